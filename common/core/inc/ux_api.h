@@ -147,6 +147,28 @@
 /*  02-19-2025     Frédéric Desbiens        Modified comment(s),          */
 /*                                            update version number,      */
 /*                                            resulting in version 6.4.2  */
+/*  xx-xx-xxxx     Mohamed ayed             Modified comment(s),          */
+/*                                            added memory word access    */
+/*                                            definitions, added memory   */
+/*                                            slab cache, added TLSF      */
+/*                                            memory pool option, added   */
+/*                                            memory pool mutex, added    */
+/*                                            memory telemetry, added     */
+/*                                            host configuration arena,   */
+/*                                            added generated descriptor  */
+/*                                            field lists, added DMA      */
+/*                                            buffer pool, added hot      */
+/*                                            field first transfer layout,*/
+/*                                            added transfer submit APIs, */
+/*                                            added transfer segments,    */
+/*                                            added HCD thread events,    */
+/*                                            added parallel enumeration, */
+/*                                            added descriptor cache,     */
+/*                                            added class match index,    */
+/*                                            added adaptive enum timing, */
+/*                                            added periodic schedule,    */
+/*                                            added device container map, */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 
@@ -339,6 +361,99 @@ typedef signed char               SCHAR;
 #define UX_HOST_HCD_THREAD_STACK_SIZE                       UX_THREAD_STACK_SIZE
 #endif
 
+/* Define USBX Host HCD thread event options. A thread per HCD uses HCD events.
+   With HCD events, a controller driver must signal its work with
+   UX_HOST_HCD_THREAD_SIGNAL(hcd), see ux_host_stack.h. A driver that increments
+   ux_hcd_thread_signal and puts ux_system_host_hcd_semaphore itself is not
+   processed: the HCD thread only processes the HCDs marked pending, and with a
+   thread per HCD the ux_system_host_hcd_semaphore is not created.  */
+#if defined(UX_HOST_STANDALONE)
+#undef UX_HOST_HCD_THREAD_EVENT_ENABLE
+#undef UX_HOST_HCD_THREAD_PER_HCD_ENABLE
+#endif
+#if defined(UX_HOST_HCD_THREAD_PER_HCD_ENABLE) && !defined(UX_HOST_HCD_THREAD_EVENT_ENABLE)
+#define UX_HOST_HCD_THREAD_EVENT_ENABLE
+#endif
+#if defined(UX_HOST_HCD_THREAD_EVENT_ENABLE) && (UX_MAX_HCD > 32)
+#error "UX_HOST_HCD_THREAD_EVENT_ENABLE supports up to 32 HCDs"
+#endif
+
+/* Define USBX Host parallel enumeration options. Devices are enumerated by worker threads
+   once they do not use address 0 anymore.  */
+#if defined(UX_HOST_STANDALONE)
+#undef UX_HOST_ENUM_PARALLEL_ENABLE
+#endif
+#if defined(UX_HOST_ENUM_PARALLEL_ENABLE)
+#ifndef UX_HOST_ENUM_PARALLEL_THREADS
+#define UX_HOST_ENUM_PARALLEL_THREADS                       2
+#endif
+#ifndef UX_HOST_ENUM_WORKER_THREAD_STACK_SIZE
+#define UX_HOST_ENUM_WORKER_THREAD_STACK_SIZE               UX_HOST_ENUM_THREAD_STACK_SIZE
+#endif
+#endif
+
+/* Define USBX Host descriptor cache options. Configuration descriptors of known devices
+   are kept so they are not read again on next enumeration.  */
+#if defined(UX_HOST_DESCRIPTOR_CACHE_ENABLE)
+#ifndef UX_HOST_DESCRIPTOR_CACHE_ENTRIES
+#define UX_HOST_DESCRIPTOR_CACHE_ENTRIES                    4
+#endif
+#ifndef UX_HOST_DESCRIPTOR_CACHE_MAX_LENGTH
+#define UX_HOST_DESCRIPTOR_CACHE_MAX_LENGTH                 512
+#endif
+#endif
+
+/* Define USBX Host class match index options. Results of class queries are indexed by
+   (VID, PID) or (class, subclass, protocol) so the classes are not queried again. Only
+   queries answered by classes enabled with ux_host_stack_class_match_index_enable are
+   indexed, the QUERY command of such a class must depend on these fields only.  */
+#if defined(UX_HOST_CLASS_MATCH_INDEX_ENABLE)
+#ifndef UX_HOST_CLASS_MATCH_INDEX_SIZE
+#define UX_HOST_CLASS_MATCH_INDEX_SIZE                      16
+#endif
+#if (UX_HOST_CLASS_MATCH_INDEX_SIZE & (UX_HOST_CLASS_MATCH_INDEX_SIZE - 1)) != 0
+#error "UX_HOST_CLASS_MATCH_INDEX_SIZE must be a power of 2"
+#endif
+#endif
+
+/* Define USBX Host adaptive enumeration timing options. Root hub ports use spec minimum
+   delays until a device fails to enumerate on them, then the fixed delays are used.  */
+#if defined(UX_HOST_STANDALONE)
+#undef UX_HOST_ENUM_ADAPTIVE_TIMING_ENABLE
+#endif
+#if defined(UX_HOST_ENUM_ADAPTIVE_TIMING_ENABLE)
+#ifndef UX_HOST_ENUM_PORT_ENABLE_WAIT_MIN
+#define UX_HOST_ENUM_PORT_ENABLE_WAIT_MIN                   10
+#endif
+#ifndef UX_HOST_ENUM_DEVICE_ADDRESS_SET_WAIT_MIN
+#define UX_HOST_ENUM_DEVICE_ADDRESS_SET_WAIT_MIN            2
+#endif
+#ifndef UX_HOST_ENUM_HS_HANDSHAKE_SUSPEND_WAIT_MIN
+#define UX_HOST_ENUM_HS_HANDSHAKE_SUSPEND_WAIT_MIN          20
+#endif
+#ifndef UX_HOST_ENUM_RETRY_DELAY_MIN
+#define UX_HOST_ENUM_RETRY_DELAY_MIN                        10
+#endif
+#endif
+
+/* Define USBX Host periodic schedule options. Interrupt and isochronous endpoints are
+   placed in (frame, microframe) slots and split transactions are budgeted per TT frame.  */
+#if UX_MAX_DEVICES == 1
+#undef UX_HOST_PERIODIC_SCHEDULE_ENABLE
+#endif
+#if defined(UX_HOST_PERIODIC_SCHEDULE_ENABLE)
+#ifndef UX_HOST_PERIODIC_FRAMES
+#define UX_HOST_PERIODIC_FRAMES                             32
+#endif
+#if (UX_HOST_PERIODIC_FRAMES & (UX_HOST_PERIODIC_FRAMES - 1)) != 0
+#error "UX_HOST_PERIODIC_FRAMES must be a power of 2"
+#endif
+#define UX_HOST_PERIODIC_SLOTS                              (UX_HOST_PERIODIC_FRAMES * 8)
+#define UX_HOST_PERIODIC_TREE_FRAMES                        32
+#define UX_HOST_PERIODIC_TT_FRAMES                          8
+#define UX_HOST_PERIODIC_SPLIT_MICROFRAMES                  6
+#endif
+
 /* Define USBX Host HNP Polling Thread Stack Size */
 #ifndef UX_HOST_HNP_POLLING_THREAD_STACK
 #define UX_HOST_HNP_POLLING_THREAD_STACK                    UX_THREAD_STACK_SIZE
@@ -1176,6 +1291,30 @@ VOID    _ux_trace_event_update(TX_TRACE_BUFFER_ENTRY *event, ULONG timestamp, UL
 #define UX_ALIGN_MIN                                                    UX_ALIGN_8
 #endif
 
+/* Define the word used by memory copy/set/compare utilities and the minimal
+   length from which the memory is accessed word by word.  */
+#define UX_UTILITY_MEMORY_WORD_SIZE                                     ((ULONG)sizeof(ALIGN_TYPE))
+#define UX_UTILITY_MEMORY_WORD_MASK                                     ((ALIGN_TYPE)sizeof(ALIGN_TYPE) - 1u)
+#ifndef UX_UTILITY_MEMORY_WORD_ACCESS_MIN
+#define UX_UTILITY_MEMORY_WORD_ACCESS_MIN                               (UX_UTILITY_MEMORY_WORD_SIZE * 2u)
+#endif
+
+/* Define the word attribute that allows the words to alias the UCHAR buffers
+   accessed by the memory utilities, so word access is safe under strict
+   aliasing. Ports whose compiler is not GCC compatible define it to their
+   equivalent (or empty if no type based alias analysis is done), otherwise
+   the memory is accessed byte by byte.  */
+#ifndef UX_UTILITY_MEMORY_WORD_ALIAS
+#if defined(__GNUC__)
+#define UX_UTILITY_MEMORY_WORD_ALIAS                                    __attribute__((__may_alias__))
+#elif !defined(UX_UTILITY_MEMORY_WORD_ACCESS_DISABLE)
+#define UX_UTILITY_MEMORY_WORD_ACCESS_DISABLE
+#endif
+#endif
+#if !defined(UX_UTILITY_MEMORY_WORD_ACCESS_DISABLE)
+typedef ALIGN_TYPE UX_UTILITY_MEMORY_WORD_ALIAS UX_UTILITY_MEMORY_WORD;
+#endif
+
 #define UX_MAX_USB_DEVICES                                              127
 
 #define UX_ENDPOINT_DIRECTION                                           0x80u
@@ -1653,6 +1792,27 @@ VOID    _ux_trace_event_update(TX_TRACE_BUFFER_ENTRY *event, ULONG timestamp, UL
 #define UX_RH_ENUMERATION_RETRY_DELAY                                   100
 
 
+/* Define USBX enumeration timing. With adaptive timing, the minimum delay is used until
+   a device fails to enumerate on the root hub port, devices on hubs use the fixed delay.  */
+
+#if defined(UX_HOST_ENUM_ADAPTIVE_TIMING_ENABLE)
+#define UX_HOST_ENUM_DELAY(hcd, port_index, min_ms, fixed_ms)                  \
+            ((((hcd) -> ux_hcd_rh_enum_fallback >> (port_index)) & 1u) ? (fixed_ms) : (min_ms))
+#define UX_HOST_ENUM_DEVICE_DELAY(device, min_ms, fixed_ms)                    \
+            (((device) -> ux_device_enum_fallback) ? (fixed_ms) : (min_ms))
+#else
+#define UX_HOST_ENUM_DELAY(hcd, port_index, min_ms, fixed_ms)                  (fixed_ms)
+#define UX_HOST_ENUM_DEVICE_DELAY(device, min_ms, fixed_ms)                    (fixed_ms)
+#endif
+
+#define UX_HOST_ENUM_PHASE_RESET                                        0
+#define UX_HOST_ENUM_PHASE_ADDRESS                                      1
+#define UX_HOST_ENUM_PHASE_DEVICE_DESCRIPTOR                            2
+#define UX_HOST_ENUM_PHASE_CONFIGURATION                                3
+#define UX_HOST_ENUM_PHASE_CLASS                                        4
+#define UX_HOST_ENUM_PHASES                                             5
+
+
 /* Define USBX PCI driver constants.  */
 
 #define UX_PCI_NB_FUNCTIONS                                             7
@@ -1730,6 +1890,9 @@ typedef struct UX_HUB_TT_STRUCT
 
     ULONG           ux_hub_tt_port_mapping;
     ULONG           ux_hub_tt_max_bandwidth;
+#if defined(UX_HOST_PERIODIC_SCHEDULE_ENABLE)
+    USHORT          ux_hub_tt_periodic_load[UX_HOST_PERIODIC_TT_FRAMES];
+#endif
 } UX_HUB_TT;
 
 
@@ -1777,44 +1940,93 @@ typedef struct UX_HOST_CLASS_STRUCT
     VOID            *ux_host_class_client;
     VOID            *ux_host_class_media;
     VOID            *ux_host_class_ext;
+#if defined(UX_HOST_CLASS_MATCH_INDEX_ENABLE)
+    UINT            ux_host_class_match_index_enable;
+#endif
 
 } UX_HOST_CLASS;
 
 
+#if defined(UX_TRANSFER_SEGMENTS_ENABLE)
+
+/* Define USBX transfer segment structure. A transfer request may describe its data
+   as a list of segments instead of one contiguous buffer.  */
+
+typedef struct UX_TRANSFER_SEGMENT_STRUCT
+{
+
+    UCHAR           *ux_transfer_segment_data_pointer;
+    ULONG           ux_transfer_segment_length;
+} UX_TRANSFER_SEGMENT;
+#endif
+
+
 /* Define USBX transfer request structure.  */
 
+/* With UX_ENABLE_TRANSFER_HOT_LAYOUT, fields touched on every transfer and
+   completion are moved to the start, so a completion touches as few cache
+   lines as possible.  */
+
 typedef struct UX_TRANSFER_STRUCT
 {
 
     ULONG           ux_transfer_request_status;
+#if defined(UX_ENABLE_TRANSFER_HOT_LAYOUT)
+    UINT            ux_transfer_request_completion_code;
+    ULONG           ux_transfer_request_packet_length;
+    VOID            (*ux_transfer_request_completion_function) (struct UX_TRANSFER_STRUCT *);
+#endif
     struct UX_ENDPOINT_STRUCT
                     *ux_transfer_request_endpoint;
     UCHAR *         ux_transfer_request_data_pointer;
     ULONG           ux_transfer_request_requested_length;
     ULONG           ux_transfer_request_actual_length;
+#if defined(UX_ENABLE_TRANSFER_HOT_LAYOUT)
+#if !defined(UX_HOST_STANDALONE)
+    UX_SEMAPHORE    ux_transfer_request_semaphore;
+#else
+    UINT            ux_transfer_request_state;
+    ULONG           ux_transfer_request_flags;
+#endif
+#endif
     UINT            ux_transfer_request_type;
     UINT            ux_transfer_request_function;
     UINT            ux_transfer_request_value;
     UINT            ux_transfer_request_index;
+#if !defined(UX_ENABLE_TRANSFER_HOT_LAYOUT)
     VOID            (*ux_transfer_request_completion_function) (struct UX_TRANSFER_STRUCT *);
+#endif
     VOID            *ux_transfer_request_class_instance;
     ULONG           ux_transfer_request_maximum_length;
     ULONG           ux_transfer_request_timeout_value;
+#if !defined(UX_ENABLE_TRANSFER_HOT_LAYOUT)
     UINT            ux_transfer_request_completion_code;
     ULONG           ux_transfer_request_packet_length;
+#endif
     struct UX_TRANSFER_STRUCT
                     *ux_transfer_request_next_transfer_request;
     VOID            *ux_transfer_request_user_specific;
 #if !defined(UX_HOST_STANDALONE)
+#if !defined(UX_ENABLE_TRANSFER_HOT_LAYOUT)
     UX_SEMAPHORE    ux_transfer_request_semaphore;
+#endif
     UX_THREAD       *ux_transfer_request_thread_pending;
 #else
+#if !defined(UX_ENABLE_TRANSFER_HOT_LAYOUT)
     UINT            ux_transfer_request_state;
+#endif
     ULONG           ux_transfer_request_time_start;
+#if !defined(UX_ENABLE_TRANSFER_HOT_LAYOUT)
     ULONG           ux_transfer_request_flags;
+#endif
     struct UX_TRANSFER_STRUCT
                     *ux_transfer_request_next_pending;
 #endif
+#if defined(UX_TRANSFER_SEGMENTS_ENABLE)
+    UX_TRANSFER_SEGMENT
+                    *ux_transfer_request_segments;
+    ULONG           ux_transfer_request_segment_count;
+#endif
 } UX_TRANSFER;
 
 #if defined(UX_HOST_STANDALONE)
@@ -1847,6 +2059,12 @@ typedef struct UX_ENDPOINT_DESCRIPTOR_STRUCT
 #define UX_ENDPOINT_DESCRIPTOR_ENTRIES                                  6
 #define UX_ENDPOINT_DESCRIPTOR_LENGTH                                   7
 
+/* Define USBX Endpoint Descriptor fields, as (size, name) of each entry.  */
+
+#define UX_ENDPOINT_DESCRIPTOR_FIELDS(field)                                \
+    field(1, bLength) field(1, bDescriptorType) field(1, bEndpointAddress)  \
+    field(1, bmAttributes) field(2, wMaxPacketSize) field(1, bInterval)
+
 
 /* Define USBX Endpoint Container structure.  */
 
@@ -1866,6 +2084,15 @@ typedef struct UX_ENDPOINT_STRUCT
                     *ux_endpoint_device;
     struct UX_TRANSFER_STRUCT
                     ux_endpoint_transfer_request;
+#if defined(UX_HOST_PERIODIC_SCHEDULE_ENABLE)
+    struct UX_HUB_TT_STRUCT
+                    *ux_endpoint_schedule_tt;
+    USHORT          ux_endpoint_schedule_load;
+    USHORT          ux_endpoint_schedule_tt_load;
+    USHORT          ux_endpoint_schedule_period;
+    USHORT          ux_endpoint_schedule_offset;
+    ULONG           ux_endpoint_schedule_claimed;
+#endif
 } UX_ENDPOINT;
 
 
@@ -1894,6 +2121,16 @@ typedef struct UX_DEVICE_DESCRIPTOR_STRUCT
 #define UX_DEVICE_DESCRIPTOR_ENTRIES                                    14
 #define UX_DEVICE_DESCRIPTOR_LENGTH                                     18
 
+/* Define USBX Device Descriptor fields, as (size, name) of each entry.  */
+
+#define UX_DEVICE_DESCRIPTOR_FIELDS(field)                                  \
+    field(1, bLength) field(1, bDescriptorType) field(2, bcdUSB)            \
+    field(1, bDeviceClass) field(1, bDeviceSubClass)                        \
+    field(1, bDeviceProtocol) field(1, bMaxPacketSize0) field(2, idVendor)  \
+    field(2, idProduct) field(2, bcdDevice) field(1, iManufacturer)         \
+    field(1, iProduct) field(1, iSerialNumber)                              \
+    field(1, bNumConfigurations)
+
 
 /* Define USBX Device Qualifier Descriptor structure.  */
 
@@ -1970,6 +2207,14 @@ typedef struct UX_INTERFACE_ASSOCIATION_DESCRIPTOR_STRUCT
 #define UX_INTERFACE_ASSOCIATION_DESCRIPTOR_ENTRIES         8
 #define UX_INTERFACE_ASSOCIATION_DESCRIPTOR_LENGTH          8
 
+/* Define USBX Interface Association Descriptor fields, as (size, name) of each entry.  */
+
+#define UX_INTERFACE_ASSOCIATION_DESCRIPTOR_FIELDS(field)                   \
+    field(1, bLength) field(1, bDescriptorType) field(1, bFirstInterface)   \
+    field(1, bInterfaceCount) field(1, bFunctionClass)                      \
+    field(1, bFunctionSubClass) field(1, bFunctionProtocol)                 \
+    field(1, iFunction)
+
 
 /* Define USBX Device Container structure.  */
 
@@ -2041,13 +2286,28 @@ typedef struct UX_DEVICE_STRUCT
     ULONG           ux_device_dbg_state_count;
 #endif
 
+#if defined(UX_HOST_ENUM_PARALLEL_ENABLE)
+    ULONG           ux_device_flags;
+
+    struct UX_DEVICE_STRUCT
+                    *ux_device_enum_next;
+    UINT            ux_device_enum_status;
+    UINT            ux_device_enum_retry;
+#endif
+
+#if defined(UX_HOST_ENUM_ADAPTIVE_TIMING_ENABLE)
+    ULONG           ux_device_enum_fallback;
+    ULONG           ux_device_enum_phase_time[UX_HOST_ENUM_PHASES];
+#endif
+
 } UX_DEVICE;
 
-#if defined(UX_HOST_STANDALONE)
+#if defined(UX_HOST_STANDALONE) || defined(UX_HOST_ENUM_PARALLEL_ENABLE)
 #define UX_DEVICE_FLAG_LOCK                     0x01u
 #define UX_DEVICE_FLAG_RESET                    0x02u
 #define UX_DEVICE_FLAG_ENUM                     0x04u
 #define UX_DEVICE_FLAG_PROTECT                  0x08u
+#define UX_DEVICE_FLAG_READY                    0x10u
 #endif
 
 #if UX_MAX_HCD > 1
@@ -2102,6 +2362,13 @@ typedef struct UX_CONFIGURATION_DESCRIPTOR_STRUCT
 #define UX_CONFIGURATION_DESCRIPTOR_ENTRIES                             8
 #define UX_CONFIGURATION_DESCRIPTOR_LENGTH                              9
 
+/* Define USBX Configuration Descriptor fields, as (size, name) of each entry.  */
+
+#define UX_CONFIGURATION_DESCRIPTOR_FIELDS(field)                           \
+    field(1, bLength) field(1, bDescriptorType) field(2, wTotalLength)      \
+    field(1, bNumInterfaces) field(1, bConfigurationValue)                  \
+    field(1, iConfiguration) field(1, bmAttributes) field(1, MaxPower)
+
 
 /* Define USBX Configuration Container structure.  */
 
@@ -2122,6 +2389,11 @@ typedef struct UX_CONFIGURATION_STRUCT
     ULONG           ux_configuration_iad_class;
     ULONG           ux_configuration_iad_subclass;
     ULONG           ux_configuration_iad_protocol;
+#if defined(UX_HOST_DEVICE_ARENA_ENABLE)
+    UCHAR           *ux_configuration_arena;
+    ULONG           ux_configuration_arena_size;
+    ULONG           ux_configuration_arena_used;
+#endif
 } UX_CONFIGURATION;
 
 #define UX_HOST_STACK_CONFIGURATION_INSTANCE_CREATE_ALL     0 /* Default: all things created.  */
@@ -2151,6 +2423,14 @@ typedef struct UX_INTERFACE_DESCRIPTOR_STRUCT
 #define UX_INTERFACE_DESCRIPTOR_ENTRIES                                 9
 #define UX_INTERFACE_DESCRIPTOR_LENGTH                                  9
 
+/* Define USBX Interface Descriptor fields, as (size, name) of each entry.  */
+
+#define UX_INTERFACE_DESCRIPTOR_FIELDS(field)                               \
+    field(1, bLength) field(1, bDescriptorType) field(1, bInterfaceNumber)  \
+    field(1, bAlternateSetting) field(1, bNumEndpoints)                     \
+    field(1, bInterfaceClass) field(1, bInterfaceSubClass)                  \
+    field(1, bInterfaceProtocol) field(1, iInterface)
+
 
 /* Define USBX Interface Container structure.  */
 
@@ -2206,6 +2486,12 @@ typedef struct UX_BOS_DESCRIPTOR_STRUCT
 #define UX_BOS_DESCRIPTOR_ENTRIES                                       4
 #define UX_BOS_DESCRIPTOR_LENGTH                                        5
 
+/* Define USBX BOS Descriptor fields, as (size, name) of each entry.  */
+
+#define UX_BOS_DESCRIPTOR_FIELDS(field)                                     \
+    field(1, bLength) field(1, bDescriptorType) field(2, wTotalLength)      \
+    field(1, bNumDeviceCaps)
+
 
 /* Define USBX USB 2.0 Descriptor structure.  */
 
@@ -2293,16 +2579,39 @@ typedef struct UX_HCD_STRUCT
 #if defined(UX_HOST_STANDALONE)
     ULONG           ux_hcd_flags;
 #endif
+
+#if defined(UX_HOST_HCD_THREAD_PER_HCD_ENABLE)
+    UCHAR           *ux_hcd_thread_stack;
+    UX_THREAD       ux_hcd_thread;
+    UX_SEMAPHORE    ux_hcd_semaphore;
+#endif
+
+#if defined(UX_HOST_ENUM_PARALLEL_ENABLE)
+    UINT            ux_hcd_rh_enum_retry;
+#endif
+
+#if defined(UX_HOST_ENUM_ADAPTIVE_TIMING_ENABLE)
+    ULONG           ux_hcd_rh_enum_fallback;
+#endif
+
+#if defined(UX_HOST_PERIODIC_SCHEDULE_ENABLE)
+    USHORT          ux_hcd_periodic_load[UX_HOST_PERIODIC_SLOTS];
+#endif
 } UX_HCD;
 
 
 /* Define USBX Device Transfer Request structure.  */
 
+/* With UX_ENABLE_TRANSFER_HOT_LAYOUT, the request type is moved after the
+   fields touched on every transfer and completion.  */
+
 typedef struct UX_SLAVE_TRANSFER_STRUCT
 {
 
     ULONG           ux_slave_transfer_request_status;
+#if !defined(UX_ENABLE_TRANSFER_HOT_LAYOUT)
     ULONG           ux_slave_transfer_request_type;
+#endif
     struct UX_SLAVE_ENDPOINT_STRUCT
                     *ux_slave_transfer_request_endpoint;
     UCHAR           *ux_slave_transfer_request_data_pointer;
@@ -2318,11 +2627,19 @@ typedef struct UX_SLAVE_TRANSFER_STRUCT
     ULONG           ux_slave_transfer_request_state;
 #else
     UX_SEMAPHORE    ux_slave_transfer_request_semaphore;
+#endif
+#if defined(UX_ENABLE_TRANSFER_HOT_LAYOUT)
+    ULONG           ux_slave_transfer_request_type;
 #endif
     ULONG           ux_slave_transfer_request_timeout;
     ULONG           ux_slave_transfer_request_force_zlp;
     UCHAR           ux_slave_transfer_request_setup[UX_SETUP_SIZE];
     ULONG           ux_slave_transfer_request_status_phase_ignore;
+#if defined(UX_TRANSFER_SEGMENTS_ENABLE)
+    UX_TRANSFER_SEGMENT
+                    *ux_slave_transfer_request_segments;
+    ULONG           ux_slave_transfer_request_segment_count;
+#endif
 } UX_SLAVE_TRANSFER;
 
 #if defined(UX_DEVICE_STANDALONE)
@@ -2486,7 +2803,24 @@ typedef struct UX_SLAVE_CLASS_STRUCT
 #define UX_UCHAR_TO_ALIGN_TYPE_POINTER_CONVERT(a)       ((ALIGN_TYPE *) ((VOID *) (a)))
 #endif
 #define UX_UCHAR_TO_INDIRECT_BYTE_POOL_POINTER(a)       ((UX_MEMORY_BYTE_POOL **) ((VOID *) (a)))
+#ifdef UX_ENABLE_MEMORY_TLSF
+
+/* With TLSF, block header includes the pointer to previous block so free blocks
+   are merged immediately. Free blocks keep free list links in memory buffer.  */
+#define UX_MEMORY_BLOCK_HEADER_SIZE                     (sizeof(UCHAR *) + sizeof(ALIGN_TYPE) + sizeof(UCHAR *))
+#define UX_MEMORY_BLOCK_PREV_OFFSET                     (sizeof(UCHAR *) + sizeof(ALIGN_TYPE))
+#define UX_MEMORY_TLSF_BLOCK_MIN                        ((ULONG)(sizeof(UCHAR *) * 2))
+#ifndef UX_BYTE_BLOCK_MIN
+#define UX_BYTE_BLOCK_MIN                               ((ULONG)(UX_MEMORY_BLOCK_HEADER_SIZE + UX_MEMORY_TLSF_BLOCK_MIN))
+#endif
+
+/* Header is not a multiple of UX_ALIGN_MIN + 1, so alignment pad may take one
+   more header than the alignment.  */
+#define UX_MEMORY_BLOCK_ALIGN_EXTRA                     ((ULONG)UX_MEMORY_BLOCK_HEADER_SIZE)
+#else
 #define UX_MEMORY_BLOCK_HEADER_SIZE                     (sizeof(UCHAR *) + sizeof(ALIGN_TYPE))
+#define UX_MEMORY_BLOCK_ALIGN_EXTRA                     0
+#endif
 
 #ifndef UX_BYTE_BLOCK_FREE
 #define UX_BYTE_BLOCK_FREE                              ((ULONG) 0xFFFFEEEEUL)
@@ -2496,6 +2830,163 @@ typedef struct UX_SLAVE_CLASS_STRUCT
 #define UX_BYTE_BLOCK_MIN                               ((ULONG) 20)
 #endif
 
+#ifndef UX_BYTE_BLOCK_SLAB_CACHED
+#define UX_BYTE_BLOCK_SLAB_CACHED                       ((ULONG) 0xFFFFEEEDUL)
+#endif
+
+#ifdef UX_ENABLE_MEMORY_SLAB
+
+/* Define the number of slab size classes and the smallest class size. Each
+   class doubles the size of the previous one (16, 32 ... 512 by default).  */
+#ifndef UX_MEMORY_SLAB_CLASS_NUM
+#define UX_MEMORY_SLAB_CLASS_NUM                        6
+#endif
+
+#ifndef UX_MEMORY_SLAB_SIZE_MIN
+#define UX_MEMORY_SLAB_SIZE_MIN                         16
+#endif
+
+#define UX_MEMORY_SLAB_SIZE_MAX                         ((ULONG)UX_MEMORY_SLAB_SIZE_MIN << (UX_MEMORY_SLAB_CLASS_NUM - 1))
+
+#if ((UX_MEMORY_SLAB_SIZE_MIN) & (UX_ALIGN_MIN)) || ((UX_MEMORY_SLAB_SIZE_MIN) < 8)
+#error "UX_MEMORY_SLAB_SIZE_MIN must be multiple of minimal alignment (UX_ALIGN_MIN + 1) and not less than 8"
+#endif
+
+/* Define USBX Memory slab structure, a size class of cached free blocks.  */
+
+typedef struct UX_MEMORY_SLAB_STRUCT
+{
+
+    /* Define the list of cached blocks, linked through their memory buffers.  */
+    UCHAR           *ux_memory_slab_free_list;
+
+    /* Define the memory buffer size of blocks in this class.  */
+    ULONG           ux_memory_slab_size;
+
+    /* Define the number of cached blocks.  */
+    ULONG           ux_memory_slab_cached;
+} UX_MEMORY_SLAB;
+#endif
+
+#ifdef UX_ENABLE_MEMORY_TLSF
+
+/* Define TLSF (two-level segregated fit) free lists layout. Free blocks are
+   listed by the most significant bit of their size (first level) and next
+   UX_MEMORY_TLSF_SL_LOG2 bits (second level). Blocks smaller than
+   (1 << UX_MEMORY_TLSF_FL_SHIFT) are in first level 0 by steps of 8 bytes,
+   blocks larger than (2 << UX_MEMORY_TLSF_FL_INDEX_MAX) share the last list.  */
+#ifndef UX_MEMORY_TLSF_SL_LOG2
+#define UX_MEMORY_TLSF_SL_LOG2                          3
+#endif
+
+#ifndef UX_MEMORY_TLSF_FL_INDEX_MAX
+#define UX_MEMORY_TLSF_FL_INDEX_MAX                     24
+#endif
+
+#define UX_MEMORY_TLSF_SL_COUNT                         (1u << UX_MEMORY_TLSF_SL_LOG2)
+#define UX_MEMORY_TLSF_FL_SHIFT                         (UX_MEMORY_TLSF_SL_LOG2 + 3)
+#define UX_MEMORY_TLSF_FL_COUNT                         (UX_MEMORY_TLSF_FL_INDEX_MAX - UX_MEMORY_TLSF_FL_SHIFT + 2)
+
+#if (UX_MEMORY_TLSF_SL_LOG2 > 5) || (UX_MEMORY_TLSF_FL_INDEX_MAX > 31) || (UX_MEMORY_TLSF_FL_COUNT < 2)
+#error "UX_MEMORY_TLSF_SL_LOG2 must not exceed 5, UX_MEMORY_TLSF_FL_INDEX_MAX must be in range of (UX_MEMORY_TLSF_SL_LOG2 + 3) to 31"
+#endif
+#endif
+
+#ifdef UX_ENABLE_MEMORY_TELEMETRY
+
+/* Define memory telemetry histograms. Bucket 0 counts value 0, bucket N counts
+   values in range of [2^(N-1), 2^N), the last bucket counts all larger values.  */
+#ifndef UX_MEMORY_TELEMETRY_HISTOGRAM_SIZE
+#define UX_MEMORY_TELEMETRY_HISTOGRAM_SIZE              16
+#endif
+
+/* Define the number of allocation sites logged per pool, allocations from more
+   sites are logged in the last entry.  */
+#ifndef UX_MEMORY_TELEMETRY_SITE_NUM
+#define UX_MEMORY_TELEMETRY_SITE_NUM                    8
+#endif
+
+/* Define the time base of allocation latency, system ticks by default. It can
+   be defined to a cycle counter read for finer resolution.  */
+#ifndef UX_MEMORY_TELEMETRY_TIME_GET
+#define UX_MEMORY_TELEMETRY_TIME_GET()                  _ux_utility_time_get()
+#endif
+
+/* Define the allocation site identifier, the calling thread by default. It can
+   be defined to (ALIGN_TYPE)__builtin_return_address(0) to log call sites.  */
+#ifndef UX_MEMORY_TELEMETRY_SITE_GET
+#if defined(UX_STANDALONE)
+#define UX_MEMORY_TELEMETRY_SITE_GET()                  ((ALIGN_TYPE)0)
+#else
+#define UX_MEMORY_TELEMETRY_SITE_GET()                  ((ALIGN_TYPE)_ux_utility_thread_identify())
+#endif
+#endif
+
+#if (UX_MEMORY_TELEMETRY_HISTOGRAM_SIZE < 2) || (UX_MEMORY_TELEMETRY_HISTOGRAM_SIZE > 33) || (UX_MEMORY_TELEMETRY_SITE_NUM < 1)
+#error "UX_MEMORY_TELEMETRY_HISTOGRAM_SIZE must be in range of 2 to 33, UX_MEMORY_TELEMETRY_SITE_NUM must not be 0"
+#endif
+
+/* Define USBX Memory telemetry histogram structure.  */
+
+typedef struct UX_MEMORY_HISTOGRAM_STRUCT
+{
+
+    /* Define the largest value logged.  */
+    ULONG           ux_memory_histogram_max;
+
+    /* Define the number of values logged in each bucket.  */
+    ULONG           ux_memory_histogram_count[UX_MEMORY_TELEMETRY_HISTOGRAM_SIZE];
+} UX_MEMORY_HISTOGRAM;
+
+/* Define USBX Memory telemetry allocation site structure.  */
+
+typedef struct UX_MEMORY_TELEMETRY_SITE_STRUCT
+{
+
+    /* Define the site identifier, see UX_MEMORY_TELEMETRY_SITE_GET.  */
+    ALIGN_TYPE      ux_memory_telemetry_site_id;
+
+    /* Define the number of allocations and failures of the site.  */
+    ULONG           ux_memory_telemetry_site_alloc_count;
+    ULONG           ux_memory_telemetry_site_fail_count;
+
+    /* Define the total and largest number of bytes requested by the site.  */
+    ULONG           ux_memory_telemetry_site_alloc_total;
+    ULONG           ux_memory_telemetry_site_alloc_max;
+} UX_MEMORY_TELEMETRY_SITE;
+
+/* Define USBX Memory telemetry structure of a byte pool.  */
+
+typedef struct UX_MEMORY_TELEMETRY_STRUCT
+{
+
+    /* Define the number of allocations and failures.  */
+    ULONG           ux_memory_telemetry_alloc_count;
+    ULONG           ux_memory_telemetry_fail_count;
+
+    /* Define allocation latency, in UX_MEMORY_TELEMETRY_TIME_GET units.  */
+    UX_MEMORY_HISTOGRAM ux_memory_telemetry_latency;
+
+    /* Define the number of blocks walked through by each pool search.  */
+    UX_MEMORY_HISTOGRAM ux_memory_telemetry_walk;
+
+    /* Define the fragments of the pool, current value is updated on query.  */
+    ULONG           ux_memory_telemetry_fragments;
+    ULONG           ux_memory_telemetry_fragments_max;
+
+    /* Define the free blocks of the pool, updated on query.  */
+    ULONG           ux_memory_telemetry_free_blocks;
+
+    /* Define the largest free block of the pool, updated on query and on
+       allocation failure, the smallest one seen is kept.  */
+    ULONG           ux_memory_telemetry_largest_free;
+    ULONG           ux_memory_telemetry_largest_free_min;
+
+    /* Define allocations breakdown by sites.  */
+    UX_MEMORY_TELEMETRY_SITE ux_memory_telemetry_sites[UX_MEMORY_TELEMETRY_SITE_NUM];
+} UX_MEMORY_TELEMETRY;
+#endif
+
 /* Define USBX Memory Management structure.  */
 
 typedef struct UX_MEMORY_BYTE_POOL_STRUCT
@@ -2516,6 +3007,12 @@ typedef struct UX_MEMORY_BYTE_POOL_STRUCT
     /* Save the byte pool's size in bytes.  */
     ULONG           ux_byte_pool_size;
 
+#if !defined(UX_STANDALONE)
+
+    /* Define the mutex protecting the byte pool.  */
+    UX_MUTEX        ux_byte_pool_mutex;
+#endif
+
 #ifdef UX_ENABLE_MEMORY_STATISTICS
     ALIGN_TYPE      ux_byte_pool_min_free;
     ULONG           ux_byte_pool_alloc_count;
@@ -2523,12 +3020,90 @@ typedef struct UX_MEMORY_BYTE_POOL_STRUCT
     ULONG           ux_byte_pool_alloc_max_count;
     ULONG           ux_byte_pool_alloc_max_total;
 #endif
+
+#ifdef UX_ENABLE_MEMORY_SLAB
+    UX_MEMORY_SLAB  ux_byte_pool_slab[UX_MEMORY_SLAB_CLASS_NUM];
+#endif
+
+#ifdef UX_ENABLE_MEMORY_TELEMETRY
+    UX_MEMORY_TELEMETRY ux_byte_pool_telemetry;
+#endif
+
+#ifdef UX_ENABLE_MEMORY_TLSF
+    ULONG           ux_byte_pool_tlsf_fl_bitmap;
+    ULONG           ux_byte_pool_tlsf_sl_bitmap[UX_MEMORY_TLSF_FL_COUNT];
+    UCHAR           *ux_byte_pool_tlsf_free[UX_MEMORY_TLSF_FL_COUNT][UX_MEMORY_TLSF_SL_COUNT];
+#endif
 } UX_MEMORY_BYTE_POOL;
 
 #define UX_MEMORY_BYTE_POOL_REGULAR 0
 #define UX_MEMORY_BYTE_POOL_CACHE_SAFE 1
 #define UX_MEMORY_BYTE_POOL_NUM 2
 
+#ifdef UX_ENABLE_MEMORY_DMA_POOL
+
+/* Define DMA buffer pool of fixed size blocks, reserved from the cache safe
+   pool at system initialization. Block size and alignment are cache line
+   multiples so blocks can be used for DMA transfers directly.  */
+#ifndef UX_MEMORY_DMA_POOL_BLOCK_SIZE
+#define UX_MEMORY_DMA_POOL_BLOCK_SIZE                   512
+#endif
+
+#ifndef UX_MEMORY_DMA_POOL_BLOCK_NUM
+#define UX_MEMORY_DMA_POOL_BLOCK_NUM                    8
+#endif
+
+#ifndef UX_MEMORY_DMA_POOL_ALIGN
+#define UX_MEMORY_DMA_POOL_ALIGN                        UX_ALIGN_32
+#endif
+
+/* Define DMA buffer owners, each owner takes blocks up to its quota.  */
+#define UX_MEMORY_DMA_OWNER_HOST_STORAGE                0
+#define UX_MEMORY_DMA_OWNER_HOST_PIMA                   1
+#define UX_MEMORY_DMA_OWNER_OTHERS                      2
+#define UX_MEMORY_DMA_OWNER_NUM                         3
+
+/* Define quotas of owners, applied at system initialization. By default
+   each owner may take all blocks.  */
+#ifndef UX_MEMORY_DMA_POOL_QUOTAS
+#define UX_MEMORY_DMA_POOL_QUOTAS                       { UX_MEMORY_DMA_POOL_BLOCK_NUM, UX_MEMORY_DMA_POOL_BLOCK_NUM, UX_MEMORY_DMA_POOL_BLOCK_NUM }
+#endif
+
+#if ((UX_MEMORY_DMA_POOL_BLOCK_SIZE) & (UX_MEMORY_DMA_POOL_ALIGN)) || ((UX_MEMORY_DMA_POOL_BLOCK_SIZE) < 16) || ((UX_MEMORY_DMA_POOL_BLOCK_NUM) < 1)
+#error "UX_MEMORY_DMA_POOL_BLOCK_SIZE must be multiple of (UX_MEMORY_DMA_POOL_ALIGN + 1) and not less than 16, UX_MEMORY_DMA_POOL_BLOCK_NUM must not be 0"
+#endif
+
+/* Define USBX Memory DMA buffer pool structure.  */
+
+typedef struct UX_MEMORY_DMA_POOL_STRUCT
+{
+
+    /* Define the blocks area.  */
+    UCHAR           *ux_dma_pool_start;
+    UCHAR           *ux_dma_pool_end;
+
+    /* Define the list of free blocks, linked through their memory buffers.  */
+    UCHAR           *ux_dma_pool_free_list;
+    ULONG           ux_dma_pool_free_count;
+
+    /* Define the owner of each block.  */
+    UCHAR           ux_dma_pool_block_owner[UX_MEMORY_DMA_POOL_BLOCK_NUM];
+
+    /* Define the blocks used and allowed for each owner.  */
+    ULONG           ux_dma_pool_used[UX_MEMORY_DMA_OWNER_NUM];
+    ULONG           ux_dma_pool_quota[UX_MEMORY_DMA_OWNER_NUM];
+
+    /* Define the number of requests served by the byte pool instead.  */
+    ULONG           ux_dma_pool_fallback_count;
+} UX_MEMORY_DMA_POOL;
+
+#define UX_MEMORY_DMA_ALLOCATE(owner, size)             _ux_utility_memory_dma_allocate(owner, size)
+#define UX_MEMORY_DMA_FREE(memory)                      _ux_utility_memory_dma_free(memory)
+#else
+#define UX_MEMORY_DMA_ALLOCATE(owner, size)             _ux_utility_memory_allocate(UX_SAFE_ALIGN, UX_CACHE_SAFE_MEMORY, size)
+#define UX_MEMORY_DMA_FREE(memory)                      _ux_utility_memory_free(memory)
+#endif
+
 typedef struct UX_SYSTEM_STRUCT
 {
     UX_MEMORY_BYTE_POOL *ux_system_memory_byte_pool[UX_MEMORY_BYTE_POOL_NUM];
@@ -2538,6 +3113,10 @@ typedef struct UX_SYSTEM_STRUCT
     UX_MUTEX        ux_system_mutex;
 #endif
 
+#ifdef UX_ENABLE_MEMORY_DMA_POOL
+    UX_MEMORY_DMA_POOL  ux_system_memory_dma_pool;
+#endif
+
 #ifndef UX_DISABLE_ERROR_HANDLER
     UINT            ux_system_last_error;
     UINT            ux_system_error_count;
@@ -2556,6 +3135,41 @@ typedef struct UX_SYSTEM_STRUCT
 } UX_SYSTEM;
 
 
+#if defined(UX_HOST_CLASS_MATCH_INDEX_ENABLE)
+
+/* Define USBX Host class match index entry structure. The key packs the query usage with
+   the (VID, PID) or with the (class, subclass, protocol) and IAD (class, subclass, protocol)
+   of the query, the class is UX_NULL if no class matched.  */
+
+typedef struct UX_HOST_CLASS_MATCH_STRUCT
+{
+
+    ULONG           ux_host_class_match_key;
+    ULONG           ux_host_class_match_key_ext;
+    UX_HOST_CLASS   *ux_host_class_match_class;
+} UX_HOST_CLASS_MATCH;
+#endif
+
+
+#if defined(UX_HOST_DESCRIPTOR_CACHE_ENABLE)
+
+/* Define USBX Host descriptor cache entry structure. Keeps a whole configuration descriptor
+   of a device, identified by its vendor ID, product ID and release number.  */
+
+typedef struct UX_HOST_DESCRIPTOR_CACHE_STRUCT
+{
+
+    ULONG           ux_host_descriptor_cache_vendor_id;
+    ULONG           ux_host_descriptor_cache_product_id;
+    ULONG           ux_host_descriptor_cache_bcd_device;
+    UINT            ux_host_descriptor_cache_configuration_index;
+    ULONG           ux_host_descriptor_cache_length;
+    UCHAR           *ux_host_descriptor_cache_descriptor;
+    ULONG           ux_host_descriptor_cache_stamp;
+} UX_HOST_DESCRIPTOR_CACHE;
+#endif
+
+
 /* Define USBX System Host Data structure.  */
 
 typedef struct UX_SYSTEM_HOST_STRUCT
@@ -2574,6 +3188,7 @@ typedef struct UX_SYSTEM_HOST_STRUCT
 
 #if UX_MAX_DEVICES > 1
     ULONG           ux_system_host_max_devices;
+    ULONG           ux_system_host_device_map[(UX_MAX_DEVICES + 31) / 32];
 #endif
     UX_DEVICE       *ux_system_host_device_array;
 
@@ -2596,6 +3211,37 @@ typedef struct UX_SYSTEM_HOST_STRUCT
     UX_THREAD       ux_system_host_hcd_thread;
     UX_SEMAPHORE    ux_system_host_hcd_semaphore;
 #endif
+#if defined(UX_HOST_HCD_THREAD_EVENT_ENABLE)
+    ULONG           ux_system_host_hcd_pending;
+#endif
+
+#if defined(UX_HOST_ENUM_PARALLEL_ENABLE)
+    UCHAR           *ux_system_host_enum_worker_thread_stack;
+    UX_THREAD       ux_system_host_enum_worker_thread[UX_HOST_ENUM_PARALLEL_THREADS];
+    UX_SEMAPHORE    ux_system_host_enum_worker_semaphore;
+    struct UX_DEVICE_STRUCT
+                    *ux_system_host_enum_device;
+    struct UX_DEVICE_STRUCT
+                    *ux_system_host_enum_ready;
+#if UX_MAX_DEVICES > 1
+    UINT            (*ux_system_host_enum_hub_retry_function) (struct UX_DEVICE_STRUCT *);
+#endif
+#endif
+
+#if defined(UX_HOST_CLASS_MATCH_INDEX_ENABLE)
+    UX_HOST_CLASS_MATCH
+                    ux_system_host_class_match_index[UX_HOST_CLASS_MATCH_INDEX_SIZE];
+#endif
+
+#if defined(UX_HOST_DESCRIPTOR_CACHE_ENABLE)
+    UX_HOST_DESCRIPTOR_CACHE
+                    ux_system_host_descriptor_cache[UX_HOST_DESCRIPTOR_CACHE_ENTRIES];
+    ULONG           ux_system_host_descriptor_cache_stamp;
+    VOID            (*ux_system_host_descriptor_cache_callback) (struct UX_DEVICE_STRUCT *, UINT, UCHAR *, ULONG);
+#if !defined(UX_HOST_STANDALONE)
+    UX_MUTEX        ux_system_host_descriptor_cache_mutex;
+#endif
+#endif
 
 #if defined(UX_OTG_SUPPORT) && !defined(UX_OTG_STANDALONE)
     UCHAR           *ux_system_host_hnp_polling_thread_stack;
@@ -2776,6 +3422,9 @@ typedef struct UX_HOST_CLASS_DPUMP_STRUCT
 #define ux_host_stack_interface_setting_select                  _uxe_host_stack_interface_setting_select
 #define ux_host_stack_transfer_request                          _uxe_host_stack_transfer_request
 #define ux_host_stack_transfer_request_abort                    _uxe_host_stack_transfer_request_abort
+#define ux_host_stack_transfer_submit                           _uxe_host_stack_transfer_submit
+#define ux_host_stack_transfer_batch_submit                     _uxe_host_stack_transfer_batch_submit
+#define ux_host_stack_descriptor_cache_add                      _uxe_host_stack_descriptor_cache_add
 
 #else
 
@@ -2794,12 +3443,16 @@ typedef struct UX_HOST_CLASS_DPUMP_STRUCT
 #define ux_host_stack_interface_setting_select                  _ux_host_stack_interface_setting_select
 #define ux_host_stack_transfer_request                          _ux_host_stack_transfer_request
 #define ux_host_stack_transfer_request_abort                    _ux_host_stack_transfer_request_abort
+#define ux_host_stack_transfer_submit                           _ux_host_stack_transfer_submit
+#define ux_host_stack_transfer_batch_submit                     _ux_host_stack_transfer_batch_submit
+#define ux_host_stack_descriptor_cache_add                      _ux_host_stack_descriptor_cache_add
 
 #endif
 
 #define ux_host_stack_class_instance_create                     _ux_host_stack_class_instance_create
 #define ux_host_stack_class_instance_destroy                    _ux_host_stack_class_instance_destroy
 #define ux_host_stack_class_unregister                          _ux_host_stack_class_unregister
+#define ux_host_stack_class_match_index_enable                  _ux_host_stack_class_match_index_enable
 #define ux_host_stack_configuration_interface_get               _ux_host_stack_configuration_interface_get
 #define ux_host_stack_device_configuration_reset                _ux_host_stack_device_configuration_reset
 #define ux_host_stack_device_configuration_select               _ux_host_stack_device_configuration_select
@@ -2807,6 +3460,7 @@ typedef struct UX_HOST_CLASS_DPUMP_STRUCT
 #define ux_host_stack_uninitialize                              _ux_host_stack_uninitialize
 #define ux_host_stack_hnp_polling_thread_entry                  _ux_host_stack_hnp_polling_thread_entry
 #define ux_host_stack_role_swap                                 _ux_host_stack_role_swap
+#define ux_host_stack_descriptor_cache_callback_set             _ux_host_stack_descriptor_cache_callback_set
 
 #define ux_host_stack_tasks_run                                 _ux_host_stack_tasks_run
 #define ux_host_stack_transfer_run                              _ux_host_stack_transfer_run
@@ -2885,6 +3539,7 @@ UINT    ux_host_stack_class_instance_destroy(UX_HOST_CLASS *host_class, VOID *cl
 UINT    ux_host_stack_class_instance_get(UX_HOST_CLASS *host_class, UINT class_index, VOID **class_instance);
 UINT    ux_host_stack_class_register(UCHAR *class_name, UINT (*class_entry_function)(struct UX_HOST_CLASS_COMMAND_STRUCT *));
 UINT    ux_host_stack_class_unregister(UINT (*class_entry_function)(struct UX_HOST_CLASS_COMMAND_STRUCT *));
+UINT    ux_host_stack_class_match_index_enable(UINT (*class_entry_function)(struct UX_HOST_CLASS_COMMAND_STRUCT *));
 UINT    ux_host_stack_configuration_interface_get(UX_CONFIGURATION *configuration, UINT interface_index,
                                     UINT alternate_setting_index, UX_INTERFACE **ux_interface);
 UINT    ux_host_stack_device_configuration_activate(UX_CONFIGURATION *configuration);
@@ -2902,6 +3557,13 @@ UINT    ux_host_stack_interface_endpoint_get(UX_INTERFACE *ux_interface, UINT en
 UINT    ux_host_stack_interface_setting_select(UX_INTERFACE *ux_interface);
 UINT    ux_host_stack_transfer_request(UX_TRANSFER *transfer_request);
 UINT    ux_host_stack_transfer_request_abort(UX_TRANSFER *transfer_request);
+UINT    ux_host_stack_transfer_submit(UX_TRANSFER *transfer_request, VOID (*completion_function)(UX_TRANSFER *));
+UINT    ux_host_stack_transfer_batch_submit(UX_TRANSFER **transfer_requests, ULONG count,
+                                    VOID (*completion_function)(UX_TRANSFER *), ULONG *actual_count);
+UINT    ux_host_stack_descriptor_cache_add(ULONG vendor_id, ULONG product_id, ULONG bcd_device,
+                                    UINT configuration_index, UCHAR *descriptor, ULONG length);
+UINT    ux_host_stack_descriptor_cache_callback_set(VOID (*callback)(UX_DEVICE *device,
+                                    UINT configuration_index, UCHAR *descriptor, ULONG length));
 VOID    ux_host_stack_hnp_polling_thread_entry(ULONG id);
 UINT    ux_host_stack_role_swap(UX_DEVICE *device);
 UINT    ux_host_stack_device_configuration_reset(UX_DEVICE *device);
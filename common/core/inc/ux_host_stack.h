@@ -67,6 +67,16 @@
 /*  10-31-2023     Chaoqiong Xiao           Modified comment(s),          */
 /*                                            added error checks support, */
 /*                                            resulting in version 6.3.0  */
+/*  xx-xx-xxxx     Mohamed ayed             Modified comment(s),          */
+/*                                            added configuration arena,  */
+/*                                            added transfer submit APIs, */
+/*                                            added HCD thread events,    */
+/*                                            added parallel enumeration, */
+/*                                            added descriptor cache,     */
+/*                                            added adaptive enum timing, */
+/*                                            added periodic schedule,    */
+/*                                            added class match index,    */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 
@@ -118,9 +128,28 @@ extern   "C" {
 #define UX_HOST_STACK_ENUM_IDLE                 (UX_STATE_STEP + 22)
 
 
+/* Define Host Stack enumeration phase timing, in ticks.  */
+
+#if defined(UX_HOST_ENUM_ADAPTIVE_TIMING_ENABLE)
+#define UX_HOST_ENUM_PHASE_START(start)                 (start) =  _ux_utility_time_get()
+#define UX_HOST_ENUM_PHASE_END(device, phase, start)    (device) -> ux_device_enum_phase_time[(phase)] +=   \
+                                                            (ULONG)_ux_utility_time_elapsed((start), _ux_utility_time_get())
+#else
+#define UX_HOST_ENUM_PHASE_START(start)
+#define UX_HOST_ENUM_PHASE_END(device, phase, start)
+#endif
+
+
 /* Define Host Stack component function prototypes.  */
 
-#if UX_MAX_DEVICES > 1
+#if defined(UX_HOST_PERIODIC_SCHEDULE_ENABLE)
+VOID    _ux_host_stack_periodic_schedule_release(UX_HCD *hcd, UX_ENDPOINT *endpoint);
+VOID    _ux_host_stack_periodic_schedule_claim(UX_HCD *hcd, UX_ENDPOINT *endpoint);
+UINT    _ux_host_stack_periodic_schedule_check(UX_HCD *hcd, UX_ENDPOINT *endpoint);
+#define _ux_host_stack_bandwidth_release(a,b)                   _ux_host_stack_periodic_schedule_release(a,b)
+#define _ux_host_stack_bandwidth_claim(a,b)                     _ux_host_stack_periodic_schedule_claim(a,b)
+#define _ux_host_stack_bandwidth_check(a,b)                     _ux_host_stack_periodic_schedule_check(a,b)
+#elif UX_MAX_DEVICES > 1
 VOID    _ux_host_stack_bandwidth_release(UX_HCD *hcd, UX_ENDPOINT *endpoint);
 VOID    _ux_host_stack_bandwidth_claim(UX_HCD *hcd, UX_ENDPOINT *endpoint);
 UINT    _ux_host_stack_bandwidth_check(UX_HCD *hcd, UX_ENDPOINT *endpoint);
@@ -141,6 +170,20 @@ UINT    _ux_host_stack_class_interface_scan(UX_DEVICE *device);
 UINT    _ux_host_stack_class_register(UCHAR *class_name,
                         UINT (*class_entry_function)(struct UX_HOST_CLASS_COMMAND_STRUCT *));
 UINT    _ux_host_stack_class_unregister(UINT (*class_entry_function)(struct UX_HOST_CLASS_COMMAND_STRUCT *));
+#if defined(UX_HOST_CLASS_MATCH_INDEX_ENABLE)
+UINT    _ux_host_stack_class_match_index_enable(UINT (*class_entry_function)(struct UX_HOST_CLASS_COMMAND_STRUCT *));
+#endif
+#if defined(UX_HOST_DEVICE_ARENA_ENABLE)
+VOID    *_ux_host_stack_configuration_arena_allocate(UX_CONFIGURATION *configuration, ULONG memory_size);
+VOID    _ux_host_stack_configuration_arena_create(UX_CONFIGURATION *configuration, UCHAR *descriptor);
+VOID    _ux_host_stack_configuration_arena_free(UX_CONFIGURATION *configuration, VOID *memory);
+#define UX_HOST_STACK_ARENA_ROUND(s)                            (((s) + UX_ALIGN_MIN) & ~((ULONG)UX_ALIGN_MIN))
+#define UX_HOST_STACK_CONTAINER_ALLOCATE(c,s)                   _ux_host_stack_configuration_arena_allocate(c,s)
+#define UX_HOST_STACK_CONTAINER_FREE(c,m)                       _ux_host_stack_configuration_arena_free(c,m)
+#else
+#define UX_HOST_STACK_CONTAINER_ALLOCATE(c,s)                   _ux_utility_memory_allocate(UX_NO_ALIGN, UX_REGULAR_MEMORY, s)
+#define UX_HOST_STACK_CONTAINER_FREE(c,m)                       _ux_utility_memory_free(m)
+#endif
 UINT    _ux_host_stack_configuration_descriptor_parse(UX_DEVICE *device, UX_CONFIGURATION *configuration, UINT configuration_index);
 UINT    _ux_host_stack_configuration_enumerate(UX_DEVICE *device);
 UINT    _ux_host_stack_configuration_instance_create(UX_CONFIGURATION *configuration);
@@ -151,6 +194,15 @@ UINT    _ux_host_stack_configuration_interface_get(UX_CONFIGURATION *configurati
 UINT    _ux_host_stack_configuration_interface_scan(UX_CONFIGURATION *configuration);
 UINT    _ux_host_stack_configuration_set(UX_CONFIGURATION *configuration);
 VOID    _ux_host_stack_delay_ms(ULONG time);
+#if defined(UX_HOST_DESCRIPTOR_CACHE_ENABLE)
+UINT    _ux_host_stack_descriptor_cache_add(ULONG vendor_id, ULONG product_id, ULONG bcd_device,
+                                    UINT configuration_index, UCHAR *descriptor, ULONG length);
+UINT    _ux_host_stack_descriptor_cache_callback_set(VOID (*callback)(UX_DEVICE *device,
+                                    UINT configuration_index, UCHAR *descriptor, ULONG length));
+UINT    _ux_host_stack_descriptor_cache_read(UX_DEVICE *device, UX_CONFIGURATION *configuration,
+                                    UINT configuration_index, UCHAR *descriptor);
+VOID    _ux_host_stack_descriptor_cache_save(UX_DEVICE *device, UINT configuration_index, UCHAR *descriptor);
+#endif
 UINT    _ux_host_stack_device_address_set(UX_DEVICE *device);
 UINT    _ux_host_stack_device_configuration_activate(UX_CONFIGURATION *configuration);
 UINT    _ux_host_stack_device_configuration_deactivate(UX_DEVICE *device);
@@ -168,10 +220,28 @@ VOID    _ux_host_stack_endpoint_instance_delete(UX_ENDPOINT *endpoint);
 UINT    _ux_host_stack_endpoint_reset(UX_ENDPOINT *endpoint);
 UINT    _ux_host_stack_endpoint_transfer_abort(UX_ENDPOINT *endpoint);
 VOID    _ux_host_stack_enum_thread_entry(ULONG input);
+#if defined(UX_HOST_ENUM_PARALLEL_ENABLE)
+VOID    _ux_host_stack_enum_worker_thread_entry(ULONG input);
+VOID    _ux_host_stack_enum_ready_process(VOID);
+VOID    _ux_host_stack_enum_device_cancel(UX_DEVICE *device);
+#endif
 UINT    _ux_host_stack_hcd_register(UCHAR *hcd_name,
                                     UINT (*hcd_init_function)(struct UX_HCD_STRUCT *), ULONG hcd_param1, ULONG hcd_param2);
 UINT    _ux_host_stack_hcd_unregister(UCHAR *hcd_name, ULONG hcd_param1, ULONG hcd_param2);
 VOID    _ux_host_stack_hcd_thread_entry(ULONG input);
+#if defined(UX_HOST_HCD_THREAD_EVENT_ENABLE)
+VOID    _ux_host_stack_hcd_thread_signal(UX_HCD *hcd);
+VOID    _ux_host_stack_hcd_thread_process(UX_HCD *hcd);
+#define UX_HOST_HCD_THREAD_SIGNAL(hcd)                          _ux_host_stack_hcd_thread_signal(hcd)
+#else
+#define UX_HOST_HCD_THREAD_SIGNAL(hcd) do {                                      \
+        (hcd) -> ux_hcd_thread_signal++;                                        \
+        _ux_host_semaphore_put(&_ux_system_host -> ux_system_host_hcd_semaphore); \
+    } while(0)
+#endif
+#if defined(UX_HOST_HCD_THREAD_PER_HCD_ENABLE)
+VOID    _ux_host_stack_hcd_controller_thread_entry(ULONG hcd_address);
+#endif
 UINT    _ux_host_stack_hcd_transfer_request(UX_TRANSFER *transfer_request);
 UINT    _ux_host_stack_initialize(UINT (*ux_system_host_change_function)(ULONG, UX_HOST_CLASS *, VOID *));
 UINT    _ux_host_stack_uninitialize(VOID);
@@ -194,6 +264,10 @@ UINT    _ux_host_stack_rh_device_extraction(UX_HCD *hcd, UINT port_index);
 UINT    _ux_host_stack_rh_device_insertion(UX_HCD *hcd, UINT port_index);
 UINT    _ux_host_stack_transfer_request(UX_TRANSFER *transfer_request);
 UINT    _ux_host_stack_transfer_request_abort(UX_TRANSFER *transfer_request);
+UINT    _ux_host_stack_transfer_submit(UX_TRANSFER *transfer_request,
+                                    VOID (*completion_function)(UX_TRANSFER *));
+UINT    _ux_host_stack_transfer_batch_submit(UX_TRANSFER **transfer_requests, ULONG count,
+                                    VOID (*completion_function)(UX_TRANSFER *), ULONG *actual_count);
 UINT    _ux_host_stack_role_swap(UX_DEVICE *device);
 
 #if defined(UX_OTG_SUPPORT)
@@ -225,6 +299,14 @@ UINT    _uxe_host_stack_interface_endpoint_get(UX_INTERFACE *ux_interface, UINT
 UINT    _uxe_host_stack_interface_setting_select(UX_INTERFACE *ux_interface);
 UINT    _uxe_host_stack_transfer_request(UX_TRANSFER *transfer_request);
 UINT    _uxe_host_stack_transfer_request_abort(UX_TRANSFER *transfer_request);
+UINT    _uxe_host_stack_transfer_submit(UX_TRANSFER *transfer_request,
+                                    VOID (*completion_function)(UX_TRANSFER *));
+UINT    _uxe_host_stack_transfer_batch_submit(UX_TRANSFER **transfer_requests, ULONG count,
+                                    VOID (*completion_function)(UX_TRANSFER *), ULONG *actual_count);
+#if defined(UX_HOST_DESCRIPTOR_CACHE_ENABLE)
+UINT    _uxe_host_stack_descriptor_cache_add(ULONG vendor_id, ULONG product_id, ULONG bcd_device,
+                                    UINT configuration_index, UCHAR *descriptor, ULONG length);
+#endif
 UINT    _uxe_host_stack_transfer_run(UX_TRANSFER *transfer_request);
 
 
@@ -144,6 +144,29 @@
    The default is UX_ALIGN_8 (0x07) to align allocated memory to 8 bytes.  */
 /* #define UX_ALIGN_MIN UX_ALIGN_8  */
 
+/* Defined, memory copy/set/compare utilities access memory byte by byte only.
+   By default, when source and destination have same word alignment, the
+   memory is accessed word by word (sizeof(ALIGN_TYPE)) from the length of
+   UX_UTILITY_MEMORY_WORD_ACCESS_MIN bytes. Port optimized versions of the
+   utilities could also be used by defining _ux_utility_memory_copy,
+   _ux_utility_memory_set and _ux_utility_memory_compare as macros.  */
+/* #define UX_UTILITY_MEMORY_WORD_ACCESS_DISABLE  */
+/* #define UX_UTILITY_MEMORY_WORD_ACCESS_MIN (UX_UTILITY_MEMORY_WORD_SIZE * 2u)  */
+
+/* Defined, this value is the compiler attribute that lets memory utility words alias
+   UCHAR buffers. The default is __attribute__((__may_alias__)) for GCC compatible
+   compilers; for other compilers word access is disabled unless it's defined.  */
+/* #define UX_UTILITY_MEMORY_WORD_ALIAS __attribute__((__may_alias__))  */
+
+/* Defined, endian helpers (_ux_utility_long_get, _ux_utility_short_put_big_endian ...) are
+   inlined in callers instead of being called. Fields are accessed byte by byte, compilers
+   merge the accesses into native loads/stores or byte swaps where the target allows it.
+   Ports could define UX_UTILITY_LONG_GET(a), UX_UTILITY_LONG_PUT(a,v) and the other access
+   macros with native instructions, e.g., for a little endian core with unaligned access:
+   #define UX_UTILITY_LONG_GET_BIG_ENDIAN(a)  __REV(__UNALIGNED_UINT32_READ(a))
+   The access macros are also used directly for storage CBW/CSW and PIMA container fields.  */
+/* #define UX_UTILITY_ENDIAN_INLINE  */
+
 /* Defined, this value represents how many ticks per seconds for a specific hardware platform. 
    The default is 1000 indicating 1 tick per millisecond.  */
 
@@ -195,6 +218,138 @@
 */
 
 
+/* Defined, this enables transfer queues on EHCI bulk and interrupt endpoints. A class may then
+   issue several transfer requests on the same endpoint, each with its own UX_TRANSFER, without
+   waiting for the previous one to complete. The TDs of the new request are linked behind the TDs
+   pending on the ED so the controller starts it as soon as the previous one is done.
+   If a transfer fails, the transfers queued behind it on the endpoint are aborted too. If a
+   transfer is aborted, only its TDs are removed and the other transfers stay queued.  */
+
+/* #define UX_HCD_EHCI_TRANSFER_QUEUE_ENABLE */
+
+
+/* Defined, this enables the active ED list on EHCI. An interrupt or asynchronous ED is put on the
+   list when TDs are hooked to it and taken off once they are all retired. On each completion
+   interrupt, only the EDs on the list are visited instead of all the interrupt EDs and the whole
+   asynchronous list, so the interrupt processing time does not grow with the number of idle
+   endpoints.  */
+
+/* #define UX_HCD_EHCI_ACTIVE_LIST_ENABLE */
+
+
+/* Defined, this enables long bulk transfer chains on EHCI. Each TD of a bulk transfer carries up
+   to 5 pages from the buffer offset, in whole packets, instead of 16K, so a large transfer needs
+   fewer TDs. Only the last TD of the transfer interrupts on completion. The other IN TDs point
+   their alternate TD to an inactive TD of the controller, so a short packet stops the queue and
+   the transfer completes at once. One TD is taken from the pool for this when the controller is
+   initialized.  */
+
+/* #define UX_HCD_EHCI_BULK_CHAIN_ENABLE */
+
+
+/* Defined, this enables the EHCI interrupt threshold API. ux_hcd_ehci_interrupt_threshold_set sets
+   the maximum rate of transfer interrupts, from 1 to 64 micro-frames, or the adaptive mode where
+   the threshold is raised under sustained bulk load and lowered when isochronous or fast interrupt
+   endpoints are present. ux_hcd_ehci_interrupt_threshold_get returns the threshold in use and the
+   number of transfer interrupts per MB transferred since the threshold was last set, 0 before the
+   first MB.  */
+
+/* #define UX_HCD_EHCI_INTERRUPT_THRESHOLD_ENABLE */
+
+
+/* Defined, this enables batched unlink of EHCI asynchronous EDs. An ED removed from the
+   asynchronous list is queued instead of waiting for its own doorbell, and all the EDs queued
+   are freed together by the interrupt handler on the next Interrupt on Async Advance. EDs
+   removed while a doorbell is pending are freed on the next one, rung as soon as the pending
+   one completes. Removing many endpoints, as on detach of a composite device or a hub, then
+   does not wait for one doorbell per endpoint.  */
+
+/* #define UX_HCD_EHCI_UNLINK_BATCH_ENABLE */
+
+
+/* Defined, this enables HCD thread events. Each controller sets its own pending bit when it has
+   work to do, and the HCD thread processes all pending controllers in one pass instead of
+   scanning every controller on each wake up. Signals that arrive while a controller is already
+   pending do not wake the thread again. UX_MAX_HCD must not be more than 32.
+   Controller drivers must signal work with UX_HOST_HCD_THREAD_SIGNAL, a driver that puts
+   ux_system_host_hcd_semaphore directly is not processed. Not supported in standalone mode.  */
+
+/* #define UX_HOST_HCD_THREAD_EVENT_ENABLE */
+
+/* Defined, this creates one thread for each registered controller, so the work of a controller
+   is not delayed by the work of other controllers. Each thread uses a stack of
+   UX_HOST_HCD_THREAD_STACK_SIZE bytes, allocated when the controller is registered.
+   It implies UX_HOST_HCD_THREAD_EVENT_ENABLE.  */
+
+/* #define UX_HOST_HCD_THREAD_PER_HCD_ENABLE */
+
+
+/* Defined, this enables parallel enumeration of devices. Only the steps done while the device
+   answers address 0 (port reset and SET_ADDRESS) are done one device at a time by the
+   enumeration thread. The wait after SET_ADDRESS and the descriptors read are done by
+   UX_HOST_ENUM_PARALLEL_THREADS worker threads, so devices behind a hub are enumerated at the
+   same time. Class activation is still done by the enumeration thread. A device whose
+   descriptors can not be read is removed and its port is reset and enumerated again, with the
+   retries left for the port. Each worker thread uses a stack of
+   UX_HOST_ENUM_WORKER_THREAD_STACK_SIZE bytes. Not supported in standalone mode.  */
+
+/* #define UX_HOST_ENUM_PARALLEL_ENABLE */
+
+/* #define UX_HOST_ENUM_PARALLEL_THREADS 2 */
+
+
+/* Defined, this enables the descriptor cache. The configuration descriptors read from a device
+   are kept in a cache of UX_HOST_DESCRIPTOR_CACHE_ENTRIES entries, identified by the vendor ID,
+   product ID and release number of the device. When the device is enumerated again, only the
+   configuration descriptor header is read, the rest is taken from the cache if the header is
+   the same. Configurations longer than UX_HOST_DESCRIPTOR_CACHE_MAX_LENGTH are not cached.
+   ux_host_stack_descriptor_cache_callback_set and ux_host_stack_descriptor_cache_add can be
+   used to save the cache and restore it on next run.  */
+
+/* #define UX_HOST_DESCRIPTOR_CACHE_ENABLE */
+
+/* #define UX_HOST_DESCRIPTOR_CACHE_ENTRIES 4 */
+
+
+/* Defined, this enables the class match index. The class found for a query (by vendor ID and
+   product ID, or by class, subclass and protocol) is kept in an index of
+   UX_HOST_CLASS_MATCH_INDEX_SIZE entries (power of 2), so the same interface or device found
+   again is matched without calling all the registered classes. The index is cleared when a
+   class is registered or unregistered. A query is indexed only if every class called for it
+   has been enabled with ux_host_stack_class_match_index_enable, whose QUERY command must then
+   depend only on the vendor/product IDs or the class, subclass and protocol codes.  */
+
+/* #define UX_HOST_CLASS_MATCH_INDEX_ENABLE */
+
+/* #define UX_HOST_CLASS_MATCH_INDEX_SIZE 16 */
+
+
+/* Defined, this enables the adaptive enumeration timing. Devices on root hub ports are
+   enumerated with the spec minimum delays (UX_HOST_ENUM_PORT_ENABLE_WAIT_MIN,
+   UX_HOST_ENUM_DEVICE_ADDRESS_SET_WAIT_MIN, UX_HOST_ENUM_HS_HANDSHAKE_SUSPEND_WAIT_MIN)
+   instead of the fixed delays sized for the slowest devices. Once a device fails to enumerate
+   on a port, the fixed delays are used on this port until a device is enumerated on it or it is
+   disconnected, and the delay before retry backs off from UX_HOST_ENUM_RETRY_DELAY_MIN. The
+   time of each enumeration phase (reset, address, device descriptor, configuration and class)
+   is kept in ticks in ux_device_enum_phase_time.
+   Not supported in standalone mode.  */
+
+/* #define UX_HOST_ENUM_ADAPTIVE_TIMING_ENABLE */
+
+
+/* Defined, this enables the periodic schedule of the host stack. Instead of a single bandwidth
+   budget per bus, interrupt and isochronous endpoints are placed in the (frame, microframe) slots
+   of a UX_HOST_PERIODIC_FRAMES frames schedule (power of 2), at the offset in their polling
+   period that gives the lowest peak load. The EHCI and OHCI controllers link the endpoint in the
+   frame and microframe of that offset. Split transactions of full and low speed devices
+   behind a high speed hub are also budgeted per frame of the hub TT. Endpoints that do not fit
+   are refused with UX_NO_BANDWIDTH_AVAILABLE. Only available if UX_MAX_DEVICES > 1.  */
+
+/* #define UX_HOST_PERIODIC_SCHEDULE_ENABLE */
+
+/* #define UX_HOST_PERIODIC_FRAMES 32 */
+
+
 /* Defined, this value represents the maximum number of devices that can be attached to the USB.
    Normally, the theoretical maximum number on a single USB is 127 devices. This value can be 
    scaled down to conserve memory. Note that this value represents the total number of devices 
@@ -371,6 +526,86 @@
 
 /* #define UX_ENFORCE_SAFE_ALIGNMENT   */
 
+/* Defined, this value enables slab size classes in memory pools. Freed small blocks
+   allocated without specific alignment are cached per size class and reused by next
+   allocations of the class without searching the pool. Cached blocks are released to
+   the pool when it's not able to satisfy an allocation. Block sizes are rounded up to
+   the class size, UX_MEMORY_SLAB_CLASS_NUM classes are doubled in size from
+   UX_MEMORY_SLAB_SIZE_MIN (16, 32 ... 512 bytes by default).
+   Cached blocks are taken and put back with interrupts locked out for a few
+   instructions, without the mutex of the pool, and they are counted as allocated in
+   memory statistics.
+*/
+
+/* #define UX_ENABLE_MEMORY_SLAB   */
+/* #define UX_MEMORY_SLAB_CLASS_NUM    6   */
+/* #define UX_MEMORY_SLAB_SIZE_MIN     16  */
+
+/* Defined, this enables TLSF (two-level segregated fit) memory pools. Free blocks are
+   kept in size segregated lists indexed by two levels of bitmaps, so a fitting block is
+   found without walking the pool, and freed blocks are merged with free neighbors
+   immediately. Each block header is extended by one pointer to the previous block.
+   UX_MEMORY_TLSF_SL_LOG2 is log2 of the number of second level lists per power of two
+   (3 by default) and UX_MEMORY_TLSF_FL_INDEX_MAX is log2 of the largest indexed block
+   size (24 by default), larger blocks share the last list. Only the first block of one list
+   is checked, so an allocation may fail while a block of nearly the same size is free
+   behind it in its list.
+*/
+
+/* #define UX_ENABLE_MEMORY_TLSF   */
+/* #define UX_MEMORY_TLSF_SL_LOG2      3   */
+/* #define UX_MEMORY_TLSF_FL_INDEX_MAX 24  */
+
+/* Defined, this enables memory telemetry of byte pools, for sizing pools and buffers from
+   real traffic. Each pool logs histograms of allocation latency and of blocks walked by
+   searches, fragments and largest free block watermarks, and allocations by sites. It's
+   read by ux_utility_memory_telemetry_get, cleared by ux_utility_memory_telemetry_reset
+   and dumped as text lines by ux_utility_memory_telemetry_dump. Histograms have
+   UX_MEMORY_TELEMETRY_HISTOGRAM_SIZE power of two buckets (16 by default), up to
+   UX_MEMORY_TELEMETRY_SITE_NUM sites are logged (8 by default). Latency is measured by
+   UX_MEMORY_TELEMETRY_TIME_GET (system ticks by default, a cycle counter can be used) and
+   sites are identified by UX_MEMORY_TELEMETRY_SITE_GET (the calling thread by default,
+   (ALIGN_TYPE)__builtin_return_address(0) identifies calling functions with GCC).
+*/
+
+/* #define UX_ENABLE_MEMORY_TELEMETRY   */
+/* #define UX_MEMORY_TELEMETRY_HISTOGRAM_SIZE  16  */
+/* #define UX_MEMORY_TELEMETRY_SITE_NUM        8   */
+
+/* Defined, this enables the DMA buffer pool. UX_MEMORY_DMA_POOL_BLOCK_NUM blocks of
+   UX_MEMORY_DMA_POOL_BLOCK_SIZE bytes (8 of 512 by default) are reserved from the cache
+   safe memory pool at ux_system_initialize, aligned to UX_MEMORY_DMA_POOL_ALIGN + 1
+   (32 by default, the cache line size). Transfer buffers allocated per operation by host
+   storage and PIMA classes are then taken and returned in constant time, without
+   touching the byte pools. UX_MEMORY_DMA_POOL_QUOTAS limits the blocks each owner
+   (UX_MEMORY_DMA_OWNER_*) may take, e.g. { 4, 4, 0 }. Requests larger than a block or
+   beyond the quota fall back to the cache safe byte pool.
+*/
+
+/* #define UX_ENABLE_MEMORY_DMA_POOL   */
+/* #define UX_MEMORY_DMA_POOL_BLOCK_SIZE   512 */
+/* #define UX_MEMORY_DMA_POOL_BLOCK_NUM    8   */
+
+/* Defined, this groups the fields of UX_TRANSFER and UX_SLAVE_TRANSFER that are touched on
+   every transfer and completion (status, lengths, data pointer, completion code, function,
+   state or semaphore) at the start of the structures, so a completion touches fewer cache
+   lines. Setup, timeout and linking fields follow. Only the member order changes, the
+   structures keep a single definition with the same members.
+*/
+
+/* #define UX_ENABLE_TRANSFER_HOT_LAYOUT   */
+
+/* Defined, this enables transfer segments. UX_TRANSFER and UX_SLAVE_TRANSFER then have a list of
+   segments (ux_transfer_request_segments and ux_transfer_request_segment_count, or the
+   ux_slave_transfer_request_ equivalents) that describe the data in several buffers instead of
+   the data pointer. The requested length must be the sum of the segment lengths, and every
+   segment but the last one must be a multiple of the endpoint max packet size.
+   Segments are supported on bulk transfers by the EHCI, OHCI and simulator controllers. With
+   NetX packet chain support, the host CDC-ECM class sends packet chains as segments when they
+   fit, instead of copying them to the transmit buffer.  */
+
+/* #define UX_TRANSFER_SEGMENTS_ENABLE     */
+
 /* Defined, this value represents the number of packets in the CDC_ECM device class.
    The default is 16.
 */
@@ -520,6 +755,16 @@
 
 /* #define UX_HOST_DEVICE_CLASS_CODE_VALIDATION_ENABLE  */
 
+/* Defined, this macro enables host configuration arena. Interface and endpoint
+   containers of a configuration are allocated from a single memory block, sized
+   from the interface and endpoint descriptors found in its wTotalLength bytes
+   configuration descriptor, and the block is released in one operation when the
+   device is removed. It reduces allocations and fragmentation of the regular
+   memory pool when devices are attached and detached repeatedly.
+ */
+
+/* #define UX_HOST_DEVICE_ARENA_ENABLE  */
+
 
 /* Defined, host HID interrupt OUT transfer is supported.  */
 
@@ -61,6 +61,16 @@
 /*                                            added new function to check */
 /*                                            parsed size of descriptor,  */
 /*                                            resulting in version 6.3.0  */
+/*  xx-xx-xxxx     Mohamed ayed             Modified comment(s),          */
+/*                                            allowed port defined memory */
+/*                                            copy/set/compare, added     */
+/*                                            memory slab, TLSF and       */
+/*                                            telemetry functions, added  */
+/*                                            descriptor unpack functions,*/
+/*                                            added DMA pool functions,   */
+/*                                            added endian field access   */
+/*                                            macros and inline helpers,  */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 
@@ -68,27 +78,190 @@
 #define UX_UTILITY_H
 
 
+/* Define descriptor field expansions, used with UX_*_DESCRIPTOR_FIELDS lists
+   to generate descriptor structure arrays and unpack functions.  */
+
+#define UX_DESCRIPTOR_FIELD_SIZE(size, name)                    size,
+#define UX_DESCRIPTOR_FIELD_UNPACK(size, name)                                  \
+    descriptor -> name =  UX_DESCRIPTOR_FIELD_GET_##size(raw_descriptor);       \
+    raw_descriptor +=  size;
+#define UX_DESCRIPTOR_FIELD_GET_1(raw)                          (*(raw))
+#define UX_DESCRIPTOR_FIELD_GET_2(raw)                          ((USHORT)((USHORT)(raw)[0] | (USHORT)((raw)[1] << 8)))
+#define UX_DESCRIPTOR_FIELD_GET_4(raw)                          _ux_utility_long_get(raw)
+
+
+/* Define endian field access macros. Fields are assembled byte by byte, which is
+   independent of alignment and lets the compiler merge the accesses into native
+   loads/stores or byte swaps where the target allows it. Arguments may be evaluated
+   more than once. Ports could define them with native instructions in ux_port.h or
+   ux_user.h.  */
+
+#ifndef UX_UTILITY_LONG_GET
+#define UX_UTILITY_LONG_GET(a)                                                  \
+    ((ULONG)(a)[0] | ((ULONG)(a)[1] << 8) | ((ULONG)(a)[2] << 16) | ((ULONG)(a)[3] << 24))
+#endif
+#ifndef UX_UTILITY_LONG_GET_BIG_ENDIAN
+#define UX_UTILITY_LONG_GET_BIG_ENDIAN(a)                                       \
+    ((ULONG)(a)[3] | ((ULONG)(a)[2] << 8) | ((ULONG)(a)[1] << 16) | ((ULONG)(a)[0] << 24))
+#endif
+#ifndef UX_UTILITY_SHORT_GET
+#define UX_UTILITY_SHORT_GET(a)             ((ULONG)(a)[0] | ((ULONG)(a)[1] << 8))
+#endif
+#ifndef UX_UTILITY_SHORT_GET_BIG_ENDIAN
+#define UX_UTILITY_SHORT_GET_BIG_ENDIAN(a)  ((ULONG)(a)[1] | ((ULONG)(a)[0] << 8))
+#endif
+#ifndef UX_UTILITY_LONG_PUT
+#define UX_UTILITY_LONG_PUT(a, v)                                               \
+    do { (a)[0] = (UCHAR)(v); (a)[1] = (UCHAR)((v) >> 8);                       \
+         (a)[2] = (UCHAR)((v) >> 16); (a)[3] = (UCHAR)((v) >> 24); } while(0)
+#endif
+#ifndef UX_UTILITY_LONG_PUT_BIG_ENDIAN
+#define UX_UTILITY_LONG_PUT_BIG_ENDIAN(a, v)                                    \
+    do { (a)[3] = (UCHAR)(v); (a)[2] = (UCHAR)((v) >> 8);                       \
+         (a)[1] = (UCHAR)((v) >> 16); (a)[0] = (UCHAR)((v) >> 24); } while(0)
+#endif
+#ifndef UX_UTILITY_SHORT_PUT
+#define UX_UTILITY_SHORT_PUT(a, v)                                              \
+    do { (a)[0] = (UCHAR)(v); (a)[1] = (UCHAR)((v) >> 8); } while(0)
+#endif
+#ifndef UX_UTILITY_SHORT_PUT_BIG_ENDIAN
+#define UX_UTILITY_SHORT_PUT_BIG_ENDIAN(a, v)                                   \
+    do { (a)[1] = (UCHAR)(v); (a)[0] = (UCHAR)((v) >> 8); } while(0)
+#endif
+
+/* Define endian helpers. When UX_UTILITY_ENDIAN_INLINE is defined, the helpers are
+   inlined in callers with the access macros. Ports could also define the function
+   names (e.g., _ux_utility_long_get) as macros in ux_port.h or ux_user.h.  */
+
+#if defined(UX_UTILITY_ENDIAN_INLINE)
+
+#ifndef UX_UTILITY_INLINE
+#define UX_UTILITY_INLINE                   static inline
+#endif
+
+UX_UTILITY_INLINE ULONG _ux_utility_long_get_inline(UCHAR *address)
+{
+    return(UX_UTILITY_LONG_GET(address));
+}
+UX_UTILITY_INLINE ULONG _ux_utility_long_get_big_endian_inline(UCHAR *address)
+{
+    return(UX_UTILITY_LONG_GET_BIG_ENDIAN(address));
+}
+UX_UTILITY_INLINE ULONG _ux_utility_short_get_inline(UCHAR *address)
+{
+    return(UX_UTILITY_SHORT_GET(address));
+}
+UX_UTILITY_INLINE ULONG _ux_utility_short_get_big_endian_inline(UCHAR *address)
+{
+    return(UX_UTILITY_SHORT_GET_BIG_ENDIAN(address));
+}
+UX_UTILITY_INLINE VOID _ux_utility_long_put_inline(UCHAR *address, ULONG value)
+{
+    UX_UTILITY_LONG_PUT(address, value);
+}
+UX_UTILITY_INLINE VOID _ux_utility_long_put_big_endian_inline(UCHAR *address, ULONG value)
+{
+    UX_UTILITY_LONG_PUT_BIG_ENDIAN(address, value);
+}
+UX_UTILITY_INLINE VOID _ux_utility_short_put_inline(UCHAR *address, USHORT value)
+{
+    UX_UTILITY_SHORT_PUT(address, value);
+}
+UX_UTILITY_INLINE VOID _ux_utility_short_put_big_endian_inline(UCHAR *address, USHORT value)
+{
+    UX_UTILITY_SHORT_PUT_BIG_ENDIAN(address, value);
+}
+
+#ifndef _ux_utility_long_get
+#define _ux_utility_long_get(a)                         _ux_utility_long_get_inline(a)
+#endif
+#ifndef _ux_utility_long_get_big_endian
+#define _ux_utility_long_get_big_endian(a)              _ux_utility_long_get_big_endian_inline(a)
+#endif
+#ifndef _ux_utility_short_get
+#define _ux_utility_short_get(a)                        _ux_utility_short_get_inline(a)
+#endif
+#ifndef _ux_utility_short_get_big_endian
+#define _ux_utility_short_get_big_endian(a)             _ux_utility_short_get_big_endian_inline(a)
+#endif
+#ifndef _ux_utility_long_put
+#define _ux_utility_long_put(a, v)                      _ux_utility_long_put_inline(a, v)
+#endif
+#ifndef _ux_utility_long_put_big_endian
+#define _ux_utility_long_put_big_endian(a, v)           _ux_utility_long_put_big_endian_inline(a, v)
+#endif
+#ifndef _ux_utility_short_put
+#define _ux_utility_short_put(a, v)                     _ux_utility_short_put_inline(a, v)
+#endif
+#ifndef _ux_utility_short_put_big_endian
+#define _ux_utility_short_put_big_endian(a, v)          _ux_utility_short_put_big_endian_inline(a, v)
+#endif
+#endif
+
+
 /* Define Utility component function prototypes.  */
 
 VOID             _ux_utility_descriptor_parse(UCHAR * raw_descriptor, UCHAR * descriptor_structure,
                              UINT descriptor_entries, UCHAR * descriptor);
+VOID             _ux_utility_descriptor_unpack_bos(UCHAR * raw_descriptor, UX_BOS_DESCRIPTOR * descriptor);
+VOID             _ux_utility_descriptor_unpack_configuration(UCHAR * raw_descriptor, UX_CONFIGURATION_DESCRIPTOR * descriptor);
+VOID             _ux_utility_descriptor_unpack_device(UCHAR * raw_descriptor, UX_DEVICE_DESCRIPTOR * descriptor);
+VOID             _ux_utility_descriptor_unpack_endpoint(UCHAR * raw_descriptor, UX_ENDPOINT_DESCRIPTOR * descriptor);
+VOID             _ux_utility_descriptor_unpack_interface(UCHAR * raw_descriptor, UX_INTERFACE_DESCRIPTOR * descriptor);
+VOID             _ux_utility_descriptor_unpack_interface_association(UCHAR * raw_descriptor, UX_INTERFACE_ASSOCIATION_DESCRIPTOR * descriptor);
 VOID             _ux_utility_descriptor_pack(UCHAR * descriptor, UCHAR * descriptor_structure,
                              UINT descriptor_entries, UCHAR * raw_descriptor);
 ULONG            _ux_utility_descriptor_parse_size(UCHAR * descriptor_structure, UINT descriptor_entries, UINT size_align_mask);
 
+#ifndef _ux_utility_long_get
 ULONG            _ux_utility_long_get(UCHAR * address);
+#endif
+#ifndef _ux_utility_long_put
 VOID             _ux_utility_long_put(UCHAR * address, ULONG value);
+#endif
+#ifndef _ux_utility_long_put_big_endian
 VOID             _ux_utility_long_put_big_endian(UCHAR * address, ULONG value);
+#endif
+#ifndef _ux_utility_long_get_big_endian
 ULONG            _ux_utility_long_get_big_endian(UCHAR * address);
+#endif
 VOID            *_ux_utility_memory_allocate(ULONG memory_alignment,ULONG memory_cache_flag, ULONG memory_size_requested);
-UINT             _ux_utility_memory_compare(VOID *memory_source, VOID *memory_destination, ULONG length);
-VOID             _ux_utility_memory_copy(VOID *memory_destination, VOID *memory_source, ULONG length);
 VOID             _ux_utility_memory_free(VOID *memory);
 ULONG            _ux_utility_string_length_get(UCHAR *string);
 UINT             _ux_utility_string_length_check(UCHAR *input_string, UINT *string_length_ptr, UINT max_string_length);
+#ifdef UX_ENABLE_MEMORY_TLSF
+#define _ux_utility_memory_byte_pool_search             _ux_utility_memory_tlsf_search
+#endif
 UCHAR           *_ux_utility_memory_byte_pool_search(UX_MEMORY_BYTE_POOL *pool_ptr, ULONG memory_size);
 UINT             _ux_utility_memory_byte_pool_create(UX_MEMORY_BYTE_POOL *pool_ptr, VOID *pool_start, ULONG pool_size);
-VOID             _ux_utility_memory_set(VOID *destination, UCHAR value, ULONG length);
+#ifdef UX_ENABLE_MEMORY_DMA_POOL
+UINT             _ux_utility_memory_dma_pool_create(VOID);
+VOID            *_ux_utility_memory_dma_allocate(ULONG owner, ULONG memory_size_requested);
+VOID             _ux_utility_memory_dma_free(VOID *memory);
+#endif
+#ifdef UX_ENABLE_MEMORY_SLAB
+VOID            *_ux_utility_memory_slab_allocate(UX_MEMORY_SLAB *slab_ptr);
+UINT             _ux_utility_memory_slab_free(UCHAR *block_ptr);
+ULONG            _ux_utility_memory_slab_flush(UX_MEMORY_BYTE_POOL *pool_ptr);
+#endif
+#ifdef UX_ENABLE_MEMORY_TLSF
+#ifndef _ux_utility_memory_tlsf_fls
+UINT             _ux_utility_memory_tlsf_fls(ULONG value);
+#endif
+VOID             _ux_utility_memory_tlsf_mapping(ULONG memory_size, UINT round_up, UINT *fl_index, UINT *sl_index);
+VOID             _ux_utility_memory_tlsf_insert(UX_MEMORY_BYTE_POOL *pool_ptr, UCHAR *block_ptr);
+VOID             _ux_utility_memory_tlsf_remove(UX_MEMORY_BYTE_POOL *pool_ptr, UCHAR *block_ptr);
+VOID             _ux_utility_memory_tlsf_split(UX_MEMORY_BYTE_POOL *pool_ptr, UCHAR *block_ptr, UCHAR *free_block_ptr);
+VOID             _ux_utility_memory_tlsf_free(UX_MEMORY_BYTE_POOL *pool_ptr, UCHAR *block_ptr);
+#endif
+#ifdef UX_ENABLE_MEMORY_TELEMETRY
+VOID             _ux_utility_memory_telemetry_histogram_add(UX_MEMORY_HISTOGRAM *histogram, ULONG value);
+ULONG            _ux_utility_memory_telemetry_largest_free_get(UX_MEMORY_BYTE_POOL *pool_ptr, ULONG *free_blocks);
+VOID             _ux_utility_memory_telemetry_record(UX_MEMORY_BYTE_POOL *pool_ptr, ALIGN_TYPE site_id, ULONG memory_size, ULONG start_time, UINT status);
+UINT             _ux_utility_memory_telemetry_get(ULONG memory_cache_flag, UX_MEMORY_TELEMETRY *telemetry);
+UINT             _ux_utility_memory_telemetry_reset(ULONG memory_cache_flag);
+VOID             _ux_utility_memory_telemetry_dump(VOID (*dump_callback)(UCHAR *line, ULONG line_length));
+#endif
 ULONG            _ux_utility_pci_class_scan(ULONG pci_class, ULONG bus_number, ULONG device_number,
                             ULONG function_number, ULONG *current_bus_number,
                             ULONG *current_device_number, ULONG *current_function_number);
@@ -98,10 +271,18 @@ VOID             _ux_utility_pci_write(ULONG bus_number, ULONG device_number, UL
                              ULONG offset, ULONG value, UINT write_size);
 VOID            *_ux_utility_physical_address(VOID *virtual_address);
 VOID             _ux_utility_set_interrupt_handler(UINT irq, VOID (*interrupt_handler)(VOID));
+#ifndef _ux_utility_short_get
 ULONG            _ux_utility_short_get(UCHAR * address);
+#endif
+#ifndef _ux_utility_short_get_big_endian
 ULONG            _ux_utility_short_get_big_endian(UCHAR * address);
+#endif
+#ifndef _ux_utility_short_put
 VOID             _ux_utility_short_put(UCHAR * address, USHORT value);
+#endif
+#ifndef _ux_utility_short_put_big_endian
 VOID             _ux_utility_short_put_big_endian(UCHAR * address, USHORT value);
+#endif
 VOID            *_ux_utility_virtual_address(VOID *physical_address);
 VOID             _ux_utility_unicode_to_string(UCHAR *source, UCHAR *destination);
 VOID             _ux_utility_string_to_unicode(UCHAR *source, UCHAR *destination);
@@ -171,6 +352,20 @@ extern  ULONG       _ux_utility_time_get(VOID);
 extern  ULONG       _ux_utility_time_get(VOID);
 #endif
 
+/* Memory copy/set/compare could be replaced by port optimized (e.g., SIMD) versions,
+   by defining the function names as macros in ux_port.h or ux_user.h.  */
+#ifndef             _ux_utility_memory_compare
+UINT                _ux_utility_memory_compare(VOID *memory_source, VOID *memory_destination, ULONG length);
+#endif
+
+#ifndef             _ux_utility_memory_copy
+VOID                _ux_utility_memory_copy(VOID *memory_destination, VOID *memory_source, ULONG length);
+#endif
+
+#ifndef             _ux_utility_memory_set
+VOID                _ux_utility_memory_set(VOID *destination, UCHAR value, ULONG length);
+#endif
+
 #ifndef             _ux_utility_time_elapsed
 #define             _ux_utility_time_elapsed(a,b)          (((b)>=(a)) ? ((b)-(a)) : (0xFFFFFFFFul-(b)+(a)+1))
 #else
@@ -457,6 +652,12 @@ VOID*            _ux_utility_memory_allocate_add_safe(ULONG align,ULONG cache,UL
 
 #define ux_utility_time_get                            _ux_utility_time_get
 #define ux_utility_time_elapsed                        _ux_utility_time_elapsed
+
+#ifdef UX_ENABLE_MEMORY_TELEMETRY
+#define ux_utility_memory_telemetry_get                _ux_utility_memory_telemetry_get
+#define ux_utility_memory_telemetry_reset              _ux_utility_memory_telemetry_reset
+#define ux_utility_memory_telemetry_dump               _ux_utility_memory_telemetry_dump
+#endif
 #endif
 
 #endif
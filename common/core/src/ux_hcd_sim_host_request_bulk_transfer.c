@@ -73,6 +73,10 @@
 /*  12-31-2020     Chaoqiong Xiao           Modified comment(s),          */
 /*                                            fixed ZLP sending,          */
 /*                                            resulting in version 6.1.3  */
+/*  xx-xx-xxxx     Mohamed ayed             Modified comment(s),          */
+/*                                            added transfer segments     */
+/*                                            support,                    */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_hcd_sim_host_request_bulk_transfer(UX_HCD_SIM_HOST *hcd_sim_host, UX_TRANSFER *transfer_request)
@@ -88,6 +92,11 @@ UX_HCD_SIM_HOST_ED      *ed;
 ULONG                   transfer_request_payload_length;
 ULONG                   bulk_packet_payload_length;
 UCHAR *                 data_pointer;
+#if defined(UX_TRANSFER_SEGMENTS_ENABLE)
+UX_TRANSFER_SEGMENT     *segment;
+ULONG                   segment_length;
+ULONG                   segment_left;
+#endif
     
 
     /* Get the pointer to the Endpoint.  */
@@ -110,16 +119,57 @@ UCHAR *                 data_pointer;
        in the endpoint descriptor). Host simulator data payload has a maximum size of 4K.  */
     transfer_request_payload_length =  transfer_request -> ux_transfer_request_requested_length;
     data_pointer =  transfer_request -> ux_transfer_request_data_pointer;
+
+#if defined(UX_TRANSFER_SEGMENTS_ENABLE)
+
+    /* With segments, each segment is described by its own TDs, a TD never crosses
+       a segment boundary.  */
+    segment =  transfer_request -> ux_transfer_request_segments;
+    segment_length =  transfer_request_payload_length;
+    segment_left =  0;
+    if (transfer_request -> ux_transfer_request_segment_count != 0)
+    {
+        data_pointer =  segment -> ux_transfer_segment_data_pointer;
+        segment_length =  segment -> ux_transfer_segment_length;
+        segment_left =  transfer_request -> ux_transfer_request_segment_count - 1;
+    }
+#endif
     
     do
     {
 
+#if defined(UX_TRANSFER_SEGMENTS_ENABLE)
+
+        /* Skip the empty segments, up to the last one.  */
+        while ((segment_length == 0) && (transfer_request_payload_length != 0) && (segment_left != 0))
+        {
+            segment ++;
+            segment_left --;
+            data_pointer =  segment -> ux_transfer_segment_data_pointer;
+            segment_length =  segment -> ux_transfer_segment_length;
+        }
+
+        /* The segments may not be longer than the requested length.  */
+        if (segment_length > transfer_request_payload_length)
+            segment_length =  transfer_request_payload_length;
+
+        if (segment_length > UX_HCD_SIM_HOST_MAX_PAYLOAD)
+
+            bulk_packet_payload_length =  UX_HCD_SIM_HOST_MAX_PAYLOAD;
+        else
+
+            bulk_packet_payload_length =  segment_length;
+
+        /* Adjust the length left in this segment.  */
+        segment_length -=  bulk_packet_payload_length;
+#else
         if (transfer_request_payload_length > UX_HCD_SIM_HOST_MAX_PAYLOAD)
 
             bulk_packet_payload_length =  UX_HCD_SIM_HOST_MAX_PAYLOAD;
         else
 
             bulk_packet_payload_length =  transfer_request_payload_length;
+#endif
 
         /* Store the beginning of the buffer address in the TD.  */
         data_td -> ux_sim_host_td_buffer =  data_pointer;
@@ -135,6 +185,13 @@ UCHAR *                 data_pointer;
         transfer_request_payload_length -=  bulk_packet_payload_length;
         data_pointer +=  bulk_packet_payload_length;
 
+#if defined(UX_TRANSFER_SEGMENTS_ENABLE)
+
+        /* The transfer ends with the last segment.  */
+        if ((segment_length == 0) && (segment_left == 0))
+            transfer_request_payload_length =  0;
+#endif
+
         /* The direction of the transaction is set in the TD.  */
         if ((transfer_request -> ux_transfer_request_type & UX_REQUEST_DIRECTION) == UX_REQUEST_IN)
 
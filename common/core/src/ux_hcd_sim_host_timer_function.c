@@ -26,6 +26,7 @@
 
 #include "ux_api.h"
 #include "ux_hcd_sim_host.h"
+#include "ux_host_stack.h"
 
 #if !defined(UX_HOST_STANDALONE)
 #include "tx_timer.h"
@@ -75,6 +76,9 @@
 /*                                            used macros to configure    */
 /*                                            for RTOS mode compile,      */
 /*                                            resulting in version 6.1.10 */
+/*  xx-xx-xxxx     Mohamed ayed             Modified comment(s),          */
+/*                                            used HCD thread signal,     */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 VOID  _ux_hcd_sim_host_timer_function(ULONG hcd_sim_host_addr)
@@ -98,8 +102,7 @@ UX_HCD              *hcd;
     {
 
         /* Wake up the thread for the controller transaction processing.  */
-        hcd -> ux_hcd_thread_signal++;
-        _ux_host_semaphore_put(&_ux_system_host -> ux_system_host_hcd_semaphore);
+        UX_HOST_HCD_THREAD_SIGNAL(hcd);
     }
 }
 #endif
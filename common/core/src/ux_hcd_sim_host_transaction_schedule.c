@@ -30,12 +30,18 @@
 #include "ux_device_stack.h"
 
 
+#if defined(UX_TRANSFER_SEGMENTS_ENABLE)
+static inline VOID _ux_hcd_sim_host_slave_segments_copy(UX_SLAVE_TRANSFER *slave_transfer_request,
+                                                UCHAR *host_buffer, ULONG length, ULONG direction);
+#endif
+
+
 /**************************************************************************/
 /*                                                                        */
 /*  FUNCTION                                               RELEASE        */
 /*                                                                        */
 /*    _ux_hcd_sim_host_transaction_schedule               PORTABLE C      */
-/*                                                           6.1.12       */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -60,6 +66,7 @@
 /*                                          Completion function           */
 /*    _ux_device_stack_control_request_process                            */
 /*                                          Process request               */
+/*    _ux_hcd_sim_host_slave_segments_copy  Copy device segments          */
 /*    _ux_utility_memory_copy               Copy memory block             */
 /*    _ux_utility_semaphore_put             Semaphore put                 */
 /*                                                                        */
@@ -95,6 +102,10 @@
 /*                                            adjusted control request    */
 /*                                            data length handling,       */
 /*                                            resulting in version 6.1.12 */
+/*  xx-xx-xxxx     Mohamed ayed             Modified comment(s),          */
+/*                                            added device transfer       */
+/*                                            segments support,           */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_hcd_sim_host_transaction_schedule(UX_HCD_SIM_HOST *hcd_sim_host, UX_HCD_SIM_HOST_ED *ed)
@@ -410,6 +421,15 @@ UX_SLAVE_DCD            *dcd;
 
             if (transaction_length)
             {
+#if defined(UX_TRANSFER_SEGMENTS_ENABLE)
+                if (slave_transfer_request -> ux_slave_transfer_request_segment_count != 0)
+
+                    /* Move the data between the host TD and the device segments.  */
+                    _ux_hcd_sim_host_slave_segments_copy(slave_transfer_request, td -> ux_sim_host_td_buffer,
+                                                         transaction_length, td -> ux_sim_host_td_direction);
+
+                else
+#endif
                 if (td -> ux_sim_host_td_direction == UX_HCD_SIM_HOST_TD_OUT)
 
                     /* Send the requested host data to the device.  */
@@ -565,3 +585,38 @@ UX_SLAVE_DCD            *dcd;
     return(UX_SUCCESS);
 }
 
+#if defined(UX_TRANSFER_SEGMENTS_ENABLE)
+static inline VOID _ux_hcd_sim_host_slave_segments_copy(UX_SLAVE_TRANSFER *slave_transfer_request,
+                                                UCHAR *host_buffer, ULONG length, ULONG direction)
+{
+UX_TRANSFER_SEGMENT     *segment;
+ULONG                   offset;
+ULONG                   copy_length;
+
+    /* Locate the segment where the data of this transaction starts.  */
+    segment =  slave_transfer_request -> ux_slave_transfer_request_segments;
+    offset =  slave_transfer_request -> ux_slave_transfer_request_actual_length;
+    while (offset >= segment -> ux_transfer_segment_length)
+    {
+        offset -=  segment -> ux_transfer_segment_length;
+        segment ++;
+    }
+
+    /* The transaction may cross segment boundaries on the device side.  */
+    while (length != 0)
+    {
+        copy_length =  UX_MIN(segment -> ux_transfer_segment_length - offset, length);
+        if (direction == UX_HCD_SIM_HOST_TD_OUT)
+            _ux_utility_memory_copy(segment -> ux_transfer_segment_data_pointer + offset,
+                                    host_buffer, copy_length); /* Use case of memcpy is verified. */
+        else
+            _ux_utility_memory_copy(host_buffer,
+                                    segment -> ux_transfer_segment_data_pointer + offset,
+                                    copy_length); /* Use case of memcpy is verified. */
+        host_buffer +=  copy_length;
+        length -=  copy_length;
+        offset =  0;
+        segment ++;
+    }
+}
+#endif
@@ -28,13 +28,13 @@
 #include "ux_host_stack.h"
 
 
-#if UX_MAX_DEVICES > 1
+#if (UX_MAX_DEVICES > 1) && !defined(UX_HOST_PERIODIC_SCHEDULE_ENABLE)
 /**************************************************************************/ 
 /*                                                                        */ 
 /*  FUNCTION                                               RELEASE        */ 
 /*                                                                        */ 
 /*    _ux_host_stack_bandwidth_check                      PORTABLE C      */ 
-/*                                                           6.1          */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -79,6 +79,10 @@
 /*                                            optimized based on compile  */
 /*                                            definitions,                */
 /*                                            resulting in version 6.1    */
+/*  xx-xx-xxxx     Mohamed ayed             Modified comment(s),          */
+/*                                            excluded when periodic      */
+/*                                            schedule is enabled,        */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_host_stack_bandwidth_check(UX_HCD *hcd, UX_ENDPOINT *endpoint)
@@ -271,4 +275,4 @@ const UCHAR     overheads[4][3] = {
     /* We get here when we have not found a 2.0 hub in the list and we got to the root port.  */
     return(UX_SUCCESS);
 }
-#endif /* #if UX_MAX_DEVICES > 1 */
+#endif /* #if (UX_MAX_DEVICES > 1) && !defined(UX_HOST_PERIODIC_SCHEDULE_ENABLE) */
@@ -28,13 +28,13 @@
 #include "ux_host_stack.h"
 
 
-#if UX_MAX_DEVICES > 1
+#if (UX_MAX_DEVICES > 1) && !defined(UX_HOST_PERIODIC_SCHEDULE_ENABLE)
 /**************************************************************************/ 
 /*                                                                        */ 
 /*  FUNCTION                                               RELEASE        */ 
 /*                                                                        */ 
 /*    _ux_host_stack_bandwidth_claim                      PORTABLE C      */ 
-/*                                                           6.1          */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -78,6 +78,10 @@
 /*                                            optimized based on compile  */
 /*                                            definitions,                */
 /*                                            resulting in version 6.1    */
+/*  xx-xx-xxxx     Mohamed ayed             Modified comment(s),          */
+/*                                            excluded when periodic      */
+/*                                            schedule is enabled,        */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 VOID  _ux_host_stack_bandwidth_claim(UX_HCD *hcd, UX_ENDPOINT *endpoint)
@@ -246,4 +250,4 @@ const UCHAR     overheads[4][3] = {
        to the root port.  */
     return;
 }
-#endif /* #if UX_MAX_DEVICES > 1 */
+#endif /* #if (UX_MAX_DEVICES > 1) && !defined(UX_HOST_PERIODIC_SCHEDULE_ENABLE) */
@@ -33,7 +33,7 @@
 /*  FUNCTION                                               RELEASE        */ 
 /*                                                                        */ 
 /*    _ux_host_stack_class_call                           PORTABLE C      */ 
-/*                                                           6.1          */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -43,6 +43,11 @@
 /*    This function will call all the registered classes to the USBX      */
 /*    stack. Each class will have the possibility to own the device or    */
 /*    one of the interfaces of a device.                                  */ 
+/*                                                                        */
+/*    With class match index, the result of a query is indexed by its    */
+/*    (VID, PID) or (class, subclass, protocol) so the same query is      */
+/*    answered without calling the classes. The result is indexed only if */
+/*    all the classes called have their match index enabled.              */
 /*                                                                        */ 
 /*  INPUT                                                                 */ 
 /*                                                                        */ 
@@ -69,6 +74,9 @@
 /*                                            optimized based on compile  */
 /*                                            definitions,                */
 /*                                            resulting in version 6.1    */
+/*  xx-xx-xxxx     Mohamed ayed             Modified comment(s),          */
+/*                                            added class match index,    */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UX_HOST_CLASS  *_ux_host_stack_class_call(UX_HOST_CLASS_COMMAND *class_command)
@@ -78,6 +86,38 @@ UINT            status = UX_NO_CLASS_MATCH;
 UX_HOST_CLASS   *class_inst;
 #if UX_MAX_CLASS_DRIVER > 1
 ULONG           class_index;
+#endif
+#if defined(UX_HOST_CLASS_MATCH_INDEX_ENABLE)
+UX_HOST_CLASS_MATCH *match;
+ULONG           key;
+ULONG           key_ext;
+ULONG           hash;
+UINT            indexable = UX_TRUE;
+
+
+    /* Build the index key of the query. VID and PID are only set for a PID/VID query.  */
+    key =  (ULONG)(class_command -> ux_host_class_command_usage & 0xFFu) << 24;
+    if (class_command -> ux_host_class_command_usage == UX_HOST_CLASS_COMMAND_USAGE_PIDVID)
+    {
+        key_ext =  ((ULONG)(class_command -> ux_host_class_command_vid & 0xFFFFu) << 16) |
+                   (ULONG)(class_command -> ux_host_class_command_pid & 0xFFFFu);
+    }
+    else
+    {
+        key |=  ((ULONG)(class_command -> ux_host_class_command_class & 0xFFu) << 16) |
+                ((ULONG)(class_command -> ux_host_class_command_subclass & 0xFFu) << 8) |
+                (ULONG)(class_command -> ux_host_class_command_protocol & 0xFFu);
+        key_ext =  ((ULONG)(class_command -> ux_host_class_command_iad_class & 0xFFu) << 16) |
+                   ((ULONG)(class_command -> ux_host_class_command_iad_subclass & 0xFFu) << 8) |
+                   (ULONG)(class_command -> ux_host_class_command_iad_protocol & 0xFFu);
+    }
+
+    /* The same query has been answered, no need to call the classes.  */
+    hash =  key ^ (key_ext * 0x9E3779B1u);
+    hash ^=  hash >> 16;
+    match =  &_ux_system_host -> ux_system_host_class_match_index[hash & (UX_HOST_CLASS_MATCH_INDEX_SIZE - 1)];
+    if ((match -> ux_host_class_match_key == key) && (match -> ux_host_class_match_key_ext == key_ext))
+        return(match -> ux_host_class_match_class);
 #endif
 
     /* Start from the 1st registered classes with USBX.  */
@@ -92,6 +132,12 @@ ULONG           class_index;
         /* Check if this class driver is used.  */
         if (class_inst -> ux_host_class_status == UX_USED)
         {
+#if defined(UX_HOST_CLASS_MATCH_INDEX_ENABLE)
+
+            /* The answer of a class not enabled may depend on other fields.  */
+            if (class_inst -> ux_host_class_match_index_enable != UX_TRUE)
+                indexable =  UX_FALSE;
+#endif
 
             /* We have found a potential candidate. Call this registered class entry function.  */
             status = class_inst -> ux_host_class_entry_function(class_command);
@@ -99,6 +145,16 @@ ULONG           class_index;
             /* The status tells us if the registered class wants to own this class.  */
             if (status == UX_SUCCESS)
             {
+#if defined(UX_HOST_CLASS_MATCH_INDEX_ENABLE)
+
+                /* Index the class for the same queries.  */
+                if (indexable)
+                {
+                    match -> ux_host_class_match_key =  key;
+                    match -> ux_host_class_match_key_ext =  key_ext;
+                    match -> ux_host_class_match_class =  class_inst;
+                }
+#endif
 
                 /* Yes, return this class pointer.  */
                 return(class_inst); 
@@ -110,6 +166,17 @@ ULONG           class_index;
     }
 #endif
 
+#if defined(UX_HOST_CLASS_MATCH_INDEX_ENABLE)
+
+    /* Index the query with no class either.  */
+    if (indexable)
+    {
+        match -> ux_host_class_match_key =  key;
+        match -> ux_host_class_match_key_ext =  key_ext;
+        match -> ux_host_class_match_class =  UX_NULL;
+    }
+#endif
+
     /* There is no driver who want to own this class!  */
     return(UX_NULL);
 }
@@ -0,0 +1,118 @@
+/***************************************************************************
+ * Copyright (c) 2024 Microsoft Corporation 
+ * 
+ * This program and the accompanying materials are made available under the
+ * terms of the MIT License which is available at
+ * https://opensource.org/licenses/MIT.
+ * 
+ * SPDX-License-Identifier: MIT
+ **************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** USBX Component                                                        */
+/**                                                                       */
+/**   Host Stack                                                          */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+
+/* Include necessary system files.  */
+
+#define UX_SOURCE_CODE
+
+#include "ux_api.h"
+#include "ux_host_stack.h"
+
+
+#if defined(UX_HOST_CLASS_MATCH_INDEX_ENABLE)
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_host_stack_class_match_index_enable             PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function enables the class match index for a registered        */
+/*    class. Queries answered by enabled classes only are indexed, the    */
+/*    same queries are then answered without calling the classes.         */
+/*                                                                        */
+/*    Note the QUERY command of the class must depend only on the vendor  */
+/*    and product IDs, or on the class, subclass and protocol codes (and  */
+/*    the IAD ones) of the query.                                         */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    class_entry_function                  Entry function of the class   */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    Completion Status                                                   */
+/*    UX_SUCCESS                            Class index enabled           */
+/*    UX_NO_CLASS_MATCH                     Class not found               */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    Application                                                         */
+/*    USBX Components                                                     */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Mohamed ayed             Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+UINT  _ux_host_stack_class_match_index_enable(UINT (*class_entry_function)(struct UX_HOST_CLASS_COMMAND_STRUCT *))
+{
+
+UX_HOST_CLASS           *class_inst;
+#if UX_MAX_CLASS_DRIVER > 1
+ULONG                   class_index;
+#endif
+
+
+    /* Get first class.  */
+    class_inst =  _ux_system_host -> ux_system_host_class_array;
+
+#if UX_MAX_CLASS_DRIVER > 1
+    /* We need to parse the class table to find right class instance.  */
+    for (class_index = 0; class_index < _ux_system_host -> ux_system_host_max_class; class_index++)
+    {
+#endif
+
+        /* Check if the class is expected.  */
+        if ((class_inst -> ux_host_class_status == UX_USED) &&
+            (class_inst -> ux_host_class_entry_function == class_entry_function))
+        {
+
+            /* Queries answered by this class can be indexed from now on, indexed
+               queries are still valid.  */
+            class_inst -> ux_host_class_match_index_enable =  UX_TRUE;
+
+            /* Class index enabled.  */
+            return(UX_SUCCESS);
+        }
+
+#if UX_MAX_CLASS_DRIVER > 1
+        /* Move to the next class.  */
+        class_inst ++;
+    }
+#endif
+
+    /* No more entries in the class table.  */
+    return(UX_NO_CLASS_MATCH);
+}
+#endif
@@ -33,7 +33,7 @@
 /*  FUNCTION                                               RELEASE        */
 /*                                                                        */
 /*    _ux_host_stack_class_register                       PORTABLE C      */
-/*                                                           6.1          */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -66,6 +66,7 @@
 /*    _ux_utility_string_length_check       Check C string and return     */
 /*                                          length if null-terminated     */
 /*    _ux_utility_memory_copy               Copy memory block             */
+/*    _ux_utility_memory_set                Set memory to a value         */
 /*                                                                        */
 /*  CALLED BY                                                             */
 /*                                                                        */
@@ -82,6 +83,9 @@
 /*                                            definitions, verified       */
 /*                                            memset and memcpy cases,    */
 /*                                            resulting in version 6.1    */
+/*  xx-xx-xxxx     Mohamed ayed             Modified comment(s),          */
+/*                                            added class match index,    */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_host_stack_class_register(UCHAR *class_name,
@@ -134,6 +138,16 @@ ULONG               class_index;
             /* Mark it as used.  */
             class_inst -> ux_host_class_status =  UX_USED;
 
+#if defined(UX_HOST_CLASS_MATCH_INDEX_ENABLE)
+
+            /* Queries answered by the class are not indexed until it's enabled.  */
+            class_inst -> ux_host_class_match_index_enable =  UX_FALSE;
+
+            /* Class queries may be answered differently now, index is built again.  */
+            _ux_utility_memory_set(_ux_system_host -> ux_system_host_class_match_index, 0,
+                                   sizeof(_ux_system_host -> ux_system_host_class_match_index)); /* Use case of memset is verified. */
+#endif
+
             /* Return successful completion.  */
             return(UX_SUCCESS);
         }
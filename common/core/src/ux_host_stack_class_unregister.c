@@ -33,7 +33,7 @@
 /*  FUNCTION                                               RELEASE        */
 /*                                                                        */
 /*    _ux_host_stack_class_unregister                     PORTABLE C      */
-/*                                                           6.1          */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -59,6 +59,7 @@
 /*  CALLS                                                                 */
 /*                                                                        */
 /*    (class_entry_function)                Entry function of the class   */
+/*    _ux_utility_memory_set                Set memory to a value         */
 /*                                                                        */
 /*  CALLED BY                                                             */
 /*                                                                        */
@@ -70,6 +71,9 @@
 /*    DATE              NAME                      DESCRIPTION             */
 /*                                                                        */
 /*  09-30-2020     Chaoqiong Xiao           Initial Version 6.1           */
+/*  xx-xx-xxxx     Mohamed ayed             Modified comment(s),          */
+/*                                            added class match index,    */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_host_stack_class_unregister(UINT (*class_entry_function)(struct UX_HOST_CLASS_COMMAND_STRUCT *))
@@ -109,6 +113,13 @@ ULONG                   class_index;
             class_inst -> ux_host_class_entry_function = UX_NULL;
             class_inst -> ux_host_class_status = UX_UNUSED;
 
+#if defined(UX_HOST_CLASS_MATCH_INDEX_ENABLE)
+
+            /* Class queries may be answered differently now, index is built again.  */
+            _ux_utility_memory_set(_ux_system_host -> ux_system_host_class_match_index, 0,
+                                   sizeof(_ux_system_host -> ux_system_host_class_match_index)); /* Use case of memset is verified. */
+#endif
+
             /* Class unregistered success.  */
             return(UX_SUCCESS);
         }
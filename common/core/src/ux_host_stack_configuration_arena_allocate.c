@@ -0,0 +1,102 @@
+/***************************************************************************
+ * Copyright (c) 2024 Microsoft Corporation
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the MIT License which is available at
+ * https://opensource.org/licenses/MIT.
+ *
+ * SPDX-License-Identifier: MIT
+ **************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** USBX Component                                                        */
+/**                                                                       */
+/**   Host Stack                                                          */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+
+/* Include necessary system files.  */
+
+#define UX_SOURCE_CODE
+
+#include "ux_api.h"
+#include "ux_host_stack.h"
+
+
+#if defined(UX_HOST_DEVICE_ARENA_ENABLE)
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_host_stack_configuration_arena_allocate         PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function allocates a cleared container memory from the arena of*/
+/*    a configuration. If there is no arena or there is no room left in   */
+/*    it, the memory is allocated from the regular memory pool.           */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    configuration                     Pointer to configuration          */
+/*    memory_size                       Size of memory                    */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    VOID *                            Pointer to memory allocated       */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _ux_utility_memory_allocate           Allocate memory block         */
+/*    _ux_utility_memory_set                Set memory block              */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    _ux_host_stack_new_endpoint_create    Create new endpoint           */
+/*    _ux_host_stack_new_interface_create   Create new interface          */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Mohamed ayed             Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+VOID  *_ux_host_stack_configuration_arena_allocate(UX_CONFIGURATION *configuration, ULONG memory_size)
+{
+
+UCHAR               *memory;
+
+    /* Keep containers aligned in arena.  */
+    memory_size =  UX_HOST_STACK_ARENA_ROUND(memory_size);
+
+    /* Check if there is room in the arena.  */
+    if ((configuration -> ux_configuration_arena == UX_NULL) ||
+        (memory_size > configuration -> ux_configuration_arena_size -
+                                    configuration -> ux_configuration_arena_used))
+    {
+
+        /* Allocate the container from the pool.  */
+        return(_ux_utility_memory_allocate(UX_NO_ALIGN, UX_REGULAR_MEMORY, memory_size));
+    }
+
+    /* Take the memory from the arena.  */
+    memory =  configuration -> ux_configuration_arena + configuration -> ux_configuration_arena_used;
+    configuration -> ux_configuration_arena_used +=  memory_size;
+
+    /* Clear the memory, as the pool allocation does.  */
+    _ux_utility_memory_set(memory, 0, memory_size); /* Use case of memset is verified. */
+
+    /* Return the container memory.  */
+    return((VOID *) memory);
+}
+#endif
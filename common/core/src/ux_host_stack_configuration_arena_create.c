@@ -0,0 +1,126 @@
+/***************************************************************************
+ * Copyright (c) 2024 Microsoft Corporation
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the MIT License which is available at
+ * https://opensource.org/licenses/MIT.
+ *
+ * SPDX-License-Identifier: MIT
+ **************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** USBX Component                                                        */
+/**                                                                       */
+/**   Host Stack                                                          */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+
+/* Include necessary system files.  */
+
+#define UX_SOURCE_CODE
+
+#include "ux_api.h"
+#include "ux_host_stack.h"
+
+
+#if defined(UX_HOST_DEVICE_ARENA_ENABLE)
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_host_stack_configuration_arena_create           PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function allocates the memory arena of a configuration. The    */
+/*    configuration descriptor is scanned to count the interface and      */
+/*    endpoint descriptors, so the arena is sized to hold all interface   */
+/*    and endpoint containers of the configuration.                       */
+/*                                                                        */
+/*    If the arena can not be allocated, containers are allocated one by  */
+/*    one from the regular memory pool.                                   */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    configuration                     Pointer to configuration          */
+/*    descriptor                        Entire configuration              */
+/*                                        descriptor                      */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _ux_utility_memory_allocate           Allocate memory block         */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    _ux_host_stack_interfaces_scan        Scan host interfaces          */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Mohamed ayed             Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+VOID  _ux_host_stack_configuration_arena_create(UX_CONFIGURATION *configuration, UCHAR *descriptor)
+{
+
+ULONG               total_configuration_length;
+ULONG               descriptor_length;
+ULONG               arena_size;
+
+    /* The arena is created once for the configuration.  */
+    if (configuration -> ux_configuration_arena != UX_NULL)
+        return;
+
+    /* Retrieve the size of all the configuration descriptor.  */
+    total_configuration_length =  configuration -> ux_configuration_descriptor.wTotalLength;
+
+    /* Accumulate container sizes for interface and endpoint descriptors.  */
+    arena_size =  0;
+    while (total_configuration_length)
+    {
+
+        /* Gather the length of the descriptor, corrupted descriptor is
+           reported while interfaces are scanned.  */
+        descriptor_length =  *descriptor;
+        if ((descriptor_length < 3) || (descriptor_length > total_configuration_length))
+            break;
+
+        /* Interface container.  */
+        if (*(descriptor + 1) == UX_INTERFACE_DESCRIPTOR_ITEM)
+            arena_size +=  UX_HOST_STACK_ARENA_ROUND(sizeof(UX_INTERFACE));
+
+        /* Endpoint container.  */
+        if (*(descriptor + 1) == UX_ENDPOINT_DESCRIPTOR_ITEM)
+            arena_size +=  UX_HOST_STACK_ARENA_ROUND(sizeof(UX_ENDPOINT));
+
+        /* Jump to the next descriptor.  */
+        descriptor +=  descriptor_length;
+        total_configuration_length -=  descriptor_length;
+    }
+
+    /* Nothing to hold.  */
+    if (arena_size == 0)
+        return;
+
+    /* Allocate the arena, it's cleared by the allocator.  */
+    configuration -> ux_configuration_arena =  _ux_utility_memory_allocate(UX_NO_ALIGN, UX_REGULAR_MEMORY, arena_size);
+    if (configuration -> ux_configuration_arena == UX_NULL)
+        return;
+    configuration -> ux_configuration_arena_size =  arena_size;
+    configuration -> ux_configuration_arena_used =  0;
+}
+#endif
@@ -0,0 +1,86 @@
+/***************************************************************************
+ * Copyright (c) 2024 Microsoft Corporation
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the MIT License which is available at
+ * https://opensource.org/licenses/MIT.
+ *
+ * SPDX-License-Identifier: MIT
+ **************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** USBX Component                                                        */
+/**                                                                       */
+/**   Host Stack                                                          */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+
+/* Include necessary system files.  */
+
+#define UX_SOURCE_CODE
+
+#include "ux_api.h"
+#include "ux_host_stack.h"
+
+
+#if defined(UX_HOST_DEVICE_ARENA_ENABLE)
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_host_stack_configuration_arena_free             PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function frees a container memory allocated for a              */
+/*    configuration. The memory inside the configuration arena is kept    */
+/*    and released with the arena, other memory is freed to the pool.     */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    configuration                     Pointer to configuration          */
+/*    memory                            Pointer to memory                 */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _ux_utility_memory_free               Free memory block             */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    _ux_host_stack_device_resources_free  Free device resources         */
+/*    _ux_host_stack_new_endpoint_create    Create new endpoint           */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Mohamed ayed             Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+VOID  _ux_host_stack_configuration_arena_free(UX_CONFIGURATION *configuration, VOID *memory)
+{
+
+    /* Memory in arena is released with the arena.  */
+    if ((configuration -> ux_configuration_arena != UX_NULL) &&
+        ((UCHAR *) memory >= configuration -> ux_configuration_arena) &&
+        ((UCHAR *) memory < configuration -> ux_configuration_arena +
+                                    configuration -> ux_configuration_arena_size))
+        return;
+
+    /* Free memory to pool.  */
+    _ux_utility_memory_free(memory);
+}
+#endif
@@ -33,7 +33,7 @@
 /*  FUNCTION                                               RELEASE        */ 
 /*                                                                        */ 
 /*    _ux_host_stack_configuration_descriptor_parse       PORTABLE C      */ 
-/*                                                           6.1          */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -45,6 +45,9 @@
 /*    if the device has multiple configurations, we read all the          */ 
 /*    configurations but do not instantiate any configuration. Rather we  */ 
 /*    let a class driver do the work.                                     */
+/*                                                                        */
+/*    With descriptor cache, a configuration of a known device is copied  */
+/*    from the cache if it has the header just read from the device.      */
 /*                                                                        */ 
 /*  INPUT                                                                 */ 
 /*                                                                        */ 
@@ -58,6 +61,8 @@
 /*                                                                        */ 
 /*  CALLS                                                                 */ 
 /*                                                                        */ 
+/*    _ux_host_stack_descriptor_cache_read  Read cached configuration     */
+/*    _ux_host_stack_descriptor_cache_save  Cache configuration           */
 /*    _ux_host_stack_interfaces_scan        Scan host interfaces          */ 
 /*    _ux_host_stack_transfer_request       Process transfer request      */ 
 /*    _ux_utility_memory_allocate           Allocate block of memory      */
@@ -74,6 +79,9 @@
 /*  05-19-2020     Chaoqiong Xiao           Initial Version 6.0           */
 /*  09-30-2020     Chaoqiong Xiao           Modified comment(s),          */
 /*                                            resulting in version 6.1    */
+/*  xx-xx-xxxx     Mohamed ayed             Modified comment(s),          */
+/*                                            added descriptor cache,     */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_host_stack_configuration_descriptor_parse(UX_DEVICE *device, UX_CONFIGURATION *configuration,
@@ -106,6 +114,18 @@ ULONG           total_configuration_length;
     }
     else
     {
+#if defined(UX_HOST_DESCRIPTOR_CACHE_ENABLE)
+
+        /* A known configuration is taken from the descriptor cache instead of being read again.  */
+        if (_ux_host_stack_descriptor_cache_read(device, configuration, configuration_index, descriptor) == UX_SUCCESS)
+        {
+
+            /* Parse all interfaces, free the descriptor and return.  */
+            status =  _ux_host_stack_interfaces_scan(configuration, descriptor);
+            _ux_utility_memory_free(descriptor);
+            return(status);
+        }
+#endif
 
         /* Create a transfer_request for the GET_DESCRIPTOR request.  */
         transfer_request -> ux_transfer_request_data_pointer =      descriptor;
@@ -126,6 +146,12 @@ ULONG           total_configuration_length;
                the interface(s) descriptors, all alternate settings, endpoints
                and descriptor specific to the class. The descriptor is parsed for all interfaces.  */
             status =  _ux_host_stack_interfaces_scan(configuration, descriptor);
+#if defined(UX_HOST_DESCRIPTOR_CACHE_ENABLE)
+
+            /* Keep the configuration for next enumeration of the device.  */
+            if (status == UX_SUCCESS)
+                _ux_host_stack_descriptor_cache_save(device, configuration_index, descriptor);
+#endif
         }
     }
 
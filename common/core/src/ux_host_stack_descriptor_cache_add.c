@@ -0,0 +1,231 @@
+/***************************************************************************
+ * Copyright (c) 2024 Microsoft Corporation
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the MIT License which is available at
+ * https://opensource.org/licenses/MIT.
+ *
+ * SPDX-License-Identifier: MIT
+ **************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** USBX Component                                                        */
+/**                                                                       */
+/**   Host Stack                                                          */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+
+/* Include necessary system files.  */
+
+#define UX_SOURCE_CODE
+
+#include "ux_api.h"
+#include "ux_host_stack.h"
+
+
+
+#if defined(UX_HOST_DESCRIPTOR_CACHE_ENABLE)
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_host_stack_descriptor_cache_add                 PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function adds a configuration descriptor of a device to the    */
+/*    descriptor cache. The device is identified by its vendor ID,        */
+/*    product ID and release number. An entry of the same configuration   */
+/*    of the same device is replaced, otherwise a free entry or the       */
+/*    least recently used one is taken.                                   */
+/*                                                                        */
+/*    The application can use it to restore the cache from a previous     */
+/*    run, the configuration is then not read again from the device on    */
+/*    its first enumeration.                                              */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    vendor_id                         Vendor ID of device               */
+/*    product_id                        Product ID of device              */
+/*    bcd_device                        Release number of device          */
+/*    configuration_index               Index of configuration            */
+/*    descriptor                        Pointer to configuration          */
+/*                                      descriptor, with all the          */
+/*                                      interface/endpoint ones           */
+/*    length                            Length of descriptor              */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    Completion Status                                                   */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _ux_host_mutex_off                    Release mutex                 */
+/*    _ux_host_mutex_on                     Get mutex                     */
+/*    _ux_utility_memory_allocate           Allocate memory block         */
+/*    _ux_utility_memory_copy               Copy memory block             */
+/*    _ux_utility_memory_free               Free memory block             */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    Application                                                         */
+/*    USBX Components                                                     */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Mohamed ayed             Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+UINT  _ux_host_stack_descriptor_cache_add(ULONG vendor_id, ULONG product_id, ULONG bcd_device,
+                                    UINT configuration_index, UCHAR *descriptor, ULONG length)
+{
+
+UX_HOST_DESCRIPTOR_CACHE    *cache_entry;
+UX_HOST_DESCRIPTOR_CACHE    *entry;
+UCHAR                       *buffer;
+ULONG                       stamp;
+ULONG                       entry_index;
+
+
+    /* Long configurations are not cached.  */
+    if (length > UX_HOST_DESCRIPTOR_CACHE_MAX_LENGTH)
+        return(UX_MEMORY_INSUFFICIENT);
+
+    /* Keep a copy of the descriptor.  */
+    buffer =  _ux_utility_memory_allocate(UX_NO_ALIGN, UX_REGULAR_MEMORY, length);
+    if (buffer == UX_NULL)
+        return(UX_MEMORY_INSUFFICIENT);
+    _ux_utility_memory_copy(buffer, descriptor, length); /* Use case of memcpy is verified. */
+
+    /* Protect the cache against other enumerations.  */
+    _ux_host_mutex_on(&_ux_system_host -> ux_system_host_descriptor_cache_mutex);
+
+    /* Look for the entry of this configuration, a free entry or the least recently used one.  */
+    stamp =  _ux_system_host -> ux_system_host_descriptor_cache_stamp;
+    entry =  UX_NULL;
+    cache_entry =  _ux_system_host -> ux_system_host_descriptor_cache;
+    for (entry_index = 0; entry_index < UX_HOST_DESCRIPTOR_CACHE_ENTRIES; entry_index ++, cache_entry ++)
+    {
+
+        /* Take the first free entry, unless this configuration is found.  */
+        if (cache_entry -> ux_host_descriptor_cache_descriptor == UX_NULL)
+        {
+            if ((entry == UX_NULL) || (entry -> ux_host_descriptor_cache_descriptor != UX_NULL))
+                entry =  cache_entry;
+            continue;
+        }
+
+        /* Same configuration of the same device is replaced.  */
+        if ((cache_entry -> ux_host_descriptor_cache_vendor_id == vendor_id) &&
+            (cache_entry -> ux_host_descriptor_cache_product_id == product_id) &&
+            (cache_entry -> ux_host_descriptor_cache_bcd_device == bcd_device) &&
+            (cache_entry -> ux_host_descriptor_cache_configuration_index == configuration_index))
+        {
+            entry =  cache_entry;
+            break;
+        }
+
+        /* Oldest entry is replaced if there is no free one. Stamps may wrap, compare ages.  */
+        if ((entry == UX_NULL) ||
+            ((entry -> ux_host_descriptor_cache_descriptor != UX_NULL) &&
+             ((ULONG)(stamp - cache_entry -> ux_host_descriptor_cache_stamp) >
+              (ULONG)(stamp - entry -> ux_host_descriptor_cache_stamp))))
+            entry =  cache_entry;
+    }
+
+    /* Fill the entry, its previous descriptor is freed after.  */
+    descriptor =  entry -> ux_host_descriptor_cache_descriptor;
+    entry -> ux_host_descriptor_cache_vendor_id =  vendor_id;
+    entry -> ux_host_descriptor_cache_product_id =  product_id;
+    entry -> ux_host_descriptor_cache_bcd_device =  bcd_device;
+    entry -> ux_host_descriptor_cache_configuration_index =  configuration_index;
+    entry -> ux_host_descriptor_cache_length =  length;
+    entry -> ux_host_descriptor_cache_descriptor =  buffer;
+    entry -> ux_host_descriptor_cache_stamp =  ++ _ux_system_host -> ux_system_host_descriptor_cache_stamp;
+
+    /* Release the cache.  */
+    _ux_host_mutex_off(&_ux_system_host -> ux_system_host_descriptor_cache_mutex);
+
+    /* Free the replaced descriptor.  */
+    if (descriptor != UX_NULL)
+        _ux_utility_memory_free(descriptor);
+
+    /* Return successful completion.  */
+    return(UX_SUCCESS);
+}
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _uxe_host_stack_descriptor_cache_add                PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function checks errors in host stack descriptor cache add      */
+/*    function call.                                                      */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    vendor_id                         Vendor ID of device               */
+/*    product_id                        Product ID of device              */
+/*    bcd_device                        Release number of device          */
+/*    configuration_index               Index of configuration            */
+/*    descriptor                        Pointer to configuration          */
+/*                                      descriptor                        */
+/*    length                            Length of descriptor              */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    Completion Status                                                   */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _ux_host_stack_descriptor_cache_add                                 */
+/*                                          Add descriptor to cache       */
+/*    _ux_utility_short_get                 Get 16-bit value              */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    Application                                                         */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Mohamed ayed             Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+UINT  _uxe_host_stack_descriptor_cache_add(ULONG vendor_id, ULONG product_id, ULONG bcd_device,
+                                    UINT configuration_index, UCHAR *descriptor, ULONG length)
+{
+
+    /* Sanity checks.  */
+    if (descriptor == UX_NULL)
+        return(UX_INVALID_PARAMETER);
+    if ((length < UX_CONFIGURATION_DESCRIPTOR_LENGTH) ||
+        (descriptor[1] != UX_CONFIGURATION_DESCRIPTOR_ITEM) ||
+        (_ux_utility_short_get(descriptor + 2) != length))
+        return(UX_DESCRIPTOR_CORRUPTED);
+
+    /* Invoke descriptor cache add function.  */
+    return(_ux_host_stack_descriptor_cache_add(vendor_id, product_id, bcd_device,
+                                               configuration_index, descriptor, length));
+}
+#endif
@@ -0,0 +1,87 @@
+/***************************************************************************
+ * Copyright (c) 2024 Microsoft Corporation
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the MIT License which is available at
+ * https://opensource.org/licenses/MIT.
+ *
+ * SPDX-License-Identifier: MIT
+ **************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** USBX Component                                                        */
+/**                                                                       */
+/**   Host Stack                                                          */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+
+/* Include necessary system files.  */
+
+#define UX_SOURCE_CODE
+
+#include "ux_api.h"
+#include "ux_host_stack.h"
+
+
+
+#if defined(UX_HOST_DESCRIPTOR_CACHE_ENABLE)
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_host_stack_descriptor_cache_callback_set        PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function sets the callback invoked each time a configuration   */
+/*    descriptor read from a device is added to the descriptor cache.     */
+/*    The application can save it to restore the cache with               */
+/*    _ux_host_stack_descriptor_cache_add on next run.                    */
+/*                                                                        */
+/*    The callback is invoked from the enumeration context, it must not   */
+/*    block.                                                              */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    callback                          Callback function, UX_NULL        */
+/*                                      to remove the callback            */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    Completion Status                                                   */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    Application                                                         */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Mohamed ayed             Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+UINT  _ux_host_stack_descriptor_cache_callback_set(VOID (*callback)(UX_DEVICE *device,
+                                    UINT configuration_index, UCHAR *descriptor, ULONG length))
+{
+
+    /* Store the callback.  */
+    _ux_system_host -> ux_system_host_descriptor_cache_callback =  callback;
+
+    /* Return successful completion.  */
+    return(UX_SUCCESS);
+}
+#endif
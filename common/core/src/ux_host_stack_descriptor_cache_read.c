@@ -0,0 +1,131 @@
+/***************************************************************************
+ * Copyright (c) 2024 Microsoft Corporation
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the MIT License which is available at
+ * https://opensource.org/licenses/MIT.
+ *
+ * SPDX-License-Identifier: MIT
+ **************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** USBX Component                                                        */
+/**                                                                       */
+/**   Host Stack                                                          */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+
+/* Include necessary system files.  */
+
+#define UX_SOURCE_CODE
+
+#include "ux_api.h"
+#include "ux_host_stack.h"
+
+
+
+#if defined(UX_HOST_DESCRIPTOR_CACHE_ENABLE)
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_host_stack_descriptor_cache_read                PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function copies the whole configuration descriptor of a        */
+/*    device from the descriptor cache. The configuration descriptor      */
+/*    header just read from the device validates the cached               */
+/*    configuration: its length and fields must be the same, otherwise    */
+/*    the configuration must be read again.                               */
+/*                                                                        */
+/*    The descriptor buffer must have the length of the configuration.    */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    device                            Pointer to device                 */
+/*    configuration                     Pointer to configuration          */
+/*                                      with descriptor header            */
+/*    configuration_index               Index of configuration            */
+/*    descriptor                        Buffer to fill                    */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    Completion Status                                                   */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _ux_host_mutex_off                    Release mutex                 */
+/*    _ux_host_mutex_on                     Get mutex                     */
+/*    _ux_utility_memory_copy               Copy memory block             */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    USBX Components                                                     */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Mohamed ayed             Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+UINT  _ux_host_stack_descriptor_cache_read(UX_DEVICE *device, UX_CONFIGURATION *configuration,
+                                    UINT configuration_index, UCHAR *descriptor)
+{
+
+UX_HOST_DESCRIPTOR_CACHE    *cache_entry;
+UCHAR                       *cached_descriptor;
+ULONG                       entry_index;
+UINT                        status =  UX_ERROR;
+
+
+    /* Protect the cache against other enumerations.  */
+    _ux_host_mutex_on(&_ux_system_host -> ux_system_host_descriptor_cache_mutex);
+
+    /* Look for the configuration of this device.  */
+    cache_entry =  _ux_system_host -> ux_system_host_descriptor_cache;
+    for (entry_index = 0; entry_index < UX_HOST_DESCRIPTOR_CACHE_ENTRIES; entry_index ++, cache_entry ++)
+    {
+
+        cached_descriptor =  cache_entry -> ux_host_descriptor_cache_descriptor;
+        if ((cached_descriptor == UX_NULL) ||
+            (cache_entry -> ux_host_descriptor_cache_vendor_id != device -> ux_device_descriptor.idVendor) ||
+            (cache_entry -> ux_host_descriptor_cache_product_id != device -> ux_device_descriptor.idProduct) ||
+            (cache_entry -> ux_host_descriptor_cache_bcd_device != device -> ux_device_descriptor.bcdDevice) ||
+            (cache_entry -> ux_host_descriptor_cache_configuration_index != configuration_index))
+            continue;
+
+        /* The cached configuration must have the header read from the device.  */
+        if ((cache_entry -> ux_host_descriptor_cache_length == configuration -> ux_configuration_descriptor.wTotalLength) &&
+            (cached_descriptor[4] == configuration -> ux_configuration_descriptor.bNumInterfaces) &&
+            (cached_descriptor[5] == configuration -> ux_configuration_descriptor.bConfigurationValue) &&
+            (cached_descriptor[6] == configuration -> ux_configuration_descriptor.iConfiguration) &&
+            (cached_descriptor[7] == configuration -> ux_configuration_descriptor.bmAttributes) &&
+            (cached_descriptor[8] == configuration -> ux_configuration_descriptor.MaxPower))
+        {
+
+            /* Copy the configuration, it is now the most recently used.  */
+            _ux_utility_memory_copy(descriptor, cached_descriptor, cache_entry -> ux_host_descriptor_cache_length); /* Use case of memcpy is verified. */
+            cache_entry -> ux_host_descriptor_cache_stamp =  ++ _ux_system_host -> ux_system_host_descriptor_cache_stamp;
+            status =  UX_SUCCESS;
+        }
+        break;
+    }
+
+    /* Release the cache.  */
+    _ux_host_mutex_off(&_ux_system_host -> ux_system_host_descriptor_cache_mutex);
+
+    /* Return completion status.  */
+    return(status);
+}
+#endif
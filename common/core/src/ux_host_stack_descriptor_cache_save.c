@@ -0,0 +1,97 @@
+/***************************************************************************
+ * Copyright (c) 2024 Microsoft Corporation
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the MIT License which is available at
+ * https://opensource.org/licenses/MIT.
+ *
+ * SPDX-License-Identifier: MIT
+ **************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** USBX Component                                                        */
+/**                                                                       */
+/**   Host Stack                                                          */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+
+/* Include necessary system files.  */
+
+#define UX_SOURCE_CODE
+
+#include "ux_api.h"
+#include "ux_host_stack.h"
+
+
+
+#if defined(UX_HOST_DESCRIPTOR_CACHE_ENABLE)
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_host_stack_descriptor_cache_save                PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function adds a configuration descriptor just read from a      */
+/*    device to the descriptor cache, then invokes the descriptor cache   */
+/*    callback of the application so it can save the configuration too.   */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    device                            Pointer to device                 */
+/*    configuration_index               Index of configuration            */
+/*    descriptor                        Pointer to configuration          */
+/*                                      descriptor                        */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _ux_host_stack_descriptor_cache_add                                 */
+/*                                          Add descriptor to cache       */
+/*    _ux_utility_short_get                 Get 16-bit value              */
+/*    (ux_system_host_descriptor_cache_callback)                          */
+/*                                          Application callback          */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    USBX Components                                                     */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Mohamed ayed             Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+VOID  _ux_host_stack_descriptor_cache_save(UX_DEVICE *device, UINT configuration_index, UCHAR *descriptor)
+{
+
+ULONG       length;
+UINT        status;
+
+
+    /* Add the whole configuration to the cache.  */
+    length =  _ux_utility_short_get(descriptor + 2);
+    status =  _ux_host_stack_descriptor_cache_add(device -> ux_device_descriptor.idVendor,
+                                                  device -> ux_device_descriptor.idProduct,
+                                                  device -> ux_device_descriptor.bcdDevice,
+                                                  configuration_index, descriptor, length);
+
+    /* The application may keep it for next run.  */
+    if ((status == UX_SUCCESS) && (_ux_system_host -> ux_system_host_descriptor_cache_callback != UX_NULL))
+        _ux_system_host -> ux_system_host_descriptor_cache_callback(device, configuration_index, descriptor, length);
+}
+#endif
@@ -33,7 +33,7 @@
 /*  FUNCTION                                               RELEASE        */ 
 /*                                                                        */ 
 /*    _ux_host_stack_device_address_set                   PORTABLE C      */ 
-/*                                                           6.1.10       */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -71,6 +71,12 @@
 /*  01-31-2022     Chaoqiong Xiao           Modified comment(s),          */
 /*                                            added standalone support,   */
 /*                                            resulting in version 6.1.10 */
+/*  xx-xx-xxxx     Mohamed ayed             Modified comment(s),          */
+/*                                            moved address wait to enum  */
+/*                                            worker in parallel enum,    */
+/*                                            added adaptive enum timing, */
+/*                                            skipped full address bytes, */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_host_stack_device_address_set(UX_DEVICE *device)
@@ -109,33 +115,26 @@ UCHAR           device_address_byte;
         /* Get the address mask byte.  */
         device_address_byte =  hcd -> ux_hcd_address[address_byte_index];
 
-        /* Scan each bit for an empty spot.  */
-        for (address_bit_index = 0; address_bit_index < 8; address_bit_index++)
-        {
+        /* Skip the bytes with all addresses taken.  */
+        if (device_address_byte == 0xFF)
+            continue;
 
-            if ((device_address_byte & (1 << address_bit_index)) == 0)
-            {
+        /* Find the first empty spot in the byte.  */
+        address_bit_index =  0;
+        while (device_address_byte & (1 << address_bit_index))
+            address_bit_index++;
 
-                /* We have found an empty spot. Reserve this address.  */
-                device_address_byte = (UCHAR)((UCHAR)device_address_byte | (UCHAR)(1 << address_bit_index));
-
-                /* Store the address mask byte.  */
-                hcd -> ux_hcd_address[address_byte_index] =  device_address_byte;
-
-                /* OK, apply address.  */
-                status = UX_SUCCESS;
-                break;
-            }
+        /* Address 128 does not exist.  */
+        device_address =  (USHORT)((address_byte_index << 3) + address_bit_index + 1);
+        if (device_address > 127)
+            break;
 
-            /* This address was already taken, increment to the next address.  */
-            device_address++;
-        }
+        /* Reserve this address in the address mask byte.  */
+        hcd -> ux_hcd_address[address_byte_index] =  (UCHAR)(device_address_byte | (1 << address_bit_index));
 
-        /* If address found, break the loop.  */
-        if (status == UX_SUCCESS)
-        {
-            break;
-        }
+        /* OK, apply address.  */
+        status = UX_SUCCESS;
+        break;
     }
     if (status == UX_ERROR)
 
@@ -174,8 +173,13 @@ UCHAR           device_address_byte;
         /* Mark the device as ADDRESSED now.  */
         device -> ux_device_state = UX_DEVICE_ADDRESSED;
 
-        /* Some devices need some time to accept this address.  */
-        _ux_utility_delay_ms(UX_DEVICE_ADDRESS_SET_WAIT);
+#if !defined(UX_HOST_ENUM_PARALLEL_ENABLE)
+
+        /* Some devices need some time to accept this address.
+           With parallel enumeration the worker thread waits.  */
+        _ux_utility_delay_ms(UX_HOST_ENUM_DEVICE_DELAY(device, UX_HOST_ENUM_DEVICE_ADDRESS_SET_WAIT_MIN,
+                                                       UX_DEVICE_ADDRESS_SET_WAIT));
+#endif
 
         /* Return successful status.  */
         return(status);
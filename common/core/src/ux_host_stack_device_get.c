@@ -33,7 +33,7 @@
 /*  FUNCTION                                               RELEASE        */
 /*                                                                        */
 /*    _ux_host_stack_device_get                           PORTABLE C      */
-/*                                                           6.1          */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -72,15 +72,15 @@
 /*                                            optimized based on compile  */
 /*                                            definitions,                */
 /*                                            resulting in version 6.1    */
+/*  xx-xx-xxxx     Mohamed ayed             Modified comment(s),          */
+/*                                            indexed device array,       */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_host_stack_device_get(ULONG device_index, UX_DEVICE **device)
 {
 
 UX_DEVICE   *current_device;
-#if UX_MAX_DEVICES > 1
-ULONG       current_device_index;
-#endif
 
     /* If trace is enabled, insert this event into the trace buffer.  */
     UX_TRACE_IN_LINE_INSERT(UX_TRACE_HOST_STACK_DEVICE_GET, device_index, 0, 0, 0, UX_TRACE_HOST_STACK_EVENTS, 0, 0)
@@ -98,48 +98,19 @@ ULONG       current_device_index;
         return(UX_DEVICE_HANDLE_UNKNOWN);
     }
 
-#if UX_MAX_DEVICES > 1
+    /* The device index is the index of the container in the device array.  */
+    current_device =  &_ux_system_host -> ux_system_host_device_array[device_index];
 
-    /* Start with the first device.  */
-    current_device =        _ux_system_host -> ux_system_host_device_array;
-    current_device_index =  0;
-
-    /* Search the list until the end.  */
-    while (current_device_index < _ux_system_host -> ux_system_host_max_devices)
+    /* Check to see if this device is existing.  */
+    if (current_device -> ux_device_handle != UX_UNUSED)
     {
 
-        /* Check to see if this device is existing.  */
-        if (current_device -> ux_device_handle != UX_UNUSED)
-        {
-
-            /* Have we reached the index we are looking for?  */
-            if (device_index == current_device_index)
-            {
-
-                /* Yes, return the device pointer.  */
-                *device =  current_device;
-
-                /* Return successful completion.  */
-                return(UX_SUCCESS);
-            }
-        }
+        /* Yes, return the device pointer.  */
+        *device =  current_device;
 
-        /* Move to next device index.  */
-        current_device_index++;
-
-        /* Move to next device.  */
-        current_device++;
-    }
-#else
-
-    /* Only one device, just check if it's used.  */
-    current_device = _ux_system_host -> ux_system_host_device_array;
-    if (current_device -> ux_device_handle != UX_UNUSED)
-    {
-        *device = current_device;
+        /* Return successful completion.  */
         return(UX_SUCCESS);
     }
-#endif
 
     /* If trace is enabled, insert this event into the trace buffer.  */
     UX_TRACE_IN_LINE_INSERT(UX_TRACE_ERROR, UX_DEVICE_HANDLE_UNKNOWN, device, 0, 0, UX_TRACE_ERRORS, 0, 0)
@@ -33,7 +33,7 @@
 /*  FUNCTION                                               RELEASE        */
 /*                                                                        */
 /*    _ux_host_stack_device_remove                        PORTABLE C      */
-/*                                                           6.1.12       */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -56,6 +56,7 @@
 /*  CALLS                                                                 */
 /*                                                                        */
 /*    _ux_host_stack_device_resources_free  Free all device resources     */
+/*    _ux_host_stack_enum_device_cancel     Cancel device enumeration     */
 /*                                                                        */
 /*  CALLED BY                                                             */
 /*                                                                        */
@@ -83,6 +84,9 @@
 /*                                            fixed parameter/variable    */
 /*                                            names conflict C++ keyword, */
 /*                                            resulting in version 6.1.12 */
+/*  xx-xx-xxxx     Mohamed ayed             Modified comment(s),          */
+/*                                            cancelled parallel enum,    */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_host_stack_device_remove(UX_HCD *hcd, UX_DEVICE *parent, UINT port_index)
@@ -154,6 +158,12 @@ UX_HOST_CLASS_COMMAND       command;
     /* We have found the device to be removed. */
     device -> ux_device_state = UX_DEVICE_REMOVED;
 
+#if defined(UX_HOST_ENUM_PARALLEL_ENABLE)
+
+    /* The device may still be enumerated by a worker thread, stop it.  */
+    _ux_host_stack_enum_device_cancel(device);
+#endif
+
     /* We have found the device to be removed. Initialize the class
         command with the generic parameters.  */
     command.ux_host_class_command_request =  UX_HOST_CLASS_COMMAND_DEACTIVATE;
@@ -33,7 +33,7 @@
 /*  FUNCTION                                               RELEASE        */ 
 /*                                                                        */ 
 /*    _ux_host_stack_device_resources_free                PORTABLE C      */ 
-/*                                                           6.1.12       */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -52,6 +52,7 @@
 /*                                                                        */ 
 /*  CALLS                                                                 */ 
 /*                                                                        */ 
+/*    UX_HOST_STACK_CONTAINER_FREE          Free container                */
 /*    _ux_host_stack_endpoint_transfer_abort                              */
 /*                                          Abort transfer                */
 /*    _ux_host_stack_endpoint_instance_delete                             */
@@ -87,6 +88,10 @@
 /*                                            freed shared device config  */
 /*                                            descriptor for enum scan,   */
 /*                                            resulting in version 6.1.12 */
+/*  xx-xx-xxxx     Mohamed ayed             Modified comment(s),          */
+/*                                            added configuration arena,  */
+/*                                            freed container in map,     */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_host_stack_device_resources_free(UX_DEVICE *device)
@@ -102,6 +107,7 @@ UX_HCD                  *hcd;
 UINT                    device_address_byte_index;
 UINT                    device_address_bit_index;
 UCHAR                   device_address_byte;
+ULONG                   container_index;
 #endif
 #if defined(UX_HOST_STANDALONE)
 UX_DEVICE               *enum_next;
@@ -187,7 +193,7 @@ UX_DEVICE               *enum_next;
                 endpoint =  endpoint -> ux_endpoint_next_endpoint;
                 
                 /* Delete the endpoint container.  */
-                _ux_utility_memory_free(container);
+                UX_HOST_STACK_CONTAINER_FREE(configuration, container);
             }
             
             
@@ -198,9 +204,16 @@ UX_DEVICE               *enum_next;
             interface_ptr =  interface_ptr -> ux_interface_next_interface;
 
             /* Delete the interface container.  */
-            _ux_utility_memory_free(container);
+            UX_HOST_STACK_CONTAINER_FREE(configuration, container);
         }
 
+#if defined(UX_HOST_DEVICE_ARENA_ENABLE)
+
+        /* Release all containers in the arena at once.  */
+        if (configuration -> ux_configuration_arena != UX_NULL)
+            _ux_utility_memory_free(configuration -> ux_configuration_arena);
+#endif
+
         /* Memorize this configuration address before we free it.  */
         container =  (VOID *) configuration;
 
@@ -279,6 +292,14 @@ UX_DEVICE               *enum_next;
     /* Mark the device handle as unused.  */
     device -> ux_device_handle =  UX_UNUSED;
 
+#if UX_MAX_DEVICES > 1
+
+    /* Return the container to the map of free containers.  */
+    container_index =  (ULONG)(device - _ux_system_host -> ux_system_host_device_array);
+    if (container_index < _ux_system_host -> ux_system_host_max_devices)
+        _ux_system_host -> ux_system_host_device_map[container_index >> 5] &=  ~((ULONG)1u << (container_index & 31u));
+#endif
+
     /* Return successful completion.  */
     return(UX_SUCCESS);
 }
@@ -0,0 +1,122 @@
+/***************************************************************************
+ * Copyright (c) 2024 Microsoft Corporation
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the MIT License which is available at
+ * https://opensource.org/licenses/MIT.
+ *
+ * SPDX-License-Identifier: MIT
+ **************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** USBX Component                                                        */
+/**                                                                       */
+/**   Host Stack                                                          */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+
+/* Include necessary system files.  */
+
+#define UX_SOURCE_CODE
+
+#include "ux_api.h"
+#include "ux_host_stack.h"
+
+
+
+#if defined(UX_HOST_ENUM_PARALLEL_ENABLE)
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_host_stack_enum_device_cancel                   PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function cancels the parallel enumeration of a device that is  */
+/*    being removed. A device queued for a worker thread or ready for     */
+/*    class scan is taken out of its queue. If a worker thread is         */
+/*    reading the device descriptors, the pending control transfer is     */
+/*    aborted until the worker gives up the device.                       */
+/*                                                                        */
+/*    The device state must be set to removed before calling this         */
+/*    function, so the worker does not start another request on the       */
+/*    device.                                                             */
+/*                                                                        */
+/*    It's for RTOS mode.                                                 */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    device                            Pointer to device                 */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _ux_host_stack_transfer_request_abort Abort transfer request        */
+/*    _ux_utility_delay_ms                  Delay                         */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    _ux_host_stack_device_remove          Remove device                 */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Mohamed ayed             Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+VOID  _ux_host_stack_enum_device_cancel(UX_DEVICE *device)
+{
+
+UX_INTERRUPT_SAVE_AREA
+
+UX_DEVICE   **next;
+
+
+    /* Take the device out of the queue it is in.  */
+    UX_DISABLE
+    if (device -> ux_device_flags & (UX_DEVICE_FLAG_ENUM | UX_DEVICE_FLAG_READY))
+    {
+
+        /* Queued devices are either waiting for a worker or ready.  */
+        if (device -> ux_device_flags & UX_DEVICE_FLAG_READY)
+            next =  &_ux_system_host -> ux_system_host_enum_ready;
+        else
+            next =  &_ux_system_host -> ux_system_host_enum_device;
+
+        /* Look for the device and unlink it.  */
+        while (*next != UX_NULL)
+        {
+            if (*next == device)
+            {
+                *next =  device -> ux_device_enum_next;
+                device -> ux_device_enum_next =  UX_NULL;
+                device -> ux_device_flags &= ~(UX_DEVICE_FLAG_ENUM | UX_DEVICE_FLAG_READY);
+                break;
+            }
+            next =  &(*next) -> ux_device_enum_next;
+        }
+    }
+    UX_RESTORE
+
+    /* Device still used by a worker thread, stop its requests until it is given up.  */
+    while (device -> ux_device_flags & UX_DEVICE_FLAG_ENUM)
+    {
+        _ux_host_stack_transfer_request_abort(&device -> ux_device_control_endpoint.ux_endpoint_transfer_request);
+        _ux_utility_delay_ms(1);
+    }
+}
+#endif
@@ -0,0 +1,234 @@
+/***************************************************************************
+ * Copyright (c) 2024 Microsoft Corporation
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the MIT License which is available at
+ * https://opensource.org/licenses/MIT.
+ *
+ * SPDX-License-Identifier: MIT
+ **************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** USBX Component                                                        */
+/**                                                                       */
+/**   Host Stack                                                          */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+
+/* Include necessary system files.  */
+
+#define UX_SOURCE_CODE
+
+#include "ux_api.h"
+#include "ux_host_stack.h"
+
+
+
+#if defined(UX_HOST_ENUM_PARALLEL_ENABLE)
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_host_stack_enum_ready_process                   PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function finishes the enumeration of the devices whose         */
+/*    descriptors have been read by the enumeration worker threads. A     */
+/*    class is looked for each device and the application is notified of  */
+/*    the connection, as it is done at the end of the device enumeration  */
+/*    without worker threads.                                             */
+/*                                                                        */
+/*    If the descriptors could not be read, the device is removed and its */
+/*    port is enumerated again, until the retries of the port are done.   */
+/*                                                                        */
+/*    Class scan and activation are kept in the enumeration thread, so    */
+/*    they are serialized with the hub and root hub changes processing.   */
+/*                                                                        */
+/*    It's for RTOS mode.                                                 */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _ux_host_stack_class_device_scan      Scan class devices            */
+/*    _ux_host_stack_class_interface_scan   Scan class interfaces         */
+/*    _ux_host_stack_device_remove          Remove device                 */
+/*    _ux_host_stack_rh_device_insertion    Insert root hub device        */
+/*    _ux_utility_delay_ms                  Delay                         */
+/*    (ux_system_host_enum_hub_retry_function)                            */
+/*                                          Retry hub port enumeration    */
+/*    _ux_utility_memory_free               Free memory                   */
+/*    _ux_system_error_handler              Log error                     */
+/*    _ux_utility_time_get                  Get current time              */
+/*    _ux_utility_time_elapsed              Compute elapsed time          */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    _ux_host_stack_enum_thread_entry      Enumeration thread            */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Mohamed ayed             Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+VOID  _ux_host_stack_enum_ready_process(VOID)
+{
+
+UX_INTERRUPT_SAVE_AREA
+
+UX_DEVICE   *device;
+UX_HCD      *hcd;
+UINT        port_index;
+UINT        retry;
+UINT        status;
+#if defined(UX_HOST_ENUM_ADAPTIVE_TIMING_ENABLE)
+ULONG       phase_start;
+#endif
+
+
+    /* Process all the devices given back by the worker threads.  */
+    while (1)
+    {
+
+        /* Take the first ready device.  */
+        UX_DISABLE
+        device =  _ux_system_host -> ux_system_host_enum_ready;
+        if (device != UX_NULL)
+        {
+            _ux_system_host -> ux_system_host_enum_ready =  device -> ux_device_enum_next;
+            device -> ux_device_enum_next =  UX_NULL;
+            device -> ux_device_flags &= ~UX_DEVICE_FLAG_READY;
+        }
+        UX_RESTORE
+
+        /* No more ready device.  */
+        if (device == UX_NULL)
+            return;
+
+        /* Get the status of the descriptors read.  */
+        status =  device -> ux_device_enum_status;
+        hcd =  UX_DEVICE_HCD_GET(device);
+        port_index =  UX_DEVICE_PORT_LOCATION_GET(device);
+
+#if defined(UX_HOST_ENUM_ADAPTIVE_TIMING_ENABLE)
+        if ((status != UX_SUCCESS) && !UX_DEVICE_PARENT_IS_HUB(device))
+        {
+
+            /* The device did not answer, next devices on this root hub port use the fixed delays.  */
+            hcd -> ux_hcd_rh_enum_fallback |=  (ULONG)(1u << port_index);
+        }
+#endif
+
+        /* The descriptors could not be read, the port is reset and the device
+           enumerated again as it is done without worker threads, while there
+           are attempts left.  */
+        if ((status != UX_SUCCESS) && (hcd -> ux_hcd_status == UX_HCD_STATUS_OPERATIONAL))
+        {
+#if UX_MAX_DEVICES > 1
+            if (UX_DEVICE_PARENT_IS_HUB(device))
+            {
+
+                /* The hub frees the device and processes its port connection again.  */
+                if ((_ux_system_host -> ux_system_host_enum_hub_retry_function != UX_NULL) &&
+                    (_ux_system_host -> ux_system_host_enum_hub_retry_function(device) == UX_SUCCESS))
+                    continue;
+            }
+            else
+#endif
+            if (device -> ux_device_enum_retry < UX_RH_ENUMERATION_RETRY - 1)
+            {
+
+                /* Simulate remove to free allocated resources before retry.  */
+                retry =  device -> ux_device_enum_retry + 1;
+                _ux_host_stack_device_remove(hcd, UX_NULL, port_index);
+                hcd -> ux_hcd_rh_device_connection &= (ULONG)~(1u << port_index);
+
+                /* Insert the device again, going on with the attempts left.  */
+#if defined(UX_HOST_ENUM_ADAPTIVE_TIMING_ENABLE)
+                _ux_utility_delay_ms(UX_MIN((ULONG)UX_HOST_ENUM_RETRY_DELAY_MIN << (retry - 1), UX_RH_ENUMERATION_RETRY_DELAY));
+#else
+                _ux_utility_delay_ms(UX_RH_ENUMERATION_RETRY_DELAY);
+#endif
+                hcd -> ux_hcd_rh_enum_retry =  retry;
+                _ux_host_stack_rh_device_insertion(hcd, port_index);
+                continue;
+            }
+        }
+
+        if (status == UX_SUCCESS)
+        {
+
+            /* The device, configuration(s), interface(s), endpoint(s) are
+               now in order for this device to work. First we need to find
+               a class driver that wants to own it.  */
+            UX_HOST_ENUM_PHASE_START(phase_start);
+            status =  _ux_host_stack_class_device_scan(device);
+            if (status == UX_NO_CLASS_MATCH)
+            {
+
+                status =  _ux_host_stack_class_interface_scan(device);
+            }
+            UX_HOST_ENUM_PHASE_END(device, UX_HOST_ENUM_PHASE_CLASS, phase_start);
+
+            /* Check if there is unnecessary resource to free.  */
+            if (device -> ux_device_packed_configuration &&
+                device -> ux_device_packed_configuration_keep_count == 0)
+            {
+                _ux_utility_memory_free(device -> ux_device_packed_configuration);
+                device -> ux_device_packed_configuration = UX_NULL;
+            }
+
+            /* If trace is enabled, register this object.  */
+            UX_TRACE_OBJECT_REGISTER(UX_TRACE_HOST_OBJECT_TYPE_DEVICE, UX_DEVICE_HCD_GET(device),
+                                     UX_DEVICE_PARENT_GET(device), UX_DEVICE_PORT_LOCATION_GET(device), 0);
+
+#if defined(UX_HOST_ENUM_ADAPTIVE_TIMING_ENABLE)
+
+            /* The device is enumerated, next attempts on this port use the minimum delays.  */
+            if (!UX_DEVICE_PARENT_IS_HUB(device))
+                hcd -> ux_hcd_rh_enum_fallback &= (ULONG)~(1u << port_index);
+#endif
+        }
+
+        /* Notify application for the connection of the device.
+           Device state unconfigured indicates enumeration fail.  */
+        if (_ux_system_host -> ux_system_host_change_function)
+        {
+            _ux_system_host -> ux_system_host_change_function(UX_DEVICE_CONNECTION, UX_NULL, (VOID*)device);
+        }
+
+        /* Check if the device enumeration failed.  */
+        if (status != UX_SUCCESS)
+        {
+
+            /* Error trap. */
+            _ux_system_error_handler(UX_SYSTEM_LEVEL_THREAD,
+                UX_DEVICE_PARENT_IS_HUB(device) ? UX_SYSTEM_CONTEXT_HUB :
+                                                  UX_SYSTEM_CONTEXT_ROOT_HUB,
+                UX_DEVICE_ENUMERATION_FAILURE);
+
+            /* If trace is enabled, insert this event into the trace buffer.  */
+            UX_TRACE_IN_LINE_INSERT(UX_TRACE_ERROR, UX_DEVICE_ENUMERATION_FAILURE,
+                UX_DEVICE_PORT_LOCATION_GET(device), 0, 0, UX_TRACE_ERRORS, 0, 0)
+        }
+    }
+}
+#endif
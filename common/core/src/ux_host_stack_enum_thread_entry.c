@@ -66,6 +66,7 @@
 /*                                                                        */ 
 /*  CALLS                                                                 */ 
 /*                                                                        */ 
+/*    _ux_host_stack_enum_ready_process     Process enumerated devices    */ 
 /*    _ux_host_stack_rh_change_process      Root hub processing           */ 
 /*    _ux_utility_semaphore_get             Get signal semaphore          */ 
 /*    (ux_system_host_enum_hub_function)    HUB enum processing function  */ 
@@ -86,6 +87,9 @@
 /*  01-31-2022     Chaoqiong Xiao           Modified comment(s),          */
 /*                                            refined macros names,       */
 /*                                            resulting in version 6.1.10 */
+/*  xx-xx-xxxx     Mohamed ayed             Modified comment(s),          */
+/*                                            added parallel enumeration, */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 VOID  _ux_host_stack_enum_thread_entry(ULONG input)
@@ -113,6 +117,13 @@ VOID  _ux_host_stack_enum_thread_entry(ULONG input)
 
         /* The signal may be also coming from the root hub, call the root hub handler.  */
         _ux_host_stack_rh_change_process();
+
+#if defined(UX_HOST_ENUM_PARALLEL_ENABLE)
+
+        /* The signal may be also coming from an enumeration worker, finish the
+           enumeration of the devices it gave back.  */
+        _ux_host_stack_enum_ready_process();
+#endif
     }
 }
 
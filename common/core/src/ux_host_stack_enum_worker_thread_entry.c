@@ -0,0 +1,167 @@
+/***************************************************************************
+ * Copyright (c) 2024 Microsoft Corporation
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the MIT License which is available at
+ * https://opensource.org/licenses/MIT.
+ *
+ * SPDX-License-Identifier: MIT
+ **************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** USBX Component                                                        */
+/**                                                                       */
+/**   Host Stack                                                          */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+
+/* Include necessary system files.  */
+
+#define UX_SOURCE_CODE
+
+#include "ux_api.h"
+#include "ux_host_stack.h"
+
+
+
+#if defined(UX_HOST_ENUM_PARALLEL_ENABLE)
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_host_stack_enum_worker_thread_entry             PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function is the entry point of the enumeration worker          */
+/*    threads. A worker takes a device queued by the enumeration thread   */
+/*    once the device has its address, waits for the device to accept     */
+/*    the address, then reads its device descriptor and its               */
+/*    configuration(s).                                                   */
+/*                                                                        */
+/*    Other devices can be reset and addressed by the enumeration thread  */
+/*    meanwhile, so the long waits and descriptor fetches of several      */
+/*    devices overlap. The device is then given back to the enumeration   */
+/*    thread which looks for its class.                                   */
+/*                                                                        */
+/*    It's for RTOS mode.                                                 */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    input                             Not used input                    */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _ux_host_semaphore_get_norc           Get semaphore                 */
+/*    _ux_host_semaphore_put                Put semaphore                 */
+/*    _ux_utility_delay_ms                  Delay                         */
+/*    _ux_host_stack_device_descriptor_read Read device descriptor        */
+/*    _ux_host_stack_configuration_enumerate                              */
+/*                                          Enumerate device config       */
+/*    _ux_utility_time_get                  Get current time              */
+/*    _ux_utility_time_elapsed              Compute elapsed time          */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    ThreadX                                                             */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Mohamed ayed             Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+VOID  _ux_host_stack_enum_worker_thread_entry(ULONG input)
+{
+
+UX_INTERRUPT_SAVE_AREA
+
+UX_DEVICE   *device;
+UX_DEVICE   **next;
+UINT        status;
+#if defined(UX_HOST_ENUM_ADAPTIVE_TIMING_ENABLE)
+ULONG       phase_start;
+#endif
+
+
+    UX_PARAMETER_NOT_USED(input);
+
+    /* Loop forever waiting for devices to enumerate.  */
+    while (1)
+    {
+
+        /* Wait for a device queued by the enumeration thread.  */
+        _ux_host_semaphore_get_norc(&_ux_system_host -> ux_system_host_enum_worker_semaphore, UX_WAIT_FOREVER);
+
+        /* Take the first device of the queue.  */
+        UX_DISABLE
+        device =  _ux_system_host -> ux_system_host_enum_device;
+        if (device != UX_NULL)
+            _ux_system_host -> ux_system_host_enum_device =  device -> ux_device_enum_next;
+        UX_RESTORE
+
+        /* The device may have been removed before it is taken.  */
+        if (device == UX_NULL)
+            continue;
+
+        /* Some devices need some time to accept the new address.  */
+        UX_HOST_ENUM_PHASE_START(phase_start);
+        _ux_utility_delay_ms(UX_HOST_ENUM_DEVICE_DELAY(device, UX_HOST_ENUM_DEVICE_ADDRESS_SET_WAIT_MIN,
+                                                       UX_DEVICE_ADDRESS_SET_WAIT));
+        UX_HOST_ENUM_PHASE_END(device, UX_HOST_ENUM_PHASE_ADDRESS, phase_start);
+
+        /* Get the device descriptor.  */
+        status =  UX_DEVICE_HANDLE_UNKNOWN;
+        UX_HOST_ENUM_PHASE_START(phase_start);
+        if (device -> ux_device_state != UX_DEVICE_REMOVED)
+            status =  _ux_host_stack_device_descriptor_read(device);
+        UX_HOST_ENUM_PHASE_END(device, UX_HOST_ENUM_PHASE_DEVICE_DESCRIPTOR, phase_start);
+
+        /* Get the configuration descriptor(s) for the device
+           and parse all the configuration, interface, endpoints...  */
+        if (status == UX_SUCCESS)
+        {
+            status =  UX_DEVICE_HANDLE_UNKNOWN;
+            UX_HOST_ENUM_PHASE_START(phase_start);
+            if (device -> ux_device_state != UX_DEVICE_REMOVED)
+                status =  _ux_host_stack_configuration_enumerate(device);
+            UX_HOST_ENUM_PHASE_END(device, UX_HOST_ENUM_PHASE_CONFIGURATION, phase_start);
+        }
+
+        /* Give the device back to the enumeration thread, unless it has been removed.  */
+        UX_DISABLE
+        device -> ux_device_enum_status =  status;
+        device -> ux_device_enum_next =  UX_NULL;
+        device -> ux_device_flags &= ~UX_DEVICE_FLAG_ENUM;
+        if (device -> ux_device_state == UX_DEVICE_REMOVED)
+            device =  UX_NULL;
+        else
+        {
+            device -> ux_device_flags |= UX_DEVICE_FLAG_READY;
+            next =  &_ux_system_host -> ux_system_host_enum_ready;
+            while (*next != UX_NULL)
+                next =  &(*next) -> ux_device_enum_next;
+            *next =  device;
+        }
+        UX_RESTORE
+
+        /* Wake up the enumeration thread to look for the class of the device.  */
+        if (device != UX_NULL)
+            _ux_host_semaphore_put(&_ux_system_host -> ux_system_host_enum_semaphore);
+    }
+}
+#endif
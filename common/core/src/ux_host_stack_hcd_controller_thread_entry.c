@@ -0,0 +1,106 @@
+/***************************************************************************
+ * Copyright (c) 2024 Microsoft Corporation
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the MIT License which is available at
+ * https://opensource.org/licenses/MIT.
+ *
+ * SPDX-License-Identifier: MIT
+ **************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** USBX Component                                                        */
+/**                                                                       */
+/**   Host Stack                                                          */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+
+/* Include necessary system files.  */
+
+#define UX_SOURCE_CODE
+
+#include "ux_api.h"
+#include "ux_host_stack.h"
+
+
+#if defined(UX_HOST_HCD_THREAD_PER_HCD_ENABLE)
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_host_stack_hcd_controller_thread_entry          PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function is the entry point of the thread of one host          */
+/*    controller. The thread is created when the HCD is registered, it    */
+/*    suspends until the HCD signals work for it, so several HCDs may     */
+/*    complete their transfers in parallel.                               */
+/*                                                                        */
+/*    It's for RTOS mode.                                                 */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    hcd_address                       Address of HCD                    */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _ux_host_semaphore_get_norc           Get signal semaphore          */
+/*    _ux_host_stack_hcd_thread_process     Process HCD work              */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    ThreadX                                                             */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Mohamed ayed             Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+VOID  _ux_host_stack_hcd_controller_thread_entry(ULONG hcd_address)
+{
+
+UX_INTERRUPT_SAVE_AREA
+
+UX_HCD      *hcd;
+ULONG       hcd_bit;
+
+
+    /* Get the HCD of this thread.  */
+    UX_THREAD_EXTENSION_PTR_GET(hcd, UX_HCD, hcd_address)
+
+    /* Get the bit of this HCD in the pending mask.  */
+    hcd_bit =  (ULONG)1u << (hcd - _ux_system_host -> ux_system_host_hcd_array);
+
+    /* Loop forever on the semaphore of this HCD.  */
+    while (1)
+    {
+
+        /* Wait for work on this HCD.  */
+        _ux_host_semaphore_get_norc(&hcd -> ux_hcd_semaphore, UX_WAIT_FOREVER);
+
+        /* The HCD is no longer pending, next signal wakes this thread up again.  */
+        UX_DISABLE
+        _ux_system_host -> ux_system_host_hcd_pending &=  ~hcd_bit;
+        UX_RESTORE
+
+        /* Process the work.  */
+        _ux_host_stack_hcd_thread_process(hcd);
+    }
+}
+#endif
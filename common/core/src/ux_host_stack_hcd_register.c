@@ -33,7 +33,7 @@
 /*  FUNCTION                                               RELEASE        */
 /*                                                                        */
 /*    _ux_host_stack_hcd_register                         PORTABLE C      */
-/*                                                           6.1          */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -64,6 +64,12 @@
 /*    _ux_utility_string_length_check       Check and return C string     */
 /*                                          length if no error            */
 /*    _ux_utility_memory_copy               Copy name into HCD structure  */
+/*    _ux_utility_memory_allocate           Allocate memory               */
+/*    _ux_utility_memory_free               Free memory                   */
+/*    _ux_utility_thread_create             Create thread                 */
+/*    _ux_utility_thread_resume             Resume thread                 */
+/*    _ux_host_semaphore_create             Create semaphore              */
+/*    _ux_host_semaphore_delete             Delete semaphore              */
 /*    (hcd_init_function)                   Init function of HCD driver   */
 /*                                                                        */
 /*  CALLED BY                                                             */
@@ -80,6 +86,9 @@
 /*                                            definitions, verified       */
 /*                                            memset and memcpy cases,    */
 /*                                            resulting in version 6.1    */
+/*  xx-xx-xxxx     Mohamed ayed             Modified comment(s),          */
+/*                                            added thread per HCD,       */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_host_stack_hcd_register(UCHAR *hcd_name,
@@ -134,6 +143,40 @@ ULONG       hcd_index;
             hcd -> ux_hcd_io =   hcd_param1;
             hcd -> ux_hcd_irq =  hcd_param2;
 
+#if defined(UX_HOST_HCD_THREAD_PER_HCD_ENABLE)
+
+            /* Allocate the stack of the thread that processes the work of this HCD.  */
+            hcd -> ux_hcd_thread_stack =  _ux_utility_memory_allocate(UX_NO_ALIGN, UX_REGULAR_MEMORY,
+                                                                      UX_HOST_HCD_THREAD_STACK_SIZE);
+            if (hcd -> ux_hcd_thread_stack == UX_NULL)
+                return(UX_MEMORY_INSUFFICIENT);
+
+            /* Create the semaphore used by the HCD to signal work to its thread.  */
+            status =  _ux_host_semaphore_create(&hcd -> ux_hcd_semaphore, "ux_hcd_semaphore", 0);
+            if (status != UX_SUCCESS)
+            {
+                _ux_utility_memory_free(hcd -> ux_hcd_thread_stack);
+                hcd -> ux_hcd_thread_stack =  UX_NULL;
+                return(UX_SEMAPHORE_ERROR);
+            }
+
+            /* Create the thread of this HCD, it is started once it knows its HCD.  */
+            status =  _ux_utility_thread_create(&hcd -> ux_hcd_thread, "ux_host_stack_hcd_controller_thread",
+                                _ux_host_stack_hcd_controller_thread_entry,
+                                (ULONG) (ALIGN_TYPE) hcd, hcd -> ux_hcd_thread_stack,
+                                UX_HOST_HCD_THREAD_STACK_SIZE, UX_THREAD_PRIORITY_HCD,
+                                UX_THREAD_PRIORITY_HCD, UX_NO_TIME_SLICE, UX_DONT_START);
+            if (status != UX_SUCCESS)
+            {
+                _ux_host_semaphore_delete(&hcd -> ux_hcd_semaphore);
+                _ux_utility_memory_free(hcd -> ux_hcd_thread_stack);
+                hcd -> ux_hcd_thread_stack =  UX_NULL;
+                return(UX_THREAD_ERROR);
+            }
+            UX_THREAD_EXTENSION_PTR_SET(&(hcd -> ux_hcd_thread), hcd)
+            _ux_utility_thread_resume(&hcd -> ux_hcd_thread);
+#endif
+
             /* This controller is now used */
             hcd -> ux_hcd_status =  UX_USED;
 
@@ -143,6 +186,18 @@ ULONG       hcd_index;
             /* We are now calling the HCD driver initialization.  */
             status =  hcd_init_function(hcd);
 
+#if defined(UX_HOST_HCD_THREAD_PER_HCD_ENABLE)
+
+            /* The controller is not working, free the thread of this HCD.  */
+            if (status != UX_SUCCESS)
+            {
+                _ux_utility_thread_delete(&hcd -> ux_hcd_thread);
+                _ux_host_semaphore_delete(&hcd -> ux_hcd_semaphore);
+                _ux_utility_memory_free(hcd -> ux_hcd_thread_stack);
+                hcd -> ux_hcd_thread_stack =  UX_NULL;
+            }
+#endif
+
             /* Return the completion status to the caller.  */
             return(status);
         }
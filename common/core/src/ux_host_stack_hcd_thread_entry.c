@@ -45,6 +45,10 @@
 /*    entry routine is invoked right away. This thread suspends until     */ 
 /*    one of the HCD resumes it due to HCD activities.                    */
 /*                                                                        */
+/*    With UX_HOST_HCD_THREAD_EVENT_ENABLE, the HCDs with work to do are  */
+/*    marked in a pending mask, all of them are processed in one pass     */
+/*    without scanning the other HCDs.                                    */
+/*                                                                        */
 /*    It's for RTOS mode.                                                 */
 /*                                                                        */ 
 /*  INPUT                                                                 */ 
@@ -58,6 +62,7 @@
 /*  CALLS                                                                 */ 
 /*                                                                        */ 
 /*    _ux_utility_semaphore_get             Get signal semaphore          */ 
+/*    _ux_host_stack_hcd_thread_process     Process HCD work              */
 /*    (ux_hcd_entry_function)               HCD's entry function          */ 
 /*                                                                        */ 
 /*  CALLED BY                                                             */ 
@@ -79,17 +84,52 @@
 /*  01-31-2022     Chaoqiong Xiao           Modified comment(s),          */
 /*                                            refined macros names,       */
 /*                                            resulting in version 6.1.10 */
+/*  xx-xx-xxxx     Mohamed ayed             Modified comment(s),          */
+/*                                            added HCD thread events,    */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 VOID  _ux_host_stack_hcd_thread_entry(ULONG input)
 {
 
+#if defined(UX_HOST_HCD_THREAD_EVENT_ENABLE)
+ULONG       hcd_pending;
+#else
 UINT        hcd_index;
+#endif
 UX_HCD      *hcd;
 UX_INTERRUPT_SAVE_AREA
     
     UX_PARAMETER_NOT_USED(input);
 
+#if defined(UX_HOST_HCD_THREAD_EVENT_ENABLE)
+
+    /* Loop forever on the semaphore. The semaphore is put when the first HCD
+       is marked pending, so one wake up covers all the HCDs marked since.  */
+    while (1)
+    {
+
+        /* Wait for HCD work.  */
+        _ux_host_semaphore_get_norc(&_ux_system_host -> ux_system_host_hcd_semaphore, UX_WAIT_FOREVER);
+
+        /* Take all the pending HCDs at once.  */
+        UX_DISABLE
+        hcd_pending =  _ux_system_host -> ux_system_host_hcd_pending;
+        _ux_system_host -> ux_system_host_hcd_pending =  0;
+        UX_RESTORE
+
+        /* Process the pending HCDs only.  */
+        hcd =  _ux_system_host -> ux_system_host_hcd_array;
+        while (hcd_pending != 0)
+        {
+            if (hcd_pending & 1u)
+                _ux_host_stack_hcd_thread_process(hcd);
+            hcd_pending >>= 1;
+            hcd ++;
+        }
+    }
+#else
+
     /* Loop forever on the semaphore. The semaphore is used to signal that 
        there is work for one or more HCDs.  */     
     while (1)
@@ -126,5 +166,6 @@ UX_INTERRUPT_SAVE_AREA
         }
 #endif
     }
+#endif
 }
 
@@ -0,0 +1,95 @@
+/***************************************************************************
+ * Copyright (c) 2024 Microsoft Corporation
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the MIT License which is available at
+ * https://opensource.org/licenses/MIT.
+ *
+ * SPDX-License-Identifier: MIT
+ **************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** USBX Component                                                        */
+/**                                                                       */
+/**   Host Stack                                                          */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+
+/* Include necessary system files.  */
+
+#define UX_SOURCE_CODE
+
+#include "ux_api.h"
+#include "ux_host_stack.h"
+
+
+#if defined(UX_HOST_HCD_THREAD_EVENT_ENABLE)
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_host_stack_hcd_thread_process                   PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function processes the work signaled by an HCD. The thread     */
+/*    signal is cleared first, so work signaled while processing is       */
+/*    processed on next wake up; then the HCD processes its whole done    */
+/*    queue.                                                              */
+/*                                                                        */
+/*    It's for RTOS mode.                                                 */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    hcd                               Pointer to HCD                    */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    (ux_hcd_entry_function)               HCD's entry function          */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    _ux_host_stack_hcd_thread_entry       HCD thread entry              */
+/*    _ux_host_stack_hcd_controller_thread_entry                          */
+/*                                          HCD controller thread entry   */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Mohamed ayed             Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+VOID  _ux_host_stack_hcd_thread_process(UX_HCD *hcd)
+{
+
+UX_INTERRUPT_SAVE_AREA
+
+
+    /* All the work signaled so far is processed now.  */
+    UX_DISABLE
+    hcd -> ux_hcd_thread_signal =  0;
+    UX_RESTORE
+
+    /* Is the HCD still operational?  */
+    if (hcd -> ux_hcd_status == UX_HCD_STATUS_OPERATIONAL)
+    {
+
+        /* Yes, call the HCD function to process the work.  */
+        hcd -> ux_hcd_entry_function(hcd, UX_HCD_PROCESS_DONE_QUEUE, UX_NULL);
+    }
+}
+#endif
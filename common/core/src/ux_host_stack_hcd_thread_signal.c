@@ -0,0 +1,109 @@
+/***************************************************************************
+ * Copyright (c) 2024 Microsoft Corporation
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the MIT License which is available at
+ * https://opensource.org/licenses/MIT.
+ *
+ * SPDX-License-Identifier: MIT
+ **************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** USBX Component                                                        */
+/**                                                                       */
+/**   Host Stack                                                          */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+
+/* Include necessary system files.  */
+
+#define UX_SOURCE_CODE
+
+#include "ux_api.h"
+#include "ux_host_stack.h"
+
+
+#if defined(UX_HOST_HCD_THREAD_EVENT_ENABLE)
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_host_stack_hcd_thread_signal                    PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function signals that an HCD has work for the HCD thread, it   */
+/*    is called by the HCD interrupt handler (or timer) instead of        */
+/*    incrementing the thread signal and putting the HCD semaphore.       */
+/*                                                                        */
+/*    The HCD is marked in the pending mask. The semaphore is only put    */
+/*    when the mask goes from empty to not empty (or, with a thread per   */
+/*    HCD, when this HCD was not pending yet), so bursts of interrupts    */
+/*    do not cause more wake ups than the thread can use.                 */
+/*                                                                        */
+/*    It's for RTOS mode.                                                 */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    hcd                               Pointer to HCD                    */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _ux_host_semaphore_put                Put semaphore                 */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    Host Controller Driver                                              */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Mohamed ayed             Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+VOID  _ux_host_stack_hcd_thread_signal(UX_HCD *hcd)
+{
+
+UX_INTERRUPT_SAVE_AREA
+
+ULONG       hcd_bit;
+ULONG       hcd_pending;
+
+
+    /* Get the bit of this HCD in the pending mask.  */
+    hcd_bit =  (ULONG)1u << (hcd - _ux_system_host -> ux_system_host_hcd_array);
+
+    /* Mark the HCD pending.  */
+    UX_DISABLE
+    hcd -> ux_hcd_thread_signal++;
+    hcd_pending =  _ux_system_host -> ux_system_host_hcd_pending;
+    _ux_system_host -> ux_system_host_hcd_pending =  hcd_pending | hcd_bit;
+    UX_RESTORE
+
+#if defined(UX_HOST_HCD_THREAD_PER_HCD_ENABLE)
+
+    /* Wake up the thread of this HCD if it was not pending yet.  */
+    if ((hcd_pending & hcd_bit) == 0)
+        _ux_host_semaphore_put(&hcd -> ux_hcd_semaphore);
+#else
+
+    /* Wake up the HCD thread if no HCD was pending yet.  */
+    if (hcd_pending == 0)
+        _ux_host_semaphore_put(&_ux_system_host -> ux_system_host_hcd_semaphore);
+#endif
+}
+#endif
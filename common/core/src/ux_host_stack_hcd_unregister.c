@@ -33,7 +33,7 @@
 /*  FUNCTION                                               RELEASE        */
 /*                                                                        */
 /*    _ux_host_stack_hcd_unregister                       PORTABLE C      */
-/*                                                           6.1.2        */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -64,6 +64,9 @@
 /*                                          length if no error            */
 /*    _ux_utility_memory_compare            Memory compare                */
 /*    (ux_hcd_entry_function)               HCD dispatch entry function   */
+/*    _ux_utility_thread_delete             Delete thread                 */
+/*    _ux_host_semaphore_delete             Delete semaphore              */
+/*    _ux_utility_memory_free               Free memory                   */
 /*                                                                        */
 /*  CALLED BY                                                             */
 /*                                                                        */
@@ -79,6 +82,9 @@
 /*                                            used HCD uninit command,    */
 /*                                            fixed HCD status scan,      */
 /*                                            resulting in version 6.1.2  */
+/*  xx-xx-xxxx     Mohamed ayed             Modified comment(s),          */
+/*                                            freed thread per HCD,       */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_host_stack_hcd_unregister(UCHAR *hcd_name,
@@ -93,6 +99,9 @@ ULONG       scan_index;
 #endif
 #if !defined(UX_NAME_REFERENCED_BY_POINTER)
 UINT        hcd_name_length =  0;
+#endif
+#if defined(UX_HOST_HCD_THREAD_EVENT_ENABLE)
+UX_INTERRUPT_SAVE_AREA
 #endif
 
 
@@ -152,6 +161,27 @@ UINT        hcd_name_length =  0;
     /* Now disable controller.  */
     hcd -> ux_hcd_entry_function(hcd, UX_HCD_UNINITIALIZE, UX_NULL);
 
+#if defined(UX_HOST_HCD_THREAD_PER_HCD_ENABLE)
+
+    /* The controller does not signal anymore, free the thread of this HCD,
+       it is already freed if the controller initialization failed.  */
+    if (hcd -> ux_hcd_thread_stack != UX_NULL)
+    {
+        _ux_utility_thread_delete(&hcd -> ux_hcd_thread);
+        _ux_host_semaphore_delete(&hcd -> ux_hcd_semaphore);
+        _ux_utility_memory_free(hcd -> ux_hcd_thread_stack);
+        hcd -> ux_hcd_thread_stack =  UX_NULL;
+    }
+#endif
+#if defined(UX_HOST_HCD_THREAD_EVENT_ENABLE)
+
+    /* Discard pending work of this HCD.  */
+    UX_DISABLE
+    _ux_system_host -> ux_system_host_hcd_pending &=
+            ~(ULONG)(1u << (hcd - _ux_system_host -> ux_system_host_hcd_array));
+    UX_RESTORE
+#endif
+
     /* Get first device.  */
     device = _ux_system_host -> ux_system_host_device_array;
 
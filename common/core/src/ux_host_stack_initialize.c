@@ -133,6 +133,11 @@ UCHAR _ux_system_host_hcd_simulator_name[] =                                "ux_
 /*  01-31-2022     Chaoqiong Xiao           Modified comment(s),          */
 /*                                            added standalone support,   */
 /*                                            resulting in version 6.1.10 */
+/*  xx-xx-xxxx     Mohamed ayed             Modified comment(s),          */
+/*                                            added parallel enum workers,*/
+/*                                            added descriptor cache,     */
+/*                                            added thread per HCD,       */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_host_stack_initialize(UINT (*ux_system_host_change_function)(ULONG, UX_HOST_CLASS *, VOID *))
@@ -143,6 +148,9 @@ UCHAR       *memory;
 #if defined(UX_HOST_STANDALONE)
 UINT        i;
 UX_DEVICE   *device;
+#endif
+#if defined(UX_HOST_ENUM_PARALLEL_ENABLE)
+UINT        worker_index;
 #endif
 
     /* If trace is enabled, insert this event into the trace buffer.  */
@@ -240,7 +248,9 @@ UX_DEVICE   *device;
             status = UX_MEMORY_INSUFFICIENT;
     }
 
-    /* Allocate another stack area.  */
+#if !defined(UX_HOST_HCD_THREAD_PER_HCD_ENABLE)
+
+    /* Allocate another stack area, each HCD has its own thread otherwise.  */
     if (status == UX_SUCCESS)
     {
         _ux_system_host -> ux_system_host_hcd_thread_stack =  _ux_utility_memory_allocate(UX_NO_ALIGN, UX_REGULAR_MEMORY,
@@ -250,6 +260,7 @@ UX_DEVICE   *device;
         if (_ux_system_host -> ux_system_host_hcd_thread_stack == UX_NULL)
             status = UX_MEMORY_INSUFFICIENT;
     }
+#endif
 
     /* Create the semaphores used by the hub and root hub to awake the enumeration thread.  */
     if (status == UX_SUCCESS)
@@ -259,6 +270,8 @@ UX_DEVICE   *device;
             status = UX_SEMAPHORE_ERROR;
     }
 
+#if !defined(UX_HOST_HCD_THREAD_PER_HCD_ENABLE)
+
     /* Create the semaphores used by the HCD to perform the completion phase of transfer_requests.  */
     if (status == UX_SUCCESS)
     {
@@ -266,6 +279,53 @@ UX_DEVICE   *device;
         if(status != UX_SUCCESS)
             status = UX_SEMAPHORE_ERROR;
     }
+#endif
+
+#if defined(UX_HOST_DESCRIPTOR_CACHE_ENABLE)
+
+    /* Create the mutex used to protect the descriptor cache.  */
+    if (status == UX_SUCCESS)
+    {
+        status =  _ux_host_mutex_create(&_ux_system_host -> ux_system_host_descriptor_cache_mutex, "ux_system_host_descriptor_cache_mutex");
+        if(status != UX_SUCCESS)
+            status = UX_MUTEX_ERROR;
+    }
+#endif
+
+#if defined(UX_HOST_ENUM_PARALLEL_ENABLE)
+
+    /* Obtain stack for the enumeration worker threads.  */
+    if (status == UX_SUCCESS)
+    {
+        _ux_system_host -> ux_system_host_enum_worker_thread_stack =  _ux_utility_memory_allocate_mulc_safe(UX_NO_ALIGN, UX_REGULAR_MEMORY,
+                                                                            UX_HOST_ENUM_PARALLEL_THREADS, UX_HOST_ENUM_WORKER_THREAD_STACK_SIZE);
+
+        /* Check for successful allocation.  */
+        if (_ux_system_host -> ux_system_host_enum_worker_thread_stack == UX_NULL)
+            status = UX_MEMORY_INSUFFICIENT;
+    }
+
+    /* Create the semaphore used to give devices to the enumeration worker threads.  */
+    if (status == UX_SUCCESS)
+    {
+        status =  _ux_utility_semaphore_create(&_ux_system_host -> ux_system_host_enum_worker_semaphore, "ux_system_host_enum_worker_semaphore", 0);
+        if(status != UX_SUCCESS)
+            status = UX_SEMAPHORE_ERROR;
+    }
+
+    /* Create the enumeration worker threads.  */
+    for (worker_index = 0; worker_index < UX_HOST_ENUM_PARALLEL_THREADS && status == UX_SUCCESS; worker_index ++)
+    {
+        status =  _ux_utility_thread_create(&_ux_system_host -> ux_system_host_enum_worker_thread[worker_index], "ux_system_host_enum_worker_thread", _ux_host_stack_enum_worker_thread_entry,
+                            worker_index, _ux_system_host -> ux_system_host_enum_worker_thread_stack + worker_index * UX_HOST_ENUM_WORKER_THREAD_STACK_SIZE,
+                            UX_HOST_ENUM_WORKER_THREAD_STACK_SIZE, UX_THREAD_PRIORITY_ENUM,
+                            UX_THREAD_PRIORITY_ENUM, UX_NO_TIME_SLICE, UX_AUTO_START);
+
+        /* Check the completion status.  */
+        if(status != UX_SUCCESS)
+            status = UX_THREAD_ERROR;
+    }
+#endif
 
     /* Create the enumeration thread of USBX.  */
     if (status == UX_SUCCESS)
@@ -280,6 +340,8 @@ UX_DEVICE   *device;
             status = UX_THREAD_ERROR;
     }
 
+#if !defined(UX_HOST_HCD_THREAD_PER_HCD_ENABLE)
+
     /* Create the HCD thread of USBX.  */
     if (status == UX_SUCCESS)
     {
@@ -293,6 +355,7 @@ UX_DEVICE   *device;
             status = UX_THREAD_ERROR;
     }
 #endif
+#endif
 
 #if defined(UX_OTG_SUPPORT) && !defined(UX_OTG_STANDALONE)
     /* Allocate another stack area for the HNP polling thread.  */
@@ -352,6 +415,31 @@ UX_DEVICE   *device;
     if (_ux_system_host -> ux_system_host_enum_thread.tx_thread_id != 0)
         _ux_utility_thread_delete(&_ux_system_host -> ux_system_host_enum_thread);
     
+#if defined(UX_HOST_ENUM_PARALLEL_ENABLE)
+
+    /* Delete _ux_system_host -> ux_system_host_enum_worker_thread.  */
+    for (worker_index = 0; worker_index < UX_HOST_ENUM_PARALLEL_THREADS; worker_index ++)
+    {
+        if (_ux_system_host -> ux_system_host_enum_worker_thread[worker_index].tx_thread_id != 0)
+            _ux_utility_thread_delete(&_ux_system_host -> ux_system_host_enum_worker_thread[worker_index]);
+    }
+
+    /* Delete _ux_system_host -> ux_system_host_enum_worker_semaphore.  */
+    if (_ux_system_host -> ux_system_host_enum_worker_semaphore.tx_semaphore_id != 0)
+        _ux_utility_semaphore_delete(&_ux_system_host -> ux_system_host_enum_worker_semaphore);
+
+    /* Free _ux_system_host -> ux_system_host_enum_worker_thread_stack.  */
+    if (_ux_system_host -> ux_system_host_enum_worker_thread_stack)
+        _ux_utility_memory_free(_ux_system_host -> ux_system_host_enum_worker_thread_stack);
+#endif
+
+#if defined(UX_HOST_DESCRIPTOR_CACHE_ENABLE)
+
+    /* Delete _ux_system_host -> ux_system_host_descriptor_cache_mutex.  */
+    if (_ux_system_host -> ux_system_host_descriptor_cache_mutex.tx_mutex_id != 0)
+        _ux_host_mutex_delete(&_ux_system_host -> ux_system_host_descriptor_cache_mutex);
+#endif
+
     /* Delete _ux_system_host -> ux_system_host_hcd_semaphore.  */
     if (_ux_system_host -> ux_system_host_hcd_semaphore.tx_semaphore_id != 0)
         _ux_utility_semaphore_delete(&_ux_system_host -> ux_system_host_hcd_semaphore);
@@ -33,7 +33,7 @@
 /*  FUNCTION                                               RELEASE        */ 
 /*                                                                        */ 
 /*    _ux_host_stack_interfaces_scan                      PORTABLE C      */ 
-/*                                                           6.1          */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -56,6 +56,8 @@
 /*                                                                        */ 
 /*  CALLS                                                                 */ 
 /*                                                                        */ 
+/*    _ux_host_stack_configuration_arena_create                           */
+/*                                            Create configuration arena  */
 /*    _ux_utility_descriptor_parse          Parse interface descriptor    */
 /*    _ux_host_stack_new_interface_create   Create new interface          */ 
 /*                                                                        */ 
@@ -70,6 +72,9 @@
 /*  05-19-2020     Chaoqiong Xiao           Initial Version 6.0           */
 /*  09-30-2020     Chaoqiong Xiao           Modified comment(s),          */
 /*                                            resulting in version 6.1    */
+/*  xx-xx-xxxx     Mohamed ayed             Modified comment(s),          */
+/*                                            added configuration arena,  */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_host_stack_interfaces_scan(UX_CONFIGURATION *configuration, UCHAR * descriptor)
@@ -86,6 +91,12 @@ UX_INTERFACE_ASSOCIATION_DESCRIPTOR interface_association;
     /* Retrieve the size of all the configuration descriptor.  */
     total_configuration_length =  configuration -> ux_configuration_descriptor.wTotalLength;
     
+#if defined(UX_HOST_DEVICE_ARENA_ENABLE)
+
+    /* Prepare memory for all interface and endpoint containers.  */
+    _ux_host_stack_configuration_arena_create(configuration, descriptor);
+#endif
+
     /* Set the IAD to false.  */
     interface_association_descriptor_present = UX_FALSE;
 
@@ -33,7 +33,7 @@
 /*  FUNCTION                                               RELEASE        */
 /*                                                                        */
 /*    _ux_host_stack_new_device_create                    PORTABLE C      */
-/*                                                           6.1.12       */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -80,8 +80,11 @@
 /*    _ux_host_stack_device_descriptor_read Read device descriptor        */
 /*    _ux_host_stack_configuration_enumerate                              */
 /*                                          Enumerate device config       */
+/*    _ux_host_semaphore_put                Put semaphore                 */
 /*    _ux_host_stack_new_device_get         Get new device                */
 /*    _ux_utility_semaphore_create          Create a semaphore            */
+/*    _ux_utility_time_get                  Get current time              */
+/*    _ux_utility_time_elapsed              Compute elapsed time          */
 /*    (ux_hcd_entry_function)               HCD entry function            */
 /*                                                                        */
 /*  CALLED BY                                                             */
@@ -109,6 +112,11 @@
 /*                                            freed shared device config  */
 /*                                            descriptor after enum scan, */
 /*                                            resulting in version 6.1.12 */
+/*  xx-xx-xxxx     Mohamed ayed             Modified comment(s),          */
+/*                                            added parallel enumeration, */
+/*                                            added adaptive enum timing, */
+/*                                            cleared enum fallback,      */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_host_stack_new_device_create(UX_HCD *hcd, UX_DEVICE *device_owner,
@@ -120,6 +128,13 @@ UINT  _ux_host_stack_new_device_create(UX_HCD *hcd, UX_DEVICE *device_owner,
 UX_DEVICE           *device;
 UINT                status;
 UX_ENDPOINT         *control_endpoint;
+#if defined(UX_HOST_ENUM_ADAPTIVE_TIMING_ENABLE)
+ULONG               phase_start;
+#endif
+#if defined(UX_HOST_ENUM_PARALLEL_ENABLE)
+UX_DEVICE           **next;
+UX_INTERRUPT_SAVE_AREA
+#endif
 
 
 #if UX_MAX_DEVICES > 1
@@ -174,6 +189,16 @@ UX_ENDPOINT         *control_endpoint;
     UX_DEVICE_PORT_LOCATION_SET(device, port_index);
     device -> ux_device_power_source =   UX_DEVICE_BUS_POWERED;
 
+#if defined(UX_HOST_ENUM_ADAPTIVE_TIMING_ENABLE)
+
+    /* Devices on a hub use the fixed delays, devices on a root hub port
+       use them once a device failed to enumerate on this port.  */
+    if (device_owner != UX_NULL)
+        device -> ux_device_enum_fallback =  UX_TRUE;
+    else
+        device -> ux_device_enum_fallback =  (hcd -> ux_hcd_rh_enum_fallback >> port_index) & 1u;
+#endif
+
     /* Create a semaphore for the device. This is to protect endpoint 0 mostly for OTG HNP polling. The initial count is 1 as
        a mutex mechanism.  */
     status =  _ux_host_semaphore_create(&device -> ux_device_protection_semaphore, "ux_host_endpoint0_semaphore", 1);
@@ -248,20 +273,46 @@ UX_ENDPOINT         *control_endpoint;
         /* Set the address of the device. The first time a USB device is
            accessed, it responds to the address 0. We need to change the address
            to a free device address between 1 and 127 ASAP.  */
+        UX_HOST_ENUM_PHASE_START(phase_start);
         status =  _ux_host_stack_device_address_set(device);
+        UX_HOST_ENUM_PHASE_END(device, UX_HOST_ENUM_PHASE_ADDRESS, phase_start);
+#if defined(UX_HOST_ENUM_PARALLEL_ENABLE)
+        if (status == UX_SUCCESS)
+        {
+
+            /* The device does not answer address 0 anymore, next device can be
+               reset. The rest of the enumeration is done by a worker thread.  */
+            UX_DISABLE
+            device -> ux_device_flags |= UX_DEVICE_FLAG_ENUM;
+            next =  &_ux_system_host -> ux_system_host_enum_device;
+            while (*next != UX_NULL)
+                next =  &(*next) -> ux_device_enum_next;
+            *next =  device;
+            UX_RESTORE
+
+            /* Wake up a worker thread.  */
+            _ux_host_semaphore_put(&_ux_system_host -> ux_system_host_enum_worker_semaphore);
+            return(UX_SUCCESS);
+        }
+#else
         if (status == UX_SUCCESS)
         {
 
             /* Get the device descriptor.  */
+            UX_HOST_ENUM_PHASE_START(phase_start);
             status =  _ux_host_stack_device_descriptor_read(device);
+            UX_HOST_ENUM_PHASE_END(device, UX_HOST_ENUM_PHASE_DEVICE_DESCRIPTOR, phase_start);
             if (status == UX_SUCCESS)
             {
 
                 /* Get the configuration descriptor(s) for the device
                    and parse all the configuration, interface, endpoints...  */
+                UX_HOST_ENUM_PHASE_START(phase_start);
                 status =  _ux_host_stack_configuration_enumerate(device);
+                UX_HOST_ENUM_PHASE_END(device, UX_HOST_ENUM_PHASE_CONFIGURATION, phase_start);
             }
         }
+#endif
     }
 
     /* Check the status of the previous operations. If there was an
@@ -269,11 +320,18 @@ UX_ENDPOINT         *control_endpoint;
        freed based on if we want to retry.  */
     if (status == UX_SUCCESS)
     {
+#if defined(UX_HOST_ENUM_ADAPTIVE_TIMING_ENABLE)
+
+        /* The device is enumerated, next attempts on its root hub port use the minimum delays.  */
+        if (device_owner == UX_NULL)
+            hcd -> ux_hcd_rh_enum_fallback &= (ULONG)~(1u << port_index);
+#endif
 
         /* The device, configuration(s), interface(s), endpoint(s) are
            now in order for this device to work. No configuration is set
            yet. First we need to find a class driver that wants to own
            it. There is no need to have an orphan device in a configured state.   */
+        UX_HOST_ENUM_PHASE_START(phase_start);
         status =  _ux_host_stack_class_device_scan(device);
         if (status == UX_NO_CLASS_MATCH)
         {
@@ -281,6 +339,7 @@ UX_ENDPOINT         *control_endpoint;
             status =  _ux_host_stack_class_interface_scan(device);
 
         }
+        UX_HOST_ENUM_PHASE_END(device, UX_HOST_ENUM_PHASE_CLASS, phase_start);
 
         /* Check if there is unnecessary resource to free.  */
         if (device -> ux_device_packed_configuration &&
@@ -33,7 +33,7 @@
 /*  FUNCTION                                               RELEASE        */ 
 /*                                                                        */ 
 /*    _ux_host_stack_new_device_get                       PORTABLE C      */ 
-/*                                                           6.1.12       */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -41,6 +41,8 @@
 /*  DESCRIPTION                                                           */
 /*                                                                        */ 
 /*    This function obtains a free device container for the new device.   */ 
+/*    The used containers are kept in a bitmap, so the words of the map   */
+/*    with all containers used are skipped.                               */
 /*                                                                        */ 
 /*  INPUT                                                                 */ 
 /*                                                                        */ 
@@ -71,6 +73,9 @@
 /*  07-29-2022     Chaoqiong Xiao           Modified comment(s),          */
 /*                                            fixed standalone enum init, */
 /*                                            resulting in version 6.1.12 */
+/*  xx-xx-xxxx     Mohamed ayed             Modified comment(s),          */
+/*                                            used map of containers,     */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UX_DEVICE  *_ux_host_stack_new_device_get(VOID)
@@ -78,54 +83,83 @@ UX_DEVICE  *_ux_host_stack_new_device_get(VOID)
 
 #if UX_MAX_DEVICES > 1
 ULONG           container_index;
+ULONG           map_index;
+ULONG           free_map;
 #endif
 UX_DEVICE       *device;
 #if defined(UX_HOST_STANDALONE)
 UX_DEVICE       *enum_next;
 #endif    
 
-    /* Start with the first device.  */
-    device =  _ux_system_host -> ux_system_host_device_array;    
-
 #if UX_MAX_DEVICES > 1
-    /* Reset the container index.  */
-    container_index =  0;
 
-    /* Search the list until the end.  */
-    while (container_index++ < _ux_system_host -> ux_system_host_max_devices)
-#endif
+    /* No free container found yet.  */
+    device =  UX_NULL;
+
+    /* Search the map of used containers a word at a time, full words are skipped.  */
+    for (map_index = 0; (map_index << 5) < _ux_system_host -> ux_system_host_max_devices; map_index++)
     {
 
-        /* Until we have found an unused entry.  */
-        if (device -> ux_device_handle == UX_UNUSED)
+        /* Get the free containers of this word.  */
+        free_map =  ~_ux_system_host -> ux_system_host_device_map[map_index];
+        container_index =  map_index << 5;
+
+        /* Check each free container of the word.  */
+        while ((free_map != 0) && (container_index < _ux_system_host -> ux_system_host_max_devices))
         {
 
-#if defined(UX_HOST_STANDALONE)
+            if (free_map & 1u)
+            {
 
-            /* Reset the entire entry except enum link.  */
-            enum_next = device -> ux_device_enum_next;
-            _ux_utility_memory_set(device, 0, sizeof(UX_DEVICE)); /* Use case of memset is verified. */
-            device -> ux_device_enum_next = enum_next;
-#else
+                /* This container is used from now on.  */
+                _ux_system_host -> ux_system_host_device_map[map_index] |=  (ULONG)1u << (container_index & 31u);
 
-            /* Reset the entire entry.  */
-            _ux_utility_memory_set(device, 0, sizeof(UX_DEVICE)); /* Use case of memset is verified. */
-#endif
+                /* Check the container is really unused.  */
+                if (_ux_system_host -> ux_system_host_device_array[container_index].ux_device_handle == UX_UNUSED)
+                {
 
-            /* This entry is now used.  */
-            device -> ux_device_handle =  UX_USED;
+                    device =  &_ux_system_host -> ux_system_host_device_array[container_index];
+                    break;
+                }
+            }
 
-            /* Return the device pointer.  */
-            return(device);
+            /* Move to the next container.  */
+            free_map >>= 1;
+            container_index++;
         }
-#if UX_MAX_DEVICES > 1
 
-        /* Move to the next device entry.  */
-        device++;
-#endif
+        /* Stop when a free container is found.  */
+        if (device != UX_NULL)
+            break;
     }
 
     /* No unused devices, return NULL.  */
-    return(UX_NULL);
+    if (device == UX_NULL)
+        return(UX_NULL);
+#else
+
+    /* Only one device, check if it's used.  */
+    device =  _ux_system_host -> ux_system_host_device_array;
+    if (device -> ux_device_handle != UX_UNUSED)
+        return(UX_NULL);
+#endif
+
+#if defined(UX_HOST_STANDALONE)
+
+    /* Reset the entire entry except enum link.  */
+    enum_next = device -> ux_device_enum_next;
+    _ux_utility_memory_set(device, 0, sizeof(UX_DEVICE)); /* Use case of memset is verified. */
+    device -> ux_device_enum_next = enum_next;
+#else
+
+    /* Reset the entire entry.  */
+    _ux_utility_memory_set(device, 0, sizeof(UX_DEVICE)); /* Use case of memset is verified. */
+#endif
+
+    /* This entry is now used.  */
+    device -> ux_device_handle =  UX_USED;
+
+    /* Return the device pointer.  */
+    return(device);
 }
 
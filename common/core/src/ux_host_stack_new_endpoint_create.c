@@ -33,7 +33,7 @@
 /*  FUNCTION                                               RELEASE        */ 
 /*                                                                        */ 
 /*    _ux_host_stack_new_endpoint_create                  PORTABLE C      */ 
-/*                                                           6.1.11       */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -59,6 +59,8 @@
 /*                                                                        */ 
 /*  CALLS                                                                 */ 
 /*                                                                        */ 
+/*    UX_HOST_STACK_CONTAINER_ALLOCATE      Allocate container            */
+/*    UX_HOST_STACK_CONTAINER_FREE          Free container                */
 /*    _ux_utility_descriptor_parse          Parse the descriptor          */ 
 /*    _ux_utility_memory_allocate           Allocate memory block         */ 
 /*                                                                        */ 
@@ -80,6 +82,9 @@
 /*                                            internal clean up,          */
 /*                                            fixed size calculation,     */
 /*                                            resulting in version 6.1.11 */
+/*  xx-xx-xxxx     Mohamed ayed             Modified comment(s),          */
+/*                                            added configuration arena,  */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_host_stack_new_endpoint_create(UX_INTERFACE *interface_ptr,
@@ -93,7 +98,7 @@ ULONG           packet_size;
 ULONG           n_tran;
 
     /* Obtain memory for storing this new endpoint.  */
-    endpoint =  (UX_ENDPOINT *) _ux_utility_memory_allocate(UX_NO_ALIGN, UX_REGULAR_MEMORY, sizeof(UX_ENDPOINT));
+    endpoint =  (UX_ENDPOINT *) UX_HOST_STACK_CONTAINER_ALLOCATE(interface_ptr -> ux_interface_configuration, sizeof(UX_ENDPOINT));
     if (endpoint == UX_NULL)
         return(UX_MEMORY_INSUFFICIENT);
 
@@ -123,7 +128,7 @@ ULONG           n_tran;
     /* Endpoint size should not be zero.  */
     if (endpoint -> ux_endpoint_descriptor.wMaxPacketSize == 0)
     {
-        _ux_utility_memory_free(endpoint);
+        UX_HOST_STACK_CONTAINER_FREE(interface_ptr -> ux_interface_configuration, endpoint);
         return(UX_DESCRIPTOR_CORRUPTED);
     }
 
@@ -140,7 +145,7 @@ ULONG           n_tran;
         /* If endpoint size not valid, return error.  */
         if (packet_size > 512)
         {
-            _ux_utility_memory_free(endpoint);
+            UX_HOST_STACK_CONTAINER_FREE(interface_ptr -> ux_interface_configuration, endpoint);
             return(UX_DESCRIPTOR_CORRUPTED);
         }
     }
@@ -153,7 +158,7 @@ ULONG           n_tran;
         packet_size = endpoint -> ux_endpoint_descriptor.wMaxPacketSize & UX_MAX_PACKET_SIZE_MASK;
         if (packet_size > 1024)
         {
-            _ux_utility_memory_free(endpoint);
+            UX_HOST_STACK_CONTAINER_FREE(interface_ptr -> ux_interface_configuration, endpoint);
             return(UX_DESCRIPTOR_CORRUPTED);
         }
 
@@ -161,14 +166,14 @@ ULONG           n_tran;
         n_tran = endpoint -> ux_endpoint_descriptor.wMaxPacketSize & UX_MAX_NUMBER_OF_TRANSACTIONS_MASK;
         if (n_tran >= UX_MAX_NUMBER_OF_TRANSACTIONS_MASK)
         {
-            _ux_utility_memory_free(endpoint);
+            UX_HOST_STACK_CONTAINER_FREE(interface_ptr -> ux_interface_configuration, endpoint);
             return(UX_DESCRIPTOR_CORRUPTED);
         }
 
         /* Isochronous/high speed interrupt interval should be 1~16.  */
         if (endpoint -> ux_endpoint_descriptor.bInterval < 1)
         {
-            _ux_utility_memory_free(endpoint);
+            UX_HOST_STACK_CONTAINER_FREE(interface_ptr -> ux_interface_configuration, endpoint);
             return(UX_DESCRIPTOR_CORRUPTED);
         }
         if ((endpoint_type == UX_ISOCHRONOUS_ENDPOINT) ||
@@ -178,7 +183,7 @@ ULONG           n_tran;
         {
             if (endpoint -> ux_endpoint_descriptor.bInterval > 16)
             {
-                _ux_utility_memory_free(endpoint);
+                UX_HOST_STACK_CONTAINER_FREE(interface_ptr -> ux_interface_configuration, endpoint);
                 return(UX_DESCRIPTOR_CORRUPTED);
             }
         }
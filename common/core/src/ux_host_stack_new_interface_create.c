@@ -33,7 +33,7 @@
 /*  FUNCTION                                               RELEASE        */ 
 /*                                                                        */ 
 /*    _ux_host_stack_new_interface_create                 PORTABLE C      */ 
-/*                                                           6.1.12       */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -64,6 +64,7 @@
 /*                                                                        */ 
 /*  CALLS                                                                 */ 
 /*                                                                        */ 
+/*    UX_HOST_STACK_CONTAINER_ALLOCATE      Allocate container            */
 /*    _ux_host_stack_new_endpoint_create    Create new endpoint           */ 
 /*    _ux_utility_descriptor_parse          Parse the descriptor          */ 
 /*    _ux_utility_memory_allocate           Allocate memory block         */ 
@@ -83,6 +84,9 @@
 /*                                            fixed parameter/variable    */
 /*                                            names conflict C++ keyword, */
 /*                                            resulting in version 6.1.12 */
+/*  xx-xx-xxxx     Mohamed ayed             Modified comment(s),          */
+/*                                            added configuration arena,  */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_host_stack_new_interface_create(UX_CONFIGURATION *configuration,
@@ -98,7 +102,7 @@ UINT                status;
 UCHAR               *this_interface_descriptor;
 
     /* Obtain memory for storing this new interface.  */
-    interface_ptr =  (UX_INTERFACE *) _ux_utility_memory_allocate(UX_NO_ALIGN, UX_REGULAR_MEMORY, sizeof(UX_INTERFACE));
+    interface_ptr =  (UX_INTERFACE *) UX_HOST_STACK_CONTAINER_ALLOCATE(configuration, sizeof(UX_INTERFACE));
     
     /* If no memory left, exit with error.  */        
     if (interface_ptr == UX_NULL)
@@ -0,0 +1,324 @@
+/***************************************************************************
+ * Copyright (c) 2024 Microsoft Corporation
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the MIT License which is available at
+ * https://opensource.org/licenses/MIT.
+ *
+ * SPDX-License-Identifier: MIT
+ **************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** USBX Component                                                        */
+/**                                                                       */
+/**   Utility                                                             */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+
+/* Include necessary system files.  */
+
+#define UX_SOURCE_CODE
+
+#include "ux_api.h"
+#include "ux_host_stack.h"
+
+
+#if defined(UX_HOST_PERIODIC_SCHEDULE_ENABLE)
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_host_stack_periodic_schedule_check              PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function finds a place in the periodic schedule for the        */
+/*    specified interrupt or isochronous endpoint. The schedule is kept   */
+/*    as the load of each (frame, microframe) slot of the main bus and    */
+/*    of each frame of the TTs. The endpoint uses the slots of one        */
+/*    offset in its period, the offset giving the lowest peak load is     */
+/*    selected. If the device is a 1.1 device behind a 2.0 hub on a 2.0   */
+/*    bus, the start split must be in the first microframes and the TT    */
+/*    of the hub must have room in the frames used.                       */
+/*                                                                        */
+/*    The placement is saved in the endpoint and added to the schedule    */
+/*    by _ux_host_stack_periodic_schedule_claim once the endpoint is      */
+/*    created. The host controller links the endpoint in the frame and    */
+/*    microframe of the selected offset.                                  */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    hcd                               Pointer to HCD                    */
+/*    endpoint                          Pointer to endpoint               */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    Completion Status                                                   */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _ux_system_error_handler              Log system error              */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    USBX Components                                                     */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Mohamed ayed             Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+UINT  _ux_host_stack_periodic_schedule_check(UX_HCD *hcd, UX_ENDPOINT *endpoint)
+{
+
+UX_DEVICE       *device;
+UX_DEVICE       *parent_device;
+UX_HUB_TT       *tt =  UX_NULL;
+ULONG           max_packet_size;
+ULONG           packet_size;
+ULONG           load;
+ULONG           tt_load =  0;
+ULONG           interval;
+ULONG           period;
+ULONG           tt_period;
+ULONG           offset;
+ULONG           slot;
+ULONG           slot_load;
+ULONG           peak_load;
+ULONG           best_offset =  0;
+ULONG           best_load =  0xFFFFFFFFu;
+ULONG           port_index;
+ULONG           port_map;
+ULONG           tt_index;
+const UCHAR     overheads[4][3] = {
+/*   LS  FS   HS   */
+    {63, 45, 173}, /* Control */
+    { 0,  9,  38}, /* Isochronous */
+    { 0, 13,  55}, /* Bulk */
+    {19, 13,  55}  /* Interrupt */
+};
+
+    /* Get the pointer to the device.  */
+    device =  endpoint -> ux_endpoint_device;
+
+    /* Calculate the bus time of one service interval, with the same units as
+       _ux_host_stack_bandwidth_check: HS frame units on the main bus, FS frame
+       units on the TT. Worst case bit stuffing is 7/6 of the raw time.  */
+    max_packet_size =  endpoint -> ux_endpoint_descriptor.wMaxPacketSize & UX_MAX_PACKET_SIZE_MASK;
+    packet_size =  (max_packet_size * 7 + 5) / 6;
+    packet_size += overheads[endpoint -> ux_endpoint_descriptor.bmAttributes & UX_MASK_ENDPOINT_TYPE][device -> ux_device_speed];
+
+    /* Check for high-speed endpoint.  */
+    if (device -> ux_device_speed == UX_HIGH_SPEED_DEVICE)
+    {
+
+        /* Get number of transactions.  */
+        packet_size *= ((endpoint -> ux_endpoint_descriptor.wMaxPacketSize & UX_MAX_NUMBER_OF_TRANSACTIONS_MASK) >>
+                            UX_MAX_NUMBER_OF_TRANSACTIONS_SHIFT) + 1;
+    }
+
+    /* Calculate the load of this endpoint in one slot of the main bus.  */
+    if (hcd -> ux_hcd_version != 0x200)
+    {
+
+        /* On a 1.1 bus a slot is a frame, use high speed timing as base.  */
+        if (device -> ux_device_speed == UX_LOW_SPEED_DEVICE)
+            load =  packet_size * 8 * 5;
+        else if (device -> ux_device_speed == UX_FULL_SPEED_DEVICE)
+            load =  packet_size * 5;
+        else
+            load =  packet_size;
+    }
+    else
+    {
+
+        /* On a 2.0 bus a slot is a microframe. The TT load is in full speed timing.  */
+        load =  packet_size;
+        if (device -> ux_device_speed == UX_LOW_SPEED_DEVICE)
+            tt_load =  packet_size * 8;
+        else
+            tt_load =  packet_size;
+    }
+
+    /* Calculate the period of the endpoint in microframes.  */
+    interval =  endpoint -> ux_endpoint_descriptor.bInterval;
+    if ((device -> ux_device_speed == UX_HIGH_SPEED_DEVICE) ||
+        ((endpoint -> ux_endpoint_descriptor.bmAttributes & UX_MASK_ENDPOINT_TYPE) == UX_ISOCHRONOUS_ENDPOINT))
+    {
+
+        /* Period is 2^(bInterval-1), in microframes for high speed, in frames otherwise.  */
+        if (interval == 0)
+            interval =  1;
+        if (interval > 16)
+            interval =  16;
+        period =  (ULONG)1u << (interval - 1);
+        if (device -> ux_device_speed != UX_HIGH_SPEED_DEVICE)
+            period =  period << 3;
+    }
+    else
+    {
+
+        /* Period is bInterval frames, scheduled with the power of 2 below it.  */
+        period =  8;
+        while ((period << 1) <= (interval << 3))
+            period =  period << 1;
+    }
+
+    /* On a 1.1 bus the host controller services isochronous endpoints in every frame.  */
+    if ((hcd -> ux_hcd_version != 0x200) &&
+        ((endpoint -> ux_endpoint_descriptor.bmAttributes & UX_MASK_ENDPOINT_TYPE) == UX_ISOCHRONOUS_ENDPOINT))
+        period =  8;
+
+    /* The periodic trees of the host controllers poll at least every
+       UX_HOST_PERIODIC_TREE_FRAMES frames.  */
+    if (period > (UX_HOST_PERIODIC_TREE_FRAMES << 3))
+        period =  UX_HOST_PERIODIC_TREE_FRAMES << 3;
+
+    /* Endpoints polled less often than the schedule are placed once in it.  */
+    if (period > UX_HOST_PERIODIC_SLOTS)
+        period =  UX_HOST_PERIODIC_SLOTS;
+
+    /* We need to take care of the case where the endpoint belongs to a USB 1.1
+       device that sits behind a 2.0 hub. The first 2.0 hub in the chain of hubs
+       holds the TT that does the split transactions.  */
+    if ((device -> ux_device_speed != UX_HIGH_SPEED_DEVICE) && (hcd -> ux_hcd_version == 0x200))
+    {
+
+        /* Remember the port on which the first 1.1 device is hooked to.  */
+        port_index =  device -> ux_device_port_location - 1;
+
+        /* Scan the chain of hubs upward.  */
+        parent_device =  device -> ux_device_parent;
+        while (parent_device != UX_NULL)
+        {
+
+            /* Determine if the device is high speed.  */
+            if (parent_device -> ux_device_speed == UX_HIGH_SPEED_DEVICE)
+            {
+
+                /* Find the TT that manages the port.  */
+                port_map =  (ULONG)(1 << port_index);
+                for (tt_index = 0; tt_index < UX_MAX_TT; tt_index++)
+                {
+
+                    /* Check if this TT owns the port where the device is attached.  */
+                    if ((parent_device -> ux_device_hub_tt[tt_index].ux_hub_tt_port_mapping & port_map) != 0)
+                    {
+
+                        tt =  &parent_device -> ux_device_hub_tt[tt_index];
+                        break;
+                    }
+                }
+
+                /* A 2.0 hub must have a TT for all its ports.  */
+                if (tt == UX_NULL)
+                {
+
+                    /* If trace is enabled, insert this event into the trace buffer.  */
+                    UX_TRACE_IN_LINE_INSERT(UX_TRACE_ERROR, UX_NO_BANDWIDTH_AVAILABLE, endpoint, 0, 0, UX_TRACE_ERRORS, 0, 0)
+
+                    /* Error trap. */
+                    _ux_system_error_handler(UX_SYSTEM_LEVEL_THREAD, UX_SYSTEM_CONTEXT_ENUMERATOR, UX_NO_BANDWIDTH_AVAILABLE);
+
+                    return(UX_NO_BANDWIDTH_AVAILABLE);
+                }
+                break;
+            }
+
+            /* We now remember where this hub is located on the parent.  */
+            port_index =  parent_device -> ux_device_port_location - 1;
+
+            /* We go up one level in the hub chain.  */
+            parent_device =  parent_device -> ux_device_parent;
+        }
+    }
+
+    /* The TT is scheduled by frames.  */
+    tt_period =  period >> 3;
+    if (tt_period > UX_HOST_PERIODIC_TT_FRAMES)
+        tt_period =  UX_HOST_PERIODIC_TT_FRAMES;
+
+    /* Try all the offsets in the period and keep the one with the lowest peak load.  */
+    for (offset = 0; offset < period; offset++)
+    {
+
+        /* On a 1.1 bus the slot is the frame: only microframe 0 is used.  */
+        if ((hcd -> ux_hcd_version != 0x200) && ((offset & 7) != 0))
+            continue;
+
+        /* Start splits must leave room for the complete splits in the frame.  */
+        if ((tt != UX_NULL) && ((offset & 7) >= UX_HOST_PERIODIC_SPLIT_MICROFRAMES))
+            continue;
+
+        /* Find the peak load of the slots used with this offset.  */
+        peak_load =  0;
+        for (slot = offset; slot < UX_HOST_PERIODIC_SLOTS; slot += period)
+        {
+
+            slot_load =  (ULONG)hcd -> ux_hcd_periodic_load[slot] + load;
+            if (slot_load > peak_load)
+                peak_load =  slot_load;
+        }
+
+        /* Check the main bus has room in all the slots.  */
+        if (peak_load > hcd -> ux_hcd_available_bandwidth)
+            continue;
+
+        /* Check the TT has room in all the frames.  */
+        if (tt != UX_NULL)
+        {
+
+            for (slot = (offset >> 3) % tt_period; slot < UX_HOST_PERIODIC_TT_FRAMES; slot += tt_period)
+            {
+
+                if ((ULONG)tt -> ux_hub_tt_periodic_load[slot] + tt_load > tt -> ux_hub_tt_max_bandwidth)
+                    break;
+            }
+            if (slot < UX_HOST_PERIODIC_TT_FRAMES)
+                continue;
+        }
+
+        /* Keep the offset that spreads the load best.  */
+        if (peak_load < best_load)
+        {
+
+            best_load =  peak_load;
+            best_offset =  offset;
+        }
+    }
+
+    /* Check if a slot is found.  */
+    if (best_load == 0xFFFFFFFFu)
+    {
+
+        /* If trace is enabled, insert this event into the trace buffer.  */
+        UX_TRACE_IN_LINE_INSERT(UX_TRACE_ERROR, UX_NO_BANDWIDTH_AVAILABLE, endpoint, 0, 0, UX_TRACE_ERRORS, 0, 0)
+
+        /* Error trap. */
+        _ux_system_error_handler(UX_SYSTEM_LEVEL_THREAD, UX_SYSTEM_CONTEXT_ENUMERATOR, UX_NO_BANDWIDTH_AVAILABLE);
+
+        return(UX_NO_BANDWIDTH_AVAILABLE);
+    }
+
+    /* Save the placement of the endpoint, it is claimed once the endpoint is created.  */
+    endpoint -> ux_endpoint_schedule_tt =  tt;
+    endpoint -> ux_endpoint_schedule_load =  (USHORT)load;
+    endpoint -> ux_endpoint_schedule_tt_load =  (USHORT)tt_load;
+    endpoint -> ux_endpoint_schedule_period =  (USHORT)period;
+    endpoint -> ux_endpoint_schedule_offset =  (USHORT)best_offset;
+
+    /* Return successful completion.  */
+    return(UX_SUCCESS);
+}
+#endif
@@ -0,0 +1,104 @@
+/***************************************************************************
+ * Copyright (c) 2024 Microsoft Corporation
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the MIT License which is available at
+ * https://opensource.org/licenses/MIT.
+ *
+ * SPDX-License-Identifier: MIT
+ **************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** USBX Component                                                        */
+/**                                                                       */
+/**   Utility                                                             */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+
+/* Include necessary system files.  */
+
+#define UX_SOURCE_CODE
+
+#include "ux_api.h"
+#include "ux_host_stack.h"
+
+
+#if defined(UX_HOST_PERIODIC_SCHEDULE_ENABLE)
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_host_stack_periodic_schedule_claim              PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function adds the load of a periodic endpoint to the slots of  */
+/*    the main bus and to the frames of the TT selected by                */
+/*    _ux_host_stack_periodic_schedule_check.                             */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    hcd                               Pointer to HCD                    */
+/*    endpoint                          Pointer to endpoint               */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    USBX Components                                                     */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Mohamed ayed             Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+VOID  _ux_host_stack_periodic_schedule_claim(UX_HCD *hcd, UX_ENDPOINT *endpoint)
+{
+
+UX_HUB_TT       *tt;
+ULONG           slot;
+ULONG           tt_period;
+
+
+    /* Add the endpoint load to all the slots it uses on the main bus.  */
+    for (slot = endpoint -> ux_endpoint_schedule_offset; slot < UX_HOST_PERIODIC_SLOTS;
+         slot += endpoint -> ux_endpoint_schedule_period)
+        hcd -> ux_hcd_periodic_load[slot] = (USHORT)(hcd -> ux_hcd_periodic_load[slot] + endpoint -> ux_endpoint_schedule_load);
+
+    /* Add the endpoint load to all the frames it uses on the TT.  */
+    tt =  endpoint -> ux_endpoint_schedule_tt;
+    if (tt != UX_NULL)
+    {
+
+        tt_period =  (ULONG)endpoint -> ux_endpoint_schedule_period >> 3;
+        if (tt_period > UX_HOST_PERIODIC_TT_FRAMES)
+            tt_period =  UX_HOST_PERIODIC_TT_FRAMES;
+        for (slot = ((ULONG)endpoint -> ux_endpoint_schedule_offset >> 3) % tt_period;
+             slot < UX_HOST_PERIODIC_TT_FRAMES; slot += tt_period)
+            tt -> ux_hub_tt_periodic_load[slot] = (USHORT)(tt -> ux_hub_tt_periodic_load[slot] + endpoint -> ux_endpoint_schedule_tt_load);
+    }
+
+    /* The load is now in the schedule.  */
+    endpoint -> ux_endpoint_schedule_claimed =  UX_TRUE;
+
+    /* Return to caller.  */
+    return;
+}
+#endif
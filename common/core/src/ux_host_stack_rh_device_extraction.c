@@ -33,7 +33,7 @@
 /*  FUNCTION                                               RELEASE        */ 
 /*                                                                        */ 
 /*    _ux_host_stack_rh_device_extraction                 PORTABLE C      */ 
-/*                                                           6.1          */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -67,6 +67,9 @@
 /*  05-19-2020     Chaoqiong Xiao           Initial Version 6.0           */
 /*  09-30-2020     Chaoqiong Xiao           Modified comment(s),          */
 /*                                            resulting in version 6.1    */
+/*  xx-xx-xxxx     Mohamed ayed             Modified comment(s),          */
+/*                                            cleared enum fallback,      */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_host_stack_rh_device_extraction(UX_HCD *hcd, UINT port_index)
@@ -81,6 +84,12 @@ UINT  _ux_host_stack_rh_device_extraction(UX_HCD *hcd, UINT port_index)
     /* The device has been removed, so the port is free again.  */
     hcd -> ux_hcd_rh_device_connection &= (ULONG)~(1 << port_index);
 
+#if defined(UX_HOST_ENUM_ADAPTIVE_TIMING_ENABLE)
+
+    /* Next device on this port is enumerated with the minimum delays again.  */
+    hcd -> ux_hcd_rh_enum_fallback &= (ULONG)~(1u << port_index);
+#endif
+
     /* That command should never fail!  */
     return(UX_SUCCESS);
 }
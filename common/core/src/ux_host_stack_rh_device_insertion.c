@@ -33,7 +33,7 @@
 /*  FUNCTION                                               RELEASE        */
 /*                                                                        */
 /*    _ux_host_stack_rh_device_insertion                  PORTABLE C      */
-/*                                                           6.1.11       */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -57,6 +57,8 @@
 /*    _ux_utility_delay_ms                  Thread sleep                  */
 /*    _ux_host_stack_new_device_create      New device create             */
 /*    _ux_host_stack_device_remove          Device remove                 */
+/*    _ux_utility_time_get                  Get current time              */
+/*    _ux_utility_time_elapsed              Compute elapsed time          */
 /*    (hcd_entry_function)                  Entry function of HCD driver  */
 /*                                                                        */
 /*  CALLED BY                                                             */
@@ -86,6 +88,11 @@
 /*  04-25-2022     Chaoqiong Xiao           Modified comment(s),          */
 /*                                            internal clean up,          */
 /*                                            resulting in version 6.1.11 */
+/*  xx-xx-xxxx     Mohamed ayed             Modified comment(s),          */
+/*                                            notified in parallel enum,  */
+/*                                            added adaptive enum timing, */
+/*                                            retried worker failures,    */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_host_stack_rh_device_insertion(UX_HCD *hcd, UINT port_index)
@@ -123,6 +130,10 @@ UINT        index_loop;
 UINT        device_speed;
 ULONG       port_status;
 UINT        status;
+#if defined(UX_HOST_ENUM_ADAPTIVE_TIMING_ENABLE)
+ULONG       phase_start;
+ULONG       reset_time;
+#endif
 
     /* If trace is enabled, insert this event into the trace buffer.  */
     UX_TRACE_IN_LINE_INSERT(UX_TRACE_HOST_STACK_RH_DEVICE_INSERTION, hcd, port_index, 0, 0, UX_TRACE_HOST_STACK_EVENTS, 0, 0)
@@ -141,10 +152,18 @@ UINT        status;
        Typically, after the port is reset and the first command is sent to
        the device, there is no answer. In this case, we reset the port again
        and retry. Usually that does the trick!  */
-    for (index_loop = 0; index_loop < UX_RH_ENUMERATION_RETRY; index_loop++)
+    index_loop =  0;
+#if defined(UX_HOST_ENUM_PARALLEL_ENABLE)
+
+    /* A device which failed in an enumeration worker goes on with the attempts left.  */
+    index_loop =  hcd -> ux_hcd_rh_enum_retry;
+    hcd -> ux_hcd_rh_enum_retry =  0;
+#endif
+    for (; index_loop < UX_RH_ENUMERATION_RETRY; index_loop++)
     {
 
         /* Now we have to do a PORT_RESET command.  */
+        UX_HOST_ENUM_PHASE_START(phase_start);
         port_status =  hcd -> ux_hcd_entry_function(hcd, UX_HCD_RESET_PORT, (VOID *)((ALIGN_TYPE)port_index));
         if (port_status == UX_SUCCESS)
         {
@@ -177,9 +196,19 @@ UINT        status;
             /* Set the device speed.  */
             device_speed =  port_status >> UX_PS_DS;
 
+#if defined(UX_HOST_ENUM_ADAPTIVE_TIMING_ENABLE)
+
+            /* Keep the time of the reset phase for the device.  */
+            reset_time =  (ULONG)_ux_utility_time_elapsed(phase_start, _ux_utility_time_get());
+#endif
+
             /* Ask the USB stack to enumerate this device. A root hub is considered self
                powered. */
             status =  _ux_host_stack_new_device_create(hcd, UX_NULL, port_index, device_speed, UX_MAX_SELF_POWER, &device);
+#if defined(UX_HOST_ENUM_ADAPTIVE_TIMING_ENABLE)
+            if (device != UX_NULL)
+                device -> ux_device_enum_phase_time[UX_HOST_ENUM_PHASE_RESET] =  reset_time;
+#endif
 
             /* Check return status.  */
             if (status == UX_SUCCESS)
@@ -192,11 +221,19 @@ UINT        status;
                    function again */
                 hcd -> ux_hcd_rh_device_connection |= (ULONG)(1 << port_index);
 
-                /* If the device instance is ready, notify application for connection.  */
+#if !defined(UX_HOST_ENUM_PARALLEL_ENABLE)
+
+                /* If the device instance is ready, notify application for connection.
+                   With parallel enumeration it's done when the enumeration ends.  */
                 if (_ux_system_host -> ux_system_host_change_function)
                 {
                     _ux_system_host -> ux_system_host_change_function(UX_DEVICE_CONNECTION, UX_NULL, (VOID*)device);
                 }
+#else
+
+                /* Remember the attempt in case the enumeration worker fails.  */
+                device -> ux_device_enum_retry =  index_loop;
+#endif
 
                 /* Return success to the caller.  */
                 return(UX_SUCCESS);
@@ -225,7 +262,15 @@ UINT        status;
         /* We get here if something did not go well. Either the port did not respond
            well to the ENABLE\RESET phases or the device did not enumerate well
            so we try again ! */
+#if defined(UX_HOST_ENUM_ADAPTIVE_TIMING_ENABLE)
+
+        /* Next attempts on this port use the fixed delays, the delay before
+           the next attempt backs off up to the fixed retry delay.  */
+        hcd -> ux_hcd_rh_enum_fallback |=  (ULONG)(1u << port_index);
+        _ux_utility_delay_ms(UX_MIN((ULONG)UX_HOST_ENUM_RETRY_DELAY_MIN << index_loop, UX_RH_ENUMERATION_RETRY_DELAY));
+#else
         _ux_utility_delay_ms(UX_RH_ENUMERATION_RETRY_DELAY);
+#endif
     }
 #endif /* defined(UX_HOST_STANDALONE)  */
 
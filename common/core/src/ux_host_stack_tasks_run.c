@@ -43,7 +43,7 @@ static inline VOID _ux_host_stack_pending_transfers_run(VOID);
 /*  FUNCTION                                                 RELEASE      */
 /*                                                                        */
 /*    _ux_host_stack_tasks_run                              PORTABLE C    */
-/*                                                             6.3.0      */
+/*                                                             6.x        */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -83,6 +83,8 @@ static inline VOID _ux_host_stack_pending_transfers_run(VOID);
 /*    _ux_host_stack_class_interface_scan   Query interface class driver  */
 /*    _ux_host_stack_interfaces_scan        Parse interfaces in a         */
 /*                                          configuration                 */
+/*    _ux_host_stack_descriptor_cache_read  Read cached configuration     */
+/*    _ux_host_stack_descriptor_cache_save  Cache configuration           */
 /*    _ux_host_stack_device_remove          Remove a device               */
 /*    _ux_utility_descriptor_parse          Parse a descriptor            */
 /*    _ux_utility_memory_allocate           Allocate memory               */
@@ -112,6 +114,10 @@ static inline VOID _ux_host_stack_pending_transfers_run(VOID);
 /*  10-31-2023     Chaoqiong Xiao           Modified comment(s),          */
 /*                                            improved enum transfer,     */
 /*                                            resulting in version 6.3.0  */
+/*  xx-xx-xxxx     Mohamed ayed             Modified comment(s),          */
+/*                                            added descriptor cache,     */
+/*                                            fixed address free on reset,*/
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT _ux_host_stack_tasks_run(VOID)
@@ -564,7 +570,7 @@ INT                     immediate_state = UX_TRUE;
                     /* Free the address.  */
                     UX_DEVICE_HCD_GET(device) ->
                     ux_hcd_address[(device -> ux_device_address-1) >> 3] &=
-                        (UCHAR)(1u << ((device -> ux_device_address-1) & 7u));
+                        (UCHAR)~(1u << ((device -> ux_device_address-1) & 7u));
                 }
 #endif
 
@@ -790,6 +796,25 @@ INT                     immediate_state = UX_TRUE;
                 }
                 trans -> ux_transfer_request_data_pointer = buffer;
 
+#if defined(UX_HOST_DESCRIPTOR_CACHE_ENABLE)
+
+                /* A known configuration is taken from the descriptor cache instead of being read again.  */
+                if (_ux_host_stack_descriptor_cache_read(device, configuration,
+                                    device -> ux_device_enum_index, buffer) == UX_SUCCESS)
+                {
+
+                    /* Parse configuration and it's interfaces, release descriptor memory.  */
+                    status = _ux_host_stack_interfaces_scan(configuration, buffer);
+                    _ux_utility_memory_free(buffer);
+                    trans -> ux_transfer_request_data_pointer = UX_NULL;
+
+                    /* Check operation status, enumerate next configuration.  */
+                    device -> ux_device_enum_state = (status == UX_SUCCESS) ?
+                            UX_HOST_STACK_ENUM_CONFIG_DESCR_NEXT : UX_HOST_STACK_ENUM_RETRY;
+                    continue;
+                }
+#endif
+
                 /* Modify transfer length for total configuration  */
                 trans -> ux_transfer_request_requested_length =
                     configuration -> ux_configuration_descriptor.wTotalLength;
@@ -807,6 +832,12 @@ INT                     immediate_state = UX_TRUE;
 
             /* Parse configuration and it's interfaces.  */
             status = _ux_host_stack_interfaces_scan(configuration, buffer);
+#if defined(UX_HOST_DESCRIPTOR_CACHE_ENABLE)
+
+            /* Keep the configuration for next enumeration of the device.  */
+            if (status == UX_SUCCESS)
+                _ux_host_stack_descriptor_cache_save(device, device -> ux_device_enum_index, buffer);
+#endif
 
             /* Release descriptor memory.  */
             _ux_utility_memory_free(buffer);
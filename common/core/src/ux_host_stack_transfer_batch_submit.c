@@ -0,0 +1,188 @@
+/***************************************************************************
+ * Copyright (c) 2024 Microsoft Corporation 
+ * 
+ * This program and the accompanying materials are made available under the
+ * terms of the MIT License which is available at
+ * https://opensource.org/licenses/MIT.
+ * 
+ * SPDX-License-Identifier: MIT
+ **************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */ 
+/** USBX Component                                                        */ 
+/**                                                                       */
+/**   Host Stack                                                          */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+
+/* Include necessary system files.  */
+
+#define UX_SOURCE_CODE
+
+#include "ux_api.h"
+#include "ux_host_stack.h"
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_host_stack_transfer_batch_submit                PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function submits a batch of transfer requests without waiting  */
+/*    for their completion. If a completion function is given, it is set  */
+/*    on every transfer request of the batch, otherwise each request      */
+/*    must have its own completion function. The submission stops on the  */
+/*    first transfer request that fails to start.                         */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    transfer_requests                 Array of transfer requests        */
+/*    count                             Number of transfer requests       */
+/*    completion_function               Transfer completion function      */
+/*    actual_count                      Number of requests started        */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    Completion Status                 If UX_SUCCESS, all transfers      */
+/*                                        were successfully started       */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _ux_host_stack_transfer_submit        Submit a transfer request     */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    Application                                                         */
+/*    USBX Components                                                     */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Mohamed ayed             Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+UINT  _ux_host_stack_transfer_batch_submit(UX_TRANSFER **transfer_requests, ULONG count,
+                                    VOID (*completion_function)(UX_TRANSFER *), ULONG *actual_count)
+{
+
+UX_TRANSFER     *transfer_request;
+ULONG           index;
+UINT            status;
+
+
+    /* Submit the transfer requests in order.  */
+    status =  UX_SUCCESS;
+    for (index = 0; index < count; index ++)
+    {
+
+        /* Get the transfer request.  */
+        transfer_request =  transfer_requests[index];
+
+        /* Submit it with the batch callback or its own one.  */
+        if (completion_function != UX_NULL)
+            status =  _ux_host_stack_transfer_submit(transfer_request, completion_function);
+        else
+            status =  _ux_host_stack_transfer_submit(transfer_request,
+                                    transfer_request -> ux_transfer_request_completion_function);
+
+        /* Stop on first error, the requests after it are not started.  */
+        if (status != UX_SUCCESS)
+            break;
+    }
+
+    /* Return the number of requests started.  */
+    if (actual_count != UX_NULL)
+        *actual_count =  index;
+
+    /* Return completion status.  */
+    return(status);
+}
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _uxe_host_stack_transfer_batch_submit               PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function checks errors in host stack transfer batch submit     */
+/*    function call.                                                      */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    transfer_requests                 Array of transfer requests        */
+/*    count                             Number of transfer requests       */
+/*    completion_function               Transfer completion function      */
+/*    actual_count                      Number of requests started        */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _ux_host_stack_transfer_batch_submit  Submit transfer requests      */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    Application                                                         */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Mohamed ayed             Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+UINT  _uxe_host_stack_transfer_batch_submit(UX_TRANSFER **transfer_requests, ULONG count,
+                                    VOID (*completion_function)(UX_TRANSFER *), ULONG *actual_count)
+{
+
+UX_TRANSFER     *transfer_request;
+ULONG           index;
+
+
+    /* Sanity checks.  */
+    if (transfer_requests == UX_NULL)
+        return(UX_INVALID_PARAMETER);
+    for (index = 0; index < count; index ++)
+    {
+        transfer_request =  transfer_requests[index];
+        if (transfer_request == UX_NULL)
+            return(UX_INVALID_PARAMETER);
+        if ((completion_function == UX_NULL) &&
+            (transfer_request -> ux_transfer_request_completion_function == UX_NULL))
+            return(UX_INVALID_PARAMETER);
+        if (transfer_request -> ux_transfer_request_endpoint == UX_NULL)
+            return(UX_ENDPOINT_HANDLE_UNKNOWN);
+        if (transfer_request -> ux_transfer_request_endpoint -> ux_endpoint_device == UX_NULL)
+            return(UX_DEVICE_HANDLE_UNKNOWN);
+        if (UX_DEVICE_HCD_GET(transfer_request -> ux_transfer_request_endpoint -> ux_endpoint_device) == UX_NULL)
+            return(UX_INVALID_PARAMETER);
+        if ((transfer_request -> ux_transfer_request_endpoint -> ux_endpoint_descriptor.bmAttributes &
+                                        UX_MASK_ENDPOINT_TYPE) == UX_CONTROL_ENDPOINT)
+            return(UX_FUNCTION_NOT_SUPPORTED);
+    }
+
+    /* Invoke transfer batch submit function.  */
+    return(_ux_host_stack_transfer_batch_submit(transfer_requests, count, completion_function, actual_count));
+}
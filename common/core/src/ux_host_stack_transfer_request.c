@@ -33,7 +33,7 @@
 /*  FUNCTION                                               RELEASE        */ 
 /*                                                                        */ 
 /*    _ux_host_stack_transfer_request                     PORTABLE C      */ 
-/*                                                           6.1.10       */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -66,6 +66,7 @@
 /*    HCD Entry Function                                                  */ 
 /*    _ux_utility_semaphore_put             Put semaphore                 */
 /*    _ux_utility_semaphore_get             Get semaphore                 */
+/*    _ux_host_semaphore_get_norc           Get semaphore                 */
 /*                                                                        */ 
 /*  CALLED BY                                                             */ 
 /*                                                                        */ 
@@ -87,6 +88,10 @@
 /*  01-31-2022     Chaoqiong Xiao           Modified comment(s),          */
 /*                                            added standalone support,   */
 /*                                            resulting in version 6.1.10 */
+/*  xx-xx-xxxx     Mohamed ayed             Modified comment(s),          */
+/*                                            took back stale semaphore   */
+/*                                            counts before a transfer,   */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_host_stack_transfer_request(UX_TRANSFER *transfer_request)
@@ -203,6 +208,12 @@ UINT            status;
         }        
     }             
     
+    /* HCDs put the semaphore on completion even if there is a callback, a request
+       submitted again from its callback then keeps a count. Take back the counts
+       left by previous completions, so a new wait does not return early.  */
+    while (_ux_host_semaphore_waiting(&transfer_request -> ux_transfer_request_semaphore))
+        _ux_host_semaphore_get_norc(&transfer_request -> ux_transfer_request_semaphore, UX_NO_WAIT);
+
     /* Send the command to the controller.  */    
     status =  hcd -> ux_hcd_entry_function(hcd, UX_HCD_TRANSFER_REQUEST, transfer_request);
 
@@ -223,7 +234,7 @@ UINT            status;
 /*  FUNCTION                                               RELEASE        */
 /*                                                                        */
 /*    _uxe_host_stack_transfer_request                    PORTABLE C      */
-/*                                                           6.3.0        */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -253,10 +264,20 @@ UINT            status;
 /*    DATE              NAME                      DESCRIPTION             */
 /*                                                                        */
 /*  10-31-2023     Chaoqiong Xiao           Initial Version 6.3.0         */
+/*  xx-xx-xxxx     Mohamed ayed             Modified comment(s),          */
+/*                                            added transfer segments     */
+/*                                            check,                      */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _uxe_host_stack_transfer_request(UX_TRANSFER *transfer_request)
 {
+#if defined(UX_TRANSFER_SEGMENTS_ENABLE)
+ULONG       segment;
+ULONG       segment_length;
+ULONG       segments_length;
+ULONG       max_packet_size;
+#endif
 
     /* Sanity checks.  */
     if (transfer_request == UX_NULL)
@@ -268,6 +289,35 @@ UINT  _uxe_host_stack_transfer_request(UX_TRANSFER *transfer_request)
     if (UX_DEVICE_HCD_GET(transfer_request -> ux_transfer_request_endpoint -> ux_endpoint_device) == UX_NULL)
         return(UX_INVALID_PARAMETER);
 
+#if defined(UX_TRANSFER_SEGMENTS_ENABLE)
+
+    /* The segments must cover exactly the requested length, and all segments but
+       the last one must be whole packets.  */
+    if (transfer_request -> ux_transfer_request_segment_count != 0)
+    {
+        if (transfer_request -> ux_transfer_request_segments == UX_NULL)
+            return(UX_INVALID_PARAMETER);
+        max_packet_size =  transfer_request -> ux_transfer_request_endpoint -> ux_endpoint_descriptor.wMaxPacketSize & UX_MAX_PACKET_SIZE_MASK;
+        segments_length =  0;
+        for (segment = 0; segment < transfer_request -> ux_transfer_request_segment_count; segment ++)
+        {
+            segment_length =  transfer_request -> ux_transfer_request_segments[segment].ux_transfer_segment_length;
+
+            /* Check for overflow of the sum.  */
+            if (segment_length > ~segments_length)
+                return(UX_INVALID_PARAMETER);
+            segments_length +=  segment_length;
+
+            /* Check for a short packet before the last segment.  */
+            if ((segment != transfer_request -> ux_transfer_request_segment_count - 1) &&
+                ((max_packet_size == 0) || (segment_length % max_packet_size) != 0))
+                return(UX_INVALID_PARAMETER);
+        }
+        if (segments_length != transfer_request -> ux_transfer_request_requested_length)
+            return(UX_INVALID_PARAMETER);
+    }
+#endif
+
     /* Invoke transfer request function.  */
     return(_ux_host_stack_transfer_request(transfer_request));
 }
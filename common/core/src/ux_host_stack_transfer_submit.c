@@ -0,0 +1,166 @@
+/***************************************************************************
+ * Copyright (c) 2024 Microsoft Corporation 
+ * 
+ * This program and the accompanying materials are made available under the
+ * terms of the MIT License which is available at
+ * https://opensource.org/licenses/MIT.
+ * 
+ * SPDX-License-Identifier: MIT
+ **************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */ 
+/** USBX Component                                                        */ 
+/**                                                                       */
+/**   Host Stack                                                          */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+
+/* Include necessary system files.  */
+
+#define UX_SOURCE_CODE
+
+#include "ux_api.h"
+#include "ux_host_stack.h"
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_host_stack_transfer_submit                      PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function submits a transfer request without waiting for its    */
+/*    completion. The completion function given is called when the        */
+/*    transfer completes, is aborted or fails. In RTOS mode it is called  */
+/*    from the HCD thread, so one thread can drive many endpoints         */
+/*    without blocking on the semaphore of each transfer request.         */
+/*                                                                        */
+/*    Control requests are not supported, HCDs wait for their completion */
+/*    in the control transfer path.                                       */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    transfer_request                  Transfer request structure        */
+/*    completion_function               Transfer completion function      */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    Completion Status                 If UX_SUCCESS, transfer was       */
+/*                                        successfully started            */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _ux_host_stack_transfer_request       Process transfer request      */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    Application                                                         */
+/*    USBX Components                                                     */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Mohamed ayed             Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+UINT  _ux_host_stack_transfer_submit(UX_TRANSFER *transfer_request,
+                                    VOID (*completion_function)(UX_TRANSFER *))
+{
+
+#if defined(UX_HOST_STANDALONE)
+ULONG       auto_wait;
+UINT        status;
+#endif
+
+    /* Completion is reported through the callback.  */
+    transfer_request -> ux_transfer_request_completion_function =  completion_function;
+
+#if defined(UX_HOST_STANDALONE)
+
+    /* The request is not waited for, the wait flag is restored once started.  */
+    auto_wait =  transfer_request -> ux_transfer_request_flags & UX_TRANSFER_FLAG_AUTO_WAIT;
+    transfer_request -> ux_transfer_request_flags &= ~UX_TRANSFER_FLAG_AUTO_WAIT;
+    status =  _ux_host_stack_transfer_request(transfer_request);
+    transfer_request -> ux_transfer_request_flags |=  auto_wait;
+    return(status);
+#else
+
+    /* Start the transfer, the HCD does not wait for its completion.  */
+    return(_ux_host_stack_transfer_request(transfer_request));
+#endif
+}
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _uxe_host_stack_transfer_submit                     PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function checks errors in host stack transfer submit function  */
+/*    call.                                                               */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    transfer_request                  Pointer to transfer               */
+/*    completion_function               Transfer completion function      */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _ux_host_stack_transfer_submit        Submit a transfer request     */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    Application                                                         */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Mohamed ayed             Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+UINT  _uxe_host_stack_transfer_submit(UX_TRANSFER *transfer_request,
+                                    VOID (*completion_function)(UX_TRANSFER *))
+{
+
+    /* Sanity checks.  */
+    if ((transfer_request == UX_NULL) || (completion_function == UX_NULL))
+        return(UX_INVALID_PARAMETER);
+    if (transfer_request -> ux_transfer_request_endpoint == UX_NULL)
+        return(UX_ENDPOINT_HANDLE_UNKNOWN);
+    if (transfer_request -> ux_transfer_request_endpoint -> ux_endpoint_device == UX_NULL)
+        return(UX_DEVICE_HANDLE_UNKNOWN);
+    if (UX_DEVICE_HCD_GET(transfer_request -> ux_transfer_request_endpoint -> ux_endpoint_device) == UX_NULL)
+        return(UX_INVALID_PARAMETER);
+
+    /* Control transfers are waited for by HCDs.  */
+    if ((transfer_request -> ux_transfer_request_endpoint -> ux_endpoint_descriptor.bmAttributes &
+                                        UX_MASK_ENDPOINT_TYPE) == UX_CONTROL_ENDPOINT)
+        return(UX_FUNCTION_NOT_SUPPORTED);
+
+    /* Invoke transfer submit function.  */
+    return(_ux_host_stack_transfer_submit(transfer_request, completion_function));
+}
@@ -33,7 +33,7 @@
 /*  FUNCTION                                               RELEASE        */
 /*                                                                        */
 /*    _ux_host_stack_uninitialize                         PORTABLE C      */
-/*                                                           6.1.10       */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -61,6 +61,7 @@
 /*    _ux_utility_memory_free               Free host memory              */
 /*    _ux_utility_thread_delete             Delete host thread            */
 /*    _ux_utility_semaphore_delete          Delete host semaphore         */
+/*    _ux_utility_mutex_delete              Delete host mutex             */
 /*                                                                        */
 /*  CALLED BY                                                             */
 /*                                                                        */
@@ -77,10 +78,21 @@
 /*  01-31-2022     Chaoqiong Xiao           Modified comment(s),          */
 /*                                            added standalone support,   */
 /*                                            resulting in version 6.1.10 */
+/*  xx-xx-xxxx     Mohamed ayed             Modified comment(s),          */
+/*                                            added parallel enum workers,*/
+/*                                            added descriptor cache,     */
+/*                                            added thread per HCD,       */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_host_stack_uninitialize(VOID)
 {
+#if defined(UX_HOST_ENUM_PARALLEL_ENABLE)
+UINT        worker_index;
+#endif
+#if defined(UX_HOST_DESCRIPTOR_CACHE_ENABLE)
+UINT        cache_index;
+#endif
 
     /* If trace is enabled, insert this event into the trace buffer.  */
     UX_TRACE_IN_LINE_INSERT(UX_TRACE_HOST_STACK_UNINITIALIZE, 0, 0, 0, 0, UX_TRACE_HOST_STACK_EVENTS, 0, 0)
@@ -95,6 +107,21 @@ UINT  _ux_host_stack_uninitialize(VOID)
     /* Free enumeration thread stack.  */
     _ux_utility_memory_free(_ux_system_host -> ux_system_host_enum_thread_stack);
 
+#if defined(UX_HOST_ENUM_PARALLEL_ENABLE)
+
+    /* Delete enumeration worker threads.  */
+    for (worker_index = 0; worker_index < UX_HOST_ENUM_PARALLEL_THREADS; worker_index ++)
+        _ux_utility_thread_delete(&_ux_system_host -> ux_system_host_enum_worker_thread[worker_index]);
+
+    /* Delete enumeration worker semaphore.  */
+    _ux_utility_semaphore_delete(&_ux_system_host -> ux_system_host_enum_worker_semaphore);
+
+    /* Free enumeration worker threads stack.  */
+    _ux_utility_memory_free(_ux_system_host -> ux_system_host_enum_worker_thread_stack);
+#endif
+
+#if !defined(UX_HOST_HCD_THREAD_PER_HCD_ENABLE)
+
     /* Delete HCD thread.  */
     _ux_utility_thread_delete(&_ux_system_host -> ux_system_host_hcd_thread);
 
@@ -105,6 +132,23 @@ UINT  _ux_host_stack_uninitialize(VOID)
     _ux_utility_memory_free(_ux_system_host -> ux_system_host_hcd_thread_stack);
 #endif
 
+#if defined(UX_HOST_DESCRIPTOR_CACHE_ENABLE)
+
+    /* Delete descriptor cache mutex.  */
+    _ux_host_mutex_delete(&_ux_system_host -> ux_system_host_descriptor_cache_mutex);
+#endif
+#endif
+
+#if defined(UX_HOST_DESCRIPTOR_CACHE_ENABLE)
+
+    /* Free cached descriptors.  */
+    for (cache_index = 0; cache_index < UX_HOST_DESCRIPTOR_CACHE_ENTRIES; cache_index ++)
+    {
+        if (_ux_system_host -> ux_system_host_descriptor_cache[cache_index].ux_host_descriptor_cache_descriptor)
+            _ux_utility_memory_free(_ux_system_host -> ux_system_host_descriptor_cache[cache_index].ux_host_descriptor_cache_descriptor);
+    }
+#endif
+
 #if defined(UX_OTG_SUPPORT) && !defined(UX_OTG_STANDALONE)
 
     /* Delete HNP thread.  */
@@ -37,13 +37,15 @@
 UX_SYSTEM         *_ux_system;
 UX_SYSTEM_OTG     *_ux_system_otg;
 
-/* Define names of all the packed descriptors in USBX.  */
-
-UCHAR _ux_system_endpoint_descriptor_structure[] =                          {1,1,1,1,2,1 };
-UCHAR _ux_system_device_descriptor_structure[] =                            {1,1,2,1,1,1,1,2,2,2,1,1,1,1};
-UCHAR _ux_system_configuration_descriptor_structure[] =                     {1,1,2,1,1,1,1,1};
-UCHAR _ux_system_interface_descriptor_structure[] =                         {1,1,1,1,1,1,1,1,1};
-UCHAR _ux_system_interface_association_descriptor_structure[] =             {1,1,1,1,1,1,1,1};
+/* Define names of all the packed descriptors in USBX.
+   Standard descriptors are generated from their field lists, which are shared
+   with the specialized unpack functions.  */
+
+UCHAR _ux_system_endpoint_descriptor_structure[] =                          {UX_ENDPOINT_DESCRIPTOR_FIELDS(UX_DESCRIPTOR_FIELD_SIZE)};
+UCHAR _ux_system_device_descriptor_structure[] =                            {UX_DEVICE_DESCRIPTOR_FIELDS(UX_DESCRIPTOR_FIELD_SIZE)};
+UCHAR _ux_system_configuration_descriptor_structure[] =                     {UX_CONFIGURATION_DESCRIPTOR_FIELDS(UX_DESCRIPTOR_FIELD_SIZE)};
+UCHAR _ux_system_interface_descriptor_structure[] =                         {UX_INTERFACE_DESCRIPTOR_FIELDS(UX_DESCRIPTOR_FIELD_SIZE)};
+UCHAR _ux_system_interface_association_descriptor_structure[] =             {UX_INTERFACE_ASSOCIATION_DESCRIPTOR_FIELDS(UX_DESCRIPTOR_FIELD_SIZE)};
 UCHAR _ux_system_string_descriptor_structure[] =                            {1,1,2};
 UCHAR _ux_system_dfu_functional_descriptor_structure[] =                    {1,1,1,2,2,2};
 UCHAR _ux_system_class_audio_interface_descriptor_structure[] =             {1,1,1,1,1,1,1,1};
@@ -58,7 +60,7 @@ UCHAR _ux_system_class_pima_storage_structure[] =                           {2,2
 UCHAR _ux_system_class_pima_object_structure[] =                            {4,2,2,4,2,4,4,4,4,4,4,4,2,4,4};
 UCHAR _ux_system_ecm_interface_descriptor_structure[] =                     {1,1,1,1,4,2,2,1};
 
-UCHAR _ux_system_bos_descriptor_structure[] =                               {1,1,2,1};
+UCHAR _ux_system_bos_descriptor_structure[] =                               {UX_BOS_DESCRIPTOR_FIELDS(UX_DESCRIPTOR_FIELD_SIZE)};
 UCHAR _ux_system_usb_2_0_extension_descriptor_structure[] =                 {1,1,1,4};
 UCHAR _ux_system_container_id_descriptor_structure[] =                      {1,1,1,1,4,4,4,4};
 
@@ -68,7 +70,7 @@ UCHAR _ux_system_container_id_descriptor_structure[] =                      {1,1
 /*  FUNCTION                                               RELEASE        */
 /*                                                                        */
 /*    _ux_system_initialize                               PORTABLE C      */
-/*                                                           6.3.0        */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -94,6 +96,7 @@ UCHAR _ux_system_container_id_descriptor_structure[] =                      {1,1
 /*    _ux_utility_memory_allocate           Allocate memory               */
 /*    _ux_utility_memory_set                Set memory                    */
 /*    _ux_utility_mutex_create              Create mutex                  */
+/*    _ux_utility_memory_dma_pool_create    Create DMA buffer pool        */
 /*                                                                        */
 /*  CALLED BY                                                             */
 /*                                                                        */
@@ -119,6 +122,12 @@ UCHAR _ux_system_container_id_descriptor_structure[] =                      {1,1
 /*                                            added UX_ASSERT check for   */
 /*                                            STD descriptor parse size,  */
 /*                                            resulting in version 6.3.0  */
+/*  xx-xx-xxxx     Mohamed ayed             Modified comment(s),          */
+/*                                            created memory pool mutex,  */
+/*                                            generated standard          */
+/*                                            descriptor structures,      */
+/*                                            reserved DMA buffer pool,   */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_system_initialize(VOID *regular_memory_pool_start, ULONG regular_memory_size,
@@ -252,6 +261,20 @@ ULONG               pool_size;
                                             (UX_MEMORY_BYTE_POOL *)int_memory_pool_start, pool_size);
     }
 
+#if !defined(UX_STANDALONE)
+
+    /* Create the Mutex objects used to protect memory pools.  */
+    status =  _ux_system_mutex_create(&_ux_system -> ux_system_memory_byte_pool[UX_MEMORY_BYTE_POOL_REGULAR] -> ux_byte_pool_mutex, "ux_byte_pool_mutex");
+    if(status != UX_SUCCESS)
+        return(UX_MUTEX_ERROR);
+    if (_ux_system -> ux_system_memory_byte_pool[UX_MEMORY_BYTE_POOL_CACHE_SAFE] != _ux_system -> ux_system_memory_byte_pool[UX_MEMORY_BYTE_POOL_REGULAR])
+    {
+        status =  _ux_system_mutex_create(&_ux_system -> ux_system_memory_byte_pool[UX_MEMORY_BYTE_POOL_CACHE_SAFE] -> ux_byte_pool_mutex, "ux_cache_safe_byte_pool_mutex");
+        if(status != UX_SUCCESS)
+            return(UX_MUTEX_ERROR);
+    }
+#endif
+
 #ifdef UX_ENABLE_MEMORY_STATISTICS
     _ux_system -> ux_system_memory_byte_pool[UX_MEMORY_BYTE_POOL_REGULAR] -> ux_byte_pool_min_free =
             _ux_system -> ux_system_memory_byte_pool[UX_MEMORY_BYTE_POOL_REGULAR] -> ux_byte_pool_available;
@@ -261,6 +284,14 @@ ULONG               pool_size;
     /* Other fields are kept zero.  */
 #endif
 
+#ifdef UX_ENABLE_MEMORY_DMA_POOL
+
+    /* Reserve the DMA buffer pool, transfer buffers are then taken from it
+       without touching the byte pools.  */
+    if (_ux_utility_memory_dma_pool_create() != UX_SUCCESS)
+        return(UX_MEMORY_INSUFFICIENT);
+#endif
+
 #ifdef UX_ENABLE_DEBUG_LOG
 
     /* Obtain memory for storing the debug log.  */
@@ -34,7 +34,7 @@
 /*  FUNCTION                                               RELEASE        */ 
 /*                                                                        */ 
 /*    _ux_system_uninitialize                             PORTABLE C      */ 
-/*                                                           6.1.10       */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -52,6 +52,8 @@
 /*                                                                        */ 
 /*  CALLS                                                                 */ 
 /*                                                                        */ 
+/*    _ux_utility_memory_free                 Free memory block           */
+/*    _ux_utility_memory_set                  Set memory block            */
 /*    _ux_utility_mutex_delete                ThreadX delete mutex        */ 
 /*                                                                        */ 
 /*  CALLED BY                                                             */ 
@@ -68,14 +70,31 @@
 /*  01-31-2022     Chaoqiong Xiao           Modified comment(s),          */
 /*                                            added standalone support,   */
 /*                                            resulting in version 6.1.10 */
+/*  xx-xx-xxxx     Mohamed ayed             Modified comment(s),          */
+/*                                            deleted memory pool mutex,  */
+/*                                            released DMA buffer pool,   */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_system_uninitialize(VOID)
 {
 
+#ifdef UX_ENABLE_MEMORY_DMA_POOL
+
+    /* Release the blocks of the DMA buffer pool and clear it.  */
+    if (_ux_system -> ux_system_memory_dma_pool.ux_dma_pool_start != UX_NULL)
+        _ux_utility_memory_free(_ux_system -> ux_system_memory_dma_pool.ux_dma_pool_start);
+    _ux_utility_memory_set(&_ux_system -> ux_system_memory_dma_pool, 0, sizeof(UX_MEMORY_DMA_POOL)); /* Use case of memset is verified. */
+#endif
+
     /* Delete the Mutex object used by USBX to control critical sections.  */
     _ux_system_mutex_delete(&_ux_system -> ux_system_mutex);
 
+    /* Delete the Mutex objects used to protect memory pools.  */
+    if (_ux_system -> ux_system_memory_byte_pool[UX_MEMORY_BYTE_POOL_CACHE_SAFE] != _ux_system -> ux_system_memory_byte_pool[UX_MEMORY_BYTE_POOL_REGULAR])
+        _ux_system_mutex_delete(&_ux_system -> ux_system_memory_byte_pool[UX_MEMORY_BYTE_POOL_CACHE_SAFE] -> ux_byte_pool_mutex);
+    _ux_system_mutex_delete(&_ux_system -> ux_system_memory_byte_pool[UX_MEMORY_BYTE_POOL_REGULAR] -> ux_byte_pool_mutex);
+
     return(UX_SUCCESS);
 }
 
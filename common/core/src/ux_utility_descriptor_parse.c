@@ -32,7 +32,7 @@
 /*  FUNCTION                                               RELEASE        */
 /*                                                                        */
 /*    _ux_utility_descriptor_parse                        PORTABLE C      */
-/*                                                           6.3.0        */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -42,6 +42,9 @@
 /*    This function will unpack a USB descriptor from the bus into a      */
 /*    memory aligned structure.                                           */
 /*                                                                        */
+/*    Standard descriptors are unpacked by specialized functions, other   */
+/*    descriptors are unpacked by interpreting their structure entries.   */
+/*                                                                        */
 /*  INPUT                                                                 */
 /*                                                                        */
 /*    raw_descriptor                        Pointer to packed descriptor  */
@@ -57,6 +60,16 @@
 /*                                                                        */
 /*  CALLS                                                                 */
 /*                                                                        */
+/*    _ux_utility_descriptor_unpack_bos     Unpack BOS descriptor         */
+/*    _ux_utility_descriptor_unpack_configuration                         */
+/*                                          Unpack configuration          */
+/*    _ux_utility_descriptor_unpack_device  Unpack device descriptor      */
+/*    _ux_utility_descriptor_unpack_endpoint                              */
+/*                                          Unpack endpoint descriptor    */
+/*    _ux_utility_descriptor_unpack_interface                             */
+/*                                          Unpack interface descriptor   */
+/*    _ux_utility_descriptor_unpack_interface_association                 */
+/*                                          Unpack IAD                    */
 /*    _ux_utility_long_get                  Get 32-bit value              */
 /*    _ux_utility_short_get                 Get 16-bit value              */
 /*                                                                        */
@@ -74,12 +87,55 @@
 /*  10-31-2023     Chaoqiong Xiao           Modified comment(s),          */
 /*                                            optimized USB descriptors,  */
 /*                                            resulting in version 6.3.0  */
+/*  xx-xx-xxxx     Mohamed ayed             Modified comment(s),          */
+/*                                            used specialized unpack of  */
+/*                                            standard descriptors,       */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 VOID  _ux_utility_descriptor_parse(UCHAR * raw_descriptor, UCHAR * descriptor_structure,
                         UINT descriptor_entries, UCHAR * descriptor)
 {
 
+    /* Standard descriptors are unpacked by functions generated from their
+       field lists, without interpreting the structure entries.  */
+    if (descriptor_structure == _ux_system_endpoint_descriptor_structure &&
+        descriptor_entries == UX_ENDPOINT_DESCRIPTOR_ENTRIES)
+    {
+        _ux_utility_descriptor_unpack_endpoint(raw_descriptor, (UX_ENDPOINT_DESCRIPTOR *) descriptor);
+        return;
+    }
+    if (descriptor_structure == _ux_system_interface_descriptor_structure &&
+        descriptor_entries == UX_INTERFACE_DESCRIPTOR_ENTRIES)
+    {
+        _ux_utility_descriptor_unpack_interface(raw_descriptor, (UX_INTERFACE_DESCRIPTOR *) descriptor);
+        return;
+    }
+    if (descriptor_structure == _ux_system_configuration_descriptor_structure &&
+        descriptor_entries == UX_CONFIGURATION_DESCRIPTOR_ENTRIES)
+    {
+        _ux_utility_descriptor_unpack_configuration(raw_descriptor, (UX_CONFIGURATION_DESCRIPTOR *) descriptor);
+        return;
+    }
+    if (descriptor_structure == _ux_system_device_descriptor_structure &&
+        descriptor_entries == UX_DEVICE_DESCRIPTOR_ENTRIES)
+    {
+        _ux_utility_descriptor_unpack_device(raw_descriptor, (UX_DEVICE_DESCRIPTOR *) descriptor);
+        return;
+    }
+    if (descriptor_structure == _ux_system_interface_association_descriptor_structure &&
+        descriptor_entries == UX_INTERFACE_ASSOCIATION_DESCRIPTOR_ENTRIES)
+    {
+        _ux_utility_descriptor_unpack_interface_association(raw_descriptor, (UX_INTERFACE_ASSOCIATION_DESCRIPTOR *) descriptor);
+        return;
+    }
+    if (descriptor_structure == _ux_system_bos_descriptor_structure &&
+        descriptor_entries == UX_BOS_DESCRIPTOR_ENTRIES)
+    {
+        _ux_utility_descriptor_unpack_bos(raw_descriptor, (UX_BOS_DESCRIPTOR *) descriptor);
+        return;
+    }
+
     /* Loop on all the entries in this descriptor.  */
     while(descriptor_entries--)
     {
@@ -0,0 +1,335 @@
+/***************************************************************************
+ * Copyright (c) 2024 Microsoft Corporation
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the MIT License which is available at
+ * https://opensource.org/licenses/MIT.
+ *
+ * SPDX-License-Identifier: MIT
+ **************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** USBX Component                                                        */
+/**                                                                       */
+/**   Utility                                                             */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+
+/* Include necessary system files.  */
+
+#define UX_SOURCE_CODE
+
+#include "ux_api.h"
+
+
+/* Define the unpack function body from the descriptor field list, each field
+   is read from the raw descriptor in order and saved to the structure.  */
+
+#define UX_UTILITY_DESCRIPTOR_UNPACK(fields)                                    \
+    fields(UX_DESCRIPTOR_FIELD_UNPACK)                                          \
+    return;
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_utility_descriptor_unpack_bos                   PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function unpacks a raw USB BOS descriptor into its structure.  */
+/*    It's generated from the same field list as the descriptor           */
+/*    structure interpreted by _ux_utility_descriptor_parse, so field     */
+/*    sizes and offsets are resolved at build time.                       */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    raw_descriptor                    Pointer to packed descriptor      */
+/*    descriptor                        Pointer to the unpacked           */
+/*                                        descriptor                      */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    _ux_utility_descriptor_parse          Parse descriptor              */
+/*    USBX Components                                                     */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Mohamed ayed             Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+VOID  _ux_utility_descriptor_unpack_bos(UCHAR * raw_descriptor, UX_BOS_DESCRIPTOR * descriptor)
+{
+
+    UX_UTILITY_DESCRIPTOR_UNPACK(UX_BOS_DESCRIPTOR_FIELDS)
+}
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_utility_descriptor_unpack_configuration         PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function unpacks a raw USB configuration descriptor into its   */
+/*    structure. It's generated from the same field list as the           */
+/*    descriptor structure interpreted by _ux_utility_descriptor_parse,   */
+/*    so field sizes and offsets are resolved at build time.              */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    raw_descriptor                    Pointer to packed descriptor      */
+/*    descriptor                        Pointer to the unpacked           */
+/*                                        descriptor                      */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    _ux_utility_descriptor_parse          Parse descriptor              */
+/*    USBX Components                                                     */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Mohamed ayed             Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+VOID  _ux_utility_descriptor_unpack_configuration(UCHAR * raw_descriptor, UX_CONFIGURATION_DESCRIPTOR * descriptor)
+{
+
+    UX_UTILITY_DESCRIPTOR_UNPACK(UX_CONFIGURATION_DESCRIPTOR_FIELDS)
+}
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_utility_descriptor_unpack_device                PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function unpacks a raw USB device descriptor into its          */
+/*    structure. It's generated from the same field list as the           */
+/*    descriptor structure interpreted by _ux_utility_descriptor_parse,   */
+/*    so field sizes and offsets are resolved at build time.              */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    raw_descriptor                    Pointer to packed descriptor      */
+/*    descriptor                        Pointer to the unpacked           */
+/*                                        descriptor                      */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    _ux_utility_descriptor_parse          Parse descriptor              */
+/*    USBX Components                                                     */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Mohamed ayed             Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+VOID  _ux_utility_descriptor_unpack_device(UCHAR * raw_descriptor, UX_DEVICE_DESCRIPTOR * descriptor)
+{
+
+    UX_UTILITY_DESCRIPTOR_UNPACK(UX_DEVICE_DESCRIPTOR_FIELDS)
+}
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_utility_descriptor_unpack_endpoint              PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function unpacks a raw USB endpoint descriptor into its        */
+/*    structure. It's generated from the same field list as the           */
+/*    descriptor structure interpreted by _ux_utility_descriptor_parse,   */
+/*    so field sizes and offsets are resolved at build time.              */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    raw_descriptor                    Pointer to packed descriptor      */
+/*    descriptor                        Pointer to the unpacked           */
+/*                                        descriptor                      */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    _ux_utility_descriptor_parse          Parse descriptor              */
+/*    USBX Components                                                     */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Mohamed ayed             Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+VOID  _ux_utility_descriptor_unpack_endpoint(UCHAR * raw_descriptor, UX_ENDPOINT_DESCRIPTOR * descriptor)
+{
+
+    UX_UTILITY_DESCRIPTOR_UNPACK(UX_ENDPOINT_DESCRIPTOR_FIELDS)
+}
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_utility_descriptor_unpack_interface             PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function unpacks a raw USB interface descriptor into its       */
+/*    structure. It's generated from the same field list as the           */
+/*    descriptor structure interpreted by _ux_utility_descriptor_parse,   */
+/*    so field sizes and offsets are resolved at build time.              */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    raw_descriptor                    Pointer to packed descriptor      */
+/*    descriptor                        Pointer to the unpacked           */
+/*                                        descriptor                      */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    _ux_utility_descriptor_parse          Parse descriptor              */
+/*    USBX Components                                                     */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Mohamed ayed             Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+VOID  _ux_utility_descriptor_unpack_interface(UCHAR * raw_descriptor, UX_INTERFACE_DESCRIPTOR * descriptor)
+{
+
+    UX_UTILITY_DESCRIPTOR_UNPACK(UX_INTERFACE_DESCRIPTOR_FIELDS)
+}
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_utility_descriptor_unpack_interface_association PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function unpacks a raw USB interface association descriptor    */
+/*    into its structure. It's generated from the same field list as the  */
+/*    descriptor structure interpreted by _ux_utility_descriptor_parse,   */
+/*    so field sizes and offsets are resolved at build time.              */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    raw_descriptor                    Pointer to packed descriptor      */
+/*    descriptor                        Pointer to the unpacked           */
+/*                                        descriptor                      */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    _ux_utility_descriptor_parse          Parse descriptor              */
+/*    USBX Components                                                     */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Mohamed ayed             Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+VOID  _ux_utility_descriptor_unpack_interface_association(UCHAR * raw_descriptor, UX_INTERFACE_ASSOCIATION_DESCRIPTOR * descriptor)
+{
+
+    UX_UTILITY_DESCRIPTOR_UNPACK(UX_INTERFACE_ASSOCIATION_DESCRIPTOR_FIELDS)
+}
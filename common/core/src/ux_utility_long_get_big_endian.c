@@ -27,6 +27,7 @@
 #include "ux_api.h"
 
 
+#if !defined(_ux_utility_long_get_big_endian)
 /**************************************************************************/ 
 /*                                                                        */ 
 /*  FUNCTION                                               RELEASE        */ 
@@ -64,6 +65,11 @@
 /*  05-19-2020     Chaoqiong Xiao           Initial Version 6.0           */
 /*  09-30-2020     Chaoqiong Xiao           Modified comment(s),          */
 /*                                            resulting in version 6.1    */
+/*  xx-xx-xxxx     Mohamed ayed             Modified comment(s),          */
+/*                                            allowed inline or port      */
+/*                                            override, fixed sign        */
+/*                                            extension of high byte,     */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 ULONG  _ux_utility_long_get_big_endian(UCHAR * address)
@@ -73,12 +79,12 @@ ULONG  value;
 
 
     /* We read a byte at a time from the address.  */
-    value =  (ULONG) ((*address++) << 24);
-    value |=  (ULONG) ((*address++) << 16);
-    value |=  (ULONG) ((*address++) << 8);
+    value =  (ULONG) (*address++) << 24;
+    value |=  (ULONG) (*address++) << 16;
+    value |=  (ULONG) (*address++) << 8;
     value |=  (ULONG) *address;
 
     /* Return 32-bit value.  */
     return(value);
 }
-
+#endif
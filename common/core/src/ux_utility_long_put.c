@@ -27,6 +27,7 @@
 #include "ux_api.h"
 
 
+#if !defined(_ux_utility_long_put)
 /**************************************************************************/ 
 /*                                                                        */ 
 /*  FUNCTION                                               RELEASE        */ 
@@ -65,6 +66,10 @@
 /*  05-19-2020     Chaoqiong Xiao           Initial Version 6.0           */
 /*  09-30-2020     Chaoqiong Xiao           Modified comment(s),          */
 /*                                            resulting in version 6.1    */
+/*  xx-xx-xxxx     Mohamed ayed             Modified comment(s),          */
+/*                                            allowed inline or port      */
+/*                                            override,                   */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 VOID  _ux_utility_long_put(UCHAR * address, ULONG value)
@@ -80,4 +85,4 @@ VOID  _ux_utility_long_put(UCHAR * address, ULONG value)
     /* Return to caller.  */
     return;
 }
-
+#endif
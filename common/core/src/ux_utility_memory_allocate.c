@@ -31,7 +31,7 @@
 /*  FUNCTION                                               RELEASE        */
 /*                                                                        */
 /*    _ux_utility_memory_allocate                         PORTABLE C      */
-/*                                                           6.3.0        */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -55,6 +55,10 @@
 /*                                                                        */
 /*    _ux_utility_memory_free_block_best_get Get best fit block of memory */
 /*    _ux_utility_memory_set                 Set block of memory          */
+/*    _ux_utility_memory_slab_allocate       Allocate from slab cache     */
+/*    _ux_utility_memory_slab_flush          Release slab cache           */
+/*    _ux_utility_memory_tlsf_split          Split TLSF block             */
+/*    _ux_utility_memory_telemetry_record    Log allocation telemetry     */
 /*                                                                        */
 /*  CALLED BY                                                             */
 /*                                                                        */
@@ -79,6 +83,12 @@
 /*                                            refined memory management,  */
 /*                                            fixed issue in 64-bit env,  */
 /*                                            resulting in version 6.3.0  */
+/*  xx-xx-xxxx     Mohamed ayed             Modified comment(s),          */
+/*                                            added memory slab support,  */
+/*                                            added TLSF support, used    */
+/*                                            mutex of pool, added memory */
+/*                                            telemetry,                  */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 VOID  *_ux_utility_memory_allocate(ULONG memory_alignment, ULONG memory_cache_flag,
@@ -96,6 +106,14 @@ ULONG               available_bytes;
 ALIGN_TYPE          int_memory_buffer;
 #ifdef UX_ENABLE_MEMORY_STATISTICS
 UINT                index;
+#endif
+#ifdef UX_ENABLE_MEMORY_SLAB
+UX_MEMORY_SLAB      *slab_ptr;
+#endif
+#ifdef UX_ENABLE_MEMORY_TELEMETRY
+ALIGN_TYPE          telemetry_site;
+ULONG               telemetry_start;
+ULONG               telemetry_size;
 #endif
 
     /* Get the pool ptr */
@@ -124,9 +142,6 @@ UINT                index;
         return(UX_NULL);
     }
 
-    /* Get the mutex as this is a critical section.  */
-    _ux_system_mutex_on(&_ux_system -> ux_system_mutex);
-
 #ifdef UX_ENFORCE_SAFE_ALIGNMENT
 
     /* Check if safe alignment requested, in this case switch to UX_NO_ALIGN.  */
@@ -199,6 +214,44 @@ UINT                index;
     if (memory_alignment < UX_ALIGN_MIN)
         memory_alignment =  UX_ALIGN_MIN;
 
+#ifdef UX_ENABLE_MEMORY_TELEMETRY
+
+    /* Keep the site, the start time and the requested size for telemetry.  */
+    telemetry_site =  UX_MEMORY_TELEMETRY_SITE_GET();
+    telemetry_start = UX_MEMORY_TELEMETRY_TIME_GET();
+    telemetry_size =  memory_size_requested;
+#endif
+
+#ifdef UX_ENABLE_MEMORY_SLAB
+
+    /* Small blocks without specific alignment are served by slab size classes.  */
+    slab_ptr = UX_NULL;
+    if ((memory_alignment == UX_ALIGN_MIN) && (memory_size_requested <= UX_MEMORY_SLAB_SIZE_MAX))
+    {
+
+        /* Find the size class.  */
+        slab_ptr = pool_ptr -> ux_byte_pool_slab;
+        while(slab_ptr -> ux_memory_slab_size < memory_size_requested)
+            slab_ptr ++;
+
+        /* Reuse a cached block if there is one, without locking the pool.  */
+        work_ptr = _ux_utility_memory_slab_allocate(slab_ptr);
+        if (work_ptr != UX_NULL)
+        {
+#ifdef UX_ENABLE_MEMORY_TELEMETRY
+            _ux_utility_memory_telemetry_record(pool_ptr, telemetry_site, telemetry_size, telemetry_start, UX_SUCCESS);
+#endif
+            return(work_ptr);
+        }
+
+        /* Allocate a block of the class size from the pool.  */
+        memory_size_requested = slab_ptr -> ux_memory_slab_size;
+    }
+#endif
+
+    /* Get the mutex of the pool as this is a critical section.  */
+    _ux_system_mutex_on(&pool_ptr -> ux_byte_pool_mutex);
+
     /* We need to make sure that the next memory block buffer is 8-byte aligned too. We
        do this by first adjusting the requested memory to be 8-byte aligned. One problem
        now is that the memory block might not be a size that is a multiple of 8, so we need
@@ -212,14 +265,30 @@ UINT                index;
     if (memory_alignment <= UX_ALIGN_MIN)
         current_ptr = _ux_utility_memory_byte_pool_search(pool_ptr, memory_size_requested);
     else
-        current_ptr = _ux_utility_memory_byte_pool_search(pool_ptr, memory_size_requested + memory_alignment);
+        current_ptr = _ux_utility_memory_byte_pool_search(pool_ptr, memory_size_requested + memory_alignment + UX_MEMORY_BLOCK_ALIGN_EXTRA);
+
+#ifdef UX_ENABLE_MEMORY_SLAB
+
+    /* If no memory block found, release cached slab blocks and search again.  */
+    if ((current_ptr == UX_NULL) && (_ux_utility_memory_slab_flush(pool_ptr) != 0))
+    {
+        if (memory_alignment <= UX_ALIGN_MIN)
+            current_ptr = _ux_utility_memory_byte_pool_search(pool_ptr, memory_size_requested);
+        else
+            current_ptr = _ux_utility_memory_byte_pool_search(pool_ptr, memory_size_requested + memory_alignment + UX_MEMORY_BLOCK_ALIGN_EXTRA);
+    }
+#endif
 
     /* Check if we found a memory block.  */
     if (current_ptr == UX_NULL)
     {
 
+#ifdef UX_ENABLE_MEMORY_TELEMETRY
+        _ux_utility_memory_telemetry_record(pool_ptr, telemetry_site, telemetry_size, telemetry_start, UX_MEMORY_INSUFFICIENT);
+#endif
+
         /* We could not find a memory block.  */
-        _ux_system_mutex_off(&_ux_system -> ux_system_mutex);
+        _ux_system_mutex_off(&pool_ptr -> ux_byte_pool_mutex);
 
         UX_TRACE_IN_LINE_INSERT(UX_TRACE_ERROR, UX_MEMORY_INSUFFICIENT, memory_size_requested, 0, 0, UX_TRACE_ERRORS, 0, 0)
 
@@ -266,6 +335,12 @@ UINT                index;
         /* Update the current pointer to point at the newly created block.  */
         *this_block_link_ptr =  next_ptr;
 
+#ifdef UX_ENABLE_MEMORY_TLSF
+
+        /* Link the new block and keep the leading part free.  */
+        _ux_utility_memory_tlsf_split(pool_ptr, current_ptr, current_ptr);
+#endif
+
         /* Calculate the available bytes.  */
         available_bytes -=  UX_UCHAR_POINTER_DIF(next_ptr, current_ptr);
 
@@ -294,6 +369,12 @@ UINT                index;
         /* Update the current pointer to point at the newly created block.  */
         *this_block_link_ptr =  next_ptr;
 
+#ifdef UX_ENABLE_MEMORY_TLSF
+
+        /* Link the new block and keep it free.  */
+        _ux_utility_memory_tlsf_split(pool_ptr, current_ptr, next_ptr);
+#endif
+
         /* Set available equal to memory size for subsequent calculation.  */
         available_bytes =  memory_size_requested;
     }
@@ -303,6 +384,13 @@ UINT                index;
     this_block_link_ptr =   UX_UCHAR_TO_INDIRECT_UCHAR_POINTER_CONVERT(work_ptr);
     *this_block_link_ptr =  UX_BYTE_POOL_TO_UCHAR_POINTER_CONVERT(pool_ptr);
 
+#ifdef UX_ENABLE_MEMORY_SLAB
+
+    /* Blocks of size classes are owned by the class, they are cached on free.  */
+    if (slab_ptr != UX_NULL)
+        *this_block_link_ptr =  UX_VOID_TO_UCHAR_POINTER_CONVERT(slab_ptr);
+#endif
+
     /* Reduce the number of available bytes in the pool.  */
     pool_ptr -> ux_byte_pool_available =  pool_ptr -> ux_byte_pool_available - (available_bytes + UX_MEMORY_BLOCK_HEADER_SIZE);
 
@@ -345,8 +433,12 @@ UINT                index;
         _ux_system -> ux_system_memory_byte_pool[index] -> ux_byte_pool_min_free = _ux_system -> ux_system_memory_byte_pool[index] -> ux_byte_pool_available;
 #endif
 
+#ifdef UX_ENABLE_MEMORY_TELEMETRY
+    _ux_utility_memory_telemetry_record(pool_ptr, telemetry_site, telemetry_size, telemetry_start, UX_SUCCESS);
+#endif
+
     /* Release the protection.  */
-    _ux_system_mutex_off(&_ux_system -> ux_system_mutex);
+    _ux_system_mutex_off(&pool_ptr -> ux_byte_pool_mutex);
 
     return(work_ptr);
 }
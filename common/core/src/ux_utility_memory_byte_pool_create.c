@@ -32,7 +32,7 @@
 /*  FUNCTION                                               RELEASE        */
 /*                                                                        */
 /*    _ux_utility_memory_byte_pool_create                 PORTABLE C      */
-/*                                                           6.3.0        */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Yajun Xia, Microsoft Corporation                                    */
@@ -65,6 +65,11 @@
 /*    DATE              NAME                      DESCRIPTION             */
 /*                                                                        */
 /*  10-31-2023     Yajun Xia                Initial Version 6.3.0         */
+/*  xx-xx-xxxx     Mohamed ayed             Modified comment(s),          */
+/*                                            initialized slab classes,   */
+/*                                            added TLSF support, added   */
+/*                                            memory telemetry,           */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_utility_memory_byte_pool_create(UX_MEMORY_BYTE_POOL *pool_ptr, VOID *pool_start, ULONG pool_size)
@@ -74,6 +79,9 @@ UCHAR               *block_ptr;
 UCHAR               **block_indirect_ptr;
 UCHAR               *temp_ptr;
 ALIGN_TYPE          *free_ptr;
+#ifdef UX_ENABLE_MEMORY_SLAB
+UINT                index;
+#endif
 
 
     /* Initialize the byte pool control block to all zeros.  */
@@ -92,29 +100,52 @@ ALIGN_TYPE          *free_ptr;
        beginning that is available and a small allocated block at the end
        of the pool that is there just for the algorithm.  Be sure to count
        the available block's header in the available bytes count.  */
-    pool_ptr -> ux_byte_pool_available =   pool_size - ((sizeof(VOID *)) + (sizeof(ALIGN_TYPE)));
+    pool_ptr -> ux_byte_pool_available =   pool_size - UX_MEMORY_BLOCK_HEADER_SIZE;
     pool_ptr -> ux_byte_pool_fragments =   ((UINT) 2);
 
+#ifdef UX_ENABLE_MEMORY_TELEMETRY
+
+    /* Initialize telemetry watermarks from the single free block.  */
+    pool_ptr -> ux_byte_pool_telemetry.ux_memory_telemetry_fragments =        pool_ptr -> ux_byte_pool_fragments;
+    pool_ptr -> ux_byte_pool_telemetry.ux_memory_telemetry_fragments_max =    pool_ptr -> ux_byte_pool_fragments;
+    pool_ptr -> ux_byte_pool_telemetry.ux_memory_telemetry_free_blocks =      1;
+    pool_ptr -> ux_byte_pool_telemetry.ux_memory_telemetry_largest_free =     pool_ptr -> ux_byte_pool_available - UX_MEMORY_BLOCK_HEADER_SIZE;
+    pool_ptr -> ux_byte_pool_telemetry.ux_memory_telemetry_largest_free_min = pool_ptr -> ux_byte_pool_available - UX_MEMORY_BLOCK_HEADER_SIZE;
+#endif
+
+#ifdef UX_ENABLE_MEMORY_SLAB
+
+    /* Initialize the sizes of slab classes.  */
+    for (index = 0; index < UX_MEMORY_SLAB_CLASS_NUM; index ++)
+        pool_ptr -> ux_byte_pool_slab[index].ux_memory_slab_size = (ULONG)UX_MEMORY_SLAB_SIZE_MIN << index;
+#endif
+
     /* Each block contains a "next" pointer that points to the next block in the pool followed by a ALIGN_TYPE
        field that contains either the constant UX_BYTE_BLOCK_FREE (if the block is free) or a pointer to the
-       owning pool (if the block is allocated).  */
+       owning pool (if the block is allocated). With TLSF, a pointer to the previous block follows.  */
 
     /* Calculate the end of the pool's memory area.  */
     block_ptr =  UX_VOID_TO_UCHAR_POINTER_CONVERT(pool_start);
     block_ptr =  UX_UCHAR_POINTER_ADD(block_ptr, pool_size);
 
     /* Backup the end of the pool pointer and build the pre-allocated block.  */
-    block_ptr =  UX_UCHAR_POINTER_SUB(block_ptr, (sizeof(ALIGN_TYPE)));
+    block_ptr =  UX_UCHAR_POINTER_SUB(block_ptr, UX_MEMORY_BLOCK_HEADER_SIZE);
 
     /* Cast the pool pointer into a ULONG.  */
     temp_ptr =             UX_BYTE_POOL_TO_UCHAR_POINTER_CONVERT(pool_ptr);
-    block_indirect_ptr =   UX_UCHAR_TO_INDIRECT_UCHAR_POINTER_CONVERT(block_ptr);
+    block_indirect_ptr =   UX_UCHAR_TO_INDIRECT_UCHAR_POINTER_CONVERT(UX_UCHAR_POINTER_ADD(block_ptr, (sizeof(UCHAR *))));
     *block_indirect_ptr =  temp_ptr;
 
-    block_ptr =            UX_UCHAR_POINTER_SUB(block_ptr, (sizeof(UCHAR *)));
     block_indirect_ptr =   UX_UCHAR_TO_INDIRECT_UCHAR_POINTER_CONVERT(block_ptr);
     *block_indirect_ptr =  UX_VOID_TO_UCHAR_POINTER_CONVERT(pool_start);
 
+#ifdef UX_ENABLE_MEMORY_TLSF
+
+    /* The large block is previous block of the pre-allocated block.  */
+    block_indirect_ptr =   UX_UCHAR_TO_INDIRECT_UCHAR_POINTER_CONVERT(UX_UCHAR_POINTER_ADD(block_ptr, UX_MEMORY_BLOCK_PREV_OFFSET));
+    *block_indirect_ptr =  UX_VOID_TO_UCHAR_POINTER_CONVERT(pool_start);
+#endif
+
     /* Now setup the large available block in the pool.  */
     temp_ptr =             UX_VOID_TO_UCHAR_POINTER_CONVERT(pool_start);
     block_indirect_ptr =   UX_UCHAR_TO_INDIRECT_UCHAR_POINTER_CONVERT(temp_ptr);
@@ -124,6 +155,14 @@ ALIGN_TYPE          *free_ptr;
     free_ptr =             UX_UCHAR_TO_ALIGN_TYPE_POINTER_CONVERT(block_ptr);
     *free_ptr =            UX_BYTE_BLOCK_FREE;
 
+#ifdef UX_ENABLE_MEMORY_TLSF
+
+    /* The large block has no previous block, insert it to free lists.  */
+    block_indirect_ptr =   UX_UCHAR_TO_INDIRECT_UCHAR_POINTER_CONVERT(UX_UCHAR_POINTER_ADD(pool_start, UX_MEMORY_BLOCK_PREV_OFFSET));
+    *block_indirect_ptr =  UX_NULL;
+    _ux_utility_memory_tlsf_insert(pool_ptr, UX_VOID_TO_UCHAR_POINTER_CONVERT(pool_start));
+#endif
+
     /* Return UX_SUCCESS.  */
     return(UX_SUCCESS);
 }
@@ -27,12 +27,13 @@
 #include "ux_api.h"
 
 
+#if !defined(UX_ENABLE_MEMORY_TLSF)
 /**************************************************************************/
 /*                                                                        */
 /*  FUNCTION                                               RELEASE        */
 /*                                                                        */
 /*    _ux_utility_memory_byte_pool_search                 PORTABLE C      */
-/*                                                           6.3.0        */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Yajun Xia, Microsoft Corporation                                    */
@@ -56,7 +57,8 @@
 /*                                                                        */
 /*  CALLS                                                                 */
 /*                                                                        */
-/*    None                                                                */
+/*    _ux_utility_memory_telemetry_histogram_add                          */
+/*                                          Log walk length               */
 /*                                                                        */
 /*  CALLED BY                                                             */
 /*                                                                        */
@@ -67,6 +69,11 @@
 /*    DATE              NAME                      DESCRIPTION             */
 /*                                                                        */
 /*  10-31-2023     Yajun Xia                Initial Version 6.3.0         */
+/*  xx-xx-xxxx     Mohamed ayed             Modified comment(s),          */
+/*                                            replaced by TLSF search if  */
+/*                                            TLSF is enabled, added      */
+/*                                            memory telemetry,           */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UCHAR  *_ux_utility_memory_byte_pool_search(UX_MEMORY_BYTE_POOL *pool_ptr, ULONG memory_size)
@@ -81,6 +88,9 @@ UINT                first_free_block_found =  UX_FALSE;
 ALIGN_TYPE          *free_ptr;
 UCHAR               *work_ptr;
 ULONG               total_theoretical_available;
+#ifdef UX_ENABLE_MEMORY_TELEMETRY
+ULONG               walk_blocks = 0;
+#endif
 
     /* First, determine if there are enough bytes in the pool.  */
     /* Theoretical bytes available = free bytes + ((fragments-2) * overhead of each block) */
@@ -107,6 +117,10 @@ ULONG               total_theoretical_available;
     available_bytes =  ((ULONG) 0);
     do
     {
+#ifdef UX_ENABLE_MEMORY_TELEMETRY
+        walk_blocks ++;
+#endif
+
         /* Check to see if this block is free.  */
         work_ptr =  UX_UCHAR_POINTER_ADD(current_ptr, (sizeof(UCHAR *)));
         free_ptr =  UX_UCHAR_TO_ALIGN_TYPE_POINTER_CONVERT(work_ptr);
@@ -203,6 +217,12 @@ ULONG               total_theoretical_available;
 
     } while(examine_blocks != ((UINT) 0));
 
+#ifdef UX_ENABLE_MEMORY_TELEMETRY
+
+    /* Log the number of blocks walked through.  */
+    _ux_utility_memory_telemetry_histogram_add(&pool_ptr -> ux_byte_pool_telemetry.ux_memory_telemetry_walk, walk_blocks);
+#endif
+
     /* If a block was found, just return. */
     if (available_bytes == ((ULONG) 0))
     {
@@ -212,3 +232,4 @@ ULONG               total_theoretical_available;
     /* Return the search pointer.  */
     return(current_ptr);
 }
+#endif
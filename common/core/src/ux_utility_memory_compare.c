@@ -27,12 +27,13 @@
 #include "ux_api.h"
 
 
+#if !defined(_ux_utility_memory_compare)
 /**************************************************************************/ 
 /*                                                                        */ 
 /*  FUNCTION                                               RELEASE        */ 
 /*                                                                        */ 
 /*    _ux_utility_memory_compare                          PORTABLE C      */ 
-/*                                                           6.1          */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -41,6 +42,10 @@
 /*                                                                        */ 
 /*    This function compares two memory blocks.                           */ 
 /*                                                                        */ 
+/*    If both blocks have the same alignment, the unaligned head is       */ 
+/*    compared byte by byte, then the blocks are compared word by word    */ 
+/*    and the remaining tail is compared byte by byte.                    */ 
+/*                                                                        */ 
 /*  INPUT                                                                 */ 
 /*                                                                        */ 
 /*    memory_source                         Pointer to source             */ 
@@ -67,19 +72,73 @@
 /*  05-19-2020     Chaoqiong Xiao           Initial Version 6.0           */
 /*  09-30-2020     Chaoqiong Xiao           Modified comment(s),          */
 /*                                            resulting in version 6.1    */
+/*  xx-xx-xxxx     Mohamed ayed             Modified comment(s),          */
+/*                                            added word access support,  */
+/*                                            allowed port override,      */
+/*                                            used aliasing word type,    */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_utility_memory_compare(VOID *memory_source, VOID *memory_destination, ULONG length)
 {
 
-UCHAR *   source;
-UCHAR *   destination;
+UCHAR *                     source;
+UCHAR *                     destination;
+#if !defined(UX_UTILITY_MEMORY_WORD_ACCESS_DISABLE)
+UX_UTILITY_MEMORY_WORD *    source_word;
+UX_UTILITY_MEMORY_WORD *    destination_word;
+#endif
 
 
     /* Setup source and destination byte oriented pointers.  */
     source =  (UCHAR *) memory_source;
     destination =  (UCHAR *) memory_destination;
 
+#if !defined(UX_UTILITY_MEMORY_WORD_ACCESS_DISABLE)
+
+    /* Words are compared only if source and destination share the same alignment.  */
+    if ((length >= UX_UTILITY_MEMORY_WORD_ACCESS_MIN) &&
+        ((((ALIGN_TYPE) source) & UX_UTILITY_MEMORY_WORD_MASK) == (((ALIGN_TYPE) destination) & UX_UTILITY_MEMORY_WORD_MASK)))
+    {
+
+        /* Compare the unaligned head.  */
+        while(((ALIGN_TYPE) destination) & UX_UTILITY_MEMORY_WORD_MASK)
+        {
+
+            /* Compare a single byte.  */
+            if(*destination++ != *source++)
+            {
+
+                /* Not equal, return an error.  */
+                return(UX_ERROR);
+            }
+            length--;
+        }
+
+        /* Setup word oriented source and destination pointers.  */
+        source_word =  (UX_UTILITY_MEMORY_WORD *) ((VOID *) source);
+        destination_word =  (UX_UTILITY_MEMORY_WORD *) ((VOID *) destination);
+
+        /* Loop to compare words.  */
+        while(length >= UX_UTILITY_MEMORY_WORD_SIZE)
+        {
+
+            /* Compare a single word.  */
+            if(*destination_word++ != *source_word++)
+            {
+
+                /* Not equal, return an error.  */
+                return(UX_ERROR);
+            }
+            length -= UX_UTILITY_MEMORY_WORD_SIZE;
+        }
+
+        /* Back to byte oriented pointers for the tail.  */
+        source =  (UCHAR *) source_word;
+        destination =  (UCHAR *) destination_word;
+    }
+#endif
+
     /* Loop to compare blocks.  */
     while(length--)
     {
@@ -96,4 +155,4 @@ UCHAR *   destination;
     /* Blocks are equal, return success.  */           
     return(UX_SUCCESS); 
 }
-
+#endif
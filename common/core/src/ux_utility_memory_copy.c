@@ -27,12 +27,13 @@
 #include "ux_api.h"
 
 
+#if !defined(_ux_utility_memory_copy)
 /**************************************************************************/ 
 /*                                                                        */ 
 /*  FUNCTION                                               RELEASE        */ 
 /*                                                                        */ 
 /*    _ux_utility_memory_copy                             PORTABLE C      */ 
-/*                                                           6.1          */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -42,6 +43,10 @@
 /*    This function copies a block of memory from a source to a           */ 
 /*    destination.                                                        */ 
 /*                                                                        */ 
+/*    If source and destination have the same alignment, the unaligned    */ 
+/*    head is copied byte by byte, then the block is copied word by word  */ 
+/*    and the remaining tail is copied byte by byte.                      */ 
+/*                                                                        */ 
 /*  INPUT                                                                 */ 
 /*                                                                        */ 
 /*    memory_destination                    Pointer to destination        */ 
@@ -67,18 +72,79 @@
 /*  05-19-2020     Chaoqiong Xiao           Initial Version 6.0           */
 /*  09-30-2020     Chaoqiong Xiao           Modified comment(s),          */
 /*                                            resulting in version 6.1    */
+/*  xx-xx-xxxx     Mohamed ayed             Modified comment(s),          */
+/*                                            added word access support,  */
+/*                                            allowed port override,      */
+/*                                            used aliasing word type,    */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 VOID  _ux_utility_memory_copy(VOID *memory_destination, VOID *memory_source, ULONG length)
 {
 
-UCHAR *   source;
-UCHAR *   destination;
+UCHAR *                     source;
+UCHAR *                     destination;
+#if !defined(UX_UTILITY_MEMORY_WORD_ACCESS_DISABLE)
+UX_UTILITY_MEMORY_WORD *    source_word;
+UX_UTILITY_MEMORY_WORD *    destination_word;
+#endif
 
     /* Setup byte oriented source and destination pointers.  */
     source =  (UCHAR *) memory_source;
     destination =  (UCHAR *) memory_destination;
 
+#if !defined(UX_UTILITY_MEMORY_WORD_ACCESS_DISABLE)
+
+    /* Words are used only if source and destination share the same alignment, and
+       if the destination is not overlapping the source ahead of it, so the result
+       is always the same as the byte by byte copy.  */
+    if ((length >= UX_UTILITY_MEMORY_WORD_ACCESS_MIN) &&
+        ((((ALIGN_TYPE) source) & UX_UTILITY_MEMORY_WORD_MASK) == (((ALIGN_TYPE) destination) & UX_UTILITY_MEMORY_WORD_MASK)) &&
+        (((ALIGN_TYPE) destination <= (ALIGN_TYPE) source) ||
+         ((ALIGN_TYPE) destination >= (ALIGN_TYPE) source + length)))
+    {
+
+        /* Copy the unaligned head.  */
+        while(((ALIGN_TYPE) destination) & UX_UTILITY_MEMORY_WORD_MASK)
+        {
+
+            /* Copy one byte.  */
+            *destination++ =  *source++;
+            length--;
+        }
+
+        /* Setup word oriented source and destination pointers.  */
+        source_word =  (UX_UTILITY_MEMORY_WORD *) ((VOID *) source);
+        destination_word =  (UX_UTILITY_MEMORY_WORD *) ((VOID *) destination);
+
+        /* Copy 4 words in each loop.  */
+        while(length >= (UX_UTILITY_MEMORY_WORD_SIZE << 2))
+        {
+
+            destination_word[0] =  source_word[0];
+            destination_word[1] =  source_word[1];
+            destination_word[2] =  source_word[2];
+            destination_word[3] =  source_word[3];
+            destination_word += 4;
+            source_word += 4;
+            length -= (UX_UTILITY_MEMORY_WORD_SIZE << 2);
+        }
+
+        /* Copy remaining words.  */
+        while(length >= UX_UTILITY_MEMORY_WORD_SIZE)
+        {
+
+            /* Copy one word.  */
+            *destination_word++ =  *source_word++;
+            length -= UX_UTILITY_MEMORY_WORD_SIZE;
+        }
+
+        /* Back to byte oriented pointers for the tail.  */
+        source =  (UCHAR *) source_word;
+        destination =  (UCHAR *) destination_word;
+    }
+#endif
+
     /* Loop to perform the copy.  */
     while(length--)
     {
@@ -90,4 +156,4 @@ UCHAR *   destination;
     /* Return to caller.  */
     return; 
 }
-
+#endif
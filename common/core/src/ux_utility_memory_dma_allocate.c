@@ -0,0 +1,127 @@
+/***************************************************************************
+ * Copyright (c) 2024 Microsoft Corporation
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the MIT License which is available at
+ * https://opensource.org/licenses/MIT.
+ *
+ * SPDX-License-Identifier: MIT
+ **************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** USBX Component                                                        */
+/**                                                                       */
+/**   Utility                                                             */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+
+/* Include necessary system files.  */
+
+#define UX_SOURCE_CODE
+
+#include "ux_api.h"
+
+
+#ifdef UX_ENABLE_MEMORY_DMA_POOL
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_utility_memory_dma_allocate                     PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function allocates a transfer buffer from the DMA buffer pool  */
+/*    for the owner. The buffer is taken from the head of the free list   */
+/*    in constant time and is zeroed up to the requested size.            */
+/*                                                                        */
+/*    If the requested size is larger than a block, the owner quota is    */
+/*    reached or the pool is exhausted, the buffer is allocated from the  */
+/*    cache safe byte pool instead.                                       */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    owner                             Owner of buffer, one of           */
+/*                                        UX_MEMORY_DMA_OWNER_*           */
+/*    memory_size_requested             Number of bytes required          */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    Pointer to buffer                 UX_NULL if no memory available    */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _ux_utility_memory_allocate           Allocate memory               */
+/*    _ux_utility_memory_set                Set memory                    */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    USBX Components                                                     */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Mohamed ayed             Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+VOID  *_ux_utility_memory_dma_allocate(ULONG owner, ULONG memory_size_requested)
+{
+
+UX_INTERRUPT_SAVE_AREA
+UX_MEMORY_DMA_POOL  *dma_pool_ptr;
+UCHAR               *block_ptr;
+UCHAR               **block_link_ptr;
+
+
+    dma_pool_ptr =  &_ux_system -> ux_system_memory_dma_pool;
+
+    /* Lockout interrupts.  */
+    UX_DISABLE
+
+    if ((memory_size_requested <= UX_MEMORY_DMA_POOL_BLOCK_SIZE) && (owner < UX_MEMORY_DMA_OWNER_NUM))
+    {
+
+        block_ptr =  dma_pool_ptr -> ux_dma_pool_free_list;
+        if ((block_ptr != UX_NULL) &&
+            (dma_pool_ptr -> ux_dma_pool_used[owner] < dma_pool_ptr -> ux_dma_pool_quota[owner]))
+        {
+
+            /* Unlink the block from free list.  */
+            block_link_ptr =  UX_UCHAR_TO_INDIRECT_UCHAR_POINTER_CONVERT(block_ptr);
+            dma_pool_ptr -> ux_dma_pool_free_list =  *block_link_ptr;
+            dma_pool_ptr -> ux_dma_pool_free_count --;
+
+            /* Account the block to the owner.  */
+            dma_pool_ptr -> ux_dma_pool_used[owner] ++;
+            dma_pool_ptr -> ux_dma_pool_block_owner[(ULONG)(block_ptr - dma_pool_ptr -> ux_dma_pool_start) /
+                                                    UX_MEMORY_DMA_POOL_BLOCK_SIZE] =  (UCHAR)owner;
+
+            /* Restore interrupts.  */
+            UX_RESTORE
+
+            /* Clear the requested memory, as byte pool allocation does.  */
+            _ux_utility_memory_set(block_ptr, 0, memory_size_requested); /* Use case of memset is verified. */
+            return(block_ptr);
+        }
+    }
+
+    /* The request can not be served by DMA pool, count it.  */
+    dma_pool_ptr -> ux_dma_pool_fallback_count ++;
+
+    /* Restore interrupts.  */
+    UX_RESTORE
+
+    /* Use cache safe byte pool.  */
+    return(_ux_utility_memory_allocate(UX_SAFE_ALIGN, UX_CACHE_SAFE_MEMORY, memory_size_requested));
+}
+#endif
@@ -0,0 +1,106 @@
+/***************************************************************************
+ * Copyright (c) 2024 Microsoft Corporation
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the MIT License which is available at
+ * https://opensource.org/licenses/MIT.
+ *
+ * SPDX-License-Identifier: MIT
+ **************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** USBX Component                                                        */
+/**                                                                       */
+/**   Utility                                                             */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+
+/* Include necessary system files.  */
+
+#define UX_SOURCE_CODE
+
+#include "ux_api.h"
+
+
+#ifdef UX_ENABLE_MEMORY_DMA_POOL
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_utility_memory_dma_free                         PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function returns a transfer buffer allocated by                */
+/*    _ux_utility_memory_dma_allocate. A DMA pool block is linked back    */
+/*    to the head of the free list in constant time, other buffers are    */
+/*    released to the byte pool.                                          */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    memory                            Pointer to buffer                 */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _ux_utility_memory_free               Free memory                   */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    USBX Components                                                     */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Mohamed ayed             Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+VOID  _ux_utility_memory_dma_free(VOID *memory)
+{
+
+UX_INTERRUPT_SAVE_AREA
+UX_MEMORY_DMA_POOL  *dma_pool_ptr;
+UCHAR               *block_ptr;
+UCHAR               **block_link_ptr;
+
+
+    dma_pool_ptr =  &_ux_system -> ux_system_memory_dma_pool;
+    block_ptr =  (UCHAR *)memory;
+
+    /* Buffers out of DMA pool are from byte pool.  */
+    if ((block_ptr < dma_pool_ptr -> ux_dma_pool_start) || (block_ptr >= dma_pool_ptr -> ux_dma_pool_end))
+    {
+        _ux_utility_memory_free(memory);
+        return;
+    }
+
+    /* Lockout interrupts.  */
+    UX_DISABLE
+
+    /* Release the block from its owner.  */
+    dma_pool_ptr -> ux_dma_pool_used[dma_pool_ptr -> ux_dma_pool_block_owner[(ULONG)(block_ptr - dma_pool_ptr -> ux_dma_pool_start) /
+                                                                        UX_MEMORY_DMA_POOL_BLOCK_SIZE]] --;
+
+    /* Link the block to free list.  */
+    block_link_ptr =  UX_UCHAR_TO_INDIRECT_UCHAR_POINTER_CONVERT(block_ptr);
+    *block_link_ptr =  dma_pool_ptr -> ux_dma_pool_free_list;
+    dma_pool_ptr -> ux_dma_pool_free_list =  block_ptr;
+    dma_pool_ptr -> ux_dma_pool_free_count ++;
+
+    /* Restore interrupts.  */
+    UX_RESTORE
+}
+#endif
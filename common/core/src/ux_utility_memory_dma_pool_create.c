@@ -0,0 +1,118 @@
+/***************************************************************************
+ * Copyright (c) 2024 Microsoft Corporation
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the MIT License which is available at
+ * https://opensource.org/licenses/MIT.
+ *
+ * SPDX-License-Identifier: MIT
+ **************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** USBX Component                                                        */
+/**                                                                       */
+/**   Utility                                                             */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+
+/* Include necessary system files.  */
+
+#define UX_SOURCE_CODE
+
+#include "ux_api.h"
+
+
+#ifdef UX_ENABLE_MEMORY_DMA_POOL
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_utility_memory_dma_pool_create                  PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function reserves the DMA buffer pool from the cache safe      */
+/*    memory pool and links all its blocks to the free list. The blocks   */
+/*    are aligned to cache lines and have fixed size, so they are handed  */
+/*    out and returned in constant time by                                */
+/*    _ux_utility_memory_dma_allocate and _ux_utility_memory_dma_free.    */
+/*                                                                        */
+/*    The quota of each owner is set from UX_MEMORY_DMA_POOL_QUOTAS.      */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    Completion Status                                                   */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _ux_utility_memory_allocate           Allocate memory               */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    _ux_system_initialize                 Initialize USBX system        */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Mohamed ayed             Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+UINT  _ux_utility_memory_dma_pool_create(VOID)
+{
+
+UX_MEMORY_DMA_POOL  *dma_pool_ptr;
+UCHAR               *block_ptr;
+UCHAR               **block_link_ptr;
+ULONG               quota[UX_MEMORY_DMA_OWNER_NUM] = UX_MEMORY_DMA_POOL_QUOTAS;
+ULONG               index;
+
+
+    dma_pool_ptr =  &_ux_system -> ux_system_memory_dma_pool;
+
+    /* Reserve the blocks from cache safe memory, aligned to cache line.  */
+    block_ptr =  _ux_utility_memory_allocate(UX_MEMORY_DMA_POOL_ALIGN, UX_CACHE_SAFE_MEMORY,
+                            UX_MEMORY_DMA_POOL_BLOCK_SIZE * UX_MEMORY_DMA_POOL_BLOCK_NUM);
+    if (block_ptr == UX_NULL)
+        return(UX_MEMORY_INSUFFICIENT);
+
+    dma_pool_ptr -> ux_dma_pool_start =  block_ptr;
+    dma_pool_ptr -> ux_dma_pool_end =    block_ptr + UX_MEMORY_DMA_POOL_BLOCK_SIZE * UX_MEMORY_DMA_POOL_BLOCK_NUM;
+
+    /* Link all blocks to free list, through their memory buffers.  */
+    dma_pool_ptr -> ux_dma_pool_free_list =  UX_NULL;
+    index = UX_MEMORY_DMA_POOL_BLOCK_NUM;
+    while(index --)
+    {
+        block_ptr =  dma_pool_ptr -> ux_dma_pool_start + index * UX_MEMORY_DMA_POOL_BLOCK_SIZE;
+        block_link_ptr =  UX_UCHAR_TO_INDIRECT_UCHAR_POINTER_CONVERT(block_ptr);
+        *block_link_ptr =  dma_pool_ptr -> ux_dma_pool_free_list;
+        dma_pool_ptr -> ux_dma_pool_free_list =  block_ptr;
+    }
+    dma_pool_ptr -> ux_dma_pool_free_count =  UX_MEMORY_DMA_POOL_BLOCK_NUM;
+
+    /* Apply owner quotas.  */
+    for (index = 0; index < UX_MEMORY_DMA_OWNER_NUM; index ++)
+    {
+        dma_pool_ptr -> ux_dma_pool_quota[index] =  quota[index];
+        dma_pool_ptr -> ux_dma_pool_used[index] =   0;
+    }
+    dma_pool_ptr -> ux_dma_pool_fallback_count =  0;
+
+    /* Return success.  */
+    return(UX_SUCCESS);
+}
+#endif
@@ -32,7 +32,7 @@
 /*  FUNCTION                                               RELEASE        */
 /*                                                                        */
 /*    _ux_utility_memory_free                             PORTABLE C      */
-/*                                                           6.3.0        */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -51,8 +51,10 @@
 /*                                                                        */
 /*  CALLS                                                                 */
 /*                                                                        */
-/*    _ux_utility_mutex_on                  Start system protection       */
-/*    _ux_utility_mutex_off                 End system protection         */
+/*    _ux_utility_mutex_on                  Start pool protection         */
+/*    _ux_utility_mutex_off                 End pool protection           */
+/*    _ux_utility_memory_slab_free          Put block to slab cache       */
+/*    _ux_utility_memory_tlsf_free          Free TLSF block               */
 /*                                                                        */
 /*  CALLED BY                                                             */
 /*                                                                        */
@@ -72,6 +74,11 @@
 /*                                            added some error traps,     */
 /*                                            refined memory management,  */
 /*                                            resulting in version 6.3.0  */
+/*  xx-xx-xxxx     Mohamed ayed             Modified comment(s),          */
+/*                                            added memory slab support,  */
+/*                                            added TLSF support, used    */
+/*                                            mutex of pool,              */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 VOID  _ux_utility_memory_free(VOID *memory)
@@ -79,22 +86,23 @@ VOID  _ux_utility_memory_free(VOID *memory)
 UX_MEMORY_BYTE_POOL *pool_ptr;
 UCHAR               *work_ptr;
 UCHAR               *temp_ptr;
-UCHAR               *next_block_ptr;
-
 ALIGN_TYPE          *free_ptr;
 UX_MEMORY_BYTE_POOL **byte_pool_ptr;
+#if !defined(UX_ENABLE_MEMORY_TLSF) || defined(UX_ENABLE_MEMORY_STATISTICS)
+UCHAR               *next_block_ptr;
 UCHAR               **block_link_ptr;
+#endif
 #ifdef UX_ENABLE_MEMORY_POOL_SANITY_CHECK
 UCHAR               *memory_address;
 UCHAR               *regular_start, *regular_end;
 UCHAR               *cache_safe_start, *cache_safe_end;
-#endif
-#ifdef UX_ENABLE_MEMORY_STATISTICS
-UINT                index;
 #endif
 
-    /* Get the mutex as this is a critical section.  */
-    _ux_system_mutex_on(&_ux_system -> ux_system_mutex);
+    /* Get the pool of the memory by its address, each pool has its own mutex.  */
+    pool_ptr =  _ux_system -> ux_system_memory_byte_pool[UX_MEMORY_BYTE_POOL_CACHE_SAFE];
+    if (((UCHAR *)memory < pool_ptr -> ux_byte_pool_start) ||
+        ((UCHAR *)memory >= pool_ptr -> ux_byte_pool_start + pool_ptr -> ux_byte_pool_size))
+        pool_ptr =  _ux_system -> ux_system_memory_byte_pool[UX_MEMORY_BYTE_POOL_REGULAR];
 
 #ifdef UX_ENABLE_MEMORY_POOL_SANITY_CHECK
 
@@ -111,9 +119,6 @@ UINT                index;
           (memory_address >= cache_safe_start && memory_address < cache_safe_end)))
     {
 
-        /* Not valid. Release the protection.  */
-        _ux_system_mutex_off(&_ux_system -> ux_system_mutex);
-
         /* Error trap.  */
         _ux_system_error_handler(UX_SYSTEM_LEVEL_THREAD,
                                 UX_SYSTEM_CONTEXT_UTILITY, UX_MEMORY_CORRUPTED);
@@ -123,67 +128,48 @@ UINT                index;
     }
 #endif
 
-    /* Set the pool pointer to NULL.  */
-    pool_ptr =  UX_NULL;
-
     /* Determine if the memory pointer is valid.  */
     work_ptr =  UX_VOID_TO_UCHAR_POINTER_CONVERT(memory);
-    if (work_ptr != UX_NULL)
+    if (work_ptr == UX_NULL)
     {
 
-        /* Back off the memory pointer to pickup its header.  */
-        work_ptr =  UX_UCHAR_POINTER_SUB(work_ptr, UX_MEMORY_BLOCK_HEADER_SIZE);
-
-        /* There is a pointer, pickup the pool pointer address.  */
-        temp_ptr =  UX_UCHAR_POINTER_ADD(work_ptr, (sizeof(UCHAR *)));
-        free_ptr =  UX_UCHAR_TO_ALIGN_TYPE_POINTER_CONVERT(temp_ptr);
-        if ((*free_ptr) != UX_BYTE_BLOCK_FREE)
-        {
-
-            /* Pickup the pool pointer.  */
-            temp_ptr =  UX_UCHAR_POINTER_ADD(work_ptr, (sizeof(UCHAR *)));
-            byte_pool_ptr = UX_UCHAR_TO_INDIRECT_BYTE_POOL_POINTER(temp_ptr);
-            pool_ptr = *byte_pool_ptr;
-
-            /* See if we have a valid pool pointer.  */
-            if ((pool_ptr == UX_NULL) ||
-                ((pool_ptr != _ux_system -> ux_system_memory_byte_pool[UX_MEMORY_BYTE_POOL_REGULAR]) &&
-                (pool_ptr != _ux_system -> ux_system_memory_byte_pool[UX_MEMORY_BYTE_POOL_CACHE_SAFE])))
-            {
-
-                /* Release the protection.  */
-                _ux_system_mutex_off(&_ux_system -> ux_system_mutex);
-
-                /* Error trap: maybe double free/memory issue here!  */
-                _ux_system_error_handler(UX_SYSTEM_LEVEL_THREAD,
-                                         UX_SYSTEM_CONTEXT_UTILITY, UX_MEMORY_CORRUPTED);
-
-                /* Return to caller.  */
-                return;
-            }
-        }
-        else
-        {
-            /* Release the protection.  */
-            _ux_system_mutex_off(&_ux_system -> ux_system_mutex);
-
-            /* Error trap: maybe double free/memory issue here!  */
-            _ux_system_error_handler(UX_SYSTEM_LEVEL_THREAD,
-                                     UX_SYSTEM_CONTEXT_UTILITY, UX_MEMORY_CORRUPTED);
-
-            /* Return to caller.  */
-            return;
-        }
+        /* Error trap: maybe double free/bad flow here!  */
+        _ux_system_error_handler(UX_SYSTEM_LEVEL_THREAD,
+                                    UX_SYSTEM_CONTEXT_UTILITY, UX_MEMORY_CORRUPTED);
+
+        /* Return to caller.  */
+        return;
     }
-    else
+
+    /* Back off the memory pointer to pickup its header.  */
+    work_ptr =  UX_UCHAR_POINTER_SUB(work_ptr, UX_MEMORY_BLOCK_HEADER_SIZE);
+
+#ifdef UX_ENABLE_MEMORY_SLAB
+
+    /* Blocks of slab size classes are cached for next allocations, without
+       locking the pool.  */
+    if (_ux_utility_memory_slab_free(work_ptr) == UX_SUCCESS)
+        return;
+#endif
+
+    /* Get the mutex of the pool as this is a critical section.  */
+    _ux_system_mutex_on(&pool_ptr -> ux_byte_pool_mutex);
+
+    /* There is a pointer, pickup the pool pointer address.  */
+    temp_ptr =  UX_UCHAR_POINTER_ADD(work_ptr, (sizeof(UCHAR *)));
+    free_ptr =  UX_UCHAR_TO_ALIGN_TYPE_POINTER_CONVERT(temp_ptr);
+    byte_pool_ptr = UX_UCHAR_TO_INDIRECT_BYTE_POOL_POINTER(temp_ptr);
+
+    /* See if the block is allocated from the pool.  */
+    if (((*free_ptr) == UX_BYTE_BLOCK_FREE) || (*byte_pool_ptr != pool_ptr))
     {
 
         /* Release the protection.  */
-        _ux_system_mutex_off(&_ux_system -> ux_system_mutex);
+        _ux_system_mutex_off(&pool_ptr -> ux_byte_pool_mutex);
 
-        /* Error trap: maybe double free/bad flow here!  */
+        /* Error trap: maybe double free/memory issue here!  */
         _ux_system_error_handler(UX_SYSTEM_LEVEL_THREAD,
-                                    UX_SYSTEM_CONTEXT_UTILITY, UX_MEMORY_CORRUPTED);
+                                 UX_SYSTEM_CONTEXT_UTILITY, UX_MEMORY_CORRUPTED);
 
         /* Return to caller.  */
         return;
@@ -191,6 +177,19 @@ UINT                index;
 
     /* At this point, we know that the pool pointer is valid.  */
 
+#ifdef UX_ENABLE_MEMORY_TLSF
+
+#ifdef UX_ENABLE_MEMORY_STATISTICS
+
+    /* Keep the block end before it's merged.  */
+    block_link_ptr =  UX_UCHAR_TO_INDIRECT_UCHAR_POINTER_CONVERT(work_ptr);
+    next_block_ptr =  *block_link_ptr;
+#endif
+
+    /* Release the memory, merge it with free neighbors and list it.  */
+    _ux_utility_memory_tlsf_free(pool_ptr, work_ptr);
+#else
+
     /* Release the memory.  */
     temp_ptr =   UX_UCHAR_POINTER_ADD(work_ptr, (sizeof(UCHAR *)));
     free_ptr =   UX_UCHAR_TO_ALIGN_TYPE_POINTER_CONVERT(temp_ptr);
@@ -209,20 +208,15 @@ UINT                index;
         /* Yes, update the search pointer to the released block.  */
         pool_ptr -> ux_byte_pool_search =  work_ptr;
     }
+#endif
 
 #ifdef UX_ENABLE_MEMORY_STATISTICS
-    if (((UCHAR*)memory >= _ux_system -> ux_system_memory_byte_pool[UX_MEMORY_BYTE_POOL_REGULAR] -> ux_byte_pool_start) &&
-        ((UCHAR*)memory < (_ux_system -> ux_system_memory_byte_pool[UX_MEMORY_BYTE_POOL_REGULAR] -> ux_byte_pool_start + _ux_system -> ux_system_memory_byte_pool[UX_MEMORY_BYTE_POOL_REGULAR] -> ux_byte_pool_size)))
-        index = UX_MEMORY_BYTE_POOL_REGULAR;
-    else
-        index = UX_MEMORY_BYTE_POOL_CACHE_SAFE;
-
-    _ux_system -> ux_system_memory_byte_pool[index] -> ux_byte_pool_alloc_count --;
-    _ux_system -> ux_system_memory_byte_pool[index] -> ux_byte_pool_alloc_total -= UX_UCHAR_POINTER_DIF(next_block_ptr, work_ptr);
+    pool_ptr -> ux_byte_pool_alloc_count --;
+    pool_ptr -> ux_byte_pool_alloc_total -= UX_UCHAR_POINTER_DIF(next_block_ptr, work_ptr);
 #endif
 
     /* Release the protection.  */
-    _ux_system_mutex_off(&_ux_system -> ux_system_mutex);
+    _ux_system_mutex_off(&pool_ptr -> ux_byte_pool_mutex);
 
     /* Return to caller.  */
     return;
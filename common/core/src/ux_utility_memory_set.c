@@ -27,12 +27,13 @@
 #include "ux_api.h"
 
 
+#if !defined(_ux_utility_memory_set)
 /**************************************************************************/ 
 /*                                                                        */ 
 /*  FUNCTION                                               RELEASE        */ 
 /*                                                                        */ 
 /*    _ux_utility_memory_set                              PORTABLE C      */ 
-/*                                                           6.1          */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -41,6 +42,9 @@
 /*                                                                        */ 
 /*    This function sets a memory block with a specific value.            */ 
 /*                                                                        */ 
+/*    The unaligned head is set byte by byte, then the block is set word  */ 
+/*    by word and the remaining tail is set byte by byte.                 */ 
+/*                                                                        */ 
 /*  INPUT                                                                 */ 
 /*                                                                        */ 
 /*    destination                           Destination address           */ 
@@ -66,17 +70,77 @@
 /*  05-19-2020     Chaoqiong Xiao           Initial Version 6.0           */
 /*  09-30-2020     Chaoqiong Xiao           Modified comment(s),          */
 /*                                            resulting in version 6.1    */
+/*  xx-xx-xxxx     Mohamed ayed             Modified comment(s),          */
+/*                                            added word access support,  */
+/*                                            allowed port override,      */
+/*                                            used aliasing word type,    */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 VOID  _ux_utility_memory_set(VOID *destination, UCHAR value, ULONG length)
 {
 
-UCHAR *    work_ptr;
+UCHAR *                     work_ptr;
+#if !defined(UX_UTILITY_MEMORY_WORD_ACCESS_DISABLE)
+UX_UTILITY_MEMORY_WORD *    work_word_ptr;
+ALIGN_TYPE                  word_value;
+#endif
 
 
     /* Setup the working pointer */
     work_ptr =  (UCHAR *) destination;
 
+#if !defined(UX_UTILITY_MEMORY_WORD_ACCESS_DISABLE)
+
+    /* Check if it's worth setting words.  */
+    if (length >= UX_UTILITY_MEMORY_WORD_ACCESS_MIN)
+    {
+
+        /* Set the unaligned head.  */
+        while(((ALIGN_TYPE) work_ptr) & UX_UTILITY_MEMORY_WORD_MASK)
+        {
+
+            /* Set a byte.  */
+            *work_ptr++ =  value;
+            length--;
+        }
+
+        /* Build the word value, with the value in each byte.  */
+        word_value =  (ALIGN_TYPE) value;
+        word_value |=  word_value << 8;
+        word_value |=  word_value << 16;
+        if (UX_UTILITY_MEMORY_WORD_SIZE > 4u)
+            word_value |=  (word_value << 16) << 16;
+
+        /* Setup the word oriented working pointer.  */
+        work_word_ptr =  (UX_UTILITY_MEMORY_WORD *) ((VOID *) work_ptr);
+
+        /* Set 4 words in each loop.  */
+        while(length >= (UX_UTILITY_MEMORY_WORD_SIZE << 2))
+        {
+
+            work_word_ptr[0] =  word_value;
+            work_word_ptr[1] =  word_value;
+            work_word_ptr[2] =  word_value;
+            work_word_ptr[3] =  word_value;
+            work_word_ptr += 4;
+            length -= (UX_UTILITY_MEMORY_WORD_SIZE << 2);
+        }
+
+        /* Set remaining words.  */
+        while(length >= UX_UTILITY_MEMORY_WORD_SIZE)
+        {
+
+            /* Set a word.  */
+            *work_word_ptr++ =  word_value;
+            length -= UX_UTILITY_MEMORY_WORD_SIZE;
+        }
+
+        /* Back to byte oriented pointer for the tail.  */
+        work_ptr =  (UCHAR *) work_word_ptr;
+    }
+#endif
+
     /* Loop to set the memory.  */
     while(length--)
     {
@@ -88,4 +152,4 @@ UCHAR *    work_ptr;
     /* Return to caller.  */
     return; 
 }
-
+#endif
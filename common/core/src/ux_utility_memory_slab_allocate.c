@@ -0,0 +1,116 @@
+/***************************************************************************
+ * Copyright (c) 2024 Microsoft Corporation
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the MIT License which is available at
+ * https://opensource.org/licenses/MIT.
+ *
+ * SPDX-License-Identifier: MIT
+ **************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** USBX Component                                                        */
+/**                                                                       */
+/**   Utility                                                             */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+
+/* Include necessary system files.  */
+
+#define UX_SOURCE_CODE
+
+#include "ux_api.h"
+
+
+#ifdef UX_ENABLE_MEMORY_SLAB
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_utility_memory_slab_allocate                    PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function takes a cached block from a slab size class. The      */
+/*    memory buffer of the block is cleared before it is returned.        */
+/*                                                                        */
+/*    The cache is accessed with interrupts locked out for a few          */
+/*    instructions, the pool mutex is not needed. Cached blocks are kept  */
+/*    allocated in the pool, so pool statistics are not changed.          */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    slab_ptr                          Pointer to slab size class        */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    VOID *                            Pointer to the memory buffer,     */
+/*                                        NULL if no block is cached      */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _ux_utility_memory_set                Set memory                    */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    _ux_utility_memory_allocate           Allocate memory               */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Mohamed ayed             Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+VOID  *_ux_utility_memory_slab_allocate(UX_MEMORY_SLAB *slab_ptr)
+{
+
+UX_INTERRUPT_SAVE_AREA
+UCHAR               *block_ptr;
+UCHAR               *work_ptr;
+UCHAR               **block_link_ptr;
+ALIGN_TYPE          *free_ptr;
+
+
+    /* Lockout interrupts.  */
+    UX_DISABLE
+
+    /* Pickup the first cached block.  */
+    block_ptr =  slab_ptr -> ux_memory_slab_free_list;
+    if (block_ptr == UX_NULL)
+    {
+
+        /* Restore interrupts.  */
+        UX_RESTORE
+        return(UX_NULL);
+    }
+
+    /* Unlink it, the link is saved in the memory buffer.  */
+    work_ptr =        UX_UCHAR_POINTER_ADD(block_ptr, UX_MEMORY_BLOCK_HEADER_SIZE);
+    block_link_ptr =  UX_UCHAR_TO_INDIRECT_UCHAR_POINTER_CONVERT(work_ptr);
+    slab_ptr -> ux_memory_slab_free_list =  *block_link_ptr;
+    slab_ptr -> ux_memory_slab_cached --;
+
+    /* Mark the block as allocated from the slab.  */
+    free_ptr =  UX_UCHAR_TO_ALIGN_TYPE_POINTER_CONVERT(UX_UCHAR_POINTER_ADD(block_ptr, sizeof(UCHAR *)));
+    *free_ptr = UX_POINTER_TO_ALIGN_TYPE_CONVERT(slab_ptr);
+
+    /* Restore interrupts.  */
+    UX_RESTORE
+
+    /* Clear the memory buffer.  */
+    _ux_utility_memory_set(work_ptr, 0, slab_ptr -> ux_memory_slab_size); /* Use case of memset is verified. */
+
+    /* Return the memory buffer.  */
+    return(work_ptr);
+}
+#endif
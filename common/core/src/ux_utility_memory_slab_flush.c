@@ -0,0 +1,143 @@
+/***************************************************************************
+ * Copyright (c) 2024 Microsoft Corporation
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the MIT License which is available at
+ * https://opensource.org/licenses/MIT.
+ *
+ * SPDX-License-Identifier: MIT
+ **************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** USBX Component                                                        */
+/**                                                                       */
+/**   Utility                                                             */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+
+/* Include necessary system files.  */
+
+#define UX_SOURCE_CODE
+
+#include "ux_api.h"
+
+
+#ifdef UX_ENABLE_MEMORY_SLAB
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_utility_memory_slab_flush                       PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function releases all blocks cached by the slab size classes   */
+/*    of a pool to the byte pool, so they can be merged and reused for    */
+/*    allocations of any size.                                            */
+/*                                                                        */
+/*    It's called with pool mutex on. Each cache is detached with         */
+/*    interrupts locked out, then its blocks are released to the pool.    */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    pool_ptr                          Pointer to pool control block     */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    ULONG                             Number of released blocks         */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _ux_utility_memory_tlsf_free          Free TLSF block               */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    _ux_utility_memory_allocate           Allocate memory               */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Mohamed ayed             Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+ULONG  _ux_utility_memory_slab_flush(UX_MEMORY_BYTE_POOL *pool_ptr)
+{
+
+UX_INTERRUPT_SAVE_AREA
+UX_MEMORY_SLAB      *slab_ptr;
+UCHAR               *cached_ptr;
+UCHAR               *block_ptr;
+UCHAR               *work_ptr;
+UCHAR               **block_link_ptr;
+#ifndef UX_ENABLE_MEMORY_TLSF
+ALIGN_TYPE          *free_ptr;
+#endif
+ULONG               released = 0;
+UINT                index;
+
+
+    for (index = 0; index < UX_MEMORY_SLAB_CLASS_NUM; index ++)
+    {
+        slab_ptr = &pool_ptr -> ux_byte_pool_slab[index];
+
+        /* Detach all cached blocks of the class.  */
+        UX_DISABLE
+        cached_ptr = slab_ptr -> ux_memory_slab_free_list;
+        slab_ptr -> ux_memory_slab_free_list = UX_NULL;
+        slab_ptr -> ux_memory_slab_cached = 0;
+        UX_RESTORE
+
+        while(cached_ptr != UX_NULL)
+        {
+
+            /* Unlink the first cached block.  */
+            block_ptr =       cached_ptr;
+            work_ptr =        UX_UCHAR_POINTER_ADD(block_ptr, UX_MEMORY_BLOCK_HEADER_SIZE);
+            block_link_ptr =  UX_UCHAR_TO_INDIRECT_UCHAR_POINTER_CONVERT(work_ptr);
+            cached_ptr =      *block_link_ptr;
+
+#ifdef UX_ENABLE_MEMORY_STATISTICS
+
+            /* Cached blocks are counted as allocated until they are released.  */
+            block_link_ptr =  UX_UCHAR_TO_INDIRECT_UCHAR_POINTER_CONVERT(block_ptr);
+            pool_ptr -> ux_byte_pool_alloc_count --;
+            pool_ptr -> ux_byte_pool_alloc_total -= UX_UCHAR_POINTER_DIF(*block_link_ptr, block_ptr);
+#endif
+
+#ifdef UX_ENABLE_MEMORY_TLSF
+
+            /* Release the block to the byte pool.  */
+            _ux_utility_memory_tlsf_free(pool_ptr, block_ptr);
+#else
+
+            /* Release the block to the byte pool.  */
+            free_ptr =  UX_UCHAR_TO_ALIGN_TYPE_POINTER_CONVERT(UX_UCHAR_POINTER_ADD(block_ptr, sizeof(UCHAR *)));
+            *free_ptr = UX_BYTE_BLOCK_FREE;
+
+            /* Update the number of available bytes in the pool.  */
+            block_link_ptr =  UX_UCHAR_TO_INDIRECT_UCHAR_POINTER_CONVERT(block_ptr);
+            pool_ptr -> ux_byte_pool_available += UX_UCHAR_POINTER_DIF(*block_link_ptr, block_ptr);
+
+            /* Determine if the free block is prior to current search pointer.  */
+            if (block_ptr < pool_ptr -> ux_byte_pool_search)
+                pool_ptr -> ux_byte_pool_search = block_ptr;
+#endif
+
+            released ++;
+        }
+    }
+
+    /* Return number of released blocks.  */
+    return(released);
+}
+#endif
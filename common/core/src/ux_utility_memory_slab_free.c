@@ -0,0 +1,137 @@
+/***************************************************************************
+ * Copyright (c) 2024 Microsoft Corporation
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the MIT License which is available at
+ * https://opensource.org/licenses/MIT.
+ *
+ * SPDX-License-Identifier: MIT
+ **************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** USBX Component                                                        */
+/**                                                                       */
+/**   Utility                                                             */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+
+/* Include necessary system files.  */
+
+#define UX_SOURCE_CODE
+
+#include "ux_api.h"
+
+
+#ifdef UX_ENABLE_MEMORY_SLAB
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_utility_memory_slab_free                        PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function puts a block allocated from a slab size class back    */
+/*    to the cache of the class. The block stays allocated in the byte    */
+/*    pool until the cache is flushed.                                    */
+/*                                                                        */
+/*    The cache is accessed with interrupts locked out for a few          */
+/*    instructions, the pool mutex is not needed.                         */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    block_ptr                         Pointer to block (header)         */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    Completion Status                 UX_SUCCESS if block is cached,    */
+/*                                        UX_ERROR if it's not a slab     */
+/*                                        block                           */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    _ux_utility_memory_free               Free memory                   */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Mohamed ayed             Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+UINT  _ux_utility_memory_slab_free(UCHAR *block_ptr)
+{
+
+UX_INTERRUPT_SAVE_AREA
+UX_MEMORY_BYTE_POOL *pool_ptr;
+UX_MEMORY_SLAB      *slab_ptr;
+UCHAR               *work_ptr;
+UCHAR               **block_link_ptr;
+ALIGN_TYPE          *free_ptr;
+ALIGN_TYPE          owner;
+ALIGN_TYPE          slab_offset;
+UINT                index;
+
+
+    /* Pickup the block owner.  */
+    free_ptr =  UX_UCHAR_TO_ALIGN_TYPE_POINTER_CONVERT(UX_UCHAR_POINTER_ADD(block_ptr, sizeof(UCHAR *)));
+    owner =     *free_ptr;
+
+    /* Check if the owner is a size class of regular or cache safe pool.  */
+    for (index = 0; index < UX_MEMORY_BYTE_POOL_NUM; index ++)
+    {
+        pool_ptr = _ux_system -> ux_system_memory_byte_pool[index];
+        if (pool_ptr == UX_NULL)
+            continue;
+
+        slab_offset = owner - UX_POINTER_TO_ALIGN_TYPE_CONVERT(pool_ptr -> ux_byte_pool_slab);
+        if ((slab_offset < sizeof(pool_ptr -> ux_byte_pool_slab)) &&
+            ((slab_offset % sizeof(UX_MEMORY_SLAB)) == 0))
+            break;
+    }
+    if (index >= UX_MEMORY_BYTE_POOL_NUM)
+        return(UX_ERROR);
+    slab_ptr =  &pool_ptr -> ux_byte_pool_slab[slab_offset / sizeof(UX_MEMORY_SLAB)];
+
+    /* Lockout interrupts.  */
+    UX_DISABLE
+
+    /* The block may have been cached by another free meanwhile.  */
+    if (*free_ptr != owner)
+    {
+
+        /* Restore interrupts.  */
+        UX_RESTORE
+        return(UX_ERROR);
+    }
+
+    /* Mark the block as cached, so it can not be freed again.  */
+    *free_ptr = UX_BYTE_BLOCK_SLAB_CACHED;
+
+    /* Link it to the cached blocks through its memory buffer.  */
+    work_ptr =        UX_UCHAR_POINTER_ADD(block_ptr, UX_MEMORY_BLOCK_HEADER_SIZE);
+    block_link_ptr =  UX_UCHAR_TO_INDIRECT_UCHAR_POINTER_CONVERT(work_ptr);
+    *block_link_ptr = slab_ptr -> ux_memory_slab_free_list;
+    slab_ptr -> ux_memory_slab_free_list = block_ptr;
+    slab_ptr -> ux_memory_slab_cached ++;
+
+    /* Restore interrupts.  */
+    UX_RESTORE
+
+    /* Block is cached.  */
+    return(UX_SUCCESS);
+}
+#endif
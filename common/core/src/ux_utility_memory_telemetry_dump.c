@@ -0,0 +1,251 @@
+/***************************************************************************
+ * Copyright (c) 2024 Microsoft Corporation
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the MIT License which is available at
+ * https://opensource.org/licenses/MIT.
+ *
+ * SPDX-License-Identifier: MIT
+ **************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** USBX Component                                                        */
+/**                                                                       */
+/**   Utility                                                             */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+
+/* Include necessary system files.  */
+
+#define UX_SOURCE_CODE
+
+#include "ux_api.h"
+
+
+#ifdef UX_ENABLE_MEMORY_TELEMETRY
+
+/* Define the size of dump line buffer.  */
+#define UX_MEMORY_TELEMETRY_DUMP_LINE_SIZE              128
+
+static VOID _ux_utility_memory_telemetry_dump_pool(UX_MEMORY_BYTE_POOL *pool_ptr, ULONG memory_cache_flag,
+                                     UCHAR *pool_name, VOID (*dump_callback)(UCHAR *line, ULONG line_length));
+static VOID _ux_utility_memory_telemetry_dump_histogram(UX_MEMORY_HISTOGRAM *histogram,
+                                     UCHAR *pool_name, UCHAR *histogram_name,
+                                     VOID (*dump_callback)(UCHAR *line, ULONG line_length));
+static UINT _ux_utility_memory_telemetry_dump_string(UCHAR *line, UINT length, UCHAR *string);
+static UINT _ux_utility_memory_telemetry_dump_number(UCHAR *line, UINT length, ALIGN_TYPE value, UINT hex);
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_utility_memory_telemetry_dump                   PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function dumps the memory telemetry of byte pools as text      */
+/*    lines, each line is passed to the dump callback (e.g., to print     */
+/*    it to a console or to a log). Histogram buckets are dumped by       */
+/*    their upper bounds, empty buckets are skipped.                      */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    dump_callback                     Callback for a dump line          */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _ux_utility_memory_telemetry_get                                    */
+/*                                          Get telemetry                 */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    Application                                                         */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Mohamed ayed             Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+VOID  _ux_utility_memory_telemetry_dump(VOID (*dump_callback)(UCHAR *line, ULONG line_length))
+{
+
+UX_MEMORY_BYTE_POOL *regular_pool_ptr;
+UX_MEMORY_BYTE_POOL *cache_safe_pool_ptr;
+
+
+    if (dump_callback == UX_NULL)
+        return;
+
+    /* Dump the regular pool.  */
+    regular_pool_ptr = _ux_system -> ux_system_memory_byte_pool[UX_MEMORY_BYTE_POOL_REGULAR];
+    if (regular_pool_ptr != UX_NULL)
+        _ux_utility_memory_telemetry_dump_pool(regular_pool_ptr, UX_REGULAR_MEMORY,
+                                               (UCHAR *)"regular pool", dump_callback);
+
+    /* Dump the cache safe pool if it's not shared with the regular one.  */
+    cache_safe_pool_ptr = _ux_system -> ux_system_memory_byte_pool[UX_MEMORY_BYTE_POOL_CACHE_SAFE];
+    if ((cache_safe_pool_ptr != UX_NULL) && (cache_safe_pool_ptr != regular_pool_ptr))
+        _ux_utility_memory_telemetry_dump_pool(cache_safe_pool_ptr, UX_CACHE_SAFE_MEMORY,
+                                               (UCHAR *)"cache safe pool", dump_callback);
+}
+
+static VOID _ux_utility_memory_telemetry_dump_pool(UX_MEMORY_BYTE_POOL *pool_ptr, ULONG memory_cache_flag,
+                                     UCHAR *pool_name, VOID (*dump_callback)(UCHAR *line, ULONG line_length))
+{
+UX_MEMORY_TELEMETRY         telemetry;
+UX_MEMORY_TELEMETRY_SITE    *site_ptr;
+UCHAR                       line[UX_MEMORY_TELEMETRY_DUMP_LINE_SIZE];
+UINT                        length;
+UINT                        index;
+
+    if (_ux_utility_memory_telemetry_get(memory_cache_flag, &telemetry) != UX_SUCCESS)
+        return;
+
+    /* Pool size and usage.  */
+    length = _ux_utility_memory_telemetry_dump_string(line, 0, pool_name);
+    length = _ux_utility_memory_telemetry_dump_string(line, length, (UCHAR *)": size ");
+    length = _ux_utility_memory_telemetry_dump_number(line, length, pool_ptr -> ux_byte_pool_size, UX_FALSE);
+    length = _ux_utility_memory_telemetry_dump_string(line, length, (UCHAR *)", available ");
+    length = _ux_utility_memory_telemetry_dump_number(line, length, pool_ptr -> ux_byte_pool_available, UX_FALSE);
+    dump_callback(line, length);
+
+    /* Fragmentation.  */
+    length = _ux_utility_memory_telemetry_dump_string(line, 0, pool_name);
+    length = _ux_utility_memory_telemetry_dump_string(line, length, (UCHAR *)": fragments ");
+    length = _ux_utility_memory_telemetry_dump_number(line, length, telemetry.ux_memory_telemetry_fragments, UX_FALSE);
+    length = _ux_utility_memory_telemetry_dump_string(line, length, (UCHAR *)", max ");
+    length = _ux_utility_memory_telemetry_dump_number(line, length, telemetry.ux_memory_telemetry_fragments_max, UX_FALSE);
+    length = _ux_utility_memory_telemetry_dump_string(line, length, (UCHAR *)", free blocks ");
+    length = _ux_utility_memory_telemetry_dump_number(line, length, telemetry.ux_memory_telemetry_free_blocks, UX_FALSE);
+    dump_callback(line, length);
+
+    length = _ux_utility_memory_telemetry_dump_string(line, 0, pool_name);
+    length = _ux_utility_memory_telemetry_dump_string(line, length, (UCHAR *)": largest free ");
+    length = _ux_utility_memory_telemetry_dump_number(line, length, telemetry.ux_memory_telemetry_largest_free, UX_FALSE);
+    length = _ux_utility_memory_telemetry_dump_string(line, length, (UCHAR *)", min ");
+    length = _ux_utility_memory_telemetry_dump_number(line, length, telemetry.ux_memory_telemetry_largest_free_min, UX_FALSE);
+    dump_callback(line, length);
+
+    /* Allocations.  */
+    length = _ux_utility_memory_telemetry_dump_string(line, 0, pool_name);
+    length = _ux_utility_memory_telemetry_dump_string(line, length, (UCHAR *)": allocations ");
+    length = _ux_utility_memory_telemetry_dump_number(line, length, telemetry.ux_memory_telemetry_alloc_count, UX_FALSE);
+    length = _ux_utility_memory_telemetry_dump_string(line, length, (UCHAR *)", failures ");
+    length = _ux_utility_memory_telemetry_dump_number(line, length, telemetry.ux_memory_telemetry_fail_count, UX_FALSE);
+    dump_callback(line, length);
+
+    /* Histograms.  */
+    _ux_utility_memory_telemetry_dump_histogram(&telemetry.ux_memory_telemetry_latency, pool_name,
+                                                (UCHAR *)": latency", dump_callback);
+    _ux_utility_memory_telemetry_dump_histogram(&telemetry.ux_memory_telemetry_walk, pool_name,
+                                                (UCHAR *)": search walk", dump_callback);
+
+    /* Allocation sites.  */
+    for (index = 0; index < UX_MEMORY_TELEMETRY_SITE_NUM; index ++)
+    {
+        site_ptr = &telemetry.ux_memory_telemetry_sites[index];
+        if ((site_ptr -> ux_memory_telemetry_site_alloc_count == 0) &&
+            (site_ptr -> ux_memory_telemetry_site_fail_count == 0))
+            continue;
+
+        length = _ux_utility_memory_telemetry_dump_string(line, 0, pool_name);
+        length = _ux_utility_memory_telemetry_dump_string(line, length, (UCHAR *)": site 0x");
+        length = _ux_utility_memory_telemetry_dump_number(line, length, site_ptr -> ux_memory_telemetry_site_id, UX_TRUE);
+        length = _ux_utility_memory_telemetry_dump_string(line, length, (UCHAR *)": allocations ");
+        length = _ux_utility_memory_telemetry_dump_number(line, length, site_ptr -> ux_memory_telemetry_site_alloc_count, UX_FALSE);
+        length = _ux_utility_memory_telemetry_dump_string(line, length, (UCHAR *)", failures ");
+        length = _ux_utility_memory_telemetry_dump_number(line, length, site_ptr -> ux_memory_telemetry_site_fail_count, UX_FALSE);
+        length = _ux_utility_memory_telemetry_dump_string(line, length, (UCHAR *)", bytes ");
+        length = _ux_utility_memory_telemetry_dump_number(line, length, site_ptr -> ux_memory_telemetry_site_alloc_total, UX_FALSE);
+        length = _ux_utility_memory_telemetry_dump_string(line, length, (UCHAR *)", max ");
+        length = _ux_utility_memory_telemetry_dump_number(line, length, site_ptr -> ux_memory_telemetry_site_alloc_max, UX_FALSE);
+        dump_callback(line, length);
+    }
+}
+
+static VOID _ux_utility_memory_telemetry_dump_histogram(UX_MEMORY_HISTOGRAM *histogram,
+                                     UCHAR *pool_name, UCHAR *histogram_name,
+                                     VOID (*dump_callback)(UCHAR *line, ULONG line_length))
+{
+UCHAR                       line[UX_MEMORY_TELEMETRY_DUMP_LINE_SIZE];
+UINT                        length;
+UINT                        bucket;
+
+    length = _ux_utility_memory_telemetry_dump_string(line, 0, pool_name);
+    length = _ux_utility_memory_telemetry_dump_string(line, length, histogram_name);
+    length = _ux_utility_memory_telemetry_dump_string(line, length, (UCHAR *)" max ");
+    length = _ux_utility_memory_telemetry_dump_number(line, length, histogram -> ux_memory_histogram_max, UX_FALSE);
+    dump_callback(line, length);
+
+    for (bucket = 0; bucket < UX_MEMORY_TELEMETRY_HISTOGRAM_SIZE; bucket ++)
+    {
+        if (histogram -> ux_memory_histogram_count[bucket] == 0)
+            continue;
+
+        /* Bucket N is for values less than 2^N, the last one is for values not less than 2^(N-1).  */
+        length = _ux_utility_memory_telemetry_dump_string(line, 0, pool_name);
+        length = _ux_utility_memory_telemetry_dump_string(line, length, histogram_name);
+        if (bucket < (UX_MEMORY_TELEMETRY_HISTOGRAM_SIZE - 1))
+        {
+            length = _ux_utility_memory_telemetry_dump_string(line, length, (UCHAR *)" < ");
+            length = _ux_utility_memory_telemetry_dump_number(line, length, (ALIGN_TYPE)1u << bucket, UX_FALSE);
+        }
+        else
+        {
+            length = _ux_utility_memory_telemetry_dump_string(line, length, (UCHAR *)" >= ");
+            length = _ux_utility_memory_telemetry_dump_number(line, length, (ALIGN_TYPE)1u << (bucket - 1), UX_FALSE);
+        }
+        length = _ux_utility_memory_telemetry_dump_string(line, length, (UCHAR *)": ");
+        length = _ux_utility_memory_telemetry_dump_number(line, length, histogram -> ux_memory_histogram_count[bucket], UX_FALSE);
+        dump_callback(line, length);
+    }
+}
+
+static UINT _ux_utility_memory_telemetry_dump_string(UCHAR *line, UINT length, UCHAR *string)
+{
+
+    /* Append the string, keep space for null-terminator.  */
+    while((*string != 0) && (length < (UX_MEMORY_TELEMETRY_DUMP_LINE_SIZE - 1)))
+        line[length ++] = *string ++;
+    line[length] = 0;
+    return(length);
+}
+
+static UINT _ux_utility_memory_telemetry_dump_number(UCHAR *line, UINT length, ALIGN_TYPE value, UINT hex)
+{
+UCHAR                       digits[sizeof(ALIGN_TYPE) * 3];
+UINT                        count = 0;
+UINT                        digit;
+ALIGN_TYPE                  base = hex ? 16u : 10u;
+
+    /* Convert the value, hexadecimal numbers are dumped in full width.  */
+    do
+    {
+        digit = (UINT)(value % base);
+        digits[count ++] = (UCHAR)((digit < 10) ? ('0' + digit) : ('A' + digit - 10));
+        value /= base;
+    } while((value != 0) || (hex && (count < (sizeof(ALIGN_TYPE) * 2))));
+
+    /* Append digits, keep space for null-terminator.  */
+    while((count != 0) && (length < (UX_MEMORY_TELEMETRY_DUMP_LINE_SIZE - 1)))
+        line[length ++] = digits[-- count];
+    line[length] = 0;
+    return(length);
+}
+#endif
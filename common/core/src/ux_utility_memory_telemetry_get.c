@@ -0,0 +1,127 @@
+/***************************************************************************
+ * Copyright (c) 2024 Microsoft Corporation
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the MIT License which is available at
+ * https://opensource.org/licenses/MIT.
+ *
+ * SPDX-License-Identifier: MIT
+ **************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** USBX Component                                                        */
+/**                                                                       */
+/**   Utility                                                             */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+
+/* Include necessary system files.  */
+
+#define UX_SOURCE_CODE
+
+#include "ux_api.h"
+
+
+#ifdef UX_ENABLE_MEMORY_TELEMETRY
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_utility_memory_telemetry_get                    PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function gets the memory telemetry of a byte pool. Fragments,  */
+/*    free blocks and the largest free block are updated on the call.     */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    memory_cache_flag                 Memory pool source                */
+/*    telemetry                         Pointer to telemetry buffer       */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    Completion Status                                                   */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _ux_utility_memory_copy               Copy memory                   */
+/*    _ux_utility_memory_telemetry_largest_free_get                       */
+/*                                          Get largest free block        */
+/*    _ux_utility_mutex_on                  Start pool protection         */
+/*    _ux_utility_mutex_off                 End pool protection           */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    Application                                                         */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Mohamed ayed             Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+UINT  _ux_utility_memory_telemetry_get(ULONG memory_cache_flag, UX_MEMORY_TELEMETRY *telemetry)
+{
+
+UX_INTERRUPT_SAVE_AREA
+UX_MEMORY_BYTE_POOL *pool_ptr;
+UX_MEMORY_TELEMETRY *pool_telemetry;
+ULONG               largest;
+ULONG               free_blocks;
+
+
+    /* Get the pool ptr.  */
+    if (memory_cache_flag == UX_REGULAR_MEMORY)
+        pool_ptr = _ux_system -> ux_system_memory_byte_pool[UX_MEMORY_BYTE_POOL_REGULAR];
+    else if (memory_cache_flag == UX_CACHE_SAFE_MEMORY)
+        pool_ptr = _ux_system -> ux_system_memory_byte_pool[UX_MEMORY_BYTE_POOL_CACHE_SAFE];
+    else
+        return(UX_INVALID_PARAMETER);
+    if (pool_ptr == UX_NULL)
+        return(UX_INVALID_PARAMETER);
+
+    if (telemetry == UX_NULL)
+        return(UX_INVALID_PARAMETER);
+
+    /* Get the mutex of the pool to walk through it.  */
+    _ux_system_mutex_on(&pool_ptr -> ux_byte_pool_mutex);
+
+    largest = _ux_utility_memory_telemetry_largest_free_get(pool_ptr, &free_blocks);
+
+    pool_telemetry = &pool_ptr -> ux_byte_pool_telemetry;
+
+    /* Update and copy the counters, with interrupts locked out for slab cache logs.
+       The sites are the last field, they are not part of the copy.  */
+    UX_DISABLE
+    pool_telemetry -> ux_memory_telemetry_fragments = pool_ptr -> ux_byte_pool_fragments;
+    if (pool_telemetry -> ux_memory_telemetry_fragments_max < pool_ptr -> ux_byte_pool_fragments)
+        pool_telemetry -> ux_memory_telemetry_fragments_max = pool_ptr -> ux_byte_pool_fragments;
+    pool_telemetry -> ux_memory_telemetry_free_blocks = free_blocks;
+    pool_telemetry -> ux_memory_telemetry_largest_free = largest;
+    if (pool_telemetry -> ux_memory_telemetry_largest_free_min > largest)
+        pool_telemetry -> ux_memory_telemetry_largest_free_min = largest;
+    _ux_utility_memory_copy(telemetry, pool_telemetry,
+                sizeof(UX_MEMORY_TELEMETRY) - sizeof(pool_telemetry -> ux_memory_telemetry_sites)); /* Use case of memcpy is verified. */
+    UX_RESTORE
+
+    /* Copy the sites, they are logged under the pool mutex.  */
+    _ux_utility_memory_copy(telemetry -> ux_memory_telemetry_sites, pool_telemetry -> ux_memory_telemetry_sites,
+                            sizeof(pool_telemetry -> ux_memory_telemetry_sites)); /* Use case of memcpy is verified. */
+
+    /* Release the protection.  */
+    _ux_system_mutex_off(&pool_ptr -> ux_byte_pool_mutex);
+
+    return(UX_SUCCESS);
+}
+#endif
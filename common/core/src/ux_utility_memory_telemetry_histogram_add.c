@@ -0,0 +1,92 @@
+/***************************************************************************
+ * Copyright (c) 2024 Microsoft Corporation
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the MIT License which is available at
+ * https://opensource.org/licenses/MIT.
+ *
+ * SPDX-License-Identifier: MIT
+ **************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** USBX Component                                                        */
+/**                                                                       */
+/**   Utility                                                             */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+
+/* Include necessary system files.  */
+
+#define UX_SOURCE_CODE
+
+#include "ux_api.h"
+
+
+#ifdef UX_ENABLE_MEMORY_TELEMETRY
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_utility_memory_telemetry_histogram_add          PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function logs a value in a telemetry histogram, the bucket of  */
+/*    the value is the number of its significant bits.                    */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    histogram                         Pointer to histogram              */
+/*    value                             Value to log                      */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    _ux_utility_memory_byte_pool_search   Search pool                   */
+/*    _ux_utility_memory_telemetry_record   Log allocation                */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Mohamed ayed             Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+VOID  _ux_utility_memory_telemetry_histogram_add(UX_MEMORY_HISTOGRAM *histogram, ULONG value)
+{
+
+ULONG               bits;
+UINT                bucket;
+
+
+    /* Count significant bits of the value, larger values share the last bucket.  */
+    bits = value;
+    bucket = 0;
+    while((bits != 0) && (bucket < (UX_MEMORY_TELEMETRY_HISTOGRAM_SIZE - 1)))
+    {
+        bits >>= 1;
+        bucket ++;
+    }
+
+    /* Log the value.  */
+    histogram -> ux_memory_histogram_count[bucket] ++;
+    if (histogram -> ux_memory_histogram_max < value)
+        histogram -> ux_memory_histogram_max = value;
+}
+#endif
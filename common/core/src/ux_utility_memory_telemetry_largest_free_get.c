@@ -0,0 +1,131 @@
+/***************************************************************************
+ * Copyright (c) 2024 Microsoft Corporation
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the MIT License which is available at
+ * https://opensource.org/licenses/MIT.
+ *
+ * SPDX-License-Identifier: MIT
+ **************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** USBX Component                                                        */
+/**                                                                       */
+/**   Utility                                                             */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+
+/* Include necessary system files.  */
+
+#define UX_SOURCE_CODE
+
+#include "ux_api.h"
+
+
+#ifdef UX_ENABLE_MEMORY_TELEMETRY
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_utility_memory_telemetry_largest_free_get       PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function walks through a byte pool to find its largest free    */
+/*    block and the number of free blocks. Adjacent free blocks are       */
+/*    counted as one since they are merged when the pool is searched.     */
+/*    Blocks cached by slab size classes are not free.                    */
+/*                                                                        */
+/*    It's called with pool mutex on.                                     */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    pool_ptr                          Pointer to pool control block     */
+/*    free_blocks                       Pointer to free blocks count,     */
+/*                                        can be UX_NULL                  */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    ULONG                             Number of bytes of the largest    */
+/*                                        free block                      */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    _ux_utility_memory_telemetry_get      Get telemetry                 */
+/*    _ux_utility_memory_telemetry_record   Log allocation                */
+/*    _ux_utility_memory_telemetry_reset    Reset telemetry               */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Mohamed ayed             Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+ULONG  _ux_utility_memory_telemetry_largest_free_get(UX_MEMORY_BYTE_POOL *pool_ptr, ULONG *free_blocks)
+{
+
+UCHAR               *block_ptr;
+UCHAR               *free_start_ptr;
+UCHAR               **block_link_ptr;
+ALIGN_TYPE          *free_ptr;
+ULONG               free_size;
+ULONG               largest = 0;
+ULONG               count = 0;
+
+
+    /* Walk through all blocks, the pre-allocated block at the end links to the start.  */
+    free_start_ptr = UX_NULL;
+    block_ptr = pool_ptr -> ux_byte_pool_start;
+    while(1)
+    {
+        free_ptr =        UX_UCHAR_TO_ALIGN_TYPE_POINTER_CONVERT(UX_UCHAR_POINTER_ADD(block_ptr, sizeof(UCHAR *)));
+        block_link_ptr =  UX_UCHAR_TO_INDIRECT_UCHAR_POINTER_CONVERT(block_ptr);
+
+        if (*free_ptr == UX_BYTE_BLOCK_FREE)
+        {
+
+            /* Start of free area.  */
+            if (free_start_ptr == UX_NULL)
+            {
+                free_start_ptr = block_ptr;
+                count ++;
+            }
+        }
+        else if (free_start_ptr != UX_NULL)
+        {
+
+            /* End of free area, check its size.  */
+            free_size = UX_UCHAR_POINTER_DIF(block_ptr, free_start_ptr) - UX_MEMORY_BLOCK_HEADER_SIZE;
+            if (largest < free_size)
+                largest = free_size;
+            free_start_ptr = UX_NULL;
+        }
+
+        /* Check if it's the end of pool.  */
+        if (*block_link_ptr == pool_ptr -> ux_byte_pool_start)
+            break;
+        block_ptr = *block_link_ptr;
+    }
+
+    /* Return the number of free blocks.  */
+    if (free_blocks != UX_NULL)
+        *free_blocks = count;
+
+    /* Return the size of the largest free block.  */
+    return(largest);
+}
+#endif
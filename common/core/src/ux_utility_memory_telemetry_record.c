@@ -0,0 +1,157 @@
+/***************************************************************************
+ * Copyright (c) 2024 Microsoft Corporation
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the MIT License which is available at
+ * https://opensource.org/licenses/MIT.
+ *
+ * SPDX-License-Identifier: MIT
+ **************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** USBX Component                                                        */
+/**                                                                       */
+/**   Utility                                                             */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+
+/* Include necessary system files.  */
+
+#define UX_SOURCE_CODE
+
+#include "ux_api.h"
+
+
+#ifdef UX_ENABLE_MEMORY_TELEMETRY
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_utility_memory_telemetry_record                 PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function logs an allocation in the telemetry of a byte pool:   */
+/*    the latency, the fragments watermark and the allocation site.       */
+/*                                                                        */
+/*    Counters are updated with interrupts locked out, so allocations     */
+/*    served by slab caches are counted without pool mutex. Sites are     */
+/*    logged under pool mutex. On failure it's called with pool mutex on, */
+/*    the largest free block is checked.                                  */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    pool_ptr                          Pointer to pool control block     */
+/*    site_id                           Allocation site                   */
+/*    memory_size                       Number of bytes requested         */
+/*    start_time                        Time the allocation started       */
+/*    status                            Allocation status                 */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _ux_utility_memory_telemetry_histogram_add                          */
+/*                                          Log value in histogram        */
+/*    _ux_utility_memory_telemetry_largest_free_get                       */
+/*                                          Get largest free block        */
+/*    _ux_utility_mutex_on                  Start pool protection         */
+/*    _ux_utility_mutex_off                 End pool protection           */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    _ux_utility_memory_allocate           Allocate memory               */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Mohamed ayed             Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+VOID  _ux_utility_memory_telemetry_record(UX_MEMORY_BYTE_POOL *pool_ptr, ALIGN_TYPE site_id,
+                                          ULONG memory_size, ULONG start_time, UINT status)
+{
+
+UX_INTERRUPT_SAVE_AREA
+UX_MEMORY_TELEMETRY         *telemetry;
+UX_MEMORY_TELEMETRY_SITE    *site_ptr;
+ULONG                       latency;
+ULONG                       largest = 0;
+UINT                        index;
+
+
+    /* Get the latency of the allocation.  */
+    latency = (ULONG)_ux_utility_time_elapsed(start_time, UX_MEMORY_TELEMETRY_TIME_GET());
+
+    /* On failure, check how large the pool can still serve.  */
+    if (status != UX_SUCCESS)
+        largest = _ux_utility_memory_telemetry_largest_free_get(pool_ptr, UX_NULL);
+
+    telemetry = &pool_ptr -> ux_byte_pool_telemetry;
+
+    UX_DISABLE
+
+    /* Log allocation latency and result.  */
+    _ux_utility_memory_telemetry_histogram_add(&telemetry -> ux_memory_telemetry_latency, latency);
+    if (status == UX_SUCCESS)
+        telemetry -> ux_memory_telemetry_alloc_count ++;
+    else
+    {
+        telemetry -> ux_memory_telemetry_fail_count ++;
+        telemetry -> ux_memory_telemetry_largest_free = largest;
+        if (telemetry -> ux_memory_telemetry_largest_free_min > largest)
+            telemetry -> ux_memory_telemetry_largest_free_min = largest;
+    }
+
+    /* Log max fragments.  */
+    if (telemetry -> ux_memory_telemetry_fragments_max < pool_ptr -> ux_byte_pool_fragments)
+        telemetry -> ux_memory_telemetry_fragments_max = pool_ptr -> ux_byte_pool_fragments;
+
+    UX_RESTORE
+
+    /* Sites are logged under the pool mutex, so the lockout does not grow with the
+       number of sites. The mutex is already held on the pool allocation paths.  */
+    _ux_system_mutex_on(&pool_ptr -> ux_byte_pool_mutex);
+
+    /* Find the entry of the site or an unused one, the last entry is shared.  */
+    for (index = 0; index < (UX_MEMORY_TELEMETRY_SITE_NUM - 1); index ++)
+    {
+        site_ptr = &telemetry -> ux_memory_telemetry_sites[index];
+        if (site_ptr -> ux_memory_telemetry_site_id == site_id)
+            break;
+        if ((site_ptr -> ux_memory_telemetry_site_alloc_count == 0) &&
+            (site_ptr -> ux_memory_telemetry_site_fail_count == 0))
+            break;
+    }
+    site_ptr = &telemetry -> ux_memory_telemetry_sites[index];
+    if ((site_ptr -> ux_memory_telemetry_site_alloc_count == 0) &&
+        (site_ptr -> ux_memory_telemetry_site_fail_count == 0))
+        site_ptr -> ux_memory_telemetry_site_id = site_id;
+
+    /* Log the allocation of the site.  */
+    if (status == UX_SUCCESS)
+    {
+        site_ptr -> ux_memory_telemetry_site_alloc_count ++;
+        site_ptr -> ux_memory_telemetry_site_alloc_total += memory_size;
+    }
+    else
+        site_ptr -> ux_memory_telemetry_site_fail_count ++;
+    if (site_ptr -> ux_memory_telemetry_site_alloc_max < memory_size)
+        site_ptr -> ux_memory_telemetry_site_alloc_max = memory_size;
+
+    /* Release the protection.  */
+    _ux_system_mutex_off(&pool_ptr -> ux_byte_pool_mutex);
+}
+#endif
@@ -0,0 +1,107 @@
+/***************************************************************************
+ * Copyright (c) 2024 Microsoft Corporation
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the MIT License which is available at
+ * https://opensource.org/licenses/MIT.
+ *
+ * SPDX-License-Identifier: MIT
+ **************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** USBX Component                                                        */
+/**                                                                       */
+/**   Utility                                                             */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+
+/* Include necessary system files.  */
+
+#define UX_SOURCE_CODE
+
+#include "ux_api.h"
+
+
+#if defined(UX_ENABLE_MEMORY_TLSF) && !defined(_ux_utility_memory_tlsf_fls)
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_utility_memory_tlsf_fls                         PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function finds the most significant bit set in a value (find   */
+/*    last set), used to map block sizes to TLSF free lists.              */
+/*                                                                        */
+/*    It could be replaced by port optimized version (e.g., count         */
+/*    leading zeros instruction), by defining the function name as macro  */
+/*    in ux_port.h or ux_user.h.                                          */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    value                             Value to check, must not be 0     */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    UINT                              Index of most significant bit     */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    _ux_utility_memory_tlsf_mapping   Map size to free list             */
+/*    _ux_utility_memory_tlsf_search    Search free block                 */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Mohamed ayed             Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+UINT  _ux_utility_memory_tlsf_fls(ULONG value)
+{
+
+UINT            bit = 0;
+
+
+    /* Binary search of the most significant bit in 32 bits.  */
+    if (value & 0xFFFF0000ul)
+    {
+        value >>= 16;
+        bit += 16;
+    }
+    if (value & 0xFF00ul)
+    {
+        value >>= 8;
+        bit += 8;
+    }
+    if (value & 0xF0ul)
+    {
+        value >>= 4;
+        bit += 4;
+    }
+    if (value & 0xCul)
+    {
+        value >>= 2;
+        bit += 2;
+    }
+    if (value & 0x2ul)
+        bit += 1;
+
+    /* Return the bit index.  */
+    return(bit);
+}
+#endif
@@ -0,0 +1,128 @@
+/***************************************************************************
+ * Copyright (c) 2024 Microsoft Corporation
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the MIT License which is available at
+ * https://opensource.org/licenses/MIT.
+ *
+ * SPDX-License-Identifier: MIT
+ **************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** USBX Component                                                        */
+/**                                                                       */
+/**   Utility                                                             */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+
+/* Include necessary system files.  */
+
+#define UX_SOURCE_CODE
+
+#include "ux_api.h"
+
+
+#ifdef UX_ENABLE_MEMORY_TLSF
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_utility_memory_tlsf_free                        PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function releases an allocated block to the pool. The block    */
+/*    is merged with its free physical neighbors immediately and the      */
+/*    result is inserted to TLSF free lists, so free takes bounded time   */
+/*    and the pool is never left with adjacent free blocks.               */
+/*                                                                        */
+/*    It's called with memory protection on.                              */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    pool_ptr                          Pointer to pool control block     */
+/*    block_ptr                         Pointer to block (header)         */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _ux_utility_memory_tlsf_insert    Insert free block                 */
+/*    _ux_utility_memory_tlsf_remove    Remove free block                 */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    _ux_utility_memory_free           Free memory                       */
+/*    _ux_utility_memory_slab_flush     Release slab cache                */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Mohamed ayed             Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+VOID  _ux_utility_memory_tlsf_free(UX_MEMORY_BYTE_POOL *pool_ptr, UCHAR *block_ptr)
+{
+
+UCHAR           *next_ptr;
+UCHAR           *prev_ptr;
+UCHAR           **block_link_ptr;
+UCHAR           **next_link_ptr;
+ALIGN_TYPE      *free_ptr;
+
+
+    /* Release the block.  */
+    free_ptr =        UX_UCHAR_TO_ALIGN_TYPE_POINTER_CONVERT(UX_UCHAR_POINTER_ADD(block_ptr, sizeof(UCHAR *)));
+    *free_ptr =       UX_BYTE_BLOCK_FREE;
+    block_link_ptr =  UX_UCHAR_TO_INDIRECT_UCHAR_POINTER_CONVERT(block_ptr);
+    next_ptr =        *block_link_ptr;
+    pool_ptr -> ux_byte_pool_available += UX_UCHAR_POINTER_DIF(next_ptr, block_ptr);
+
+    /* Merge with next block if it's free.  */
+    free_ptr =  UX_UCHAR_TO_ALIGN_TYPE_POINTER_CONVERT(UX_UCHAR_POINTER_ADD(next_ptr, sizeof(UCHAR *)));
+    if (*free_ptr == UX_BYTE_BLOCK_FREE)
+    {
+        _ux_utility_memory_tlsf_remove(pool_ptr, next_ptr);
+        next_link_ptr =   UX_UCHAR_TO_INDIRECT_UCHAR_POINTER_CONVERT(next_ptr);
+        *block_link_ptr = *next_link_ptr;
+        pool_ptr -> ux_byte_pool_fragments --;
+    }
+
+    /* Merge with previous block if it's free.  */
+    block_link_ptr =  UX_UCHAR_TO_INDIRECT_UCHAR_POINTER_CONVERT(UX_UCHAR_POINTER_ADD(block_ptr, UX_MEMORY_BLOCK_PREV_OFFSET));
+    prev_ptr =        *block_link_ptr;
+    if (prev_ptr != UX_NULL)
+    {
+        free_ptr =  UX_UCHAR_TO_ALIGN_TYPE_POINTER_CONVERT(UX_UCHAR_POINTER_ADD(prev_ptr, sizeof(UCHAR *)));
+        if (*free_ptr == UX_BYTE_BLOCK_FREE)
+        {
+            _ux_utility_memory_tlsf_remove(pool_ptr, prev_ptr);
+            block_link_ptr =  UX_UCHAR_TO_INDIRECT_UCHAR_POINTER_CONVERT(block_ptr);
+            next_link_ptr =   UX_UCHAR_TO_INDIRECT_UCHAR_POINTER_CONVERT(prev_ptr);
+            *next_link_ptr =  *block_link_ptr;
+            pool_ptr -> ux_byte_pool_fragments --;
+            block_ptr = prev_ptr;
+        }
+    }
+
+    /* Merged block is previous block of the block after it.  */
+    block_link_ptr =  UX_UCHAR_TO_INDIRECT_UCHAR_POINTER_CONVERT(block_ptr);
+    next_link_ptr =   UX_UCHAR_TO_INDIRECT_UCHAR_POINTER_CONVERT(UX_UCHAR_POINTER_ADD(*block_link_ptr, UX_MEMORY_BLOCK_PREV_OFFSET));
+    *next_link_ptr =  block_ptr;
+
+    /* List the free block.  */
+    _ux_utility_memory_tlsf_insert(pool_ptr, block_ptr);
+}
+#endif
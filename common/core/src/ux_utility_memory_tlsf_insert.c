@@ -0,0 +1,117 @@
+/***************************************************************************
+ * Copyright (c) 2024 Microsoft Corporation
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the MIT License which is available at
+ * https://opensource.org/licenses/MIT.
+ *
+ * SPDX-License-Identifier: MIT
+ **************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** USBX Component                                                        */
+/**                                                                       */
+/**   Utility                                                             */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+
+/* Include necessary system files.  */
+
+#define UX_SOURCE_CODE
+
+#include "ux_api.h"
+
+
+#ifdef UX_ENABLE_MEMORY_TLSF
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_utility_memory_tlsf_insert                      PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function inserts a free block to the head of its TLSF free     */
+/*    list and marks the list as not empty in first and second level      */
+/*    bitmaps.                                                            */
+/*                                                                        */
+/*    Blocks whose memory buffer can not keep the free list links are     */
+/*    not listed, they are merged when their neighbors are freed.         */
+/*                                                                        */
+/*    It's called with memory protection on.                              */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    pool_ptr                          Pointer to pool control block     */
+/*    block_ptr                         Pointer to free block             */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _ux_utility_memory_tlsf_mapping   Map size to free list             */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    _ux_utility_memory_byte_pool_create                                 */
+/*                                      Create byte pool                  */
+/*    _ux_utility_memory_tlsf_free      Free block                        */
+/*    _ux_utility_memory_tlsf_split     Split block                       */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Mohamed ayed             Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+VOID  _ux_utility_memory_tlsf_insert(UX_MEMORY_BYTE_POOL *pool_ptr, UCHAR *block_ptr)
+{
+
+UCHAR           **block_link_ptr;
+UCHAR           **free_link_ptr;
+UCHAR           *head_ptr;
+ULONG           memory_size;
+UINT            fl;
+UINT            sl;
+
+
+    /* Get the memory buffer size.  */
+    block_link_ptr =  UX_UCHAR_TO_INDIRECT_UCHAR_POINTER_CONVERT(block_ptr);
+    memory_size =     UX_UCHAR_POINTER_DIF(*block_link_ptr, block_ptr) - UX_MEMORY_BLOCK_HEADER_SIZE;
+
+    /* Too small to be listed.  */
+    if (memory_size < UX_MEMORY_TLSF_BLOCK_MIN)
+        return;
+
+    /* Find the list.  */
+    _ux_utility_memory_tlsf_mapping(memory_size, UX_FALSE, &fl, &sl);
+
+    /* Link the block as list head, links are next and previous free blocks.  */
+    head_ptr =          pool_ptr -> ux_byte_pool_tlsf_free[fl][sl];
+    free_link_ptr =     UX_UCHAR_TO_INDIRECT_UCHAR_POINTER_CONVERT(UX_UCHAR_POINTER_ADD(block_ptr, UX_MEMORY_BLOCK_HEADER_SIZE));
+    free_link_ptr[0] =  head_ptr;
+    free_link_ptr[1] =  UX_NULL;
+    if (head_ptr != UX_NULL)
+    {
+        free_link_ptr =     UX_UCHAR_TO_INDIRECT_UCHAR_POINTER_CONVERT(UX_UCHAR_POINTER_ADD(head_ptr, UX_MEMORY_BLOCK_HEADER_SIZE));
+        free_link_ptr[1] =  block_ptr;
+    }
+    pool_ptr -> ux_byte_pool_tlsf_free[fl][sl] = block_ptr;
+
+    /* Mark the list as not empty.  */
+    pool_ptr -> ux_byte_pool_tlsf_fl_bitmap |= (1ul << fl);
+    pool_ptr -> ux_byte_pool_tlsf_sl_bitmap[fl] |= (1ul << sl);
+}
+#endif
@@ -0,0 +1,126 @@
+/***************************************************************************
+ * Copyright (c) 2024 Microsoft Corporation
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the MIT License which is available at
+ * https://opensource.org/licenses/MIT.
+ *
+ * SPDX-License-Identifier: MIT
+ **************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** USBX Component                                                        */
+/**                                                                       */
+/**   Utility                                                             */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+
+/* Include necessary system files.  */
+
+#define UX_SOURCE_CODE
+
+#include "ux_api.h"
+
+
+#ifdef UX_ENABLE_MEMORY_TLSF
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_utility_memory_tlsf_mapping                     PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function maps a memory buffer size to TLSF first level and     */
+/*    second level free list indexes.                                     */
+/*                                                                        */
+/*    If round up is requested, the size is rounded up to the next list,  */
+/*    so any block in the mapped list and the following lists is large    */
+/*    enough for the size. It's used when searching for free block.       */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    memory_size                       Memory buffer size                */
+/*    round_up                          Round up to next list             */
+/*    fl_index                          Pointer to first level index      */
+/*    sl_index                          Pointer to second level index     */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _ux_utility_memory_tlsf_fls       Find last set bit                 */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    _ux_utility_memory_tlsf_insert    Insert free block                 */
+/*    _ux_utility_memory_tlsf_remove    Remove free block                 */
+/*    _ux_utility_memory_tlsf_search    Search free block                 */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Mohamed ayed             Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+VOID  _ux_utility_memory_tlsf_mapping(ULONG memory_size, UINT round_up, UINT *fl_index, UINT *sl_index)
+{
+
+UINT            fl;
+UINT            sl;
+
+
+    /* Small blocks are in first level 0, by steps of 8 bytes.  */
+    if (memory_size < (1ul << UX_MEMORY_TLSF_FL_SHIFT))
+    {
+
+        /* Round up the size to the next step if required.  */
+        if (round_up)
+            memory_size += (1ul << (UX_MEMORY_TLSF_FL_SHIFT - UX_MEMORY_TLSF_SL_LOG2)) - 1;
+
+        if (memory_size < (1ul << UX_MEMORY_TLSF_FL_SHIFT))
+        {
+            *fl_index = 0;
+            *sl_index = (UINT)(memory_size >> (UX_MEMORY_TLSF_FL_SHIFT - UX_MEMORY_TLSF_SL_LOG2));
+            return;
+        }
+
+        /* Rounded up to first list of first level 1.  */
+        round_up = UX_FALSE;
+    }
+
+    /* Round up the size to the next second level list if required.  */
+    fl = _ux_utility_memory_tlsf_fls(memory_size);
+    if (round_up)
+    {
+        memory_size += (1ul << (fl - UX_MEMORY_TLSF_SL_LOG2)) - 1;
+        fl = _ux_utility_memory_tlsf_fls(memory_size);
+    }
+
+    /* Second level index is from bits following the most significant one.  */
+    sl = (UINT)(memory_size >> (fl - UX_MEMORY_TLSF_SL_LOG2)) - UX_MEMORY_TLSF_SL_COUNT;
+    fl = fl - UX_MEMORY_TLSF_FL_SHIFT + 1;
+
+    /* Large blocks share the last list.  */
+    if (fl >= UX_MEMORY_TLSF_FL_COUNT)
+    {
+        fl = UX_MEMORY_TLSF_FL_COUNT - 1;
+        sl = UX_MEMORY_TLSF_SL_COUNT - 1;
+    }
+
+    *fl_index = fl;
+    *sl_index = sl;
+}
+#endif
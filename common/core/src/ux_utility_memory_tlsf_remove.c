@@ -0,0 +1,119 @@
+/***************************************************************************
+ * Copyright (c) 2024 Microsoft Corporation
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the MIT License which is available at
+ * https://opensource.org/licenses/MIT.
+ *
+ * SPDX-License-Identifier: MIT
+ **************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** USBX Component                                                        */
+/**                                                                       */
+/**   Utility                                                             */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+
+/* Include necessary system files.  */
+
+#define UX_SOURCE_CODE
+
+#include "ux_api.h"
+
+
+#ifdef UX_ENABLE_MEMORY_TLSF
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_utility_memory_tlsf_remove                      PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function removes a free block from its TLSF free list and      */
+/*    updates the first and second level bitmaps if the list becomes      */
+/*    empty.                                                              */
+/*                                                                        */
+/*    It's called with memory protection on.                              */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    pool_ptr                          Pointer to pool control block     */
+/*    block_ptr                         Pointer to free block             */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _ux_utility_memory_tlsf_mapping   Map size to free list             */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    _ux_utility_memory_tlsf_free      Free block                        */
+/*    _ux_utility_memory_tlsf_search    Search free block                 */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Mohamed ayed             Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+VOID  _ux_utility_memory_tlsf_remove(UX_MEMORY_BYTE_POOL *pool_ptr, UCHAR *block_ptr)
+{
+
+UCHAR           **block_link_ptr;
+UCHAR           **free_link_ptr;
+UCHAR           **neighbor_link_ptr;
+ULONG           memory_size;
+UINT            fl;
+UINT            sl;
+
+
+    /* Get the memory buffer size.  */
+    block_link_ptr =  UX_UCHAR_TO_INDIRECT_UCHAR_POINTER_CONVERT(block_ptr);
+    memory_size =     UX_UCHAR_POINTER_DIF(*block_link_ptr, block_ptr) - UX_MEMORY_BLOCK_HEADER_SIZE;
+
+    /* Too small blocks are not listed.  */
+    if (memory_size < UX_MEMORY_TLSF_BLOCK_MIN)
+        return;
+
+    /* Find the list.  */
+    _ux_utility_memory_tlsf_mapping(memory_size, UX_FALSE, &fl, &sl);
+
+    /* Unlink the block.  */
+    free_link_ptr = UX_UCHAR_TO_INDIRECT_UCHAR_POINTER_CONVERT(UX_UCHAR_POINTER_ADD(block_ptr, UX_MEMORY_BLOCK_HEADER_SIZE));
+    if (free_link_ptr[1] != UX_NULL)
+    {
+        neighbor_link_ptr =     UX_UCHAR_TO_INDIRECT_UCHAR_POINTER_CONVERT(UX_UCHAR_POINTER_ADD(free_link_ptr[1], UX_MEMORY_BLOCK_HEADER_SIZE));
+        neighbor_link_ptr[0] =  free_link_ptr[0];
+    }
+    else
+        pool_ptr -> ux_byte_pool_tlsf_free[fl][sl] = free_link_ptr[0];
+    if (free_link_ptr[0] != UX_NULL)
+    {
+        neighbor_link_ptr =     UX_UCHAR_TO_INDIRECT_UCHAR_POINTER_CONVERT(UX_UCHAR_POINTER_ADD(free_link_ptr[0], UX_MEMORY_BLOCK_HEADER_SIZE));
+        neighbor_link_ptr[1] =  free_link_ptr[1];
+    }
+
+    /* Mark the list as empty if it's the last block.  */
+    if (pool_ptr -> ux_byte_pool_tlsf_free[fl][sl] == UX_NULL)
+    {
+        pool_ptr -> ux_byte_pool_tlsf_sl_bitmap[fl] &= ~(1ul << sl);
+        if (pool_ptr -> ux_byte_pool_tlsf_sl_bitmap[fl] == 0)
+            pool_ptr -> ux_byte_pool_tlsf_fl_bitmap &= ~(1ul << fl);
+    }
+}
+#endif
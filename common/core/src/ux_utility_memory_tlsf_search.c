@@ -0,0 +1,151 @@
+/***************************************************************************
+ * Copyright (c) 2024 Microsoft Corporation
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the MIT License which is available at
+ * https://opensource.org/licenses/MIT.
+ *
+ * SPDX-License-Identifier: MIT
+ **************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** USBX Component                                                        */
+/**                                                                       */
+/**   Utility                                                             */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+
+/* Include necessary system files.  */
+
+#define UX_SOURCE_CODE
+
+#include "ux_api.h"
+
+
+#ifdef UX_ENABLE_MEMORY_TLSF
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_utility_memory_tlsf_search                      PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function searches TLSF free lists for a memory block to        */
+/*    satisfy the requested number of bytes, in bounded time regardless   */
+/*    of pool fragmentation. The block found is removed from free lists   */
+/*    and returned as a free block, to be split and marked as allocated   */
+/*    by the caller.                                                      */
+/*                                                                        */
+/*    The size is rounded up to the next free list so the head of first   */
+/*    non empty list found by bitmaps is large enough. If there is no     */
+/*    such list, the head of the list of the size itself is a good fit.   */
+/*    Only the head of one list is checked, a block of the list of the    */
+/*    size or of the last list may be too small and then no block is      */
+/*    returned, even if another block in the list would fit.              */
+/*                                                                        */
+/*    It's used as _ux_utility_memory_byte_pool_search if TLSF is         */
+/*    enabled.                                                            */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    pool_ptr                          Pointer to pool control block     */
+/*    memory_size                       Number of bytes required          */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    UCHAR *                           Pointer to the free block, if     */
+/*                                        successful. Otherwise, a NULL   */
+/*                                        is returned                     */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _ux_utility_memory_tlsf_fls       Find last set bit                 */
+/*    _ux_utility_memory_tlsf_mapping   Map size to free list             */
+/*    _ux_utility_memory_tlsf_remove    Remove free block                 */
+/*    _ux_utility_memory_telemetry_histogram_add                          */
+/*                                      Log walk length                   */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    _ux_utility_memory_allocate       Allocate memory                   */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Mohamed ayed             Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+UCHAR  *_ux_utility_memory_tlsf_search(UX_MEMORY_BYTE_POOL *pool_ptr, ULONG memory_size)
+{
+
+UCHAR           *block_ptr;
+UCHAR           **block_link_ptr;
+ULONG           fl_map;
+ULONG           sl_map;
+UINT            fl;
+UINT            sl;
+
+
+    /* First, determine if there are enough bytes in the pool.  */
+    if (memory_size >= pool_ptr -> ux_byte_pool_available)
+        return(UX_NULL);
+
+    /* Only listed blocks are searched.  */
+    if (memory_size < UX_MEMORY_TLSF_BLOCK_MIN)
+        memory_size = UX_MEMORY_TLSF_BLOCK_MIN;
+
+    /* Find the first non empty list of blocks large enough.  */
+    _ux_utility_memory_tlsf_mapping(memory_size, UX_TRUE, &fl, &sl);
+    sl_map = pool_ptr -> ux_byte_pool_tlsf_sl_bitmap[fl] & (~0ul << sl);
+    if (sl_map == 0)
+    {
+        fl_map = pool_ptr -> ux_byte_pool_tlsf_fl_bitmap & (~0ul << (fl + 1));
+        if (fl_map != 0)
+        {
+            fl = _ux_utility_memory_tlsf_fls(fl_map & (~fl_map + 1));
+            sl_map = pool_ptr -> ux_byte_pool_tlsf_sl_bitmap[fl];
+        }
+        else
+        {
+
+            /* No larger list, the head of the list of the size may fit.  */
+            _ux_utility_memory_tlsf_mapping(memory_size, UX_FALSE, &fl, &sl);
+            sl_map = pool_ptr -> ux_byte_pool_tlsf_sl_bitmap[fl] & (1ul << sl);
+            if (sl_map == 0)
+                return(UX_NULL);
+        }
+    }
+    sl = _ux_utility_memory_tlsf_fls(sl_map & (~sl_map + 1));
+
+    /* Only the head of the list is checked.  */
+    block_ptr = pool_ptr -> ux_byte_pool_tlsf_free[fl][sl];
+
+#ifdef UX_ENABLE_MEMORY_TELEMETRY
+
+    /* Log the number of blocks walked through.  */
+    _ux_utility_memory_telemetry_histogram_add(&pool_ptr -> ux_byte_pool_telemetry.ux_memory_telemetry_walk, 1);
+#endif
+
+    /* The list of the size and the last list may hold smaller blocks.  */
+    block_link_ptr = UX_UCHAR_TO_INDIRECT_UCHAR_POINTER_CONVERT(block_ptr);
+    if ((UX_UCHAR_POINTER_DIF(*block_link_ptr, block_ptr) - UX_MEMORY_BLOCK_HEADER_SIZE) < memory_size)
+        return(UX_NULL);
+
+    /* Take the block out of free lists.  */
+    _ux_utility_memory_tlsf_remove(pool_ptr, block_ptr);
+
+    /* Return the free block.  */
+    return(block_ptr);
+}
+#endif
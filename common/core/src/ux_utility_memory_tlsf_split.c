@@ -0,0 +1,97 @@
+/***************************************************************************
+ * Copyright (c) 2024 Microsoft Corporation
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the MIT License which is available at
+ * https://opensource.org/licenses/MIT.
+ *
+ * SPDX-License-Identifier: MIT
+ **************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** USBX Component                                                        */
+/**                                                                       */
+/**   Utility                                                             */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+
+/* Include necessary system files.  */
+
+#define UX_SOURCE_CODE
+
+#include "ux_api.h"
+
+
+#ifdef UX_ENABLE_MEMORY_TLSF
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_utility_memory_tlsf_split                       PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function completes the split of a block into two blocks, by    */
+/*    linking the new second block to its physical neighbors and          */
+/*    inserting the free part to TLSF free lists.                         */
+/*                                                                        */
+/*    It's called with memory protection on.                              */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    pool_ptr                          Pointer to pool control block     */
+/*    block_ptr                         Pointer to first block of         */
+/*                                        split                           */
+/*    free_block_ptr                    Pointer to the free block of      */
+/*                                        split                           */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _ux_utility_memory_tlsf_insert    Insert free block                 */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    _ux_utility_memory_allocate       Allocate memory                   */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Mohamed ayed             Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+VOID  _ux_utility_memory_tlsf_split(UX_MEMORY_BYTE_POOL *pool_ptr, UCHAR *block_ptr, UCHAR *free_block_ptr)
+{
+
+UCHAR           *next_ptr;
+UCHAR           **block_link_ptr;
+
+
+    /* Second block is previous block of the block after it.  */
+    block_link_ptr =  UX_UCHAR_TO_INDIRECT_UCHAR_POINTER_CONVERT(block_ptr);
+    next_ptr =        *block_link_ptr;
+    block_link_ptr =  UX_UCHAR_TO_INDIRECT_UCHAR_POINTER_CONVERT(next_ptr);
+    block_link_ptr =  UX_UCHAR_TO_INDIRECT_UCHAR_POINTER_CONVERT(UX_UCHAR_POINTER_ADD(*block_link_ptr, UX_MEMORY_BLOCK_PREV_OFFSET));
+    *block_link_ptr = next_ptr;
+
+    /* First block is previous block of the second.  */
+    block_link_ptr =  UX_UCHAR_TO_INDIRECT_UCHAR_POINTER_CONVERT(UX_UCHAR_POINTER_ADD(next_ptr, UX_MEMORY_BLOCK_PREV_OFFSET));
+    *block_link_ptr = block_ptr;
+
+    /* List the free part.  */
+    _ux_utility_memory_tlsf_insert(pool_ptr, free_block_ptr);
+}
+#endif
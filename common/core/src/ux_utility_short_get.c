@@ -27,6 +27,7 @@
 #include "ux_api.h"
 
 
+#if !defined(_ux_utility_short_get)
 /**************************************************************************/ 
 /*                                                                        */ 
 /*  FUNCTION                                               RELEASE        */ 
@@ -64,6 +65,10 @@
 /*  05-19-2020     Chaoqiong Xiao           Initial Version 6.0           */
 /*  09-30-2020     Chaoqiong Xiao           Modified comment(s),          */
 /*                                            resulting in version 6.1    */
+/*  xx-xx-xxxx     Mohamed ayed             Modified comment(s),          */
+/*                                            allowed inline or port      */
+/*                                            override,                   */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 ULONG  _ux_utility_short_get(UCHAR * address)
@@ -80,4 +85,4 @@ USHORT   value;
     /* Return to caller.  */
     return((ULONG) value);
 }
-
+#endif
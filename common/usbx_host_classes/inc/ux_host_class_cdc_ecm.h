@@ -62,6 +62,10 @@
 /*  10-31-2023     Chaoqiong Xiao           Modified comment(s),          */
 /*                                            optimized USB descriptors,  */
 /*                                            resulting in version 6.3.0  */
+/*  xx-xx-xxxx     Mohamed ayed             Modified comment(s),          */
+/*                                            added transmit of packet    */
+/*                                            chains as transfer segments,*/
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 
@@ -155,6 +159,14 @@ extern   "C" {
 #define UX_HOST_CLASS_CDC_ECM_PACKET_CHAIN_SUPPORT
 #endif
 
+/* Define the maximum number of packets in a chain sent as transfer segments.
+   Longer chains are copied to the transmit buffer.  */
+#if defined(UX_HOST_CLASS_CDC_ECM_PACKET_CHAIN_SUPPORT) && defined(UX_TRANSFER_SEGMENTS_ENABLE)
+#ifndef UX_HOST_CLASS_CDC_ECM_XMIT_SEGMENTS
+#define UX_HOST_CLASS_CDC_ECM_XMIT_SEGMENTS                    8
+#endif
+#endif
+
 #define UX_HOST_CLASS_CDC_ECM_ETHERNET_SIZE                    14
                                                                 
 #define UX_HOST_CLASS_CDC_ECM_DEVICE_INIT_DELAY                (1 * UX_PERIODIC_RATE)
@@ -297,6 +309,10 @@ typedef struct UX_HOST_CLASS_CDC_ECM_STRUCT
     UCHAR           *ux_host_class_cdc_ecm_xmit_buffer;
     UCHAR           *ux_host_class_cdc_ecm_receive_buffer;
 #endif
+#if defined(UX_HOST_CLASS_CDC_ECM_PACKET_CHAIN_SUPPORT) && defined(UX_TRANSFER_SEGMENTS_ENABLE)
+    UX_TRANSFER_SEGMENT
+                    ux_host_class_cdc_ecm_xmit_segments[UX_HOST_CLASS_CDC_ECM_XMIT_SEGMENTS];
+#endif
 
     UCHAR           ux_host_class_cdc_ecm_node_id[UX_HOST_CLASS_CDC_ECM_NODE_ID_LENGTH];
     VOID            (*ux_host_class_cdc_ecm_device_status_change_callback)(struct UX_HOST_CLASS_CDC_ECM_STRUCT *cdc_ecm, 
@@ -335,6 +351,7 @@ VOID  _ux_host_class_cdc_ecm_interrupt_notification(UX_TRANSFER *transfer_reques
 VOID  _ux_host_class_cdc_ecm_thread(ULONG parameter);
 VOID  _ux_host_class_cdc_ecm_transmission_callback(UX_TRANSFER *transfer_request);
 VOID  _ux_host_class_cdc_ecm_transmit_queue_clean(UX_HOST_CLASS_CDC_ECM *cdc_ecm_control);
+UINT  _ux_host_class_cdc_ecm_transmit_segments_set(UX_HOST_CLASS_CDC_ECM *cdc_ecm, UX_TRANSFER *transfer_request, NX_PACKET *packet);
 UINT  _ux_host_class_cdc_ecm_mac_address_get(UX_HOST_CLASS_CDC_ECM *cdc_ecm);
                                     
 /* Define CDC ECM Class API prototypes.  */
@@ -25,7 +25,7 @@
 /*  COMPONENT DEFINITION                                   RELEASE        */ 
 /*                                                                        */ 
 /*    ux_host_class_hub.h                                 PORTABLE C      */ 
-/*                                                           6.3.0        */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -52,6 +52,9 @@
 /*  10-31-2023     Chaoqiong Xiao           Modified comment(s),          */
 /*                                            optimized USB descriptors,  */
 /*                                            resulting in version 6.3.0  */
+/*  xx-xx-xxxx     Mohamed ayed             Modified comment(s),          */
+/*                                            retried parallel enum,      */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 
@@ -222,6 +225,10 @@ typedef struct UX_HOST_CLASS_HUB_STRUCT
     UINT            ux_host_class_hub_port_state;
     UINT            ux_host_class_hub_port_power;
 
+#if defined(UX_HOST_ENUM_PARALLEL_ENABLE)
+    UINT            ux_host_class_hub_enum_retry;
+#endif
+
 #if defined(UX_HOST_STANDALONE)
     UINT            ux_host_class_hub_run_status;
     UCHAR           *ux_host_class_hub_allocated;
@@ -245,6 +252,7 @@ typedef struct UX_HOST_CLASS_HUB_STRUCT
 
 UINT    _ux_host_class_hub_activate(UX_HOST_CLASS_COMMAND *command);
 VOID    _ux_host_class_hub_change_detect(VOID);
+UINT    _ux_host_class_hub_device_enum_retry(UX_DEVICE *device);
 UINT    _ux_host_class_hub_change_process(UX_HOST_CLASS_HUB *hub);
 UINT    _ux_host_class_hub_configure(UX_HOST_CLASS_HUB *hub);
 UINT    _ux_host_class_hub_deactivate(UX_HOST_CLASS_COMMAND *command);
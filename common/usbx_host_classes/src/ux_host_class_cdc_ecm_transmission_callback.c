@@ -55,6 +55,8 @@
 /*                                                                        */ 
 /*  CALLS                                                                 */ 
 /*                                                                        */ 
+/*    _ux_host_class_cdc_ecm_transmit_segments_set                        */
+/*                                          Set transfer segments         */
 /*    _ux_host_stack_transfer_request       Process transfer request      */ 
 /*    nx_packet_transmit_release            Release NetX packet           */
 /*                                                                        */ 
@@ -82,6 +84,10 @@
 /*  10-31-2022     Chaoqiong Xiao           Modified comment(s),          */
 /*                                            supported NX packet chain,  */
 /*                                            resulting in version 6.2.0  */
+/*  xx-xx-xxxx     Mohamed ayed             Modified comment(s),          */
+/*                                            sent packet chains as       */
+/*                                            transfer segments,          */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 VOID  _ux_host_class_cdc_ecm_transmission_callback(UX_TRANSFER *transfer_request)
@@ -137,6 +143,9 @@ ULONG                           copied;
 
             /* Set transfer request length to zero.  */
             transfer_request -> ux_transfer_request_requested_length =  0;
+#if defined(UX_HOST_CLASS_CDC_ECM_PACKET_CHAIN_SUPPORT) && defined(UX_TRANSFER_SEGMENTS_ENABLE)
+            transfer_request -> ux_transfer_request_segment_count =  0;
+#endif
 
             /* Send the transfer.  */
             _ux_host_stack_transfer_request(transfer_request);
@@ -157,6 +166,13 @@ ULONG                           copied;
 
 #ifdef UX_HOST_CLASS_CDC_ECM_PACKET_CHAIN_SUPPORT
 
+#if defined(UX_TRANSFER_SEGMENTS_ENABLE)
+
+            /* Send the chain as transfer segments if possible, without copy.  */
+            if (_ux_host_class_cdc_ecm_transmit_segments_set(cdc_ecm, transfer_request, next_packet) == UX_SUCCESS)
+                packet_header =  next_packet -> nx_packet_prepend_ptr;
+            else
+#endif
             if (next_packet -> nx_packet_next != UX_NULL)
             {
 
@@ -0,0 +1,134 @@
+/***************************************************************************
+ * Copyright (c) 2024 Microsoft Corporation 
+ * 
+ * This program and the accompanying materials are made available under the
+ * terms of the MIT License which is available at
+ * https://opensource.org/licenses/MIT.
+ * 
+ * SPDX-License-Identifier: MIT
+ **************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */ 
+/** USBX Component                                                        */ 
+/**                                                                       */
+/**   CDC_ECM Class                                                       */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+
+/* Include necessary system files.  */
+
+#define UX_SOURCE_CODE
+
+#include "ux_api.h"
+#include "ux_host_class_cdc_ecm.h"
+#include "ux_host_stack.h"
+
+
+#if !defined(UX_HOST_STANDALONE) && defined(UX_HOST_CLASS_CDC_ECM_PACKET_CHAIN_SUPPORT) && defined(UX_TRANSFER_SEGMENTS_ENABLE)
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_host_class_cdc_ecm_transmit_segments_set        PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function describes a NetX packet chain as the segments of the  */
+/*    bulk out transfer request, so the chain is sent without copy.       */
+/*                                                                        */
+/*    The chain is only sent as segments if it has no more than           */
+/*    UX_HOST_CLASS_CDC_ECM_XMIT_SEGMENTS packets and the length of each  */
+/*    packet but the last one is a multiple of the endpoint max packet    */
+/*    size, otherwise a short packet would end the transfer on the bus.   */
+/*    In other cases the segments are cleared and an error is returned,   */
+/*    the caller then copies the chain to the transmit buffer.            */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    cdc_ecm                               Pointer to cdc_ecm class      */
+/*    transfer_request                      Pointer to transfer request   */
+/*    packet                                Packet chain to send          */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    Completion Status                                                   */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    _ux_host_class_cdc_ecm_write          Write to CDC ECM              */
+/*    _ux_host_class_cdc_ecm_transmission_callback                        */
+/*                                          Transmission callback         */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Mohamed ayed             Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+UINT  _ux_host_class_cdc_ecm_transmit_segments_set(UX_HOST_CLASS_CDC_ECM *cdc_ecm, UX_TRANSFER *transfer_request, NX_PACKET *packet)
+{
+
+UX_TRANSFER_SEGMENT     *segment;
+NX_PACKET               *current_packet;
+ULONG                   segment_count;
+ULONG                   packet_length;
+
+
+    /* Segments are not used until the chain is known to fit.  */
+    transfer_request -> ux_transfer_request_segment_count =  0;
+
+    /* A single packet is already contiguous.  */
+    if (packet -> nx_packet_next == UX_NULL)
+        return(UX_ERROR);
+
+    /* Describe each packet of the chain by a segment.  */
+    segment =  cdc_ecm -> ux_host_class_cdc_ecm_xmit_segments;
+    segment_count =  0;
+    current_packet =  packet;
+    while (current_packet != UX_NULL)
+    {
+
+        /* Check if there is a segment left for this packet.  */
+        if (segment_count == UX_HOST_CLASS_CDC_ECM_XMIT_SEGMENTS)
+            return(UX_ERROR);
+
+        /* Get the length of data in this packet.  */
+        packet_length =  (ULONG)(current_packet -> nx_packet_append_ptr - current_packet -> nx_packet_prepend_ptr);
+
+        /* All the packets but the last one must end on a packet boundary.  */
+        if ((current_packet -> nx_packet_next != UX_NULL) &&
+            (packet_length % transfer_request -> ux_transfer_request_packet_length) != 0)
+            return(UX_ERROR);
+
+        /* Store the packet data in the segment.  */
+        segment -> ux_transfer_segment_data_pointer =  current_packet -> nx_packet_prepend_ptr;
+        segment -> ux_transfer_segment_length =  packet_length;
+        segment ++;
+        segment_count ++;
+
+        /* Next packet in chain.  */
+        current_packet =  current_packet -> nx_packet_next;
+    }
+
+    /* The chain is sent as segments.  */
+    transfer_request -> ux_transfer_request_segments =  cdc_ecm -> ux_host_class_cdc_ecm_xmit_segments;
+    transfer_request -> ux_transfer_request_segment_count =  segment_count;
+
+    /* Return successful completion.  */
+    return(UX_SUCCESS);
+}
+#endif
@@ -56,6 +56,8 @@
 /*                                                                        */ 
 /*  CALLS                                                                 */ 
 /*                                                                        */ 
+/*    _ux_host_class_cdc_ecm_transmit_segments_set                        */
+/*                                          Set transfer segments         */
 /*    _ux_host_stack_transfer_request       Process transfer request      */ 
 /*    _ux_host_semaphore_put                Release protection semaphore  */ 
 /*    nx_packet_transmit_release            Release NetX packet           */
@@ -83,6 +85,10 @@
 /*  10-31-2022     Chaoqiong Xiao           Modified comment(s),          */
 /*                                            supported NX packet chain,  */
 /*                                            resulting in version 6.2.0  */
+/*  xx-xx-xxxx     Mohamed ayed             Modified comment(s),          */
+/*                                            sent packet chains as       */
+/*                                            transfer segments,          */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_host_class_cdc_ecm_write(VOID *cdc_ecm_class, NX_PACKET *packet)
@@ -185,9 +191,20 @@ ULONG                   copied;
                     }
                 }
 
-                /* Put packet to continuous buffer to transfer.  */
-                packet_header = cdc_ecm -> ux_host_class_cdc_ecm_xmit_buffer;
-                nx_packet_data_extract_offset(packet, 0, packet_header, packet -> nx_packet_length, &copied);
+#if defined(UX_TRANSFER_SEGMENTS_ENABLE)
+
+                /* Send the chain as transfer segments if possible, without copy.
+                   The buffer is still needed for chains queued behind.  */
+                if (_ux_host_class_cdc_ecm_transmit_segments_set(cdc_ecm, transfer_request, packet) == UX_SUCCESS)
+                    packet_header =  packet -> nx_packet_prepend_ptr;
+                else
+#endif
+                {
+
+                    /* Put packet to continuous buffer to transfer.  */
+                    packet_header = cdc_ecm -> ux_host_class_cdc_ecm_xmit_buffer;
+                    nx_packet_data_extract_offset(packet, 0, packet_header, packet -> nx_packet_length, &copied);
+                }
             }
             else
 #endif
@@ -196,6 +213,11 @@ ULONG                   copied;
                 /* Load the address of the current packet header at the physical header.  */
                 packet_header =  packet -> nx_packet_prepend_ptr;
 
+#if defined(UX_HOST_CLASS_CDC_ECM_PACKET_CHAIN_SUPPORT) && defined(UX_TRANSFER_SEGMENTS_ENABLE)
+
+                /* The packet is not sent as segments.  */
+                transfer_request -> ux_transfer_request_segment_count =  0;
+#endif
             }
 
             /* Setup the transaction parameters.  */
@@ -34,7 +34,7 @@
 /*  FUNCTION                                               RELEASE        */ 
 /*                                                                        */ 
 /*    _ux_host_class_hub_activate                         PORTABLE C      */ 
-/*                                                           6.1.12       */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -86,6 +86,9 @@
 /*  07-29-2022     Chaoqiong Xiao           Modified comment(s),          */
 /*                                            added standalone support,   */
 /*                                            resulting in version 6.1.12 */
+/*  xx-xx-xxxx     Mohamed ayed             Modified comment(s),          */
+/*                                            added parallel enum retry,  */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_host_class_hub_activate(UX_HOST_CLASS_COMMAND *command)
@@ -101,6 +104,11 @@ UINT                status;
        one active HUB instance and the function to call when the thread
        is awaken.  */
     _ux_system_host -> ux_system_host_enum_hub_function =  _ux_host_class_hub_change_detect;
+#if defined(UX_HOST_ENUM_PARALLEL_ENABLE)
+
+    /* Devices failing in enumeration worker threads are enumerated again by the HUB.  */
+    _ux_system_host -> ux_system_host_enum_hub_retry_function =  _ux_host_class_hub_device_enum_retry;
+#endif
 #endif
 
     /* The HUB is always activated by the device descriptor and not the
@@ -0,0 +1,113 @@
+/***************************************************************************
+ * Copyright (c) 2024 Microsoft Corporation
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the MIT License which is available at
+ * https://opensource.org/licenses/MIT.
+ *
+ * SPDX-License-Identifier: MIT
+ **************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** USBX Component                                                        */
+/**                                                                       */
+/**   HUB Class                                                           */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+
+/* Include necessary system files.  */
+
+#define UX_SOURCE_CODE
+
+#include "ux_api.h"
+#include "ux_host_class_hub.h"
+#include "ux_host_stack.h"
+
+
+
+#if defined(UX_HOST_ENUM_PARALLEL_ENABLE) && (UX_MAX_DEVICES > 1)
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_host_class_hub_device_enum_retry                PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function enumerates again a device attached to a downstream    */
+/*    port of the HUB, when an enumeration worker thread could not read   */
+/*    its descriptors. The device is removed and the connection on the    */
+/*    port is processed again with the attempts left.                     */
+/*                                                                        */
+/*    It's for RTOS mode with parallel enumeration.                       */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    device                                Pointer to device             */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    Completion Status                                                   */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _ux_host_class_hub_port_change_connection_process                   */
+/*                                          Process connection            */
+/*    _ux_host_stack_device_remove          Remove device                 */
+/*    _ux_utility_delay_ms                  Thread sleep                  */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    USBX Stack                                                          */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Mohamed ayed             Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+UINT  _ux_host_class_hub_device_enum_retry(UX_DEVICE *device)
+{
+
+UX_HOST_CLASS_HUB   *hub;
+UINT                port;
+UINT                retry;
+
+
+    /* Get the HUB instance and the port of the device.  */
+    hub =  (UX_HOST_CLASS_HUB *) UX_DEVICE_PARENT_GET(device) -> ux_device_class_instance;
+    port =  UX_DEVICE_PORT_LOCATION_GET(device);
+
+    /* No retry if the HUB is not live or all attempts are done.  */
+    retry =  device -> ux_device_enum_retry + 1;
+    if ((hub == UX_NULL) ||
+        (hub -> ux_host_class_hub_state != UX_HOST_CLASS_INSTANCE_LIVE) ||
+        (retry >= UX_HOST_CLASS_HUB_ENUMERATION_RETRY))
+        return(UX_DEVICE_ENUMERATION_FAILURE);
+
+    /* Simulate remove to free allocated resources before retry.  */
+    _ux_host_stack_device_remove(UX_DEVICE_HCD_GET(hub -> ux_host_class_hub_device),
+                                 hub -> ux_host_class_hub_device, port);
+    hub -> ux_host_class_hub_port_state &= (UINT)~(1 << port);
+
+    /* Wait for a while.  */
+    _ux_utility_delay_ms(UX_HOST_CLASS_HUB_ENUMERATION_RETRY_DELAY);
+
+    /* The device is still attached, process its connection again.  */
+    hub -> ux_host_class_hub_enum_retry =  retry;
+    _ux_host_class_hub_port_change_connection_process(hub, port, UX_HOST_CLASS_HUB_PORT_STATUS_CONNECTION);
+
+    /* Return successful completion.  */
+    return(UX_SUCCESS);
+}
+#endif
@@ -34,7 +34,7 @@
 /*  FUNCTION                                               RELEASE        */ 
 /*                                                                        */ 
 /*    _ux_host_class_hub_port_change_connection_process   PORTABLE C      */ 
-/*                                                           6.1.12       */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -87,6 +87,10 @@
 /*  07-29-2022     Chaoqiong Xiao           Modified comment(s),          */
 /*                                            added standalone support,   */
 /*                                            resulting in version 6.1.12 */
+/*  xx-xx-xxxx     Mohamed ayed             Modified comment(s),          */
+/*                                            notified in parallel enum,  */
+/*                                            retried worker failures,    */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 VOID  _ux_host_class_hub_port_change_connection_process(UX_HOST_CLASS_HUB *hub, UINT port, UINT port_status)
@@ -138,7 +142,14 @@ USHORT      local_port_change;
         _ux_host_class_hub_feature(hub, port, UX_CLEAR_FEATURE, UX_HOST_CLASS_HUB_C_PORT_CONNECTION);
 
         /* Some devices are known to fail on the first try.  */
-        for (device_enumeration_retry = 0; device_enumeration_retry < UX_HOST_CLASS_HUB_ENUMERATION_RETRY; device_enumeration_retry++)
+        device_enumeration_retry =  0;
+#if defined(UX_HOST_ENUM_PARALLEL_ENABLE)
+
+        /* A device which failed in an enumeration worker goes on with the attempts left.  */
+        device_enumeration_retry =  hub -> ux_host_class_hub_enum_retry;
+        hub -> ux_host_class_hub_enum_retry =  0;
+#endif
+        for (; device_enumeration_retry < UX_HOST_CLASS_HUB_ENUMERATION_RETRY; device_enumeration_retry++)
         {
 
             /* Wait for debounce.  */
@@ -196,11 +207,19 @@ USHORT      local_port_change;
 
                 /* Successful device creation.  */
 
-                /* If the device instance is ready, notify application for unconfigured device.  */
+#if !defined(UX_HOST_ENUM_PARALLEL_ENABLE)
+
+                /* If the device instance is ready, notify application for unconfigured device.
+                   With parallel enumeration it's done when the enumeration ends.  */
                 if (_ux_system_host -> ux_system_host_change_function)
                 {
                     _ux_system_host -> ux_system_host_change_function(UX_DEVICE_CONNECTION, UX_NULL, (VOID*)device);
                 }
+#else
+
+                /* Remember the attempt in case the enumeration worker fails.  */
+                device -> ux_device_enum_retry =  device_enumeration_retry;
+#endif
 
                 /* Just return.  */
                 return;
@@ -34,7 +34,7 @@
 /*  FUNCTION                                               RELEASE        */
 /*                                                                        */
 /*    _ux_host_class_pima_command                         PORTABLE C      */
-/*                                                           6.3.0        */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -80,6 +80,9 @@
 /*                                            resulting in version 6.1.10 */
 /*  10-31-2023     Yajun xia                Modified comment(s),          */
 /*                                            resulting in version 6.3.0  */
+/*  xx-xx-xxxx     Mohamed ayed             Modified comment(s),          */
+/*                                            used field access macros,   */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_host_class_pima_command(UX_HOST_CLASS_PIMA *pima, UX_HOST_CLASS_PIMA_COMMAND *command,
@@ -102,33 +105,34 @@ UINT            status;
     requested_length =  UX_HOST_CLASS_PIMA_COMMAND_HEADER_SIZE + ((ULONG)sizeof(ULONG) * command -> ux_host_class_pima_command_nb_parameters);
 
     /* Fill the command container. First the length of the total header and payload.  */
-    _ux_utility_long_put(ptp_payload + UX_HOST_CLASS_PIMA_COMMAND_HEADER_LENGTH, requested_length);
+    UX_UTILITY_LONG_PUT(ptp_payload + UX_HOST_CLASS_PIMA_COMMAND_HEADER_LENGTH, requested_length);
 
     /* Then the type of container : a command block here.  */
-    _ux_utility_short_put(ptp_payload + UX_HOST_CLASS_PIMA_COMMAND_HEADER_TYPE, UX_HOST_CLASS_PIMA_CT_COMMAND_BLOCK);
+    UX_UTILITY_SHORT_PUT(ptp_payload + UX_HOST_CLASS_PIMA_COMMAND_HEADER_TYPE, UX_HOST_CLASS_PIMA_CT_COMMAND_BLOCK);
 
     /* Now the command code to send.  */
-    _ux_utility_short_put(ptp_payload + UX_HOST_CLASS_PIMA_COMMAND_HEADER_CODE, (USHORT)command -> ux_host_class_pima_command_operation_code);
+    UX_UTILITY_SHORT_PUT(ptp_payload + UX_HOST_CLASS_PIMA_COMMAND_HEADER_CODE, (USHORT)command -> ux_host_class_pima_command_operation_code);
 
     /* Save the operation code.  */
     pima -> ux_host_class_pima_operation_code =  command -> ux_host_class_pima_command_operation_code;
 
     /* Put the transaction ID.  */
-    _ux_utility_long_put(ptp_payload + UX_HOST_CLASS_PIMA_COMMAND_HEADER_TRANSACTION_ID,
-                        pima -> ux_host_class_pima_transaction_id++);
+    UX_UTILITY_LONG_PUT(ptp_payload + UX_HOST_CLASS_PIMA_COMMAND_HEADER_TRANSACTION_ID,
+                        pima -> ux_host_class_pima_transaction_id);
+    pima -> ux_host_class_pima_transaction_id++;
 
     /* Then fill in all the parameters. To make it quick we fill the 5 parameters, regardless
        of the number contained in the command. But when the payload is transmitted, only the
        relevant data is sent over the Bulk Out pipe.  */
-    _ux_utility_long_put(ptp_payload + UX_HOST_CLASS_PIMA_COMMAND_HEADER_PARAMETER_1,
+    UX_UTILITY_LONG_PUT(ptp_payload + UX_HOST_CLASS_PIMA_COMMAND_HEADER_PARAMETER_1,
                         command -> ux_host_class_pima_command_parameter_1);
-    _ux_utility_long_put(ptp_payload + UX_HOST_CLASS_PIMA_COMMAND_HEADER_PARAMETER_2,
+    UX_UTILITY_LONG_PUT(ptp_payload + UX_HOST_CLASS_PIMA_COMMAND_HEADER_PARAMETER_2,
                         command -> ux_host_class_pima_command_parameter_2);
-    _ux_utility_long_put(ptp_payload + UX_HOST_CLASS_PIMA_COMMAND_HEADER_PARAMETER_3,
+    UX_UTILITY_LONG_PUT(ptp_payload + UX_HOST_CLASS_PIMA_COMMAND_HEADER_PARAMETER_3,
                         command -> ux_host_class_pima_command_parameter_3);
-    _ux_utility_long_put(ptp_payload + UX_HOST_CLASS_PIMA_COMMAND_HEADER_PARAMETER_4,
+    UX_UTILITY_LONG_PUT(ptp_payload + UX_HOST_CLASS_PIMA_COMMAND_HEADER_PARAMETER_4,
                         command -> ux_host_class_pima_command_parameter_4);
-    _ux_utility_long_put(ptp_payload + UX_HOST_CLASS_PIMA_COMMAND_HEADER_PARAMETER_5,
+    UX_UTILITY_LONG_PUT(ptp_payload + UX_HOST_CLASS_PIMA_COMMAND_HEADER_PARAMETER_5,
                         command -> ux_host_class_pima_command_parameter_5);
 
     /* Initialize the transfer_request.  */
@@ -273,22 +277,22 @@ UINT            status;
             }
 
             /* Check to ensure this is a Response packet.  */
-            if (_ux_utility_short_get(ptp_payload + UX_HOST_CLASS_PIMA_RESPONSE_HEADER_TYPE) !=
+            if (UX_UTILITY_SHORT_GET(ptp_payload + UX_HOST_CLASS_PIMA_RESPONSE_HEADER_TYPE) !=
                                         UX_HOST_CLASS_PIMA_CT_RESPONSE_BLOCK)
 
                 /* We have a wrong packet.  */
                 return(UX_ERROR);
 
             /* Then get all the response parameters.  */
-            command -> ux_host_class_pima_command_parameter_1 =  _ux_utility_long_get(ptp_payload +
+            command -> ux_host_class_pima_command_parameter_1 =  UX_UTILITY_LONG_GET(ptp_payload +
                                                                  UX_HOST_CLASS_PIMA_RESPONSE_HEADER_PARAMETER_1);
-            command -> ux_host_class_pima_command_parameter_2 =  _ux_utility_long_get(ptp_payload +
+            command -> ux_host_class_pima_command_parameter_2 =  UX_UTILITY_LONG_GET(ptp_payload +
                                                                  UX_HOST_CLASS_PIMA_RESPONSE_HEADER_PARAMETER_2);
-            command -> ux_host_class_pima_command_parameter_3 =  _ux_utility_long_get(ptp_payload +
+            command -> ux_host_class_pima_command_parameter_3 =  UX_UTILITY_LONG_GET(ptp_payload +
                                                                  UX_HOST_CLASS_PIMA_RESPONSE_HEADER_PARAMETER_3);
-            command -> ux_host_class_pima_command_parameter_4 =  _ux_utility_long_get(ptp_payload +
+            command -> ux_host_class_pima_command_parameter_4 =  UX_UTILITY_LONG_GET(ptp_payload +
                                                                  UX_HOST_CLASS_PIMA_RESPONSE_HEADER_PARAMETER_4);
-            command -> ux_host_class_pima_command_parameter_5 =  _ux_utility_long_get(ptp_payload +
+            command -> ux_host_class_pima_command_parameter_5 =  UX_UTILITY_LONG_GET(ptp_payload +
                                                                  UX_HOST_CLASS_PIMA_RESPONSE_HEADER_PARAMETER_5);
 
             /* We are done with the command.  */
@@ -34,7 +34,7 @@
 /*  FUNCTION                                               RELEASE        */
 /*                                                                        */
 /*    _ux_host_class_pima_device_info_get                 PORTABLE C      */
-/*                                                           6.3.0        */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -81,6 +81,10 @@
 /*  10-31-2023     Chaoqiong Xiao           Modified comment(s),          */
 /*                                            fixed compile warnings,     */
 /*                                            resulting in version 6.3.0  */
+/*  xx-xx-xxxx     Mohamed ayed             Modified comment(s),          */
+/*                                            used DMA buffer pool for    */
+/*                                            transfer buffers,           */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_host_class_pima_device_info_get(UX_HOST_CLASS_PIMA *pima,
@@ -111,7 +115,7 @@ UINT                                 status;
     command.ux_host_class_pima_command_operation_code =  UX_HOST_CLASS_PIMA_OC_GET_DEVICE_INFO;
 
     /* Allocate some DMA safe memory for receiving the device info block.  */
-    device_buffer =  _ux_utility_memory_allocate(UX_SAFE_ALIGN, UX_CACHE_SAFE_MEMORY, UX_HOST_CLASS_PIMA_DEVICE_MAX_LENGTH);
+    device_buffer =  UX_MEMORY_DMA_ALLOCATE(UX_MEMORY_DMA_OWNER_HOST_PIMA, UX_HOST_CLASS_PIMA_DEVICE_MAX_LENGTH);
     if (device_buffer == UX_NULL)
         return(UX_MEMORY_INSUFFICIENT);
 
@@ -357,7 +361,7 @@ UINT                                 status;
     }
 
     /* Free the original object info buffer.  */
-    _ux_utility_memory_free(device_buffer);
+    UX_MEMORY_DMA_FREE(device_buffer);
 
     /* Return completion status.  */
     return(status);
@@ -34,7 +34,7 @@
 /*  FUNCTION                                               RELEASE        */
 /*                                                                        */
 /*    _ux_host_class_pima_object_handles_get              PORTABLE C      */
-/*                                                           6.1.12       */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -82,6 +82,10 @@
 /*  07-29-2022     Chaoqiong Xiao           Modified comment(s),          */
 /*                                            improved num objects check, */
 /*                                            resulting in version 6.1.12 */
+/*  xx-xx-xxxx     Mohamed ayed             Modified comment(s),          */
+/*                                            used DMA buffer pool for    */
+/*                                            transfer buffers,           */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_host_class_pima_object_handles_get(UX_HOST_CLASS_PIMA *pima, UX_HOST_CLASS_PIMA_SESSION *pima_session,
@@ -139,7 +143,7 @@ UINT                                 status;
         return(status);
 
     /* Allocate some DMA safe memory for receiving the handles  */
-    object_handles_array_raw =  _ux_utility_memory_allocate(UX_SAFE_ALIGN, UX_CACHE_SAFE_MEMORY, object_handle_length_raw);
+    object_handles_array_raw =  UX_MEMORY_DMA_ALLOCATE(UX_MEMORY_DMA_OWNER_HOST_PIMA, object_handle_length_raw);
     if (object_handles_array_raw == UX_NULL)
         return(UX_MEMORY_INSUFFICIENT);
 
@@ -172,7 +176,7 @@ UINT                                 status;
     }
 
     /* Free the original raw array.  */
-    _ux_utility_memory_free(object_handles_array_raw);
+    UX_MEMORY_DMA_FREE(object_handles_array_raw);
 
     /* Return completion status.  */
     return(status);
@@ -34,7 +34,7 @@
 /*  FUNCTION                                               RELEASE        */
 /*                                                                        */
 /*    _ux_host_class_pima_object_info_send                PORTABLE C      */
-/*                                                           6.3.0        */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -81,6 +81,10 @@
 /*                                            fixed allocated buffer      */
 /*                                            pointer checking issue,     */
 /*                                            resulting in version 6.3.0  */
+/*  xx-xx-xxxx     Mohamed ayed             Modified comment(s),          */
+/*                                            used DMA buffer pool for    */
+/*                                            transfer buffers,           */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_host_class_pima_object_info_send(UX_HOST_CLASS_PIMA *pima,
@@ -127,7 +131,7 @@ UINT                                 status;
     command.ux_host_class_pima_command_operation_code =  UX_HOST_CLASS_PIMA_OC_SEND_OBJECT_INFO;
 
     /* Allocate some DMA safe memory for sending the object info block.  */
-    object_buffer =  _ux_utility_memory_allocate(UX_SAFE_ALIGN, UX_CACHE_SAFE_MEMORY, UX_HOST_CLASS_PIMA_OBJECT_MAX_LENGTH);
+    object_buffer =  UX_MEMORY_DMA_ALLOCATE(UX_MEMORY_DMA_OWNER_HOST_PIMA, UX_HOST_CLASS_PIMA_OBJECT_MAX_LENGTH);
     if (object_buffer == UX_NULL)
         return(UX_MEMORY_INSUFFICIENT);
 
@@ -251,7 +255,7 @@ UINT                                 status;
     }
 
     /* Free the original object info buffer.  */
-    _ux_utility_memory_free(object_buffer);
+    UX_MEMORY_DMA_FREE(object_buffer);
 
     /* Return completion status.  */
     return(status);
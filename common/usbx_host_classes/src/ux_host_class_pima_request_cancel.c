@@ -71,6 +71,10 @@
 /*  05-19-2020     Chaoqiong Xiao           Initial Version 6.0           */
 /*  09-30-2020     Chaoqiong Xiao           Modified comment(s),          */
 /*                                            resulting in version 6.1    */
+/*  xx-xx-xxxx     Mohamed ayed             Modified comment(s),          */
+/*                                            used DMA buffer pool for    */
+/*                                            transfer buffers,           */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_host_class_pima_request_cancel(UX_HOST_CLASS_PIMA *pima)
@@ -89,7 +93,7 @@ ULONG                               command_retry_counter;
 
     /* Allocate some DMA safe memory for the command data payload.  We use mode than needed because
        we use this buffer for both the command and the status phase.  */
-    request_payload =  _ux_utility_memory_allocate(UX_SAFE_ALIGN, UX_CACHE_SAFE_MEMORY, UX_HOST_CLASS_PIMA_REQUEST_STATUS_DATA_LENGTH);
+    request_payload =  UX_MEMORY_DMA_ALLOCATE(UX_MEMORY_DMA_OWNER_HOST_PIMA, UX_HOST_CLASS_PIMA_REQUEST_STATUS_DATA_LENGTH);
     if (request_payload == UX_NULL)
         return(UX_MEMORY_INSUFFICIENT);
 
@@ -180,7 +184,7 @@ ULONG                               command_retry_counter;
     }
 
     /* Free allocated resources.  */
-    _ux_utility_memory_free(request_payload);
+    UX_MEMORY_DMA_FREE(request_payload);
 
     /* Return completion status.  */
     return(status);
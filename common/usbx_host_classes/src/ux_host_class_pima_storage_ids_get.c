@@ -34,7 +34,7 @@
 /*  FUNCTION                                               RELEASE        */
 /*                                                                        */
 /*    _ux_host_class_pima_storage_ids_get                 PORTABLE C      */
-/*                                                           6.1.12       */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -77,6 +77,10 @@
 /*  07-29-2022     Chaoqiong Xiao           Modified comment(s),          */
 /*                                            improved array size check,  */
 /*                                            resulting in version 6.1.12 */
+/*  xx-xx-xxxx     Mohamed ayed             Modified comment(s),          */
+/*                                            used DMA buffer pool for    */
+/*                                            transfer buffers,           */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_host_class_pima_storage_ids_get(UX_HOST_CLASS_PIMA *pima, UX_HOST_CLASS_PIMA_SESSION *pima_session,
@@ -117,7 +121,7 @@ ULONG                                nb_storage_ids;
      * UX_HOST_CLASS_PIMA_STORAGE_IDS_LENGTH = (UX_HOST_CLASS_PIMA_MAX_STORAGE_IDS + 1) * 4,
      * it is checked no calculation overflow.
      */
-    storage_ids =  _ux_utility_memory_allocate(UX_SAFE_ALIGN, UX_CACHE_SAFE_MEMORY, UX_HOST_CLASS_PIMA_STORAGE_IDS_LENGTH);
+    storage_ids =  UX_MEMORY_DMA_ALLOCATE(UX_MEMORY_DMA_OWNER_HOST_PIMA, UX_HOST_CLASS_PIMA_STORAGE_IDS_LENGTH);
     if (storage_ids == UX_NULL)
         return(UX_MEMORY_INSUFFICIENT);
 
@@ -156,7 +160,7 @@ ULONG                                nb_storage_ids;
     }
 
     /* Free the original storage ID buffer.  */
-    _ux_utility_memory_free(storage_ids);
+    UX_MEMORY_DMA_FREE(storage_ids);
 
     /* Return completion status.  */
     return(status);
@@ -80,6 +80,10 @@
 /*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s),          */
 /*                                            fixed unicode string copy,  */
 /*                                            resulting in version 6.x    */
+/*  xx-xx-xxxx     Mohamed ayed             Modified comment(s),          */
+/*                                            used DMA buffer pool for    */
+/*                                            transfer buffers,           */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_host_class_pima_storage_info_get(UX_HOST_CLASS_PIMA *pima,
@@ -120,7 +124,7 @@ ULONG                                unicode_string_length, unicode_string_bytes
     command.ux_host_class_pima_command_operation_code =  UX_HOST_CLASS_PIMA_OC_GET_STORAGE_INFO;
 
     /* Allocate some DMA safe memory for receiving the storage info block.  */
-    storage_buffer =  _ux_utility_memory_allocate(UX_SAFE_ALIGN, UX_CACHE_SAFE_MEMORY, UX_HOST_CLASS_PIMA_STORAGE_MAX_LENGTH);
+    storage_buffer =  UX_MEMORY_DMA_ALLOCATE(UX_MEMORY_DMA_OWNER_HOST_PIMA, UX_HOST_CLASS_PIMA_STORAGE_MAX_LENGTH);
     if (storage == UX_NULL)
         return(UX_MEMORY_INSUFFICIENT);
 
@@ -150,7 +154,7 @@ ULONG                                unicode_string_length, unicode_string_bytes
         /* Check target buffer length.  */
         if (unicode_string_bytes > UX_HOST_CLASS_PIMA_UNICODE_MAX_LENGTH)
         {
-            _ux_utility_memory_free(storage_buffer);
+            UX_MEMORY_DMA_FREE(storage_buffer);
             return(UX_BUFFER_OVERFLOW);
         }
 
@@ -172,7 +176,7 @@ ULONG                                unicode_string_length, unicode_string_bytes
         /* Check target buffer length.  */
         if (unicode_string_bytes > UX_HOST_CLASS_PIMA_UNICODE_MAX_LENGTH)
         {
-            _ux_utility_memory_free(storage_buffer);
+            UX_MEMORY_DMA_FREE(storage_buffer);
             return(UX_BUFFER_OVERFLOW);
         }
 
@@ -184,7 +188,7 @@ ULONG                                unicode_string_length, unicode_string_bytes
     }
 
     /* Free the original storage info buffer.  */
-    _ux_utility_memory_free(storage_buffer);
+    UX_MEMORY_DMA_FREE(storage_buffer);
 
     /* Return completion status.  */
     return(status);
@@ -58,7 +58,6 @@
 /*                                                                        */ 
 /*  CALLS                                                                 */ 
 /*                                                                        */ 
-/*    _ux_utility_long_put                  Write a 32-bit value          */ 
 /*    _ux_utility_memory_set                Set memory to a value         */ 
 /*                                                                        */ 
 /*  CALLED BY                                                             */ 
@@ -76,6 +75,9 @@
 /*                                            resulting in version 6.1    */
 /*  12-31-2020     Chaoqiong Xiao           Modified comment(s),          */
 /*                                            resulting in version 6.1.3  */
+/*  xx-xx-xxxx     Mohamed ayed             Modified comment(s),          */
+/*                                            used field access macros,   */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 VOID  _ux_host_class_storage_cbw_initialize(UX_HOST_CLASS_STORAGE *storage, UINT flags,
@@ -89,14 +91,14 @@ UCHAR   *cbw;
     cbw =  (UCHAR *) storage -> ux_host_class_storage_cbw;
 
     /* Store the signature of the CBW.  */
-    _ux_utility_long_put(cbw, UX_HOST_CLASS_STORAGE_CBW_SIGNATURE_MASK);
+    UX_UTILITY_LONG_PUT(cbw, UX_HOST_CLASS_STORAGE_CBW_SIGNATURE_MASK);
     
     /* Set the Tag, this value is simply an arbitrary number that is echoed by 
        the device in the CSW.  */
-    _ux_utility_long_put(cbw + UX_HOST_CLASS_STORAGE_CBW_TAG, UX_HOST_CLASS_STORAGE_CBW_TAG_MASK);
+    UX_UTILITY_LONG_PUT(cbw + UX_HOST_CLASS_STORAGE_CBW_TAG, UX_HOST_CLASS_STORAGE_CBW_TAG_MASK);
 
     /* Store the Data Transfer Length expected for the data payload.  */
-    _ux_utility_long_put(cbw + UX_HOST_CLASS_STORAGE_CBW_DATA_LENGTH, data_transfer_length);
+    UX_UTILITY_LONG_PUT(cbw + UX_HOST_CLASS_STORAGE_CBW_DATA_LENGTH, data_transfer_length);
 
     /* Store the CBW Flag field that contains the transfer flags.  */
     *(cbw + UX_HOST_CLASS_STORAGE_CBW_FLAGS) =  (UCHAR)flags;
@@ -34,7 +34,7 @@
 /*  FUNCTION                                               RELEASE        */
 /*                                                                        */
 /*    _ux_host_class_storage_max_lun_get                  PORTABLE C      */
-/*                                                           6.1.10       */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -72,6 +72,10 @@
 /*  01-31-2022     Chaoqiong Xiao           Modified comment(s),          */
 /*                                            added standalone support,   */
 /*                                            resulting in version 6.1.10 */
+/*  xx-xx-xxxx     Mohamed ayed             Modified comment(s),          */
+/*                                            used DMA buffer pool for    */
+/*                                            transfer buffers,           */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_host_class_storage_max_lun_get(UX_HOST_CLASS_STORAGE *storage)
@@ -103,7 +107,7 @@ UCHAR           *storage_data_buffer;
         return(status);
 
     /* Need to allocate memory for the descriptor.  */
-    storage_data_buffer =  _ux_utility_memory_allocate(UX_SAFE_ALIGN, UX_CACHE_SAFE_MEMORY, 1);
+    storage_data_buffer =  UX_MEMORY_DMA_ALLOCATE(UX_MEMORY_DMA_OWNER_HOST_STORAGE, 1);
     if (storage_data_buffer == UX_NULL)
         return(UX_MEMORY_INSUFFICIENT);
 
@@ -149,7 +153,7 @@ UCHAR           *storage_data_buffer;
     }
 
     /* Free all used resources.  */
-    _ux_utility_memory_free(storage_data_buffer);
+    UX_MEMORY_DMA_FREE(storage_data_buffer);
 #endif
 
 #ifdef UX_HOST_CLASS_STORAGE_INCLUDE_LEGACY_PROTOCOL_SUPPORT
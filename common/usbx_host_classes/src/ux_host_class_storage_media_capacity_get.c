@@ -34,7 +34,7 @@
 /*  FUNCTION                                               RELEASE        */
 /*                                                                        */
 /*    _ux_host_class_storage_media_capacity_get           PORTABLE C      */
-/*                                                           6.1.10       */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -78,6 +78,10 @@
 /*  01-31-2022     Chaoqiong Xiao           Modified comment(s),          */
 /*                                            added standalone support,   */
 /*                                            resulting in version 6.1.10 */
+/*  xx-xx-xxxx     Mohamed ayed             Modified comment(s),          */
+/*                                            used DMA buffer pool for    */
+/*                                            transfer buffers,           */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_host_class_storage_media_capacity_get(UX_HOST_CLASS_STORAGE *storage)
@@ -149,7 +153,7 @@ ULONG           command_retry;
         *(cbw + UX_HOST_CLASS_STORAGE_CBW_CB + UX_HOST_CLASS_STORAGE_READ_CAPACITY_OPERATION) =  UX_HOST_CLASS_STORAGE_SCSI_READ_CAPACITY;
 
         /* Obtain a block of memory for the answer.  */
-        capacity_response =  _ux_utility_memory_allocate(UX_SAFE_ALIGN, UX_CACHE_SAFE_MEMORY, UX_HOST_CLASS_STORAGE_READ_CAPACITY_RESPONSE_LENGTH);
+        capacity_response =  UX_MEMORY_DMA_ALLOCATE(UX_MEMORY_DMA_OWNER_HOST_STORAGE, UX_HOST_CLASS_STORAGE_READ_CAPACITY_RESPONSE_LENGTH);
         if (capacity_response == UX_NULL)
             return(UX_MEMORY_INSUFFICIENT);
 
@@ -172,7 +176,7 @@ ULONG           command_retry;
         {
 
             /* Free the memory resource used for the command response.  */
-            _ux_utility_memory_free(capacity_response);
+            UX_MEMORY_DMA_FREE(capacity_response);
 
             /* We return a sad status.  */
             return(status);
@@ -191,14 +195,14 @@ ULONG           command_retry;
             storage -> ux_host_class_storage_sector_size =  _ux_utility_long_get_big_endian(capacity_response + UX_HOST_CLASS_STORAGE_READ_CAPACITY_DATA_SECTOR_SIZE);
 
             /* Free the memory resource used for the command response.  */
-            _ux_utility_memory_free(capacity_response);
+            UX_MEMORY_DMA_FREE(capacity_response);
 
             /* We return a happy status.  */
             return(UX_SUCCESS);
         }
 
         /* Free the memory resource used for the command response.  */
-        _ux_utility_memory_free(capacity_response);
+        UX_MEMORY_DMA_FREE(capacity_response);
     }
 
     /* We get here when we could not retrieve the sector size through the READ_CAPACITY command.
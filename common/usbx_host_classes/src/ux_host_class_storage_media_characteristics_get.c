@@ -75,6 +75,10 @@
 /*  01-31-2022     Chaoqiong Xiao           Modified comment(s),          */
 /*                                            added standalone support,   */
 /*                                            resulting in version 6.1.10 */
+/*  xx-xx-xxxx     Mohamed ayed             Modified comment(s),          */
+/*                                            used DMA buffer pool for    */
+/*                                            transfer buffers,           */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_host_class_storage_media_characteristics_get(UX_HOST_CLASS_STORAGE *storage)
@@ -108,7 +112,7 @@ UINT            command_length;
     *(cbw + UX_HOST_CLASS_STORAGE_CBW_CB + UX_HOST_CLASS_STORAGE_INQUIRY_ALLOCATION_LENGTH) =  UX_HOST_CLASS_STORAGE_INQUIRY_RESPONSE_LENGTH;
 
     /* Obtain a block of memory for the answer.  */
-    inquiry_response =  _ux_utility_memory_allocate(UX_SAFE_ALIGN, UX_CACHE_SAFE_MEMORY, UX_HOST_CLASS_STORAGE_INQUIRY_RESPONSE_LENGTH);
+    inquiry_response =  UX_MEMORY_DMA_ALLOCATE(UX_MEMORY_DMA_OWNER_HOST_STORAGE, UX_HOST_CLASS_STORAGE_INQUIRY_RESPONSE_LENGTH);
     if (inquiry_response == UX_NULL)
         return(UX_MEMORY_INSUFFICIENT);
 
@@ -139,7 +143,7 @@ UINT            command_length;
     }       
 
     /* Free the memory resource used for the command response.  */
-    _ux_utility_memory_free(inquiry_response);
+    UX_MEMORY_DMA_FREE(inquiry_response);
     
     /* Return completion status.  */
     return(status);                                            
@@ -75,6 +75,10 @@
 /*  01-31-2022     Chaoqiong Xiao           Modified comment(s),          */
 /*                                            added standalone support,   */
 /*                                            resulting in version 6.1.10 */
+/*  xx-xx-xxxx     Mohamed ayed             Modified comment(s),          */
+/*                                            used DMA buffer pool for    */
+/*                                            transfer buffers,           */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_host_class_storage_media_format_capacity_get(UX_HOST_CLASS_STORAGE *storage)
@@ -110,7 +114,7 @@ UINT            command_length;
     _ux_utility_short_put_big_endian(cbw + UX_HOST_CLASS_STORAGE_CBW_CB + UX_HOST_CLASS_STORAGE_READ_FORMAT_PARAMETER_LIST_LENGTH, UX_HOST_CLASS_STORAGE_READ_FORMAT_RESPONSE_LENGTH);
 
     /* Obtain a block of memory for the answer.  */
-    read_format_capacity_response =  _ux_utility_memory_allocate(UX_SAFE_ALIGN, UX_CACHE_SAFE_MEMORY, UX_HOST_CLASS_STORAGE_READ_FORMAT_RESPONSE_LENGTH);
+    read_format_capacity_response =  UX_MEMORY_DMA_ALLOCATE(UX_MEMORY_DMA_OWNER_HOST_STORAGE, UX_HOST_CLASS_STORAGE_READ_FORMAT_RESPONSE_LENGTH);
     if (read_format_capacity_response == UX_NULL)
         return(UX_MEMORY_INSUFFICIENT);
 
@@ -129,7 +133,7 @@ UINT            command_length;
     _ux_host_class_storage_transport(storage, read_format_capacity_response);
 
     /* Free the memory resource used for the command response.  */
-    _ux_utility_memory_free(read_format_capacity_response);
+    UX_MEMORY_DMA_FREE(read_format_capacity_response);
 
     /* If we have a transport error, there is not much we can do, we do not fail.  */
     return(UX_SUCCESS);                                            
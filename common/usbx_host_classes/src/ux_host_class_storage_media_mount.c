@@ -34,7 +34,7 @@
 /*  FUNCTION                                               RELEASE        */
 /*                                                                        */
 /*    _ux_host_class_storage_media_mount                  PORTABLE C      */
-/*                                                           6.1.9        */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -90,6 +90,10 @@
 /*  10-15-2021     Chaoqiong Xiao           Modified comment(s),          */
 /*                                            fixed exFAT mounting,       */
 /*                                            resulting in version 6.1.9  */
+/*  xx-xx-xxxx     Mohamed ayed             Modified comment(s),          */
+/*                                            used DMA buffer pool for    */
+/*                                            transfer buffers,           */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_host_class_storage_media_mount(UX_HOST_CLASS_STORAGE *storage, ULONG sector)
@@ -123,7 +127,7 @@ UINT            status;
 
     /* Obtain memory for reading the partition sector, we do not use the storage instance
        memory because this function is reentrant.  */
-    sector_memory =  _ux_utility_memory_allocate(UX_SAFE_ALIGN, UX_CACHE_SAFE_MEMORY, storage -> ux_host_class_storage_sector_size);
+    sector_memory =  UX_MEMORY_DMA_ALLOCATE(UX_MEMORY_DMA_OWNER_HOST_STORAGE, storage -> ux_host_class_storage_sector_size);
     if (sector_memory == UX_NULL)
         return(UX_MEMORY_INSUFFICIENT);
 
@@ -141,7 +145,7 @@ UINT            status;
     {
 
         /* In any case, we free the sector memory.  */
-        _ux_utility_memory_free(sector_memory);
+        UX_MEMORY_DMA_FREE(sector_memory);
 
         if (status == UX_HOST_CLASS_STORAGE_SENSE_ERROR)
 
@@ -179,13 +183,13 @@ UINT            status;
 
                 /* This is a boot sector signature.  */
                 _ux_host_class_storage_media_open(storage, sector);
-                _ux_utility_memory_free(sector_memory);
+                UX_MEMORY_DMA_FREE(sector_memory);
                 return(UX_SUCCESS);
             }
         }
 
         _ux_host_class_storage_partition_read(storage, sector_memory, sector);
-        _ux_utility_memory_free(sector_memory);
+        UX_MEMORY_DMA_FREE(sector_memory);
         return(UX_SUCCESS);
     }
     else
@@ -196,7 +200,7 @@ UINT            status;
     }
 
     /* Free all resources used.  */
-    _ux_utility_memory_free(sector_memory);
+    UX_MEMORY_DMA_FREE(sector_memory);
 
     /* Return completion status.  */
     return(status);
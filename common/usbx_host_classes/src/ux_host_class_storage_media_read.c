@@ -69,10 +69,10 @@ ULONG       command_length;
     *(cbw_cb + UX_HOST_CLASS_STORAGE_READ_OPERATION) =  UX_HOST_CLASS_STORAGE_SCSI_READ16;
 
     /* Store the sector start (LBA field).  */
-    _ux_utility_long_put_big_endian(cbw_cb + UX_HOST_CLASS_STORAGE_READ_LBA, sector_start);
+    UX_UTILITY_LONG_PUT_BIG_ENDIAN(cbw_cb + UX_HOST_CLASS_STORAGE_READ_LBA, sector_start);
 
     /* Store the number of sectors to read.  */
-    _ux_utility_short_put_big_endian(cbw_cb + UX_HOST_CLASS_STORAGE_READ_TRANSFER_LENGTH, (USHORT) sector_count);
+    UX_UTILITY_SHORT_PUT_BIG_ENDIAN(cbw_cb + UX_HOST_CLASS_STORAGE_READ_TRANSFER_LENGTH, (USHORT) sector_count);
 }
 
 
@@ -105,7 +105,6 @@ ULONG       command_length;
 /*                                                                        */ 
 /*    _ux_host_class_storage_cbw_initialize Initialize the CBW            */ 
 /*    _ux_host_class_storage_transport      Send command                  */ 
-/*    _ux_utility_long_put_big_endian       Put 32-bit word               */ 
 /*    _ux_utility_short_put_big_endian      Put 16-bit word               */ 
 /*                                                                        */ 
 /*  CALLED BY                                                             */ 
@@ -125,6 +124,9 @@ ULONG       command_length;
 /*  03-08-2023     Chaoqiong Xiao           Modified comment(s),          */
 /*                                            checked device removal,     */
 /*                                            resulting in version 6.2.1  */
+/*  xx-xx-xxxx     Mohamed ayed             Modified comment(s),          */
+/*                                            used field access macros,   */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_host_class_storage_media_read(UX_HOST_CLASS_STORAGE *storage, ULONG sector_start,
@@ -71,6 +71,10 @@
 /*  05-19-2020     Chaoqiong Xiao           Initial Version 6.0           */
 /*  09-30-2020     Chaoqiong Xiao           Modified comment(s),          */
 /*                                            resulting in version 6.1    */
+/*  xx-xx-xxxx     Mohamed ayed             Modified comment(s),          */
+/*                                            used DMA buffer pool for    */
+/*                                            transfer buffers,           */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_host_class_storage_media_recovery_sense_get(UX_HOST_CLASS_STORAGE *storage)
@@ -121,7 +125,7 @@ UINT            command_length;
     _ux_utility_short_put_big_endian(cbw + UX_HOST_CLASS_STORAGE_CBW_CB + UX_HOST_CLASS_STORAGE_MODE_SENSE_PARAMETER_LIST_LENGTH, UX_HOST_CLASS_STORAGE_MODE_SENSE_ALL_PAGE_LENGTH);
 
     /* Obtain a block of memory for the answer.  */
-    mode_sense_response =  _ux_utility_memory_allocate(UX_SAFE_ALIGN, UX_CACHE_SAFE_MEMORY, UX_HOST_CLASS_STORAGE_MODE_SENSE_ALL_PAGE_LENGTH);
+    mode_sense_response =  UX_MEMORY_DMA_ALLOCATE(UX_MEMORY_DMA_OWNER_HOST_STORAGE, UX_HOST_CLASS_STORAGE_MODE_SENSE_ALL_PAGE_LENGTH);
     if (mode_sense_response == UX_NULL)
         return(UX_MEMORY_INSUFFICIENT);
     
@@ -129,7 +133,7 @@ UINT            command_length;
     status =  _ux_host_class_storage_transport(storage, mode_sense_response);
     
     /* Free the memory resource used for the command response.  */
-    _ux_utility_memory_free(mode_sense_response);
+    UX_MEMORY_DMA_FREE(mode_sense_response);
     
     /* Return completion status.  */
     return(status);                                            
@@ -77,6 +77,10 @@
 /*  01-31-2022     Chaoqiong Xiao           Modified comment(s),          */
 /*                                            added standalone support,   */
 /*                                            resulting in version 6.1.10 */
+/*  xx-xx-xxxx     Mohamed ayed             Modified comment(s),          */
+/*                                            used DMA buffer pool for    */
+/*                                            transfer buffers,           */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_host_class_storage_request_sense(UX_HOST_CLASS_STORAGE *storage)
@@ -127,7 +131,7 @@ ULONG           sense_code;
     *(cbw + UX_HOST_CLASS_STORAGE_CBW_CB + UX_HOST_CLASS_STORAGE_REQUEST_SENSE_ALLOCATION_LENGTH) =  UX_HOST_CLASS_STORAGE_REQUEST_SENSE_RESPONSE_LENGTH;
 
     /* Obtain a block of memory for the answer.  */
-    request_sense_response =  _ux_utility_memory_allocate(UX_SAFE_ALIGN, UX_CACHE_SAFE_MEMORY, UX_HOST_CLASS_STORAGE_REQUEST_SENSE_RESPONSE_LENGTH);
+    request_sense_response =  UX_MEMORY_DMA_ALLOCATE(UX_MEMORY_DMA_OWNER_HOST_STORAGE, UX_HOST_CLASS_STORAGE_REQUEST_SENSE_RESPONSE_LENGTH);
     if (request_sense_response == UX_NULL)
         return(UX_MEMORY_INSUFFICIENT);
 
@@ -165,7 +169,7 @@ ULONG           sense_code;
     }       
 
     /* Free the memory resource used for the command response.  */
-    _ux_utility_memory_free(request_sense_response);
+    UX_MEMORY_DMA_FREE(request_sense_response);
 
     /* Restore the current CBW command.  */
     _ux_utility_memory_copy(storage -> ux_host_class_storage_cbw, storage -> ux_host_class_storage_saved_cbw, UX_HOST_CLASS_STORAGE_CBW_LENGTH); /* Use case of memcpy is verified. */
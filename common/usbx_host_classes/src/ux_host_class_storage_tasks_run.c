@@ -52,7 +52,7 @@ static inline UINT _ux_host_class_storage_transport_sense_check(UX_HOST_CLASS_ST
 /*  FUNCTION                                               RELEASE        */
 /*                                                                        */
 /*    _ux_host_class_storage_tasks_run                    PORTABLE C      */
-/*                                                           6.2.0        */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -101,6 +101,10 @@ static inline UINT _ux_host_class_storage_transport_sense_check(UX_HOST_CLASS_ST
 /*  10-31-2022     Chaoqiong Xiao           Modified comment(s),          */
 /*                                            improved internal logic,    */
 /*                                            resulting in version 6.2.0  */
+/*  xx-xx-xxxx     Mohamed ayed             Modified comment(s),          */
+/*                                            used DMA buffer pool for    */
+/*                                            transfer buffers,           */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_host_class_storage_tasks_run(UX_HOST_CLASS *storage_class)
@@ -405,7 +409,7 @@ INT             immediate_state;
 
                 /* Normal flow is broken, if there is data buffer, free it.  */
                 if (storage -> ux_host_class_storage_trans_data)
-                    _ux_utility_memory_free(storage -> ux_host_class_storage_trans_data);
+                    UX_MEMORY_DMA_FREE(storage -> ux_host_class_storage_trans_data);
 
                 /* No further operations, reset state machine.  */
                 storage -> ux_host_class_storage_state_state = UX_STATE_RESET;
@@ -423,7 +427,7 @@ INT             immediate_state;
 
                     /* Normal flow is broken, if there is data buffer, free it.  */
                     if (storage -> ux_host_class_storage_trans_data)
-                        _ux_utility_memory_free(storage -> ux_host_class_storage_trans_data);
+                        UX_MEMORY_DMA_FREE(storage -> ux_host_class_storage_trans_data);
                     continue;
                 }
 
@@ -548,7 +552,7 @@ UX_TRANSFER *trans = storage -> ux_host_class_storage_trans;
         }
 
         /* Allocated buffer for request must be freed here.  */
-        _ux_utility_memory_free(trans -> ux_transfer_request_data_pointer);
+        UX_MEMORY_DMA_FREE(trans -> ux_transfer_request_data_pointer);
     }
 }
 static inline UINT _ux_host_class_storage_inquiry_save(UX_HOST_CLASS_STORAGE *storage)
@@ -564,7 +568,7 @@ UINT        lun_index = storage -> ux_host_class_storage_lun;
                         UX_HOST_CLASS_STORAGE_INQUIRY_RESPONSE_REMOVABLE_MEDIA);
 
     /* Free response buffer.  */
-    _ux_utility_memory_free(inquiry_response);
+    UX_MEMORY_DMA_FREE(inquiry_response);
 
     /* Set default sector size.  */
     switch(storage -> ux_host_class_storage_media_type)
@@ -610,7 +614,7 @@ UCHAR       *capacity_response = storage -> ux_host_class_storage_trans_data;
     }
 
     /* Free allocated buffer.  */
-    _ux_utility_memory_free(capacity_response);
+    UX_MEMORY_DMA_FREE(capacity_response);
 }
 static inline VOID _ux_host_class_storage_format_cap_save(UX_HOST_CLASS_STORAGE *storage)
 {
@@ -618,7 +622,7 @@ UCHAR       *format_cap_response = storage -> ux_host_class_storage_trans_data;
 
     /* There is nothing to save.  */
     /* Free allocated resource.  */
-    _ux_utility_memory_free(format_cap_response);
+    UX_MEMORY_DMA_FREE(format_cap_response);
 }
 
 static inline ULONG _ux_host_class_storage_lun_scan(UX_HOST_CLASS_STORAGE *storage,
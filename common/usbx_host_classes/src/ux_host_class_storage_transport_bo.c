@@ -35,7 +35,7 @@
 /*  FUNCTION                                               RELEASE        */
 /*                                                                        */
 /*    _ux_host_class_storage_transport_bo                 PORTABLE C      */
-/*                                                           6.1.10       */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -63,7 +63,6 @@
 /*    _ux_host_stack_transfer_request_abort Abort transfer request        */
 /*    _ux_utility_memory_allocate           Allocate memory               */
 /*    _ux_utility_memory_free               Free memory                   */
-/*    _ux_utility_long_get                  Get 32-bit word               */
 /*    _ux_host_semaphore_get                Get semaphore                 */
 /*                                                                        */
 /*  CALLED BY                                                             */
@@ -81,6 +80,11 @@
 /*  01-31-2022     Chaoqiong Xiao           Modified comment(s),          */
 /*                                            refined macros names,       */
 /*                                            resulting in version 6.1.10 */
+/*  xx-xx-xxxx     Mohamed ayed             Modified comment(s),          */
+/*                                            used DMA buffer pool for    */
+/*                                            transfer buffers,           */
+/*                                            used field access macros,   */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_host_class_storage_transport_bo(UX_HOST_CLASS_STORAGE *storage, UCHAR *data_pointer)
@@ -166,7 +170,7 @@ UCHAR           *get_status_response;
     }
 
     /* Get the length of the data payload.  */
-    data_phase_requested_length =  _ux_utility_long_get(cbw + UX_HOST_CLASS_STORAGE_CBW_DATA_LENGTH);
+    data_phase_requested_length =  UX_UTILITY_LONG_GET(cbw + UX_HOST_CLASS_STORAGE_CBW_DATA_LENGTH);
 
     /* Reset the data phase memory size.  */
     storage -> ux_host_class_storage_data_phase_length =  0;
@@ -313,7 +317,7 @@ UCHAR           *get_status_response;
 
                     /* Did the command fail, or succeed with non-zero data residue?  */
                     if (storage -> ux_host_class_storage_csw[UX_HOST_CLASS_STORAGE_CSW_STATUS] == UX_HOST_CLASS_STORAGE_CSW_FAILED ||
-                        _ux_utility_long_get(storage -> ux_host_class_storage_csw + UX_HOST_CLASS_STORAGE_CSW_DATA_RESIDUE) != 0)
+                        UX_UTILITY_LONG_GET(storage -> ux_host_class_storage_csw + UX_HOST_CLASS_STORAGE_CSW_DATA_RESIDUE) != 0)
                     {
 
                         /* It's possible the bulk out endpoint is stalled.
@@ -324,7 +328,7 @@ UCHAR           *get_status_response;
                            Query its status before clearing the stall.  */
 
                         /* Allocate memory for Get Status response.  */
-                        get_status_response =  _ux_utility_memory_allocate(UX_SAFE_ALIGN, UX_CACHE_SAFE_MEMORY, 2);
+                        get_status_response =  UX_MEMORY_DMA_ALLOCATE(UX_MEMORY_DMA_OWNER_HOST_STORAGE, 2);
                         if (get_status_response == UX_NULL)
                             return(UX_MEMORY_INSUFFICIENT);
 
@@ -356,7 +360,7 @@ UCHAR           *get_status_response;
                         }
 
                         /* Free the get status memory.  */
-                        _ux_utility_memory_free(get_status_response);
+                        UX_MEMORY_DMA_FREE(get_status_response);
 
                         /* Check result of Get Status and Clear Feature commands. */
                         if (status != UX_SUCCESS)
@@ -365,8 +369,8 @@ UCHAR           *get_status_response;
                 }
 
                 /* Save the amount of relevant data.  */
-                storage -> ux_host_class_storage_data_phase_length =  _ux_utility_long_get(cbw + UX_HOST_CLASS_STORAGE_CBW_DATA_LENGTH) -
-                    _ux_utility_long_get(storage -> ux_host_class_storage_csw + UX_HOST_CLASS_STORAGE_CSW_DATA_RESIDUE);
+                storage -> ux_host_class_storage_data_phase_length =  UX_UTILITY_LONG_GET(cbw + UX_HOST_CLASS_STORAGE_CBW_DATA_LENGTH) -
+                    UX_UTILITY_LONG_GET(storage -> ux_host_class_storage_csw + UX_HOST_CLASS_STORAGE_CSW_DATA_RESIDUE);
             }
             else
             {
@@ -62,7 +62,7 @@ static inline VOID _ux_host_class_storage_transport_ep_reset(UX_HOST_CLASS_STORA
 /*  FUNCTION                                               RELEASE        */
 /*                                                                        */
 /*    _ux_host_class_storage_transport_run                PORTABLE C      */
-/*                                                           6.2.0        */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -103,6 +103,10 @@ static inline VOID _ux_host_class_storage_transport_ep_reset(UX_HOST_CLASS_STORA
 /*  10-31-2022     Chaoqiong Xiao           Modified comment(s),          */
 /*                                            improved internal logic,    */
 /*                                            resulting in version 6.2.0  */
+/*  xx-xx-xxxx     Mohamed ayed             Modified comment(s),          */
+/*                                            used DMA buffer pool for    */
+/*                                            transfer buffers,           */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_host_class_storage_transport_run(UX_HOST_CLASS_STORAGE *storage)
@@ -250,7 +254,7 @@ UCHAR                   *cb = cbw + UX_HOST_CLASS_STORAGE_CBW_CB;
     {
 
         /* Free sense buffer and restore data pointer.  */
-        _ux_utility_memory_free(storage -> ux_host_class_storage_trans_data);
+        UX_MEMORY_DMA_FREE(storage -> ux_host_class_storage_trans_data);
         storage -> ux_host_class_storage_trans_data =
                                 storage -> ux_host_class_storage_trans_data_bak;
 
@@ -540,7 +544,7 @@ UCHAR                   csw_status;
                 (ULONG) *(resp + UX_HOST_CLASS_STORAGE_REQUEST_SENSE_RESPONSE_CODE_QUALIFIER));
 
         /* Free buffer allocated for sense response.  */
-        _ux_utility_memory_free(resp);
+        UX_MEMORY_DMA_FREE(resp);
 
         /* Passed, keep previous status and done.  */
         if (csw_status == UX_HOST_CLASS_STORAGE_CSW_PASSED)
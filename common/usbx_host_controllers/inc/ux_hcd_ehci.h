@@ -25,7 +25,7 @@
 /*  COMPONENT DEFINITION                                   RELEASE        */ 
 /*                                                                        */ 
 /*    ux_hcd_ehci.h                                       PORTABLE C      */ 
-/*                                                           6.1.8        */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -54,6 +54,18 @@
 /*                                            added extern "C" keyword    */
 /*                                            for compatibility with C++, */
 /*                                            resulting in version 6.1.8  */
+/*  xx-xx-xxxx     Mohamed ayed             Modified comment(s),          */
+/*                                            added transfer queue        */
+/*                                            functions,                  */
+/*                                            added descriptor free lists */
+/*                                            and exhaustion counters,    */
+/*                                            added active ED list,       */
+/*                                            added bulk chain support,   */
+/*                                            added interrupt threshold   */
+/*                                            functions,                  */
+/*                                            added batched unlink,       */
+/*                                            added periodic list get,    */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 
@@ -90,6 +102,11 @@ extern   "C" {
 #define UX_EHCI_PAGE_SIZE                                   4096
 #define UX_EHCI_PAGE_ALIGN                                  0xfffff000
 
+/* Define the largest payload of a TD holding whole packets of size m, from buffer address p.
+   A TD buffer spans up to 5 pages, the first one from the offset of the buffer.  */
+
+#define UX_EHCI_TD_PAYLOAD_MAX(p, m)                        ((((UX_EHCI_PAGE_SIZE * 5u) - ((ULONG) ((ALIGN_TYPE) (p) & (UX_EHCI_PAGE_SIZE - 1u)))) / (m)) * (m))
+
 
 /* Define EHCI host controller capability registers.  */
 
@@ -119,6 +136,8 @@ extern   "C" {
 #define EHCI_HC_IO_ASE                                      0x00000020u
 #define EHCI_HC_IO_IAAD                                     0x00000040u
 #define EHCI_HC_IO_ITC                                      0x00010000u
+#define EHCI_HC_IO_ITC_LOC                                  16u
+#define EHCI_HC_IO_ITC_MASK                                 0x00ff0000u
 #define EHCI_HC_IO_FRAME_SIZE_1024                          0x00000000u
 #define EHCI_HC_IO_FRAME_SIZE_512                           0x00000004u
 #define EHCI_HC_IO_FRAME_SIZE_256                           0x00000008u
@@ -134,6 +153,35 @@ extern   "C" {
 #endif
 #define UX_EHCI_FRAME_LIST_MASK                             EHCI_HC_IO_FRAME_SIZE_1024
 
+/* Define EHCI interrupt threshold control. The threshold is the maximum rate, in micro-frames,
+   at which the controller issues transfer interrupts. It can be 1, 2, 4, 8, 16, 32 or 64.
+   When it is set to adaptive, it is raised to UX_HCD_EHCI_INTERRUPT_THRESHOLD_MAX while more than
+   UX_HCD_EHCI_INTERRUPT_THRESHOLD_BULK_BYTES are transferred in each window of
+   UX_HCD_EHCI_INTERRUPT_THRESHOLD_WINDOW ms, and lowered to the shortest periodic interval
+   otherwise.  */
+
+#define UX_HCD_EHCI_INTERRUPT_THRESHOLD_ADAPTIVE            0
+#define UX_HCD_EHCI_INTERRUPT_THRESHOLD_DEFAULT             1
+
+#ifndef UX_HCD_EHCI_INTERRUPT_THRESHOLD_MAX
+#define UX_HCD_EHCI_INTERRUPT_THRESHOLD_MAX                 8
+#endif
+
+#ifndef UX_HCD_EHCI_INTERRUPT_THRESHOLD_WINDOW
+#define UX_HCD_EHCI_INTERRUPT_THRESHOLD_WINDOW              8
+#endif
+
+#ifndef UX_HCD_EHCI_INTERRUPT_THRESHOLD_BULK_BYTES
+#define UX_HCD_EHCI_INTERRUPT_THRESHOLD_BULK_BYTES          (64 * 1024)
+#endif
+
+/* Define EHCI doorbell states. Unlinked EDs and doorbell waits are pending until the doorbell
+   is rung, and are retired on the next Interrupt on Async Advance.  */
+
+#define UX_EHCI_DOOR_BELL_RUNG                              0x00000001u
+#define UX_EHCI_DOOR_BELL_WAIT_PENDING                      0x00000002u
+#define UX_EHCI_DOOR_BELL_WAIT_RUNG                         0x00000004u
+
 /* Define EHCI HCOR status register.  */
 
 #define EHCI_HC_STS_USB_INT                                 0x00000001u
@@ -376,6 +424,42 @@ typedef struct UX_HCD_EHCI_STRUCT
     ULONG           ux_hcd_ehci_frame_list_size;
     ULONG           ux_hcd_ehci_interrupt_count;
     ULONG           ux_hcd_ehci_embedded_tt;
+    struct UX_EHCI_ED_STRUCT
+                    *ux_hcd_ehci_ed_free_list;
+    struct UX_EHCI_TD_STRUCT
+                    *ux_hcd_ehci_td_free_list;
+    struct UX_EHCI_FSISO_TD_STRUCT
+                    *ux_hcd_ehci_fsiso_td_free_list;
+    struct UX_EHCI_HSISO_TD_STRUCT
+                    *ux_hcd_ehci_hsiso_td_free_list;
+    ULONG           ux_hcd_ehci_ed_obtain_failures;
+    ULONG           ux_hcd_ehci_td_obtain_failures;
+    ULONG           ux_hcd_ehci_fsiso_td_obtain_failures;
+    ULONG           ux_hcd_ehci_hsiso_td_obtain_failures;
+#if defined(UX_HCD_EHCI_ACTIVE_LIST_ENABLE)
+    struct UX_EHCI_ED_STRUCT
+                    *ux_hcd_ehci_active_ed_list;
+#endif
+#if defined(UX_HCD_EHCI_BULK_CHAIN_ENABLE)
+    struct UX_EHCI_TD_STRUCT
+                    *ux_hcd_ehci_short_td;
+#endif
+#if defined(UX_HCD_EHCI_INTERRUPT_THRESHOLD_ENABLE)
+    ULONG           ux_hcd_ehci_interrupt_threshold;
+    ULONG           ux_hcd_ehci_interrupt_threshold_current;
+    ULONG           ux_hcd_ehci_interrupt_threshold_window_start;
+    ULONG           ux_hcd_ehci_interrupt_threshold_window_bytes;
+    ULONG           ux_hcd_ehci_transfer_interrupt_count;
+    ULONG           ux_hcd_ehci_transfer_bytes;
+    ULONG           ux_hcd_ehci_transfer_mbytes;
+#endif
+#if defined(UX_HCD_EHCI_UNLINK_BATCH_ENABLE)
+    struct UX_EHCI_ED_STRUCT
+                    *ux_hcd_ehci_unlink_ed_list;
+    struct UX_EHCI_ED_STRUCT
+                    *ux_hcd_ehci_unlink_retire_list;
+    ULONG           ux_hcd_ehci_door_bell_state;
+#endif
 } UX_HCD_EHCI;
 
 
@@ -423,7 +507,15 @@ typedef struct UX_EHCI_ED_STRUCT
                         *ux_ehci_ed_anchor;                 /* + 1 DWord.  */
             struct UX_ENDPOINT_STRUCT
                         *ux_ehci_ed_endpoint;               /* + 1 Dword.  */
+            struct UX_EHCI_ED_STRUCT
+                        *ux_ehci_ed_next_active;            /* + 1 Dword.  */
+            struct UX_EHCI_ED_STRUCT
+                        *ux_ehci_ed_next_unlink;            /* + 1 Dword.  */
         } INTR;
+        struct {                                            /* As free ED.  */
+            struct UX_EHCI_ED_STRUCT
+                        *ux_ehci_ed_next_free;              /* + 1 DWord.  */
+        } FREE;
         struct {                                            /* Space: 7 DWord.  */
             ULONG       ux_ehci_ed_reserved[7];
         } RESERVED;
@@ -450,6 +542,7 @@ typedef struct UX_EHCI_ED_STRUCT
 #define UX_EHCI_QH_SSPLIT_SCH_FULL_2                        0x02000000u
 #define UX_EHCI_QH_SSPLIT_SCH_FULL_1                        0x01000000u
 #define UX_EHCI_QH_SSPLIT_SCH_FULL_0                        0x00800000u
+#define UX_EHCI_QH_ACTIVE_LIST                              0x00000002u
 
 #define UX_EHCI_QH_MPS_LOC                                  16u
 #define UX_EHCI_QH_MPS_MASK                                 0x07ff0000u
@@ -511,7 +604,9 @@ typedef struct UX_EHCI_TD_STRUCT
     ULONG           ux_ehci_td_length;
     ULONG           ux_ehci_td_status;
     ULONG           ux_ehci_td_phase;
-    ULONG           ux_ehci_td_reserved_2[2];
+    struct UX_EHCI_TD_STRUCT
+                    *ux_ehci_td_next_free;
+    ULONG           ux_ehci_td_reserved_2;
     /* 16-DWord aligned.  */
 } UX_EHCI_TD;
 
@@ -584,7 +679,7 @@ typedef struct UX_EHCI_HSISO_TD_STRUCT
     union UX_EHCI_PERIODIC_LINK_POINTER_UNION
                     ux_ehci_hsiso_td_previous_lp;
     struct UX_EHCI_HSISO_TD_STRUCT
-                    *ux_ehci_hsiso_td_next_scan_td; 
+                    *ux_ehci_hsiso_td_next_scan_td;     /* Next free iTD when unused.  */
     struct UX_EHCI_HSISO_TD_STRUCT
                     *ux_ehci_hsiso_td_previous_scan_td; 
     struct UX_TRANSFER_STRUCT
@@ -680,7 +775,7 @@ typedef struct UX_EHCI_FSISO_TD_STRUCT
     union UX_EHCI_PERIODIC_LINK_POINTER_UNION
                     ux_ehci_fsiso_td_previous_lp;
     struct UX_EHCI_FSISO_TD_STRUCT
-                    *ux_ehci_fsiso_td_next_scan_td;
+                    *ux_ehci_fsiso_td_next_scan_td;     /* Next free siTD when unused.  */
     struct UX_EHCI_FSISO_TD_STRUCT
                     *ux_ehci_fsiso_td_previous_scan_td;
     struct UX_EHCI_ED_STRUCT
@@ -791,31 +886,44 @@ typedef struct UX_EHCI_FSISO_TD_STRUCT
 /* Define EHCI function prototypes.  */
 
 void _ux_hcd_ehci_periodic_descriptor_link(VOID* prev, VOID* prev_next, VOID* next_prev, VOID* next);
-UX_EHCI_TD          *_ux_hcd_ehci_asynch_td_process(UX_EHCI_ED *ed, UX_EHCI_TD *td);
+UX_EHCI_TD          *_ux_hcd_ehci_asynch_td_process(UX_HCD_EHCI *hcd_ehci, UX_EHCI_ED *ed, UX_EHCI_TD *td);
 UX_EHCI_HSISO_TD    *_ux_hcd_ehci_hsisochronous_tds_process(UX_HCD_EHCI *hcd_ehci, UX_EHCI_HSISO_TD* itd);
 UX_EHCI_FSISO_TD    *_ux_hcd_ehci_fsisochronous_tds_process(UX_HCD_EHCI *hcd_ehci, UX_EHCI_FSISO_TD* sitd);
 UINT    _ux_hcd_ehci_asynchronous_endpoint_create(UX_HCD_EHCI *hcd_ehci, UX_ENDPOINT *endpoint);
 UINT    _ux_hcd_ehci_asynchronous_endpoint_destroy(UX_HCD_EHCI *hcd_ehci, UX_ENDPOINT *endpoint);
 UINT    _ux_hcd_ehci_controller_disable(UX_HCD_EHCI *hcd_ehci);
 VOID    _ux_hcd_ehci_done_queue_process(UX_HCD_EHCI *hcd_ehci);
+VOID    _ux_hcd_ehci_door_bell_process(UX_HCD_EHCI *hcd_ehci);
+VOID    _ux_hcd_ehci_door_bell_ring(UX_HCD_EHCI *hcd_ehci);
 VOID    _ux_hcd_ehci_door_bell_wait(UX_HCD_EHCI *hcd_ehci);
-UINT    _ux_hcd_ehci_ed_clean(UX_EHCI_ED *ed);
+VOID    _ux_hcd_ehci_ed_active_insert(UX_HCD_EHCI *hcd_ehci, UX_EHCI_ED *ed);
+VOID    _ux_hcd_ehci_ed_active_remove(UX_HCD_EHCI *hcd_ehci, UX_EHCI_ED *ed);
+UINT    _ux_hcd_ehci_ed_clean(UX_HCD_EHCI *hcd_ehci, UX_EHCI_ED *ed);
 UX_EHCI_ED          *_ux_hcd_ehci_ed_obtain(UX_HCD_EHCI *hcd_ehci);
+VOID    _ux_hcd_ehci_ed_queue_flush(UX_HCD_EHCI *hcd_ehci, UX_EHCI_ED *ed, UX_TRANSFER *transfer_request, UINT completion_code);
+VOID    _ux_hcd_ehci_ed_queue_remove(UX_HCD_EHCI *hcd_ehci, UX_EHCI_ED *ed, UX_TRANSFER *transfer_request);
+VOID    _ux_hcd_ehci_ed_release(UX_HCD_EHCI *hcd_ehci, UX_EHCI_ED *ed);
 UINT    _ux_hcd_ehci_endpoint_reset(UX_HCD_EHCI *hcd_ehci, UX_ENDPOINT *endpoint);
 UINT    _ux_hcd_ehci_entry(UX_HCD *hcd, UINT function, VOID *parameter);
 UINT    _ux_hcd_ehci_frame_number_get(UX_HCD_EHCI *hcd_ehci, ULONG *frame_number);
 VOID    _ux_hcd_ehci_frame_number_set(UX_HCD_EHCI *hcd_ehci, ULONG frame_number);
 UX_EHCI_FSISO_TD    *_ux_hcd_ehci_fsisochronous_td_obtain(UX_HCD_EHCI *hcd_ehci);
+VOID    _ux_hcd_ehci_fsisochronous_td_release(UX_HCD_EHCI *hcd_ehci, UX_EHCI_FSISO_TD *td);
 UX_EHCI_HSISO_TD    *_ux_hcd_ehci_hsisochronous_td_obtain(UX_HCD_EHCI *hcd_ehci);
+VOID    _ux_hcd_ehci_hsisochronous_td_release(UX_HCD_EHCI *hcd_ehci, UX_EHCI_HSISO_TD *td);
 UINT    _ux_hcd_ehci_initialize(UX_HCD *hcd);
 UINT    _ux_hcd_ehci_interrupt_endpoint_create(UX_HCD_EHCI *hcd_ehci, UX_ENDPOINT *endpoint);
 UINT    _ux_hcd_ehci_interrupt_endpoint_destroy(UX_HCD_EHCI *hcd_ehci, UX_ENDPOINT *endpoint);
 VOID    _ux_hcd_ehci_interrupt_handler(VOID);
+VOID    _ux_hcd_ehci_interrupt_threshold_adapt(UX_HCD_EHCI *hcd_ehci);
+UINT    _ux_hcd_ehci_interrupt_threshold_get(UX_HCD *hcd, ULONG *threshold, ULONG *interrupts_per_mbyte);
+UINT    _ux_hcd_ehci_interrupt_threshold_set(UX_HCD *hcd, ULONG threshold);
 UINT    _ux_hcd_ehci_isochronous_endpoint_create(UX_HCD_EHCI *hcd_ehci, UX_ENDPOINT *endpoint);
 UINT    _ux_hcd_ehci_isochronous_endpoint_destroy(UX_HCD_EHCI *hcd_ehci, UX_ENDPOINT *endpoint);
 UX_EHCI_ED          *_ux_hcd_ehci_least_traffic_list_get(UX_HCD_EHCI *hcd_ehci, ULONG microframe_load[8], ULONG microframe_ssplit_count[8]);
 UX_EHCI_ED          *_ux_hcd_ehci_poll_rate_entry_get(UX_HCD_EHCI *hcd_ehci, UX_EHCI_ED *ed_list, ULONG poll_depth);
 VOID    _ux_hcd_ehci_next_td_clean(UX_EHCI_TD *td);
+UX_EHCI_ED          *_ux_hcd_ehci_periodic_list_get(UX_HCD_EHCI *hcd_ehci, ULONG list_index, ULONG microframe_load[8], ULONG microframe_ssplit_count[8]);
 UINT    _ux_hcd_ehci_periodic_tree_create(UX_HCD_EHCI *hcd_ehci);
 UINT    _ux_hcd_ehci_port_disable(UX_HCD_EHCI *hcd_ehci, ULONG port_index);
 UINT    _ux_hcd_ehci_port_reset(UX_HCD_EHCI *hcd_ehci, ULONG port_index);
@@ -828,6 +936,7 @@ VOID    _ux_hcd_ehci_power_root_hubs(UX_HCD_EHCI *hcd_ehci);
 ULONG   _ux_hcd_ehci_register_read(UX_HCD_EHCI *hcd_ehci, ULONG ehci_register);
 VOID    _ux_hcd_ehci_register_write(UX_HCD_EHCI *hcd_ehci, ULONG ehci_register, ULONG value);
 UX_EHCI_TD          *_ux_hcd_ehci_regular_td_obtain(UX_HCD_EHCI *hcd_ehci);
+VOID    _ux_hcd_ehci_regular_td_release(UX_HCD_EHCI *hcd_ehci, UX_EHCI_TD *td);
 UINT    _ux_hcd_ehci_request_bulk_transfer(UX_HCD_EHCI *hcd_ehci, UX_TRANSFER *transfer_request);
 UINT    _ux_hcd_ehci_request_control_transfer(UX_HCD_EHCI *hcd_ehci, UX_TRANSFER *transfer_request);
 UINT    _ux_hcd_ehci_request_interrupt_transfer(UX_HCD_EHCI *hcd_ehci, UX_TRANSFER *transfer_request);
@@ -835,11 +944,14 @@ UINT    _ux_hcd_ehci_request_isochronous_transfer(UX_HCD_EHCI *hcd_ehci, UX_TRAN
 UINT    _ux_hcd_ehci_request_transfer(UX_HCD_EHCI *hcd_ehci, UX_TRANSFER *transfer_request);
 UINT    _ux_hcd_ehci_request_transfer_add(UX_HCD_EHCI *hcd_ehci, UX_EHCI_ED *ed, ULONG phase, ULONG pid,
                                     ULONG toggle, UCHAR * buffer_address, ULONG buffer_length, UX_TRANSFER *transfer_request);
+UINT    _ux_hcd_ehci_request_transfer_queue(UX_HCD_EHCI *hcd_ehci, UX_EHCI_ED *ed, UX_TRANSFER *transfer_request);
 UINT    _ux_hcd_ehci_transfer_abort(UX_HCD_EHCI *hcd_ehci,UX_TRANSFER *transfer_request);
 VOID    _ux_hcd_ehci_transfer_request_process(UX_TRANSFER *transfer_request);
 
 #define ux_hcd_ehci_initialize                      _ux_hcd_ehci_initialize
 #define ux_hcd_ehci_interrupt_handler               _ux_hcd_ehci_interrupt_handler
+#define ux_hcd_ehci_interrupt_threshold_get         _ux_hcd_ehci_interrupt_threshold_get
+#define ux_hcd_ehci_interrupt_threshold_set         _ux_hcd_ehci_interrupt_threshold_set
 
 /* Determine if a C++ compiler is being used.  If so, complete the standard 
    C conditional started above.  */   
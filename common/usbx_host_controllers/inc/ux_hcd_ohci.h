@@ -25,7 +25,7 @@
 /*  COMPONENT DEFINITION                                   RELEASE        */ 
 /*                                                                        */ 
 /*    ux_hcd_ohci.h                                       PORTABLE C      */ 
-/*                                                           6.1.12       */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -55,6 +55,10 @@
 /*  07-29-2022     Yajun Xia                Modified comment(s),          */
 /*                                            fixed OHCI PRSC issue,      */
 /*                                            resulting in version 6.1.12 */
+/*  xx-xx-xxxx     Mohamed ayed             Modified comment(s),          */
+/*                                            added descriptor free lists */
+/*                                            and exhaustion counters,    */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 
@@ -267,6 +271,15 @@ typedef struct UX_HCD_OHCI_STRUCT
                     *ux_hcd_ohci_iso_td_list;
     UX_EVENT_FLAGS_GROUP
                     ux_hcd_ohci_event_flags_group;
+    struct UX_OHCI_ED_STRUCT
+                    *ux_hcd_ohci_ed_free_list;
+    struct UX_OHCI_TD_STRUCT
+                    *ux_hcd_ohci_td_free_list;
+    struct UX_OHCI_ISO_TD_STRUCT
+                    *ux_hcd_ohci_iso_td_free_list;
+    ULONG           ux_hcd_ohci_ed_obtain_failures;
+    ULONG           ux_hcd_ohci_td_obtain_failures;
+    ULONG           ux_hcd_ohci_iso_td_obtain_failures;
 } UX_HCD_OHCI;
 
 
@@ -283,7 +296,7 @@ typedef struct UX_OHCI_ED_STRUCT
     struct UX_OHCI_ED_STRUCT               
                     *ux_ohci_ed_next_ed;
     struct UX_OHCI_ED_STRUCT               
-                    *ux_ohci_ed_previous_ed;
+                    *ux_ohci_ed_previous_ed;            /* Next free ED when unused.  */
     ULONG           ux_ohci_ed_status;
     struct UX_ENDPOINT_STRUCT          
                     *ux_ohci_ed_endpoint;
@@ -324,7 +337,9 @@ typedef struct UX_OHCI_TD_STRUCT
                     *ux_ohci_td_ed;
     ULONG           ux_ohci_td_length;
     ULONG           ux_ohci_td_status;
-    ULONG           ux_ohci_td_reserved_2[3];
+    struct UX_OHCI_TD_STRUCT
+                    *ux_ohci_td_next_free;
+    ULONG           ux_ohci_td_reserved_2[2];
 } UX_OHCI_TD;
 
 
@@ -362,7 +377,9 @@ typedef struct UX_OHCI_ISO_TD_STRUCT
                     *ux_ohci_iso_td_ed;
     ULONG           ux_ohci_iso_td_length;
     ULONG           ux_ohci_iso_td_status;
-    ULONG           ux_ohci_iso_td_reserved[3];
+    struct UX_OHCI_ISO_TD_STRUCT
+                    *ux_ohci_iso_td_next_free;
+    ULONG           ux_ohci_iso_td_reserved[2];
 } UX_OHCI_ISO_TD;
 
 
@@ -381,6 +398,7 @@ UINT    _ux_hcd_ohci_asynchronous_endpoint_destroy(UX_HCD_OHCI *hcd_ohci, UX_END
 UINT    _ux_hcd_ohci_controller_disable(UX_HCD_OHCI *hcd_ohci);
 VOID    _ux_hcd_ohci_done_queue_process(UX_HCD_OHCI *hcd_ohci);
 UX_OHCI_ED  *_ux_hcd_ohci_ed_obtain(UX_HCD_OHCI *hcd_ohci);
+VOID    _ux_hcd_ohci_ed_release(UX_HCD_OHCI *hcd_ohci, UX_OHCI_ED *ed);
 UINT    _ux_hcd_ohci_endpoint_error_clear(UX_HCD_OHCI *hcd_ohci, UX_ENDPOINT *endpoint);
 UINT    _ux_hcd_ohci_endpoint_reset(UX_HCD_OHCI *hcd_ohci, UX_ENDPOINT *endpoint);
 UINT    _ux_hcd_ohci_entry(UX_HCD *hcd, UINT function, VOID *parameter);
@@ -391,8 +409,9 @@ UINT    _ux_hcd_ohci_interrupt_endpoint_create(UX_HCD_OHCI *hcd_ohci, UX_ENDPOIN
 VOID    _ux_hcd_ohci_interrupt_handler(VOID);
 UINT    _ux_hcd_ohci_isochronous_endpoint_create(UX_HCD_OHCI *hcd_ohci, UX_ENDPOINT *endpoint);
 UX_OHCI_ISO_TD  *_ux_hcd_ohci_isochronous_td_obtain(UX_HCD_OHCI *hcd_ohci);
+VOID    _ux_hcd_ohci_isochronous_td_release(UX_HCD_OHCI *hcd_ohci, UX_OHCI_ISO_TD *td);
 UX_OHCI_ED  *_ux_hcd_ohci_least_traffic_list_get(UX_HCD_OHCI *hcd_ohci);
-VOID    _ux_hcd_ohci_next_td_clean(UX_OHCI_TD *td);
+VOID    _ux_hcd_ohci_next_td_clean(UX_HCD_OHCI *hcd_ohci, UX_OHCI_TD *td);
 UINT    _ux_hcd_ohci_periodic_endpoint_destroy(UX_HCD_OHCI *hcd_ohci, UX_ENDPOINT *endpoint);
 UINT    _ux_hcd_ohci_periodic_tree_create(UX_HCD_OHCI *hcd_ohci);
 UINT    _ux_hcd_ohci_port_disable(UX_HCD_OHCI *hcd_ohci, ULONG port_index);
@@ -407,6 +426,7 @@ VOID    _ux_hcd_ohci_power_root_hubs(UX_HCD_OHCI *hcd_ohci);
 ULONG   _ux_hcd_ohci_register_read(UX_HCD_OHCI *hcd_ohci, ULONG ohci_register);
 VOID    _ux_hcd_ohci_register_write(UX_HCD_OHCI *hcd_ohci, ULONG ohci_register, ULONG value);
 UX_OHCI_TD  *_ux_hcd_ohci_regular_td_obtain(UX_HCD_OHCI *hcd_ohci);
+VOID    _ux_hcd_ohci_regular_td_release(UX_HCD_OHCI *hcd_ohci, UX_OHCI_TD *td);
 UINT    _ux_hcd_ohci_request_bulk_transfer(UX_HCD_OHCI *hcd_ohci, UX_TRANSFER *transfer_request);
 UINT    _ux_hcd_ohci_request_control_transfer(UX_HCD_OHCI *hcd_ohci, UX_TRANSFER *transfer_request);
 UINT    _ux_hcd_ohci_request_interrupt_transfer(UX_HCD_OHCI *hcd_ohci, UX_TRANSFER *transfer_request);
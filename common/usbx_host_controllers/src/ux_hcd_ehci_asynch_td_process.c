@@ -34,7 +34,7 @@
 /*  FUNCTION                                               RELEASE        */ 
 /*                                                                        */ 
 /*    _ux_hcd_ehci_asynch_td_process                      PORTABLE C      */ 
-/*                                                           6.1.10       */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -47,6 +47,7 @@
 /*                                                                        */ 
 /*  INPUT                                                                 */ 
 /*                                                                        */ 
+/*    hcd_ehci                              Pointer to EHCI controller    */
 /*    ed                                    Pointer to ED                 */ 
 /*    td                                    Pointer to TD                 */ 
 /*                                                                        */ 
@@ -58,6 +59,8 @@
 /*                                                                        */ 
 /*    (ux_transfer_request_completion_function) Completion function       */ 
 /*    _ux_hcd_ehci_ed_clean                 Clean ED                      */ 
+/*    _ux_hcd_ehci_ed_queue_flush           Flush TDs on ED               */
+/*    _ux_hcd_ehci_regular_td_release       Release TD                    */
 /*    _ux_host_semaphore_put                Put semaphore                 */ 
 /*    _ux_utility_virtual_address           Get virtual address           */ 
 /*                                                                        */ 
@@ -75,17 +78,35 @@
 /*  01-31-2022     Chaoqiong Xiao           Modified comment(s),          */
 /*                                            refined macros names,       */
 /*                                            resulting in version 6.1.10 */
+/*  xx-xx-xxxx     Mohamed ayed             Modified comment(s),          */
+/*                                            supported transfers queued  */
+/*                                            behind pending transfers,   */
+/*                                            added bulk chain support,   */
+/*                                            counted bytes transferred,  */
+/*                                            released TDs to free list,  */
+/*                                            kept short packet TD,       */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
-UX_EHCI_TD  *_ux_hcd_ehci_asynch_td_process(UX_EHCI_ED *ed, UX_EHCI_TD *td)
+UX_EHCI_TD  *_ux_hcd_ehci_asynch_td_process(UX_HCD_EHCI *hcd_ehci, UX_EHCI_ED *ed, UX_EHCI_TD *td)
 {
 
+#if defined(UX_HCD_EHCI_TRANSFER_QUEUE_ENABLE)
+UX_INTERRUPT_SAVE_AREA
+#endif
+
 UX_TRANSFER     *transfer_request;
 ULONG           td_residual_length;
 UINT            td_error;
 UX_EHCI_TD      *next_td;
 ULONG           td_element;
 ULONG           pid;
+#if defined(UX_HCD_EHCI_BULK_CHAIN_ENABLE)
+ULONG           td_short;
+#endif
+#if defined(UX_HCD_EHCI_INTERRUPT_THRESHOLD_ENABLE)
+ULONG           td_length;
+#endif
 
 
     /* If the TD is still active, we know that the transfer has not taken place yet. In this case, 
@@ -129,11 +150,18 @@ ULONG           pid;
         /* Update the transfer code.  */
         transfer_request -> ux_transfer_request_completion_code =  td_error;
         
+#if defined(UX_HCD_EHCI_TRANSFER_QUEUE_ENABLE)
+
+        /* Flush the queue, the transfers queued behind this one are aborted.  */
+        _ux_hcd_ehci_ed_queue_flush(hcd_ehci, ed, transfer_request, UX_TRANSFER_STATUS_ABORT);
+#else
+
         /* Clean the link.  */
-        _ux_hcd_ehci_ed_clean(ed);
+        _ux_hcd_ehci_ed_clean(hcd_ehci, ed);
 
         /* Free the TD that was just treated.  */
-        td -> ux_ehci_td_status =  UX_UNUSED;
+        _ux_hcd_ehci_regular_td_release(hcd_ehci, td);
+#endif
 
         /* We may do a call back.  */
         if (transfer_request -> ux_transfer_request_completion_function != UX_NULL)
@@ -160,11 +188,39 @@ ULONG           pid;
 
         td_residual_length =  (td -> ux_ehci_td_control >> UX_EHCI_TD_LG_LOC) & UX_EHCI_TD_LG_MASK;
         transfer_request -> ux_transfer_request_actual_length +=  td -> ux_ehci_td_length - td_residual_length;        
+
+#if defined(UX_HCD_EHCI_INTERRUPT_THRESHOLD_ENABLE)
+
+        /* Count the bytes transferred for the interrupt threshold and rate.  */
+        td_length =  td -> ux_ehci_td_length - td_residual_length;
+        hcd_ehci -> ux_hcd_ehci_interrupt_threshold_window_bytes +=  td_length;
+        hcd_ehci -> ux_hcd_ehci_transfer_bytes +=  td_length;
+        if (hcd_ehci -> ux_hcd_ehci_transfer_bytes >= 1024 * 1024)
+        {
+            hcd_ehci -> ux_hcd_ehci_transfer_bytes -=  1024 * 1024;
+            hcd_ehci -> ux_hcd_ehci_transfer_mbytes ++;
+        }
+#endif
     }
 
+#if defined(UX_HCD_EHCI_BULK_CHAIN_ENABLE)
+
+    /* A short packet on a TD with an alternate TD stopped the queue, the
+       transfer is complete even if this TD is not the last one.  */
+    td_element =  (ULONG) td -> ux_ehci_td_alternate_link_pointer;
+    if ((td_residual_length != 0) && ((td_element & UX_EHCI_TD_T) == 0))
+        td_short =  UX_TRUE;
+    else
+        td_short =  UX_FALSE;
+#endif
+
     /* We get here when there is no error on the transfer. It may be that this transfer is not the last 
        one in the link and therefore we process the length received but do not complete the transfer request.  */
+#if defined(UX_HCD_EHCI_BULK_CHAIN_ENABLE)
+    if ((td -> ux_ehci_td_control & UX_EHCI_TD_IOC) || (td_short == UX_TRUE))
+#else
     if (td -> ux_ehci_td_control & UX_EHCI_TD_IOC)
+#endif
     {
 
         /* Check if this transaction is complete or a short packet occurred, in both case, complete the 
@@ -177,11 +233,95 @@ ULONG           pid;
             /* Update the transfer code.  */
             transfer_request -> ux_transfer_request_completion_code =  UX_SUCCESS;
         
+#if defined(UX_HCD_EHCI_TRANSFER_QUEUE_ENABLE)
+
+            /* Only the TDs of this transfer are removed, the transfers queued
+               behind it stay on the ED.  */
+            UX_DISABLE
+
+#if defined(UX_HCD_EHCI_BULK_CHAIN_ENABLE)
+
+            /* The TDs left in the transfer stopped by a short packet are freed.  */
+            if (td_short == UX_TRUE)
+            {
+                while (td -> ux_ehci_td_next_td_transfer_request != UX_NULL)
+                {
+                    next_td =  td -> ux_ehci_td_next_td_transfer_request;
+                    _ux_hcd_ehci_regular_td_release(hcd_ehci, td);
+                    td =  next_td;
+                }
+            }
+#endif
+
+            /* Get the next TD attached to this TD.  */
+            td_element =  (ULONG) td -> ux_ehci_td_link_pointer;
+            if (td_element & UX_EHCI_TD_T)
+            {
+
+                /* No more transfer queued, the ED is idle.  */
+                next_td =  UX_NULL;
+                ed -> ux_ehci_ed_last_td =  UX_NULL;
+
+#if defined(UX_HCD_EHCI_BULK_CHAIN_ENABLE)
+
+                /* The next TD pointer of the queue stopped on a short packet
+                   refers to freed TDs, terminate it.  */
+                if (td_short == UX_TRUE)
+                    ed -> ux_ehci_ed_queue_element =  (UX_EHCI_TD *) UX_EHCI_TD_T;
+#endif
+            }
+            else
+            {
+
+                /* The next TD is the first TD of the next transfer.  */
+                next_td =  _ux_utility_virtual_address((VOID *) td_element);
+
+#if defined(UX_HCD_EHCI_BULK_CHAIN_ENABLE)
+
+                /* The queue stopped on the short packet TD, restart it on the next
+                   transfer. The overlay length is cleared last so that the controller
+                   uses the new next TD pointer.  */
+                if (td_short == UX_TRUE)
+                {
+                    ed -> ux_ehci_ed_queue_element =  (UX_EHCI_TD *) td_element;
+                    UX_DATA_MEMORY_BARRIER
+                    ed -> ux_ehci_ed_state &=  UX_EHCI_QH_TOGGLE;
+                }
+                else
+#endif
+
+                /* The controller may have fetched this TD before the next transfer was
+                   linked to it, and have retired the queue. Restart the queue then.  */
+                if ((next_td -> ux_ehci_td_control & UX_EHCI_TD_ACTIVE) &&
+                    ((ULONG) ed -> ux_ehci_ed_queue_element & UX_EHCI_TD_T) &&
+                    ((ed -> ux_ehci_ed_state & (UX_EHCI_TD_ACTIVE | UX_EHCI_TD_HALTED)) == 0))
+                    ed -> ux_ehci_ed_queue_element =  (UX_EHCI_TD *) td_element;
+            }
+
+            /* The next TD is now the first TD.  */
+            ed -> ux_ehci_ed_first_td =  next_td;
+
+            /* Free the TD that was just treated.  */
+            _ux_hcd_ehci_regular_td_release(hcd_ehci, td);
+
+            /* Restore interrupts.  */
+            UX_RESTORE
+#else
+
+#if defined(UX_HCD_EHCI_BULK_CHAIN_ENABLE)
+
+            /* The queue stopped on the short packet TD, which is not freed.
+               The TDs left in the transfer follow this TD.  */
+            if (td_short == UX_TRUE)
+                ed -> ux_ehci_ed_queue_element =  td -> ux_ehci_td_link_pointer;
+#endif
+
             /* Clean the link.  */
-            _ux_hcd_ehci_ed_clean(ed);
+            _ux_hcd_ehci_ed_clean(hcd_ehci, ed);
 
             /* Free the TD that was just treated.  */
-            td -> ux_ehci_td_status =  UX_UNUSED;
+            _ux_hcd_ehci_regular_td_release(hcd_ehci, td);
+#endif
 
             /* We may do a call back.  */
             if (transfer_request -> ux_transfer_request_completion_function != UX_NULL)
@@ -190,8 +330,15 @@ ULONG           pid;
             /* Wake up the semaphore for this request.  */
             _ux_host_semaphore_put(&transfer_request -> ux_transfer_request_semaphore);
 
+#if defined(UX_HCD_EHCI_TRANSFER_QUEUE_ENABLE)
+
+            /* The next transfer may be complete already.  */
+            return(next_td);
+#else
+
             /* Nothing else to be processed in this queue */
             return(UX_NULL);
+#endif
         }
     }
 
@@ -201,7 +348,7 @@ ULONG           pid;
     next_td =  _ux_utility_virtual_address((VOID *) td_element);
     
     /* Free the TD that was just treated.  */
-    td -> ux_ehci_td_status =  UX_UNUSED;
+    _ux_hcd_ehci_regular_td_release(hcd_ehci, td);
 
     /* This TD is now the first TD.  */
     ed -> ux_ehci_ed_first_td = next_td;
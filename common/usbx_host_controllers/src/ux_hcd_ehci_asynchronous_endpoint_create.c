@@ -34,7 +34,7 @@
 /*  FUNCTION                                               RELEASE        */ 
 /*                                                                        */ 
 /*    _ux_hcd_ehci_asynchronous_endpoint_create           PORTABLE C      */ 
-/*                                                           6.3.0        */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -56,6 +56,8 @@
 /*  CALLS                                                                 */ 
 /*                                                                        */ 
 /*    _ux_hcd_ehci_ed_obtain                Obtain EHCI ED                */ 
+/*    _ux_host_mutex_on                     Get mutex                     */
+/*    _ux_host_mutex_off                    Put mutex                     */
 /*    _ux_utility_physical_address          Get physical address          */ 
 /*                                                                        */ 
 /*  CALLED BY                                                             */ 
@@ -77,6 +79,9 @@
 /*  10-31-2023     Chaoqiong Xiao           Modified comment(s),          */
 /*                                            fixed compile warnings,     */
 /*                                            resulting in version 6.3.0  */
+/*  xx-xx-xxxx     Mohamed ayed             Modified comment(s),          */
+/*                                            locked list for queue,      */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_hcd_ehci_asynchronous_endpoint_create(UX_HCD_EHCI *hcd_ehci, UX_ENDPOINT *endpoint)
@@ -158,6 +163,12 @@ UX_EHCI_LINK_POINTER    queue_head;
         break;
     }
             
+#if defined(UX_HCD_EHCI_TRANSFER_QUEUE_ENABLE)
+
+    /* An aborted transfer may take an ED off the list for a while.  */
+    _ux_host_mutex_on(&hcd_ehci -> ux_hcd_ehci_periodic_mutex);
+#endif
+
     /* We need to insert this new endpoint into the asynchronous list. All new EDs are inserted at the 
        end of the list. The current ED will be pointing to the first ED in the list.  */
     queue_head.void_ptr = _ux_utility_physical_address(hcd_ehci -> ux_hcd_ehci_asynch_first_list);
@@ -177,6 +188,12 @@ UX_EHCI_LINK_POINTER    queue_head;
     /* Remember the new last QH.  */
     hcd_ehci -> ux_hcd_ehci_asynch_last_list =  ed;
 
+#if defined(UX_HCD_EHCI_TRANSFER_QUEUE_ENABLE)
+
+    /* Release the list.  */
+    _ux_host_mutex_off(&hcd_ehci -> ux_hcd_ehci_periodic_mutex);
+#endif
+
     /* Return successful completion.  */
     return(UX_SUCCESS);         
 }
@@ -34,7 +34,7 @@
 /*  FUNCTION                                               RELEASE        */ 
 /*                                                                        */ 
 /*    _ux_hcd_ehci_asynchronous_endpoint_destroy          PORTABLE C      */ 
-/*                                                           6.1          */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -55,7 +55,12 @@
 /*                                                                        */ 
 /*  CALLS                                                                 */ 
 /*                                                                        */ 
+/*    _ux_hcd_ehci_door_bell_ring           Ring door bell                */
 /*    _ux_hcd_ehci_door_bell_wait           Wait for door bell            */ 
+/*    _ux_hcd_ehci_ed_active_remove         Remove ED from active list    */
+/*    _ux_hcd_ehci_ed_release               Release ED                    */
+/*    _ux_host_mutex_on                     Get mutex                     */
+/*    _ux_host_mutex_off                    Put mutex                     */
 /*    _ux_utility_physical_address          Get physical address          */ 
 /*                                                                        */ 
 /*  CALLED BY                                                             */ 
@@ -69,11 +74,22 @@
 /*  05-19-2020     Chaoqiong Xiao           Initial Version 6.0           */
 /*  09-30-2020     Chaoqiong Xiao           Modified comment(s),          */
 /*                                            resulting in version 6.1    */
+/*  xx-xx-xxxx     Mohamed ayed             Modified comment(s),          */
+/*                                            removed from active list,   */
+/*                                            batched unlink,             */
+/*                                            freed ED on halted HC,      */
+/*                                            released ED to free list,   */
+/*                                            locked list for queue,      */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_hcd_ehci_asynchronous_endpoint_destroy(UX_HCD_EHCI *hcd_ehci, UX_ENDPOINT *endpoint)
 {
 
+#if defined(UX_HCD_EHCI_UNLINK_BATCH_ENABLE)
+UX_INTERRUPT_SAVE_AREA
+#endif
+
 UX_EHCI_ED              *ed;
 UX_EHCI_ED              *previous_ed;
 UX_EHCI_ED              *next_ed;
@@ -83,6 +99,12 @@ UX_EHCI_LINK_POINTER    queue_head;
     /* From the endpoint container fetch the EHCI ED descriptor.  */
     ed =  (UX_EHCI_ED *) endpoint -> ux_endpoint_ed;
 
+#if defined(UX_HCD_EHCI_TRANSFER_QUEUE_ENABLE)
+
+    /* An aborted transfer may take an ED off the list for a while.  */
+    _ux_host_mutex_on(&hcd_ehci -> ux_hcd_ehci_periodic_mutex);
+#endif
+
     /* Get the previous ED in the list for this ED.  */
     previous_ed =  ed -> ux_ehci_ed_previous_ed;
 
@@ -104,11 +126,53 @@ UX_EHCI_LINK_POINTER    queue_head;
     if (hcd_ehci -> ux_hcd_ehci_asynch_last_list == ed)
         hcd_ehci -> ux_hcd_ehci_asynch_last_list =  previous_ed;
 
+#if defined(UX_HCD_EHCI_TRANSFER_QUEUE_ENABLE)
+
+    /* Release the list.  */
+    _ux_host_mutex_off(&hcd_ehci -> ux_hcd_ehci_periodic_mutex);
+#endif
+
+#if defined(UX_HCD_EHCI_ACTIVE_LIST_ENABLE)
+
+    /* Take the ED off the active list, the done queue processing walks
+       this list with the periodic mutex held.  */
+    _ux_host_mutex_on(&hcd_ehci -> ux_hcd_ehci_periodic_mutex);
+    _ux_hcd_ehci_ed_active_remove(hcd_ehci, ed);
+    _ux_host_mutex_off(&hcd_ehci -> ux_hcd_ehci_periodic_mutex);
+#endif
+
+#if defined(UX_HCD_EHCI_UNLINK_BATCH_ENABLE)
+
+    /* The interrupt handler retires the unlinked EDs.  */
+    UX_DISABLE
+
+    /* A halted controller does not visit the ED nor answer the doorbell,
+       the ED can be freed now.  */
+    if (hcd_ehci -> ux_hcd_ehci_hcd_owner -> ux_hcd_status != UX_HCD_STATUS_OPERATIONAL)
+        _ux_hcd_ehci_ed_release(hcd_ehci, ed);
+    else
+    {
+
+        /* Queue the ED for the next doorbell, it is freed on the Interrupt on
+           Async Advance that follows, so no need to wait for it here.  */
+        ed -> REF_AS.INTR.ux_ehci_ed_next_unlink =  hcd_ehci -> ux_hcd_ehci_unlink_ed_list;
+        hcd_ehci -> ux_hcd_ehci_unlink_ed_list =  ed;
+
+        /* If a doorbell is rung already, the ED is retired with the next one.  */
+        if ((hcd_ehci -> ux_hcd_ehci_door_bell_state & UX_EHCI_DOOR_BELL_RUNG) == 0)
+            _ux_hcd_ehci_door_bell_ring(hcd_ehci);
+    }
+
+    /* Restore interrupts.  */
+    UX_RESTORE
+#else
+
     /* Arm the doorbell and wait for its completion.  */
     _ux_hcd_ehci_door_bell_wait(hcd_ehci);
         
     /* Now we can safely make the ED free.  */
-    ed -> ux_ehci_ed_status =  UX_UNUSED;
+    _ux_hcd_ehci_ed_release(hcd_ehci, ed);
+#endif
 
     /* Return successful completion.  */
     return(UX_SUCCESS);        
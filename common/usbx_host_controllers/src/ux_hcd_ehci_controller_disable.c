@@ -34,7 +34,7 @@
 /*  FUNCTION                                               RELEASE        */ 
 /*                                                                        */ 
 /*    _ux_hcd_ehci_controller_disable                     PORTABLE C      */ 
-/*                                                           6.1          */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -58,8 +58,11 @@
 /*                                                                        */ 
 /*  CALLS                                                                 */ 
 /*                                                                        */ 
+/*    _ux_hcd_ehci_ed_release               Release ED                    */
 /*    _ux_hcd_ehci_register_read            Read EHCI register            */ 
 /*    _ux_hcd_ehci_register_write           Write EHCI register           */ 
+/*    _ux_hcd_ehci_regular_td_release       Release TD                    */
+/*    _ux_host_semaphore_put                Put semaphore                 */
 /*                                                                        */ 
 /*  CALLED BY                                                             */ 
 /*                                                                        */ 
@@ -72,11 +75,21 @@
 /*  05-19-2020     Chaoqiong Xiao           Initial Version 6.0           */
 /*  09-30-2020     Chaoqiong Xiao           Modified comment(s),          */
 /*                                            resulting in version 6.1    */
+/*  xx-xx-xxxx     Mohamed ayed             Modified comment(s),          */
+/*                                            freed short packet TD,      */
+/*                                            retired unlinked EDs,       */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_hcd_ehci_controller_disable(UX_HCD_EHCI *hcd_ehci)
 {
 
+#if defined(UX_HCD_EHCI_UNLINK_BATCH_ENABLE)
+UX_INTERRUPT_SAVE_AREA
+
+UX_EHCI_ED  *ed;
+UX_EHCI_ED  *next_ed;
+#endif
 UX_HCD      *hcd;
 ULONG       ehci_register;
     
@@ -101,6 +114,49 @@ ULONG       ehci_register;
     /* Reflect the state of the controller in the main structure.  */
     hcd -> ux_hcd_status =  UX_HCD_STATUS_HALTED;
 
+#if defined(UX_HCD_EHCI_BULK_CHAIN_ENABLE)
+
+    /* Free the short packet TD.  */
+    if (hcd_ehci -> ux_hcd_ehci_short_td != UX_NULL)
+    {
+        _ux_hcd_ehci_regular_td_release(hcd_ehci, hcd_ehci -> ux_hcd_ehci_short_td);
+        hcd_ehci -> ux_hcd_ehci_short_td =  UX_NULL;
+    }
+#endif
+
+#if defined(UX_HCD_EHCI_UNLINK_BATCH_ENABLE)
+
+    /* The controller is halted, there will be no Interrupt on Async Advance
+       for the doorbell. The unlinked EDs are no longer visited, free them.  */
+    UX_DISABLE
+    ed =  hcd_ehci -> ux_hcd_ehci_unlink_retire_list;
+    while (ed != UX_NULL)
+    {
+
+        next_ed =  ed -> REF_AS.INTR.ux_ehci_ed_next_unlink;
+        _ux_hcd_ehci_ed_release(hcd_ehci, ed);
+        ed =  next_ed;
+    }
+    hcd_ehci -> ux_hcd_ehci_unlink_retire_list =  UX_NULL;
+    ed =  hcd_ehci -> ux_hcd_ehci_unlink_ed_list;
+    while (ed != UX_NULL)
+    {
+
+        next_ed =  ed -> REF_AS.INTR.ux_ehci_ed_next_unlink;
+        _ux_hcd_ehci_ed_release(hcd_ehci, ed);
+        ed =  next_ed;
+    }
+    hcd_ehci -> ux_hcd_ehci_unlink_ed_list =  UX_NULL;
+
+    /* Resume the thread who waits for the doorbell.  */
+    if (hcd_ehci -> ux_hcd_ehci_door_bell_state & (UX_EHCI_DOOR_BELL_WAIT_RUNG | UX_EHCI_DOOR_BELL_WAIT_PENDING))
+        _ux_host_semaphore_put(&hcd_ehci -> ux_hcd_ehci_doorbell_semaphore);
+
+    /* The doorbell is idle.  */
+    hcd_ehci -> ux_hcd_ehci_door_bell_state =  0;
+    UX_RESTORE
+#endif
+
     /* Return successful completion.  */
     return(UX_SUCCESS);
 }
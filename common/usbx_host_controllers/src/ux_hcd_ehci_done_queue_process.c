@@ -34,7 +34,7 @@
 /*  FUNCTION                                               RELEASE        */
 /*                                                                        */
 /*    _ux_hcd_ehci_done_queue_process                     PORTABLE C      */
-/*                                                           6.1.11       */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -45,6 +45,10 @@
 /*    lists in search for transfers that occurred in the past             */
 /*    (micro-)frame.                                                      */
 /*                                                                        */
+/*    If the active ED list is enabled, only the interrupt and            */
+/*    asynchronous EDs that have TDs hooked are visited. An ED is taken   */
+/*    off the list once it has no more TDs.                               */
+/*                                                                        */
 /*  INPUT                                                                 */
 /*                                                                        */
 /*    hcd_ehci                              Pointer to EHCI controller    */
@@ -56,6 +60,9 @@
 /*  CALLS                                                                 */
 /*                                                                        */
 /*    _ux_hcd_ehci_asynch_td_process        Process asynch TD             */
+/*    _ux_hcd_ehci_ed_active_remove         Remove ED from active list    */
+/*    _ux_hcd_ehci_interrupt_threshold_adapt                              */
+/*                                          Adapt interrupt threshold     */
 /*    _ux_hcd_ehci_hsisochronous_tds_process                              */
 /*                                          Process high speed            */
 /*                                          isochronous TDs               */
@@ -81,14 +88,27 @@
 /*  04-25-2022     Chaoqiong Xiao           Modified comment(s),          */
 /*                                            fixed standalone compile,   */
 /*                                            resulting in version 6.1.11 */
+/*  xx-xx-xxxx     Mohamed ayed             Modified comment(s),          */
+/*                                            visited only active EDs     */
+/*                                            when active list enabled,   */
+/*                                            adapted interrupt threshold,*/
+/*                                            passed controller to TD     */
+/*                                            processing,                 */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 VOID  _ux_hcd_ehci_done_queue_process(UX_HCD_EHCI *hcd_ehci)
 {
 
+#if defined(UX_HCD_EHCI_ACTIVE_LIST_ENABLE)
+UX_INTERRUPT_SAVE_AREA
+
+UX_EHCI_ED                      *next_ed;
+#else
+UX_EHCI_ED                      *start_ed;
+#endif
 UX_EHCI_TD                      *td;
 UX_EHCI_PERIODIC_LINK_POINTER   ed;
-UX_EHCI_ED                      *start_ed;
 
 
 #if UX_MAX_ISO_TD
@@ -121,6 +141,40 @@ UX_EHCI_PERIODIC_LINK_POINTER   lp;
 #endif
 #endif
 
+#if defined(UX_HCD_EHCI_ACTIVE_LIST_ENABLE)
+
+    /* We scan the active ED list then. The periodic mutex keeps the EDs
+       from being destroyed while they are processed.  */
+    _ux_host_mutex_on(&hcd_ehci -> ux_hcd_ehci_periodic_mutex);
+    ed.ed_ptr = hcd_ehci -> ux_hcd_ehci_active_ed_list;
+    while(ed.ed_ptr != UX_NULL)
+    {
+
+        /* Retrieve the fist TD attached to this ED.  */
+        td =  ed.ed_ptr -> ux_ehci_ed_first_td;
+
+        /* Process TD until there is no next available.  */
+        while (td != UX_NULL)
+            td =  _ux_hcd_ehci_asynch_td_process(hcd_ehci, ed.ed_ptr, td);
+
+        /* A new transfer may be hooked to the ED at the same time.  */
+        UX_DISABLE
+
+        /* Next ED.  */
+        next_ed = ed.ed_ptr -> REF_AS.INTR.ux_ehci_ed_next_active;
+
+        /* The ED is idle, take it off the active list.  */
+        if (ed.ed_ptr -> ux_ehci_ed_first_td == UX_NULL)
+            _ux_hcd_ehci_ed_active_remove(hcd_ehci, ed.ed_ptr);
+
+        /* Restore interrupts.  */
+        UX_RESTORE
+
+        ed.ed_ptr = next_ed;
+    }
+    _ux_host_mutex_off(&hcd_ehci -> ux_hcd_ehci_periodic_mutex);
+#else
+
     /* We scan the linked interrupt list then.  */
     _ux_host_mutex_on(&hcd_ehci -> ux_hcd_ehci_periodic_mutex);
     ed.ed_ptr = hcd_ehci -> ux_hcd_ehci_interrupt_ed_list;
@@ -132,7 +186,7 @@ UX_EHCI_PERIODIC_LINK_POINTER   lp;
 
         /* Process TD until there is no next available.  */
         while (td != UX_NULL)
-            td =  _ux_hcd_ehci_asynch_td_process(ed.ed_ptr, td);
+            td =  _ux_hcd_ehci_asynch_td_process(hcd_ehci, ed.ed_ptr, td);
         
         /* Next ED.  */
         ed.ed_ptr = ed.ed_ptr -> ux_ehci_ed_next_ed;
@@ -160,7 +214,7 @@ UX_EHCI_PERIODIC_LINK_POINTER   lp;
         while (td != UX_NULL)
         {
 
-            td =  _ux_hcd_ehci_asynch_td_process(ed.ed_ptr, td);
+            td =  _ux_hcd_ehci_asynch_td_process(hcd_ehci, ed.ed_ptr, td);
         }
 
         /* Point to the next ED in the asynchronous tree.  */
@@ -170,5 +224,12 @@ UX_EHCI_PERIODIC_LINK_POINTER   lp;
         /* Obtain the virtual address from the element.  */
         ed.void_ptr = _ux_utility_virtual_address(ed.void_ptr);
     }
+#endif
+
+#if defined(UX_HCD_EHCI_INTERRUPT_THRESHOLD_ENABLE)
+
+    /* Adapt the interrupt threshold to the load.  */
+    _ux_hcd_ehci_interrupt_threshold_adapt(hcd_ehci);
+#endif
 }
 
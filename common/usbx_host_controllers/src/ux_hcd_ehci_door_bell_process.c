@@ -0,0 +1,113 @@
+/***************************************************************************
+ * Copyright (c) 2024 Microsoft Corporation 
+ * 
+ * This program and the accompanying materials are made available under the
+ * terms of the MIT License which is available at
+ * https://opensource.org/licenses/MIT.
+ * 
+ * SPDX-License-Identifier: MIT
+ **************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */ 
+/** USBX Component                                                        */ 
+/**                                                                       */
+/**   EHCI Controller Driver                                              */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+
+/* Include necessary system files.  */
+
+#define UX_SOURCE_CODE
+
+#include "ux_api.h"
+#include "ux_hcd_ehci.h"
+#include "ux_host_stack.h"
+
+
+#if defined(UX_HCD_EHCI_UNLINK_BATCH_ENABLE)
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_hcd_ehci_door_bell_process                      PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function is called from the interrupt handler on an Interrupt  */
+/*    on Async Advance. The controller no longer holds any ED unlinked    */
+/*    before the doorbell was rung, so these EDs are freed and the thread */
+/*    waiting for the doorbell is resumed. If more EDs were unlinked in   */
+/*    the meantime, the doorbell is rung again for all of them.           */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    hcd_ehci                              Pointer to EHCI controller    */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _ux_hcd_ehci_door_bell_ring           Ring door bell                */
+/*    _ux_hcd_ehci_ed_release               Release ED                    */
+/*    _ux_host_semaphore_put                Put semaphore                 */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    EHCI Controller Driver                                              */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Mohamed ayed             Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+VOID  _ux_hcd_ehci_door_bell_process(UX_HCD_EHCI *hcd_ehci)
+{
+
+UX_EHCI_ED      *ed;
+UX_EHCI_ED      *next_ed;
+
+
+    /* Check if the doorbell was rung by us.  */
+    if ((hcd_ehci -> ux_hcd_ehci_door_bell_state & UX_EHCI_DOOR_BELL_RUNG) == 0)
+        return;
+
+    /* Now we can safely make the retired EDs free.  */
+    ed =  hcd_ehci -> ux_hcd_ehci_unlink_retire_list;
+    while (ed != UX_NULL)
+    {
+
+        next_ed =  ed -> REF_AS.INTR.ux_ehci_ed_next_unlink;
+        _ux_hcd_ehci_ed_release(hcd_ehci, ed);
+        ed =  next_ed;
+    }
+    hcd_ehci -> ux_hcd_ehci_unlink_retire_list =  UX_NULL;
+
+    /* Resume the thread who waits for this doorbell.  */
+    if (hcd_ehci -> ux_hcd_ehci_door_bell_state & UX_EHCI_DOOR_BELL_WAIT_RUNG)
+        _ux_host_semaphore_put(&hcd_ehci -> ux_hcd_ehci_doorbell_semaphore);
+
+    /* Check for EDs unlinked or a wait posted while the doorbell was rung.  */
+    if ((hcd_ehci -> ux_hcd_ehci_unlink_ed_list != UX_NULL) ||
+        (hcd_ehci -> ux_hcd_ehci_door_bell_state & UX_EHCI_DOOR_BELL_WAIT_PENDING))
+
+        /* Ring the doorbell again for all of them.  */
+        _ux_hcd_ehci_door_bell_ring(hcd_ehci);
+    else
+
+        /* The doorbell is idle.  */
+        hcd_ehci -> ux_hcd_ehci_door_bell_state =  0;
+}
+#endif
@@ -0,0 +1,96 @@
+/***************************************************************************
+ * Copyright (c) 2024 Microsoft Corporation 
+ * 
+ * This program and the accompanying materials are made available under the
+ * terms of the MIT License which is available at
+ * https://opensource.org/licenses/MIT.
+ * 
+ * SPDX-License-Identifier: MIT
+ **************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */ 
+/** USBX Component                                                        */ 
+/**                                                                       */
+/**   EHCI Controller Driver                                              */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+
+/* Include necessary system files.  */
+
+#define UX_SOURCE_CODE
+
+#include "ux_api.h"
+#include "ux_hcd_ehci.h"
+#include "ux_host_stack.h"
+
+
+#if defined(UX_HCD_EHCI_UNLINK_BATCH_ENABLE)
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_hcd_ehci_door_bell_ring                         PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function raises the doorbell for all the EDs unlinked and the  */
+/*    doorbell waits posted since the last doorbell. They are retired     */
+/*    together on the next Interrupt on Async Advance. It must be called  */
+/*    with interrupts disabled, when no doorbell is rung.                 */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    hcd_ehci                              Pointer to EHCI controller    */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _ux_hcd_ehci_register_read            Read EHCI register            */
+/*    _ux_hcd_ehci_register_write           Write EHCI register           */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    EHCI Controller Driver                                              */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Mohamed ayed             Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+VOID  _ux_hcd_ehci_door_bell_ring(UX_HCD_EHCI *hcd_ehci)
+{
+
+ULONG       ehci_register;
+
+
+    /* The pending EDs are retired by this doorbell.  */
+    hcd_ehci -> ux_hcd_ehci_unlink_retire_list =  hcd_ehci -> ux_hcd_ehci_unlink_ed_list;
+    hcd_ehci -> ux_hcd_ehci_unlink_ed_list =  UX_NULL;
+
+    /* So is the pending doorbell wait.  */
+    if (hcd_ehci -> ux_hcd_ehci_door_bell_state & UX_EHCI_DOOR_BELL_WAIT_PENDING)
+        hcd_ehci -> ux_hcd_ehci_door_bell_state =  UX_EHCI_DOOR_BELL_WAIT_RUNG;
+    else
+        hcd_ehci -> ux_hcd_ehci_door_bell_state =  0;
+    hcd_ehci -> ux_hcd_ehci_door_bell_state |=  UX_EHCI_DOOR_BELL_RUNG;
+
+    /* Raise the doorbell to the HCD.  */
+    ehci_register =  _ux_hcd_ehci_register_read(hcd_ehci, EHCI_HCOR_USB_COMMAND);
+    ehci_register |=  EHCI_HC_IO_IAAD;
+    _ux_hcd_ehci_register_write(hcd_ehci, EHCI_HCOR_USB_COMMAND, ehci_register);
+}
+#endif
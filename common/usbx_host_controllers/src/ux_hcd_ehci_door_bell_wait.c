@@ -34,7 +34,7 @@
 /*  FUNCTION                                               RELEASE        */ 
 /*                                                                        */ 
 /*    _ux_hcd_ehci_door_bell_wait                         PORTABLE C      */ 
-/*                                                           6.1.10       */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -55,6 +55,7 @@
 /*                                                                        */ 
 /*  CALLS                                                                 */ 
 /*                                                                        */ 
+/*    _ux_hcd_ehci_door_bell_ring           Ring door bell                */
 /*    _ux_hcd_ehci_register_read            Read EHCI register            */ 
 /*    _ux_hcd_ehci_register_write           Write EHCI register           */ 
 /*    _ux_host_semaphore_get                Get semaphore                 */ 
@@ -74,12 +75,19 @@
 /*  01-31-2022     Chaoqiong Xiao           Modified comment(s),          */
 /*                                            refined macros names,       */
 /*                                            resulting in version 6.1.10 */
+/*  xx-xx-xxxx     Mohamed ayed             Modified comment(s),          */
+/*                                            shared batched doorbell,    */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 VOID  _ux_hcd_ehci_door_bell_wait(UX_HCD_EHCI *hcd_ehci)
 {
 
+#if defined(UX_HCD_EHCI_UNLINK_BATCH_ENABLE)
+UX_INTERRUPT_SAVE_AREA
+#else
 ULONG       ehci_register;
+#endif
 UINT        status;
     
 
@@ -88,10 +96,26 @@ UINT        status;
     if (status != UX_SUCCESS)
         return;
 
+#if defined(UX_HCD_EHCI_UNLINK_BATCH_ENABLE)
+
+    /* The interrupt handler retires the doorbell waits.  */
+    UX_DISABLE
+
+    /* Post the wait. If a doorbell is rung already, it may have been rung
+       before the caller unlinked its ED, so the wait is for the next one.  */
+    hcd_ehci -> ux_hcd_ehci_door_bell_state |=  UX_EHCI_DOOR_BELL_WAIT_PENDING;
+    if ((hcd_ehci -> ux_hcd_ehci_door_bell_state & UX_EHCI_DOOR_BELL_RUNG) == 0)
+        _ux_hcd_ehci_door_bell_ring(hcd_ehci);
+
+    /* Restore interrupts.  */
+    UX_RESTORE
+#else
+
     /* Raise the doorbell to the HCD.  */
     ehci_register =  _ux_hcd_ehci_register_read(hcd_ehci, EHCI_HCOR_USB_COMMAND);
     ehci_register |=  EHCI_HC_IO_IAAD;
     _ux_hcd_ehci_register_write(hcd_ehci, EHCI_HCOR_USB_COMMAND, ehci_register);
+#endif
 
     /* Wait for the doorbell to be awaken.  */
     _ux_host_semaphore_get_norc(&hcd_ehci -> ux_hcd_ehci_doorbell_semaphore, UX_WAIT_FOREVER);
@@ -0,0 +1,98 @@
+/***************************************************************************
+ * Copyright (c) 2024 Microsoft Corporation 
+ * 
+ * This program and the accompanying materials are made available under the
+ * terms of the MIT License which is available at
+ * https://opensource.org/licenses/MIT.
+ * 
+ * SPDX-License-Identifier: MIT
+ **************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */ 
+/** USBX Component                                                        */ 
+/**                                                                       */
+/**   EHCI Controller Driver                                              */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+
+/* Include necessary system files.  */
+
+#define UX_SOURCE_CODE
+
+#include "ux_api.h"
+#include "ux_hcd_ehci.h"
+#include "ux_host_stack.h"
+
+
+#if defined(UX_HCD_EHCI_ACTIVE_LIST_ENABLE)
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_hcd_ehci_ed_active_insert                       PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function puts an ED on the active ED list of the controller,   */
+/*    so that the done queue processing visits it until all its TDs are   */
+/*    retired. It is called after a first TD is hooked to an idle ED.     */
+/*    An ED already on the list is left in place.                         */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    hcd_ehci                              Pointer to EHCI controller    */
+/*    ed                                    Pointer to ED                 */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    EHCI Controller Driver                                              */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Mohamed ayed             Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+VOID  _ux_hcd_ehci_ed_active_insert(UX_HCD_EHCI *hcd_ehci, UX_EHCI_ED *ed)
+{
+
+UX_INTERRUPT_SAVE_AREA
+
+
+    /* The done queue processing may remove the ED at the same time.  */
+    UX_DISABLE
+
+    /* Check if the ED is on the list already.  */
+    if ((ed -> ux_ehci_ed_status & UX_EHCI_QH_ACTIVE_LIST) == 0)
+    {
+
+        /* Put the ED at the head of the active list.  */
+        ed -> REF_AS.INTR.ux_ehci_ed_next_active =  hcd_ehci -> ux_hcd_ehci_active_ed_list;
+        hcd_ehci -> ux_hcd_ehci_active_ed_list =  ed;
+
+        /* Mark the ED as listed.  */
+        ed -> ux_ehci_ed_status |=  UX_EHCI_QH_ACTIVE_LIST;
+    }
+
+    /* Restore interrupts.  */
+    UX_RESTORE
+}
+#endif
@@ -0,0 +1,124 @@
+/***************************************************************************
+ * Copyright (c) 2024 Microsoft Corporation 
+ * 
+ * This program and the accompanying materials are made available under the
+ * terms of the MIT License which is available at
+ * https://opensource.org/licenses/MIT.
+ * 
+ * SPDX-License-Identifier: MIT
+ **************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */ 
+/** USBX Component                                                        */ 
+/**                                                                       */
+/**   EHCI Controller Driver                                              */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+
+/* Include necessary system files.  */
+
+#define UX_SOURCE_CODE
+
+#include "ux_api.h"
+#include "ux_hcd_ehci.h"
+#include "ux_host_stack.h"
+
+
+#if defined(UX_HCD_EHCI_ACTIVE_LIST_ENABLE)
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_hcd_ehci_ed_active_remove                       PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function takes an ED off the active ED list of the controller. */
+/*    It is called by the done queue processing when the ED has no more   */
+/*    TDs, and when the endpoint is destroyed. The next active pointer of */
+/*    the ED is kept so that a list walk stopped on this ED can go on.    */
+/*    An ED that is not on the list is left untouched.                    */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    hcd_ehci                              Pointer to EHCI controller    */
+/*    ed                                    Pointer to ED                 */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    EHCI Controller Driver                                              */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Mohamed ayed             Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+VOID  _ux_hcd_ehci_ed_active_remove(UX_HCD_EHCI *hcd_ehci, UX_EHCI_ED *ed)
+{
+
+UX_INTERRUPT_SAVE_AREA
+
+UX_EHCI_ED      *previous_ed;
+
+
+    /* New EDs may be inserted at the head of the list at the same time.  */
+    UX_DISABLE
+
+    /* Check if the ED is on the list.  */
+    if (ed -> ux_ehci_ed_status & UX_EHCI_QH_ACTIVE_LIST)
+    {
+
+        /* Check if the ED is the head of the list.  */
+        previous_ed =  hcd_ehci -> ux_hcd_ehci_active_ed_list;
+        if (previous_ed == ed)
+
+            /* Point head to the next ED.  */
+            hcd_ehci -> ux_hcd_ehci_active_ed_list =  ed -> REF_AS.INTR.ux_ehci_ed_next_active;
+        else
+        {
+
+            /* Find the previous ED in the list.  */
+            while (previous_ed != UX_NULL)
+            {
+
+                /* The expected ED is found.  */
+                if (previous_ed -> REF_AS.INTR.ux_ehci_ed_next_active == ed)
+                {
+
+                    /* Point next to next of the ED.  */
+                    previous_ed -> REF_AS.INTR.ux_ehci_ed_next_active =  ed -> REF_AS.INTR.ux_ehci_ed_next_active;
+                    break;
+                }
+
+                /* Try next ED.  */
+                previous_ed =  previous_ed -> REF_AS.INTR.ux_ehci_ed_next_active;
+            }
+        }
+
+        /* The ED is no longer listed.  */
+        ed -> ux_ehci_ed_status &=  ~UX_EHCI_QH_ACTIVE_LIST;
+    }
+
+    /* Restore interrupts.  */
+    UX_RESTORE
+}
+#endif
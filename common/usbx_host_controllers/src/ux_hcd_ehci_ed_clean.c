@@ -34,7 +34,7 @@
 /*  FUNCTION                                               RELEASE        */ 
 /*                                                                        */ 
 /*    _ux_hcd_ehci_ed_clean                               PORTABLE C      */ 
-/*                                                           6.1          */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -46,6 +46,7 @@
 /*                                                                        */ 
 /*  INPUT                                                                 */ 
 /*                                                                        */ 
+/*    hcd_ehci                              Pointer to EHCI controller    */
 /*    ed                                    Pointer to ED                 */ 
 /*                                                                        */ 
 /*  OUTPUT                                                                */ 
@@ -54,6 +55,7 @@
 /*                                                                        */ 
 /*  CALLS                                                                 */ 
 /*                                                                        */ 
+/*    _ux_hcd_ehci_regular_td_release       Release TD                    */
 /*    _ux_utility_virtual_address           Get virtual address           */ 
 /*                                                                        */ 
 /*  CALLED BY                                                             */ 
@@ -67,9 +69,12 @@
 /*  05-19-2020     Chaoqiong Xiao           Initial Version 6.0           */
 /*  09-30-2020     Chaoqiong Xiao           Modified comment(s),          */
 /*                                            resulting in version 6.1    */
+/*  xx-xx-xxxx     Mohamed ayed             Modified comment(s),          */
+/*                                            released TDs to free list,  */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
-UINT  _ux_hcd_ehci_ed_clean(UX_EHCI_ED *ed)
+UINT  _ux_hcd_ehci_ed_clean(UX_HCD_EHCI *hcd_ehci, UX_EHCI_ED *ed)
 {
 
 UX_EHCI_TD      *td;
@@ -94,7 +99,7 @@ UX_EHCI_TD      *next_td;
         next_td =  _ux_utility_virtual_address(next_td);
 
         /* Mark the current TD as free.  */
-        td -> ux_ehci_td_status =  UX_UNUSED;
+        _ux_hcd_ehci_regular_td_release(hcd_ehci, td);
 
         td =  next_td;
     }
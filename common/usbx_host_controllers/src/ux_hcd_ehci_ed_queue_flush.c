@@ -0,0 +1,136 @@
+/***************************************************************************
+ * Copyright (c) 2024 Microsoft Corporation 
+ * 
+ * This program and the accompanying materials are made available under the
+ * terms of the MIT License which is available at
+ * https://opensource.org/licenses/MIT.
+ * 
+ * SPDX-License-Identifier: MIT
+ **************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */ 
+/** USBX Component                                                        */ 
+/**                                                                       */
+/**   EHCI Controller Driver                                              */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+
+/* Include necessary system files.  */
+
+#define UX_SOURCE_CODE
+
+#include "ux_api.h"
+#include "ux_hcd_ehci.h"
+#include "ux_host_stack.h"
+
+
+#if defined(UX_HCD_EHCI_TRANSFER_QUEUE_ENABLE)
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_hcd_ehci_ed_queue_flush                         PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function removes all the TDs queued on an ED and completes     */
+/*    every transfer request owning one of them, except the one given,    */
+/*    with the completion code given. It is used when the queue is        */
+/*    halted by an error.                                                 */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    hcd_ehci                          Pointer to EHCI controller        */
+/*    ed                                Pointer to ED                     */
+/*    transfer_request                  Transfer request not to           */
+/*                                      complete                          */
+/*    completion_code                   Completion code                   */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _ux_hcd_ehci_regular_td_release       Release TD                    */
+/*    _ux_host_semaphore_put                Put semaphore                 */
+/*    _ux_utility_virtual_address           Get virtual address           */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    EHCI Controller Driver                                              */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Mohamed ayed             Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+VOID  _ux_hcd_ehci_ed_queue_flush(UX_HCD_EHCI *hcd_ehci, UX_EHCI_ED *ed, UX_TRANSFER *transfer_request, UINT completion_code)
+{
+
+UX_INTERRUPT_SAVE_AREA
+
+UX_EHCI_TD      *td;
+UX_EHCI_TD      *next_td;
+UX_TRANSFER     *td_transfer_request;
+UX_TRANSFER     *previous_transfer_request;
+
+
+    /* Detach all the TDs from the ED. They stay marked as used until they are
+       parsed, so they can not be reused by a new transfer queued meanwhile.  */
+    UX_DISABLE
+    td =  ed -> ux_ehci_ed_first_td;
+    ed -> ux_ehci_ed_queue_element =  (UX_EHCI_TD *) UX_EHCI_TD_T;
+    ed -> ux_ehci_ed_first_td =  UX_NULL;
+    ed -> ux_ehci_ed_last_td =  UX_NULL;
+    UX_RESTORE
+
+    /* Parse the detached TDs.  */
+    previous_transfer_request =  transfer_request;
+    while (td != UX_NULL)
+    {
+
+        /* Get the next TD pointed by the current TD.  */
+        next_td =  td -> ux_ehci_td_link_pointer;
+        next_td =  (UX_EHCI_TD *) ((ULONG) next_td & ~UX_EHCI_TD_T);
+        next_td =  _ux_utility_virtual_address(next_td);
+
+        /* Get the transfer request owning this TD.  */
+        td_transfer_request =  td -> ux_ehci_td_transfer_request;
+
+        /* Mark the current TD as free.  */
+        _ux_hcd_ehci_regular_td_release(hcd_ehci, td);
+
+        /* The TDs of a transfer request are contiguous, complete the request
+           on its first TD.  */
+        if ((td_transfer_request != previous_transfer_request) &&
+            (td_transfer_request != transfer_request))
+        {
+
+            /* Update the transfer code.  */
+            td_transfer_request -> ux_transfer_request_completion_code =  completion_code;
+
+            /* We may do a call back.  */
+            if (td_transfer_request -> ux_transfer_request_completion_function != UX_NULL)
+                td_transfer_request -> ux_transfer_request_completion_function(td_transfer_request);
+
+            /* Wake up the semaphore for this request.  */
+            _ux_host_semaphore_put(&td_transfer_request -> ux_transfer_request_semaphore);
+        }
+        previous_transfer_request =  td_transfer_request;
+
+        td =  next_td;
+    }
+}
+#endif
@@ -0,0 +1,266 @@
+/***************************************************************************
+ * Copyright (c) 2024 Microsoft Corporation 
+ * 
+ * This program and the accompanying materials are made available under the
+ * terms of the MIT License which is available at
+ * https://opensource.org/licenses/MIT.
+ * 
+ * SPDX-License-Identifier: MIT
+ **************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */ 
+/** USBX Component                                                        */ 
+/**                                                                       */
+/**   EHCI Controller Driver                                              */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+
+/* Include necessary system files.  */
+
+#define UX_SOURCE_CODE
+
+#include "ux_api.h"
+#include "ux_hcd_ehci.h"
+#include "ux_host_stack.h"
+
+
+#if defined(UX_HCD_EHCI_TRANSFER_QUEUE_ENABLE)
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_hcd_ehci_ed_queue_remove                        PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function removes the TDs of an aborted transfer request from   */
+/*    the TDs queued on an ED. The transfers queued before and after it   */
+/*    stay on the ED. The ED is unlinked from the schedule and the        */
+/*    doorbell is waited before its TDs and overlay are modified. If the  */
+/*    controller was on a TD of the aborted transfer, the queue is moved  */
+/*    to the next transfer. The ED is then linked back.                   */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    hcd_ehci                          Pointer to EHCI controller        */
+/*    ed                                Pointer to ED                     */
+/*    transfer_request                  Pointer to transfer request       */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _ux_hcd_ehci_door_bell_wait           Wait for door bell            */
+/*    _ux_hcd_ehci_periodic_descriptor_link Link/unlink descriptor        */
+/*    _ux_hcd_ehci_regular_td_release       Release TD                    */
+/*    _ux_host_mutex_off                    Put mutex                     */
+/*    _ux_host_mutex_on                     Get mutex                     */
+/*    _ux_utility_physical_address          Get physical address          */
+/*    _ux_utility_virtual_address           Get virtual address           */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    EHCI Controller Driver                                              */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Mohamed ayed             Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+VOID  _ux_hcd_ehci_ed_queue_remove(UX_HCD_EHCI *hcd_ehci, UX_EHCI_ED *ed, UX_TRANSFER *transfer_request)
+{
+
+UX_INTERRUPT_SAVE_AREA
+
+UX_EHCI_TD              *td;
+UX_EHCI_TD              *next_td;
+UX_EHCI_TD              *previous_td;
+UX_EHCI_TD              *first_td;
+UX_EHCI_TD              *last_td;
+UX_EHCI_TD              *after_td;
+UX_EHCI_TD              *after_element;
+UX_EHCI_ED              *previous_ed;
+UX_EHCI_LINK_POINTER    queue_head;
+ULONG                   periodic;
+ULONG                   current_td;
+ULONG                   queue_element;
+ULONG                   td_current;
+ULONG                   td_next;
+
+
+    /* The ED is taken off the schedule while its TDs are removed, no other
+       thread must relink the EDs around it in the meantime.  */
+    _ux_host_mutex_on(&hcd_ehci -> ux_hcd_ehci_periodic_mutex);
+
+    /* The HCD thread may complete the pending transfers while we look.  */
+    UX_DISABLE
+
+    /* Check if the transfer has TDs on the ED.  */
+    td =  ed -> ux_ehci_ed_first_td;
+    while (td != UX_NULL)
+    {
+
+        /* Stop on the first TD of the transfer.  */
+        if (td -> ux_ehci_td_transfer_request == transfer_request)
+            break;
+
+        /* Get the next TD pointed by the current TD.  */
+        if ((ULONG) td -> ux_ehci_td_link_pointer & UX_EHCI_TD_T)
+            td =  UX_NULL;
+        else
+            td =  _ux_utility_virtual_address(td -> ux_ehci_td_link_pointer);
+    }
+
+    /* Restore interrupts.  */
+    UX_RESTORE
+
+    /* Nothing to do if the transfer is not queued on the ED.  */
+    if (td == UX_NULL)
+    {
+        _ux_host_mutex_off(&hcd_ehci -> ux_hcd_ehci_periodic_mutex);
+        return;
+    }
+
+    /* The controller may be executing the ED, or hold a copy of it. Its TDs
+       and overlay can only be modified once the ED is out of the schedule.  */
+    previous_ed =  ed -> ux_ehci_ed_previous_ed;
+    periodic =  ((ed -> REF_AS.INTR.ux_ehci_ed_endpoint -> ux_endpoint_descriptor.bmAttributes & UX_MASK_ENDPOINT_TYPE) == UX_INTERRUPT_ENDPOINT);
+    if (periodic)
+
+        /* Unlink the ED from the periodic list.  */
+        _ux_hcd_ehci_periodic_descriptor_link(previous_ed, UX_NULL, UX_NULL, ed -> ux_ehci_ed_queue_head);
+    else
+
+        /* Point the previous ED to the ED after this one, the software links
+           are kept to put the ED back.  */
+        previous_ed -> ux_ehci_ed_queue_head =  ed -> ux_ehci_ed_queue_head;
+
+    /* Wait for the controller to release its copy of the ED.  */
+    _ux_hcd_ehci_door_bell_wait(hcd_ehci);
+
+    /* The HCD thread may have completed transfers while we waited.  */
+    UX_DISABLE
+
+    /* Look for the TDs of the transfer, they are contiguous on the ED.  */
+    previous_td =  UX_NULL;
+    first_td =  UX_NULL;
+    last_td =  UX_NULL;
+    after_td =  UX_NULL;
+    td =  ed -> ux_ehci_ed_first_td;
+    while (td != UX_NULL)
+    {
+
+        /* Get the next TD pointed by the current TD.  */
+        if ((ULONG) td -> ux_ehci_td_link_pointer & UX_EHCI_TD_T)
+            next_td =  UX_NULL;
+        else
+            next_td =  _ux_utility_virtual_address(td -> ux_ehci_td_link_pointer);
+
+        if (td -> ux_ehci_td_transfer_request == transfer_request)
+        {
+
+            /* Remember the first and the last TD of the transfer.  */
+            if (first_td == UX_NULL)
+                first_td =  td;
+            last_td =  td;
+        }
+        else if (first_td != UX_NULL)
+        {
+
+            /* This is the first TD of the next transfer.  */
+            after_td =  td;
+            break;
+        }
+        else
+
+            /* This TD belongs to a transfer before the aborted one.  */
+            previous_td =  td;
+
+        td =  next_td;
+    }
+
+    /* The transfer may have completed before the ED was unlinked.  */
+    if (first_td != UX_NULL)
+    {
+
+        /* Get the link to the next transfer.  */
+        if (after_td == UX_NULL)
+            after_element =  (UX_EHCI_TD *) UX_EHCI_TD_T;
+        else
+            after_element =  _ux_utility_physical_address(after_td);
+
+        /* Unlink the TDs from the queue.  */
+        if (previous_td == UX_NULL)
+            ed -> ux_ehci_ed_first_td =  after_td;
+        else
+            previous_td -> ux_ehci_td_link_pointer =  after_element;
+        if (ed -> ux_ehci_ed_last_td == last_td)
+            ed -> ux_ehci_ed_last_td =  previous_td;
+
+        /* Free the TDs of the transfer, and check if the overlay is on one of
+           them or points to one of them.  */
+        current_td =  (ULONG) ed -> ux_ehci_ed_current_td;
+        queue_element =  (ULONG) ed -> ux_ehci_ed_queue_element & ~UX_EHCI_TD_T;
+        td_current =  UX_FALSE;
+        td_next =  UX_FALSE;
+        td =  first_td;
+        while (td != after_td)
+        {
+
+            /* Compare with the physical address of the TD.  */
+            if (current_td == (ULONG) _ux_utility_physical_address(td))
+                td_current =  UX_TRUE;
+            if (queue_element == (ULONG) _ux_utility_physical_address(td))
+                td_next =  UX_TRUE;
+
+            /* Get the next TD pointed by the current TD.  */
+            if ((ULONG) td -> ux_ehci_td_link_pointer & UX_EHCI_TD_T)
+                next_td =  UX_NULL;
+            else
+                next_td =  _ux_utility_virtual_address(td -> ux_ehci_td_link_pointer);
+
+            /* Mark the current TD as free.  */
+            _ux_hcd_ehci_regular_td_release(hcd_ehci, td);
+
+            td =  next_td;
+        }
+
+        /* Move the queue to the next transfer.  */
+        if ((td_current == UX_TRUE) || (td_next == UX_TRUE))
+            ed -> ux_ehci_ed_queue_element =  after_element;
+
+        /* If the overlay is on a TD of the transfer, make it inactive so that
+           the controller fetches the next TD.  */
+        if (td_current == UX_TRUE)
+            ed -> ux_ehci_ed_state &=  UX_EHCI_QH_TOGGLE;
+    }
+
+    /* Restore interrupts.  */
+    UX_RESTORE
+
+    /* Put the ED back in the schedule, the overlay is written before.  */
+    UX_DATA_MEMORY_BARRIER
+    queue_head.void_ptr =  _ux_utility_physical_address(ed);
+    queue_head.value |=  UX_EHCI_QH_TYP_QH;
+    if (periodic)
+        _ux_hcd_ehci_periodic_descriptor_link(previous_ed, queue_head.void_ptr, ed, ed -> ux_ehci_ed_queue_head);
+    else
+        previous_ed -> ux_ehci_ed_queue_head =  queue_head.ed_ptr;
+
+    /* Release the schedule.  */
+    _ux_host_mutex_off(&hcd_ehci -> ux_hcd_ehci_periodic_mutex);
+}
+#endif
@@ -0,0 +1,95 @@
+/***************************************************************************
+ * Copyright (c) 2024 Microsoft Corporation 
+ * 
+ * This program and the accompanying materials are made available under the
+ * terms of the MIT License which is available at
+ * https://opensource.org/licenses/MIT.
+ * 
+ * SPDX-License-Identifier: MIT
+ **************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */ 
+/** USBX Component                                                        */ 
+/**                                                                       */
+/**   EHCI Controller Driver                                              */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+
+/* Include necessary system files.  */
+
+#define UX_SOURCE_CODE
+
+#include "ux_api.h"
+#include "ux_hcd_ehci.h"
+#include "ux_host_stack.h"
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_hcd_ehci_fsisochronous_td_release               PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function returns a siTD to the free siTD list of the           */
+/*    controller, the next obtain takes it first. A siTD that is free     */
+/*    already is left untouched.                                          */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    hcd_ehci                              Pointer to EHCI controller    */
+/*    td                                    Pointer to siTD               */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    EHCI Controller Driver                                              */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Mohamed ayed             Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+VOID  _ux_hcd_ehci_fsisochronous_td_release(UX_HCD_EHCI *hcd_ehci, UX_EHCI_FSISO_TD *td)
+{
+
+UX_INTERRUPT_SAVE_AREA
+
+
+    /* Lockout interrupts, the free list is shared by all the users of the
+       controller.  */
+    UX_DISABLE
+
+    /* A siTD released twice is put on the free list once.  */
+    if (td -> ux_ehci_fsiso_td_status != UX_UNUSED)
+    {
+
+        /* Mark the siTD as free and put it at the head of the free list.  */
+        td -> ux_ehci_fsiso_td_status =  UX_UNUSED;
+        td -> ux_ehci_fsiso_td_next_scan_td =  hcd_ehci -> ux_hcd_ehci_fsiso_td_free_list;
+        hcd_ehci -> ux_hcd_ehci_fsiso_td_free_list =  td;
+    }
+
+    /* Restore interrupts.  */
+    UX_RESTORE
+}
+
@@ -34,7 +34,7 @@
 /*  FUNCTION                                               RELEASE        */
 /*                                                                        */
 /*    _ux_hcd_ehci_hsisochronous_td_obtain                PORTABLE C      */
-/*                                                           6.1          */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -69,6 +69,10 @@
 /*                                            verified memset and memcpy  */
 /*                                            cases,                      */
 /*                                            resulting in version 6.1    */
+/*  xx-xx-xxxx     Mohamed ayed             Modified comment(s),          */
+/*                                            used free list,             */
+/*                                            counted exhaustion,         */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UX_EHCI_HSISO_TD  *_ux_hcd_ehci_hsisochronous_td_obtain(UX_HCD_EHCI *hcd_ehci)
@@ -80,40 +84,45 @@ UX_EHCI_HSISO_TD  *_ux_hcd_ehci_hsisochronous_td_obtain(UX_HCD_EHCI *hcd_ehci)
     return(UX_NULL);
 #else
 
+UX_INTERRUPT_SAVE_AREA
+
 UX_EHCI_HSISO_TD    *td;
-ULONG               td_index;
 
 
-    /* Start the search from the beginning of the list.  */
-    td =  hcd_ehci -> ux_hcd_ehci_hsiso_td_list;
-    for (td_index = 0; td_index < _ux_system_host -> ux_system_host_max_iso_td; td_index++)
+    /* Lockout interrupts, the free list is shared by all the users of the
+       controller.  */
+    UX_DISABLE
+
+    /* Take the TD at the head of the free TD list.  */
+    td =  hcd_ehci -> ux_hcd_ehci_hsiso_td_free_list;
+    if (td == UX_NULL)
     {
 
-        /* Check the TD status, a free TD is marked with the USED flag.  */
-        if (td -> ux_ehci_hsiso_td_status == UX_UNUSED)
-        {
+        /* There is no available TD in the TD list, count it for diagnostics.  */
+        hcd_ehci -> ux_hcd_ehci_hsiso_td_obtain_failures++;
 
-            /* The TD may have been used, so we reset all fields.  */
-            _ux_utility_memory_set(td, 0, sizeof(UX_EHCI_HSISO_TD)); /* Use case of memset is verified. */
+        /* Restore interrupts.  */
+        UX_RESTORE
 
-            /* This TD is now marked as USED.  */
-            td -> ux_ehci_hsiso_td_status =  UX_USED;
+        /* Error, return a null.  */
+        return(UX_NULL);
+    }
+    hcd_ehci -> ux_hcd_ehci_hsiso_td_free_list =  td -> ux_ehci_hsiso_td_next_scan_td;
 
-            /* Initialize the link pointer TD fields.  */
-            td -> ux_ehci_hsiso_td_next_lp.value = UX_EHCI_HSISO_T;
+    /* The TD may have been used, so we reset all fields.  */
+    _ux_utility_memory_set(td, 0, sizeof(UX_EHCI_HSISO_TD)); /* Use case of memset is verified. */
 
-            /* Success, return TD pointer.  */
-            return(td);
-        }
+    /* This TD is now marked as USED.  */
+    td -> ux_ehci_hsiso_td_status =  UX_USED;
 
-        /* Look at next TD.  */
-        td++;
-    }
+    /* Restore interrupts.  */
+    UX_RESTORE
 
-    /* There is no available TD in the TD list.  */
+    /* Initialize the link pointer TD fields.  */
+    td -> ux_ehci_hsiso_td_next_lp.value = UX_EHCI_HSISO_T;
 
-    /* Error, return a null.  */
-    return(UX_NULL);
+    /* Success, return TD pointer.  */
+    return(td);
 #endif
 }
 
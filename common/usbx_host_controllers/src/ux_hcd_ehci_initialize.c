@@ -59,7 +59,7 @@
 /*  FUNCTION                                               RELEASE        */
 /*                                                                        */
 /*    _ux_hcd_ehci_initialize                             PORTABLE C      */
-/*                                                           6.1.11       */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -116,6 +116,12 @@
 /*  04-25-2022     Chaoqiong Xiao           Modified comment(s),          */
 /*                                            fixed standalone compile,   */
 /*                                            resulting in version 6.1.11 */
+/*  xx-xx-xxxx     Mohamed ayed             Modified comment(s),          */
+/*                                            allocated short packet TD,  */
+/*                                            set interrupt threshold,    */
+/*                                            seeded descriptor free      */
+/*                                            lists,                      */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_hcd_ehci_initialize(UX_HCD *hcd)
@@ -130,6 +136,7 @@ UX_EHCI_ED              *ed;
 UX_EHCI_LINK_POINTER    lp;
 ULONG                   ehci_register;
 ULONG                   port_index;
+ULONG                   descriptor_index;
 UINT                    status = UX_SUCCESS;
 
 
@@ -252,6 +259,36 @@ UINT                    status = UX_SUCCESS;
     }
 #endif
 
+    /* Put all the descriptors on the free lists of the controller.  */
+    if (status == UX_SUCCESS)
+    {
+        for (descriptor_index = _ux_system_host -> ux_system_host_max_ed; descriptor_index > 0; descriptor_index --)
+        {
+            ed =  hcd_ehci -> ux_hcd_ehci_ed_list + descriptor_index - 1;
+            ed -> REF_AS.FREE.ux_ehci_ed_next_free =  hcd_ehci -> ux_hcd_ehci_ed_free_list;
+            hcd_ehci -> ux_hcd_ehci_ed_free_list =  ed;
+        }
+        for (descriptor_index = _ux_system_host -> ux_system_host_max_td; descriptor_index > 0; descriptor_index --)
+        {
+            hcd_ehci -> ux_hcd_ehci_td_list[descriptor_index - 1].ux_ehci_td_next_free =  hcd_ehci -> ux_hcd_ehci_td_free_list;
+            hcd_ehci -> ux_hcd_ehci_td_free_list =  &hcd_ehci -> ux_hcd_ehci_td_list[descriptor_index - 1];
+        }
+#if UX_MAX_ISO_TD != 0 && defined(UX_HCD_EHCI_SPLIT_TRANSFER_ENABLE)
+        for (descriptor_index = _ux_system_host -> ux_system_host_max_iso_td; descriptor_index > 0; descriptor_index --)
+        {
+            hcd_ehci -> ux_hcd_ehci_fsiso_td_list[descriptor_index - 1].ux_ehci_fsiso_td_next_scan_td =  hcd_ehci -> ux_hcd_ehci_fsiso_td_free_list;
+            hcd_ehci -> ux_hcd_ehci_fsiso_td_free_list =  &hcd_ehci -> ux_hcd_ehci_fsiso_td_list[descriptor_index - 1];
+        }
+#endif
+#if UX_MAX_ISO_TD != 0
+        for (descriptor_index = _ux_system_host -> ux_system_host_max_iso_td; descriptor_index > 0; descriptor_index --)
+        {
+            hcd_ehci -> ux_hcd_ehci_hsiso_td_list[descriptor_index - 1].ux_ehci_hsiso_td_next_scan_td =  hcd_ehci -> ux_hcd_ehci_hsiso_td_free_list;
+            hcd_ehci -> ux_hcd_ehci_hsiso_td_free_list =  &hcd_ehci -> ux_hcd_ehci_hsiso_td_list[descriptor_index - 1];
+        }
+#endif
+    }
+
     /* Initialize the periodic tree.  */
     if (status == UX_SUCCESS)
         status =  _ux_hcd_ehci_periodic_tree_create(hcd_ehci);
@@ -296,6 +333,18 @@ UINT                    status = UX_SUCCESS;
             status = (UX_NO_ED_AVAILABLE);
     }
 
+#if defined(UX_HCD_EHCI_BULK_CHAIN_ENABLE)
+    if (status == UX_SUCCESS)
+    {
+
+        /* We need one inactive TD, the queue of an IN transfer stops on it
+           when a short packet is received.  */
+        hcd_ehci -> ux_hcd_ehci_short_td =  _ux_hcd_ehci_regular_td_obtain(hcd_ehci);
+        if (hcd_ehci -> ux_hcd_ehci_short_td == UX_NULL)
+            status = (UX_NO_TD_AVAILABLE);
+    }
+#endif
+
     if (status == UX_SUCCESS)
     {
 
@@ -320,6 +369,10 @@ UINT                    status = UX_SUCCESS;
         /* Set the EHCI Interrupt threshold default value (1 or 8 per ms)
         and the size of the frame list.  */
         _ux_hcd_ehci_register_write(hcd_ehci, EHCI_HCOR_USB_COMMAND, EHCI_HC_IO_ITC);
+#if defined(UX_HCD_EHCI_INTERRUPT_THRESHOLD_ENABLE)
+        hcd_ehci -> ux_hcd_ehci_interrupt_threshold =  UX_HCD_EHCI_INTERRUPT_THRESHOLD_DEFAULT;
+        hcd_ehci -> ux_hcd_ehci_interrupt_threshold_current =  UX_HCD_EHCI_INTERRUPT_THRESHOLD_DEFAULT;
+#endif
 
         /* Get the number of ports on the controller. The number of ports
         needs to be reflected both for the generic HCD container and the
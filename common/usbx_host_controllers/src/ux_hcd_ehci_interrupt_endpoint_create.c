@@ -34,7 +34,7 @@
 /*  FUNCTION                                               RELEASE        */ 
 /*                                                                        */ 
 /*    _ux_hcd_ehci_interrupt_endpoint_create              PORTABLE C      */ 
-/*                                                           6.3.0        */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -60,6 +60,9 @@
 /*    interval required. At that node, we anchor our real ED to the node  */ 
 /*    and link the ED that was attached to the node to our ED.            */ 
 /*                                                                        */ 
+/*    If the host stack periodic schedule is enabled, the list and the    */
+/*    start micro-frame are the ones chosen by the schedule.              */
+/*                                                                        */
 /*  INPUT                                                                 */ 
 /*                                                                        */ 
 /*    hcd_ehci                              Pointer to EHCI controller    */ 
@@ -72,7 +75,9 @@
 /*  CALLS                                                                 */ 
 /*                                                                        */ 
 /*    _ux_hcd_ehci_ed_obtain                Obtain an ED                  */ 
+/*    _ux_hcd_ehci_ed_release               Release ED                    */
 /*    _ux_hcd_ehci_least_traffic_list_get   Get least traffic list        */ 
+/*    _ux_hcd_ehci_periodic_list_get        Get list of a frame           */
 /*    _ux_hcd_ehci_poll_rate_entry_get      Get anchor for poll rate      */
 /*    _ux_utility_physical_address          Get physical address          */ 
 /*    _ux_host_mutex_on                     Get mutex                     */
@@ -106,6 +111,11 @@
 /*  10-31-2023     Chaoqiong Xiao           Modified comment(s),          */
 /*                                            fixed split transfer issue, */
 /*                                            resulting in version 6.3.0  */
+/*  xx-xx-xxxx     Mohamed ayed             Modified comment(s),          */
+/*                                            used stack periodic         */
+/*                                            schedule placement,         */
+/*                                            released ED to free list,   */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_hcd_ehci_interrupt_endpoint_create(UX_HCD_EHCI *hcd_ehci, UX_ENDPOINT *endpoint)
@@ -256,8 +266,16 @@ UINT                            i;
     /* We are now updating the periodic list.  */
     _ux_host_mutex_on(&hcd_ehci -> ux_hcd_ehci_periodic_mutex);
 
+#if defined(UX_HOST_PERIODIC_SCHEDULE_ENABLE)
+
+    /* Get the list of the frame chosen by the host stack periodic schedule.  */
+    ed_list =  _ux_hcd_ehci_periodic_list_get(hcd_ehci, (ULONG)endpoint -> ux_endpoint_schedule_offset >> 3,
+                                              microframe_load, microframe_ssplit_count);
+#else
+
     /* Get the list index with the least traffic.  */
     ed_list =  _ux_hcd_ehci_least_traffic_list_get(hcd_ehci, microframe_load, microframe_ssplit_count);
+#endif
 
     /* Now we need to scan the list of eds from the lowest load entry until we reach the 
        appropriate interval node. The depth index is the interval EHCI value and the 
@@ -270,9 +288,17 @@ UINT                            i;
     /* Calculate packet size with num transactions.  */
     max_packet_size *= num_transaction;
 
+#if defined(UX_HOST_PERIODIC_SCHEDULE_ENABLE)
+
+    /* The start micro-frame is chosen by the host stack periodic schedule,
+       only check the transaction loads of that micro-frame.  */
+    for (i = endpoint -> ux_endpoint_schedule_offset & 7u; i < interval; i = interval)
+#else
+
     /* Go through the transaction loads for start
        index of micro-frame.  */
     for (i = 0; i < interval; i ++)
+#endif
     {
 
         /* Skip if load too much.  */
@@ -302,7 +328,7 @@ UINT                            i;
     if (i >= interval)
     {
         _ux_host_mutex_off(&hcd_ehci -> ux_hcd_ehci_periodic_mutex);
-        ed -> ux_ehci_ed_status = UX_UNUSED;
+        _ux_hcd_ehci_ed_release(hcd_ehci, ed);
         return(UX_NO_BANDWIDTH_AVAILABLE);
     }
 
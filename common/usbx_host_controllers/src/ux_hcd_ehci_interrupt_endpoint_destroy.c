@@ -34,7 +34,7 @@
 /*  FUNCTION                                               RELEASE        */
 /*                                                                        */
 /*    _ux_hcd_ehci_interrupt_endpoint_destroy             PORTABLE C      */
-/*                                                           6.1.11       */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -55,6 +55,8 @@
 /*  CALLS                                                                 */
 /*                                                                        */
 /*    _ux_hcd_ehci_door_bell_wait           Setup doorbell wait           */
+/*    _ux_hcd_ehci_ed_active_remove         Remove ED from active list    */
+/*    _ux_hcd_ehci_ed_release               Release ED                    */
 /*    _ux_utility_physical_address          Get physical address          */
 /*    _ux_host_mutex_on                     Get mutex                     */
 /*    _ux_host_mutex_off                    Put mutex                     */
@@ -81,6 +83,10 @@
 /*  04-25-2022     Chaoqiong Xiao           Modified comment(s),          */
 /*                                            fixed standalone compile,   */
 /*                                            resulting in version 6.1.11 */
+/*  xx-xx-xxxx     Mohamed ayed             Modified comment(s),          */
+/*                                            removed from active list,   */
+/*                                            released ED to free list,   */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_hcd_ehci_interrupt_endpoint_destroy(UX_HCD_EHCI *hcd_ehci, UX_ENDPOINT *endpoint)
@@ -132,6 +138,12 @@ ULONG                         max_packet_size;
         }
     }
 
+#if defined(UX_HCD_EHCI_ACTIVE_LIST_ENABLE)
+
+    /* Take the ED off the active list.  */
+    _ux_hcd_ehci_ed_active_remove(hcd_ehci, ed);
+#endif
+
     /* Update micro-frame loads of anchor.  */
 
     /* Calculate max packet size.  */
@@ -198,7 +210,7 @@ ULONG                         max_packet_size;
     _ux_hcd_ehci_door_bell_wait(hcd_ehci);
 
     /* Now we can safely make the ED free.  */
-    ed -> ux_ehci_ed_status =  UX_UNUSED;
+    _ux_hcd_ehci_ed_release(hcd_ehci, ed);
 
     /* Return successful completion.  */
     return(UX_SUCCESS);
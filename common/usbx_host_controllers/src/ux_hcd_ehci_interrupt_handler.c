@@ -34,7 +34,7 @@
 /*  FUNCTION                                               RELEASE        */ 
 /*                                                                        */ 
 /*    _ux_hcd_ehci_interrupt_handler                      PORTABLE C      */ 
-/*                                                           6.1.10       */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -63,6 +63,7 @@
 /*  CALLS                                                                 */ 
 /*                                                                        */ 
 /*    _ux_hcd_ehci_controller_disable       Disable controller            */ 
+/*    _ux_hcd_ehci_door_bell_process        Process door bell             */
 /*    _ux_hcd_ehci_register_read            Read EHCI register            */ 
 /*    _ux_hcd_ehci_register_write           Write EHCI register           */ 
 /*    _ux_host_semaphore_put                Put semaphore                 */ 
@@ -81,6 +82,11 @@
 /*  01-31-2022     Chaoqiong Xiao           Modified comment(s),          */
 /*                                            refined macros names,       */
 /*                                            resulting in version 6.1.10 */
+/*  xx-xx-xxxx     Mohamed ayed             Modified comment(s),          */
+/*                                            used HCD thread signal,     */
+/*                                            counted transfer interrupts,*/
+/*                                            retired batched unlinks,    */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 VOID  _ux_hcd_ehci_interrupt_handler(VOID)
@@ -128,8 +134,13 @@ ULONG           port_index;
 
                     /* We have some transactions done in the past frame/micro-frame.
                        The controller thread needs to wake up and process them.  */
-                    hcd -> ux_hcd_thread_signal++;
-                    _ux_host_semaphore_put(&_ux_system_host -> ux_system_host_hcd_semaphore);
+                    UX_HOST_HCD_THREAD_SIGNAL(hcd);
+
+#if defined(UX_HCD_EHCI_INTERRUPT_THRESHOLD_ENABLE)
+
+                    /* Count the transfer interrupts for the interrupt rate.  */
+                    hcd_ehci -> ux_hcd_ehci_transfer_interrupt_count++;
+#endif
                 }
                     
                 if (ehci_register & EHCI_HC_STS_HSE)
@@ -138,10 +149,8 @@ ULONG           port_index;
                     /* The controller has issued a Host System Error which is fatal.
                        The controller will be reset now, and we wake up the HCD thread.  */
                     _ux_hcd_ehci_controller_disable(hcd_ehci);
-                    hcd -> ux_hcd_thread_signal++;
                     hcd -> ux_hcd_status =  UX_HCD_STATUS_DEAD;
-                    hcd -> ux_hcd_thread_signal++;
-                    _ux_host_semaphore_put(&_ux_system_host -> ux_system_host_hcd_semaphore);
+                    UX_HOST_HCD_THREAD_SIGNAL(hcd);
 
                     /* Error trap. */
                     _ux_system_error_handler(UX_SYSTEM_LEVEL_INTERRUPT, UX_SYSTEM_CONTEXT_HCD, UX_CONTROLLER_DEAD);
@@ -182,9 +191,17 @@ ULONG           port_index;
                 if (ehci_register & EHCI_HC_STS_IAA)
                 {
 
+#if defined(UX_HCD_EHCI_UNLINK_BATCH_ENABLE)
+
+                    /* The controller has issued a Door Bell status change signal.
+                       We need to retire the EDs and the waits behind the doorbell.  */
+                    _ux_hcd_ehci_door_bell_process(hcd_ehci);
+#else
+
                     /* The controller has issued a Door Bell status change signal.  
                        We need to resume the thread who raised the doorbell.  */
                     _ux_host_semaphore_put(&hcd_ehci -> ux_hcd_ehci_doorbell_semaphore);
+#endif
                 }
             }
         }
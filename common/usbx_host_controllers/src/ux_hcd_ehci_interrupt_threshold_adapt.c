@@ -0,0 +1,176 @@
+/***************************************************************************
+ * Copyright (c) 2024 Microsoft Corporation 
+ * 
+ * This program and the accompanying materials are made available under the
+ * terms of the MIT License which is available at
+ * https://opensource.org/licenses/MIT.
+ * 
+ * SPDX-License-Identifier: MIT
+ **************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */ 
+/** USBX Component                                                        */ 
+/**                                                                       */
+/**   EHCI Controller Driver                                              */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+
+/* Include necessary system files.  */
+
+#define UX_SOURCE_CODE
+
+#include "ux_api.h"
+#include "ux_hcd_ehci.h"
+#include "ux_host_stack.h"
+
+
+#if defined(UX_HCD_EHCI_INTERRUPT_THRESHOLD_ENABLE)
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_hcd_ehci_interrupt_threshold_adapt              PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function adapts the interrupt threshold of an EHCI controller  */
+/*    in adaptive mode. At the end of each window of                      */
+/*    UX_HCD_EHCI_INTERRUPT_THRESHOLD_WINDOW ms, the threshold is raised  */
+/*    to UX_HCD_EHCI_INTERRUPT_THRESHOLD_MAX if the window transferred    */
+/*    UX_HCD_EHCI_INTERRUPT_THRESHOLD_BULK_BYTES or more per window       */
+/*    length, and set back to the default threshold otherwise. A window   */
+/*    ends on the next done queue processing, so the bytes are divided    */
+/*    by the time elapsed. It never exceeds the interval of               */
+/*    an interrupt endpoint, and is 1 when isochronous endpoints exist.   */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    hcd_ehci                              Pointer to EHCI controller    */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _ux_hcd_ehci_register_read            Read EHCI register            */
+/*    _ux_hcd_ehci_register_write           Write EHCI register           */
+/*    _ux_host_mutex_on                     Get mutex                     */
+/*    _ux_host_mutex_off                    Put mutex                     */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    EHCI Controller Driver                                              */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Mohamed ayed             Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+VOID  _ux_hcd_ehci_interrupt_threshold_adapt(UX_HCD_EHCI *hcd_ehci)
+{
+
+UX_INTERRUPT_SAVE_AREA
+
+UX_EHCI_ED      *ed;
+UX_ENDPOINT     *endpoint;
+ULONG           frame_number;
+ULONG           elapsed;
+ULONG           threshold;
+ULONG           interval;
+ULONG           ehci_register;
+
+
+    /* Nothing to do if the threshold is fixed.  */
+    if (hcd_ehci -> ux_hcd_ehci_interrupt_threshold != UX_HCD_EHCI_INTERRUPT_THRESHOLD_ADAPTIVE)
+        return;
+
+    /* Read the frame number, in ms.  */
+    ehci_register =  _ux_hcd_ehci_register_read(hcd_ehci, EHCI_HCOR_FRAME_INDEX);
+    frame_number =  (ehci_register >> 3) & 0x3ff;
+
+    /* Check if the window is over.  */
+    elapsed =  (frame_number - hcd_ehci -> ux_hcd_ehci_interrupt_threshold_window_start) & 0x3ff;
+    if (elapsed < UX_HCD_EHCI_INTERRUPT_THRESHOLD_WINDOW)
+        return;
+
+    /* A sustained bulk load raises the threshold. The window may have lasted
+       longer than expected, the load is compared per ms.  */
+    if ((hcd_ehci -> ux_hcd_ehci_interrupt_threshold_window_bytes / elapsed) >=
+        (UX_HCD_EHCI_INTERRUPT_THRESHOLD_BULK_BYTES / UX_HCD_EHCI_INTERRUPT_THRESHOLD_WINDOW))
+        threshold =  UX_HCD_EHCI_INTERRUPT_THRESHOLD_MAX;
+    else
+        threshold =  UX_HCD_EHCI_INTERRUPT_THRESHOLD_DEFAULT;
+
+    /* Start a new window.  */
+    hcd_ehci -> ux_hcd_ehci_interrupt_threshold_window_start =  frame_number;
+    hcd_ehci -> ux_hcd_ehci_interrupt_threshold_window_bytes =  0;
+
+    /* Isochronous endpoints need the shortest latency.  */
+    if ((hcd_ehci -> ux_hcd_ehci_hsiso_scan_list != UX_NULL) ||
+        (hcd_ehci -> ux_hcd_ehci_fsiso_scan_list != UX_NULL))
+        threshold =  1;
+
+    /* An interrupt endpoint must not wait more than its interval.  */
+    _ux_host_mutex_on(&hcd_ehci -> ux_hcd_ehci_periodic_mutex);
+    ed =  hcd_ehci -> ux_hcd_ehci_interrupt_ed_list;
+    while ((ed != UX_NULL) && (threshold > 1))
+    {
+
+        /* Get the interval in micro-frames.  */
+        endpoint =  ed -> REF_AS.INTR.ux_ehci_ed_endpoint;
+        interval =  endpoint -> ux_endpoint_descriptor.bInterval;
+        if (endpoint -> ux_endpoint_device -> ux_device_speed == UX_HIGH_SPEED_DEVICE)
+        {
+
+            /* The interval is 2^(bInterval-1) micro-frames.  */
+            if (interval > 8)
+                interval =  8;
+            if (interval > 0)
+                interval =  1u << (interval - 1);
+        }
+        else
+
+            /* The interval is in frames.  */
+            interval <<=  3;
+
+        /* Keep the threshold a power of 2 within the interval.  */
+        while ((threshold > 1) && (threshold > interval))
+            threshold >>=  1;
+
+        /* Next ED.  */
+        ed =  ed -> ux_ehci_ed_next_ed;
+    }
+    _ux_host_mutex_off(&hcd_ehci -> ux_hcd_ehci_periodic_mutex);
+
+    /* Check if the threshold changes.  */
+    if (threshold == hcd_ehci -> ux_hcd_ehci_interrupt_threshold_current)
+        return;
+
+    /* The command register is also updated by the doorbell.  */
+    UX_DISABLE
+
+    /* Update the interrupt threshold control of the command register.  */
+    ehci_register =  _ux_hcd_ehci_register_read(hcd_ehci, EHCI_HCOR_USB_COMMAND);
+    ehci_register &=  ~EHCI_HC_IO_ITC_MASK;
+    ehci_register |=  threshold << EHCI_HC_IO_ITC_LOC;
+    _ux_hcd_ehci_register_write(hcd_ehci, EHCI_HCOR_USB_COMMAND, ehci_register);
+
+    /* This is the threshold in use now.  */
+    hcd_ehci -> ux_hcd_ehci_interrupt_threshold_current =  threshold;
+
+    /* Restore interrupts.  */
+    UX_RESTORE
+}
+#endif
@@ -0,0 +1,109 @@
+/***************************************************************************
+ * Copyright (c) 2024 Microsoft Corporation 
+ * 
+ * This program and the accompanying materials are made available under the
+ * terms of the MIT License which is available at
+ * https://opensource.org/licenses/MIT.
+ * 
+ * SPDX-License-Identifier: MIT
+ **************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */ 
+/** USBX Component                                                        */ 
+/**                                                                       */
+/**   EHCI Controller Driver                                              */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+
+/* Include necessary system files.  */
+
+#define UX_SOURCE_CODE
+
+#include "ux_api.h"
+#include "ux_hcd_ehci.h"
+#include "ux_host_stack.h"
+
+
+#if defined(UX_HCD_EHCI_INTERRUPT_THRESHOLD_ENABLE)
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_hcd_ehci_interrupt_threshold_get                PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function returns the interrupt threshold in use on an EHCI     */
+/*    controller, and the number of transfer interrupts per MB of bulk,   */
+/*    control and interrupt data transferred since the threshold was     */
+/*    last set. Until a MB is transferred there is no rate, 0 is          */
+/*    returned.                                                           */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    hcd                                   Pointer to HCD                */
+/*    threshold                             Destination for threshold in  */
+/*                                          micro-frames, may be NULL     */
+/*    interrupts_per_mbyte                  Destination for interrupts    */
+/*                                          per MB, may be NULL           */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    Completion Status                                                   */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    Application                                                         */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Mohamed ayed             Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+UINT  _ux_hcd_ehci_interrupt_threshold_get(UX_HCD *hcd, ULONG *threshold, ULONG *interrupts_per_mbyte)
+{
+
+UX_HCD_EHCI     *hcd_ehci;
+
+
+    /* Check if the controller is an operational EHCI controller.  */
+    if ((hcd -> ux_hcd_controller_type != UX_EHCI_CONTROLLER) ||
+        (hcd -> ux_hcd_status != UX_HCD_STATUS_OPERATIONAL))
+        return(UX_CONTROLLER_UNKNOWN);
+
+    /* Get the EHCI controller.  */
+    hcd_ehci =  (UX_HCD_EHCI *) hcd -> ux_hcd_controller_hardware;
+
+    /* Return the threshold in use.  */
+    if (threshold != UX_NULL)
+        *threshold =  hcd_ehci -> ux_hcd_ehci_interrupt_threshold_current;
+
+    /* Return the interrupt rate.  */
+    if (interrupts_per_mbyte != UX_NULL)
+    {
+        if (hcd_ehci -> ux_hcd_ehci_transfer_mbytes == 0)
+            *interrupts_per_mbyte =  0;
+        else
+            *interrupts_per_mbyte =  hcd_ehci -> ux_hcd_ehci_transfer_interrupt_count /
+                                     hcd_ehci -> ux_hcd_ehci_transfer_mbytes;
+    }
+
+    /* Return successful completion.  */
+    return(UX_SUCCESS);
+}
+#endif
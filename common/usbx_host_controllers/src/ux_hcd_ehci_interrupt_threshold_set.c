@@ -0,0 +1,135 @@
+/***************************************************************************
+ * Copyright (c) 2024 Microsoft Corporation 
+ * 
+ * This program and the accompanying materials are made available under the
+ * terms of the MIT License which is available at
+ * https://opensource.org/licenses/MIT.
+ * 
+ * SPDX-License-Identifier: MIT
+ **************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */ 
+/** USBX Component                                                        */ 
+/**                                                                       */
+/**   EHCI Controller Driver                                              */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+
+/* Include necessary system files.  */
+
+#define UX_SOURCE_CODE
+
+#include "ux_api.h"
+#include "ux_hcd_ehci.h"
+#include "ux_host_stack.h"
+
+
+#if defined(UX_HCD_EHCI_INTERRUPT_THRESHOLD_ENABLE)
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_hcd_ehci_interrupt_threshold_set                PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function sets the interrupt threshold of an EHCI controller,   */
+/*    in micro-frames. The controller then issues transfer interrupts at  */
+/*    most once per threshold. In adaptive mode (threshold 0), the done   */
+/*    queue processing adapts the threshold to the load, starting from    */
+/*    the default threshold. The interrupt rate returned by               */
+/*    ux_hcd_ehci_interrupt_threshold_get is measured again from here.    */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    hcd                                   Pointer to HCD                */
+/*    threshold                             Threshold in micro-frames     */
+/*                                          (1, 2, 4, 8, 16, 32, 64) or   */
+/*                                          adaptive (0)                  */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    Completion Status                                                   */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _ux_hcd_ehci_register_read            Read EHCI register            */
+/*    _ux_hcd_ehci_register_write           Write EHCI register           */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    Application                                                         */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Mohamed ayed             Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+UINT  _ux_hcd_ehci_interrupt_threshold_set(UX_HCD *hcd, ULONG threshold)
+{
+
+UX_INTERRUPT_SAVE_AREA
+
+UX_HCD_EHCI     *hcd_ehci;
+ULONG           ehci_register;
+
+
+    /* Check if the controller is an operational EHCI controller.  */
+    if ((hcd -> ux_hcd_controller_type != UX_EHCI_CONTROLLER) ||
+        (hcd -> ux_hcd_status != UX_HCD_STATUS_OPERATIONAL))
+        return(UX_CONTROLLER_UNKNOWN);
+
+    /* The threshold must be a power of 2, up to 64 micro-frames.  */
+    if ((threshold > 64) || (threshold & (threshold - 1)))
+        return(UX_INVALID_PARAMETER);
+
+    /* Get the EHCI controller.  */
+    hcd_ehci =  (UX_HCD_EHCI *) hcd -> ux_hcd_controller_hardware;
+
+    /* Keep the threshold requested.  */
+    hcd_ehci -> ux_hcd_ehci_interrupt_threshold =  threshold;
+
+    /* In adaptive mode, start from the default threshold with a new window.  */
+    if (threshold == UX_HCD_EHCI_INTERRUPT_THRESHOLD_ADAPTIVE)
+    {
+        threshold =  UX_HCD_EHCI_INTERRUPT_THRESHOLD_DEFAULT;
+        ehci_register =  _ux_hcd_ehci_register_read(hcd_ehci, EHCI_HCOR_FRAME_INDEX);
+        hcd_ehci -> ux_hcd_ehci_interrupt_threshold_window_start =  (ehci_register >> 3) & 0x3ff;
+        hcd_ehci -> ux_hcd_ehci_interrupt_threshold_window_bytes =  0;
+    }
+
+    /* The command register is also updated by the doorbell.  */
+    UX_DISABLE
+
+    /* Update the interrupt threshold control of the command register.  */
+    ehci_register =  _ux_hcd_ehci_register_read(hcd_ehci, EHCI_HCOR_USB_COMMAND);
+    ehci_register &=  ~EHCI_HC_IO_ITC_MASK;
+    ehci_register |=  threshold << EHCI_HC_IO_ITC_LOC;
+    _ux_hcd_ehci_register_write(hcd_ehci, EHCI_HCOR_USB_COMMAND, ehci_register);
+
+    /* This is the threshold in use now.  */
+    hcd_ehci -> ux_hcd_ehci_interrupt_threshold_current =  threshold;
+
+    /* The interrupt rate is measured again for this threshold.  */
+    hcd_ehci -> ux_hcd_ehci_transfer_interrupt_count =  0;
+    hcd_ehci -> ux_hcd_ehci_transfer_bytes =  0;
+    hcd_ehci -> ux_hcd_ehci_transfer_mbytes =  0;
+
+    /* Restore interrupts.  */
+    UX_RESTORE
+
+    /* Return successful completion.  */
+    return(UX_SUCCESS);
+}
+#endif
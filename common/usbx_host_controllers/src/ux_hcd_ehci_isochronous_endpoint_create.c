@@ -34,7 +34,7 @@
 /*  FUNCTION                                               RELEASE        */
 /*                                                                        */
 /*    _ux_hcd_ehci_isochronous_endpoint_create            PORTABLE C      */
-/*                                                           6.3.0        */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -54,10 +54,12 @@
 /*                                                                        */
 /*  CALLS                                                                 */
 /*                                                                        */
+/*    _ux_hcd_ehci_hsisochronous_td_release Release iTD                   */
 /*    _ux_utility_memory_allocate           Allocate memory               */
 /*    _ux_utility_memory_free               Free memory                   */
 /*    _ux_hcd_ehci_hsisochronous_td_obtain  Obtain a TD                   */
 /*    _ux_hcd_ehci_least_traffic_list_get   Get least traffic list        */
+/*    _ux_hcd_ehci_periodic_list_get        Get list of a frame           */
 /*    _ux_hcd_ehci_poll_rate_entry_get      Get anchor for poll rate      */
 /*    _ux_utility_physical_address          Get physical address          */
 /*    _ux_host_mutex_on                     Get mutex                     */
@@ -91,6 +93,11 @@
 /*                                            fixed split transfer issue, */
 /*                                            fixed compile warnings,     */
 /*                                            resulting in version 6.3.0  */
+/*  xx-xx-xxxx     Mohamed ayed             Modified comment(s),          */
+/*                                            used stack periodic         */
+/*                                            schedule placement,         */
+/*                                            released TDs to free list,  */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_hcd_ehci_isochronous_endpoint_create(UX_HCD_EHCI *hcd_ehci, UX_ENDPOINT *endpoint)
@@ -245,7 +252,7 @@ UINT                            status;
         if (status != UX_SUCCESS)
         {
             for (i = 0; i < ed -> ux_ehci_hsiso_ed_nb_tds; i ++)
-                ed -> ux_ehci_hsiso_ed_fr_td[i] -> ux_ehci_hsiso_td_status = UX_UNUSED;
+                _ux_hcd_ehci_hsisochronous_td_release(hcd_ehci, ed -> ux_ehci_hsiso_ed_fr_td[i]);
             _ux_utility_memory_free(ed);
             return(status);
         }
@@ -336,8 +343,16 @@ UINT                            status;
     /* Lock the periodic list to update.  */
     _ux_host_mutex_on(&hcd_ehci -> ux_hcd_ehci_periodic_mutex);
 
+#if defined(UX_HOST_PERIODIC_SCHEDULE_ENABLE)
+
+    /* Get the list of the frame chosen by the host stack periodic schedule.  */
+    ed_list = _ux_hcd_ehci_periodic_list_get(hcd_ehci, (ULONG)endpoint -> ux_endpoint_schedule_offset >> 3,
+                                             microframe_load, microframe_ssplit_count);
+#else
+
     /* Get the list index with the least traffic.  */
     ed_list = _ux_hcd_ehci_least_traffic_list_get(hcd_ehci, microframe_load, microframe_ssplit_count);
+#endif
 
     /* Now we need to scan the list of EDs from the lowest load entry until we reach the
        appropriate interval node. The depth index is the interval EHCI value and the
@@ -347,9 +362,17 @@ UINT                            status;
     /* Calculate packet size with num transactions.  */
     max_packet_size *= mult;
 
+#if defined(UX_HOST_PERIODIC_SCHEDULE_ENABLE)
+
+    /* The start micro-frame is chosen by the host stack periodic schedule,
+       only check the transaction loads of that micro-frame.  */
+    for (microframe_i = endpoint -> ux_endpoint_schedule_offset & 7u; microframe_i < interval; microframe_i = interval)
+#else
+
     /* Go through the transaction loads for for start
        index of micro-frame.  */
     for (microframe_i = 0; microframe_i < interval; microframe_i ++)
+#endif
     {
 
         /* Skip if load too much.  */
@@ -380,7 +403,7 @@ UINT                            status;
     {
         _ux_host_mutex_off(&hcd_ehci -> ux_hcd_ehci_periodic_mutex);
         for (i = 0; i < ed -> ux_ehci_hsiso_ed_nb_tds; i ++)
-            ed -> ux_ehci_hsiso_ed_fr_td[i] -> ux_ehci_hsiso_td_status = UX_UNUSED;
+            _ux_hcd_ehci_hsisochronous_td_release(hcd_ehci, ed -> ux_ehci_hsiso_ed_fr_td[i]);
         _ux_utility_memory_free(ed);
         return(UX_NO_BANDWIDTH_AVAILABLE);
     }
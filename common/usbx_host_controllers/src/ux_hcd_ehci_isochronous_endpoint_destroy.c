@@ -34,7 +34,7 @@
 /*  FUNCTION                                               RELEASE        */
 /*                                                                        */
 /*    _ux_hcd_ehci_isochronous_endpoint_destroy           PORTABLE C      */
-/*                                                           6.1.11       */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -55,6 +55,8 @@
 /*  CALLS                                                                 */
 /*                                                                        */
 /*    None                                                                */
+/*    _ux_hcd_ehci_fsisochronous_td_release Release siTD                  */
+/*    _ux_hcd_ehci_hsisochronous_td_release Release iTD                   */
 /*    _ux_host_mutex_on                     Get mutex                     */
 /*    _ux_host_mutex_off                    Put mutex                     */
 /*    _ux_hcd_ehci_periodic_descriptor_link Link/unlink descriptor        */
@@ -81,6 +83,9 @@
 /*  04-25-2022     Chaoqiong Xiao           Modified comment(s),          */
 /*                                            fixed standalone compile,   */
 /*                                            resulting in version 6.1.11 */
+/*  xx-xx-xxxx     Mohamed ayed             Modified comment(s),          */
+/*                                            released TDs to free list,  */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_hcd_ehci_isochronous_endpoint_destroy(UX_HCD_EHCI *hcd_ehci, UX_ENDPOINT *endpoint)
@@ -277,13 +282,13 @@ ULONG                           last_size;
 #if defined(UX_HCD_EHCI_SPLIT_TRANSFER_ENABLE)
     if (endpoint -> ux_endpoint_device -> ux_device_speed != UX_HIGH_SPEED_DEVICE)
     {
-        ed_td.sitd_ptr -> ux_ehci_fsiso_td_status = UX_UNUSED;
+        _ux_hcd_ehci_fsisochronous_td_release(hcd_ehci, ed_td.sitd_ptr);
     }
     else
 #endif
     {
         for (frindex = 0; frindex < ed -> ux_ehci_hsiso_ed_nb_tds; frindex ++)
-            ed -> ux_ehci_hsiso_ed_fr_td[frindex] -> ux_ehci_hsiso_td_status = UX_UNUSED;
+            _ux_hcd_ehci_hsisochronous_td_release(hcd_ehci, ed -> ux_ehci_hsiso_ed_fr_td[frindex]);
         _ux_utility_memory_free(ed);
     }
 
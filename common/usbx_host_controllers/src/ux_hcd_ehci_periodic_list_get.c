@@ -0,0 +1,127 @@
+/***************************************************************************
+ * Copyright (c) 2024 Microsoft Corporation 
+ * 
+ * This program and the accompanying materials are made available under the
+ * terms of the MIT License which is available at
+ * https://opensource.org/licenses/MIT.
+ * 
+ * SPDX-License-Identifier: MIT
+ **************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** USBX Component                                                        */
+/**                                                                       */
+/**   EHCI Controller Driver                                              */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+
+/* Include necessary system files.  */
+
+#define UX_SOURCE_CODE
+
+#include "ux_api.h"
+#include "ux_hcd_ehci.h"
+#include "ux_host_stack.h"
+
+
+#if defined(UX_HOST_PERIODIC_SCHEDULE_ENABLE)
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_hcd_ehci_periodic_list_get                      PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function return a pointer to the first ED in the periodic tree */
+/*    for the given frame list entry, with the micro-frame loads of that  */
+/*    entry. It is used to place an endpoint in the frame chosen by the   */
+/*    host stack periodic schedule.                                       */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    hcd_ehci                              Pointer to EHCI controller    */
+/*    list_index                            Frame list entry (0 to 31)    */
+/*    microframe_load                       Pointer to an array for 8     */
+/*                                          micro-frame loads             */
+/*    microframe_ssplit_count               Pointer to an array for 8     */
+/*                                          micro-frame start split count */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    UX_EHCI_ED *                          Pointer to ED                 */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _ux_utility_virtual_address           Get virtual address           */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    EHCI Controller Driver                                              */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Mohamed ayed             Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+UX_EHCI_ED  *_ux_hcd_ehci_periodic_list_get(UX_HCD_EHCI *hcd_ehci, ULONG list_index,
+    ULONG microframe_load[8], ULONG microframe_ssplit_count[8])
+{
+
+UX_EHCI_ED                      *ed;
+UX_EHCI_PERIODIC_LINK_POINTER   anchor;
+UINT                            frindex;
+
+
+#if !defined(UX_HCD_EHCI_SPLIT_TRANSFER_ENABLE)
+    UX_PARAMETER_NOT_USED(microframe_ssplit_count);
+#endif
+
+    /* Get the ED of the beginning of the list, the tree has 32 lists.  */
+    /* Obtain the ED address only.  */
+    /* Obtain the virtual address from the element.  */
+    anchor.ed_ptr =  *(hcd_ehci -> ux_hcd_ehci_frame_list + (list_index & 0x1f));
+    anchor.value &= UX_EHCI_LINK_ADDRESS_MASK;
+    anchor.void_ptr = _ux_utility_virtual_address(anchor.void_ptr);
+
+    /* Reset microframe load table.  */
+    for (frindex = 0; frindex < 8; frindex ++)
+    {
+        microframe_load[frindex] = 0;
+#if defined(UX_HCD_EHCI_SPLIT_TRANSFER_ENABLE)
+        microframe_ssplit_count[frindex] = 0;
+#endif
+    }
+
+    /* Summary micro-frames loads of all the static anchors in the list,
+       down to the 1ms anchor.  */
+    ed = anchor.ed_ptr;
+    while(ed != UX_NULL)
+    {
+        for (frindex = 0; frindex < 8; frindex ++)
+        {
+            microframe_load[frindex] += ed -> REF_AS.ANCHOR.ux_ehci_ed_microframe_load[frindex];
+#if defined(UX_HCD_EHCI_SPLIT_TRANSFER_ENABLE)
+            microframe_ssplit_count[frindex] += ed -> REF_AS.ANCHOR.ux_ehci_ed_microframe_ssplit_count[frindex];
+#endif
+        }
+
+        /* Next static anchor.  */
+        ed = ed -> REF_AS.ANCHOR.ux_ehci_ed_next_anchor;
+    }
+
+    /* Return the first ED of the list.  */
+    return(anchor.ed_ptr);
+}
+#endif
@@ -87,7 +87,7 @@
 /*  FUNCTION                                               RELEASE        */ 
 /*                                                                        */ 
 /*    _ux_hcd_ehci_port_reset                             PORTABLE C      */ 
-/*                                                           6.1.8        */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -126,6 +126,9 @@
 /*  08-02-2021     Wen Wang                 Modified comment(s),          */
 /*                                            fixed spelling error,       */
 /*                                            resulting in version 6.1.8  */
+/*  xx-xx-xxxx     Mohamed ayed             Modified comment(s),          */
+/*                                            added adaptive enum timing, */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_hcd_ehci_port_reset(UX_HCD_EHCI *hcd_ehci, ULONG port_index)
@@ -207,7 +210,9 @@ INT         i;
             if (i == 0)
             {
                 _ux_hcd_ehci_register_write(hcd_ehci, EHCI_HCOR_PORT_SC + port_index, (ehci_register_port_status | EHCI_HC_PS_SUSPEND));
-                _ux_utility_delay_ms(UX_HIGH_SPEED_DETECTION_HANDSHAKE_SUSPEND_WAIT);
+                _ux_utility_delay_ms(UX_HOST_ENUM_DELAY(hcd_ehci -> ux_hcd_ehci_hcd_owner, port_index,
+                                                        UX_HOST_ENUM_HS_HANDSHAKE_SUSPEND_WAIT_MIN,
+                                                        UX_HIGH_SPEED_DETECTION_HANDSHAKE_SUSPEND_WAIT));
                 _ux_hcd_ehci_register_write(hcd_ehci, EHCI_HCOR_PORT_SC + port_index, (ehci_register_port_status & ~EHCI_HC_PS_SUSPEND));
             }
             else
@@ -34,7 +34,7 @@
 /*  FUNCTION                                               RELEASE        */ 
 /*                                                                        */ 
 /*    _ux_hcd_ehci_regular_td_obtain                      PORTABLE C      */ 
-/*                                                           6.1.11       */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -54,8 +54,6 @@
 /*  CALLS                                                                 */ 
 /*                                                                        */ 
 /*    _ux_utility_memory_set                Set memory block              */ 
-/*    _ux_host_mutex_on                     Get protection mutex          */
-/*    _ux_host_mutex_off                    Release protection mutex      */
 /*                                                                        */ 
 /*  CALLED BY                                                             */ 
 /*                                                                        */ 
@@ -73,56 +71,56 @@
 /*  04-25-2022     Chaoqiong Xiao           Modified comment(s),          */
 /*                                            fixed standalone compile,   */
 /*                                            resulting in version 6.1.11 */
+/*  xx-xx-xxxx     Mohamed ayed             Modified comment(s),          */
+/*                                            used free list,             */
+/*                                            counted exhaustion,         */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UX_EHCI_TD  *_ux_hcd_ehci_regular_td_obtain(UX_HCD_EHCI *hcd_ehci)
 {
 
+UX_INTERRUPT_SAVE_AREA
+
 UX_EHCI_TD      *td;
-ULONG           td_index;
 ULONG           td_element;
 
 
-    /* Get the mutex as this is a critical section.  */
-    _ux_host_mutex_on(&_ux_system -> ux_system_mutex);
+    /* Lockout interrupts, the free list is shared by all the users of the
+       controller.  */
+    UX_DISABLE
 
-    /* Start the search from the beginning of the list.  */
-    td =  hcd_ehci -> ux_hcd_ehci_td_list;
-    for (td_index = 0; td_index < _ux_system_host -> ux_system_host_max_td; td_index++)
+    /* Take the TD at the head of the free TD list.  */
+    td =  hcd_ehci -> ux_hcd_ehci_td_free_list;
+    if (td == UX_NULL)
     {
 
-        /* Check the TD status, a free TD is marked with the USED flag.  */
-        if (td -> ux_ehci_td_status == UX_UNUSED)
-        {
-
-            /* The TD may have been used, so we reset all fields.  */
-            _ux_utility_memory_set(td, 0, sizeof(UX_EHCI_TD)); /* Use case of memset is verified. */
+        /* There is no available TD in the TD list, count it for diagnostics.  */
+        hcd_ehci -> ux_hcd_ehci_td_obtain_failures++;
 
-            /* This TD is now marked as USED.  */
-            td -> ux_ehci_td_status =  UX_USED;
+        /* Restore interrupts.  */
+        UX_RESTORE
 
-            /* Initialize the link pointer and alternate TD fields.  */
-            td_element =  UX_EHCI_TD_T;
-            td -> ux_ehci_td_link_pointer =  (UX_EHCI_TD *) td_element;
-            td -> ux_ehci_td_alternate_link_pointer =  (UX_EHCI_TD *) td_element;
-            
-            /* Release the protection.  */
-            _ux_host_mutex_off(&_ux_system -> ux_system_mutex);
+        /* Error, return a null.  */
+        return(UX_NULL);
+    }
+    hcd_ehci -> ux_hcd_ehci_td_free_list =  td -> ux_ehci_td_next_free;
 
-            /* Success, return TD pointer.  */
-            return(td);
-        }
+    /* The TD may have been used, so we reset all fields.  */
+    _ux_utility_memory_set(td, 0, sizeof(UX_EHCI_TD)); /* Use case of memset is verified. */
 
-        /* Look at next TD.  */
-        td++;
-    }
+    /* This TD is now marked as USED.  */
+    td -> ux_ehci_td_status =  UX_USED;
 
-    /* There is no available TD in the TD list.  */
+    /* Restore interrupts.  */
+    UX_RESTORE
 
-    /* Release protection.  */
-    _ux_host_mutex_off(&_ux_system -> ux_system_mutex);
+    /* Initialize the link pointer and alternate TD fields.  */
+    td_element =  UX_EHCI_TD_T;
+    td -> ux_ehci_td_link_pointer =  (UX_EHCI_TD *) td_element;
+    td -> ux_ehci_td_alternate_link_pointer =  (UX_EHCI_TD *) td_element;
 
-    /* Error, return a null.  */
-    return(UX_NULL);
+    /* Success, return TD pointer.  */
+    return(td);
 }
 
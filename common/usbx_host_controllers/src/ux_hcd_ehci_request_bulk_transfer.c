@@ -34,7 +34,7 @@
 /*  FUNCTION                                               RELEASE        */ 
 /*                                                                        */ 
 /*    _ux_hcd_ehci_request_bulk_transfer                  PORTABLE C      */ 
-/*                                                           6.1          */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -59,6 +59,7 @@
 /*  CALLS                                                                 */ 
 /*                                                                        */ 
 /*    _ux_hcd_ehci_request_transfer_add     Add transfer to ED            */ 
+/*    _ux_hcd_ehci_request_transfer_queue   Queue TDs on ED               */
 /*                                                                        */ 
 /*  CALLED BY                                                             */ 
 /*                                                                        */ 
@@ -71,6 +72,13 @@
 /*  05-19-2020     Chaoqiong Xiao           Initial Version 6.0           */
 /*  09-30-2020     Chaoqiong Xiao           Modified comment(s),          */
 /*                                            resulting in version 6.1    */
+/*  xx-xx-xxxx     Mohamed ayed             Modified comment(s),          */
+/*                                            supported transfers queued  */
+/*                                            behind pending transfers,   */
+/*                                            added transfer segments     */
+/*                                            support,                    */
+/*                                            added bulk chain support,   */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_hcd_ehci_request_bulk_transfer(UX_HCD_EHCI *hcd_ehci, UX_TRANSFER *transfer_request)
@@ -78,13 +86,24 @@ UINT  _ux_hcd_ehci_request_bulk_transfer(UX_HCD_EHCI *hcd_ehci, UX_TRANSFER *tra
 
 UX_ENDPOINT     *endpoint;
 UX_EHCI_ED      *ed;
+#if !defined(UX_HCD_EHCI_TRANSFER_QUEUE_ENABLE)
 ULONG           transfer_request_payload_length;
 ULONG           bulk_packet_payload_length;
+ULONG           bulk_packet_payload_max;
+#if defined(UX_HCD_EHCI_BULK_CHAIN_ENABLE)
+ULONG           max_packet_size;
+#endif
 UCHAR *         data_pointer;
 ULONG           pid;
 ULONG           td_component;
 UINT            status;
 ULONG           zlp_flag;
+#if defined(UX_TRANSFER_SEGMENTS_ENABLE)
+UX_TRANSFER_SEGMENT *segment;
+ULONG           segment_length;
+ULONG           segment_left;
+#endif
+#endif
 
 
     /* Get the pointer to the Endpoint.  */
@@ -93,6 +112,12 @@ ULONG           zlp_flag;
     /* Now get the physical ED attached to this endpoint.  */
     ed =  endpoint -> ux_endpoint_ed;
 
+#if defined(UX_HCD_EHCI_TRANSFER_QUEUE_ENABLE)
+
+    /* Queue the TDs of this transfer behind the ones pending on the ED.  */
+    return(_ux_hcd_ehci_request_transfer_queue(hcd_ehci, ed, transfer_request));
+#else
+
     /* The overlay parameters should be reset now.  */
     ed -> ux_ehci_ed_current_td =     UX_NULL;
     ed -> ux_ehci_ed_queue_element =  (UX_EHCI_TD *)UX_EHCI_TD_T;
@@ -120,6 +145,27 @@ ULONG           zlp_flag;
     
         /* We do not have a zlp.  */
         zlp_flag = UX_FALSE;
+
+    /* Get the maximum payload of a TD.  */
+    bulk_packet_payload_max =  UX_EHCI_MAX_PAYLOAD;
+#if defined(UX_HCD_EHCI_BULK_CHAIN_ENABLE)
+    max_packet_size =  endpoint -> ux_endpoint_descriptor.wMaxPacketSize & UX_MAX_PACKET_SIZE_MASK;
+#endif
+
+#if defined(UX_TRANSFER_SEGMENTS_ENABLE)
+
+    /* With segments, each segment is described by its own TDs, a TD never crosses
+       a segment boundary.  */
+    segment =  transfer_request -> ux_transfer_request_segments;
+    segment_length =  transfer_request_payload_length;
+    segment_left =  0;
+    if (transfer_request -> ux_transfer_request_segment_count != 0)
+    {
+        data_pointer =  segment -> ux_transfer_segment_data_pointer;
+        segment_length =  segment -> ux_transfer_segment_length;
+        segment_left =  transfer_request -> ux_transfer_request_segment_count - 1;
+    }
+#endif
                 
     /* Build all necessary TDs.  */
     while ((transfer_request_payload_length != 0) || zlp_flag == UX_TRUE)
@@ -128,11 +174,47 @@ ULONG           zlp_flag;
         /* Reset ZLP now.  */
         zlp_flag = UX_FALSE;        
       
+#if defined(UX_TRANSFER_SEGMENTS_ENABLE)
+
+        /* Skip the empty segments, up to the last one.  */
+        while ((segment_length == 0) && (transfer_request_payload_length != 0) && (segment_left != 0))
+        {
+            segment ++;
+            segment_left --;
+            data_pointer =  segment -> ux_transfer_segment_data_pointer;
+            segment_length =  segment -> ux_transfer_segment_length;
+        }
+
+        /* The segments may not be longer than the requested length.  */
+        if (segment_length > transfer_request_payload_length)
+            segment_length =  transfer_request_payload_length;
+#endif
+
+#if defined(UX_HCD_EHCI_BULK_CHAIN_ENABLE)
+
+        /* The TD may span 5 pages from the buffer offset, in whole packets.  */
+        if (max_packet_size != 0)
+            bulk_packet_payload_max =  UX_EHCI_TD_PAYLOAD_MAX(data_pointer, max_packet_size);
+#endif
+
+#if defined(UX_TRANSFER_SEGMENTS_ENABLE)
+
+        /* Check if we are exceeding the max payload. */
+        if (segment_length > bulk_packet_payload_max)
+            bulk_packet_payload_length =  bulk_packet_payload_max;
+        else
+            bulk_packet_payload_length =  segment_length;
+
+        /* Adjust the length left in this segment.  */
+        segment_length -=  bulk_packet_payload_length;
+#else
+
         /* Check if we are exceeding the max payload. */
-        if (transfer_request_payload_length > UX_EHCI_MAX_PAYLOAD)
-            bulk_packet_payload_length =  UX_EHCI_MAX_PAYLOAD;
+        if (transfer_request_payload_length > bulk_packet_payload_max)
+            bulk_packet_payload_length =  bulk_packet_payload_max;
         else
             bulk_packet_payload_length =  transfer_request_payload_length;
+#endif
 
         /* Add this transfer request to the ED.  */
         if ((transfer_request -> ux_transfer_request_type&UX_REQUEST_DIRECTION) == UX_REQUEST_IN)
@@ -145,10 +227,26 @@ ULONG           zlp_flag;
 
         if (status != UX_SUCCESS)
             return(status);
+
+#if defined(UX_HCD_EHCI_BULK_CHAIN_ENABLE)
+
+        /* A short packet received before the last TD stops the queue on the
+           short packet TD, the transfer is then complete.  */
+        if ((pid == UX_EHCI_PID_IN) && (transfer_request_payload_length != bulk_packet_payload_length))
+            ed -> ux_ehci_ed_last_td -> ux_ehci_td_alternate_link_pointer =
+                                _ux_utility_physical_address(hcd_ehci -> ux_hcd_ehci_short_td);
+#endif
             
         /* Adjust the data payload length and the data payload pointer.  */
         transfer_request_payload_length -=  bulk_packet_payload_length;
         data_pointer +=  bulk_packet_payload_length;
+
+#if defined(UX_TRANSFER_SEGMENTS_ENABLE)
+
+        /* The transfer ends with the last segment.  */
+        if ((segment_length == 0) && (segment_left == 0))
+            transfer_request_payload_length =  0;
+#endif
     }        
 
     /* Set the IOC bit in the last TD.  */
@@ -165,5 +263,6 @@ ULONG           zlp_flag;
 
     /* Return successful completion.  */
     return(UX_SUCCESS);           
+#endif
 }
 
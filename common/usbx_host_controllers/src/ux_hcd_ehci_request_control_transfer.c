@@ -34,7 +34,7 @@
 /*  FUNCTION                                               RELEASE        */ 
 /*                                                                        */ 
 /*    _ux_hcd_ehci_request_control_transfer               PORTABLE C      */ 
-/*                                                           6.3.0        */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -88,6 +88,10 @@
 /*  10-31-2023     Chaoqiong Xiao           Modified comment(s),          */
 /*                                            fixed compile warnings,     */
 /*                                            resulting in version 6.3.0  */
+/*  xx-xx-xxxx     Mohamed ayed             Modified comment(s),          */
+/*                                            passed controller to ED     */
+/*                                            clean,                      */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_hcd_ehci_request_control_transfer(UX_HCD_EHCI *hcd_ehci, UX_TRANSFER *transfer_request)
@@ -156,7 +160,7 @@ UINT            pid;
     {
 
         /* We need to clean the tds attached if any.  */
-        _ux_hcd_ehci_ed_clean(ed);
+        _ux_hcd_ehci_ed_clean(hcd_ehci, ed);
         return(status);
     }
 
@@ -179,7 +183,7 @@ UINT            pid;
         {
 
             /* We need to clean the tds attached if any.  */
-            _ux_hcd_ehci_ed_clean(ed);
+            _ux_hcd_ehci_ed_clean(hcd_ehci, ed);
             return(status);
         }
     }        
@@ -197,7 +201,7 @@ UINT            pid;
     {
 
         /* We need to clean the tds attached if any.  */
-        _ux_hcd_ehci_ed_clean(ed);
+        _ux_hcd_ehci_ed_clean(hcd_ehci, ed);
         return(status);
     }
 
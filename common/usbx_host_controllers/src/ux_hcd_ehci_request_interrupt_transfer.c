@@ -34,7 +34,7 @@
 /*  FUNCTION                                               RELEASE        */ 
 /*                                                                        */ 
 /*    _ux_hcd_ehci_request_interrupt_transfer             PORTABLE C      */ 
-/*                                                           6.1          */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -58,6 +58,7 @@
 /*  CALLS                                                                 */ 
 /*                                                                        */ 
 /*    _ux_hcd_ehci_request_transfer_add     Add transfer to ED            */ 
+/*    _ux_hcd_ehci_request_transfer_queue   Queue TDs on ED               */
 /*                                                                        */ 
 /*  CALLED BY                                                             */ 
 /*                                                                        */ 
@@ -70,6 +71,10 @@
 /*  05-19-2020     Chaoqiong Xiao           Initial Version 6.0           */
 /*  09-30-2020     Chaoqiong Xiao           Modified comment(s),          */
 /*                                            resulting in version 6.1    */
+/*  xx-xx-xxxx     Mohamed ayed             Modified comment(s),          */
+/*                                            supported transfers queued  */
+/*                                            behind pending transfers,   */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_hcd_ehci_request_interrupt_transfer(UX_HCD_EHCI *hcd_ehci, UX_TRANSFER *transfer_request)
@@ -77,9 +82,11 @@ UINT  _ux_hcd_ehci_request_interrupt_transfer(UX_HCD_EHCI *hcd_ehci, UX_TRANSFER
 
 UX_ENDPOINT     *endpoint;
 UX_EHCI_ED      *ed;
+#if !defined(UX_HCD_EHCI_TRANSFER_QUEUE_ENABLE)
 ULONG           pid;
 ULONG           td_component;
 UINT            status;
+#endif
     
 
     /* Get the pointer to the endpoint.  */
@@ -88,6 +95,12 @@ UINT            status;
     /* Now get the physical ED attached to this endpoint.  */
     ed =  endpoint -> ux_endpoint_ed;
 
+#if defined(UX_HCD_EHCI_TRANSFER_QUEUE_ENABLE)
+
+    /* Queue the TDs of this transfer behind the ones pending on the ED.  */
+    return(_ux_hcd_ehci_request_transfer_queue(hcd_ehci, ed, transfer_request));
+#else
+
     /* The overlay parameters should be reset now.  */
     ed -> ux_ehci_ed_current_td =     UX_NULL;
     ed -> ux_ehci_ed_queue_element =  (UX_EHCI_TD *) UX_EHCI_TD_T;
@@ -131,5 +144,6 @@ UINT            status;
     
     /* Return completion status.  */
     return(status);
+#endif
 }
 
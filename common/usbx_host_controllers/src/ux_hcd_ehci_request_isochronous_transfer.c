@@ -34,7 +34,7 @@
 /*  FUNCTION                                               RELEASE        */
 /*                                                                        */
 /*    _ux_hcd_ehci_request_isochronous_transfer           PORTABLE C      */
-/*                                                           6.1.12       */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -88,6 +88,9 @@
 /*  07-29-2022     Chaoqiong Xiao           Modified comment(s),          */
 /*                                            improved iso start up,      */
 /*                                            resulting in version 6.1.12 */
+/*  xx-xx-xxxx     Mohamed ayed             Modified comment(s),          */
+/*                                            used HCD thread signal,     */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_hcd_ehci_request_isochronous_transfer(UX_HCD_EHCI *hcd_ehci, UX_TRANSFER *transfer_request)
@@ -179,8 +182,7 @@ UCHAR                           start = UX_FALSE;
     /* Simulate iTD/siTD done to start - HCD signal.  */
     if (start)
     {
-        hcd_ehci -> ux_hcd_ehci_hcd_owner -> ux_hcd_thread_signal ++;
-        _ux_host_semaphore_put(&_ux_system_host -> ux_system_host_hcd_semaphore);
+        UX_HOST_HCD_THREAD_SIGNAL(hcd_ehci -> ux_hcd_ehci_hcd_owner);
     }
 
     /* Return completion status.  */
@@ -34,7 +34,7 @@
 /*  FUNCTION                                               RELEASE        */ 
 /*                                                                        */ 
 /*    _ux_hcd_ehci_request_transfer_add                   PORTABLE C      */ 
-/*                                                           6.1          */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -61,6 +61,7 @@
 /*                                                                        */ 
 /*  CALLS                                                                 */ 
 /*                                                                        */ 
+/*    _ux_hcd_ehci_ed_active_insert         Insert ED in active list      */
 /*    _ux_hcd_ehci_regular_td_obtain        Obtain regular TD             */ 
 /*    _ux_utility_physical_address          Get physical address          */ 
 /*                                                                        */ 
@@ -75,6 +76,9 @@
 /*  05-19-2020     Chaoqiong Xiao           Initial Version 6.0           */
 /*  09-30-2020     Chaoqiong Xiao           Modified comment(s),          */
 /*                                            resulting in version 6.1    */
+/*  xx-xx-xxxx     Mohamed ayed             Modified comment(s),          */
+/*                                            listed ED as active,        */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_hcd_ehci_request_transfer_add(UX_HCD_EHCI *hcd_ehci, UX_EHCI_ED *ed, ULONG phase, ULONG pid,
@@ -140,6 +144,12 @@ UX_EHCI_POINTER         bp;
         lp.void_ptr = _ux_utility_physical_address(td);
         lp.value |= UX_EHCI_TD_T;
         ed -> ux_ehci_ed_queue_element = lp.td_ptr;
+
+#if defined(UX_HCD_EHCI_ACTIVE_LIST_ENABLE)
+
+        /* The done queue processing must visit this ED now.  */
+        _ux_hcd_ehci_ed_active_insert(hcd_ehci, ed);
+#endif
     }
     else
     {
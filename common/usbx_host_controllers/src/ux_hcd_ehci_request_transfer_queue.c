@@ -0,0 +1,336 @@
+/***************************************************************************
+ * Copyright (c) 2024 Microsoft Corporation 
+ * 
+ * This program and the accompanying materials are made available under the
+ * terms of the MIT License which is available at
+ * https://opensource.org/licenses/MIT.
+ * 
+ * SPDX-License-Identifier: MIT
+ **************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */ 
+/** USBX Component                                                        */ 
+/**                                                                       */
+/**   EHCI Controller Driver                                              */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+
+/* Include necessary system files.  */
+
+#define UX_SOURCE_CODE
+
+#include "ux_api.h"
+#include "ux_hcd_ehci.h"
+#include "ux_host_stack.h"
+
+
+#if defined(UX_HCD_EHCI_TRANSFER_QUEUE_ENABLE)
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_hcd_ehci_request_transfer_queue                 PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function builds the TDs of a bulk or interrupt transfer        */
+/*    request in a private chain and queues the chain behind the TDs      */
+/*    already pending on the ED. The controller can therefore start this  */
+/*    transfer as soon as the previous one completes, without waiting     */
+/*    for the completion to be processed by the HCD thread.               */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    hcd_ehci                          Pointer to EHCI controller        */
+/*    ed                                Pointer to ED                     */
+/*    transfer_request                  Pointer to transfer request       */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    Completion Status                                                   */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _ux_hcd_ehci_ed_active_insert         Insert ED in active list      */
+/*    _ux_hcd_ehci_regular_td_obtain        Get regular TD                */
+/*    _ux_hcd_ehci_regular_td_release       Release TD                    */
+/*    _ux_utility_physical_address          Get physical address          */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    EHCI Controller Driver                                              */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Mohamed ayed             Initial Version 6.x           */
+/*  xx-xx-xxxx     Mohamed ayed             Modified comment(s),          */
+/*                                            added transfer segments     */
+/*                                            support,                    */
+/*                                            listed ED as active,        */
+/*                                            added bulk chain support,   */
+/*                                            released TDs to free list,  */
+/*                                            resulting in version 6.x    */
+/*                                                                        */
+/**************************************************************************/
+UINT  _ux_hcd_ehci_request_transfer_queue(UX_HCD_EHCI *hcd_ehci, UX_EHCI_ED *ed, UX_TRANSFER *transfer_request)
+{
+
+UX_INTERRUPT_SAVE_AREA
+
+UX_EHCI_TD              *first_td;
+UX_EHCI_TD              *last_td;
+UX_EHCI_TD              *td;
+UX_EHCI_LINK_POINTER    lp;
+UX_EHCI_POINTER         bp;
+UCHAR                   *data_pointer;
+ULONG                   transfer_request_payload_length;
+ULONG                   td_payload_length;
+ULONG                   td_payload_max;
+#if defined(UX_HCD_EHCI_BULK_CHAIN_ENABLE)
+ULONG                   max_packet_size;
+#endif
+ULONG                   pid;
+ULONG                   zlp_flag;
+#if defined(UX_TRANSFER_SEGMENTS_ENABLE)
+UX_TRANSFER_SEGMENT     *segment;
+ULONG                   segment_length;
+ULONG                   segment_left;
+#endif
+
+
+    /* Get the correct PID for this transfer.  */
+    if ((transfer_request -> ux_transfer_request_type & UX_REQUEST_DIRECTION) == UX_REQUEST_IN)
+        pid =  UX_EHCI_PID_IN;
+    else
+        pid =  UX_EHCI_PID_OUT;
+
+    /* It may take more than one TD if the transfer_request length is more than the
+       maximum length for an EHCI TD.  */
+    transfer_request_payload_length =  transfer_request -> ux_transfer_request_requested_length;
+    data_pointer =  transfer_request -> ux_transfer_request_data_pointer;
+
+    /* Check for ZLP condition.  */
+    if (transfer_request_payload_length == 0)
+        zlp_flag =  UX_TRUE;
+    else
+        zlp_flag =  UX_FALSE;
+
+    /* Get the maximum payload of a TD.  */
+    td_payload_max =  UX_EHCI_MAX_PAYLOAD;
+#if defined(UX_HCD_EHCI_BULK_CHAIN_ENABLE)
+    max_packet_size =  transfer_request -> ux_transfer_request_endpoint -> ux_endpoint_descriptor.wMaxPacketSize & UX_MAX_PACKET_SIZE_MASK;
+#endif
+
+#if defined(UX_TRANSFER_SEGMENTS_ENABLE)
+
+    /* With segments, each segment is described by its own TDs, a TD never crosses
+       a segment boundary.  */
+    segment =  transfer_request -> ux_transfer_request_segments;
+    segment_length =  transfer_request_payload_length;
+    segment_left =  0;
+    if (transfer_request -> ux_transfer_request_segment_count != 0)
+    {
+        data_pointer =  segment -> ux_transfer_segment_data_pointer;
+        segment_length =  segment -> ux_transfer_segment_length;
+        segment_left =  transfer_request -> ux_transfer_request_segment_count - 1;
+    }
+#endif
+
+    /* Build the TDs in a private chain, the controller does not see them yet.  */
+    first_td =  UX_NULL;
+    last_td =  UX_NULL;
+    while ((transfer_request_payload_length != 0) || (zlp_flag == UX_TRUE))
+    {
+
+        /* Reset ZLP now.  */
+        zlp_flag =  UX_FALSE;
+
+#if defined(UX_TRANSFER_SEGMENTS_ENABLE)
+
+        /* Skip the empty segments, up to the last one.  */
+        while ((segment_length == 0) && (transfer_request_payload_length != 0) && (segment_left != 0))
+        {
+            segment ++;
+            segment_left --;
+            data_pointer =  segment -> ux_transfer_segment_data_pointer;
+            segment_length =  segment -> ux_transfer_segment_length;
+        }
+
+        /* The segments may not be longer than the requested length.  */
+        if (segment_length > transfer_request_payload_length)
+            segment_length =  transfer_request_payload_length;
+#endif
+
+#if defined(UX_HCD_EHCI_BULK_CHAIN_ENABLE)
+
+        /* The TD may span 5 pages from the buffer offset, in whole packets.  */
+        if (max_packet_size != 0)
+            td_payload_max =  UX_EHCI_TD_PAYLOAD_MAX(data_pointer, max_packet_size);
+#endif
+
+#if defined(UX_TRANSFER_SEGMENTS_ENABLE)
+
+        /* Check if we are exceeding the max payload. */
+        if (segment_length > td_payload_max)
+            td_payload_length =  td_payload_max;
+        else
+            td_payload_length =  segment_length;
+
+        /* Adjust the length left in this segment.  */
+        segment_length -=  td_payload_length;
+#else
+
+        /* Check if we are exceeding the max payload. */
+        if (transfer_request_payload_length > td_payload_max)
+            td_payload_length =  td_payload_max;
+        else
+            td_payload_length =  transfer_request_payload_length;
+#endif
+
+        /* Obtain a TD for this transaction.  */
+        td =  _ux_hcd_ehci_regular_td_obtain(hcd_ehci);
+        if (td == UX_NULL)
+        {
+
+            /* Release the TDs built so far.  */
+            while (first_td != UX_NULL)
+            {
+                td =  first_td;
+                first_td =  td -> ux_ehci_td_next_td_transfer_request;
+                _ux_hcd_ehci_regular_td_release(hcd_ehci, td);
+            }
+            return(UX_NO_TD_AVAILABLE);
+        }
+
+        /* Store the transfer request and the ED associated with this TD.  */
+        td -> ux_ehci_td_transfer_request =  transfer_request;
+        td -> ux_ehci_td_ed =  ed;
+
+        /* Set the PID in the control DWORD of the TD.  */
+        td -> ux_ehci_td_control =  pid;
+
+        /* Set the buffer address and the next pages addresses.  */
+        bp.void_ptr =  _ux_utility_physical_address(data_pointer);
+        td -> ux_ehci_td_bp0 =  bp.void_ptr;
+        bp.value &=  UX_EHCI_PAGE_ALIGN;
+        td -> ux_ehci_td_bp1 =  bp.u8_ptr + UX_EHCI_PAGE_SIZE;
+        td -> ux_ehci_td_bp2 =  bp.u8_ptr + UX_EHCI_PAGE_SIZE * 2;
+        td -> ux_ehci_td_bp3 =  bp.u8_ptr + UX_EHCI_PAGE_SIZE * 3;
+        td -> ux_ehci_td_bp4 =  bp.u8_ptr + UX_EHCI_PAGE_SIZE * 4;
+
+        /* Set the length of the data transfer. We keep its original value.  */
+        td -> ux_ehci_td_control |=  td_payload_length << UX_EHCI_TD_LG_LOC;
+        td -> ux_ehci_td_length =    td_payload_length;
+
+        /* Add the default error count and the active bit.  */
+        td -> ux_ehci_td_control |=  UX_EHCI_TD_CERR | UX_EHCI_TD_ACTIVE;
+
+#if defined(UX_HCD_EHCI_BULK_CHAIN_ENABLE)
+
+        /* A short packet received before the last TD stops the queue on the
+           short packet TD, the completion restarts it on the next transfer.  */
+        if ((pid == UX_EHCI_PID_IN) && (transfer_request_payload_length != td_payload_length))
+            td -> ux_ehci_td_alternate_link_pointer =
+                                _ux_utility_physical_address(hcd_ehci -> ux_hcd_ehci_short_td);
+#endif
+
+        /* Link the TD to the private chain.  */
+        if (last_td == UX_NULL)
+            first_td =  td;
+        else
+        {
+            last_td -> ux_ehci_td_next_td_transfer_request =  td;
+            last_td -> ux_ehci_td_link_pointer =  _ux_utility_physical_address(td);
+        }
+        last_td =  td;
+
+        /* Adjust the data payload length and the data payload pointer.  */
+        transfer_request_payload_length -=  td_payload_length;
+        data_pointer +=  td_payload_length;
+
+#if defined(UX_TRANSFER_SEGMENTS_ENABLE)
+
+        /* The transfer ends with the last segment.  */
+        if ((segment_length == 0) && (segment_left == 0))
+            transfer_request_payload_length =  0;
+#endif
+    }
+
+    /* Set the IOC bit in the last TD, before the chain is visible to the controller.  */
+    last_td -> ux_ehci_td_control |=  UX_EHCI_TD_IOC;
+
+    /* Ensure the whole chain is written before it is linked. This is necessary
+       for some processors that perform writes out of order as an optimization.  */
+    UX_DATA_MEMORY_BARRIER
+
+    /* The HCD thread may complete the pending transfers while we link.  */
+    UX_DISABLE
+
+    /* Get the physical address of the first TD.  */
+    lp.void_ptr =  _ux_utility_physical_address(first_td);
+
+    /* Check if the ED is idle.  */
+    if (ed -> ux_ehci_ed_last_td == UX_NULL)
+    {
+
+        /* The overlay parameters should be reset now.  */
+        ed -> ux_ehci_ed_current_td =     UX_NULL;
+        ed -> ux_ehci_ed_alternate_td =   (UX_EHCI_TD *) UX_EHCI_TD_T;
+        ed -> ux_ehci_ed_state &=         UX_EHCI_QH_TOGGLE;
+        ed -> ux_ehci_ed_bp0 =            UX_NULL;
+        ed -> ux_ehci_ed_bp1 =            UX_NULL;
+        ed -> ux_ehci_ed_bp2 =            UX_NULL;
+        ed -> ux_ehci_ed_bp3 =            UX_NULL;
+        ed -> ux_ehci_ed_bp4 =            UX_NULL;
+
+        /* This chain is the first one on the ED.  */
+        ed -> ux_ehci_ed_first_td =  first_td;
+
+        /* Activate the first TD linked to the ED.  */
+        UX_DATA_MEMORY_BARRIER
+        ed -> ux_ehci_ed_queue_element =  lp.td_ptr;
+
+#if defined(UX_HCD_EHCI_ACTIVE_LIST_ENABLE)
+
+        /* The done queue processing must visit this ED now.  */
+        _ux_hcd_ehci_ed_active_insert(hcd_ehci, ed);
+#endif
+    }
+    else
+    {
+
+        /* Hook the chain behind the last TD pending.  */
+        ed -> ux_ehci_ed_last_td -> ux_ehci_td_link_pointer =  lp.td_ptr;
+        UX_DATA_MEMORY_BARRIER
+
+        /* The controller may have fetched the last TD before it was linked,
+           and have retired the queue since. Restart the queue in this case,
+           otherwise the completion of the last TD will do it.  */
+        bp.void_ptr =  ed -> ux_ehci_ed_queue_element;
+        if ((bp.value & UX_EHCI_TD_T) &&
+            ((ed -> ux_ehci_ed_state & (UX_EHCI_TD_ACTIVE | UX_EHCI_TD_HALTED)) == 0) &&
+            ((ed -> ux_ehci_ed_last_td -> ux_ehci_td_control & UX_EHCI_TD_ACTIVE) == 0))
+            ed -> ux_ehci_ed_queue_element =  lp.td_ptr;
+    }
+
+    /* Memorize the last TD hooked.  */
+    ed -> ux_ehci_ed_last_td =  last_td;
+
+    /* Restore interrupts.  */
+    UX_RESTORE
+
+    /* Return successful completion.  */
+    return(UX_SUCCESS);
+}
+#endif
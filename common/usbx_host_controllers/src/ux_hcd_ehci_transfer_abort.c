@@ -34,7 +34,7 @@
 /*  FUNCTION                                               RELEASE        */
 /*                                                                        */
 /*    _ux_hcd_ehci_transfer_abort                         PORTABLE C      */
-/*                                                           6.1.12       */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -60,6 +60,7 @@
 /*    _ux_host_mutex_off                    Put mutex                     */
 /*    _ux_utility_delay_ms                  Delay milliseconds            */
 /*    _ux_hcd_ehci_ed_clean                 Clean TDs on ED               */
+/*    _ux_hcd_ehci_ed_queue_remove          Remove transfer TDs on ED     */
 /*                                                                        */
 /*  CALLED BY                                                             */
 /*                                                                        */
@@ -84,6 +85,12 @@
 /*  07-29-2022     Chaoqiong Xiao           Modified comment(s),          */
 /*                                            improved iso abort support, */
 /*                                            resulting in version 6.1.12 */
+/*  xx-xx-xxxx     Mohamed ayed             Modified comment(s),          */
+/*                                            supported transfers queued  */
+/*                                            behind pending transfers,   */
+/*                                            passed controller to ED     */
+/*                                            clean,                      */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_hcd_ehci_transfer_abort(UX_HCD_EHCI *hcd_ehci,UX_TRANSFER *transfer_request)
@@ -234,9 +241,16 @@ ULONG                           first_new_aborted = 1;
         _ux_host_mutex_off(&hcd_ehci -> ux_hcd_ehci_periodic_mutex);
     }
     else
+#if defined(UX_HCD_EHCI_TRANSFER_QUEUE_ENABLE)
+
+        /* Remove the TDs of this transfer, the other transfers queued stay
+           on the ED.  */
+        _ux_hcd_ehci_ed_queue_remove(hcd_ehci, lp.ed_ptr, transfer_request);
+#else
 
         /* Clean the TDs attached to the ED.  */
-        _ux_hcd_ehci_ed_clean(lp.ed_ptr);
+        _ux_hcd_ehci_ed_clean(hcd_ehci, lp.ed_ptr);
+#endif
 
     /* Return successful completion.  */
     return(UX_SUCCESS);
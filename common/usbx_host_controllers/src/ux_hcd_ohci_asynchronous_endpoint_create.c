@@ -34,7 +34,7 @@
 /*  FUNCTION                                               RELEASE        */ 
 /*                                                                        */ 
 /*    _ux_hcd_ohci_asynchronous_endpoint_create           PORTABLE C      */ 
-/*                                                           6.1.12       */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -56,6 +56,7 @@
 /*  CALLS                                                                 */ 
 /*                                                                        */ 
 /*    _ux_hcd_ohci_ed_obtain                Obtain a new ED               */ 
+/*    _ux_hcd_ohci_ed_release               Release ED                    */
 /*    _ux_hcd_ohci_register_read            Read OHCI register            */ 
 /*    _ux_hcd_ohci_register_write           Write OHCI register           */ 
 /*    _ux_utility_physical_address          Get physical address          */ 
@@ -77,6 +78,9 @@
 /*  07-29-2022     Chaoqiong Xiao           Modified comment(s),          */
 /*                                            fixed addressing issues,    */
 /*                                            resulting in version 6.1.12 */
+/*  xx-xx-xxxx     Mohamed ayed             Modified comment(s),          */
+/*                                            released ED to free list,   */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_hcd_ohci_asynchronous_endpoint_create(UX_HCD_OHCI *hcd_ohci, UX_ENDPOINT *endpoint)
@@ -104,7 +108,7 @@ ULONG           ohci_register;
     if (td == UX_NULL)
     {
 
-        ed -> ux_ohci_ed_status =  UX_UNUSED;
+        _ux_hcd_ohci_ed_release(hcd_ohci, ed);
         return(UX_NO_TD_AVAILABLE);
     }
 
@@ -34,7 +34,7 @@
 /*  FUNCTION                                               RELEASE        */ 
 /*                                                                        */ 
 /*    _ux_hcd_ohci_done_queue_process                     PORTABLE C      */ 
-/*                                                           6.1.12       */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -65,6 +65,7 @@
 /*    _ux_hcd_ohci_next_td_clean            Clean next TD                 */ 
 /*    _ux_hcd_ohci_register_read            Read OHCI register            */ 
 /*    _ux_hcd_ohci_register_write           Write OHCI register           */ 
+/*    _ux_hcd_ohci_regular_td_release       Release TD                    */
 /*    _ux_host_semaphore_put                Put producer semaphore        */ 
 /*    _ux_utility_virtual_address           Get virtual address           */ 
 /*                                                                        */ 
@@ -85,6 +86,9 @@
 /*  07-29-2022     Chaoqiong Xiao           Modified comment(s),          */
 /*                                            fixed an addressing issue,  */
 /*                                            resulting in version 6.1.12 */
+/*  xx-xx-xxxx     Mohamed ayed             Modified comment(s),          */
+/*                                            released TDs to free list,  */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 VOID  _ux_hcd_ohci_done_queue_process(UX_HCD_OHCI *hcd_ohci)
@@ -190,7 +194,7 @@ ULONG               current_frame;
 
                 /* Either this is a non control endpoint or it is the status phase and we are done */
                 transfer_request -> ux_transfer_request_completion_code =  UX_SUCCESS;
-                _ux_hcd_ohci_next_td_clean(td);
+                _ux_hcd_ohci_next_td_clean(hcd_ohci, td);
                 if (transfer_request -> ux_transfer_request_completion_function != UX_NULL)
                     transfer_request -> ux_transfer_request_completion_function(transfer_request);
                 _ux_host_semaphore_put(&transfer_request -> ux_transfer_request_semaphore);
@@ -203,7 +207,7 @@ ULONG               current_frame;
                 /* A stall condition happens when the device refuses the requested command or when a 
                    parameter in the command is wrong. We retire the transfer_request and mark the error.  */
                 transfer_request -> ux_transfer_request_completion_code =  UX_TRANSFER_STALLED;
-                _ux_hcd_ohci_next_td_clean(td);
+                _ux_hcd_ohci_next_td_clean(hcd_ohci, td);
                 if (transfer_request -> ux_transfer_request_completion_function != UX_NULL)
                     transfer_request -> ux_transfer_request_completion_function(transfer_request);
                 _ux_host_semaphore_put(&transfer_request -> ux_transfer_request_semaphore);
@@ -222,7 +226,7 @@ ULONG               current_frame;
                    happens at the first GET_DESCRIPTOR after the port is enabled. This error has to be 
                    picked up by the enumeration module to reset the port and retry the command.  */ 
                 transfer_request -> ux_transfer_request_completion_code =  UX_TRANSFER_NO_ANSWER;
-                _ux_hcd_ohci_next_td_clean(td);
+                _ux_hcd_ohci_next_td_clean(hcd_ohci, td);
                 if (transfer_request -> ux_transfer_request_completion_function != UX_NULL)
                     transfer_request -> ux_transfer_request_completion_function(transfer_request);
                 _ux_host_semaphore_put(&transfer_request -> ux_transfer_request_semaphore);
@@ -240,7 +244,7 @@ ULONG               current_frame;
                 /* Any other errors default to this section. The command has been repeated 3 times 
                    and there is still a problem. The endpoint probably should be reset.   */
                 transfer_request -> ux_transfer_request_completion_code =  UX_TRANSFER_ERROR;
-                _ux_hcd_ohci_next_td_clean(td);
+                _ux_hcd_ohci_next_td_clean(hcd_ohci, td);
                 if (transfer_request -> ux_transfer_request_completion_function != UX_NULL)
                     transfer_request -> ux_transfer_request_completion_function(transfer_request);
                 _ux_host_semaphore_put(&transfer_request -> ux_transfer_request_semaphore);
@@ -332,7 +336,7 @@ ULONG               current_frame;
         }                
 
         /* Free the TD that was just treated.  */
-        td -> ux_ohci_td_status =  UX_UNUSED;
+        _ux_hcd_ohci_regular_td_release(hcd_ohci, td);
 
         /* And continue the TD loop.  */
         td =  _ux_utility_virtual_address(td -> ux_ohci_td_next_td);
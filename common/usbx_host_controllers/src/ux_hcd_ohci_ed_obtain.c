@@ -34,7 +34,7 @@
 /*  FUNCTION                                               RELEASE        */ 
 /*                                                                        */ 
 /*    _ux_hcd_ohci_ed_obtain                              PORTABLE C      */ 
-/*                                                           6.1          */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -68,39 +68,50 @@
 /*                                            verified memset and memcpy  */
 /*                                            cases,                      */
 /*                                            resulting in version 6.1    */
+/*  xx-xx-xxxx     Mohamed ayed             Modified comment(s),          */
+/*                                            used free list,             */
+/*                                            counted exhaustion,         */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UX_OHCI_ED  *_ux_hcd_ohci_ed_obtain(UX_HCD_OHCI *hcd_ohci)
 {
 
+UX_INTERRUPT_SAVE_AREA
+
 UX_OHCI_ED      *ed;
-ULONG           ed_index;
 
 
-    /* Start the search from the beginning of the list.  */
-    ed =  hcd_ohci -> ux_hcd_ohci_ed_list;
-    for (ed_index = 0; ed_index < _ux_system_host -> ux_system_host_max_ed; ed_index++)
-    {
+    /* Lockout interrupts, the free list is shared by all the users of the
+       controller.  */
+    UX_DISABLE
 
-        /* Check the ED status, a free ED is marked with the UNUSED flag.  */
-        if (ed -> ux_ohci_ed_status == UX_UNUSED)
-        {
+    /* Take the ED at the head of the free ED list.  */
+    ed =  hcd_ohci -> ux_hcd_ohci_ed_free_list;
+    if (ed == UX_NULL)
+    {
 
-            /* The ED may have been used, so we reset all fields.  */
-            _ux_utility_memory_set(ed, 0, sizeof(UX_OHCI_ED)); /* Use case of memset is verified. */
+        /* There is no available ED in the ED list, count it for diagnostics.  */
+        hcd_ohci -> ux_hcd_ohci_ed_obtain_failures++;
 
-            /* This ED is now marked as USED.  */
-            ed -> ux_ohci_ed_status =  UX_USED;
+        /* Restore interrupts.  */
+        UX_RESTORE
 
-            /* Success, return the ED pointer.  */
-            return(ed);
-        }
- 
-        /* Point to the next ED.  */
-        ed++;
+        /* Error, return a null.  */
+        return(UX_NULL);
     }
+    hcd_ohci -> ux_hcd_ohci_ed_free_list =  ed -> ux_ohci_ed_previous_ed;
+
+    /* The ED may have been used, so we reset all fields.  */
+    _ux_utility_memory_set(ed, 0, sizeof(UX_OHCI_ED)); /* Use case of memset is verified. */
+
+    /* This ED is now marked as USED.  */
+    ed -> ux_ohci_ed_status =  UX_USED;
+
+    /* Restore interrupts.  */
+    UX_RESTORE
 
-    /* There is no available ED in the ED list, return a NULL.  */
-    return(UX_NULL);
+    /* Success, return ED pointer.  */
+    return(ed);
 }
 
@@ -34,7 +34,7 @@
 /*  FUNCTION                                               RELEASE        */ 
 /*                                                                        */ 
 /*    _ux_hcd_ohci_initialize                             PORTABLE C      */ 
-/*                                                           6.1.12       */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -87,6 +87,11 @@
 /*  07-29-2022     Yajun Xia                Modified comment(s),          */
 /*                                            fixed OHCI PRSC issue,      */
 /*                                            resulting in version 6.1.12 */
+/*  xx-xx-xxxx     Mohamed ayed             Modified comment(s),          */
+/*                                            seeded descriptor free      */
+/*                                            lists,                      */
+/*                                            fixed ISO TD list check,    */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_hcd_ohci_initialize(UX_HCD *hcd)
@@ -145,9 +150,26 @@ UINT            status;
 
     /* Allocate the list of isochronous tds. All tds are allocated on 32 byte memory boundary.  */
     hcd_ohci -> ux_hcd_ohci_iso_td_list =  _ux_utility_memory_allocate(UX_ALIGN_32, UX_CACHE_SAFE_MEMORY, sizeof(UX_OHCI_ISO_TD) * _ux_system_host -> ux_system_host_max_iso_td);
-    if (hcd_ohci -> ux_hcd_ohci_td_list == UX_NULL)
+    if ((hcd_ohci -> ux_hcd_ohci_iso_td_list == UX_NULL) && (_ux_system_host -> ux_system_host_max_iso_td != 0))
         return(UX_MEMORY_INSUFFICIENT);
 
+    /* Put all the descriptors on the free lists of the controller.  */
+    for (index_loop = _ux_system_host -> ux_system_host_max_ed; index_loop > 0; index_loop --)
+    {
+        hcd_ohci -> ux_hcd_ohci_ed_list[index_loop - 1].ux_ohci_ed_previous_ed =  hcd_ohci -> ux_hcd_ohci_ed_free_list;
+        hcd_ohci -> ux_hcd_ohci_ed_free_list =  &hcd_ohci -> ux_hcd_ohci_ed_list[index_loop - 1];
+    }
+    for (index_loop = _ux_system_host -> ux_system_host_max_td; index_loop > 0; index_loop --)
+    {
+        hcd_ohci -> ux_hcd_ohci_td_list[index_loop - 1].ux_ohci_td_next_free =  hcd_ohci -> ux_hcd_ohci_td_free_list;
+        hcd_ohci -> ux_hcd_ohci_td_free_list =  &hcd_ohci -> ux_hcd_ohci_td_list[index_loop - 1];
+    }
+    for (index_loop = _ux_system_host -> ux_system_host_max_iso_td; index_loop > 0; index_loop --)
+    {
+        hcd_ohci -> ux_hcd_ohci_iso_td_list[index_loop - 1].ux_ohci_iso_td_next_free =  hcd_ohci -> ux_hcd_ohci_iso_td_free_list;
+        hcd_ohci -> ux_hcd_ohci_iso_td_free_list =  &hcd_ohci -> ux_hcd_ohci_iso_td_list[index_loop - 1];
+    }
+
     /* Initialize the periodic tree.  */
     status =  _ux_hcd_ohci_periodic_tree_create(hcd_ohci);
     if (status != UX_SUCCESS)
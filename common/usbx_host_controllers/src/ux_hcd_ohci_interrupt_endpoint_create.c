@@ -34,7 +34,7 @@
 /*  FUNCTION                                               RELEASE        */ 
 /*                                                                        */ 
 /*    _ux_hcd_ohci_interrupt_endpoint_create              PORTABLE C      */ 
-/*                                                           6.1.6        */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -60,6 +60,9 @@
 /*     interval required. At that node, we anchor our real ED to the node */ 
 /*     and link the ED that was attached to the node to our ED.           */ 
 /*                                                                        */ 
+/*     If the host stack periodic schedule is enabled, the list is the    */
+/*     one of the frame chosen by the schedule.                           */
+/*                                                                        */
 /*  INPUT                                                                 */ 
 /*                                                                        */ 
 /*    hcd_ohci                              Pointer to OHCI               */ 
@@ -72,6 +75,7 @@
 /*  CALLS                                                                 */ 
 /*                                                                        */ 
 /*    _ux_hcd_ohci_ed_obtain                Obtain OHCI ED                */ 
+/*    _ux_hcd_ohci_ed_release               Release ED                    */
 /*    _ux_hcd_ohci_least_traffic_list_get   Get least traffic list        */ 
 /*    _ux_hcd_ohci_regular_td_obtain        Obtain OHCI regular TD        */ 
 /*    _ux_utility_physical_address          Get physical address          */ 
@@ -93,6 +97,11 @@
 /*  04-02-2021     Chaoqiong Xiao           Modified comment(s),          */
 /*                                            filled max transfer length, */
 /*                                            resulting in version 6.1.6  */
+/*  xx-xx-xxxx     Mohamed ayed             Modified comment(s),          */
+/*                                            used stack periodic         */
+/*                                            schedule placement,         */
+/*                                            released ED to free list,   */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_hcd_ohci_interrupt_endpoint_create(UX_HCD_OHCI *hcd_ohci, UX_ENDPOINT *endpoint)
@@ -119,7 +128,7 @@ UINT            interval_ohci;
     if (td == UX_NULL)
     {
     
-        ed -> ux_ohci_ed_status =  UX_UNUSED;
+        _ux_hcd_ohci_ed_release(hcd_ohci, ed);
         return(UX_NO_TD_AVAILABLE);
     }
 
@@ -148,8 +157,16 @@ UINT            interval_ohci;
     ed -> ux_ohci_ed_tail_td =  _ux_utility_physical_address(td);
     ed -> ux_ohci_ed_head_td =  _ux_utility_physical_address(td);
 
+#if defined(UX_HOST_PERIODIC_SCHEDULE_ENABLE)
+
+    /* Get the list of the frame chosen by the host stack periodic schedule.  */
+    ed_list =  _ux_utility_virtual_address(hcd_ohci -> ux_hcd_ohci_hcca ->
+                            ux_hcd_ohci_hcca_ed[((ULONG)endpoint -> ux_endpoint_schedule_offset >> 3) & 0x1f]);
+#else
+
     /* Get the list index with the least traffic.  */
     ed_list =  _ux_hcd_ohci_least_traffic_list_get(hcd_ohci);
+#endif
     
     /* Get the interval for the endpoint and match it to a OHCI list. We match anything that 
        is > 32ms to the 32ms interval list. The 32ms list is list 0, 16ms list is 1 ...
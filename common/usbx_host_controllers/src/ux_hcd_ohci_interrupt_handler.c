@@ -34,7 +34,7 @@
 /*  FUNCTION                                               RELEASE        */ 
 /*                                                                        */ 
 /*    _ux_hcd_ohci_interrupt_handler                      PORTABLE C      */ 
-/*                                                           6.1.12       */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -82,6 +82,9 @@
 /*  07-29-2022     Yajun Xia                Modified comment(s),          */
 /*                                            fixed OHCI PRSC issue,      */
 /*                                            resulting in version 6.1.12 */
+/*  xx-xx-xxxx     Mohamed ayed             Modified comment(s),          */
+/*                                            used HCD thread signal,     */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 VOID  _ux_hcd_ohci_interrupt_handler(VOID)
@@ -124,8 +127,7 @@ ULONG           port_index;
                        to wake up and process them.  */
                     hcd_ohci -> ux_hcd_ohci_done_head =  hcd_ohci -> ux_hcd_ohci_hcca -> ux_hcd_ohci_hcca_done_head;
                     hcd_ohci -> ux_hcd_ohci_hcca -> ux_hcd_ohci_hcca_done_head =  UX_NULL;                    
-                    hcd -> ux_hcd_thread_signal++;
-                    _ux_host_semaphore_put(&_ux_system_host -> ux_system_host_hcd_semaphore);
+                    UX_HOST_HCD_THREAD_SIGNAL(hcd);
 
                     /* Since we have delayed the processing of the done queue to a thread.
                        We need to ensure the host controller will not overwrite the done
@@ -140,9 +142,8 @@ ULONG           port_index;
                     /* The controller has issued a Unrecoverable Error signal. The controller will 
                        be reset now, and we wake up the HCD thread.  */
                     _ux_hcd_ohci_register_write(hcd_ohci, OHCI_HC_COMMAND_STATUS, OHCI_HC_CS_HCR);
-                    hcd -> ux_hcd_thread_signal++;
                     hcd -> ux_hcd_status =  UX_HCD_STATUS_DEAD;
-                    _ux_host_semaphore_put(&_ux_system_host -> ux_system_host_hcd_semaphore);
+                    UX_HOST_HCD_THREAD_SIGNAL(hcd);
                 }
 
                 if (ohci_register & OHCI_HC_INT_RHSC)
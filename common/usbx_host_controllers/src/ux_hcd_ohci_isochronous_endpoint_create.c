@@ -34,7 +34,7 @@
 /*  FUNCTION                                               RELEASE        */ 
 /*                                                                        */ 
 /*    _ux_hcd_ohci_isochronous_endpoint_create            PORTABLE C      */ 
-/*                                                           6.1.6        */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -55,6 +55,7 @@
 /*  CALLS                                                                 */ 
 /*                                                                        */ 
 /*    _ux_hcd_ohci_ed_obtain                Obtain an OHCI ED             */ 
+/*    _ux_hcd_ohci_ed_release               Release ED                    */
 /*    _ux_hcd_ohci_isochronous_td_obtain    Obtain an OHCI TD             */ 
 /*    _ux_utility_physical_address          Get physical address          */ 
 /*    _ux_utility_virtual_address           Get virtual address           */ 
@@ -73,6 +74,9 @@
 /*  04-02-2021     Chaoqiong Xiao           Modified comment(s),          */
 /*                                            filled max transfer length, */
 /*                                            resulting in version 6.1.6  */
+/*  xx-xx-xxxx     Mohamed ayed             Modified comment(s),          */
+/*                                            released ED to free list,   */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_hcd_ohci_isochronous_endpoint_create(UX_HCD_OHCI *hcd_ohci, UX_ENDPOINT *endpoint)
@@ -98,7 +102,7 @@ UX_OHCI_ISO_TD          *td;
     td =  _ux_hcd_ohci_isochronous_td_obtain(hcd_ohci);
     if (td == UX_NULL)
     {
-        ed -> ux_ohci_ed_status =  UX_UNUSED;
+        _ux_hcd_ohci_ed_release(hcd_ohci, ed);
         return(UX_NO_TD_AVAILABLE);
     }
 
@@ -34,7 +34,7 @@
 /*  FUNCTION                                               RELEASE        */ 
 /*                                                                        */ 
 /*    _ux_hcd_ohci_isochronous_td_obtain                  PORTABLE C      */ 
-/*                                                           6.1          */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -68,39 +68,50 @@
 /*                                            verified memset and memcpy  */
 /*                                            cases,                      */
 /*                                            resulting in version 6.1    */
+/*  xx-xx-xxxx     Mohamed ayed             Modified comment(s),          */
+/*                                            used free list,             */
+/*                                            counted exhaustion,         */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UX_OHCI_ISO_TD  *_ux_hcd_ohci_isochronous_td_obtain(UX_HCD_OHCI *hcd_ohci)
 {
 
+UX_INTERRUPT_SAVE_AREA
+
 UX_OHCI_ISO_TD      *td;
-ULONG               td_index;
 
 
-    /* Start the search from the beginning of the list.  */
-    td =  hcd_ohci -> ux_hcd_ohci_iso_td_list;
-    for (td_index = 0; td_index < _ux_system_host -> ux_system_host_max_iso_td; td_index++)
+    /* Lockout interrupts, the free list is shared by all the users of the
+       controller.  */
+    UX_DISABLE
+
+    /* Take the TD at the head of the free TD list.  */
+    td =  hcd_ohci -> ux_hcd_ohci_iso_td_free_list;
+    if (td == UX_NULL)
     {
 
-        /* Check the TD status, a free TD is marked with the UNUSED flag.  */
-        if (td -> ux_ohci_iso_td_status == UX_UNUSED)
-        {
+        /* There is no available TD in the TD list, count it for diagnostics.  */
+        hcd_ohci -> ux_hcd_ohci_iso_td_obtain_failures++;
 
-            /* The TD may have been used, so we reset all fields.  */
-            _ux_utility_memory_set(td, 0, sizeof(UX_OHCI_ISO_TD)); /* Use case of memset is verified. */
+        /* Restore interrupts.  */
+        UX_RESTORE
 
-            /* This TD is now marked as USED.  */
-            td -> ux_ohci_iso_td_status =  UX_USED;
+        /* Error, return a null.  */
+        return(UX_NULL);
+    }
+    hcd_ohci -> ux_hcd_ohci_iso_td_free_list =  td -> ux_ohci_iso_td_next_free;
 
-            /* Success, return the TD pointer.  */
-            return(td);
-        }
+    /* The TD may have been used, so we reset all fields.  */
+    _ux_utility_memory_set(td, 0, sizeof(UX_OHCI_ISO_TD)); /* Use case of memset is verified. */
 
-        /* Move to next TD.  */
-        td++;
-    }
+    /* This TD is now marked as USED.  */
+    td -> ux_ohci_iso_td_status =  UX_USED;
+
+    /* Restore interrupts.  */
+    UX_RESTORE
 
-    /* There is no available TD in the TD list.  */
-    return(UX_NULL);
+    /* Success, return TD pointer.  */
+    return(td);
 }
 
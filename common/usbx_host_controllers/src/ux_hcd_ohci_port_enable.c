@@ -34,7 +34,7 @@
 /*  FUNCTION                                               RELEASE        */ 
 /*                                                                        */ 
 /*    _ux_hcd_ohci_port_enable                            PORTABLE C      */ 
-/*                                                           6.1          */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -70,6 +70,9 @@
 /*  05-19-2020     Chaoqiong Xiao           Initial Version 6.0           */
 /*  09-30-2020     Chaoqiong Xiao           Modified comment(s),          */
 /*                                            resulting in version 6.1    */
+/*  xx-xx-xxxx     Mohamed ayed             Modified comment(s),          */
+/*                                            added adaptive enum timing, */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_hcd_ohci_port_enable(UX_HCD_OHCI *hcd_ohci, ULONG port_index)
@@ -108,8 +111,10 @@ ULONG       ohci_register_port_status;
         return(UX_NO_DEVICE_CONNECTED);
     }
     
-    /* Wait 50ms before we issue the command, otherwise some device do not answer!  */
-    _ux_utility_delay_ms(UX_PORT_ENABLE_WAIT);
+    /* Wait 50ms before we issue the command, otherwise some device do not answer!
+       With adaptive timing the shorter wait is used until a device failed on the port.  */
+    _ux_utility_delay_ms(UX_HOST_ENUM_DELAY(hcd_ohci -> ux_hcd_ohci_hcd_owner, port_index,
+                                            UX_HOST_ENUM_PORT_ENABLE_WAIT_MIN, UX_PORT_ENABLE_WAIT));
 
     /* Write the command PES to this port.   */
     _ux_hcd_ohci_register_write(hcd_ohci, OHCI_HC_RH_PORT_STATUS + port_index, OHCI_HC_PS_PES);
@@ -34,7 +34,7 @@
 /*  FUNCTION                                               RELEASE        */ 
 /*                                                                        */ 
 /*    _ux_hcd_ohci_regular_td_obtain                      PORTABLE C      */ 
-/*                                                           6.1.11       */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -54,8 +54,6 @@
 /*  CALLS                                                                 */ 
 /*                                                                        */ 
 /*    _ux_utility_memory_set                Set memory block              */ 
-/*    _ux_host_mutex_on                     Get protection mutex          */
-/*    _ux_host_mutex_off                    Release protection mutex      */ 
 /*                                                                        */ 
 /*  CALLED BY                                                             */ 
 /*                                                                        */ 
@@ -73,51 +71,50 @@
 /*  04-25-2022     Chaoqiong Xiao           Modified comment(s),          */
 /*                                            fixed standalone compile,   */
 /*                                            resulting in version 6.1.11 */
+/*  xx-xx-xxxx     Mohamed ayed             Modified comment(s),          */
+/*                                            used free list,             */
+/*                                            counted exhaustion,         */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UX_OHCI_TD  *_ux_hcd_ohci_regular_td_obtain(UX_HCD_OHCI *hcd_ohci)
 {
 
-UX_OHCI_TD      *td;
-ULONG           td_index;
+UX_INTERRUPT_SAVE_AREA
 
+UX_OHCI_TD      *td;
 
-    /* Set the Mutex as this is a critical section.  */
-    _ux_host_mutex_on(&_ux_system -> ux_system_mutex);
 
-    /* Start the search from the beginning of the regular TD list.  */
-    td =  hcd_ohci -> ux_hcd_ohci_td_list;
+    /* Lockout interrupts, the free list is shared by all the users of the
+       controller.  */
+    UX_DISABLE
 
-    for (td_index = 0; td_index < _ux_system_host -> ux_system_host_max_td; td_index++)
+    /* Take the TD at the head of the free TD list.  */
+    td =  hcd_ohci -> ux_hcd_ohci_td_free_list;
+    if (td == UX_NULL)
     {
 
-        /* Check the TD status, a free TD is marked with the UNUSED flag.  */
-        if (td -> ux_ohci_td_status == UX_UNUSED)
-        {
-
-            /* The TD may have been used, so we reset all fields.  */
-            _ux_utility_memory_set(td, 0, sizeof(UX_OHCI_TD)); /* Use case of memset is verified. */
+        /* There is no available TD in the TD list, count it for diagnostics.  */
+        hcd_ohci -> ux_hcd_ohci_td_obtain_failures++;
 
-            /* This TD is now marked as USED.  */
-            td -> ux_ohci_td_status =  UX_USED;
+        /* Restore interrupts.  */
+        UX_RESTORE
 
-            /* Release the protection.  */
-            _ux_host_mutex_off(&_ux_system -> ux_system_mutex);
-
-            /* Return TD pointer - success!  */
-            return(td);
-        }
-
-        /* Move to the next TD.  */
-        td++;
+        /* Error, return a null.  */
+        return(UX_NULL);
     }
+    hcd_ohci -> ux_hcd_ohci_td_free_list =  td -> ux_ohci_td_next_free;
+
+    /* The TD may have been used, so we reset all fields.  */
+    _ux_utility_memory_set(td, 0, sizeof(UX_OHCI_TD)); /* Use case of memset is verified. */
 
-    /* There is no available TD in the TD list.  */
+    /* This TD is now marked as USED.  */
+    td -> ux_ohci_td_status =  UX_USED;
 
-    /* Release protection.  */
-    _ux_host_mutex_off(&_ux_system -> ux_system_mutex);
+    /* Restore interrupts.  */
+    UX_RESTORE
 
-    /* Return NULL to caller.  */
-    return(UX_NULL);
+    /* Success, return TD pointer.  */
+    return(td);
 }
 
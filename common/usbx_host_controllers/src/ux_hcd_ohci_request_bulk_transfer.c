@@ -34,7 +34,7 @@
 /*  FUNCTION                                               RELEASE        */ 
 /*                                                                        */ 
 /*    _ux_hcd_ohci_request_bulk_transfer                  PORTABLE C      */ 
-/*                                                           6.1          */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -61,6 +61,7 @@
 /*    _ux_hcd_ohci_register_read            Read OHCI register            */ 
 /*    _ux_hcd_ohci_register_write           Write OHCI register           */ 
 /*    _ux_hcd_ohci_regular_td_obtain        Get regular TD                */ 
+/*    _ux_hcd_ohci_regular_td_release       Release TD                    */
 /*    _ux_utility_physical_address          Get physical address          */ 
 /*    _ux_utility_virtual_address           Get virtual address           */ 
 /*                                                                        */ 
@@ -75,6 +76,11 @@
 /*  05-19-2020     Chaoqiong Xiao           Initial Version 6.0           */
 /*  09-30-2020     Chaoqiong Xiao           Modified comment(s),          */
 /*                                            resulting in version 6.1    */
+/*  xx-xx-xxxx     Mohamed ayed             Modified comment(s),          */
+/*                                            added transfer segments     */
+/*                                            support,                    */
+/*                                            released TDs to free list,  */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_hcd_ohci_request_bulk_transfer(UX_HCD_OHCI *hcd_ohci, UX_TRANSFER *transfer_request)
@@ -92,6 +98,11 @@ ULONG           bulk_packet_payload_length;
 UCHAR *         data_pointer;
 ULONG           ohci_register;
 ULONG           zlp_flag;
+#if defined(UX_TRANSFER_SEGMENTS_ENABLE)
+UX_TRANSFER_SEGMENT *segment;
+ULONG           segment_length;
+ULONG           segment_left;
+#endif
     
 
     /* Get the pointer to the Endpoint.  */
@@ -123,6 +134,21 @@ ULONG           zlp_flag;
     
         /* We do not have a zlp.  */
         zlp_flag = UX_FALSE;
+
+#if defined(UX_TRANSFER_SEGMENTS_ENABLE)
+
+    /* With segments, each segment is described by its own TDs, a TD never crosses
+       a segment boundary.  */
+    segment =  transfer_request -> ux_transfer_request_segments;
+    segment_length =  transfer_request_payload_length;
+    segment_left =  0;
+    if (transfer_request -> ux_transfer_request_segment_count != 0)
+    {
+        data_pointer =  segment -> ux_transfer_segment_data_pointer;
+        segment_length =  segment -> ux_transfer_segment_length;
+        segment_left =  transfer_request -> ux_transfer_request_segment_count - 1;
+    }
+#endif
                 
     /* Build all necessary TDs.  */
     while ((transfer_request_payload_length != 0) || zlp_flag == UX_TRUE)
@@ -131,6 +157,33 @@ ULONG           zlp_flag;
         /* Reset ZLP now.  */
         zlp_flag = UX_FALSE;        
       
+#if defined(UX_TRANSFER_SEGMENTS_ENABLE)
+
+        /* Skip the empty segments, up to the last one.  */
+        while ((segment_length == 0) && (transfer_request_payload_length != 0) && (segment_left != 0))
+        {
+            segment ++;
+            segment_left --;
+            data_pointer =  segment -> ux_transfer_segment_data_pointer;
+            segment_length =  segment -> ux_transfer_segment_length;
+        }
+
+        /* The segments may not be longer than the requested length.  */
+        if (segment_length > transfer_request_payload_length)
+            segment_length =  transfer_request_payload_length;
+
+        /* Check if we are exceeding the max payload. */
+        if (segment_length > UX_OHCI_MAX_PAYLOAD)
+
+            bulk_packet_payload_length =  UX_OHCI_MAX_PAYLOAD;
+        else
+
+            bulk_packet_payload_length =  segment_length;
+
+        /* Adjust the length left in this segment.  */
+        segment_length -=  bulk_packet_payload_length;
+#else
+
         /* Check if we are exceeding the max payload. */
         if (transfer_request_payload_length > UX_OHCI_MAX_PAYLOAD)
 
@@ -138,6 +191,7 @@ ULONG           zlp_flag;
         else
 
             bulk_packet_payload_length =  transfer_request_payload_length;
+#endif
 
         /* IN transfer ? */
         if ((transfer_request -> ux_transfer_request_type&UX_REQUEST_DIRECTION) == UX_REQUEST_IN)
@@ -164,6 +218,13 @@ ULONG           zlp_flag;
         transfer_request_payload_length -=  bulk_packet_payload_length;
         data_pointer +=  bulk_packet_payload_length;
 
+#if defined(UX_TRANSFER_SEGMENTS_ENABLE)
+
+        /* The transfer ends with the last segment.  */
+        if ((segment_length == 0) && (segment_left == 0))
+            transfer_request_payload_length =  0;
+#endif
+
         /* Check if there will be another transaction.  */
         if (transfer_request_payload_length != 0)
         {
@@ -183,7 +244,7 @@ ULONG           zlp_flag;
                     {
 
                         next_data_td =  _ux_utility_virtual_address(data_td -> ux_ohci_td_next_td);
-                        data_td -> ux_ohci_td_status =  UX_UNUSED;
+                        _ux_hcd_ohci_regular_td_release(hcd_ohci, data_td);
                         data_td =  next_data_td;
                     }
                 }
@@ -217,7 +278,7 @@ ULONG           zlp_flag;
             {
 
                 next_data_td =  _ux_utility_virtual_address(data_td -> ux_ohci_td_next_td);
-                data_td -> ux_ohci_td_status =  UX_UNUSED;
+                _ux_hcd_ohci_regular_td_release(hcd_ohci, data_td);
                 data_td =  next_data_td;
             }
         }
@@ -34,7 +34,7 @@
 /*  FUNCTION                                               RELEASE        */ 
 /*                                                                        */ 
 /*    _ux_hcd_ohci_request_control_transfer               PORTABLE C      */ 
-/*                                                           6.1.10       */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -64,6 +64,7 @@
 /*    _ux_hcd_ohci_register_read            Read OHCI register            */ 
 /*    _ux_hcd_ohci_register_write           Write OHCI register           */ 
 /*    _ux_hcd_ohci_regular_td_obtain        Get regular TD                */ 
+/*    _ux_hcd_ohci_regular_td_release       Release TD                    */
 /*    _ux_host_stack_transfer_request_abort Abort transfer request        */ 
 /*    _ux_utility_memory_allocate           Allocate memory block         */ 
 /*    _ux_utility_memory_free               Release memory block          */ 
@@ -90,6 +91,9 @@
 /*  01-31-2022     Chaoqiong Xiao           Modified comment(s),          */
 /*                                            refined macros names,       */
 /*                                            resulting in version 6.1.10 */
+/*  xx-xx-xxxx     Mohamed ayed             Modified comment(s),          */
+/*                                            released TDs to free list,  */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_hcd_ohci_request_control_transfer(UX_HCD_OHCI *hcd_ohci, UX_TRANSFER *transfer_request)
@@ -197,7 +201,7 @@ UINT            status;
 
         _ux_utility_memory_free(setup_request);
         if (data_td != UX_NULL)
-            data_td -> ux_ohci_td_status =  UX_UNUSED;
+            _ux_hcd_ohci_regular_td_release(hcd_ohci, data_td);
         return(UX_NO_TD_AVAILABLE);
     }
 
@@ -232,8 +236,8 @@ UINT            status;
 
         _ux_utility_memory_free(setup_request);
         if (data_td != UX_NULL)
-            data_td -> ux_ohci_td_status =  UX_UNUSED;
-        status_td -> ux_ohci_td_status =  UX_UNUSED;
+            _ux_hcd_ohci_regular_td_release(hcd_ohci, data_td);
+        _ux_hcd_ohci_regular_td_release(hcd_ohci, status_td);
         return(UX_NO_TD_AVAILABLE);
     }
 
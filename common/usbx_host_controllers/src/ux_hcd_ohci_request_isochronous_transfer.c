@@ -34,7 +34,7 @@
 /*  FUNCTION                                               RELEASE        */ 
 /*                                                                        */ 
 /*    _ux_hcd_ohci_request_isochronous_transfer           PORTABLE C      */ 
-/*                                                           6.1          */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -57,6 +57,7 @@
 /*  CALLS                                                                 */ 
 /*                                                                        */ 
 /*    _ux_hcd_ohci_isochronous_td_obtain    Get isochronous TD            */ 
+/*    _ux_hcd_ohci_isochronous_td_release   Release TD                    */
 /*    _ux_utility_physical_address          Get physical address          */ 
 /*    _ux_utility_virtual_address           Get virtual address           */ 
 /*                                                                        */ 
@@ -71,6 +72,9 @@
 /*  05-19-2020     Chaoqiong Xiao           Initial Version 6.0           */
 /*  09-30-2020     Chaoqiong Xiao           Modified comment(s),          */
 /*                                            resulting in version 6.1    */
+/*  xx-xx-xxxx     Mohamed ayed             Modified comment(s),          */
+/*                                            released TDs to free list,  */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_hcd_ohci_request_isochronous_transfer(UX_HCD_OHCI *hcd_ohci, UX_TRANSFER *transfer_request)
@@ -189,7 +193,7 @@ ULONG               current_frame_number;
                     {
 
                         next_data_td =  _ux_utility_virtual_address(data_td -> ux_ohci_iso_td_next_td);
-                        data_td -> ux_ohci_iso_td_status =  UX_UNUSED;
+                        _ux_hcd_ohci_isochronous_td_release(hcd_ohci, data_td);
                         data_td =  next_data_td;
                     }
                 }
@@ -226,7 +230,7 @@ ULONG               current_frame_number;
             {
 
                 next_data_td =  _ux_utility_virtual_address(data_td -> ux_ohci_iso_td_next_td);
-                data_td -> ux_ohci_iso_td_status =  UX_UNUSED;
+                _ux_hcd_ohci_isochronous_td_release(hcd_ohci, data_td);
                 data_td =  next_data_td;
             }
         }
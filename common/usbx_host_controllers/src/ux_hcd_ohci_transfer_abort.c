@@ -34,7 +34,7 @@
 /*  FUNCTION                                               RELEASE        */ 
 /*                                                                        */ 
 /*    _ux_hcd_ohci_transfer_abort                         PORTABLE C      */ 
-/*                                                           6.1.2        */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -55,6 +55,7 @@
 /*                                                                        */ 
 /*  CALLS                                                                 */ 
 /*                                                                        */ 
+/*    _ux_hcd_ohci_regular_td_release       Release TD                    */
 /*    _ux_utility_delay_ms                  Delay                         */ 
 /*    _ux_utility_physical_address          Get physical address          */ 
 /*    _ux_utility_virtual_address           Get virtual address           */ 
@@ -75,6 +76,9 @@
 /*  11-09-2020     Chaoqiong Xiao           Modified comment(s),          */
 /*                                            fixed compile warnings,     */
 /*                                            resulting in version 6.1.2  */
+/*  xx-xx-xxxx     Mohamed ayed             Modified comment(s),          */
+/*                                            released TDs to free list,  */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_hcd_ohci_transfer_abort(UX_HCD_OHCI *hcd_ohci, UX_TRANSFER *transfer_request)
@@ -134,7 +138,7 @@ ULONG           value_carry;
         ed -> ux_ohci_ed_head_td =  head_td -> ux_ohci_td_next_td;
 
         /* Mark the current head TD as free.  */
-        head_td -> ux_ohci_td_status =  UX_UNUSED;
+        _ux_hcd_ohci_regular_td_release(hcd_ohci, head_td);
 
         /* Now the new head TD is the next TD in the chain.  */
         head_td =  _ux_utility_virtual_address(ed -> ux_ohci_ed_head_td);
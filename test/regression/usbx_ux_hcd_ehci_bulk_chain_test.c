@@ -0,0 +1,341 @@
+/* This test is designed to test the EHCI bulk chains: the TDs of a bulk IN transfer
+   span whole packets, and a short packet received before the last TD stops the
+   queue on the short packet TD. The transfer is then complete, its TDs are freed
+   and the short packet TD is kept until the controller is disabled.  */
+
+#include <stdio.h>
+#include "tx_api.h"
+#include "ux_api.h"
+#include "ux_system.h"
+#include "ux_utility.h"
+#include "ux_host_stack.h"
+#include "ux_hcd_ehci.h"
+
+#include "ux_test.h"
+
+
+/* Define USBX test constants.  */
+
+#define UX_TEST_STACK_SIZE      4096
+#define UX_TEST_MEMORY_SIZE     (128*1024)
+
+#define UX_TEST_TRANSFERS       2
+#define UX_TEST_TDS             8
+#define UX_TEST_LENGTH          (UX_EHCI_PAGE_SIZE * 12)
+#define UX_TEST_SHORT_LENGTH    100
+
+
+/* Define the counters used in the test application...  */
+
+static ULONG                           error_counter;
+
+#if defined(UX_HCD_EHCI_BULK_CHAIN_ENABLE)
+static UX_HCD                          test_hcd;
+static UX_DEVICE                       test_device;
+static UX_ENDPOINT                     test_endpoint;
+static UX_TRANSFER                     test_transfers[UX_TEST_TRANSFERS];
+static UCHAR                           test_buffer[UX_TEST_LENGTH];
+static UX_HCD_EHCI                     test_hcd_ehci;
+static ULONG                           test_registers[64];
+static UX_EHCI_ED                      *test_ed;
+#endif
+
+
+/* Define prototypes for external Host Controller's (HCDs), classes and clients.  */
+
+static TX_THREAD           ux_test_thread_simulation_0;
+static void                ux_test_thread_simulation_0_entry(ULONG);
+
+
+/* Prototype for test control return.  */
+
+void  test_control_return(UINT status);
+
+
+static VOID error_callback(UINT system_level, UINT system_context, UINT error_code)
+{
+
+    /* Failed test.  */
+    printf("Error #%d, system_level: %d, system_context: %d, error_code: 0x%x\n", __LINE__, system_level, system_context, error_code);
+    error_counter ++;
+}
+
+#if defined(UX_HCD_EHCI_BULK_CHAIN_ENABLE)
+static VOID _ux_test_ehci_initialize(VOID)
+{
+
+ULONG           i;
+UX_EHCI_ED      *ed;
+UX_EHCI_LINK_POINTER    lp;
+
+    /* Build the free lists and the asynchronous list of an EHCI controller, as
+       its initialization does. The registers are in memory.  */
+    ux_utility_memory_set(&test_hcd, 0, sizeof(test_hcd));
+    ux_utility_memory_set(&test_hcd_ehci, 0, sizeof(test_hcd_ehci));
+    ux_utility_memory_set(test_registers, 0, sizeof(test_registers));
+    test_hcd_ehci.ux_hcd_ehci_hcd_owner = &test_hcd;
+    test_hcd_ehci.ux_hcd_ehci_base = test_registers;
+    test_hcd_ehci.ux_hcd_ehci_ed_list = _ux_utility_memory_allocate(UX_ALIGN_32, UX_CACHE_SAFE_MEMORY, sizeof(UX_EHCI_ED) * _ux_system_host -> ux_system_host_max_ed);
+    UX_TEST_ASSERT(test_hcd_ehci.ux_hcd_ehci_ed_list != UX_NULL);
+    test_hcd_ehci.ux_hcd_ehci_td_list = _ux_utility_memory_allocate(UX_ALIGN_32, UX_CACHE_SAFE_MEMORY, sizeof(UX_EHCI_TD) * _ux_system_host -> ux_system_host_max_td);
+    UX_TEST_ASSERT(test_hcd_ehci.ux_hcd_ehci_td_list != UX_NULL);
+    for (i = _ux_system_host -> ux_system_host_max_ed; i > 0; i --)
+    {
+        test_hcd_ehci.ux_hcd_ehci_ed_list[i - 1].REF_AS.FREE.ux_ehci_ed_next_free = test_hcd_ehci.ux_hcd_ehci_ed_free_list;
+        test_hcd_ehci.ux_hcd_ehci_ed_free_list = &test_hcd_ehci.ux_hcd_ehci_ed_list[i - 1];
+    }
+    for (i = _ux_system_host -> ux_system_host_max_td; i > 0; i --)
+    {
+        test_hcd_ehci.ux_hcd_ehci_td_list[i - 1].ux_ehci_td_next_free = test_hcd_ehci.ux_hcd_ehci_td_free_list;
+        test_hcd_ehci.ux_hcd_ehci_td_free_list = &test_hcd_ehci.ux_hcd_ehci_td_list[i - 1];
+    }
+    UX_TEST_ASSERT(_ux_host_mutex_create(&test_hcd_ehci.ux_hcd_ehci_periodic_mutex, "ehci_periodic_mutex") == UX_SUCCESS);
+
+    /* The head ED of the asynchronous list points to itself.  */
+    ed = _ux_hcd_ehci_ed_obtain(&test_hcd_ehci);
+    UX_TEST_ASSERT(ed != UX_NULL);
+    lp.void_ptr = _ux_utility_physical_address(ed);
+    lp.value |= UX_EHCI_QH_TYP_QH;
+    ed -> ux_ehci_ed_queue_head = lp.ed_ptr;
+    ed -> ux_ehci_ed_cap0 = UX_EHCI_QH_HEAD;
+    test_hcd_ehci.ux_hcd_ehci_asynch_head_list = ed;
+    test_hcd_ehci.ux_hcd_ehci_asynch_first_list = ed;
+    test_hcd_ehci.ux_hcd_ehci_asynch_last_list = ed;
+
+    /* The inactive TD the queue stops on when a short packet is received.  */
+    test_hcd_ehci.ux_hcd_ehci_short_td = _ux_hcd_ehci_regular_td_obtain(&test_hcd_ehci);
+    UX_TEST_ASSERT(test_hcd_ehci.ux_hcd_ehci_short_td != UX_NULL);
+
+    /* A high speed bulk IN endpoint.  */
+    ux_utility_memory_set(&test_device, 0, sizeof(test_device));
+    ux_utility_memory_set(&test_endpoint, 0, sizeof(test_endpoint));
+    ux_utility_memory_set(test_transfers, 0, sizeof(test_transfers));
+    test_device.ux_device_speed = UX_HIGH_SPEED_DEVICE;
+    test_device.ux_device_address = 1;
+    test_endpoint.ux_endpoint_device = &test_device;
+    test_endpoint.ux_endpoint_descriptor.bEndpointAddress = 0x81;
+    test_endpoint.ux_endpoint_descriptor.bmAttributes = UX_BULK_ENDPOINT;
+    test_endpoint.ux_endpoint_descriptor.wMaxPacketSize = 512;
+    UX_TEST_ASSERT(_ux_hcd_ehci_asynchronous_endpoint_create(&test_hcd_ehci, &test_endpoint) == UX_SUCCESS);
+    test_ed = (UX_EHCI_ED *) test_endpoint.ux_endpoint_ed;
+    for (i = 0; i < UX_TEST_TRANSFERS; i ++)
+    {
+        test_transfers[i].ux_transfer_request_endpoint = &test_endpoint;
+        test_transfers[i].ux_transfer_request_type = UX_REQUEST_IN;
+        test_transfers[i].ux_transfer_request_data_pointer = test_buffer;
+        test_transfers[i].ux_transfer_request_requested_length = UX_TEST_LENGTH;
+        test_transfers[i].ux_transfer_request_completion_code = UX_TRANSFER_STATUS_PENDING;
+        UX_TEST_ASSERT(_ux_host_semaphore_create(&test_transfers[i].ux_transfer_request_semaphore, "test transfer semaphore", 0) == UX_SUCCESS);
+    }
+}
+
+static ULONG _ux_test_tds_get(UX_EHCI_TD **tds)
+{
+
+UX_EHCI_TD      *td;
+ULONG           count;
+
+    /* Get the TDs queued on the ED.  */
+    count = 0;
+    td = test_ed -> ux_ehci_ed_first_td;
+    while (1)
+    {
+        UX_TEST_ASSERT(count < UX_TEST_TDS);
+        tds[count ++] = td;
+        if ((ULONG) td -> ux_ehci_td_link_pointer & UX_EHCI_TD_T)
+            break;
+        td = _ux_utility_virtual_address(td -> ux_ehci_td_link_pointer);
+    }
+    return(count);
+}
+
+static VOID _ux_test_td_complete(UX_EHCI_TD *td, ULONG residual_length)
+{
+
+    /* The controller retires the TD with the length left.  */
+    td -> ux_ehci_td_control &= ~(UX_EHCI_TD_ACTIVE | (UX_EHCI_TD_LG_MASK << UX_EHCI_TD_LG_LOC));
+    td -> ux_ehci_td_control |= residual_length << UX_EHCI_TD_LG_LOC;
+}
+
+static VOID _ux_test_short_packet(VOID)
+{
+
+UX_EHCI_TD      *tds[UX_TEST_TDS];
+UX_EHCI_TD      *short_td;
+ULONG           td_count;
+ULONG           transfer_td_count;
+ULONG           i;
+
+    _ux_test_ehci_initialize();
+    short_td = test_hcd_ehci.ux_hcd_ehci_short_td;
+
+    /* Every TD of the transfer but the last one has the short packet TD as its
+       alternate TD, and holds whole packets.  */
+    UX_TEST_ASSERT(_ux_hcd_ehci_request_bulk_transfer(&test_hcd_ehci, &test_transfers[0]) == UX_SUCCESS);
+    transfer_td_count = _ux_test_tds_get(tds);
+    UX_TEST_ASSERT(transfer_td_count >= 3);
+    for (i = 0; i < transfer_td_count - 1; i ++)
+    {
+        UX_TEST_ASSERT(tds[i] -> ux_ehci_td_alternate_link_pointer == _ux_utility_physical_address(short_td));
+        UX_TEST_ASSERT((tds[i] -> ux_ehci_td_length % 512) == 0);
+    }
+    UX_TEST_ASSERT((ULONG) tds[transfer_td_count - 1] -> ux_ehci_td_alternate_link_pointer & UX_EHCI_TD_T);
+
+#if defined(UX_HCD_EHCI_TRANSFER_QUEUE_ENABLE)
+
+    /* A second transfer is queued behind the first one.  */
+    UX_TEST_ASSERT(_ux_hcd_ehci_request_bulk_transfer(&test_hcd_ehci, &test_transfers[1]) == UX_SUCCESS);
+    td_count = _ux_test_tds_get(tds);
+    UX_TEST_ASSERT(td_count == transfer_td_count * 2);
+#else
+    td_count = transfer_td_count;
+#endif
+
+    /* The first TD is received, a short packet ends the second one. The queue
+       stops on the short packet TD.  */
+    _ux_test_td_complete(tds[0], 0);
+    _ux_test_td_complete(tds[1], tds[1] -> ux_ehci_td_length - UX_TEST_SHORT_LENGTH);
+    test_ed -> ux_ehci_ed_current_td = _ux_utility_physical_address(tds[1]);
+    test_ed -> ux_ehci_ed_queue_element = _ux_utility_physical_address(short_td);
+    test_ed -> ux_ehci_ed_state = UX_EHCI_QH_TOGGLE;
+    _ux_hcd_ehci_done_queue_process(&test_hcd_ehci);
+
+    /* The transfer is complete with the length received.  */
+    UX_TEST_ASSERT(test_transfers[0].ux_transfer_request_completion_code == UX_SUCCESS);
+    UX_TEST_ASSERT(test_transfers[0].ux_transfer_request_actual_length == tds[0] -> ux_ehci_td_length + UX_TEST_SHORT_LENGTH);
+    UX_TEST_ASSERT(_ux_host_semaphore_get(&test_transfers[0].ux_transfer_request_semaphore, UX_NO_WAIT) == UX_SUCCESS);
+
+    /* Its TDs are freed, the short packet TD is not.  */
+    for (i = 0; i < transfer_td_count; i ++)
+        UX_TEST_ASSERT(tds[i] -> ux_ehci_td_status == UX_UNUSED);
+    UX_TEST_ASSERT(short_td -> ux_ehci_td_status != UX_UNUSED);
+
+#if defined(UX_HCD_EHCI_TRANSFER_QUEUE_ENABLE)
+
+    /* The queue restarts on the next transfer, which is still pending.  */
+    UX_TEST_ASSERT(test_ed -> ux_ehci_ed_first_td == tds[transfer_td_count]);
+    UX_TEST_ASSERT(test_ed -> ux_ehci_ed_queue_element == _ux_utility_physical_address(tds[transfer_td_count]));
+    UX_TEST_ASSERT(test_ed -> ux_ehci_ed_state == UX_EHCI_QH_TOGGLE);
+    UX_TEST_ASSERT(test_transfers[1].ux_transfer_request_completion_code == UX_TRANSFER_STATUS_PENDING);
+    for (i = transfer_td_count; i < td_count; i ++)
+        UX_TEST_ASSERT(tds[i] -> ux_ehci_td_status != UX_UNUSED);
+
+    /* A short packet in the last TD of the next transfer completes it, the ED is idle.  */
+    for (i = transfer_td_count; i < td_count - 1; i ++)
+        _ux_test_td_complete(tds[i], 0);
+    _ux_test_td_complete(tds[td_count - 1], UX_TEST_SHORT_LENGTH);
+    test_ed -> ux_ehci_ed_queue_element = (UX_EHCI_TD *) UX_EHCI_TD_T;
+    _ux_hcd_ehci_done_queue_process(&test_hcd_ehci);
+    UX_TEST_ASSERT(test_transfers[1].ux_transfer_request_completion_code == UX_SUCCESS);
+    UX_TEST_ASSERT(test_transfers[1].ux_transfer_request_actual_length == UX_TEST_LENGTH - UX_TEST_SHORT_LENGTH);
+    for (i = transfer_td_count; i < td_count; i ++)
+        UX_TEST_ASSERT(tds[i] -> ux_ehci_td_status == UX_UNUSED);
+#endif
+
+    /* The ED is idle.  */
+    UX_TEST_ASSERT(test_ed -> ux_ehci_ed_first_td == UX_NULL);
+    UX_TEST_ASSERT(test_ed -> ux_ehci_ed_last_td == UX_NULL);
+    UX_TEST_ASSERT((ULONG) test_ed -> ux_ehci_ed_queue_element & UX_EHCI_TD_T);
+    UX_TEST_ASSERT(short_td -> ux_ehci_td_status != UX_UNUSED);
+
+    /* The short packet TD is freed when the controller is disabled.  */
+    test_registers[EHCI_HCCR_HCS_PARAMS] = EHCI_HC_STS_HC_HALTED;
+    UX_TEST_ASSERT(_ux_hcd_ehci_controller_disable(&test_hcd_ehci) == UX_SUCCESS);
+    UX_TEST_ASSERT(short_td -> ux_ehci_td_status == UX_UNUSED);
+    UX_TEST_ASSERT(test_hcd_ehci.ux_hcd_ehci_short_td == UX_NULL);
+}
+#endif
+
+
+/* Define what the initial system looks like.  */
+
+#ifdef CTEST
+void test_application_define(void *first_unused_memory)
+#else
+void    usbx_ux_hcd_ehci_bulk_chain_test_application_define(void *first_unused_memory)
+#endif
+{
+
+UINT status;
+CHAR                            *stack_pointer;
+CHAR                            *memory_pointer;
+
+    /* Inform user.  */
+    printf("Running EHCI Bulk Chain Test........................................ ");
+#if !defined(UX_HCD_EHCI_BULK_CHAIN_ENABLE)
+    printf("SKIP SUCCESS!\n");
+    test_control_return(0);
+    return;
+#endif
+
+    /* Initialize the free memory pointer.  */
+    stack_pointer = (CHAR *) first_unused_memory;
+    memory_pointer = stack_pointer + (UX_TEST_STACK_SIZE * 2);
+
+    /* Initialize USBX Memory.  */
+    status =  ux_system_initialize(memory_pointer, UX_TEST_MEMORY_SIZE, UX_NULL, 0);
+
+    /* Check for error.  */
+    if (status != UX_SUCCESS)
+    {
+
+        printf("ERROR #%d\n", __LINE__);
+        test_control_return(1);
+    }
+
+    /* Register the error callback. */
+    _ux_utility_error_callback_register(error_callback);
+
+    /* The code below is required for installing the host portion of USBX.  */
+    status =  ux_host_stack_initialize(UX_NULL);
+
+    /* Check for error.  */
+    if (status != UX_SUCCESS)
+    {
+
+        printf("ERROR #%d\n", __LINE__);
+        test_control_return(1);
+    }
+
+    /* Create the simulation thread.  */
+    status =  tx_thread_create(&ux_test_thread_simulation_0, "test simulation", ux_test_thread_simulation_0_entry, 0,
+            stack_pointer, UX_TEST_STACK_SIZE,
+            20, 20, 1, TX_AUTO_START);
+
+    /* Check for error.  */
+    if (status != TX_SUCCESS)
+    {
+
+        printf("ERROR #%d\n", __LINE__);
+        test_control_return(1);
+    }
+}
+
+static void  ux_test_thread_simulation_0_entry(ULONG arg)
+{
+
+#if defined(UX_HCD_EHCI_BULK_CHAIN_ENABLE)
+
+    /* A short packet stops the queue before the last TD of a transfer.  */
+    _ux_test_short_packet();
+#endif
+
+    /* Sleep for a tick to make sure everything is complete.  */
+    tx_thread_sleep(1);
+
+    /* Check for errors from other threads.  */
+    if (error_counter)
+    {
+
+        /* Test error.  */
+        printf("ERROR #%d: total %ld errors\n", __LINE__, error_counter);
+        test_control_return(1);
+    }
+    else
+    {
+
+        /* Successful test.  */
+        printf("SUCCESS!\n");
+        test_control_return(0);
+    }
+}
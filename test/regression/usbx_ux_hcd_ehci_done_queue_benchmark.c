@@ -0,0 +1,299 @@
+/* This benchmark measures the EHCI completion time of a transfer, from the done
+   queue processing to the transfer completion, with 1 and 30 endpoints on the
+   controller. Without UX_HCD_EHCI_ACTIVE_LIST_ENABLE every interrupt ED and the
+   whole asynchronous list are visited, with it only the EDs with TDs hooked.  */
+
+#include <stdio.h>
+#include <time.h>
+#include "tx_api.h"
+#include "ux_api.h"
+#include "ux_system.h"
+#include "ux_utility.h"
+#include "ux_host_stack.h"
+#include "ux_hcd_ehci.h"
+
+#include "ux_test.h"
+
+
+/* Define USBX test constants.  */
+
+#define UX_TEST_STACK_SIZE      4096
+#define UX_TEST_MEMORY_SIZE     (128*1024)
+
+#define UX_TEST_MAX_ED          128
+#define UX_TEST_ENDPOINTS       30
+#define UX_TEST_LENGTH          64
+#define UX_TEST_BENCH_LOOPS     20000
+
+
+/* Define the counters used in the test application...  */
+
+static ULONG                           error_counter;
+
+static UX_DEVICE                       test_device;
+static UX_ENDPOINT                     test_endpoints[UX_TEST_ENDPOINTS];
+static UX_TRANSFER                     test_transfers[UX_TEST_ENDPOINTS];
+static UCHAR                           test_buffer[UX_TEST_LENGTH];
+static UX_HCD_EHCI                     test_hcd_ehci;
+static ULONG                           test_registers[64];
+
+/* Define prototypes for external Host Controller's (HCDs), classes and clients.  */
+
+static TX_THREAD           ux_test_thread_simulation_0;
+static void                ux_test_thread_simulation_0_entry(ULONG);
+
+
+/* Prototype for test control return.  */
+
+void  test_control_return(UINT status);
+
+
+static VOID error_callback(UINT system_level, UINT system_context, UINT error_code)
+{
+
+    /* Failed test.  */
+    printf("Error #%d, system_level: %d, system_context: %d, error_code: 0x%x\n", __LINE__, system_level, system_context, error_code);
+    error_counter ++;
+}
+
+static VOID _ux_test_ehci_initialize(VOID)
+{
+
+ULONG           i;
+UX_EHCI_ED      *ed;
+UX_EHCI_LINK_POINTER    lp;
+
+    /* Build the free lists, the periodic tree and the asynchronous list of an
+       EHCI controller, as its initialization does. The registers are in memory.  */
+    ux_utility_memory_set(&test_hcd_ehci, 0, sizeof(test_hcd_ehci));
+    ux_utility_memory_set(test_registers, 0, sizeof(test_registers));
+    test_hcd_ehci.ux_hcd_ehci_base = test_registers;
+    test_hcd_ehci.ux_hcd_ehci_frame_list_size = 32;
+    test_hcd_ehci.ux_hcd_ehci_frame_list = _ux_utility_memory_allocate(UX_ALIGN_4096, UX_CACHE_SAFE_MEMORY, sizeof(UX_EHCI_ED *) * 32);
+    UX_TEST_ASSERT(test_hcd_ehci.ux_hcd_ehci_frame_list != UX_NULL);
+    test_hcd_ehci.ux_hcd_ehci_ed_list = _ux_utility_memory_allocate(UX_ALIGN_32, UX_CACHE_SAFE_MEMORY, sizeof(UX_EHCI_ED) * UX_TEST_MAX_ED);
+    UX_TEST_ASSERT(test_hcd_ehci.ux_hcd_ehci_ed_list != UX_NULL);
+    test_hcd_ehci.ux_hcd_ehci_td_list = _ux_utility_memory_allocate(UX_ALIGN_32, UX_CACHE_SAFE_MEMORY, sizeof(UX_EHCI_TD) * _ux_system_host -> ux_system_host_max_td);
+    UX_TEST_ASSERT(test_hcd_ehci.ux_hcd_ehci_td_list != UX_NULL);
+    for (i = UX_TEST_MAX_ED; i > 0; i --)
+    {
+        test_hcd_ehci.ux_hcd_ehci_ed_list[i - 1].REF_AS.FREE.ux_ehci_ed_next_free = test_hcd_ehci.ux_hcd_ehci_ed_free_list;
+        test_hcd_ehci.ux_hcd_ehci_ed_free_list = &test_hcd_ehci.ux_hcd_ehci_ed_list[i - 1];
+    }
+    for (i = _ux_system_host -> ux_system_host_max_td; i > 0; i --)
+    {
+        test_hcd_ehci.ux_hcd_ehci_td_list[i - 1].ux_ehci_td_next_free = test_hcd_ehci.ux_hcd_ehci_td_free_list;
+        test_hcd_ehci.ux_hcd_ehci_td_free_list = &test_hcd_ehci.ux_hcd_ehci_td_list[i - 1];
+    }
+    UX_TEST_ASSERT(_ux_host_mutex_create(&test_hcd_ehci.ux_hcd_ehci_periodic_mutex, "ehci_periodic_mutex") == UX_SUCCESS);
+    UX_TEST_ASSERT(_ux_host_semaphore_create(&test_hcd_ehci.ux_hcd_ehci_protect_semaphore, "ehci_protect_semaphore", 1) == UX_SUCCESS);
+    UX_TEST_ASSERT(_ux_host_semaphore_create(&test_hcd_ehci.ux_hcd_ehci_doorbell_semaphore, "ehci_doorbell_semaphore", 0) == UX_SUCCESS);
+    UX_TEST_ASSERT(_ux_hcd_ehci_periodic_tree_create(&test_hcd_ehci) == UX_SUCCESS);
+
+    /* The head ED of the asynchronous list points to itself.  */
+    ed = _ux_hcd_ehci_ed_obtain(&test_hcd_ehci);
+    UX_TEST_ASSERT(ed != UX_NULL);
+    lp.void_ptr = _ux_utility_physical_address(ed);
+    lp.value |= UX_EHCI_QH_TYP_QH;
+    ed -> ux_ehci_ed_queue_head = lp.ed_ptr;
+    ed -> ux_ehci_ed_cap0 = UX_EHCI_QH_HEAD;
+    test_hcd_ehci.ux_hcd_ehci_asynch_head_list = ed;
+    test_hcd_ehci.ux_hcd_ehci_asynch_first_list = ed;
+    test_hcd_ehci.ux_hcd_ehci_asynch_last_list = ed;
+}
+
+static VOID _ux_test_endpoints_create(ULONG first, ULONG count)
+{
+
+ULONG           i;
+UINT            status;
+
+    /* High speed endpoints, one interrupt endpoint for two bulk endpoints.  */
+    test_device.ux_device_speed = UX_HIGH_SPEED_DEVICE;
+    test_device.ux_device_address = 1;
+    for (i = first; i < first + count; i ++)
+    {
+        test_endpoints[i].ux_endpoint_device = &test_device;
+        test_endpoints[i].ux_endpoint_descriptor.bEndpointAddress = (UCHAR) (0x81 + (i % 15));
+        test_endpoints[i].ux_endpoint_descriptor.wMaxPacketSize = 64;
+        test_endpoints[i].ux_endpoint_descriptor.bInterval = 4;
+        if ((i % 3) == 0)
+        {
+            test_endpoints[i].ux_endpoint_descriptor.bmAttributes = UX_INTERRUPT_ENDPOINT;
+            status = _ux_hcd_ehci_interrupt_endpoint_create(&test_hcd_ehci, &test_endpoints[i]);
+        }
+        else
+        {
+            test_endpoints[i].ux_endpoint_descriptor.bmAttributes = UX_BULK_ENDPOINT;
+            status = _ux_hcd_ehci_asynchronous_endpoint_create(&test_hcd_ehci, &test_endpoints[i]);
+        }
+        UX_TEST_ASSERT(status == UX_SUCCESS);
+        test_transfers[i].ux_transfer_request_endpoint = &test_endpoints[i];
+        test_transfers[i].ux_transfer_request_type = UX_REQUEST_IN;
+        test_transfers[i].ux_transfer_request_data_pointer = test_buffer;
+        test_transfers[i].ux_transfer_request_requested_length = UX_TEST_LENGTH;
+        UX_TEST_ASSERT(_ux_host_semaphore_create(&test_transfers[i].ux_transfer_request_semaphore, "test transfer semaphore", 0) == UX_SUCCESS);
+    }
+}
+
+static VOID _ux_test_transfer_start(ULONG index)
+{
+
+UINT            status;
+
+    /* Hook a transfer of one TD to the endpoint.  */
+    test_transfers[index].ux_transfer_request_completion_code = UX_TRANSFER_STATUS_PENDING;
+    test_transfers[index].ux_transfer_request_actual_length = 0;
+    if ((index % 3) == 0)
+        status = _ux_hcd_ehci_request_interrupt_transfer(&test_hcd_ehci, &test_transfers[index]);
+    else
+        status = _ux_hcd_ehci_request_bulk_transfer(&test_hcd_ehci, &test_transfers[index]);
+    UX_TEST_ASSERT(status == UX_SUCCESS);
+}
+
+static VOID _ux_test_transfer_complete(ULONG index)
+{
+
+UX_EHCI_ED      *ed;
+UX_EHCI_TD      *td;
+
+    /* The controller retires the TD with all the data.  */
+    ed = (UX_EHCI_ED *) test_endpoints[index].ux_endpoint_ed;
+    td = ed -> ux_ehci_ed_first_td;
+    UX_TEST_ASSERT(td != UX_NULL);
+    td -> ux_ehci_td_control &= ~(UX_EHCI_TD_ACTIVE | (UX_EHCI_TD_LG_MASK << UX_EHCI_TD_LG_LOC));
+    ed -> ux_ehci_ed_queue_element = (UX_EHCI_TD *) UX_EHCI_TD_T;
+}
+
+static double _ux_test_completion_ns(ULONG index)
+{
+
+clock_t         start;
+ULONG           i;
+
+    /* Complete transfers on the endpoint, the other endpoints are idle.  */
+    start = clock();
+    for (i = 0; i < UX_TEST_BENCH_LOOPS; i ++)
+    {
+        _ux_test_transfer_start(index);
+        _ux_test_transfer_complete(index);
+        _ux_hcd_ehci_done_queue_process(&test_hcd_ehci);
+        if (test_transfers[index].ux_transfer_request_completion_code != UX_SUCCESS)
+            return(-1.0);
+        _ux_host_semaphore_get(&test_transfers[index].ux_transfer_request_semaphore, UX_NO_WAIT);
+    }
+    return((double)(clock() - start) * 1000000000.0 / CLOCKS_PER_SEC / UX_TEST_BENCH_LOOPS);
+}
+
+static VOID _ux_test_done_queue_benchmark(VOID)
+{
+
+double          bulk_ns[2];
+double          interrupt_ns[2];
+
+    _ux_test_ehci_initialize();
+
+    /* One interrupt and one bulk endpoint.  */
+    _ux_test_endpoints_create(0, 2);
+    interrupt_ns[0] = _ux_test_completion_ns(0);
+    bulk_ns[0] = _ux_test_completion_ns(1);
+
+    /* 30 endpoints, the same two are busy.  */
+    _ux_test_endpoints_create(2, UX_TEST_ENDPOINTS - 2);
+    interrupt_ns[1] = _ux_test_completion_ns(0);
+    bulk_ns[1] = _ux_test_completion_ns(1);
+    UX_TEST_ASSERT(bulk_ns[0] >= 0 && bulk_ns[1] >= 0 && interrupt_ns[0] >= 0 && interrupt_ns[1] >= 0);
+#if defined(UX_HCD_EHCI_ACTIVE_LIST_ENABLE)
+    printf("\nactive list, ");
+#else
+    printf("\nfull scan, ");
+#endif
+    printf("bulk completion %ld/%ld ns, interrupt completion %ld/%ld ns with 1/%d endpoints ... ",
+           (long)bulk_ns[0], (long)bulk_ns[1], (long)interrupt_ns[0], (long)interrupt_ns[1], UX_TEST_ENDPOINTS);
+}
+
+
+/* Define what the initial system looks like.  */
+
+#ifdef CTEST
+void test_application_define(void *first_unused_memory)
+#else
+void    usbx_ux_hcd_ehci_done_queue_benchmark_application_define(void *first_unused_memory)
+#endif
+{
+
+UINT status;
+CHAR                            *stack_pointer;
+CHAR                            *memory_pointer;
+
+    /* Inform user.  */
+    printf("Running EHCI Done Queue Benchmark................................... ");
+
+    /* Initialize the free memory pointer.  */
+    stack_pointer = (CHAR *) first_unused_memory;
+    memory_pointer = stack_pointer + (UX_TEST_STACK_SIZE * 2);
+
+    /* Initialize USBX Memory.  */
+    status =  ux_system_initialize(memory_pointer, UX_TEST_MEMORY_SIZE, UX_NULL, 0);
+
+    /* Check for error.  */
+    if (status != UX_SUCCESS)
+    {
+
+        printf("ERROR #%d\n", __LINE__);
+        test_control_return(1);
+    }
+
+    /* Register the error callback. */
+    _ux_utility_error_callback_register(error_callback);
+
+    /* The code below is required for installing the host portion of USBX.  */
+    status =  ux_host_stack_initialize(UX_NULL);
+
+    /* Check for error.  */
+    if (status != UX_SUCCESS)
+    {
+
+        printf("ERROR #%d\n", __LINE__);
+        test_control_return(1);
+    }
+
+    /* Create the simulation thread.  */
+    status =  tx_thread_create(&ux_test_thread_simulation_0, "test simulation", ux_test_thread_simulation_0_entry, 0,
+            stack_pointer, UX_TEST_STACK_SIZE,
+            20, 20, 1, TX_AUTO_START);
+
+    /* Check for error.  */
+    if (status != TX_SUCCESS)
+    {
+
+        printf("ERROR #%d\n", __LINE__);
+        test_control_return(1);
+    }
+}
+
+static void  ux_test_thread_simulation_0_entry(ULONG arg)
+{
+
+    /* The completion time with idle endpoints on the controller.  */
+    _ux_test_done_queue_benchmark();
+
+    /* Sleep for a tick to make sure everything is complete.  */
+    tx_thread_sleep(1);
+
+    /* Check for errors from other threads.  */
+    if (error_counter)
+    {
+
+        /* Test error.  */
+        printf("ERROR #%d: total %ld errors\n", __LINE__, error_counter);
+        test_control_return(1);
+    }
+    else
+    {
+
+        /* Successful test.  */
+        printf("SUCCESS!\n");
+        test_control_return(0);
+    }
+}
@@ -0,0 +1,331 @@
+/* This test is designed to test the EHCI interrupt threshold: the threshold set is
+   written to the command register, the interrupt rate is measured from the last
+   threshold set, and in adaptive mode the threshold follows the bytes transferred
+   per ms of each window.  */
+
+#include <stdio.h>
+#include "tx_api.h"
+#include "ux_api.h"
+#include "ux_system.h"
+#include "ux_utility.h"
+#include "ux_host_stack.h"
+#include "ux_hcd_ehci.h"
+
+#include "ux_test.h"
+
+
+/* Define USBX test constants.  */
+
+#define UX_TEST_STACK_SIZE      4096
+#define UX_TEST_MEMORY_SIZE     (128*1024)
+
+#define UX_TEST_LENGTH          512
+
+
+/* Define the counters used in the test application...  */
+
+static ULONG                           error_counter;
+
+#if defined(UX_HCD_EHCI_INTERRUPT_THRESHOLD_ENABLE)
+static UX_HCD                          test_hcd;
+static UX_DEVICE                       test_device;
+static UX_ENDPOINT                     test_endpoint;
+static UX_TRANSFER                     test_transfer;
+static UCHAR                           test_buffer[UX_TEST_LENGTH];
+static UX_HCD_EHCI                     test_hcd_ehci;
+static ULONG                           test_registers[64];
+#endif
+
+
+/* Define prototypes for external Host Controller's (HCDs), classes and clients.  */
+
+static TX_THREAD           ux_test_thread_simulation_0;
+static void                ux_test_thread_simulation_0_entry(ULONG);
+
+
+/* Prototype for test control return.  */
+
+void  test_control_return(UINT status);
+
+
+static VOID error_callback(UINT system_level, UINT system_context, UINT error_code)
+{
+
+    /* Failed test.  */
+    printf("Error #%d, system_level: %d, system_context: %d, error_code: 0x%x\n", __LINE__, system_level, system_context, error_code);
+    error_counter ++;
+}
+
+#if defined(UX_HCD_EHCI_INTERRUPT_THRESHOLD_ENABLE)
+static VOID _ux_test_ehci_initialize(VOID)
+{
+
+ULONG           i;
+UX_EHCI_ED      *ed;
+UX_EHCI_LINK_POINTER    lp;
+
+    /* Build the free lists and the asynchronous list of an operational EHCI
+       controller, as its initialization does. The registers are in memory.  */
+    ux_utility_memory_set(&test_hcd, 0, sizeof(test_hcd));
+    ux_utility_memory_set(&test_hcd_ehci, 0, sizeof(test_hcd_ehci));
+    ux_utility_memory_set(test_registers, 0, sizeof(test_registers));
+    test_hcd.ux_hcd_controller_type = UX_EHCI_CONTROLLER;
+    test_hcd.ux_hcd_status = UX_HCD_STATUS_OPERATIONAL;
+    test_hcd.ux_hcd_controller_hardware = &test_hcd_ehci;
+    test_hcd_ehci.ux_hcd_ehci_hcd_owner = &test_hcd;
+    test_hcd_ehci.ux_hcd_ehci_base = test_registers;
+    test_hcd_ehci.ux_hcd_ehci_interrupt_threshold = UX_HCD_EHCI_INTERRUPT_THRESHOLD_DEFAULT;
+    test_hcd_ehci.ux_hcd_ehci_interrupt_threshold_current = UX_HCD_EHCI_INTERRUPT_THRESHOLD_DEFAULT;
+    test_hcd_ehci.ux_hcd_ehci_ed_list = _ux_utility_memory_allocate(UX_ALIGN_32, UX_CACHE_SAFE_MEMORY, sizeof(UX_EHCI_ED) * _ux_system_host -> ux_system_host_max_ed);
+    UX_TEST_ASSERT(test_hcd_ehci.ux_hcd_ehci_ed_list != UX_NULL);
+    test_hcd_ehci.ux_hcd_ehci_td_list = _ux_utility_memory_allocate(UX_ALIGN_32, UX_CACHE_SAFE_MEMORY, sizeof(UX_EHCI_TD) * _ux_system_host -> ux_system_host_max_td);
+    UX_TEST_ASSERT(test_hcd_ehci.ux_hcd_ehci_td_list != UX_NULL);
+    for (i = _ux_system_host -> ux_system_host_max_ed; i > 0; i --)
+    {
+        test_hcd_ehci.ux_hcd_ehci_ed_list[i - 1].REF_AS.FREE.ux_ehci_ed_next_free = test_hcd_ehci.ux_hcd_ehci_ed_free_list;
+        test_hcd_ehci.ux_hcd_ehci_ed_free_list = &test_hcd_ehci.ux_hcd_ehci_ed_list[i - 1];
+    }
+    for (i = _ux_system_host -> ux_system_host_max_td; i > 0; i --)
+    {
+        test_hcd_ehci.ux_hcd_ehci_td_list[i - 1].ux_ehci_td_next_free = test_hcd_ehci.ux_hcd_ehci_td_free_list;
+        test_hcd_ehci.ux_hcd_ehci_td_free_list = &test_hcd_ehci.ux_hcd_ehci_td_list[i - 1];
+    }
+    UX_TEST_ASSERT(_ux_host_mutex_create(&test_hcd_ehci.ux_hcd_ehci_periodic_mutex, "ehci_periodic_mutex") == UX_SUCCESS);
+
+    /* The head ED of the asynchronous list points to itself.  */
+    ed = _ux_hcd_ehci_ed_obtain(&test_hcd_ehci);
+    UX_TEST_ASSERT(ed != UX_NULL);
+    lp.void_ptr = _ux_utility_physical_address(ed);
+    lp.value |= UX_EHCI_QH_TYP_QH;
+    ed -> ux_ehci_ed_queue_head = lp.ed_ptr;
+    ed -> ux_ehci_ed_cap0 = UX_EHCI_QH_HEAD;
+    test_hcd_ehci.ux_hcd_ehci_asynch_head_list = ed;
+    test_hcd_ehci.ux_hcd_ehci_asynch_first_list = ed;
+    test_hcd_ehci.ux_hcd_ehci_asynch_last_list = ed;
+
+    /* A high speed bulk IN endpoint.  */
+    ux_utility_memory_set(&test_device, 0, sizeof(test_device));
+    ux_utility_memory_set(&test_endpoint, 0, sizeof(test_endpoint));
+    ux_utility_memory_set(&test_transfer, 0, sizeof(test_transfer));
+    test_device.ux_device_speed = UX_HIGH_SPEED_DEVICE;
+    test_device.ux_device_address = 1;
+    test_endpoint.ux_endpoint_device = &test_device;
+    test_endpoint.ux_endpoint_descriptor.bEndpointAddress = 0x81;
+    test_endpoint.ux_endpoint_descriptor.bmAttributes = UX_BULK_ENDPOINT;
+    test_endpoint.ux_endpoint_descriptor.wMaxPacketSize = 512;
+    UX_TEST_ASSERT(_ux_hcd_ehci_asynchronous_endpoint_create(&test_hcd_ehci, &test_endpoint) == UX_SUCCESS);
+    test_transfer.ux_transfer_request_endpoint = &test_endpoint;
+    test_transfer.ux_transfer_request_type = UX_REQUEST_IN;
+    test_transfer.ux_transfer_request_data_pointer = test_buffer;
+    test_transfer.ux_transfer_request_requested_length = UX_TEST_LENGTH;
+    UX_TEST_ASSERT(_ux_host_semaphore_create(&test_transfer.ux_transfer_request_semaphore, "test transfer semaphore", 0) == UX_SUCCESS);
+}
+
+static ULONG _ux_test_command_threshold_get(VOID)
+{
+
+    /* Get the interrupt threshold control of the command register.  */
+    return((test_registers[0] & EHCI_HC_IO_ITC_MASK) >> EHCI_HC_IO_ITC_LOC);
+}
+
+static VOID _ux_test_frame_set(ULONG frame_number)
+{
+
+    /* The frame index counts micro-frames.  */
+    test_registers[3] = (frame_number & 0x3ff) << 3;
+}
+
+static VOID _ux_test_window_end(ULONG frame_number, ULONG bytes)
+{
+
+    /* The window transferred the bytes, the done queue is processed on the frame.  */
+    test_hcd_ehci.ux_hcd_ehci_interrupt_threshold_window_bytes = bytes;
+    _ux_test_frame_set(frame_number);
+    _ux_hcd_ehci_interrupt_threshold_adapt(&test_hcd_ehci);
+}
+
+static VOID _ux_test_interrupt_threshold(VOID)
+{
+
+UX_EHCI_ED      *ed;
+UX_EHCI_TD      *td;
+ULONG           threshold;
+ULONG           rate;
+
+    _ux_test_ehci_initialize();
+    ed = (UX_EHCI_ED *) test_endpoint.ux_endpoint_ed;
+
+    /* The threshold is a power of 2 up to 64 micro-frames.  */
+    UX_TEST_ASSERT(ux_hcd_ehci_interrupt_threshold_set(&test_hcd, 3) == UX_INVALID_PARAMETER);
+    UX_TEST_ASSERT(ux_hcd_ehci_interrupt_threshold_set(&test_hcd, 128) == UX_INVALID_PARAMETER);
+
+    /* The threshold set is written to the command register, no rate yet.  */
+    UX_TEST_ASSERT(ux_hcd_ehci_interrupt_threshold_set(&test_hcd, 4) == UX_SUCCESS);
+    UX_TEST_ASSERT(_ux_test_command_threshold_get() == 4);
+    UX_TEST_ASSERT(ux_hcd_ehci_interrupt_threshold_get(&test_hcd, &threshold, &rate) == UX_SUCCESS);
+    UX_TEST_ASSERT(threshold == 4);
+    UX_TEST_ASSERT(rate == 0);
+
+    /* Interrupts before the first MB is transferred give no rate.  */
+    test_hcd_ehci.ux_hcd_ehci_transfer_interrupt_count = 10;
+    test_hcd_ehci.ux_hcd_ehci_transfer_bytes = 1024 * 1024 - UX_TEST_LENGTH / 2;
+    UX_TEST_ASSERT(ux_hcd_ehci_interrupt_threshold_get(&test_hcd, UX_NULL, &rate) == UX_SUCCESS);
+    UX_TEST_ASSERT(rate == 0);
+
+    /* The transfer completing the first MB gives the rate.  */
+    UX_TEST_ASSERT(_ux_hcd_ehci_request_bulk_transfer(&test_hcd_ehci, &test_transfer) == UX_SUCCESS);
+    td = ed -> ux_ehci_ed_first_td;
+    td -> ux_ehci_td_control &= ~(UX_EHCI_TD_ACTIVE | (UX_EHCI_TD_LG_MASK << UX_EHCI_TD_LG_LOC));
+    ed -> ux_ehci_ed_queue_element = (UX_EHCI_TD *) UX_EHCI_TD_T;
+    _ux_hcd_ehci_done_queue_process(&test_hcd_ehci);
+    UX_TEST_ASSERT(test_transfer.ux_transfer_request_completion_code == UX_SUCCESS);
+    UX_TEST_ASSERT(test_hcd_ehci.ux_hcd_ehci_transfer_mbytes == 1);
+    UX_TEST_ASSERT(test_hcd_ehci.ux_hcd_ehci_transfer_bytes == UX_TEST_LENGTH / 2);
+    UX_TEST_ASSERT(ux_hcd_ehci_interrupt_threshold_get(&test_hcd, UX_NULL, &rate) == UX_SUCCESS);
+    UX_TEST_ASSERT(rate == 10);
+
+    /* A new threshold measures the rate again.  */
+    UX_TEST_ASSERT(ux_hcd_ehci_interrupt_threshold_set(&test_hcd, 8) == UX_SUCCESS);
+    UX_TEST_ASSERT(_ux_test_command_threshold_get() == 8);
+    UX_TEST_ASSERT(ux_hcd_ehci_interrupt_threshold_get(&test_hcd, &threshold, &rate) == UX_SUCCESS);
+    UX_TEST_ASSERT(threshold == 8);
+    UX_TEST_ASSERT(rate == 0);
+    UX_TEST_ASSERT(test_hcd_ehci.ux_hcd_ehci_transfer_interrupt_count == 0);
+    UX_TEST_ASSERT(test_hcd_ehci.ux_hcd_ehci_transfer_bytes == 0);
+
+    /* A fixed threshold is not adapted.  */
+    _ux_test_window_end(100, 0);
+    UX_TEST_ASSERT(test_hcd_ehci.ux_hcd_ehci_interrupt_threshold_current == 8);
+
+    /* Adaptive mode starts from the default threshold, with a window from now.  */
+    UX_TEST_ASSERT(ux_hcd_ehci_interrupt_threshold_set(&test_hcd, UX_HCD_EHCI_INTERRUPT_THRESHOLD_ADAPTIVE) == UX_SUCCESS);
+    UX_TEST_ASSERT(_ux_test_command_threshold_get() == UX_HCD_EHCI_INTERRUPT_THRESHOLD_DEFAULT);
+    UX_TEST_ASSERT(test_hcd_ehci.ux_hcd_ehci_interrupt_threshold_window_start == 100);
+
+    /* Nothing changes before the end of the window.  */
+    _ux_test_window_end(100 + UX_HCD_EHCI_INTERRUPT_THRESHOLD_WINDOW - 1, UX_HCD_EHCI_INTERRUPT_THRESHOLD_BULK_BYTES);
+    UX_TEST_ASSERT(test_hcd_ehci.ux_hcd_ehci_interrupt_threshold_current == UX_HCD_EHCI_INTERRUPT_THRESHOLD_DEFAULT);
+    UX_TEST_ASSERT(test_hcd_ehci.ux_hcd_ehci_interrupt_threshold_window_start == 100);
+
+    /* A bulk load over the window raises the threshold.  */
+    _ux_test_window_end(100 + UX_HCD_EHCI_INTERRUPT_THRESHOLD_WINDOW, UX_HCD_EHCI_INTERRUPT_THRESHOLD_BULK_BYTES);
+    UX_TEST_ASSERT(test_hcd_ehci.ux_hcd_ehci_interrupt_threshold_current == UX_HCD_EHCI_INTERRUPT_THRESHOLD_MAX);
+    UX_TEST_ASSERT(_ux_test_command_threshold_get() == UX_HCD_EHCI_INTERRUPT_THRESHOLD_MAX);
+    UX_TEST_ASSERT(test_hcd_ehci.ux_hcd_ehci_interrupt_threshold_window_bytes == 0);
+
+    /* The same bytes over a much longer window are not a bulk load.  */
+    _ux_test_window_end(200 + UX_HCD_EHCI_INTERRUPT_THRESHOLD_WINDOW, UX_HCD_EHCI_INTERRUPT_THRESHOLD_BULK_BYTES);
+    UX_TEST_ASSERT(test_hcd_ehci.ux_hcd_ehci_interrupt_threshold_current == UX_HCD_EHCI_INTERRUPT_THRESHOLD_DEFAULT);
+    UX_TEST_ASSERT(_ux_test_command_threshold_get() == UX_HCD_EHCI_INTERRUPT_THRESHOLD_DEFAULT);
+
+    /* The window may span the frame number wrap.  */
+    test_hcd_ehci.ux_hcd_ehci_interrupt_threshold_window_start = 0x3fc;
+    _ux_test_window_end(0x3fc + UX_HCD_EHCI_INTERRUPT_THRESHOLD_WINDOW, UX_HCD_EHCI_INTERRUPT_THRESHOLD_BULK_BYTES);
+    UX_TEST_ASSERT(test_hcd_ehci.ux_hcd_ehci_interrupt_threshold_current == UX_HCD_EHCI_INTERRUPT_THRESHOLD_MAX);
+
+    /* Isochronous endpoints keep the shortest threshold.  */
+    test_hcd_ehci.ux_hcd_ehci_hsiso_scan_list = (VOID *) ed;
+    _ux_test_window_end(0x3fc + UX_HCD_EHCI_INTERRUPT_THRESHOLD_WINDOW * 2, UX_HCD_EHCI_INTERRUPT_THRESHOLD_BULK_BYTES);
+    UX_TEST_ASSERT(test_hcd_ehci.ux_hcd_ehci_interrupt_threshold_current == 1);
+    test_hcd_ehci.ux_hcd_ehci_hsiso_scan_list = UX_NULL;
+
+    /* The controller must be operational.  */
+    test_hcd.ux_hcd_status = UX_HCD_STATUS_HALTED;
+    UX_TEST_ASSERT(ux_hcd_ehci_interrupt_threshold_set(&test_hcd, 4) == UX_CONTROLLER_UNKNOWN);
+    UX_TEST_ASSERT(ux_hcd_ehci_interrupt_threshold_get(&test_hcd, &threshold, &rate) == UX_CONTROLLER_UNKNOWN);
+}
+#endif
+
+
+/* Define what the initial system looks like.  */
+
+#ifdef CTEST
+void test_application_define(void *first_unused_memory)
+#else
+void    usbx_ux_hcd_ehci_interrupt_threshold_test_application_define(void *first_unused_memory)
+#endif
+{
+
+UINT status;
+CHAR                            *stack_pointer;
+CHAR                            *memory_pointer;
+
+    /* Inform user.  */
+    printf("Running EHCI Interrupt Threshold Test............................... ");
+#if !defined(UX_HCD_EHCI_INTERRUPT_THRESHOLD_ENABLE)
+    printf("SKIP SUCCESS!\n");
+    test_control_return(0);
+    return;
+#endif
+
+    /* Initialize the free memory pointer.  */
+    stack_pointer = (CHAR *) first_unused_memory;
+    memory_pointer = stack_pointer + (UX_TEST_STACK_SIZE * 2);
+
+    /* Initialize USBX Memory.  */
+    status =  ux_system_initialize(memory_pointer, UX_TEST_MEMORY_SIZE, UX_NULL, 0);
+
+    /* Check for error.  */
+    if (status != UX_SUCCESS)
+    {
+
+        printf("ERROR #%d\n", __LINE__);
+        test_control_return(1);
+    }
+
+    /* Register the error callback. */
+    _ux_utility_error_callback_register(error_callback);
+
+    /* The code below is required for installing the host portion of USBX.  */
+    status =  ux_host_stack_initialize(UX_NULL);
+
+    /* Check for error.  */
+    if (status != UX_SUCCESS)
+    {
+
+        printf("ERROR #%d\n", __LINE__);
+        test_control_return(1);
+    }
+
+    /* Create the simulation thread.  */
+    status =  tx_thread_create(&ux_test_thread_simulation_0, "test simulation", ux_test_thread_simulation_0_entry, 0,
+            stack_pointer, UX_TEST_STACK_SIZE,
+            20, 20, 1, TX_AUTO_START);
+
+    /* Check for error.  */
+    if (status != TX_SUCCESS)
+    {
+
+        printf("ERROR #%d\n", __LINE__);
+        test_control_return(1);
+    }
+}
+
+static void  ux_test_thread_simulation_0_entry(ULONG arg)
+{
+
+#if defined(UX_HCD_EHCI_INTERRUPT_THRESHOLD_ENABLE)
+
+    /* The threshold set, the interrupt rate and the adaptive threshold.  */
+    _ux_test_interrupt_threshold();
+#endif
+
+    /* Sleep for a tick to make sure everything is complete.  */
+    tx_thread_sleep(1);
+
+    /* Check for errors from other threads.  */
+    if (error_counter)
+    {
+
+        /* Test error.  */
+        printf("ERROR #%d: total %ld errors\n", __LINE__, error_counter);
+        test_control_return(1);
+    }
+    else
+    {
+
+        /* Successful test.  */
+        printf("SUCCESS!\n");
+        test_control_return(0);
+    }
+}
@@ -0,0 +1,375 @@
+/* This test is designed to test the EHCI transfer queue: several transfers are
+   queued on an ED, and the TDs of an aborted transfer are removed while the other
+   transfers stay queued. The ED must be out of the schedule, and the doorbell
+   rung, before its TDs and overlay are modified.  */
+
+#include <stdio.h>
+#include "tx_api.h"
+#include "ux_api.h"
+#include "ux_system.h"
+#include "ux_utility.h"
+#include "ux_host_stack.h"
+#include "ux_hcd_ehci.h"
+
+#include "ux_test.h"
+
+
+/* Define USBX test constants.  */
+
+#define UX_TEST_STACK_SIZE      4096
+#define UX_TEST_MEMORY_SIZE     (128*1024)
+
+#define UX_TEST_TRANSFERS       3
+
+
+/* Define the counters used in the test application...  */
+
+static ULONG                           error_counter;
+
+#if defined(UX_HCD_EHCI_TRANSFER_QUEUE_ENABLE)
+static UX_DEVICE                       test_device;
+static UX_ENDPOINT                     test_endpoint;
+static UX_TRANSFER                     test_transfers[UX_TEST_TRANSFERS];
+static UCHAR                           test_buffer[UX_TEST_TRANSFERS][64];
+static UX_HCD_EHCI                     test_hcd_ehci;
+static ULONG                           test_registers[64];
+
+/* What the controller sees when the doorbell is rung.  */
+static UX_EHCI_ED                      *test_ed;
+static UX_EHCI_TD                      *test_aborted_td;
+static ULONG                           test_door_bell_count;
+static ULONG                           test_ed_linked;
+static ULONG                           test_td_used;
+static ULONG                           test_done;
+#endif
+
+
+/* Define prototypes for external Host Controller's (HCDs), classes and clients.  */
+
+static TX_THREAD           ux_test_thread_simulation_0;
+static void                ux_test_thread_simulation_0_entry(ULONG);
+#if defined(UX_HCD_EHCI_TRANSFER_QUEUE_ENABLE)
+static TX_THREAD           ux_test_thread_controller;
+static void                ux_test_thread_controller_entry(ULONG);
+#endif
+
+
+/* Prototype for test control return.  */
+
+void  test_control_return(UINT status);
+
+
+static VOID error_callback(UINT system_level, UINT system_context, UINT error_code)
+{
+
+    /* Failed test.  */
+    printf("Error #%d, system_level: %d, system_context: %d, error_code: 0x%x\n", __LINE__, system_level, system_context, error_code);
+    error_counter ++;
+}
+
+#if defined(UX_HCD_EHCI_TRANSFER_QUEUE_ENABLE)
+static VOID _ux_test_ehci_initialize(VOID)
+{
+
+ULONG           i;
+UX_EHCI_ED      *ed;
+UX_EHCI_LINK_POINTER    lp;
+
+    /* Build the free lists, the periodic tree and the asynchronous list of an
+       EHCI controller, as its initialization does. The registers are in memory.  */
+    ux_utility_memory_set(&test_hcd_ehci, 0, sizeof(test_hcd_ehci));
+    ux_utility_memory_set(test_registers, 0, sizeof(test_registers));
+    test_hcd_ehci.ux_hcd_ehci_base = test_registers;
+    test_hcd_ehci.ux_hcd_ehci_frame_list_size = 32;
+    test_hcd_ehci.ux_hcd_ehci_frame_list = _ux_utility_memory_allocate(UX_ALIGN_4096, UX_CACHE_SAFE_MEMORY, sizeof(UX_EHCI_ED *) * 32);
+    UX_TEST_ASSERT(test_hcd_ehci.ux_hcd_ehci_frame_list != UX_NULL);
+    test_hcd_ehci.ux_hcd_ehci_ed_list = _ux_utility_memory_allocate(UX_ALIGN_32, UX_CACHE_SAFE_MEMORY, sizeof(UX_EHCI_ED) * _ux_system_host -> ux_system_host_max_ed);
+    UX_TEST_ASSERT(test_hcd_ehci.ux_hcd_ehci_ed_list != UX_NULL);
+    test_hcd_ehci.ux_hcd_ehci_td_list = _ux_utility_memory_allocate(UX_ALIGN_32, UX_CACHE_SAFE_MEMORY, sizeof(UX_EHCI_TD) * _ux_system_host -> ux_system_host_max_td);
+    UX_TEST_ASSERT(test_hcd_ehci.ux_hcd_ehci_td_list != UX_NULL);
+    for (i = _ux_system_host -> ux_system_host_max_ed; i > 0; i --)
+    {
+        test_hcd_ehci.ux_hcd_ehci_ed_list[i - 1].REF_AS.FREE.ux_ehci_ed_next_free = test_hcd_ehci.ux_hcd_ehci_ed_free_list;
+        test_hcd_ehci.ux_hcd_ehci_ed_free_list = &test_hcd_ehci.ux_hcd_ehci_ed_list[i - 1];
+    }
+    for (i = _ux_system_host -> ux_system_host_max_td; i > 0; i --)
+    {
+        test_hcd_ehci.ux_hcd_ehci_td_list[i - 1].ux_ehci_td_next_free = test_hcd_ehci.ux_hcd_ehci_td_free_list;
+        test_hcd_ehci.ux_hcd_ehci_td_free_list = &test_hcd_ehci.ux_hcd_ehci_td_list[i - 1];
+    }
+    UX_TEST_ASSERT(_ux_host_mutex_create(&test_hcd_ehci.ux_hcd_ehci_periodic_mutex, "ehci_periodic_mutex") == UX_SUCCESS);
+    UX_TEST_ASSERT(_ux_host_semaphore_create(&test_hcd_ehci.ux_hcd_ehci_protect_semaphore, "ehci_protect_semaphore", 1) == UX_SUCCESS);
+    UX_TEST_ASSERT(_ux_host_semaphore_create(&test_hcd_ehci.ux_hcd_ehci_doorbell_semaphore, "ehci_doorbell_semaphore", 0) == UX_SUCCESS);
+    UX_TEST_ASSERT(_ux_hcd_ehci_periodic_tree_create(&test_hcd_ehci) == UX_SUCCESS);
+
+    /* The head ED of the asynchronous list points to itself.  */
+    ed = _ux_hcd_ehci_ed_obtain(&test_hcd_ehci);
+    UX_TEST_ASSERT(ed != UX_NULL);
+    lp.void_ptr = _ux_utility_physical_address(ed);
+    lp.value |= UX_EHCI_QH_TYP_QH;
+    ed -> ux_ehci_ed_queue_head = lp.ed_ptr;
+    ed -> ux_ehci_ed_cap0 = UX_EHCI_QH_HEAD;
+    test_hcd_ehci.ux_hcd_ehci_asynch_head_list = ed;
+    test_hcd_ehci.ux_hcd_ehci_asynch_first_list = ed;
+    test_hcd_ehci.ux_hcd_ehci_asynch_last_list = ed;
+}
+
+static VOID _ux_test_endpoint_create(UCHAR type)
+{
+
+ULONG           i;
+UINT            status;
+
+    /* A high speed endpoint with its transfers.  */
+    ux_utility_memory_set(&test_device, 0, sizeof(test_device));
+    ux_utility_memory_set(&test_endpoint, 0, sizeof(test_endpoint));
+    ux_utility_memory_set(test_transfers, 0, sizeof(test_transfers));
+    test_device.ux_device_speed = UX_HIGH_SPEED_DEVICE;
+    test_device.ux_device_address = 1;
+    test_endpoint.ux_endpoint_device = &test_device;
+    test_endpoint.ux_endpoint_descriptor.bEndpointAddress = 0x81;
+    test_endpoint.ux_endpoint_descriptor.bmAttributes = type;
+    test_endpoint.ux_endpoint_descriptor.wMaxPacketSize = 64;
+    test_endpoint.ux_endpoint_descriptor.bInterval = 4;
+    if (type == UX_INTERRUPT_ENDPOINT)
+        status = _ux_hcd_ehci_interrupt_endpoint_create(&test_hcd_ehci, &test_endpoint);
+    else
+        status = _ux_hcd_ehci_asynchronous_endpoint_create(&test_hcd_ehci, &test_endpoint);
+    UX_TEST_ASSERT(status == UX_SUCCESS);
+    test_ed = (UX_EHCI_ED *) test_endpoint.ux_endpoint_ed;
+
+    /* Queue the transfers, one TD each.  */
+    for (i = 0; i < UX_TEST_TRANSFERS; i ++)
+    {
+        test_transfers[i].ux_transfer_request_endpoint = &test_endpoint;
+        test_transfers[i].ux_transfer_request_type = UX_REQUEST_IN;
+        test_transfers[i].ux_transfer_request_data_pointer = test_buffer[i];
+        test_transfers[i].ux_transfer_request_requested_length = 64;
+        status = _ux_hcd_ehci_request_transfer_queue(&test_hcd_ehci, test_ed, &test_transfers[i]);
+        UX_TEST_ASSERT(status == UX_SUCCESS);
+    }
+}
+
+static UX_EHCI_TD *_ux_test_td_get(ULONG index)
+{
+
+UX_EHCI_TD      *td;
+
+    /* Get the TD of the transfer queued at this index.  */
+    td = test_ed -> ux_ehci_ed_first_td;
+    while (index --)
+        td = _ux_utility_virtual_address(td -> ux_ehci_td_link_pointer);
+    return(td);
+}
+
+static ULONG _ux_test_ed_linked(VOID)
+{
+
+UX_EHCI_LINK_POINTER    lp;
+
+    /* Check if the previous ED points to the ED, for the controller to visit it.  */
+    lp.ed_ptr = test_ed -> ux_ehci_ed_previous_ed -> ux_ehci_ed_queue_head;
+    lp.value &= UX_EHCI_LINK_ADDRESS_MASK;
+    return(lp.void_ptr == _ux_utility_physical_address(test_ed));
+}
+
+static VOID _ux_test_queue_remove(UCHAR type)
+{
+
+UX_EHCI_TD      *td[UX_TEST_TRANSFERS];
+ULONG           i;
+
+    /* The controller executes the second transfer.  */
+    _ux_test_endpoint_create(type);
+    for (i = 0; i < UX_TEST_TRANSFERS; i ++)
+        td[i] = _ux_test_td_get(i);
+    test_ed -> ux_ehci_ed_current_td = _ux_utility_physical_address(td[1]);
+    test_ed -> ux_ehci_ed_queue_element = _ux_utility_physical_address(td[2]);
+    test_ed -> ux_ehci_ed_state = UX_EHCI_QH_TOGGLE | UX_EHCI_TD_ACTIVE;
+    td[0] -> ux_ehci_td_control &= ~UX_EHCI_TD_ACTIVE;
+    UX_TEST_ASSERT(_ux_test_ed_linked());
+
+    /* Abort it: the controller must not see the ED while it is modified.  */
+    test_door_bell_count = 0;
+    test_aborted_td = td[1];
+    _ux_hcd_ehci_ed_queue_remove(&test_hcd_ehci, test_ed, &test_transfers[1]);
+    UX_TEST_ASSERT(test_door_bell_count == 1);
+    UX_TEST_ASSERT(test_ed_linked == UX_FALSE);
+    UX_TEST_ASSERT(test_td_used == UX_TRUE);
+
+    /* The ED is back in the schedule, on the third transfer, with its toggle.  */
+    UX_TEST_ASSERT(_ux_test_ed_linked());
+    UX_TEST_ASSERT(td[1] -> ux_ehci_td_status == UX_UNUSED);
+    UX_TEST_ASSERT(test_ed -> ux_ehci_ed_first_td == td[0]);
+    UX_TEST_ASSERT(td[0] -> ux_ehci_td_link_pointer == _ux_utility_physical_address(td[2]));
+    UX_TEST_ASSERT(test_ed -> ux_ehci_ed_last_td == td[2]);
+    UX_TEST_ASSERT(test_ed -> ux_ehci_ed_queue_element == _ux_utility_physical_address(td[2]));
+    UX_TEST_ASSERT(test_ed -> ux_ehci_ed_state == UX_EHCI_QH_TOGGLE);
+
+    /* Abort the last transfer, the overlay is not on it.  */
+    test_ed -> ux_ehci_ed_current_td = _ux_utility_physical_address(td[0]);
+    test_ed -> ux_ehci_ed_queue_element = _ux_utility_physical_address(td[2]);
+    test_ed -> ux_ehci_ed_state = UX_EHCI_TD_ACTIVE;
+    test_aborted_td = td[2];
+    _ux_hcd_ehci_ed_queue_remove(&test_hcd_ehci, test_ed, &test_transfers[2]);
+    UX_TEST_ASSERT(test_door_bell_count == 2);
+    UX_TEST_ASSERT(test_ed_linked == UX_FALSE);
+    UX_TEST_ASSERT(test_td_used == UX_TRUE);
+    UX_TEST_ASSERT(_ux_test_ed_linked());
+    UX_TEST_ASSERT(td[2] -> ux_ehci_td_status == UX_UNUSED);
+    UX_TEST_ASSERT(test_ed -> ux_ehci_ed_last_td == td[0]);
+    UX_TEST_ASSERT((ULONG) td[0] -> ux_ehci_td_link_pointer & UX_EHCI_TD_T);
+    UX_TEST_ASSERT((ULONG) test_ed -> ux_ehci_ed_queue_element & UX_EHCI_TD_T);
+    UX_TEST_ASSERT(test_ed -> ux_ehci_ed_state == UX_EHCI_TD_ACTIVE);
+
+    /* A transfer not queued does not take the ED off the schedule.  */
+    _ux_hcd_ehci_ed_queue_remove(&test_hcd_ehci, test_ed, &test_transfers[1]);
+    UX_TEST_ASSERT(test_door_bell_count == 2);
+    UX_TEST_ASSERT(_ux_test_ed_linked());
+}
+#endif
+
+
+/* Define what the initial system looks like.  */
+
+#ifdef CTEST
+void test_application_define(void *first_unused_memory)
+#else
+void    usbx_ux_hcd_ehci_transfer_queue_test_application_define(void *first_unused_memory)
+#endif
+{
+
+UINT status;
+CHAR                            *stack_pointer;
+CHAR                            *memory_pointer;
+
+    /* Inform user.  */
+    printf("Running EHCI Transfer Queue Test.................................... ");
+#if !defined(UX_HCD_EHCI_TRANSFER_QUEUE_ENABLE)
+    printf("SKIP SUCCESS!\n");
+    test_control_return(0);
+    return;
+#endif
+
+    /* Initialize the free memory pointer.  */
+    stack_pointer = (CHAR *) first_unused_memory;
+    memory_pointer = stack_pointer + (UX_TEST_STACK_SIZE * 2);
+
+    /* Initialize USBX Memory.  */
+    status =  ux_system_initialize(memory_pointer, UX_TEST_MEMORY_SIZE, UX_NULL, 0);
+
+    /* Check for error.  */
+    if (status != UX_SUCCESS)
+    {
+
+        printf("ERROR #%d\n", __LINE__);
+        test_control_return(1);
+    }
+
+    /* Register the error callback. */
+    _ux_utility_error_callback_register(error_callback);
+
+    /* The code below is required for installing the host portion of USBX.  */
+    status =  ux_host_stack_initialize(UX_NULL);
+
+    /* Check for error.  */
+    if (status != UX_SUCCESS)
+    {
+
+        printf("ERROR #%d\n", __LINE__);
+        test_control_return(1);
+    }
+
+    /* Create the simulation thread.  */
+    status =  tx_thread_create(&ux_test_thread_simulation_0, "test simulation", ux_test_thread_simulation_0_entry, 0,
+            stack_pointer, UX_TEST_STACK_SIZE,
+            20, 20, 1, TX_AUTO_START);
+
+    /* Check for error.  */
+    if (status != TX_SUCCESS)
+    {
+
+        printf("ERROR #%d\n", __LINE__);
+        test_control_return(1);
+    }
+
+#if defined(UX_HCD_EHCI_TRANSFER_QUEUE_ENABLE)
+
+    /* Create the thread that plays the controller.  */
+    status =  tx_thread_create(&ux_test_thread_controller, "test controller", ux_test_thread_controller_entry, 0,
+            stack_pointer + UX_TEST_STACK_SIZE, UX_TEST_STACK_SIZE,
+            20, 20, 1, TX_AUTO_START);
+
+    /* Check for error.  */
+    if (status != TX_SUCCESS)
+    {
+
+        printf("ERROR #%d\n", __LINE__);
+        test_control_return(1);
+    }
+#endif
+}
+
+#if defined(UX_HCD_EHCI_TRANSFER_QUEUE_ENABLE)
+static void  ux_test_thread_controller_entry(ULONG arg)
+{
+
+UX_HCD_EHCI     *hcd_ehci = &test_hcd_ehci;
+ULONG           ehci_register;
+
+    while (test_done == UX_FALSE)
+    {
+
+        /* Wait for the doorbell.  */
+        ehci_register = _ux_hcd_ehci_register_read(hcd_ehci, EHCI_HCOR_USB_COMMAND);
+        if ((ehci_register & EHCI_HC_IO_IAAD) == 0)
+        {
+            tx_thread_sleep(1);
+            continue;
+        }
+
+        /* Remember what the controller sees, then acknowledge the doorbell.  */
+        test_ed_linked = _ux_test_ed_linked();
+        test_td_used = (test_aborted_td -> ux_ehci_td_status != UX_UNUSED);
+        test_door_bell_count ++;
+        _ux_hcd_ehci_register_write(hcd_ehci, EHCI_HCOR_USB_COMMAND, ehci_register & ~EHCI_HC_IO_IAAD);
+        _ux_host_semaphore_put(&test_hcd_ehci.ux_hcd_ehci_doorbell_semaphore);
+    }
+}
+#endif
+
+static void  ux_test_thread_simulation_0_entry(ULONG arg)
+{
+
+#if defined(UX_HCD_EHCI_TRANSFER_QUEUE_ENABLE)
+
+    /* Bulk transfers queued on an ED of the asynchronous list.  */
+    _ux_test_ehci_initialize();
+    _ux_test_queue_remove(UX_BULK_ENDPOINT);
+
+    /* Interrupt transfers queued on an ED of the periodic list.  */
+    _ux_test_ehci_initialize();
+    _ux_test_queue_remove(UX_INTERRUPT_ENDPOINT);
+
+    test_done = UX_TRUE;
+#endif
+
+    /* Sleep for a tick to make sure everything is complete.  */
+    tx_thread_sleep(1);
+
+    /* Check for errors from other threads.  */
+    if (error_counter)
+    {
+
+        /* Test error.  */
+        printf("ERROR #%d: total %ld errors\n", __LINE__, error_counter);
+        test_control_return(1);
+    }
+    else
+    {
+
+        /* Successful test.  */
+        printf("SUCCESS!\n");
+        test_control_return(0);
+    }
+}
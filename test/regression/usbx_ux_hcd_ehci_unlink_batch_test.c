@@ -0,0 +1,402 @@
+/* This test is designed to test the EHCI batched unlink: asynchronous EDs
+   destroyed while a doorbell is rung are freed together on the next Interrupt
+   on Async Advance, a doorbell wait joins the same cycle, and a halted
+   controller frees the EDs still waiting for a doorbell.  */
+
+#include <stdio.h>
+#include "tx_api.h"
+#include "ux_api.h"
+#include "ux_system.h"
+#include "ux_utility.h"
+#include "ux_host_stack.h"
+#include "ux_hcd_ehci.h"
+
+#include "ux_test.h"
+
+
+/* Define USBX test constants.  */
+
+#define UX_TEST_STACK_SIZE      4096
+#define UX_TEST_MEMORY_SIZE     (128*1024)
+
+#define UX_TEST_MAX_ED          128
+#define UX_TEST_ENDPOINTS       12
+
+
+/* Define the counters used in the test application...  */
+
+static ULONG                           error_counter;
+
+#if defined(UX_HCD_EHCI_UNLINK_BATCH_ENABLE)
+static UX_HCD                          test_hcd;
+static UX_DEVICE                       test_device;
+static UX_ENDPOINT                     test_endpoints[UX_TEST_ENDPOINTS];
+static UX_HCD_EHCI                     test_hcd_ehci;
+static ULONG                           test_registers[64];
+static ULONG                           test_controller_enabled;
+static ULONG                           test_door_bell_count;
+static ULONG                           test_done;
+#endif
+
+
+/* Define prototypes for external Host Controller's (HCDs), classes and clients.  */
+
+static TX_THREAD           ux_test_thread_simulation_0;
+static void                ux_test_thread_simulation_0_entry(ULONG);
+#if defined(UX_HCD_EHCI_UNLINK_BATCH_ENABLE)
+static TX_THREAD           ux_test_thread_controller;
+static void                ux_test_thread_controller_entry(ULONG);
+#endif
+
+
+/* Prototype for test control return.  */
+
+void  test_control_return(UINT status);
+
+
+static VOID error_callback(UINT system_level, UINT system_context, UINT error_code)
+{
+
+    /* Failed test.  */
+    printf("Error #%d, system_level: %d, system_context: %d, error_code: 0x%x\n", __LINE__, system_level, system_context, error_code);
+    error_counter ++;
+}
+
+#if defined(UX_HCD_EHCI_UNLINK_BATCH_ENABLE)
+static VOID _ux_test_ehci_initialize(VOID)
+{
+
+ULONG           i;
+UX_EHCI_ED      *ed;
+UX_EHCI_LINK_POINTER    lp;
+
+    /* Build the free lists, the periodic tree and the asynchronous list of an
+       EHCI controller, as its initialization does. The registers are in memory.  */
+    ux_utility_memory_set(&test_hcd, 0, sizeof(test_hcd));
+    ux_utility_memory_set(&test_hcd_ehci, 0, sizeof(test_hcd_ehci));
+    ux_utility_memory_set(test_registers, 0, sizeof(test_registers));
+    test_hcd.ux_hcd_controller_type = UX_EHCI_CONTROLLER;
+    test_hcd.ux_hcd_status = UX_HCD_STATUS_OPERATIONAL;
+    test_hcd.ux_hcd_controller_hardware = &test_hcd_ehci;
+    test_hcd_ehci.ux_hcd_ehci_hcd_owner = &test_hcd;
+    test_hcd_ehci.ux_hcd_ehci_base = test_registers;
+    test_hcd_ehci.ux_hcd_ehci_frame_list_size = 32;
+    test_hcd_ehci.ux_hcd_ehci_frame_list = _ux_utility_memory_allocate(UX_ALIGN_4096, UX_CACHE_SAFE_MEMORY, sizeof(UX_EHCI_ED *) * 32);
+    UX_TEST_ASSERT(test_hcd_ehci.ux_hcd_ehci_frame_list != UX_NULL);
+    test_hcd_ehci.ux_hcd_ehci_ed_list = _ux_utility_memory_allocate(UX_ALIGN_32, UX_CACHE_SAFE_MEMORY, sizeof(UX_EHCI_ED) * UX_TEST_MAX_ED);
+    UX_TEST_ASSERT(test_hcd_ehci.ux_hcd_ehci_ed_list != UX_NULL);
+    test_hcd_ehci.ux_hcd_ehci_td_list = _ux_utility_memory_allocate(UX_ALIGN_32, UX_CACHE_SAFE_MEMORY, sizeof(UX_EHCI_TD) * _ux_system_host -> ux_system_host_max_td);
+    UX_TEST_ASSERT(test_hcd_ehci.ux_hcd_ehci_td_list != UX_NULL);
+    for (i = UX_TEST_MAX_ED; i > 0; i --)
+    {
+        test_hcd_ehci.ux_hcd_ehci_ed_list[i - 1].REF_AS.FREE.ux_ehci_ed_next_free = test_hcd_ehci.ux_hcd_ehci_ed_free_list;
+        test_hcd_ehci.ux_hcd_ehci_ed_free_list = &test_hcd_ehci.ux_hcd_ehci_ed_list[i - 1];
+    }
+    for (i = _ux_system_host -> ux_system_host_max_td; i > 0; i --)
+    {
+        test_hcd_ehci.ux_hcd_ehci_td_list[i - 1].ux_ehci_td_next_free = test_hcd_ehci.ux_hcd_ehci_td_free_list;
+        test_hcd_ehci.ux_hcd_ehci_td_free_list = &test_hcd_ehci.ux_hcd_ehci_td_list[i - 1];
+    }
+    UX_TEST_ASSERT(_ux_host_mutex_create(&test_hcd_ehci.ux_hcd_ehci_periodic_mutex, "ehci_periodic_mutex") == UX_SUCCESS);
+    UX_TEST_ASSERT(_ux_host_semaphore_create(&test_hcd_ehci.ux_hcd_ehci_protect_semaphore, "ehci_protect_semaphore", 1) == UX_SUCCESS);
+    UX_TEST_ASSERT(_ux_host_semaphore_create(&test_hcd_ehci.ux_hcd_ehci_doorbell_semaphore, "ehci_doorbell_semaphore", 0) == UX_SUCCESS);
+    UX_TEST_ASSERT(_ux_hcd_ehci_periodic_tree_create(&test_hcd_ehci) == UX_SUCCESS);
+
+    /* The head ED of the asynchronous list points to itself.  */
+    ed = _ux_hcd_ehci_ed_obtain(&test_hcd_ehci);
+    UX_TEST_ASSERT(ed != UX_NULL);
+    lp.void_ptr = _ux_utility_physical_address(ed);
+    lp.value |= UX_EHCI_QH_TYP_QH;
+    ed -> ux_ehci_ed_queue_head = lp.ed_ptr;
+    ed -> ux_ehci_ed_cap0 = UX_EHCI_QH_HEAD;
+    test_hcd_ehci.ux_hcd_ehci_asynch_head_list = ed;
+    test_hcd_ehci.ux_hcd_ehci_asynch_first_list = ed;
+    test_hcd_ehci.ux_hcd_ehci_asynch_last_list = ed;
+}
+
+static VOID _ux_test_endpoints_create(VOID)
+{
+
+ULONG           i;
+UINT            status;
+
+    /* High speed endpoints, one interrupt endpoint for two bulk endpoints.  */
+    ux_utility_memory_set(&test_device, 0, sizeof(test_device));
+    ux_utility_memory_set(test_endpoints, 0, sizeof(test_endpoints));
+    test_device.ux_device_speed = UX_HIGH_SPEED_DEVICE;
+    test_device.ux_device_address = 1;
+    for (i = 0; i < UX_TEST_ENDPOINTS; i ++)
+    {
+        test_endpoints[i].ux_endpoint_device = &test_device;
+        test_endpoints[i].ux_endpoint_descriptor.bEndpointAddress = (UCHAR) (0x81 + (i % 15));
+        test_endpoints[i].ux_endpoint_descriptor.wMaxPacketSize = 64;
+        test_endpoints[i].ux_endpoint_descriptor.bInterval = 4;
+        if ((i % 3) == 0)
+        {
+            test_endpoints[i].ux_endpoint_descriptor.bmAttributes = UX_INTERRUPT_ENDPOINT;
+            status = _ux_hcd_ehci_interrupt_endpoint_create(&test_hcd_ehci, &test_endpoints[i]);
+        }
+        else
+        {
+            test_endpoints[i].ux_endpoint_descriptor.bmAttributes = UX_BULK_ENDPOINT;
+            status = _ux_hcd_ehci_asynchronous_endpoint_create(&test_hcd_ehci, &test_endpoints[i]);
+        }
+        UX_TEST_ASSERT(status == UX_SUCCESS);
+    }
+}
+
+static ULONG _ux_test_free_ed_count(VOID)
+{
+
+UX_EHCI_ED      *ed;
+ULONG           count;
+
+    /* Count the EDs on the free list.  */
+    count = 0;
+    ed = test_hcd_ehci.ux_hcd_ehci_ed_free_list;
+    while (ed != UX_NULL)
+    {
+        count ++;
+        ed = ed -> REF_AS.FREE.ux_ehci_ed_next_free;
+    }
+    return(count);
+}
+
+static ULONG _ux_test_door_bell_rung(VOID)
+{
+
+ULONG           rung;
+
+    /* Check the doorbell and acknowledge it, as the controller does.  */
+    rung = (test_registers[0] & EHCI_HC_IO_IAAD) ? UX_TRUE : UX_FALSE;
+    test_registers[0] &= ~EHCI_HC_IO_IAAD;
+    return(rung);
+}
+
+static UX_EHCI_ED *_ux_test_endpoint_destroy(ULONG index)
+{
+
+UX_EHCI_ED      *ed;
+
+    /* Destroy a bulk endpoint, return its ED.  */
+    ed = (UX_EHCI_ED *) test_endpoints[index].ux_endpoint_ed;
+    UX_TEST_ASSERT(_ux_hcd_ehci_asynchronous_endpoint_destroy(&test_hcd_ehci, &test_endpoints[index]) == UX_SUCCESS);
+    return(ed);
+}
+
+static VOID _ux_test_unlink_batch(VOID)
+{
+
+UX_EHCI_ED      *eds[UX_TEST_ENDPOINTS];
+ULONG           free_count;
+
+    /* Endpoints 0, 3, 6 and 9 are interrupt endpoints, the others are bulk.  */
+    _ux_test_ehci_initialize();
+    _ux_test_endpoints_create();
+    free_count = _ux_test_free_ed_count();
+
+    /* The first bulk endpoint destroyed rings the doorbell, its ED is kept
+       until the Interrupt on Async Advance.  */
+    eds[1] = _ux_test_endpoint_destroy(1);
+    UX_TEST_ASSERT(_ux_test_door_bell_rung() == UX_TRUE);
+    UX_TEST_ASSERT(eds[1] -> ux_ehci_ed_status != UX_UNUSED);
+    UX_TEST_ASSERT(test_hcd_ehci.ux_hcd_ehci_unlink_retire_list == eds[1]);
+
+    /* The next ones wait for the next doorbell, no doorbell is rung for them.  */
+    eds[2] = _ux_test_endpoint_destroy(2);
+    eds[4] = _ux_test_endpoint_destroy(4);
+    eds[5] = _ux_test_endpoint_destroy(5);
+    UX_TEST_ASSERT(_ux_test_door_bell_rung() == UX_FALSE);
+    UX_TEST_ASSERT(_ux_test_free_ed_count() == free_count);
+
+    /* The Interrupt on Async Advance frees the first ED and rings the doorbell
+       once for the others.  */
+    _ux_hcd_ehci_door_bell_process(&test_hcd_ehci);
+    UX_TEST_ASSERT(eds[1] -> ux_ehci_ed_status == UX_UNUSED);
+    UX_TEST_ASSERT(eds[2] -> ux_ehci_ed_status != UX_UNUSED);
+    UX_TEST_ASSERT(_ux_test_free_ed_count() == free_count + 1);
+    UX_TEST_ASSERT(_ux_test_door_bell_rung() == UX_TRUE);
+    UX_TEST_ASSERT(test_hcd_ehci.ux_hcd_ehci_unlink_ed_list == UX_NULL);
+
+    /* The next one frees them all, the doorbell is idle.  */
+    _ux_hcd_ehci_door_bell_process(&test_hcd_ehci);
+    UX_TEST_ASSERT(eds[2] -> ux_ehci_ed_status == UX_UNUSED);
+    UX_TEST_ASSERT(eds[4] -> ux_ehci_ed_status == UX_UNUSED);
+    UX_TEST_ASSERT(eds[5] -> ux_ehci_ed_status == UX_UNUSED);
+    UX_TEST_ASSERT(_ux_test_free_ed_count() == free_count + 4);
+    UX_TEST_ASSERT(_ux_test_door_bell_rung() == UX_FALSE);
+    UX_TEST_ASSERT(test_hcd_ehci.ux_hcd_ehci_unlink_retire_list == UX_NULL);
+    UX_TEST_ASSERT(test_hcd_ehci.ux_hcd_ehci_door_bell_state == 0);
+
+    /* A doorbell wait posted while a doorbell is rung is resumed on the next
+       one, which also retires the EDs unlinked in between.  */
+    free_count = _ux_test_free_ed_count();
+    eds[7] = _ux_test_endpoint_destroy(7);
+    test_door_bell_count = 0;
+    test_controller_enabled = UX_TRUE;
+    UX_TEST_ASSERT(_ux_hcd_ehci_interrupt_endpoint_destroy(&test_hcd_ehci, &test_endpoints[3]) == UX_SUCCESS);
+    test_controller_enabled = UX_FALSE;
+    UX_TEST_ASSERT(test_door_bell_count == 2);
+    UX_TEST_ASSERT(eds[7] -> ux_ehci_ed_status == UX_UNUSED);
+    UX_TEST_ASSERT(_ux_test_free_ed_count() == free_count + 2);
+    UX_TEST_ASSERT(test_hcd_ehci.ux_hcd_ehci_door_bell_state == 0);
+
+    /* The controller halts with an ED retired by the doorbell, one waiting
+       for the next doorbell and a doorbell wait posted. No Interrupt on Async
+       Advance will come: the EDs are freed and the wait is resumed.  */
+    free_count = _ux_test_free_ed_count();
+    eds[8] = _ux_test_endpoint_destroy(8);
+    eds[10] = _ux_test_endpoint_destroy(10);
+    UX_TEST_ASSERT(_ux_test_door_bell_rung() == UX_TRUE);
+    test_hcd_ehci.ux_hcd_ehci_door_bell_state |= UX_EHCI_DOOR_BELL_WAIT_PENDING;
+    test_registers[EHCI_HCCR_HCS_PARAMS] = EHCI_HC_STS_HC_HALTED;
+    UX_TEST_ASSERT(_ux_hcd_ehci_controller_disable(&test_hcd_ehci) == UX_SUCCESS);
+    UX_TEST_ASSERT(eds[8] -> ux_ehci_ed_status == UX_UNUSED);
+    UX_TEST_ASSERT(eds[10] -> ux_ehci_ed_status == UX_UNUSED);
+    UX_TEST_ASSERT(_ux_test_free_ed_count() == free_count + 2);
+    UX_TEST_ASSERT(test_hcd_ehci.ux_hcd_ehci_unlink_retire_list == UX_NULL);
+    UX_TEST_ASSERT(test_hcd_ehci.ux_hcd_ehci_unlink_ed_list == UX_NULL);
+    UX_TEST_ASSERT(test_hcd_ehci.ux_hcd_ehci_door_bell_state == 0);
+    UX_TEST_ASSERT(_ux_host_semaphore_get(&test_hcd_ehci.ux_hcd_ehci_doorbell_semaphore, UX_NO_WAIT) == UX_SUCCESS);
+
+    /* An endpoint destroyed after the halt is freed at once.  */
+    free_count = _ux_test_free_ed_count();
+    eds[11] = _ux_test_endpoint_destroy(11);
+    UX_TEST_ASSERT(_ux_test_door_bell_rung() == UX_FALSE);
+    UX_TEST_ASSERT(eds[11] -> ux_ehci_ed_status == UX_UNUSED);
+    UX_TEST_ASSERT(_ux_test_free_ed_count() == free_count + 1);
+    UX_TEST_ASSERT(test_hcd_ehci.ux_hcd_ehci_unlink_ed_list == UX_NULL);
+}
+#endif
+
+
+/* Define what the initial system looks like.  */
+
+#ifdef CTEST
+void test_application_define(void *first_unused_memory)
+#else
+void    usbx_ux_hcd_ehci_unlink_batch_test_application_define(void *first_unused_memory)
+#endif
+{
+
+UINT status;
+CHAR                            *stack_pointer;
+CHAR                            *memory_pointer;
+
+    /* Inform user.  */
+    printf("Running EHCI Unlink Batch Test...................................... ");
+#if !defined(UX_HCD_EHCI_UNLINK_BATCH_ENABLE)
+    printf("SKIP SUCCESS!\n");
+    test_control_return(0);
+    return;
+#endif
+
+    /* Initialize the free memory pointer.  */
+    stack_pointer = (CHAR *) first_unused_memory;
+    memory_pointer = stack_pointer + (UX_TEST_STACK_SIZE * 2);
+
+    /* Initialize USBX Memory.  */
+    status =  ux_system_initialize(memory_pointer, UX_TEST_MEMORY_SIZE, UX_NULL, 0);
+
+    /* Check for error.  */
+    if (status != UX_SUCCESS)
+    {
+
+        printf("ERROR #%d\n", __LINE__);
+        test_control_return(1);
+    }
+
+    /* Register the error callback. */
+    _ux_utility_error_callback_register(error_callback);
+
+    /* The code below is required for installing the host portion of USBX.  */
+    status =  ux_host_stack_initialize(UX_NULL);
+
+    /* Check for error.  */
+    if (status != UX_SUCCESS)
+    {
+
+        printf("ERROR #%d\n", __LINE__);
+        test_control_return(1);
+    }
+
+    /* Create the simulation thread.  */
+    status =  tx_thread_create(&ux_test_thread_simulation_0, "test simulation", ux_test_thread_simulation_0_entry, 0,
+            stack_pointer, UX_TEST_STACK_SIZE,
+            20, 20, 1, TX_AUTO_START);
+
+    /* Check for error.  */
+    if (status != TX_SUCCESS)
+    {
+
+        printf("ERROR #%d\n", __LINE__);
+        test_control_return(1);
+    }
+
+#if defined(UX_HCD_EHCI_UNLINK_BATCH_ENABLE)
+
+    /* Create the thread that plays the controller.  */
+    status =  tx_thread_create(&ux_test_thread_controller, "test controller", ux_test_thread_controller_entry, 0,
+            stack_pointer + UX_TEST_STACK_SIZE, UX_TEST_STACK_SIZE,
+            20, 20, 1, TX_AUTO_START);
+
+    /* Check for error.  */
+    if (status != TX_SUCCESS)
+    {
+
+        printf("ERROR #%d\n", __LINE__);
+        test_control_return(1);
+    }
+#endif
+}
+
+static void  ux_test_thread_simulation_0_entry(ULONG arg)
+{
+
+#if defined(UX_HCD_EHCI_UNLINK_BATCH_ENABLE)
+
+    /* Unlinked EDs are freed together behind one doorbell.  */
+    _ux_test_unlink_batch();
+    test_done = UX_TRUE;
+#endif
+
+    /* Sleep for a tick to make sure everything is complete.  */
+    tx_thread_sleep(1);
+
+    /* Check for errors from other threads.  */
+    if (error_counter)
+    {
+
+        /* Test error.  */
+        printf("ERROR #%d: total %ld errors\n", __LINE__, error_counter);
+        test_control_return(1);
+    }
+    else
+    {
+
+        /* Successful test.  */
+        printf("SUCCESS!\n");
+        test_control_return(0);
+    }
+}
+
+#if defined(UX_HCD_EHCI_UNLINK_BATCH_ENABLE)
+static void  ux_test_thread_controller_entry(ULONG arg)
+{
+
+    while (test_done == UX_FALSE)
+    {
+
+        /* Wait for the doorbell.  */
+        if ((test_controller_enabled == UX_FALSE) || (_ux_test_door_bell_rung() == UX_FALSE))
+        {
+            tx_thread_sleep(1);
+            continue;
+        }
+
+        /* Issue the Interrupt on Async Advance.  */
+        test_door_bell_count ++;
+        _ux_hcd_ehci_door_bell_process(&test_hcd_ehci);
+    }
+}
+#endif
@@ -0,0 +1,342 @@
+/* This test is designed to test the class match index: the class found for
+   a query is indexed so the same query does not call the classes again, if
+   the classes called have their match index enabled.  */
+
+#include <stdio.h>
+#include "tx_api.h"
+#include "ux_api.h"
+#include "ux_system.h"
+#include "ux_utility.h"
+#include "ux_host_stack.h"
+
+#include "ux_test.h"
+
+
+/* Define USBX test constants.  */
+
+#define UX_TEST_STACK_SIZE      4096
+#define UX_TEST_MEMORY_SIZE     (64*1024)
+
+/* Classes that never match, registered before the class that matches.  */
+#define UX_TEST_MISS_CLASSES    ((UX_MAX_CLASS_DRIVER - 1) < 15 ? (UX_MAX_CLASS_DRIVER - 1) : 15)
+
+
+/* Define the counters used in the test application...  */
+
+static ULONG                           error_counter;
+
+#if defined(UX_HOST_CLASS_MATCH_INDEX_ENABLE)
+static ULONG                           test_class_miss_count;
+static ULONG                           test_class_match_count;
+#endif
+
+
+/* Define prototypes for external Host Controller's (HCDs), classes and clients.  */
+
+static TX_THREAD           ux_test_thread_simulation_0;
+static void                ux_test_thread_simulation_0_entry(ULONG);
+
+
+/* Prototype for test control return.  */
+
+void  test_control_return(UINT status);
+
+
+static VOID error_callback(UINT system_level, UINT system_context, UINT error_code)
+{
+
+    /* Failed test.  */
+    printf("Error #%d, system_level: %d, system_context: %d, error_code: 0x%x\n", __LINE__, system_level, system_context, error_code);
+    error_counter ++;
+}
+
+#if defined(UX_HOST_CLASS_MATCH_INDEX_ENABLE)
+static UINT test_class_miss(UX_HOST_CLASS_COMMAND *command)
+{
+
+    /* This class never owns anything.  */
+    if (command -> ux_host_class_command_request == UX_HOST_CLASS_COMMAND_QUERY)
+    {
+        test_class_miss_count ++;
+        return(UX_NO_CLASS_MATCH);
+    }
+    return(UX_SUCCESS);
+}
+
+/* Each class must have its own entry function.  */
+#define UX_TEST_CLASS_MISS_ENTRY(n) \
+static UINT test_class_miss_entry_##n(UX_HOST_CLASS_COMMAND *command) { return(test_class_miss(command)); }
+UX_TEST_CLASS_MISS_ENTRY(0)
+UX_TEST_CLASS_MISS_ENTRY(1)
+UX_TEST_CLASS_MISS_ENTRY(2)
+UX_TEST_CLASS_MISS_ENTRY(3)
+UX_TEST_CLASS_MISS_ENTRY(4)
+UX_TEST_CLASS_MISS_ENTRY(5)
+UX_TEST_CLASS_MISS_ENTRY(6)
+UX_TEST_CLASS_MISS_ENTRY(7)
+UX_TEST_CLASS_MISS_ENTRY(8)
+UX_TEST_CLASS_MISS_ENTRY(9)
+UX_TEST_CLASS_MISS_ENTRY(10)
+UX_TEST_CLASS_MISS_ENTRY(11)
+UX_TEST_CLASS_MISS_ENTRY(12)
+UX_TEST_CLASS_MISS_ENTRY(13)
+UX_TEST_CLASS_MISS_ENTRY(14)
+
+static UINT (*test_class_miss_entries[15])(UX_HOST_CLASS_COMMAND *) =
+{
+    test_class_miss_entry_0,  test_class_miss_entry_1,  test_class_miss_entry_2,
+    test_class_miss_entry_3,  test_class_miss_entry_4,  test_class_miss_entry_5,
+    test_class_miss_entry_6,  test_class_miss_entry_7,  test_class_miss_entry_8,
+    test_class_miss_entry_9,  test_class_miss_entry_10, test_class_miss_entry_11,
+    test_class_miss_entry_12, test_class_miss_entry_13, test_class_miss_entry_14,
+};
+
+static UINT test_class_match_entry(UX_HOST_CLASS_COMMAND *command)
+{
+
+    /* This class owns vendor 0x1234 devices and 0xFF/0x01 interfaces.  */
+    if (command -> ux_host_class_command_request == UX_HOST_CLASS_COMMAND_QUERY)
+    {
+        test_class_match_count ++;
+        if ((command -> ux_host_class_command_usage == UX_HOST_CLASS_COMMAND_USAGE_PIDVID) &&
+            (command -> ux_host_class_command_vid == 0x1234))
+            return(UX_SUCCESS);
+        if ((command -> ux_host_class_command_usage == UX_HOST_CLASS_COMMAND_USAGE_CSP) &&
+            (command -> ux_host_class_command_class == 0xFF) &&
+            (command -> ux_host_class_command_subclass == 0x01))
+            return(UX_SUCCESS);
+        return(UX_NO_CLASS_MATCH);
+    }
+    return(UX_SUCCESS);
+}
+
+static VOID test_class_command_set(UX_HOST_CLASS_COMMAND *command, UINT usage,
+                                   UINT class_code, UINT subclass, UINT protocol, UINT iad_class)
+{
+
+    _ux_utility_memory_set(command, 0, sizeof(UX_HOST_CLASS_COMMAND));
+    command -> ux_host_class_command_request = UX_HOST_CLASS_COMMAND_QUERY;
+    command -> ux_host_class_command_usage = usage;
+    command -> ux_host_class_command_class = class_code;
+    command -> ux_host_class_command_subclass = subclass;
+    command -> ux_host_class_command_protocol = protocol;
+    command -> ux_host_class_command_iad_class = iad_class;
+}
+
+static VOID test_class_counters_reset(VOID)
+{
+
+    test_class_miss_count = 0;
+    test_class_match_count = 0;
+}
+#endif
+
+
+/* Define what the initial system looks like.  */
+
+#ifdef CTEST
+void test_application_define(void *first_unused_memory)
+#else
+void    usbx_ux_host_stack_class_match_index_test_application_define(void *first_unused_memory)
+#endif
+{
+
+UINT status;
+CHAR                            *stack_pointer;
+CHAR                            *memory_pointer;
+
+    /* Inform user.  */
+    printf("Running Class Match Index Test...................................... ");
+#if !defined(UX_HOST_CLASS_MATCH_INDEX_ENABLE)
+    printf("SKIP SUCCESS!\n");
+    test_control_return(0);
+    return;
+#endif
+
+    /* Initialize the free memory pointer.  */
+    stack_pointer = (CHAR *) first_unused_memory;
+    memory_pointer = stack_pointer + (UX_TEST_STACK_SIZE * 2);
+
+    /* Initialize USBX Memory.  */
+    status =  ux_system_initialize(memory_pointer, UX_TEST_MEMORY_SIZE, UX_NULL, 0);
+
+    /* Check for error.  */
+    if (status != UX_SUCCESS)
+    {
+
+        printf("ERROR #%d\n", __LINE__);
+        test_control_return(1);
+    }
+
+    /* Register the error callback. */
+    _ux_utility_error_callback_register(error_callback);
+
+    /* The code below is required for installing the host portion of USBX.  */
+    status =  ux_host_stack_initialize(UX_NULL);
+
+    /* Check for error.  */
+    if (status != UX_SUCCESS)
+    {
+
+        printf("ERROR #%d\n", __LINE__);
+        test_control_return(1);
+    }
+
+    /* Create the simulation thread.  */
+    status =  tx_thread_create(&ux_test_thread_simulation_0, "test simulation", ux_test_thread_simulation_0_entry, 0,
+            stack_pointer, UX_TEST_STACK_SIZE,
+            20, 20, 1, TX_AUTO_START);
+
+    /* Check for error.  */
+    if (status != TX_SUCCESS)
+    {
+
+        printf("ERROR #%d\n", __LINE__);
+        test_control_return(1);
+    }
+}
+
+static void  ux_test_thread_simulation_0_entry(ULONG arg)
+{
+#if defined(UX_HOST_CLASS_MATCH_INDEX_ENABLE)
+UX_HOST_CLASS_COMMAND   command;
+UX_HOST_CLASS           *class_inst;
+UX_HOST_CLASS           *match_class;
+ULONG                   i;
+UINT                    status;
+
+
+    /* Fill the class table, the class that matches is the last one.  */
+    for (i = 0; i < UX_TEST_MISS_CLASSES; i ++)
+    {
+        status =  ux_host_stack_class_register(_ux_system_host_class_hub_name, test_class_miss_entries[i]);
+        UX_TEST_ASSERT(status == UX_SUCCESS);
+        status =  ux_host_stack_class_match_index_enable(test_class_miss_entries[i]);
+        UX_TEST_ASSERT(status == UX_SUCCESS);
+    }
+    status =  ux_host_stack_class_register(_ux_system_host_class_hub_name, test_class_match_entry);
+    UX_TEST_ASSERT(status == UX_SUCCESS);
+    status =  ux_host_stack_class_match_index_enable(test_class_match_entry);
+    UX_TEST_ASSERT(status == UX_SUCCESS);
+    match_class = &_ux_system_host -> ux_system_host_class_array[UX_TEST_MISS_CLASSES];
+
+    /* First interface query calls all the classes.  */
+    test_class_command_set(&command, UX_HOST_CLASS_COMMAND_USAGE_CSP, 0xFF, 0x01, 0x02, 0);
+    class_inst = _ux_host_stack_class_call(&command);
+    UX_TEST_ASSERT(class_inst == match_class);
+    UX_TEST_ASSERT(test_class_miss_count == UX_TEST_MISS_CLASSES);
+    UX_TEST_ASSERT(test_class_match_count == 1);
+
+    /* Same interface found again, no class is called.  */
+    test_class_counters_reset();
+    class_inst = _ux_host_stack_class_call(&command);
+    UX_TEST_ASSERT(class_inst == match_class);
+    UX_TEST_ASSERT(test_class_miss_count == 0);
+    UX_TEST_ASSERT(test_class_match_count == 0);
+
+    /* Device query by vendor/product is indexed too.  */
+    test_class_command_set(&command, UX_HOST_CLASS_COMMAND_USAGE_PIDVID, 0, 0, 0, 0);
+    command.ux_host_class_command_vid = 0x1234;
+    command.ux_host_class_command_pid = 0x5678;
+    class_inst = _ux_host_stack_class_call(&command);
+    UX_TEST_ASSERT(class_inst == match_class);
+    UX_TEST_ASSERT(test_class_match_count == 1);
+    class_inst = _ux_host_stack_class_call(&command);
+    UX_TEST_ASSERT(class_inst == match_class);
+    UX_TEST_ASSERT(test_class_match_count == 1);
+
+    /* Query without owner is indexed as well.  */
+    test_class_counters_reset();
+    test_class_command_set(&command, UX_HOST_CLASS_COMMAND_USAGE_CSP, 0x08, 0x06, 0x50, 0);
+    class_inst = _ux_host_stack_class_call(&command);
+    UX_TEST_ASSERT(class_inst == UX_NULL);
+    UX_TEST_ASSERT(test_class_miss_count == UX_TEST_MISS_CLASSES);
+    UX_TEST_ASSERT(test_class_match_count == 1);
+    test_class_counters_reset();
+    class_inst = _ux_host_stack_class_call(&command);
+    UX_TEST_ASSERT(class_inst == UX_NULL);
+    UX_TEST_ASSERT(test_class_miss_count == 0);
+    UX_TEST_ASSERT(test_class_match_count == 0);
+
+    /* Interface in an IAD is a different query.  */
+    test_class_command_set(&command, UX_HOST_CLASS_COMMAND_USAGE_CSP, 0xFF, 0x01, 0x02, 0xEF);
+    class_inst = _ux_host_stack_class_call(&command);
+    UX_TEST_ASSERT(class_inst == match_class);
+    UX_TEST_ASSERT(test_class_match_count == 1);
+
+    /* Unregister clears the index.  */
+    test_class_counters_reset();
+    status =  ux_host_stack_class_unregister(test_class_match_entry);
+    UX_TEST_ASSERT(status == UX_SUCCESS);
+    test_class_command_set(&command, UX_HOST_CLASS_COMMAND_USAGE_CSP, 0xFF, 0x01, 0x02, 0);
+    class_inst = _ux_host_stack_class_call(&command);
+    UX_TEST_ASSERT(class_inst == UX_NULL);
+    UX_TEST_ASSERT(test_class_miss_count == UX_TEST_MISS_CLASSES);
+    UX_TEST_ASSERT(test_class_match_count == 0);
+
+    /* Unregistered class can not be enabled.  */
+    status =  ux_host_stack_class_match_index_enable(test_class_match_entry);
+    UX_TEST_ASSERT(status == UX_NO_CLASS_MATCH);
+
+    /* Register clears the index, queries answered by a class not enabled are not indexed.  */
+    test_class_counters_reset();
+    status =  ux_host_stack_class_register(_ux_system_host_class_hub_name, test_class_match_entry);
+    UX_TEST_ASSERT(status == UX_SUCCESS);
+    class_inst = _ux_host_stack_class_call(&command);
+    UX_TEST_ASSERT(class_inst == match_class);
+    UX_TEST_ASSERT(test_class_match_count == 1);
+    class_inst = _ux_host_stack_class_call(&command);
+    UX_TEST_ASSERT(class_inst == match_class);
+    UX_TEST_ASSERT(test_class_miss_count == UX_TEST_MISS_CLASSES * 2);
+    UX_TEST_ASSERT(test_class_match_count == 2);
+
+    /* Queries without owner are not indexed either.  */
+    test_class_counters_reset();
+    test_class_command_set(&command, UX_HOST_CLASS_COMMAND_USAGE_CSP, 0x08, 0x06, 0x50, 0);
+    class_inst = _ux_host_stack_class_call(&command);
+    UX_TEST_ASSERT(class_inst == UX_NULL);
+    class_inst = _ux_host_stack_class_call(&command);
+    UX_TEST_ASSERT(class_inst == UX_NULL);
+    UX_TEST_ASSERT(test_class_match_count == 2);
+
+    /* Enabled class queries are indexed again.  */
+    status =  ux_host_stack_class_match_index_enable(test_class_match_entry);
+    UX_TEST_ASSERT(status == UX_SUCCESS);
+    test_class_counters_reset();
+    test_class_command_set(&command, UX_HOST_CLASS_COMMAND_USAGE_CSP, 0xFF, 0x01, 0x02, 0);
+    class_inst = _ux_host_stack_class_call(&command);
+    UX_TEST_ASSERT(class_inst == match_class);
+    class_inst = _ux_host_stack_class_call(&command);
+    UX_TEST_ASSERT(class_inst == match_class);
+    UX_TEST_ASSERT(test_class_miss_count == UX_TEST_MISS_CLASSES);
+    UX_TEST_ASSERT(test_class_match_count == 1);
+
+    /* Free the class table.  */
+    status =  ux_host_stack_class_unregister(test_class_match_entry);
+    UX_TEST_ASSERT(status == UX_SUCCESS);
+    for (i = 0; i < UX_TEST_MISS_CLASSES; i ++)
+    {
+        status =  ux_host_stack_class_unregister(test_class_miss_entries[i]);
+        UX_TEST_ASSERT(status == UX_SUCCESS);
+    }
+#endif
+
+    /* Sleep for a tick to make sure everything is complete.  */
+    tx_thread_sleep(1);
+
+    /* Check for errors from other threads.  */
+    if (error_counter)
+    {
+
+        /* Test error.  */
+        printf("ERROR #%d: total %ld errors\n", __LINE__, error_counter);
+        test_control_return(1);
+    }
+    else
+    {
+
+        /* Successful test.  */
+        printf("SUCCESS!\n");
+        test_control_return(0);
+    }
+}
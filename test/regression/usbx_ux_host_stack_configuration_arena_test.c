@@ -0,0 +1,245 @@
+/* This test is designed to test the host configuration arena: interface and endpoint
+   containers of a configuration come from one block and are released at once.  */
+
+#include <stdio.h>
+#include <string.h>
+#include "tx_api.h"
+#include "ux_api.h"
+#include "ux_system.h"
+#include "ux_utility.h"
+#include "ux_host_stack.h"
+
+#include "ux_test.h"
+
+
+/* Define USBX test constants.  */
+
+#define UX_TEST_STACK_SIZE      4096
+#define UX_TEST_MEMORY_SIZE     (64*1024)
+
+
+/* Define the counters used in the test application...  */
+
+static ULONG                           error_counter;
+
+
+/* Configuration with two interfaces (one with alternate setting) and four endpoints.  */
+
+static UCHAR configuration_descriptor[] = {
+
+    /* Configuration descriptor */
+    0x09, 0x02,
+    0x40, 0x00, /* wTotalLength */
+    0x02, 0x01, /* bNumInterfaces, bConfigurationValue */
+    0x00,
+    0xc0, 0x32, /* bmAttributes, bMaxPower */
+
+    /* Interface descriptor */
+    0x09, 0x04,
+    0x00, 0x00, 0x02, /* bInterfaceNumber, bAlternateSetting, bNumEndpoints */
+    0x99, 0x99, 0x99, /* bInterfaceClass, bInterfaceSubClass, bInterfaceProtocol */
+    0x00,
+
+    /* Endpoint descriptor (Bulk Out) */
+    0x07, 0x05, 0x01, 0x02, 0x40, 0x00, 0x00,
+
+    /* Endpoint descriptor (Bulk In) */
+    0x07, 0x05, 0x82, 0x02, 0x40, 0x00, 0x00,
+
+    /* Interface descriptor */
+    0x09, 0x04,
+    0x01, 0x00, 0x00, /* bInterfaceNumber, bAlternateSetting, bNumEndpoints */
+    0x99, 0x99, 0x99, /* bInterfaceClass, bInterfaceSubClass, bInterfaceProtocol */
+    0x00,
+
+    /* Interface descriptor, alternate setting */
+    0x09, 0x04,
+    0x01, 0x01, 0x02, /* bInterfaceNumber, bAlternateSetting, bNumEndpoints */
+    0x99, 0x99, 0x99, /* bInterfaceClass, bInterfaceSubClass, bInterfaceProtocol */
+    0x00,
+
+    /* Endpoint descriptor (Interrupt Out) */
+    0x07, 0x05, 0x03, 0x03, 0x08, 0x00, 0x01,
+
+    /* Endpoint descriptor (Interrupt In) */
+    0x07, 0x05, 0x84, 0x03, 0x08, 0x00, 0x01,
+};
+#define UX_TEST_ARENA_INTERFACES    3
+#define UX_TEST_ARENA_ENDPOINTS     4
+
+
+/* Define prototypes for external Host Controller's (HCDs), classes and clients.  */
+
+static TX_THREAD           ux_test_thread_simulation_0;
+static void                ux_test_thread_simulation_0_entry(ULONG);
+
+
+/* Prototype for test control return.  */
+
+void  test_control_return(UINT status);
+
+
+/* Define what the initial system looks like.  */
+
+#ifdef CTEST
+void test_application_define(void *first_unused_memory)
+#else
+void    usbx_ux_host_stack_configuration_arena_test_application_define(void *first_unused_memory)
+#endif
+{
+
+UINT status;
+CHAR                            *stack_pointer;
+CHAR                            *memory_pointer;
+
+    /* Inform user.  */
+#if !defined(UX_HOST_DEVICE_ARENA_ENABLE)
+    printf("Running ux_host_stack_configuration_arena Test..................SKIP SUCCESS!\n");
+    test_control_return(0);
+    return;
+#endif
+
+    printf("Running ux_host_stack_configuration_arena Test...................... ");
+
+    /* Initialize the free memory pointer.  */
+    stack_pointer = (CHAR *) first_unused_memory;
+    memory_pointer = stack_pointer + (UX_TEST_STACK_SIZE * 2);
+
+    /* Initialize USBX Memory.  */
+    status =  ux_system_initialize(memory_pointer, UX_TEST_MEMORY_SIZE, UX_NULL, 0);
+
+    /* Check for error.  */
+    if (status != UX_SUCCESS)
+    {
+
+        printf("ERROR #%d\n", __LINE__);
+        test_control_return(1);
+    }
+
+    /* Create the simulation thread.  */
+    status =  tx_thread_create(&ux_test_thread_simulation_0, "test simulation", ux_test_thread_simulation_0_entry, 0,
+            stack_pointer, UX_TEST_STACK_SIZE,
+            20, 20, 1, TX_AUTO_START);
+
+    /* Check for error.  */
+    if (status != TX_SUCCESS)
+    {
+
+        printf("ERROR #%d\n", __LINE__);
+        test_control_return(1);
+    }
+}
+
+
+static void  ux_test_thread_simulation_0_entry(ULONG arg)
+{
+#if defined(UX_HOST_DEVICE_ARENA_ENABLE)
+UX_MEMORY_BYTE_POOL     *pool_ptr = _ux_system -> ux_system_memory_byte_pool[UX_MEMORY_BYTE_POOL_REGULAR];
+UX_DEVICE               device;
+UX_CONFIGURATION        configuration;
+UX_INTERFACE            *interface_ptr;
+UX_ENDPOINT             *endpoint;
+UCHAR                   *arena;
+UCHAR                   *arena_end;
+UCHAR                   *memory;
+ULONG                   available;
+ULONG                   arena_size;
+ULONG                   count;
+UINT                    status;
+
+
+    _ux_utility_memory_set(&device, 0, sizeof(device));
+    _ux_utility_memory_set(&configuration, 0, sizeof(configuration));
+    configuration.ux_configuration_device = &device;
+    _ux_utility_descriptor_parse(configuration_descriptor,
+                    _ux_system_configuration_descriptor_structure,
+                    UX_CONFIGURATION_DESCRIPTOR_ENTRIES,
+                    (UCHAR *) &configuration.ux_configuration_descriptor);
+    UX_TEST_ASSERT(configuration.ux_configuration_descriptor.wTotalLength == sizeof(configuration_descriptor));
+    available = pool_ptr -> ux_byte_pool_available;
+
+    /* No arena, containers are allocated from pool.  */
+    memory = _ux_host_stack_configuration_arena_allocate(&configuration, sizeof(UX_ENDPOINT));
+    UX_TEST_ASSERT(memory != UX_NULL);
+    UX_TEST_ASSERT(pool_ptr -> ux_byte_pool_available < available);
+    _ux_host_stack_configuration_arena_free(&configuration, memory);
+    UX_TEST_ASSERT(pool_ptr -> ux_byte_pool_available == available);
+
+    /* Scan interfaces, arena is sized by descriptors.  */
+    status = _ux_host_stack_interfaces_scan(&configuration, configuration_descriptor);
+    UX_TEST_ASSERT(status == UX_SUCCESS);
+    arena = configuration.ux_configuration_arena;
+    arena_size = UX_TEST_ARENA_INTERFACES * UX_HOST_STACK_ARENA_ROUND(sizeof(UX_INTERFACE)) +
+                 UX_TEST_ARENA_ENDPOINTS * UX_HOST_STACK_ARENA_ROUND(sizeof(UX_ENDPOINT));
+    UX_TEST_ASSERT(arena != UX_NULL);
+    UX_TEST_ASSERT(configuration.ux_configuration_arena_size == arena_size);
+    UX_TEST_ASSERT(configuration.ux_configuration_arena_used == arena_size);
+    arena_end = arena + arena_size;
+
+    /* All containers are in arena.  */
+    count = 0;
+    interface_ptr = configuration.ux_configuration_first_interface;
+    while(interface_ptr)
+    {
+        UX_TEST_ASSERT((UCHAR *)interface_ptr >= arena && (UCHAR *)interface_ptr < arena_end);
+        UX_TEST_ASSERT(((ALIGN_TYPE)interface_ptr & UX_ALIGN_MIN) == 0);
+        UX_TEST_ASSERT(interface_ptr -> ux_interface_configuration == &configuration);
+        endpoint = interface_ptr -> ux_interface_first_endpoint;
+        while(endpoint)
+        {
+            UX_TEST_ASSERT((UCHAR *)endpoint >= arena && (UCHAR *)endpoint < arena_end);
+            UX_TEST_ASSERT(((ALIGN_TYPE)endpoint & UX_ALIGN_MIN) == 0);
+            UX_TEST_ASSERT(endpoint -> ux_endpoint_device == &device);
+            endpoint = endpoint -> ux_endpoint_next_endpoint;
+            count ++;
+        }
+        interface_ptr = interface_ptr -> ux_interface_next_interface;
+    }
+    UX_TEST_ASSERT(count == UX_TEST_ARENA_ENDPOINTS);
+
+    /* Arena containers are not freed one by one.  */
+    available = pool_ptr -> ux_byte_pool_available;
+    _ux_host_stack_configuration_arena_free(&configuration, configuration.ux_configuration_first_interface);
+    UX_TEST_ASSERT(pool_ptr -> ux_byte_pool_available == available);
+
+    /* Arena is full, next container is allocated from pool.  */
+    memory = _ux_host_stack_configuration_arena_allocate(&configuration, sizeof(UX_ENDPOINT));
+    UX_TEST_ASSERT(memory != UX_NULL);
+    UX_TEST_ASSERT(memory < arena || memory >= arena_end);
+    _ux_host_stack_configuration_arena_free(&configuration, memory);
+    UX_TEST_ASSERT(pool_ptr -> ux_byte_pool_available == available);
+
+    /* Arena is created once.  */
+    _ux_host_stack_configuration_arena_create(&configuration, configuration_descriptor);
+    UX_TEST_ASSERT(configuration.ux_configuration_arena == arena);
+
+    /* Release all at once.  */
+    _ux_utility_memory_free(arena);
+    UX_TEST_ASSERT(pool_ptr -> ux_byte_pool_available > available);
+
+    /* Corrupted descriptor, arena is not created and error is reported by scan.  */
+    _ux_utility_memory_set(&configuration, 0, sizeof(configuration));
+    configuration.ux_configuration_device = &device;
+    configuration.ux_configuration_descriptor.wTotalLength = 2;
+    _ux_host_stack_configuration_arena_create(&configuration, configuration_descriptor + 9);
+    UX_TEST_ASSERT(configuration.ux_configuration_arena == UX_NULL);
+#endif
+
+    /* Check for errors.  */
+    if (error_counter)
+    {
+
+        /* Test error.  */
+        printf("ERROR #%d: total %ld errors\n", __LINE__, error_counter);
+        test_control_return(1);
+    }
+    else
+    {
+
+        /* Successful test.  */
+        printf("SUCCESS!\n");
+        test_control_return(0);
+    }
+
+    return;
+}
@@ -0,0 +1,399 @@
+/* This test is designed to test the descriptor cache: configurations of a
+   known device are not read again when the device is enumerated again.  */
+
+#include <stdio.h>
+#include "tx_api.h"
+#include "ux_api.h"
+#include "ux_system.h"
+#include "ux_utility.h"
+#include "ux_host_stack.h"
+
+#include "ux_test.h"
+
+
+/* Define USBX test constants.  */
+
+#define UX_TEST_STACK_SIZE      4096
+#define UX_TEST_MEMORY_SIZE     (128*1024)
+
+#define UX_TEST_VENDOR_ID       0x08EC
+#define UX_TEST_PRODUCT_ID      0x0010
+#define UX_TEST_OTHER_PRODUCT   0x0100
+
+
+/* Define the counters used in the test application...  */
+
+static ULONG                           error_counter;
+
+#if defined(UX_HOST_DESCRIPTOR_CACHE_ENABLE) && !defined(UX_HOST_STANDALONE)
+
+/* Fake device framework.  */
+
+static UCHAR test_device_descriptor[] = {
+    0x12, 0x01, 0x10, 0x01, 0x00, 0x00, 0x00, 0x40,
+    0xec, 0x08, 0x10, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x01,
+};
+
+static UCHAR test_configuration_descriptor[] = {
+    0x09, 0x02, 0x20, 0x00, 0x01, 0x01, 0x00, 0xc0,
+    0x32,
+    0x09, 0x04, 0x00, 0x00, 0x02, 0x99, 0x99, 0x99,
+    0x00,
+    0x07, 0x05, 0x81, 0x02, 0x40, 0x00, 0x00,
+    0x07, 0x05, 0x02, 0x02, 0x40, 0x00, 0x00,
+};
+
+/* Fake root hub port and request statistics.  */
+
+static ULONG                           test_port_connected;
+
+static ULONG                           test_config_header_count;
+static ULONG                           test_config_full_count;
+static ULONG                           test_cache_callback_count;
+
+static ULONG                           test_connection_count;
+static ULONG                           test_disconnection_count;
+#endif
+
+
+/* Define prototypes for external Host Controller's (HCDs), classes and clients.  */
+
+static TX_THREAD           ux_test_thread_simulation_0;
+static void                ux_test_thread_simulation_0_entry(ULONG);
+
+
+/* Prototype for test control return.  */
+
+void  test_control_return(UINT status);
+
+
+static VOID error_callback(UINT system_level, UINT system_context, UINT error_code)
+{
+
+    /* No class is registered, device enumerations end with no class found.  */
+    if (error_code == UX_NO_CLASS_MATCH || error_code == UX_DEVICE_ENUMERATION_FAILURE)
+        return;
+
+    /* Failed test.  */
+    printf("Error #%d, system_level: %d, system_context: %d, error_code: 0x%x\n", __LINE__, system_level, system_context, error_code);
+    error_counter ++;
+}
+
+#if defined(UX_HOST_DESCRIPTOR_CACHE_ENABLE) && !defined(UX_HOST_STANDALONE)
+static UINT test_change_function(ULONG event, UX_HOST_CLASS *host_class, VOID *instance)
+{
+
+    UX_PARAMETER_NOT_USED(host_class);
+    UX_PARAMETER_NOT_USED(instance);
+
+    if (event == UX_DEVICE_CONNECTION)
+        test_connection_count ++;
+    if (event == UX_DEVICE_DISCONNECTION)
+        test_disconnection_count ++;
+    return(UX_SUCCESS);
+}
+
+static VOID test_cache_callback(UX_DEVICE *device, UINT configuration_index, UCHAR *descriptor, ULONG length)
+{
+
+    /* Configuration read from the device is given to the application.  */
+    UX_TEST_ASSERT(device -> ux_device_descriptor.idVendor == UX_TEST_VENDOR_ID);
+    UX_TEST_ASSERT(device -> ux_device_descriptor.idProduct == UX_TEST_PRODUCT_ID);
+    UX_TEST_ASSERT(configuration_index == 0);
+    UX_TEST_ASSERT(length == sizeof(test_configuration_descriptor));
+    UX_TEST_ASSERT(_ux_utility_memory_compare(descriptor, test_configuration_descriptor, length) == UX_SUCCESS);
+    test_cache_callback_count ++;
+}
+
+static VOID test_control_transfer(UX_TRANSFER *transfer_request)
+{
+UCHAR           *descriptor = UX_NULL;
+ULONG           length = 0;
+
+    if (transfer_request -> ux_transfer_request_function == UX_GET_DESCRIPTOR)
+    {
+        if ((transfer_request -> ux_transfer_request_value >> 8) == UX_DEVICE_DESCRIPTOR_ITEM)
+        {
+            descriptor = test_device_descriptor;
+            length = sizeof(test_device_descriptor);
+        }
+        else if ((transfer_request -> ux_transfer_request_value >> 8) == UX_CONFIGURATION_DESCRIPTOR_ITEM)
+        {
+            descriptor = test_configuration_descriptor;
+            length = sizeof(test_configuration_descriptor);
+
+            /* Count the header and the whole configuration requests.  */
+            if (transfer_request -> ux_transfer_request_requested_length == UX_CONFIGURATION_DESCRIPTOR_LENGTH)
+                test_config_header_count ++;
+            else
+                test_config_full_count ++;
+        }
+        if (length > transfer_request -> ux_transfer_request_requested_length)
+            length = transfer_request -> ux_transfer_request_requested_length;
+        if (descriptor)
+            _ux_utility_memory_copy(transfer_request -> ux_transfer_request_data_pointer, descriptor, length);
+    }
+
+    /* What the HCD does when the transfer is done.  */
+    transfer_request -> ux_transfer_request_actual_length = length;
+    transfer_request -> ux_transfer_request_completion_code = UX_SUCCESS;
+    _ux_host_semaphore_put(&transfer_request -> ux_transfer_request_semaphore);
+}
+
+static UINT test_hcd_entry(UX_HCD *hcd, UINT function, VOID *parameter)
+{
+
+    UX_PARAMETER_NOT_USED(hcd);
+
+    switch(function)
+    {
+
+    case UX_HCD_GET_PORT_STATUS:
+        if (test_port_connected)
+            return(UX_PS_CCS | UX_PS_DS_FS);
+        return(0);
+
+    case UX_HCD_TRANSFER_REQUEST:
+        test_control_transfer((UX_TRANSFER *)parameter);
+        return(UX_SUCCESS);
+
+    default:
+        return(UX_SUCCESS);
+    }
+}
+
+static UINT test_hcd_initialize(UX_HCD *hcd)
+{
+
+    /* Initialize the function collector for this HCD.  */
+    hcd -> ux_hcd_entry_function =  test_hcd_entry;
+
+    /* Set the host controller into the operational state.  */
+    hcd -> ux_hcd_status =  UX_HCD_STATUS_OPERATIONAL;
+
+    /* One root hub port is used.  */
+    hcd -> ux_hcd_nb_root_hubs =  1;
+
+    /* Return successful completion.  */
+    return(UX_SUCCESS);
+}
+
+static ULONG test_wait(ULONG *counter, ULONG value)
+{
+ULONG           i;
+
+    for (i = 0; i < 500 && *counter < value; i ++)
+        tx_thread_sleep(UX_MS_TO_TICK_NON_ZERO(10));
+    return(*counter);
+}
+
+static VOID test_device_plug(VOID)
+{
+UX_HCD          *hcd = &_ux_system_host -> ux_system_host_hcd_array[0];
+
+    /* Connect the device and wait for its enumeration.  */
+    test_port_connected = 1;
+    hcd -> ux_hcd_root_hub_signal[0] ++;
+    _ux_host_semaphore_put(&_ux_system_host -> ux_system_host_enum_semaphore);
+    UX_TEST_ASSERT(test_wait(&test_connection_count, 1) == 1);
+
+    /* Disconnect the device and wait for its removal.  */
+    test_port_connected = 0;
+    hcd -> ux_hcd_root_hub_signal[0] ++;
+    _ux_host_semaphore_put(&_ux_system_host -> ux_system_host_enum_semaphore);
+    UX_TEST_ASSERT(test_wait(&test_disconnection_count, 1) == 1);
+
+    test_connection_count = 0;
+    test_disconnection_count = 0;
+}
+
+static UX_HOST_DESCRIPTOR_CACHE *test_cache_find(ULONG product_id)
+{
+UX_HOST_DESCRIPTOR_CACHE    *entry = _ux_system_host -> ux_system_host_descriptor_cache;
+ULONG                       i;
+
+    for (i = 0; i < UX_HOST_DESCRIPTOR_CACHE_ENTRIES; i ++, entry ++)
+    {
+        if (entry -> ux_host_descriptor_cache_descriptor != UX_NULL &&
+            entry -> ux_host_descriptor_cache_product_id == product_id)
+            return(entry);
+    }
+    return(UX_NULL);
+}
+#endif
+
+
+/* Define what the initial system looks like.  */
+
+#ifdef CTEST
+void test_application_define(void *first_unused_memory)
+#else
+void    usbx_ux_host_stack_descriptor_cache_test_application_define(void *first_unused_memory)
+#endif
+{
+
+UINT status;
+CHAR                            *stack_pointer;
+CHAR                            *memory_pointer;
+
+    /* Inform user.  */
+    printf("Running Descriptor Cache Test....................................... ");
+#if !defined(UX_HOST_DESCRIPTOR_CACHE_ENABLE) || defined(UX_HOST_STANDALONE)
+    printf("SKIP SUCCESS!\n");
+    test_control_return(0);
+    return;
+#else
+
+    /* Initialize the free memory pointer.  */
+    stack_pointer = (CHAR *) first_unused_memory;
+    memory_pointer = stack_pointer + (UX_TEST_STACK_SIZE * 2);
+
+    /* Initialize USBX Memory.  */
+    status =  ux_system_initialize(memory_pointer, UX_TEST_MEMORY_SIZE, UX_NULL, 0);
+
+    /* Check for error.  */
+    if (status != UX_SUCCESS)
+    {
+
+        printf("ERROR #%d\n", __LINE__);
+        test_control_return(1);
+    }
+
+    /* Register the error callback. */
+    _ux_utility_error_callback_register(error_callback);
+
+    /* The code below is required for installing the host portion of USBX.  */
+    status =  ux_host_stack_initialize(test_change_function);
+
+    /* Check for error.  */
+    if (status != UX_SUCCESS)
+    {
+
+        printf("ERROR #%d\n", __LINE__);
+        test_control_return(1);
+    }
+
+    /* Create the simulation thread.  */
+    status =  tx_thread_create(&ux_test_thread_simulation_0, "test simulation", ux_test_thread_simulation_0_entry, 0,
+            stack_pointer, UX_TEST_STACK_SIZE,
+            20, 20, 1, TX_AUTO_START);
+
+    /* Check for error.  */
+    if (status != TX_SUCCESS)
+    {
+
+        printf("ERROR #%d\n", __LINE__);
+        test_control_return(1);
+    }
+#endif
+}
+
+static void  ux_test_thread_simulation_0_entry(ULONG arg)
+{
+#if defined(UX_HOST_DESCRIPTOR_CACHE_ENABLE) && !defined(UX_HOST_STANDALONE)
+UX_HOST_DESCRIPTOR_CACHE    *entry;
+UCHAR                       long_descriptor[UX_HOST_DESCRIPTOR_CACHE_MAX_LENGTH + 1];
+ULONG                       i;
+UINT                        status;
+
+
+    /* Register the fake controller.  */
+    status =  ux_host_stack_hcd_register("hcd_test_driver", test_hcd_initialize, 0, 0);
+    UX_TEST_ASSERT(status == UX_SUCCESS);
+    status =  _ux_host_stack_descriptor_cache_callback_set(test_cache_callback);
+    UX_TEST_ASSERT(status == UX_SUCCESS);
+
+    /* Error checks.  */
+    status =  _uxe_host_stack_descriptor_cache_add(UX_TEST_VENDOR_ID, UX_TEST_OTHER_PRODUCT, 0, 0, UX_NULL, 0);
+    UX_TEST_ASSERT(status == UX_INVALID_PARAMETER);
+    status =  _uxe_host_stack_descriptor_cache_add(UX_TEST_VENDOR_ID, UX_TEST_OTHER_PRODUCT, 0, 0,
+                                                   test_configuration_descriptor, sizeof(test_configuration_descriptor) - 1);
+    UX_TEST_ASSERT(status == UX_DESCRIPTOR_CORRUPTED);
+    _ux_utility_memory_set(long_descriptor, 0, sizeof(long_descriptor));
+    long_descriptor[0] = 9;
+    long_descriptor[1] = UX_CONFIGURATION_DESCRIPTOR_ITEM;
+    _ux_utility_short_put(long_descriptor + 2, sizeof(long_descriptor));
+    status =  _uxe_host_stack_descriptor_cache_add(UX_TEST_VENDOR_ID, UX_TEST_OTHER_PRODUCT, 0, 0,
+                                                   long_descriptor, sizeof(long_descriptor));
+    UX_TEST_ASSERT(status == UX_MEMORY_INSUFFICIENT);
+    UX_TEST_ASSERT(test_cache_find(UX_TEST_OTHER_PRODUCT) == UX_NULL);
+
+    /* First enumeration reads the whole configuration and caches it.  */
+    test_device_plug();
+    UX_TEST_ASSERT(test_config_header_count == 1);
+    UX_TEST_ASSERT(test_config_full_count == 1);
+    UX_TEST_ASSERT(test_cache_callback_count == 1);
+    entry = test_cache_find(UX_TEST_PRODUCT_ID);
+    UX_TEST_ASSERT(entry != UX_NULL);
+    UX_TEST_ASSERT(entry -> ux_host_descriptor_cache_vendor_id == UX_TEST_VENDOR_ID);
+    UX_TEST_ASSERT(entry -> ux_host_descriptor_cache_length == sizeof(test_configuration_descriptor));
+
+    /* Next enumeration reads the configuration header only.  */
+    test_device_plug();
+    UX_TEST_ASSERT(test_config_header_count == 2);
+    UX_TEST_ASSERT(test_config_full_count == 1);
+    UX_TEST_ASSERT(test_cache_callback_count == 1);
+
+    /* A different header means the configuration has changed, it's read again.  */
+    test_configuration_descriptor[8] = 0x64;
+    test_device_plug();
+    UX_TEST_ASSERT(test_config_header_count == 3);
+    UX_TEST_ASSERT(test_config_full_count == 2);
+    UX_TEST_ASSERT(test_cache_callback_count == 2);
+    UX_TEST_ASSERT(test_cache_find(UX_TEST_PRODUCT_ID) == entry);
+    UX_TEST_ASSERT(entry -> ux_host_descriptor_cache_descriptor[8] == 0x64);
+
+    /* Fill the cache with other devices, as restored by the application.  */
+    for (i = 0; i < UX_HOST_DESCRIPTOR_CACHE_ENTRIES - 1; i ++)
+    {
+        status =  _uxe_host_stack_descriptor_cache_add(UX_TEST_VENDOR_ID, UX_TEST_OTHER_PRODUCT + i, 0, 0,
+                                                       test_configuration_descriptor, sizeof(test_configuration_descriptor));
+        UX_TEST_ASSERT(status == UX_SUCCESS);
+    }
+    UX_TEST_ASSERT(test_cache_callback_count == 2);
+
+    /* The device is still cached, using it makes it the most recently used.  */
+    test_device_plug();
+    UX_TEST_ASSERT(test_config_header_count == 4);
+    UX_TEST_ASSERT(test_config_full_count == 2);
+
+    /* The least recently used entry is replaced.  */
+    status =  _uxe_host_stack_descriptor_cache_add(UX_TEST_VENDOR_ID, UX_TEST_OTHER_PRODUCT + i, 0, 0,
+                                                   test_configuration_descriptor, sizeof(test_configuration_descriptor));
+    UX_TEST_ASSERT(status == UX_SUCCESS);
+    UX_TEST_ASSERT(test_cache_find(UX_TEST_PRODUCT_ID) == entry);
+    UX_TEST_ASSERT(test_cache_find(UX_TEST_OTHER_PRODUCT) == UX_NULL);
+    UX_TEST_ASSERT(test_cache_find(UX_TEST_OTHER_PRODUCT + i) != UX_NULL);
+
+    /* Configuration restored by the application is not read from the device.  */
+    _ux_utility_memory_free(entry -> ux_host_descriptor_cache_descriptor);
+    entry -> ux_host_descriptor_cache_descriptor = UX_NULL;
+    status =  _uxe_host_stack_descriptor_cache_add(UX_TEST_VENDOR_ID, UX_TEST_PRODUCT_ID, 0, 0,
+                                                   test_configuration_descriptor, sizeof(test_configuration_descriptor));
+    UX_TEST_ASSERT(status == UX_SUCCESS);
+    test_device_plug();
+    UX_TEST_ASSERT(test_config_header_count == 5);
+    UX_TEST_ASSERT(test_config_full_count == 2);
+    UX_TEST_ASSERT(test_cache_callback_count == 2);
+#endif
+
+    /* Sleep for a tick to make sure everything is complete.  */
+    tx_thread_sleep(1);
+
+    /* Check for errors from other threads.  */
+    if (error_counter)
+    {
+
+        /* Test error.  */
+        printf("ERROR #%d: total %ld errors\n", __LINE__, error_counter);
+        test_control_return(1);
+    }
+    else
+    {
+
+        /* Successful test.  */
+        printf("SUCCESS!\n");
+        test_control_return(0);
+    }
+}
@@ -418,6 +418,25 @@ UX_DEVICE        device_back;
         error_counter ++;
     }
 
+    /* Set address, expect error since address 128 does not exist.  */
+    ux_utility_memory_set(hcd->ux_hcd_address, 0xFF, 16);
+    hcd->ux_hcd_address[15] = 0x7F;
+    test_error_counter = 0;
+    ux_test_hcd_sim_host_set_actions(set_address_request);
+    status = _ux_host_stack_device_address_set(device);
+    if (status == UX_SUCCESS)
+    {
+
+        printf("ERROR #%d: expect error\n", __LINE__);
+        error_counter ++;
+    }
+    if (test_error_counter || hcd->ux_hcd_address[15] != 0x7F)
+    {
+
+        printf("ERROR #%d: expect no call of SetAddress\n", __LINE__);
+        error_counter ++;
+    }
+
     /* Set address, expect address 1.  */
     ux_utility_memory_set(hcd->ux_hcd_address, 0x00, 16);
     hcd->ux_hcd_address[0] = 1;
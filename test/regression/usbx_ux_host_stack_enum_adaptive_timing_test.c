@@ -0,0 +1,351 @@
+/* This test is designed to test the adaptive enumeration timing: root hub
+   devices are enumerated with minimum delays until a device fails.  */
+
+#include <stdio.h>
+#include "tx_api.h"
+#include "ux_api.h"
+#include "ux_system.h"
+#include "ux_utility.h"
+#include "ux_host_stack.h"
+
+#include "ux_test.h"
+
+
+/* Define USBX test constants.  */
+
+#define UX_TEST_STACK_SIZE      4096
+#define UX_TEST_MEMORY_SIZE     (128*1024)
+
+
+/* Define the counters used in the test application...  */
+
+static ULONG                           error_counter;
+
+#if defined(UX_HOST_ENUM_ADAPTIVE_TIMING_ENABLE) && !defined(UX_HOST_ENUM_PARALLEL_ENABLE)
+
+/* Fake device framework.  */
+
+static UCHAR test_device_descriptor[] = {
+    0x12, 0x01, 0x10, 0x01, 0x00, 0x00, 0x00, 0x40,
+    0xec, 0x08, 0x10, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x01,
+};
+
+static UCHAR test_configuration_descriptor[] = {
+    0x09, 0x02, 0x20, 0x00, 0x01, 0x01, 0x00, 0xc0,
+    0x32,
+    0x09, 0x04, 0x00, 0x00, 0x02, 0x99, 0x99, 0x99,
+    0x00,
+    0x07, 0x05, 0x81, 0x02, 0x40, 0x00, 0x00,
+    0x07, 0x05, 0x02, 0x02, 0x40, 0x00, 0x00,
+};
+
+/* Fake root hub port and request timings.  */
+
+static ULONG                           test_port_connected;
+static ULONG                           test_device_descriptor_fail;
+
+static ULONG                           test_address_set_time;
+static ULONG                           test_address_wait;
+
+static ULONG                           test_connection_count;
+static ULONG                           test_disconnection_count;
+static UX_DEVICE                       *test_device;
+#endif
+
+
+/* Define prototypes for external Host Controller's (HCDs), classes and clients.  */
+
+static TX_THREAD           ux_test_thread_simulation_0;
+static void                ux_test_thread_simulation_0_entry(ULONG);
+
+
+/* Prototype for test control return.  */
+
+void  test_control_return(UINT status);
+
+
+static VOID error_callback(UINT system_level, UINT system_context, UINT error_code)
+{
+
+    /* No class is registered, device enumerations end with no class found.
+       The device that fails the first request is enumerated again.  */
+    if (error_code == UX_NO_CLASS_MATCH || error_code == UX_DEVICE_ENUMERATION_FAILURE ||
+        error_code == UX_TRANSFER_STALLED)
+        return;
+
+    /* Failed test.  */
+    printf("Error #%d, system_level: %d, system_context: %d, error_code: 0x%x\n", __LINE__, system_level, system_context, error_code);
+    error_counter ++;
+}
+
+#if defined(UX_HOST_ENUM_ADAPTIVE_TIMING_ENABLE) && !defined(UX_HOST_ENUM_PARALLEL_ENABLE)
+static UINT test_change_function(ULONG event, UX_HOST_CLASS *host_class, VOID *instance)
+{
+
+    UX_PARAMETER_NOT_USED(host_class);
+
+    if (event == UX_DEVICE_CONNECTION)
+    {
+        test_device = (UX_DEVICE *)instance;
+        test_connection_count ++;
+    }
+    if (event == UX_DEVICE_DISCONNECTION)
+        test_disconnection_count ++;
+    return(UX_SUCCESS);
+}
+
+static VOID test_control_transfer(UX_TRANSFER *transfer_request)
+{
+UCHAR           *descriptor = UX_NULL;
+ULONG           length = 0;
+UINT            completion_code = UX_SUCCESS;
+
+    /* Keep the time the device is given to accept its address.  */
+    if (transfer_request -> ux_transfer_request_function == UX_SET_ADDRESS)
+        test_address_set_time = tx_time_get();
+
+    if (transfer_request -> ux_transfer_request_function == UX_GET_DESCRIPTOR)
+    {
+        if ((transfer_request -> ux_transfer_request_value >> 8) == UX_DEVICE_DESCRIPTOR_ITEM)
+        {
+            test_address_wait = tx_time_get() - test_address_set_time;
+            descriptor = test_device_descriptor;
+            length = sizeof(test_device_descriptor);
+
+            /* The device does not answer so early.  */
+            if (test_device_descriptor_fail)
+            {
+                test_device_descriptor_fail --;
+                descriptor = UX_NULL;
+                length = 0;
+                completion_code = UX_TRANSFER_STALLED;
+            }
+        }
+        else if ((transfer_request -> ux_transfer_request_value >> 8) == UX_CONFIGURATION_DESCRIPTOR_ITEM)
+        {
+            descriptor = test_configuration_descriptor;
+            length = sizeof(test_configuration_descriptor);
+        }
+        if (length > transfer_request -> ux_transfer_request_requested_length)
+            length = transfer_request -> ux_transfer_request_requested_length;
+        if (descriptor)
+            _ux_utility_memory_copy(transfer_request -> ux_transfer_request_data_pointer, descriptor, length);
+    }
+
+    /* What the HCD does when the transfer is done.  */
+    transfer_request -> ux_transfer_request_actual_length = length;
+    transfer_request -> ux_transfer_request_completion_code = completion_code;
+    _ux_host_semaphore_put(&transfer_request -> ux_transfer_request_semaphore);
+}
+
+static UINT test_hcd_entry(UX_HCD *hcd, UINT function, VOID *parameter)
+{
+
+    UX_PARAMETER_NOT_USED(hcd);
+
+    switch(function)
+    {
+
+    case UX_HCD_GET_PORT_STATUS:
+        if (test_port_connected)
+            return(UX_PS_CCS | UX_PS_DS_FS);
+        return(0);
+
+    case UX_HCD_TRANSFER_REQUEST:
+        test_control_transfer((UX_TRANSFER *)parameter);
+        return(UX_SUCCESS);
+
+    default:
+        return(UX_SUCCESS);
+    }
+}
+
+static UINT test_hcd_initialize(UX_HCD *hcd)
+{
+
+    /* Initialize the function collector for this HCD.  */
+    hcd -> ux_hcd_entry_function =  test_hcd_entry;
+
+    /* Set the host controller into the operational state.  */
+    hcd -> ux_hcd_status =  UX_HCD_STATUS_OPERATIONAL;
+
+    /* One root hub port is used.  */
+    hcd -> ux_hcd_nb_root_hubs =  1;
+
+    /* Return successful completion.  */
+    return(UX_SUCCESS);
+}
+
+static ULONG test_wait(ULONG *counter, ULONG value)
+{
+ULONG           i;
+
+    for (i = 0; i < 500 && *counter < value; i ++)
+        tx_thread_sleep(UX_MS_TO_TICK_NON_ZERO(10));
+    return(*counter);
+}
+
+static VOID test_device_connect(VOID)
+{
+UX_HCD          *hcd = &_ux_system_host -> ux_system_host_hcd_array[0];
+
+    /* Connect the device and wait for its enumeration.  */
+    test_port_connected = 1;
+    hcd -> ux_hcd_root_hub_signal[0] ++;
+    _ux_host_semaphore_put(&_ux_system_host -> ux_system_host_enum_semaphore);
+    UX_TEST_ASSERT(test_wait(&test_connection_count, 1) == 1);
+}
+
+static VOID test_device_disconnect(VOID)
+{
+UX_HCD          *hcd = &_ux_system_host -> ux_system_host_hcd_array[0];
+
+    /* Disconnect the device and wait for its removal.  */
+    test_port_connected = 0;
+    hcd -> ux_hcd_root_hub_signal[0] ++;
+    _ux_host_semaphore_put(&_ux_system_host -> ux_system_host_enum_semaphore);
+    UX_TEST_ASSERT(test_wait(&test_disconnection_count, 1) == 1);
+
+    test_connection_count = 0;
+    test_disconnection_count = 0;
+}
+#endif
+
+
+/* Define what the initial system looks like.  */
+
+#ifdef CTEST
+void test_application_define(void *first_unused_memory)
+#else
+void    usbx_ux_host_stack_enum_adaptive_timing_test_application_define(void *first_unused_memory)
+#endif
+{
+
+UINT status;
+CHAR                            *stack_pointer;
+CHAR                            *memory_pointer;
+
+    /* Inform user.  */
+    printf("Running Enumeration Adaptive Timing Test............................ ");
+#if !defined(UX_HOST_ENUM_ADAPTIVE_TIMING_ENABLE) || defined(UX_HOST_ENUM_PARALLEL_ENABLE)
+    printf("SKIP SUCCESS!\n");
+    test_control_return(0);
+    return;
+#else
+
+    /* Initialize the free memory pointer.  */
+    stack_pointer = (CHAR *) first_unused_memory;
+    memory_pointer = stack_pointer + (UX_TEST_STACK_SIZE * 2);
+
+    /* Initialize USBX Memory.  */
+    status =  ux_system_initialize(memory_pointer, UX_TEST_MEMORY_SIZE, UX_NULL, 0);
+
+    /* Check for error.  */
+    if (status != UX_SUCCESS)
+    {
+
+        printf("ERROR #%d\n", __LINE__);
+        test_control_return(1);
+    }
+
+    /* Register the error callback. */
+    _ux_utility_error_callback_register(error_callback);
+
+    /* The code below is required for installing the host portion of USBX.  */
+    status =  ux_host_stack_initialize(test_change_function);
+
+    /* Check for error.  */
+    if (status != UX_SUCCESS)
+    {
+
+        printf("ERROR #%d\n", __LINE__);
+        test_control_return(1);
+    }
+
+    /* Create the simulation thread.  */
+    status =  tx_thread_create(&ux_test_thread_simulation_0, "test simulation", ux_test_thread_simulation_0_entry, 0,
+            stack_pointer, UX_TEST_STACK_SIZE,
+            20, 20, 1, TX_AUTO_START);
+
+    /* Check for error.  */
+    if (status != TX_SUCCESS)
+    {
+
+        printf("ERROR #%d\n", __LINE__);
+        test_control_return(1);
+    }
+#endif
+}
+
+static void  ux_test_thread_simulation_0_entry(ULONG arg)
+{
+#if defined(UX_HOST_ENUM_ADAPTIVE_TIMING_ENABLE) && !defined(UX_HOST_ENUM_PARALLEL_ENABLE)
+UX_HCD                      *hcd;
+UINT                        status;
+
+
+    /* Register the fake controller.  */
+    status =  ux_host_stack_hcd_register("hcd_test_driver", test_hcd_initialize, 0, 0);
+    UX_TEST_ASSERT(status == UX_SUCCESS);
+    hcd = &_ux_system_host -> ux_system_host_hcd_array[0];
+
+    /* Device is enumerated with the minimum delays.  */
+    test_device_connect();
+    UX_TEST_ASSERT(hcd -> ux_hcd_rh_enum_fallback == 0);
+    UX_TEST_ASSERT(test_device -> ux_device_enum_fallback == 0);
+    UX_TEST_ASSERT(test_address_wait < UX_MS_TO_TICK(UX_DEVICE_ADDRESS_SET_WAIT));
+    UX_TEST_ASSERT(test_device -> ux_device_enum_phase_time[UX_HOST_ENUM_PHASE_ADDRESS] < UX_MS_TO_TICK(UX_DEVICE_ADDRESS_SET_WAIT));
+    test_device_disconnect();
+
+    /* Device failing the first request is enumerated again with the fixed delays.  */
+    test_device_descriptor_fail = 1;
+    test_device_connect();
+    UX_TEST_ASSERT(test_device_descriptor_fail == 0);
+
+    /* Failed attempt is notified as a disconnection.  */
+    UX_TEST_ASSERT(test_disconnection_count == 1);
+    test_disconnection_count = 0;
+    UX_TEST_ASSERT(test_device -> ux_device_enum_fallback == 1);
+    UX_TEST_ASSERT(test_address_wait >= UX_MS_TO_TICK(UX_DEVICE_ADDRESS_SET_WAIT));
+    UX_TEST_ASSERT(test_device -> ux_device_enum_phase_time[UX_HOST_ENUM_PHASE_ADDRESS] >= UX_MS_TO_TICK(UX_DEVICE_ADDRESS_SET_WAIT));
+
+    /* The device is enumerated, the port is back to the minimum delays.  */
+    UX_TEST_ASSERT(hcd -> ux_hcd_rh_enum_fallback == 0);
+    test_device_disconnect();
+
+    /* Next device is enumerated with the minimum delays.  */
+    test_device_connect();
+    UX_TEST_ASSERT(test_device -> ux_device_enum_fallback == 0);
+    UX_TEST_ASSERT(test_address_wait < UX_MS_TO_TICK(UX_DEVICE_ADDRESS_SET_WAIT));
+    test_device_disconnect();
+
+    /* Device never answering keeps the fixed delays until it is disconnected.  */
+    test_device_descriptor_fail = UX_RH_ENUMERATION_RETRY;
+    test_device_connect();
+    UX_TEST_ASSERT(test_device_descriptor_fail == 0);
+    UX_TEST_ASSERT(hcd -> ux_hcd_rh_enum_fallback == 1);
+    test_disconnection_count = 0;
+    test_device_disconnect();
+    UX_TEST_ASSERT(hcd -> ux_hcd_rh_enum_fallback == 0);
+#endif
+
+    /* Sleep for a tick to make sure everything is complete.  */
+    tx_thread_sleep(1);
+
+    /* Check for errors from other threads.  */
+    if (error_counter)
+    {
+
+        /* Test error.  */
+        printf("ERROR #%d: total %ld errors\n", __LINE__, error_counter);
+        test_control_return(1);
+    }
+    else
+    {
+
+        /* Successful test.  */
+        printf("SUCCESS!\n");
+        test_control_return(0);
+    }
+}
@@ -0,0 +1,437 @@
+/* This test is designed to test the parallel enumeration of devices: the
+   enumeration thread sets the device addresses, worker threads read the
+   descriptors of several devices at the same time.  */
+
+#include <stdio.h>
+#include "tx_api.h"
+#include "ux_api.h"
+#include "ux_system.h"
+#include "ux_utility.h"
+#include "ux_host_stack.h"
+
+#include "ux_test.h"
+
+
+/* Define USBX test constants.  */
+
+#define UX_TEST_STACK_SIZE      4096
+#define UX_TEST_MEMORY_SIZE     (256*1024)
+
+#define UX_TEST_PORTS           UX_MAX_ROOTHUB_PORT
+#define UX_TEST_SLOW_CONFIG_MS  300
+
+
+/* Define the counters used in the test application...  */
+
+static ULONG                           error_counter;
+
+#if defined(UX_HOST_ENUM_PARALLEL_ENABLE)
+
+/* Fake device framework.  */
+
+static UCHAR test_device_descriptor[] = {
+    0x12, 0x01, 0x10, 0x01, 0x00, 0x00, 0x00, 0x40,
+    0xec, 0x08, 0x10, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x01,
+};
+
+static UCHAR test_configuration_descriptor[] = {
+    0x09, 0x02, 0x12, 0x00, 0x01, 0x01, 0x00, 0xc0,
+    0x32,
+    0x09, 0x04, 0x00, 0x00, 0x00, 0x99, 0x99, 0x99,
+    0x00,
+};
+
+/* Fake root hub ports and request statistics.  */
+
+static ULONG                           test_port_connected;
+static UCHAR                           test_slow_config;
+static ULONG                           test_device_descriptor_fail;
+
+static ULONG                           test_address_set_count;
+static ULONG                           test_address_set_other_thread;
+static ULONG                           test_descriptor_enum_thread;
+static ULONG                           test_config_in_flight;
+static ULONG                           test_config_in_flight_max;
+
+static ULONG                           test_connection_count;
+static ULONG                           test_disconnection_count;
+#endif
+
+
+/* Define prototypes for external Host Controller's (HCDs), classes and clients.  */
+
+static TX_THREAD           ux_test_thread_simulation_0;
+static void                ux_test_thread_simulation_0_entry(ULONG);
+
+
+/* Prototype for test control return.  */
+
+void  test_control_return(UINT status);
+
+
+static VOID error_callback(UINT system_level, UINT system_context, UINT error_code)
+{
+
+    /* No class is registered, device enumerations end with no class found.  */
+    if (error_code == UX_NO_CLASS_MATCH || error_code == UX_DEVICE_ENUMERATION_FAILURE)
+        return;
+
+    /* Failed test.  */
+    printf("Error #%d, system_level: %d, system_context: %d, error_code: 0x%x\n", __LINE__, system_level, system_context, error_code);
+    error_counter ++;
+}
+
+#if defined(UX_HOST_ENUM_PARALLEL_ENABLE)
+static UINT test_change_function(ULONG event, UX_HOST_CLASS *host_class, VOID *instance)
+{
+
+    UX_PARAMETER_NOT_USED(host_class);
+    UX_PARAMETER_NOT_USED(instance);
+
+    if (event == UX_DEVICE_CONNECTION)
+        test_connection_count ++;
+    if (event == UX_DEVICE_DISCONNECTION)
+        test_disconnection_count ++;
+    return(UX_SUCCESS);
+}
+
+static VOID test_control_transfer(UX_TRANSFER *transfer_request)
+{
+UCHAR           *descriptor = UX_NULL;
+ULONG           length = 0;
+
+    if (transfer_request -> ux_transfer_request_function == UX_SET_ADDRESS)
+    {
+
+        /* Address 0 is used by the enumeration thread only.  */
+        test_address_set_count ++;
+        if (tx_thread_identify() != &_ux_system_host -> ux_system_host_enum_thread)
+            test_address_set_other_thread ++;
+    }
+    else if (transfer_request -> ux_transfer_request_function == UX_GET_DESCRIPTOR)
+    {
+
+        /* Descriptors are read by the worker threads.  */
+        if (tx_thread_identify() == &_ux_system_host -> ux_system_host_enum_thread)
+            test_descriptor_enum_thread ++;
+
+        if ((transfer_request -> ux_transfer_request_value >> 8) == UX_DEVICE_DESCRIPTOR_ITEM)
+        {
+
+            /* Device not answering, once its address is set.  */
+            if (test_device_descriptor_fail)
+            {
+                test_device_descriptor_fail --;
+                transfer_request -> ux_transfer_request_actual_length = 0;
+                transfer_request -> ux_transfer_request_completion_code = UX_TRANSFER_STALLED;
+                _ux_host_semaphore_put(&transfer_request -> ux_transfer_request_semaphore);
+                return;
+            }
+            descriptor = test_device_descriptor;
+            length = sizeof(test_device_descriptor);
+        }
+        else if ((transfer_request -> ux_transfer_request_value >> 8) == UX_CONFIGURATION_DESCRIPTOR_ITEM)
+        {
+            descriptor = test_configuration_descriptor;
+            length = sizeof(test_configuration_descriptor);
+
+            /* Slow device, count the requests done at the same time.  */
+            if (test_slow_config)
+            {
+                test_config_in_flight ++;
+                if (test_config_in_flight > test_config_in_flight_max)
+                    test_config_in_flight_max = test_config_in_flight;
+                tx_thread_sleep(UX_MS_TO_TICK_NON_ZERO(UX_TEST_SLOW_CONFIG_MS));
+                test_config_in_flight --;
+
+                /* The request may be aborted meanwhile.  */
+                if (transfer_request -> ux_transfer_request_completion_code != UX_TRANSFER_STATUS_PENDING)
+                    return;
+            }
+        }
+        if (length > transfer_request -> ux_transfer_request_requested_length)
+            length = transfer_request -> ux_transfer_request_requested_length;
+        if (descriptor)
+            _ux_utility_memory_copy(transfer_request -> ux_transfer_request_data_pointer, descriptor, length);
+    }
+
+    /* What the HCD does when the transfer is done.  */
+    transfer_request -> ux_transfer_request_actual_length = length;
+    transfer_request -> ux_transfer_request_completion_code = UX_SUCCESS;
+    _ux_host_semaphore_put(&transfer_request -> ux_transfer_request_semaphore);
+}
+
+static UINT test_hcd_entry(UX_HCD *hcd, UINT function, VOID *parameter)
+{
+ULONG           port_index = (ULONG)(ALIGN_TYPE)parameter;
+
+    UX_PARAMETER_NOT_USED(hcd);
+
+    switch(function)
+    {
+
+    case UX_HCD_GET_PORT_STATUS:
+        if (test_port_connected & (1u << port_index))
+            return(UX_PS_CCS | UX_PS_DS_FS);
+        return(0);
+
+    case UX_HCD_TRANSFER_REQUEST:
+        test_control_transfer((UX_TRANSFER *)parameter);
+        return(UX_SUCCESS);
+
+    default:
+        return(UX_SUCCESS);
+    }
+}
+
+static UINT test_hcd_initialize(UX_HCD *hcd)
+{
+
+    /* Initialize the function collector for this HCD.  */
+    hcd -> ux_hcd_entry_function =  test_hcd_entry;
+
+    /* Set the host controller into the operational state.  */
+    hcd -> ux_hcd_status =  UX_HCD_STATUS_OPERATIONAL;
+
+    /* All the root hub ports are used.  */
+    hcd -> ux_hcd_nb_root_hubs =  UX_TEST_PORTS;
+
+    /* Return successful completion.  */
+    return(UX_SUCCESS);
+}
+
+static VOID test_ports_change(ULONG ports)
+{
+UX_HCD          *hcd = &_ux_system_host -> ux_system_host_hcd_array[0];
+ULONG           i;
+
+    for (i = 0; i < UX_TEST_PORTS; i ++)
+    {
+        if (ports & (1u << i))
+            hcd -> ux_hcd_root_hub_signal[i] ++;
+    }
+    _ux_host_semaphore_put(&_ux_system_host -> ux_system_host_enum_semaphore);
+}
+
+static ULONG test_wait(ULONG *counter, ULONG value)
+{
+ULONG           i;
+
+    for (i = 0; i < 500 && *counter < value; i ++)
+        tx_thread_sleep(UX_MS_TO_TICK_NON_ZERO(10));
+    return(*counter);
+}
+
+static ULONG test_devices_count(VOID)
+{
+UX_DEVICE       *device = _ux_system_host -> ux_system_host_device_array;
+ULONG           count = 0;
+ULONG           i;
+
+    for (i = 0; i < UX_MAX_DEVICES; i ++, device ++)
+    {
+        if (device -> ux_device_handle != UX_UNUSED)
+            count ++;
+    }
+    return(count);
+}
+#endif
+
+
+/* Define what the initial system looks like.  */
+
+#ifdef CTEST
+void test_application_define(void *first_unused_memory)
+#else
+void    usbx_ux_host_stack_enum_parallel_test_application_define(void *first_unused_memory)
+#endif
+{
+
+UINT status;
+CHAR                            *stack_pointer;
+CHAR                            *memory_pointer;
+
+    /* Inform user.  */
+    printf("Running Parallel Enumeration Test................................... ");
+#if !defined(UX_HOST_ENUM_PARALLEL_ENABLE)
+    printf("SKIP SUCCESS!\n");
+    test_control_return(0);
+    return;
+#else
+
+    /* Initialize the free memory pointer.  */
+    stack_pointer = (CHAR *) first_unused_memory;
+    memory_pointer = stack_pointer + (UX_TEST_STACK_SIZE * 2);
+
+    /* Initialize USBX Memory.  */
+    status =  ux_system_initialize(memory_pointer, UX_TEST_MEMORY_SIZE, UX_NULL, 0);
+
+    /* Check for error.  */
+    if (status != UX_SUCCESS)
+    {
+
+        printf("ERROR #%d\n", __LINE__);
+        test_control_return(1);
+    }
+
+    /* Register the error callback. */
+    _ux_utility_error_callback_register(error_callback);
+
+    /* The code below is required for installing the host portion of USBX.  */
+    status =  ux_host_stack_initialize(test_change_function);
+
+    /* Check for error.  */
+    if (status != UX_SUCCESS)
+    {
+
+        printf("ERROR #%d\n", __LINE__);
+        test_control_return(1);
+    }
+
+    /* Create the simulation thread.  */
+    status =  tx_thread_create(&ux_test_thread_simulation_0, "test simulation", ux_test_thread_simulation_0_entry, 0,
+            stack_pointer, UX_TEST_STACK_SIZE,
+            20, 20, 1, TX_AUTO_START);
+
+    /* Check for error.  */
+    if (status != TX_SUCCESS)
+    {
+
+        printf("ERROR #%d\n", __LINE__);
+        test_control_return(1);
+    }
+#endif
+}
+
+static void  ux_test_thread_simulation_0_entry(ULONG arg)
+{
+#if defined(UX_HOST_ENUM_PARALLEL_ENABLE)
+UX_DEVICE       *device;
+ULONG           addresses;
+ULONG           all_ports = (1u << UX_TEST_PORTS) - 1;
+ULONG           i;
+UINT            status;
+
+
+    /* Register the fake controller.  */
+    status =  ux_host_stack_hcd_register("hcd_test_driver", test_hcd_initialize, 0, 0);
+    UX_TEST_ASSERT(status == UX_SUCCESS);
+
+    /* All ports are connected at the same time, configurations are slow to read.  */
+    test_slow_config = UX_TRUE;
+    test_port_connected = all_ports;
+    test_ports_change(all_ports);
+    UX_TEST_ASSERT(test_wait(&test_connection_count, UX_TEST_PORTS) == UX_TEST_PORTS);
+
+    /* Addresses are set by the enumeration thread, descriptors are read by the workers.  */
+    UX_TEST_ASSERT(test_address_set_count == UX_TEST_PORTS);
+    UX_TEST_ASSERT(test_address_set_other_thread == 0);
+    UX_TEST_ASSERT(test_descriptor_enum_thread == 0);
+
+    /* Configurations of several devices were read at the same time.  */
+    UX_TEST_ASSERT(test_config_in_flight_max > 1);
+    UX_TEST_ASSERT(test_config_in_flight_max <= UX_HOST_ENUM_PARALLEL_THREADS);
+
+    /* All devices are enumerated with their own address.  */
+    addresses = 0;
+    device = _ux_system_host -> ux_system_host_device_array;
+    for (i = 0; i < UX_MAX_DEVICES; i ++, device ++)
+    {
+        if (device -> ux_device_handle == UX_UNUSED)
+            continue;
+        UX_TEST_ASSERT(device -> ux_device_state == UX_DEVICE_ADDRESSED);
+        UX_TEST_ASSERT(device -> ux_device_flags == 0);
+        UX_TEST_ASSERT(device -> ux_device_first_configuration != UX_NULL);
+        UX_TEST_ASSERT((addresses & (1u << device -> ux_device_address)) == 0);
+        addresses |= 1u << device -> ux_device_address;
+    }
+    UX_TEST_ASSERT(addresses == (all_ports << 1));
+
+    /* All devices are removed.  */
+    test_port_connected = 0;
+    test_ports_change(all_ports);
+    UX_TEST_ASSERT(test_wait(&test_disconnection_count, UX_TEST_PORTS) == UX_TEST_PORTS);
+
+    /* Device removed while its descriptors are read by a worker.  */
+    test_connection_count = 0;
+    test_disconnection_count = 0;
+    test_port_connected = 1;
+    test_ports_change(1);
+    UX_TEST_ASSERT(test_wait(&test_config_in_flight, 1) == 1);
+    test_port_connected = 0;
+    test_ports_change(1);
+    UX_TEST_ASSERT(test_wait(&test_disconnection_count, 1) == 1);
+    UX_TEST_ASSERT(test_config_in_flight == 0);
+    tx_thread_sleep(UX_MS_TO_TICK_NON_ZERO(UX_TEST_SLOW_CONFIG_MS));
+    UX_TEST_ASSERT(test_connection_count == 0);
+    UX_TEST_ASSERT(_ux_system_host -> ux_system_host_enum_device == UX_NULL);
+    UX_TEST_ASSERT(_ux_system_host -> ux_system_host_enum_ready == UX_NULL);
+    UX_TEST_ASSERT(_ux_system_host -> ux_system_host_device_array[0].ux_device_handle == UX_UNUSED);
+
+    /* Device descriptor read fails once in a worker: the device is freed and enumerated again.  */
+    test_slow_config = UX_FALSE;
+    test_connection_count = 0;
+    test_disconnection_count = 0;
+    test_address_set_count = 0;
+    test_device_descriptor_fail = 1;
+    test_port_connected = 1;
+    test_ports_change(1);
+    UX_TEST_ASSERT(test_wait(&test_connection_count, 1) == 1);
+    tx_thread_sleep(UX_MS_TO_TICK_NON_ZERO(100));
+    UX_TEST_ASSERT(test_connection_count == 1);
+    UX_TEST_ASSERT(test_disconnection_count == 1);
+    UX_TEST_ASSERT(test_address_set_count == 2);
+    UX_TEST_ASSERT(test_device_descriptor_fail == 0);
+    UX_TEST_ASSERT(test_devices_count() == 1);
+    UX_TEST_ASSERT(_ux_system_host -> ux_system_host_hcd_array[0].ux_hcd_nb_devices == 1);
+    device = _ux_system_host -> ux_system_host_device_array;
+    UX_TEST_ASSERT(device -> ux_device_state == UX_DEVICE_ADDRESSED);
+    UX_TEST_ASSERT(device -> ux_device_first_configuration != UX_NULL);
+
+    test_port_connected = 0;
+    test_ports_change(1);
+    UX_TEST_ASSERT(test_wait(&test_disconnection_count, 2) == 2);
+    UX_TEST_ASSERT(test_devices_count() == 0);
+
+    /* Device descriptor read always fails: the port is retried, the last device stays unconfigured.  */
+    test_connection_count = 0;
+    test_disconnection_count = 0;
+    test_address_set_count = 0;
+    test_device_descriptor_fail = UX_RH_ENUMERATION_RETRY;
+    test_port_connected = 1;
+    test_ports_change(1);
+    UX_TEST_ASSERT(test_wait(&test_connection_count, 1) == 1);
+    tx_thread_sleep(UX_MS_TO_TICK_NON_ZERO(100));
+    UX_TEST_ASSERT(test_connection_count == 1);
+    UX_TEST_ASSERT(test_disconnection_count == UX_RH_ENUMERATION_RETRY - 1);
+    UX_TEST_ASSERT(test_address_set_count == UX_RH_ENUMERATION_RETRY);
+    UX_TEST_ASSERT(test_devices_count() == 1);
+    UX_TEST_ASSERT(_ux_system_host -> ux_system_host_hcd_array[0].ux_hcd_nb_devices == 1);
+    UX_TEST_ASSERT(device -> ux_device_first_configuration == UX_NULL);
+
+    test_port_connected = 0;
+    test_ports_change(1);
+    UX_TEST_ASSERT(test_wait(&test_disconnection_count, UX_RH_ENUMERATION_RETRY) == UX_RH_ENUMERATION_RETRY);
+    UX_TEST_ASSERT(test_devices_count() == 0);
+#endif
+
+    /* Sleep for a tick to make sure everything is complete.  */
+    tx_thread_sleep(1);
+
+    /* Check for errors from other threads.  */
+    if (error_counter)
+    {
+
+        /* Test error.  */
+        printf("ERROR #%d: total %ld errors\n", __LINE__, error_counter);
+        test_control_return(1);
+    }
+    else
+    {
+
+        /* Successful test.  */
+        printf("SUCCESS!\n");
+        test_control_return(0);
+    }
+}
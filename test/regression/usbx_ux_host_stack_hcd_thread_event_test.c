@@ -0,0 +1,276 @@
+/* This test is designed to test the HCD thread events: signals of HCDs
+   set pending bits which are processed in one pass of the HCD thread(s).  */
+
+#include <stdio.h>
+#include "tx_api.h"
+#include "ux_api.h"
+#include "ux_system.h"
+#include "ux_utility.h"
+#include "ux_host_stack.h"
+
+#include "ux_test.h"
+
+
+/* Define USBX test constants.  */
+
+#define UX_TEST_STACK_SIZE      4096
+#define UX_TEST_MEMORY_SIZE     (64*1024)
+
+#define UX_TEST_SIGNALS         4
+
+
+/* Define the counters used in the test application...  */
+
+static ULONG                           error_counter;
+
+#if defined(UX_HOST_HCD_THREAD_EVENT_ENABLE)
+static ULONG                           hcd_process_counter[UX_MAX_HCD];
+#endif
+
+
+/* Define prototypes for external Host Controller's (HCDs), classes and clients.  */
+
+static TX_THREAD           ux_test_thread_simulation_0;
+static void                ux_test_thread_simulation_0_entry(ULONG);
+
+
+/* Prototype for test control return.  */
+
+void  test_control_return(UINT status);
+
+
+static VOID error_callback(UINT system_level, UINT system_context, UINT error_code)
+{
+
+    /* Failed test.  */
+    printf("Error #%d, system_level: %d, system_context: %d, error_code: 0x%x\n", __LINE__, system_level, system_context, error_code);
+    error_counter ++;
+}
+
+#if defined(UX_HOST_HCD_THREAD_EVENT_ENABLE)
+static UINT _ux_hcd_test_host_entry(UX_HCD *hcd, UINT function, VOID *parameter)
+{
+
+    UX_PARAMETER_NOT_USED(parameter);
+
+    if (function == UX_HCD_PROCESS_DONE_QUEUE)
+        hcd_process_counter[hcd - _ux_system_host -> ux_system_host_hcd_array] ++;
+    return(UX_SUCCESS);
+}
+
+static UINT _ux_hcd_test_host_initialize(UX_HCD *hcd)
+{
+
+    /* Initialize the function collector for this HCD.  */
+    hcd -> ux_hcd_entry_function =  _ux_hcd_test_host_entry;
+
+    /* Set the host controller into the operational state.  */
+    hcd -> ux_hcd_status =  UX_HCD_STATUS_OPERATIONAL;
+
+    /* No port on this controller.  */
+    hcd -> ux_hcd_nb_root_hubs =  0;
+
+    /* Return successful completion.  */
+    return(UX_SUCCESS);
+}
+
+static UINT _ux_hcd_test_host_initialize_fail(UX_HCD *hcd)
+{
+
+    /* The controller is registered but does not work.  */
+    hcd -> ux_hcd_entry_function =  _ux_hcd_test_host_entry;
+    return(UX_CONTROLLER_INIT_FAILED);
+}
+
+static VOID _ux_hcd_test_threads_suspend(VOID)
+{
+#if defined(UX_HOST_HCD_THREAD_PER_HCD_ENABLE)
+ULONG           i;
+
+    for (i = 0; i < UX_MAX_HCD; i ++)
+        tx_thread_suspend(&_ux_system_host -> ux_system_host_hcd_array[i].ux_hcd_thread);
+#else
+    tx_thread_suspend(&_ux_system_host -> ux_system_host_hcd_thread);
+#endif
+}
+
+static VOID _ux_hcd_test_threads_resume(VOID)
+{
+#if defined(UX_HOST_HCD_THREAD_PER_HCD_ENABLE)
+ULONG           i;
+
+    for (i = 0; i < UX_MAX_HCD; i ++)
+        tx_thread_resume(&_ux_system_host -> ux_system_host_hcd_array[i].ux_hcd_thread);
+#else
+    tx_thread_resume(&_ux_system_host -> ux_system_host_hcd_thread);
+#endif
+}
+#endif
+
+
+/* Define what the initial system looks like.  */
+
+#ifdef CTEST
+void test_application_define(void *first_unused_memory)
+#else
+void    usbx_ux_host_stack_hcd_thread_event_test_application_define(void *first_unused_memory)
+#endif
+{
+
+UINT status;
+CHAR                            *stack_pointer;
+CHAR                            *memory_pointer;
+
+    /* Inform user.  */
+    printf("Running HCD Thread Event Test....................................... ");
+#if !defined(UX_HOST_HCD_THREAD_EVENT_ENABLE)
+    printf("SKIP SUCCESS!\n");
+    test_control_return(0);
+    return;
+#endif
+
+    /* Initialize the free memory pointer.  */
+    stack_pointer = (CHAR *) first_unused_memory;
+    memory_pointer = stack_pointer + (UX_TEST_STACK_SIZE * 2);
+
+    /* Initialize USBX Memory.  */
+    status =  ux_system_initialize(memory_pointer, UX_TEST_MEMORY_SIZE, UX_NULL, 0);
+
+    /* Check for error.  */
+    if (status != UX_SUCCESS)
+    {
+
+        printf("ERROR #%d\n", __LINE__);
+        test_control_return(1);
+    }
+
+    /* Register the error callback. */
+    _ux_utility_error_callback_register(error_callback);
+
+    /* The code below is required for installing the host portion of USBX.  */
+    status =  ux_host_stack_initialize(UX_NULL);
+
+    /* Check for error.  */
+    if (status != UX_SUCCESS)
+    {
+
+        printf("ERROR #%d\n", __LINE__);
+        test_control_return(1);
+    }
+
+    /* Create the simulation thread.  */
+    status =  tx_thread_create(&ux_test_thread_simulation_0, "test simulation", ux_test_thread_simulation_0_entry, 0,
+            stack_pointer, UX_TEST_STACK_SIZE,
+            20, 20, 1, TX_AUTO_START);
+
+    /* Check for error.  */
+    if (status != TX_SUCCESS)
+    {
+
+        printf("ERROR #%d\n", __LINE__);
+        test_control_return(1);
+    }
+}
+
+static void  ux_test_thread_simulation_0_entry(ULONG arg)
+{
+#if defined(UX_HOST_HCD_THREAD_EVENT_ENABLE)
+UX_HCD          *hcd;
+ULONG           i;
+ULONG           j;
+UINT            status;
+
+
+    /* Register all the fake controllers.  */
+    for (i = 0; i < UX_MAX_HCD; i ++)
+    {
+        status =  ux_host_stack_hcd_register("hcd_test_driver", _ux_hcd_test_host_initialize, i, 0);
+        UX_TEST_ASSERT(status == UX_SUCCESS);
+    }
+
+    /* Signals are collected while the HCD thread(s) can not run.  */
+    _ux_hcd_test_threads_suspend();
+    for (j = 0; j < UX_TEST_SIGNALS; j ++)
+    {
+        for (i = 0; i < UX_MAX_HCD; i ++)
+            UX_HOST_HCD_THREAD_SIGNAL(&_ux_system_host -> ux_system_host_hcd_array[i]);
+    }
+    UX_TEST_ASSERT(_ux_system_host -> ux_system_host_hcd_pending == (ULONG)((1u << UX_MAX_HCD) - 1));
+
+    /* Only the first signal wakes up the thread.  */
+#if defined(UX_HOST_HCD_THREAD_PER_HCD_ENABLE)
+    for (i = 0; i < UX_MAX_HCD; i ++)
+        UX_TEST_ASSERT(_ux_system_host -> ux_system_host_hcd_array[i].ux_hcd_semaphore.tx_semaphore_count <= 1);
+#else
+    UX_TEST_ASSERT(_ux_system_host -> ux_system_host_hcd_semaphore.tx_semaphore_count <= 1);
+#endif
+
+    /* All the work is processed in one pass.  */
+    _ux_hcd_test_threads_resume();
+    tx_thread_sleep(10);
+    UX_TEST_ASSERT(_ux_system_host -> ux_system_host_hcd_pending == 0);
+    for (i = 0; i < UX_MAX_HCD; i ++)
+    {
+        UX_TEST_ASSERT(hcd_process_counter[i] == 1);
+        UX_TEST_ASSERT(_ux_system_host -> ux_system_host_hcd_array[i].ux_hcd_thread_signal == 0);
+    }
+
+    /* Only the signaled HCD is processed.  */
+    hcd = &_ux_system_host -> ux_system_host_hcd_array[UX_MAX_HCD - 1];
+    UX_HOST_HCD_THREAD_SIGNAL(hcd);
+    tx_thread_sleep(10);
+    UX_TEST_ASSERT(hcd_process_counter[UX_MAX_HCD - 1] == 2);
+    UX_TEST_ASSERT(hcd_process_counter[0] == 1 || UX_MAX_HCD == 1);
+
+    /* A controller not operational is not processed.  */
+    hcd -> ux_hcd_status =  UX_HCD_STATUS_DEAD;
+    UX_HOST_HCD_THREAD_SIGNAL(hcd);
+    tx_thread_sleep(10);
+    UX_TEST_ASSERT(hcd_process_counter[UX_MAX_HCD - 1] == 2);
+    UX_TEST_ASSERT(_ux_system_host -> ux_system_host_hcd_pending == 0);
+    hcd -> ux_hcd_status =  UX_HCD_STATUS_OPERATIONAL;
+
+    /* Unregister frees the resources of the HCD.  */
+    status =  ux_host_stack_hcd_unregister("hcd_test_driver", UX_MAX_HCD - 1, 0);
+    UX_TEST_ASSERT(status == UX_SUCCESS);
+#if defined(UX_HOST_HCD_THREAD_PER_HCD_ENABLE)
+    UX_TEST_ASSERT(hcd -> ux_hcd_thread_stack == UX_NULL);
+
+    /* The stack does not have a shared HCD thread.  */
+    UX_TEST_ASSERT(_ux_system_host -> ux_system_host_hcd_thread.tx_thread_id == 0);
+    UX_TEST_ASSERT(_ux_system_host -> ux_system_host_hcd_thread_stack == UX_NULL);
+#endif
+
+    /* A controller failing its initialization does not keep its thread.  */
+    status =  ux_host_stack_hcd_register("hcd_test_driver", _ux_hcd_test_host_initialize_fail, UX_MAX_HCD - 1, 0);
+    UX_TEST_ASSERT(status == UX_CONTROLLER_INIT_FAILED);
+#if defined(UX_HOST_HCD_THREAD_PER_HCD_ENABLE)
+    UX_TEST_ASSERT(hcd -> ux_hcd_thread_stack == UX_NULL);
+    UX_TEST_ASSERT(hcd -> ux_hcd_thread.tx_thread_id == 0);
+    UX_TEST_ASSERT(hcd -> ux_hcd_semaphore.tx_semaphore_id == 0);
+#endif
+
+    /* Unregister does not free it twice.  */
+    status =  ux_host_stack_hcd_unregister("hcd_test_driver", UX_MAX_HCD - 1, 0);
+    UX_TEST_ASSERT(status == UX_SUCCESS);
+#endif
+
+    /* Sleep for a tick to make sure everything is complete.  */
+    tx_thread_sleep(1);
+
+    /* Check for errors from other threads.  */
+    if (error_counter)
+    {
+
+        /* Test error.  */
+        printf("ERROR #%d: total %ld errors\n", __LINE__, error_counter);
+        test_control_return(1);
+    }
+    else
+    {
+
+        /* Successful test.  */
+        printf("SUCCESS!\n");
+        test_control_return(0);
+    }
+}
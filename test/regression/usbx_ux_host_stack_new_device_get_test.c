@@ -5,6 +5,7 @@
 #include "ux_api.h"
 #include "ux_system.h"
 #include "ux_utility.h"
+#include "ux_host_stack.h"
 #include "ux_host_class_dpump.h"
 #include "ux_device_class_dpump.h"
 
@@ -42,7 +43,6 @@ static TX_THREAD           ux_test_thread_slave_simulation;
 static void                ux_test_thread_host_simulation_entry(ULONG);
 static void                ux_test_thread_slave_simulation_entry(ULONG);
 
-extern  UX_DEVICE  *_ux_host_stack_new_device_get(VOID);
 
 /* Define the ISR dispatch.  */
 
@@ -152,7 +152,38 @@ UINT                            i;
         printf("ERROR #5\n");
         test_control_return(1);
     }
-    else
+
+    /* The device index is the index of the container.  */
+    for (i = 0; i < UX_SYSTEM_HOST_MAX_DEVICES_GET(); i ++)
+    {
+        if (ux_host_stack_device_get(i, &new_device) != UX_SUCCESS ||
+            new_device != &_ux_system_host -> ux_system_host_device_array[i])
+        {
+
+            printf("ERROR #6\n");
+            test_control_return(1);
+        }
+    }
+
+#if UX_MAX_DEVICES > 1
+
+    /* A container freed is found again from the map.  */
+    new_device = &_ux_system_host -> ux_system_host_device_array[UX_MAX_DEVICES - 1];
+    _ux_host_stack_device_resources_free(new_device);
+    if (_ux_system_host -> ux_system_host_device_map[(UX_MAX_DEVICES - 1) >> 5] & (1u << ((UX_MAX_DEVICES - 1) & 31)))
+    {
+
+        printf("ERROR #7\n");
+        test_control_return(1);
+    }
+    if (_ux_host_stack_new_device_get() != new_device)
+    {
+
+        printf("ERROR #8\n");
+        test_control_return(1);
+    }
+#endif
+
     {
 
         /* Successful test.  */
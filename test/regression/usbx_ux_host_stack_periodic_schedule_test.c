@@ -0,0 +1,436 @@
+/* This test is designed to test the periodic schedule: interrupt and isochronous
+   endpoints are placed in (frame, microframe) slots and split transactions are
+   budgeted per TT frame. The EHCI and OHCI controllers link the endpoints in the
+   slots chosen by the schedule.  */
+
+#include <stdio.h>
+#include "tx_api.h"
+#include "ux_api.h"
+#include "ux_system.h"
+#include "ux_utility.h"
+#include "ux_host_stack.h"
+#include "ux_hcd_ehci.h"
+#include "ux_hcd_ohci.h"
+
+#include "ux_test.h"
+
+
+/* Define USBX test constants.  */
+
+#define UX_TEST_STACK_SIZE      4096
+#define UX_TEST_MEMORY_SIZE     (128*1024)
+
+#define UX_TEST_ENDPOINTS       33
+
+
+/* Define the counters used in the test application...  */
+
+static ULONG                           error_counter;
+static ULONG                           bandwidth_error_counter;
+
+#if defined(UX_HOST_PERIODIC_SCHEDULE_ENABLE)
+static UX_HCD                          test_hcd;
+static UX_DEVICE                       test_hub;
+static UX_DEVICE                       test_device;
+static UX_ENDPOINT                     test_endpoints[UX_TEST_ENDPOINTS];
+static UX_HCD_EHCI                     test_hcd_ehci;
+static UX_HCD_OHCI                     test_hcd_ohci;
+#endif
+
+
+/* Define prototypes for external Host Controller's (HCDs), classes and clients.  */
+
+static TX_THREAD           ux_test_thread_simulation_0;
+static void                ux_test_thread_simulation_0_entry(ULONG);
+
+
+/* Prototype for test control return.  */
+
+void  test_control_return(UINT status);
+
+
+static VOID error_callback(UINT system_level, UINT system_context, UINT error_code)
+{
+
+    /* Bandwidth errors are expected.  */
+    if (error_code == UX_NO_BANDWIDTH_AVAILABLE)
+    {
+        bandwidth_error_counter ++;
+        return;
+    }
+
+    /* Failed test.  */
+    printf("Error #%d, system_level: %d, system_context: %d, error_code: 0x%x\n", __LINE__, system_level, system_context, error_code);
+    error_counter ++;
+}
+
+#if defined(UX_HOST_PERIODIC_SCHEDULE_ENABLE)
+static VOID _ux_test_schedule_reset(ULONG hcd_version, UCHAR speed)
+{
+
+    /* Start from an empty schedule.  */
+    ux_utility_memory_set(&test_hcd, 0, sizeof(test_hcd));
+    ux_utility_memory_set(&test_hub, 0, sizeof(test_hub));
+    ux_utility_memory_set(&test_device, 0, sizeof(test_device));
+    ux_utility_memory_set(test_endpoints, 0, sizeof(test_endpoints));
+    test_hcd.ux_hcd_version = hcd_version;
+    test_hcd.ux_hcd_available_bandwidth = 6000;
+    test_device.ux_device_speed = speed;
+}
+
+static VOID _ux_test_endpoint_init(UX_ENDPOINT *endpoint, UCHAR type, USHORT max_packet_size, UCHAR interval)
+{
+
+    endpoint -> ux_endpoint_device = &test_device;
+    endpoint -> ux_endpoint_descriptor.bmAttributes = type;
+    endpoint -> ux_endpoint_descriptor.wMaxPacketSize = max_packet_size;
+    endpoint -> ux_endpoint_descriptor.bInterval = interval;
+}
+
+static UINT _ux_test_endpoint_add(UX_ENDPOINT *endpoint)
+{
+
+UINT            status;
+
+    /* Same sequence as the endpoint instance creation.  */
+    status = _ux_host_stack_bandwidth_check(&test_hcd, endpoint);
+    if ((status == UX_SUCCESS) && (test_hcd.ux_hcd_entry_function != UX_NULL))
+        status = test_hcd.ux_hcd_entry_function(&test_hcd, UX_HCD_CREATE_ENDPOINT, (VOID *) endpoint);
+    if (status == UX_SUCCESS)
+        _ux_host_stack_bandwidth_claim(&test_hcd, endpoint);
+    return(status);
+}
+
+static VOID _ux_test_ehci_initialize(VOID)
+{
+
+ULONG           i;
+
+    /* Build the ED free list and periodic tree of an EHCI controller, as its
+       initialization does.  */
+    ux_utility_memory_set(&test_hcd_ehci, 0, sizeof(test_hcd_ehci));
+    test_hcd_ehci.ux_hcd_ehci_frame_list_size = 32;
+    test_hcd_ehci.ux_hcd_ehci_frame_list = _ux_utility_memory_allocate(UX_ALIGN_4096, UX_CACHE_SAFE_MEMORY, sizeof(UX_EHCI_ED *) * 32);
+    UX_TEST_ASSERT(test_hcd_ehci.ux_hcd_ehci_frame_list != UX_NULL);
+    test_hcd_ehci.ux_hcd_ehci_ed_list = _ux_utility_memory_allocate(UX_ALIGN_32, UX_CACHE_SAFE_MEMORY, sizeof(UX_EHCI_ED) * _ux_system_host -> ux_system_host_max_ed);
+    UX_TEST_ASSERT(test_hcd_ehci.ux_hcd_ehci_ed_list != UX_NULL);
+    for (i = _ux_system_host -> ux_system_host_max_ed; i > 0; i --)
+    {
+        test_hcd_ehci.ux_hcd_ehci_ed_list[i - 1].REF_AS.FREE.ux_ehci_ed_next_free = test_hcd_ehci.ux_hcd_ehci_ed_free_list;
+        test_hcd_ehci.ux_hcd_ehci_ed_free_list = &test_hcd_ehci.ux_hcd_ehci_ed_list[i - 1];
+    }
+    UX_TEST_ASSERT(_ux_host_mutex_create(&test_hcd_ehci.ux_hcd_ehci_periodic_mutex, "ehci_periodic_mutex") == UX_SUCCESS);
+    UX_TEST_ASSERT(_ux_hcd_ehci_periodic_tree_create(&test_hcd_ehci) == UX_SUCCESS);
+
+    test_hcd.ux_hcd_controller_hardware = &test_hcd_ehci;
+    test_hcd.ux_hcd_entry_function = _ux_hcd_ehci_entry;
+    test_hcd.ux_hcd_status = UX_HCD_STATUS_OPERATIONAL;
+}
+
+static UX_EHCI_ED *_ux_test_ehci_anchor_get(ULONG list_index, ULONG poll_depth)
+{
+
+UX_EHCI_PERIODIC_LINK_POINTER   lp;
+
+    /* Get the static anchor of the frame list entry at the poll depth.  */
+    lp.ed_ptr = test_hcd_ehci.ux_hcd_ehci_frame_list[list_index];
+    lp.value &= UX_EHCI_LINK_ADDRESS_MASK;
+    lp.void_ptr = _ux_utility_virtual_address(lp.void_ptr);
+    return(_ux_hcd_ehci_poll_rate_entry_get(&test_hcd_ehci, lp.ed_ptr, poll_depth));
+}
+
+static VOID _ux_test_ohci_initialize(VOID)
+{
+
+ULONG           i;
+
+    /* Build the free lists and periodic tree of an OHCI controller, as its
+       initialization does.  */
+    ux_utility_memory_set(&test_hcd_ohci, 0, sizeof(test_hcd_ohci));
+    test_hcd_ohci.ux_hcd_ohci_hcca = _ux_utility_memory_allocate(UX_ALIGN_256, UX_CACHE_SAFE_MEMORY, sizeof(UX_HCD_OHCI_HCCA));
+    UX_TEST_ASSERT(test_hcd_ohci.ux_hcd_ohci_hcca != UX_NULL);
+    test_hcd_ohci.ux_hcd_ohci_ed_list = _ux_utility_memory_allocate(UX_ALIGN_16, UX_CACHE_SAFE_MEMORY, sizeof(UX_OHCI_ED) * _ux_system_host -> ux_system_host_max_ed);
+    UX_TEST_ASSERT(test_hcd_ohci.ux_hcd_ohci_ed_list != UX_NULL);
+    test_hcd_ohci.ux_hcd_ohci_td_list = _ux_utility_memory_allocate(UX_ALIGN_32, UX_CACHE_SAFE_MEMORY, sizeof(UX_OHCI_TD) * _ux_system_host -> ux_system_host_max_td);
+    UX_TEST_ASSERT(test_hcd_ohci.ux_hcd_ohci_td_list != UX_NULL);
+    for (i = _ux_system_host -> ux_system_host_max_ed; i > 0; i --)
+    {
+        test_hcd_ohci.ux_hcd_ohci_ed_list[i - 1].ux_ohci_ed_previous_ed = test_hcd_ohci.ux_hcd_ohci_ed_free_list;
+        test_hcd_ohci.ux_hcd_ohci_ed_free_list = &test_hcd_ohci.ux_hcd_ohci_ed_list[i - 1];
+    }
+    for (i = _ux_system_host -> ux_system_host_max_td; i > 0; i --)
+    {
+        test_hcd_ohci.ux_hcd_ohci_td_list[i - 1].ux_ohci_td_next_free = test_hcd_ohci.ux_hcd_ohci_td_free_list;
+        test_hcd_ohci.ux_hcd_ohci_td_free_list = &test_hcd_ohci.ux_hcd_ohci_td_list[i - 1];
+    }
+    UX_TEST_ASSERT(_ux_hcd_ohci_periodic_tree_create(&test_hcd_ohci) == UX_SUCCESS);
+
+    test_hcd.ux_hcd_controller_hardware = &test_hcd_ohci;
+    test_hcd.ux_hcd_entry_function = _ux_hcd_ohci_entry;
+    test_hcd.ux_hcd_status = UX_HCD_STATUS_OPERATIONAL;
+}
+
+static UX_OHCI_ED *_ux_test_ohci_anchor_get(ULONG list_index, ULONG poll_depth)
+{
+
+UX_OHCI_ED      *ed;
+
+    /* Get the static anchor of the HCCA list at the poll depth.  */
+    ed = _ux_utility_virtual_address(test_hcd_ohci.ux_hcd_ohci_hcca -> ux_hcd_ohci_hcca_ed[list_index]);
+    while (poll_depth --)
+    {
+        ed = _ux_utility_virtual_address(ed -> ux_ohci_ed_next_ed);
+        while (!(ed -> ux_ohci_ed_dw0 & UX_OHCI_ED_SKIP))
+            ed = _ux_utility_virtual_address(ed -> ux_ohci_ed_next_ed);
+    }
+    return(ed);
+}
+#endif
+
+
+/* Define what the initial system looks like.  */
+
+#ifdef CTEST
+void test_application_define(void *first_unused_memory)
+#else
+void    usbx_ux_host_stack_periodic_schedule_test_application_define(void *first_unused_memory)
+#endif
+{
+
+UINT status;
+CHAR                            *stack_pointer;
+CHAR                            *memory_pointer;
+
+    /* Inform user.  */
+    printf("Running Periodic Schedule Test...................................... ");
+#if !defined(UX_HOST_PERIODIC_SCHEDULE_ENABLE)
+    printf("SKIP SUCCESS!\n");
+    test_control_return(0);
+    return;
+#endif
+
+    /* Initialize the free memory pointer.  */
+    stack_pointer = (CHAR *) first_unused_memory;
+    memory_pointer = stack_pointer + (UX_TEST_STACK_SIZE * 2);
+
+    /* Initialize USBX Memory.  */
+    status =  ux_system_initialize(memory_pointer, UX_TEST_MEMORY_SIZE, UX_NULL, 0);
+
+    /* Check for error.  */
+    if (status != UX_SUCCESS)
+    {
+
+        printf("ERROR #%d\n", __LINE__);
+        test_control_return(1);
+    }
+
+    /* Register the error callback. */
+    _ux_utility_error_callback_register(error_callback);
+
+    /* The code below is required for installing the host portion of USBX.  */
+    status =  ux_host_stack_initialize(UX_NULL);
+
+    /* Check for error.  */
+    if (status != UX_SUCCESS)
+    {
+
+        printf("ERROR #%d\n", __LINE__);
+        test_control_return(1);
+    }
+
+    /* Create the simulation thread.  */
+    status =  tx_thread_create(&ux_test_thread_simulation_0, "test simulation", ux_test_thread_simulation_0_entry, 0,
+            stack_pointer, UX_TEST_STACK_SIZE,
+            20, 20, 1, TX_AUTO_START);
+
+    /* Check for error.  */
+    if (status != TX_SUCCESS)
+    {
+
+        printf("ERROR #%d\n", __LINE__);
+        test_control_return(1);
+    }
+}
+
+static void  ux_test_thread_simulation_0_entry(ULONG arg)
+{
+#if defined(UX_HOST_PERIODIC_SCHEDULE_ENABLE)
+ULONG           i;
+UINT            status;
+USHORT          load;
+UX_EHCI_ED      *ehci_ed;
+UX_OHCI_ED      *ohci_ed;
+
+
+    /* High speed interrupt endpoints of 1024 bytes polled every 8 microframes:
+       4 fit in a microframe, so 32 fit in the 8 microframes of their period.  */
+    _ux_test_schedule_reset(0x200, UX_HIGH_SPEED_DEVICE);
+    for (i = 0; i < UX_TEST_ENDPOINTS; i ++)
+        _ux_test_endpoint_init(&test_endpoints[i], UX_INTERRUPT_ENDPOINT, 1024, 4);
+
+    /* The load is spread over the microframes.  */
+    for (i = 0; i < 8; i ++)
+    {
+        status = _ux_test_endpoint_add(&test_endpoints[i]);
+        UX_TEST_ASSERT(status == UX_SUCCESS);
+        UX_TEST_ASSERT(test_endpoints[i].ux_endpoint_schedule_period == 8);
+        UX_TEST_ASSERT(test_endpoints[i].ux_endpoint_schedule_offset == i);
+    }
+    load = test_endpoints[0].ux_endpoint_schedule_load;
+    for (i = 0; i < UX_HOST_PERIODIC_SLOTS; i ++)
+        UX_TEST_ASSERT(test_hcd.ux_hcd_periodic_load[i] == load);
+
+    /* Fill the schedule, then the next endpoint does not fit.  */
+    for (i = 8; i < UX_TEST_ENDPOINTS - 1; i ++)
+    {
+        status = _ux_test_endpoint_add(&test_endpoints[i]);
+        UX_TEST_ASSERT(status == UX_SUCCESS);
+    }
+    bandwidth_error_counter = 0;
+    status = _ux_test_endpoint_add(&test_endpoints[UX_TEST_ENDPOINTS - 1]);
+    UX_TEST_ASSERT(status == UX_NO_BANDWIDTH_AVAILABLE);
+    UX_TEST_ASSERT(bandwidth_error_counter == 1);
+
+    /* An endpoint not claimed is not released.  */
+    _ux_host_stack_bandwidth_release(&test_hcd, &test_endpoints[UX_TEST_ENDPOINTS - 1]);
+    UX_TEST_ASSERT(test_hcd.ux_hcd_periodic_load[0] == load * 4);
+
+    /* Releasing an endpoint frees its slots for the next one.  */
+    _ux_host_stack_bandwidth_release(&test_hcd, &test_endpoints[5]);
+    UX_TEST_ASSERT(test_hcd.ux_hcd_periodic_load[5] == load * 3);
+    status = _ux_test_endpoint_add(&test_endpoints[UX_TEST_ENDPOINTS - 1]);
+    UX_TEST_ASSERT(status == UX_SUCCESS);
+    UX_TEST_ASSERT(test_endpoints[UX_TEST_ENDPOINTS - 1].ux_endpoint_schedule_offset == 5);
+
+    /* Release all, the schedule is empty.  */
+    for (i = 0; i < UX_TEST_ENDPOINTS; i ++)
+        _ux_host_stack_bandwidth_release(&test_hcd, &test_endpoints[i]);
+    for (i = 0; i < UX_HOST_PERIODIC_SLOTS; i ++)
+        UX_TEST_ASSERT(test_hcd.ux_hcd_periodic_load[i] == 0);
+
+    /* Full speed interrupt endpoints behind a high speed hub, polled every 2 frames.
+       The TT has room for one endpoint per frame: even frames then odd frames.  */
+    _ux_test_schedule_reset(0x200, UX_FULL_SPEED_DEVICE);
+    test_hub.ux_device_speed = UX_HIGH_SPEED_DEVICE;
+    test_hub.ux_device_hub_tt[0].ux_hub_tt_port_mapping = UX_TT_MASK;
+    test_hub.ux_device_hub_tt[0].ux_hub_tt_max_bandwidth = 100;
+    test_device.ux_device_parent = &test_hub;
+    test_device.ux_device_port_location = 1;
+    for (i = 0; i < 3; i ++)
+        _ux_test_endpoint_init(&test_endpoints[i], UX_INTERRUPT_ENDPOINT, 64, 2);
+
+    status = _ux_test_endpoint_add(&test_endpoints[0]);
+    UX_TEST_ASSERT(status == UX_SUCCESS);
+    UX_TEST_ASSERT(test_endpoints[0].ux_endpoint_schedule_tt == &test_hub.ux_device_hub_tt[0]);
+    UX_TEST_ASSERT(test_endpoints[0].ux_endpoint_schedule_period == 16);
+    UX_TEST_ASSERT(test_endpoints[0].ux_endpoint_schedule_offset == 0);
+    status = _ux_test_endpoint_add(&test_endpoints[1]);
+    UX_TEST_ASSERT(status == UX_SUCCESS);
+    UX_TEST_ASSERT(test_endpoints[1].ux_endpoint_schedule_offset == 8);
+    for (i = 0; i < UX_HOST_PERIODIC_TT_FRAMES; i ++)
+        UX_TEST_ASSERT(test_hub.ux_device_hub_tt[0].ux_hub_tt_periodic_load[i] == test_endpoints[0].ux_endpoint_schedule_tt_load);
+    bandwidth_error_counter = 0;
+    status = _ux_test_endpoint_add(&test_endpoints[2]);
+    UX_TEST_ASSERT(status == UX_NO_BANDWIDTH_AVAILABLE);
+    UX_TEST_ASSERT(bandwidth_error_counter == 1);
+
+    /* Start splits are in the first microframes of the frame.  */
+    test_hub.ux_device_hub_tt[0].ux_hub_tt_max_bandwidth = UX_TT_BANDWIDTH;
+    for (i = 2; i < 8; i ++)
+    {
+        _ux_test_endpoint_init(&test_endpoints[i], UX_INTERRUPT_ENDPOINT, 64, 2);
+        status = _ux_test_endpoint_add(&test_endpoints[i]);
+        UX_TEST_ASSERT(status == UX_SUCCESS);
+        UX_TEST_ASSERT((test_endpoints[i].ux_endpoint_schedule_offset & 7) < UX_HOST_PERIODIC_SPLIT_MICROFRAMES);
+    }
+
+    /* A port without TT refuses the endpoint.  */
+    test_hub.ux_device_hub_tt[0].ux_hub_tt_port_mapping = 0;
+    _ux_test_endpoint_init(&test_endpoints[8], UX_INTERRUPT_ENDPOINT, 64, 2);
+    bandwidth_error_counter = 0;
+    status = _ux_test_endpoint_add(&test_endpoints[8]);
+    UX_TEST_ASSERT(status == UX_NO_BANDWIDTH_AVAILABLE);
+    UX_TEST_ASSERT(bandwidth_error_counter == 1);
+
+    /* Full speed isochronous endpoints on a 1.1 bus are serviced in every frame,
+       whatever their interval: one fits on the bus.  */
+    _ux_test_schedule_reset(0x110, UX_FULL_SPEED_DEVICE);
+    for (i = 0; i < 2; i ++)
+        _ux_test_endpoint_init(&test_endpoints[i], UX_ISOCHRONOUS_ENDPOINT, 512, 2);
+    status = _ux_test_endpoint_add(&test_endpoints[0]);
+    UX_TEST_ASSERT(status == UX_SUCCESS);
+    UX_TEST_ASSERT(test_endpoints[0].ux_endpoint_schedule_period == 8);
+    UX_TEST_ASSERT(test_endpoints[0].ux_endpoint_schedule_offset == 0);
+    bandwidth_error_counter = 0;
+    status = _ux_test_endpoint_add(&test_endpoints[1]);
+    UX_TEST_ASSERT(status == UX_NO_BANDWIDTH_AVAILABLE);
+    UX_TEST_ASSERT(bandwidth_error_counter == 1);
+
+    /* Endpoints polled less often than the periodic trees of the controllers are
+       scheduled every 32 frames.  */
+    _ux_test_schedule_reset(0x200, UX_HIGH_SPEED_DEVICE);
+    _ux_test_endpoint_init(&test_endpoints[0], UX_INTERRUPT_ENDPOINT, 64, 16);
+    status = _ux_test_endpoint_add(&test_endpoints[0]);
+    UX_TEST_ASSERT(status == UX_SUCCESS);
+    UX_TEST_ASSERT(test_endpoints[0].ux_endpoint_schedule_period == UX_HOST_PERIODIC_TREE_FRAMES * 8);
+
+    /* High speed interrupt endpoints polled every 8 frames, with 3 transactions of 1024
+       bytes: one fits in a microframe. The second endpoint competes for the slot of the
+       first one and is placed in the next microframe of the same frame. EHCI links both
+       in the 8ms anchor of frame 0, with the start microframe of their slot.  */
+    _ux_test_schedule_reset(0x200, UX_HIGH_SPEED_DEVICE);
+    _ux_test_ehci_initialize();
+    for (i = 0; i < 2; i ++)
+    {
+        _ux_test_endpoint_init(&test_endpoints[i], UX_INTERRUPT_ENDPOINT, 0x1400, 7);
+        status = _ux_test_endpoint_add(&test_endpoints[i]);
+        UX_TEST_ASSERT(status == UX_SUCCESS);
+        UX_TEST_ASSERT(test_endpoints[i].ux_endpoint_schedule_period == 64);
+        UX_TEST_ASSERT(test_endpoints[i].ux_endpoint_schedule_offset == i);
+        ehci_ed = (UX_EHCI_ED *)test_endpoints[i].ux_endpoint_ed;
+        UX_TEST_ASSERT(ehci_ed -> REF_AS.INTR.ux_ehci_ed_anchor == _ux_test_ehci_anchor_get(0, 2));
+        UX_TEST_ASSERT((ehci_ed -> ux_ehci_ed_cap1 & UX_EHCI_SMASK_MASK) == (UX_EHCI_SMASK_0 << i));
+    }
+
+    /* Full speed interrupt endpoints polled every 8 frames on a 1.1 bus: one fits in a
+       frame. The second endpoint competes for the slot of the first one and is placed in
+       the next frame. OHCI links each in the 8ms anchor of its frame.  */
+    _ux_test_schedule_reset(0x110, UX_FULL_SPEED_DEVICE);
+    test_hcd.ux_hcd_available_bandwidth = 500;
+    _ux_test_ohci_initialize();
+    for (i = 0; i < 2; i ++)
+    {
+        _ux_test_endpoint_init(&test_endpoints[i], UX_INTERRUPT_ENDPOINT, 64, 8);
+        status = _ux_test_endpoint_add(&test_endpoints[i]);
+        UX_TEST_ASSERT(status == UX_SUCCESS);
+        UX_TEST_ASSERT(test_endpoints[i].ux_endpoint_schedule_period == 64);
+        UX_TEST_ASSERT(test_endpoints[i].ux_endpoint_schedule_offset == i * 8);
+        ohci_ed = (UX_OHCI_ED *)test_endpoints[i].ux_endpoint_ed;
+        UX_TEST_ASSERT(ohci_ed -> ux_ohci_ed_previous_ed == _ux_test_ohci_anchor_get(i, 2));
+    }
+    _ux_test_endpoint_init(&test_endpoints[2], UX_INTERRUPT_ENDPOINT, 64, 1);
+    bandwidth_error_counter = 0;
+    status = _ux_test_endpoint_add(&test_endpoints[2]);
+    UX_TEST_ASSERT(status == UX_NO_BANDWIDTH_AVAILABLE);
+    UX_TEST_ASSERT(bandwidth_error_counter == 1);
+#endif
+
+    /* Sleep for a tick to make sure everything is complete.  */
+    tx_thread_sleep(1);
+
+    /* Check for errors from other threads.  */
+    if (error_counter)
+    {
+
+        /* Test error.  */
+        printf("ERROR #%d: total %ld errors\n", __LINE__, error_counter);
+        test_control_return(1);
+    }
+    else
+    {
+
+        /* Successful test.  */
+        printf("SUCCESS!\n");
+        test_control_return(0);
+    }
+}
@@ -0,0 +1,354 @@
+/* This test is designed to test the ux_host_stack_transfer_submit and
+   ux_host_stack_transfer_batch_submit asynchronous transfer APIs.  */
+
+#include <stdio.h>
+#include "tx_api.h"
+#include "ux_api.h"
+#include "ux_system.h"
+#include "ux_utility.h"
+#include "ux_host_stack.h"
+
+#include "ux_test.h"
+
+
+/* Define USBX test constants.  */
+
+#define UX_TEST_STACK_SIZE      4096
+#define UX_TEST_MEMORY_SIZE     (64*1024)
+
+#define UX_TEST_ENDPOINTS       4
+#define UX_TEST_ROUNDS          16
+#define UX_TEST_LENGTH          64
+
+
+/* Define the counters used in the test application...  */
+
+static ULONG                           error_counter;
+
+static UCHAR                           error_callback_ignore = UX_FALSE;
+static ULONG                           error_callback_counter;
+
+/* Define the fake device, endpoints and transfers.  */
+
+static UX_DEVICE                       test_device;
+static UX_ENDPOINT                     test_endpoints[UX_TEST_ENDPOINTS];
+static UX_TRANSFER                     *test_transfers[UX_TEST_ENDPOINTS];
+static UCHAR                           test_buffers[UX_TEST_ENDPOINTS][UX_TEST_LENGTH];
+
+/* Transfers started on the fake HCD and not completed yet.  */
+
+static UX_TRANSFER                     *test_hcd_pending[UX_TEST_ENDPOINTS * 2];
+static ULONG                           test_hcd_pending_count;
+static ULONG                           test_hcd_request_count;
+
+static ULONG                           test_callback_count[UX_TEST_ENDPOINTS];
+static ULONG                           test_other_callback_count;
+static ULONG                           test_resubmit_count;
+
+
+/* Define prototypes for external Host Controller's (HCDs), classes and clients.  */
+
+static TX_THREAD           ux_test_thread_simulation_0;
+static void                ux_test_thread_simulation_0_entry(ULONG);
+
+
+/* Prototype for test control return.  */
+
+void  test_control_return(UINT status);
+
+
+static VOID error_callback(UINT system_level, UINT system_context, UINT error_code)
+{
+
+    error_callback_counter ++;
+
+    if (!error_callback_ignore)
+    {
+        {
+            /* Failed test.  */
+            printf("Error #%d, system_level: %d, system_context: %d, error_code: 0x%x\n", __LINE__, system_level, system_context, error_code);
+            // test_control_return(1);
+        }
+    }
+}
+
+static VOID test_transfer_complete(UX_TRANSFER *transfer_request)
+{
+
+    /* What the HCD does when the transfer is done.  */
+    transfer_request -> ux_transfer_request_actual_length = transfer_request -> ux_transfer_request_requested_length;
+    transfer_request -> ux_transfer_request_completion_code = UX_SUCCESS;
+    if (transfer_request -> ux_transfer_request_completion_function)
+        transfer_request -> ux_transfer_request_completion_function(transfer_request);
+    _ux_host_semaphore_put(&transfer_request -> ux_transfer_request_semaphore);
+}
+
+static UINT test_hcd_entry(UX_HCD *hcd, UINT function, VOID *parameter)
+{
+
+    UX_PARAMETER_NOT_USED(hcd);
+
+    if (function == UX_HCD_TRANSFER_REQUEST)
+    {
+        test_hcd_request_count ++;
+#if defined(UX_HOST_STANDALONE)
+
+        /* Transfer is done in run.  */
+        test_transfer_complete((UX_TRANSFER *)parameter);
+        return(UX_STATE_NEXT);
+#else
+
+        /* Transfer is started, it's done later in HCD thread.  */
+        test_hcd_pending[test_hcd_pending_count ++] = (UX_TRANSFER *)parameter;
+#endif
+    }
+    return(UX_SUCCESS);
+}
+
+static VOID test_hcd_done_process(VOID)
+{
+ULONG           i;
+
+    for (i = 0; i < test_hcd_pending_count; i ++)
+        test_transfer_complete(test_hcd_pending[i]);
+    test_hcd_pending_count = 0;
+}
+
+static VOID test_callback(UX_TRANSFER *transfer_request)
+{
+ULONG           i;
+
+    for (i = 0; i < UX_TEST_ENDPOINTS; i ++)
+    {
+        if (transfer_request == test_transfers[i])
+        {
+            UX_TEST_ASSERT(transfer_request -> ux_transfer_request_completion_code == UX_SUCCESS);
+            UX_TEST_ASSERT(transfer_request -> ux_transfer_request_actual_length == UX_TEST_LENGTH);
+            test_callback_count[i] ++;
+            return;
+        }
+    }
+    UX_TEST_ASSERT(0);
+}
+
+static VOID test_other_callback(UX_TRANSFER *transfer_request)
+{
+
+    UX_PARAMETER_NOT_USED(transfer_request);
+    test_other_callback_count ++;
+}
+
+static VOID test_resubmit_callback(UX_TRANSFER *transfer_request)
+{
+UINT            status;
+
+    /* Submit again from the callback, before the HCD puts the semaphore.  */
+    test_resubmit_count ++;
+    if (test_resubmit_count < 2)
+    {
+        status = _ux_host_stack_transfer_submit(transfer_request, test_resubmit_callback);
+        UX_TEST_ASSERT(status == UX_SUCCESS);
+    }
+}
+
+
+/* Define what the initial system looks like.  */
+
+#ifdef CTEST
+void test_application_define(void *first_unused_memory)
+#else
+void    usbx_ux_host_stack_transfer_submit_test_application_define(void *first_unused_memory)
+#endif
+{
+
+UINT status;
+CHAR                            *stack_pointer;
+CHAR                            *memory_pointer;
+
+    /* Inform user.  */
+    printf("Running ux_host_stack_transfer_submit Test.......................... ");
+
+    /* Initialize the free memory pointer.  */
+    stack_pointer = (CHAR *) first_unused_memory;
+    memory_pointer = stack_pointer + (UX_TEST_STACK_SIZE * 2);
+
+    /* Initialize USBX Memory.  */
+    status =  ux_system_initialize(memory_pointer, UX_TEST_MEMORY_SIZE, UX_NULL, 0);
+
+    /* Check for error.  */
+    if (status != UX_SUCCESS)
+    {
+
+        printf("ERROR #%d\n", __LINE__);
+        test_control_return(1);
+    }
+
+    /* Register the error callback. */
+    _ux_utility_error_callback_register(error_callback);
+
+    /* The code below is required for installing the host portion of USBX.  */
+    status =  ux_host_stack_initialize(UX_NULL);
+
+    /* Check for error.  */
+    if (status != UX_SUCCESS)
+    {
+
+        printf("ERROR #%d\n", __LINE__);
+        test_control_return(1);
+    }
+
+    /* Create the simulation thread.  */
+    status =  tx_thread_create(&ux_test_thread_simulation_0, "test simulation", ux_test_thread_simulation_0_entry, 0,
+            stack_pointer, UX_TEST_STACK_SIZE,
+            20, 20, 1, TX_AUTO_START);
+
+    /* Check for error.  */
+    if (status != TX_SUCCESS)
+    {
+
+        printf("ERROR #%d\n", __LINE__);
+        test_control_return(1);
+    }
+}
+
+static void  ux_test_thread_simulation_0_entry(ULONG arg)
+{
+UX_HCD          *hcd;
+UX_TRANSFER     *transfer_request;
+ULONG           actual_count;
+ULONG           round;
+ULONG           i;
+UINT            status;
+
+
+    /* Fake HCD completes transfers on request.  */
+    hcd = &_ux_system_host -> ux_system_host_hcd_array[0];
+    hcd -> ux_hcd_entry_function = test_hcd_entry;
+
+    /* Fake configured device with bulk IN endpoints.  */
+    test_device.ux_device_state = UX_DEVICE_CONFIGURED;
+    UX_DEVICE_HCD_SET(&test_device, hcd);
+    for (i = 0; i < UX_TEST_ENDPOINTS; i ++)
+    {
+        test_endpoints[i].ux_endpoint_device = &test_device;
+        test_endpoints[i].ux_endpoint_descriptor.bEndpointAddress = (UCHAR)(0x81 + i);
+        test_endpoints[i].ux_endpoint_descriptor.bmAttributes = UX_BULK_ENDPOINT;
+        transfer_request = &test_endpoints[i].ux_endpoint_transfer_request;
+        transfer_request -> ux_transfer_request_endpoint = &test_endpoints[i];
+        transfer_request -> ux_transfer_request_type = UX_REQUEST_IN;
+        transfer_request -> ux_transfer_request_data_pointer = test_buffers[i];
+        transfer_request -> ux_transfer_request_requested_length = UX_TEST_LENGTH;
+        transfer_request -> ux_transfer_request_timeout_value = UX_WAIT_FOREVER;
+        status = _ux_host_semaphore_create(&transfer_request -> ux_transfer_request_semaphore, "test transfer", 0);
+        UX_TEST_ASSERT(status == UX_SUCCESS);
+        test_transfers[i] = transfer_request;
+    }
+
+    /* Error checks.  */
+    status = _uxe_host_stack_transfer_submit(UX_NULL, test_callback);
+    UX_TEST_ASSERT(status == UX_INVALID_PARAMETER);
+    status = _uxe_host_stack_transfer_submit(test_transfers[0], UX_NULL);
+    UX_TEST_ASSERT(status == UX_INVALID_PARAMETER);
+    status = _uxe_host_stack_transfer_batch_submit(test_transfers, UX_TEST_ENDPOINTS, UX_NULL, &actual_count);
+    UX_TEST_ASSERT(status == UX_INVALID_PARAMETER);
+
+    /* Control transfers are not submitted asynchronously.  */
+    test_endpoints[0].ux_endpoint_descriptor.bmAttributes = UX_CONTROL_ENDPOINT;
+    status = _uxe_host_stack_transfer_submit(test_transfers[0], test_callback);
+    UX_TEST_ASSERT(status == UX_FUNCTION_NOT_SUPPORTED);
+    status = _uxe_host_stack_transfer_batch_submit(test_transfers, UX_TEST_ENDPOINTS, test_callback, &actual_count);
+    UX_TEST_ASSERT(status == UX_FUNCTION_NOT_SUPPORTED);
+    test_endpoints[0].ux_endpoint_descriptor.bmAttributes = UX_BULK_ENDPOINT;
+    UX_TEST_ASSERT(test_hcd_request_count == 0);
+
+    /* All endpoints are driven from this thread, completions come as callbacks.  */
+    for (round = 0; round < UX_TEST_ROUNDS; round ++)
+    {
+        actual_count = 0;
+        status = _uxe_host_stack_transfer_batch_submit(test_transfers, UX_TEST_ENDPOINTS, test_callback, &actual_count);
+        UX_TEST_ASSERT(status == UX_SUCCESS);
+        UX_TEST_ASSERT(actual_count == UX_TEST_ENDPOINTS);
+        test_hcd_done_process();
+        for (i = 0; i < UX_TEST_ENDPOINTS; i ++)
+            UX_TEST_ASSERT(test_callback_count[i] == round + 1);
+    }
+    UX_TEST_ASSERT(test_hcd_request_count == UX_TEST_ROUNDS * UX_TEST_ENDPOINTS);
+
+#if !defined(UX_HOST_STANDALONE)
+
+    /* Semaphore counts do not grow with asynchronous use.  */
+    for (i = 0; i < UX_TEST_ENDPOINTS; i ++)
+        UX_TEST_ASSERT(test_transfers[i] -> ux_transfer_request_semaphore.tx_semaphore_count <= 1);
+
+    /* Transfer used asynchronously can still be waited for.  */
+    status = _ux_host_stack_transfer_submit(test_transfers[0], test_callback);
+    UX_TEST_ASSERT(status == UX_SUCCESS);
+    test_transfers[0] -> ux_transfer_request_completion_function = UX_NULL;
+    test_hcd_done_process();
+    status = _ux_host_semaphore_get(&test_transfers[0] -> ux_transfer_request_semaphore, UX_NO_WAIT);
+    UX_TEST_ASSERT(status == UX_SUCCESS);
+    status = _ux_host_semaphore_get(&test_transfers[0] -> ux_transfer_request_semaphore, UX_NO_WAIT);
+    UX_TEST_ASSERT(status != UX_SUCCESS);
+
+    /* Transfer submitted again from its callback can still be waited for.  */
+    status = _ux_host_stack_transfer_submit(test_transfers[0], test_resubmit_callback);
+    UX_TEST_ASSERT(status == UX_SUCCESS);
+    test_hcd_done_process();
+    UX_TEST_ASSERT(test_resubmit_count == 2);
+    test_transfers[0] -> ux_transfer_request_completion_function = UX_NULL;
+    status = _ux_host_stack_transfer_request(test_transfers[0]);
+    UX_TEST_ASSERT(status == UX_SUCCESS);
+    status = _ux_host_semaphore_get(&test_transfers[0] -> ux_transfer_request_semaphore, UX_NO_WAIT);
+    UX_TEST_ASSERT(status != UX_SUCCESS);
+    test_hcd_done_process();
+    status = _ux_host_semaphore_get(&test_transfers[0] -> ux_transfer_request_semaphore, UX_NO_WAIT);
+    UX_TEST_ASSERT(status == UX_SUCCESS);
+#else
+
+    /* Wait flag is kept after an asynchronous submit.  */
+    test_transfers[0] -> ux_transfer_request_flags |= UX_TRANSFER_FLAG_AUTO_WAIT;
+    status = _ux_host_stack_transfer_submit(test_transfers[0], test_callback);
+    UX_TEST_ASSERT(status == UX_SUCCESS);
+    UX_TEST_ASSERT(test_transfers[0] -> ux_transfer_request_flags & UX_TRANSFER_FLAG_AUTO_WAIT);
+    test_transfers[0] -> ux_transfer_request_flags &= ~UX_TRANSFER_FLAG_AUTO_WAIT;
+#endif
+
+    /* Batch without callback keeps each request callback.  */
+    test_transfers[0] -> ux_transfer_request_completion_function = test_other_callback;
+    test_transfers[1] -> ux_transfer_request_completion_function = test_other_callback;
+    status = _uxe_host_stack_transfer_batch_submit(test_transfers, 2, UX_NULL, &actual_count);
+    UX_TEST_ASSERT(status == UX_SUCCESS);
+    UX_TEST_ASSERT(actual_count == 2);
+    test_hcd_done_process();
+    UX_TEST_ASSERT(test_other_callback_count == 2);
+
+    /* Batch stops on the first request not started.  */
+    test_hcd_request_count = 0;
+    test_device.ux_device_state = UX_DEVICE_RESET;
+    error_callback_ignore = UX_TRUE;
+    status = _ux_host_stack_transfer_batch_submit(test_transfers, UX_TEST_ENDPOINTS, test_callback, &actual_count);
+    error_callback_ignore = UX_FALSE;
+    UX_TEST_ASSERT(status == UX_TRANSFER_NOT_READY);
+    UX_TEST_ASSERT(actual_count == 0);
+    UX_TEST_ASSERT(test_hcd_request_count == 0);
+    test_device.ux_device_state = UX_DEVICE_CONFIGURED;
+
+    /* Sleep for a tick to make sure everything is complete.  */
+    tx_thread_sleep(1);
+
+    /* Check for errors from other threads.  */
+    if (error_counter)
+    {
+
+        /* Test error.  */
+        printf("ERROR #%d: total %ld errors\n", __LINE__, error_counter);
+        test_control_return(1);
+    }
+    else
+    {
+
+        /* Successful test.  */
+        printf("SUCCESS!\n");
+        test_control_return(0);
+    }
+}
@@ -0,0 +1,317 @@
+/* This test is designed to report the size and field offsets of UX_TRANSFER and UX_SLAVE_TRANSFER,
+   and to measure the cost of transfer completions on many requests, with default layout
+   or with hot fields grouped by UX_ENABLE_TRANSFER_HOT_LAYOUT.  */
+
+#include <stdio.h>
+#include <stddef.h>
+#include <time.h>
+#include "tx_api.h"
+#include "ux_api.h"
+#include "ux_system.h"
+#include "ux_utility.h"
+
+#include "ux_test.h"
+
+
+/* Define USBX test constants.  */
+
+#define UX_TEST_STACK_SIZE      4096
+#define UX_TEST_MEMORY_SIZE     (64*1024)
+
+#define UX_TEST_CACHE_LINE      32
+#define UX_TEST_REQUESTS        4096
+#define UX_TEST_BENCH_LOOPS     200
+
+
+/* Define the counters used in the test application...  */
+
+static ULONG                           error_counter;
+
+static UX_TRANSFER                     test_transfers[UX_TEST_REQUESTS];
+static UX_SLAVE_TRANSFER               test_slave_transfers[UX_TEST_REQUESTS];
+static ULONG                           test_completions;
+
+
+/* Define prototypes for external Host Controller's (HCDs), classes and clients.  */
+
+static TX_THREAD           ux_test_thread_simulation_0;
+static void                ux_test_thread_simulation_0_entry(ULONG);
+
+
+/* Prototype for test control return.  */
+
+void  test_control_return(UINT status);
+
+
+/* Define what the initial system looks like.  */
+
+#ifdef CTEST
+void test_application_define(void *first_unused_memory)
+#else
+void    usbx_ux_transfer_layout_test_application_define(void *first_unused_memory)
+#endif
+{
+
+UINT status;
+CHAR                            *stack_pointer;
+CHAR                            *memory_pointer;
+
+    /* Inform user.  */
+    printf("Running ux_transfer layout Test..................................... ");
+
+    /* Initialize the free memory pointer.  */
+    stack_pointer = (CHAR *) first_unused_memory;
+    memory_pointer = stack_pointer + (UX_TEST_STACK_SIZE * 2);
+
+    /* Initialize USBX Memory.  */
+    status =  ux_system_initialize(memory_pointer, UX_TEST_MEMORY_SIZE, UX_NULL, 0);
+
+    /* Check for error.  */
+    if (status != UX_SUCCESS)
+    {
+
+        printf("ERROR #%d\n", __LINE__);
+        test_control_return(1);
+    }
+
+    /* Create the simulation thread.  */
+    status =  tx_thread_create(&ux_test_thread_simulation_0, "test simulation", ux_test_thread_simulation_0_entry, 0,
+            stack_pointer, UX_TEST_STACK_SIZE,
+            20, 20, 1, TX_AUTO_START);
+
+    /* Check for error.  */
+    if (status != TX_SUCCESS)
+    {
+
+        printf("ERROR #%d\n", __LINE__);
+        test_control_return(1);
+    }
+}
+
+#define UX_TEST_FIELD_REPORT(type, field)                                                   \
+    printf("\n  %-48s %3ld %3ld", #field, (long)offsetof(type, field), (long)sizeof(((type *)0) -> field))
+#define UX_TEST_FIELD_END(type, field)          (offsetof(type, field) + sizeof(((type *)0) -> field))
+#define UX_TEST_FIELD_LINE(type, field)         (offsetof(type, field) / UX_TEST_CACHE_LINE)
+
+static ULONG test_lines(ULONG *lines, ULONG n)
+{
+ULONG   mask = 0;
+ULONG   count = 0;
+
+    /* Count distinct cache lines.  */
+    while(n --)
+        mask |= 1ul << (lines[n] & 31);
+    while(mask)
+    {
+        count += mask & 1;
+        mask >>= 1;
+    }
+    return(count);
+}
+
+static VOID test_transfer_completion(UX_TRANSFER *transfer_request)
+{
+    test_completions ++;
+}
+
+static VOID test_slave_transfer_completion(UX_SLAVE_TRANSFER *transfer_request)
+{
+    test_completions ++;
+}
+
+static double test_host_completion_ns(void)
+{
+clock_t         start;
+ULONG           i, loop;
+UX_TRANSFER     *transfer_request;
+
+    start = clock();
+    for (loop = 0; loop < UX_TEST_BENCH_LOOPS; loop ++)
+    {
+        for (i = 0; i < UX_TEST_REQUESTS; i ++)
+        {
+
+            /* Scattered order, as completions of many endpoints are.  */
+            transfer_request = &test_transfers[(i * 1031) % UX_TEST_REQUESTS];
+
+            /* What controller driver touches on transfer done.  */
+            transfer_request -> ux_transfer_request_actual_length += transfer_request -> ux_transfer_request_packet_length;
+            if (transfer_request -> ux_transfer_request_actual_length > transfer_request -> ux_transfer_request_requested_length)
+                transfer_request -> ux_transfer_request_actual_length = 0;
+            transfer_request -> ux_transfer_request_completion_code = UX_SUCCESS;
+            transfer_request -> ux_transfer_request_status = UX_TRANSFER_STATUS_COMPLETED;
+            if (transfer_request -> ux_transfer_request_data_pointer == UX_NULL ||
+                transfer_request -> ux_transfer_request_endpoint == UX_NULL)
+                return(-1.0);
+            if (transfer_request -> ux_transfer_request_completion_function)
+                transfer_request -> ux_transfer_request_completion_function(transfer_request);
+#if defined(UX_HOST_STANDALONE)
+            transfer_request -> ux_transfer_request_state = UX_STATE_NEXT;
+#else
+            (*(volatile UCHAR *)&transfer_request -> ux_transfer_request_semaphore) ++;
+#endif
+        }
+    }
+    return((double)(clock() - start) * 1000000000.0 / CLOCKS_PER_SEC / UX_TEST_BENCH_LOOPS / UX_TEST_REQUESTS);
+}
+
+static double test_device_completion_ns(void)
+{
+clock_t             start;
+ULONG               i, loop;
+UX_SLAVE_TRANSFER   *transfer_request;
+
+    start = clock();
+    for (loop = 0; loop < UX_TEST_BENCH_LOOPS; loop ++)
+    {
+        for (i = 0; i < UX_TEST_REQUESTS; i ++)
+        {
+
+            /* Scattered order, as completions of many endpoints are.  */
+            transfer_request = &test_slave_transfers[(i * 1031) % UX_TEST_REQUESTS];
+
+            /* What controller driver touches on transfer done.  */
+            transfer_request -> ux_slave_transfer_request_current_data_pointer += transfer_request -> ux_slave_transfer_request_transfer_length;
+            transfer_request -> ux_slave_transfer_request_actual_length += transfer_request -> ux_slave_transfer_request_transfer_length;
+            transfer_request -> ux_slave_transfer_request_in_transfer_length -= transfer_request -> ux_slave_transfer_request_transfer_length;
+            if (transfer_request -> ux_slave_transfer_request_actual_length >= transfer_request -> ux_slave_transfer_request_requested_length)
+            {
+                transfer_request -> ux_slave_transfer_request_current_data_pointer = transfer_request -> ux_slave_transfer_request_data_pointer;
+                transfer_request -> ux_slave_transfer_request_actual_length = 0;
+                transfer_request -> ux_slave_transfer_request_in_transfer_length = transfer_request -> ux_slave_transfer_request_requested_length;
+            }
+            transfer_request -> ux_slave_transfer_request_completion_code = UX_SUCCESS;
+            transfer_request -> ux_slave_transfer_request_status = UX_TRANSFER_STATUS_COMPLETED;
+            if (transfer_request -> ux_slave_transfer_request_completion_function)
+                transfer_request -> ux_slave_transfer_request_completion_function(transfer_request);
+#if defined(UX_DEVICE_STANDALONE)
+            transfer_request -> ux_slave_transfer_request_state = UX_STATE_NEXT;
+#else
+            (*(volatile UCHAR *)&transfer_request -> ux_slave_transfer_request_semaphore) ++;
+#endif
+        }
+    }
+    return((double)(clock() - start) * 1000000000.0 / CLOCKS_PER_SEC / UX_TEST_BENCH_LOOPS / UX_TEST_REQUESTS);
+}
+
+static void  ux_test_thread_simulation_0_entry(ULONG arg)
+{
+ULONG                   lines[12];
+ULONG                   host_lines, device_lines;
+ULONG                   i;
+double                  host_ns, device_ns;
+
+
+    /* Size and offset report of hot fields.  */
+    printf("\n UX_TRANSFER %ld bytes", (long)sizeof(UX_TRANSFER));
+    UX_TEST_FIELD_REPORT(UX_TRANSFER, ux_transfer_request_status);
+    UX_TEST_FIELD_REPORT(UX_TRANSFER, ux_transfer_request_completion_code);
+    UX_TEST_FIELD_REPORT(UX_TRANSFER, ux_transfer_request_data_pointer);
+    UX_TEST_FIELD_REPORT(UX_TRANSFER, ux_transfer_request_requested_length);
+    UX_TEST_FIELD_REPORT(UX_TRANSFER, ux_transfer_request_actual_length);
+    UX_TEST_FIELD_REPORT(UX_TRANSFER, ux_transfer_request_packet_length);
+    UX_TEST_FIELD_REPORT(UX_TRANSFER, ux_transfer_request_endpoint);
+    UX_TEST_FIELD_REPORT(UX_TRANSFER, ux_transfer_request_completion_function);
+#if defined(UX_HOST_STANDALONE)
+    UX_TEST_FIELD_REPORT(UX_TRANSFER, ux_transfer_request_state);
+#else
+    UX_TEST_FIELD_REPORT(UX_TRANSFER, ux_transfer_request_semaphore);
+#endif
+    lines[0] = UX_TEST_FIELD_LINE(UX_TRANSFER, ux_transfer_request_status);
+    lines[1] = UX_TEST_FIELD_LINE(UX_TRANSFER, ux_transfer_request_completion_code);
+    lines[2] = UX_TEST_FIELD_LINE(UX_TRANSFER, ux_transfer_request_data_pointer);
+    lines[3] = UX_TEST_FIELD_LINE(UX_TRANSFER, ux_transfer_request_requested_length);
+    lines[4] = UX_TEST_FIELD_LINE(UX_TRANSFER, ux_transfer_request_actual_length);
+    lines[5] = UX_TEST_FIELD_LINE(UX_TRANSFER, ux_transfer_request_packet_length);
+    lines[6] = UX_TEST_FIELD_LINE(UX_TRANSFER, ux_transfer_request_endpoint);
+    lines[7] = UX_TEST_FIELD_LINE(UX_TRANSFER, ux_transfer_request_completion_function);
+#if defined(UX_HOST_STANDALONE)
+    lines[8] = UX_TEST_FIELD_LINE(UX_TRANSFER, ux_transfer_request_state);
+#else
+    lines[8] = UX_TEST_FIELD_LINE(UX_TRANSFER, ux_transfer_request_semaphore);
+#endif
+    host_lines = test_lines(lines, 9);
+
+    printf("\n UX_SLAVE_TRANSFER %ld bytes", (long)sizeof(UX_SLAVE_TRANSFER));
+    UX_TEST_FIELD_REPORT(UX_SLAVE_TRANSFER, ux_slave_transfer_request_status);
+    UX_TEST_FIELD_REPORT(UX_SLAVE_TRANSFER, ux_slave_transfer_request_completion_code);
+    UX_TEST_FIELD_REPORT(UX_SLAVE_TRANSFER, ux_slave_transfer_request_data_pointer);
+    UX_TEST_FIELD_REPORT(UX_SLAVE_TRANSFER, ux_slave_transfer_request_current_data_pointer);
+    UX_TEST_FIELD_REPORT(UX_SLAVE_TRANSFER, ux_slave_transfer_request_requested_length);
+    UX_TEST_FIELD_REPORT(UX_SLAVE_TRANSFER, ux_slave_transfer_request_actual_length);
+    UX_TEST_FIELD_REPORT(UX_SLAVE_TRANSFER, ux_slave_transfer_request_in_transfer_length);
+    UX_TEST_FIELD_REPORT(UX_SLAVE_TRANSFER, ux_slave_transfer_request_transfer_length);
+    UX_TEST_FIELD_REPORT(UX_SLAVE_TRANSFER, ux_slave_transfer_request_completion_function);
+#if defined(UX_DEVICE_STANDALONE)
+    UX_TEST_FIELD_REPORT(UX_SLAVE_TRANSFER, ux_slave_transfer_request_state);
+#else
+    UX_TEST_FIELD_REPORT(UX_SLAVE_TRANSFER, ux_slave_transfer_request_semaphore);
+#endif
+    lines[0] = UX_TEST_FIELD_LINE(UX_SLAVE_TRANSFER, ux_slave_transfer_request_status);
+    lines[1] = UX_TEST_FIELD_LINE(UX_SLAVE_TRANSFER, ux_slave_transfer_request_completion_code);
+    lines[2] = UX_TEST_FIELD_LINE(UX_SLAVE_TRANSFER, ux_slave_transfer_request_data_pointer);
+    lines[3] = UX_TEST_FIELD_LINE(UX_SLAVE_TRANSFER, ux_slave_transfer_request_current_data_pointer);
+    lines[4] = UX_TEST_FIELD_LINE(UX_SLAVE_TRANSFER, ux_slave_transfer_request_requested_length);
+    lines[5] = UX_TEST_FIELD_LINE(UX_SLAVE_TRANSFER, ux_slave_transfer_request_actual_length);
+    lines[6] = UX_TEST_FIELD_LINE(UX_SLAVE_TRANSFER, ux_slave_transfer_request_in_transfer_length);
+    lines[7] = UX_TEST_FIELD_LINE(UX_SLAVE_TRANSFER, ux_slave_transfer_request_transfer_length);
+    lines[8] = UX_TEST_FIELD_LINE(UX_SLAVE_TRANSFER, ux_slave_transfer_request_completion_function);
+#if defined(UX_DEVICE_STANDALONE)
+    lines[9] = UX_TEST_FIELD_LINE(UX_SLAVE_TRANSFER, ux_slave_transfer_request_state);
+#else
+    lines[9] = UX_TEST_FIELD_LINE(UX_SLAVE_TRANSFER, ux_slave_transfer_request_semaphore);
+#endif
+    device_lines = test_lines(lines, 10);
+    printf("\n hot fields in %ld/%ld lines of %d bytes", (long)host_lines, (long)device_lines, UX_TEST_CACHE_LINE);
+
+#if defined(UX_ENABLE_TRANSFER_HOT_LAYOUT)
+
+    /* Hot fields are grouped ahead of others.  */
+    UX_TEST_ASSERT(offsetof(UX_TRANSFER, ux_transfer_request_type) >= UX_TEST_FIELD_END(UX_TRANSFER, ux_transfer_request_completion_function));
+    UX_TEST_ASSERT(offsetof(UX_TRANSFER, ux_transfer_request_timeout_value) > offsetof(UX_TRANSFER, ux_transfer_request_type));
+    UX_TEST_ASSERT(UX_TEST_FIELD_END(UX_TRANSFER, ux_transfer_request_completion_function) <= 8 * sizeof(VOID *));
+    UX_TEST_ASSERT(offsetof(UX_SLAVE_TRANSFER, ux_slave_transfer_request_type) > offsetof(UX_SLAVE_TRANSFER, ux_slave_transfer_request_phase));
+    UX_TEST_ASSERT(UX_TEST_FIELD_END(UX_SLAVE_TRANSFER, ux_slave_transfer_request_transfer_length) <= 8 * sizeof(VOID *));
+#endif
+
+    /* Benchmark: completion of many requests.  */
+    for (i = 0; i < UX_TEST_REQUESTS; i ++)
+    {
+        test_transfers[i].ux_transfer_request_data_pointer = (UCHAR *)&test_completions;
+        test_transfers[i].ux_transfer_request_endpoint = (UX_ENDPOINT *)&test_completions;
+        test_transfers[i].ux_transfer_request_requested_length = 512;
+        test_transfers[i].ux_transfer_request_packet_length = 64;
+        test_transfers[i].ux_transfer_request_completion_function = test_transfer_completion;
+        test_slave_transfers[i].ux_slave_transfer_request_data_pointer = (UCHAR *)&test_completions;
+        test_slave_transfers[i].ux_slave_transfer_request_current_data_pointer = (UCHAR *)&test_completions;
+        test_slave_transfers[i].ux_slave_transfer_request_requested_length = 512;
+        test_slave_transfers[i].ux_slave_transfer_request_in_transfer_length = 512;
+        test_slave_transfers[i].ux_slave_transfer_request_transfer_length = 64;
+        test_slave_transfers[i].ux_slave_transfer_request_completion_function = test_slave_transfer_completion;
+    }
+    test_completions = 0;
+    host_ns = test_host_completion_ns();
+    device_ns = test_device_completion_ns();
+    UX_TEST_ASSERT(host_ns >= 0);
+    UX_TEST_ASSERT(test_completions == 2ul * UX_TEST_BENCH_LOOPS * UX_TEST_REQUESTS);
+    printf("\n completion, host %ld ns, device %ld ns ... ", (long)host_ns, (long)device_ns);
+
+    /* Sleep for a tick to make sure everything is complete.  */
+    tx_thread_sleep(1);
+
+    /* Check for errors from other threads.  */
+    if (error_counter)
+    {
+
+        /* Test error.  */
+        printf("ERROR #%d: total %ld errors\n", __LINE__, error_counter);
+        test_control_return(1);
+    }
+    else
+    {
+
+        /* Successful test.  */
+        printf("SUCCESS!\n");
+        test_control_return(0);
+    }
+}
@@ -0,0 +1,368 @@
+/* This test is designed to test transfer requests with data segments on the
+   host simulator and device simulator controllers.  */
+
+#include <stdio.h>
+#include "tx_api.h"
+#include "ux_api.h"
+#include "ux_system.h"
+#include "ux_utility.h"
+#include "ux_host_stack.h"
+#include "ux_hcd_sim_host.h"
+#include "ux_dcd_sim_slave.h"
+
+#include "ux_test.h"
+
+
+/* Define USBX test constants.  */
+
+#define UX_TEST_STACK_SIZE      4096
+#define UX_TEST_MEMORY_SIZE     (64*1024)
+
+#define UX_TEST_MAX_PACKET_SIZE 64
+#define UX_TEST_LENGTH          229
+
+
+/* Define the counters used in the test application...  */
+
+static ULONG                           error_counter;
+
+#if defined(UX_TRANSFER_SEGMENTS_ENABLE)
+
+/* Define the fake device and endpoints.  */
+
+static UX_DEVICE                       test_device;
+static UX_ENDPOINT                     test_endpoint_out;
+static UX_ENDPOINT                     test_endpoint_in;
+static UX_SLAVE_ENDPOINT               test_slave_endpoint_out;
+static UX_SLAVE_ENDPOINT               test_slave_endpoint_in;
+
+/* Host data in 3 segments, device data in 2 segments, boundaries differ.  */
+
+static UCHAR                           test_host_buffer_0[128];
+static UCHAR                           test_host_buffer_1[64];
+static UCHAR                           test_host_buffer_2[37];
+static UX_TRANSFER_SEGMENT             test_host_segments[] = {
+    {test_host_buffer_0, sizeof(test_host_buffer_0)},
+    {test_host_buffer_1, 0},
+    {test_host_buffer_1, sizeof(test_host_buffer_1)},
+    {test_host_buffer_2, sizeof(test_host_buffer_2)},
+};
+static UX_TRANSFER_SEGMENT             test_bad_segments[2];
+static UCHAR                           test_device_buffer_0[100];
+static UCHAR                           test_device_buffer_1[129];
+static UX_TRANSFER_SEGMENT             test_device_segments[] = {
+    {test_device_buffer_0, sizeof(test_device_buffer_0)},
+    {test_device_buffer_1, sizeof(test_device_buffer_1)},
+};
+#endif
+
+
+/* Define prototypes for external Host Controller's (HCDs), classes and clients.  */
+
+static TX_THREAD           ux_test_thread_simulation_0;
+static void                ux_test_thread_simulation_0_entry(ULONG);
+
+
+/* Prototype for test control return.  */
+
+void  test_control_return(UINT status);
+
+
+static VOID error_callback(UINT system_level, UINT system_context, UINT error_code)
+{
+
+    /* Failed test.  */
+    printf("Error #%d, system_level: %d, system_context: %d, error_code: 0x%x\n", __LINE__, system_level, system_context, error_code);
+    // test_control_return(1);
+}
+
+
+/* Define what the initial system looks like.  */
+
+#ifdef CTEST
+void test_application_define(void *first_unused_memory)
+#else
+void    usbx_ux_transfer_segments_test_application_define(void *first_unused_memory)
+#endif
+{
+
+UINT status;
+CHAR                            *stack_pointer;
+CHAR                            *memory_pointer;
+
+    /* Inform user.  */
+#if !defined(UX_TRANSFER_SEGMENTS_ENABLE)
+    printf("Running ux_transfer_segments Test...............................SKIP SUCCESS!\n");
+    test_control_return(0);
+    return;
+#endif
+
+    printf("Running ux_transfer_segments Test................................... ");
+
+    /* Initialize the free memory pointer.  */
+    stack_pointer = (CHAR *) first_unused_memory;
+    memory_pointer = stack_pointer + (UX_TEST_STACK_SIZE * 2);
+
+    /* Initialize USBX Memory.  */
+    status =  ux_system_initialize(memory_pointer, UX_TEST_MEMORY_SIZE, UX_NULL, 0);
+
+    /* Check for error.  */
+    if (status != UX_SUCCESS)
+    {
+
+        printf("ERROR #%d\n", __LINE__);
+        test_control_return(1);
+    }
+
+    /* Register the error callback. */
+    _ux_utility_error_callback_register(error_callback);
+
+    /* The code below is required for installing the host portion of USBX.  */
+    status =  ux_host_stack_initialize(UX_NULL);
+
+    /* Check for error.  */
+    if (status != UX_SUCCESS)
+    {
+
+        printf("ERROR #%d\n", __LINE__);
+        test_control_return(1);
+    }
+
+    /* Register HCD for simulation.  */
+    status =  ux_host_stack_hcd_register(_ux_system_host_hcd_simulator_name, _ux_hcd_sim_host_initialize, 0, 0);
+
+    /* Check for error.  */
+    if (status != UX_SUCCESS)
+    {
+
+        printf("ERROR #%d\n", __LINE__);
+        test_control_return(1);
+    }
+
+    /* Initialize the simulated device controller.  */
+    status =  _ux_dcd_sim_slave_initialize();
+
+    /* Check for error.  */
+    if (status != UX_SUCCESS)
+    {
+
+        printf("ERROR #%d\n", __LINE__);
+        test_control_return(1);
+    }
+
+    /* Create the simulation thread.  */
+    status =  tx_thread_create(&ux_test_thread_simulation_0, "test simulation", ux_test_thread_simulation_0_entry, 0,
+            stack_pointer, UX_TEST_STACK_SIZE,
+            20, 20, 1, TX_AUTO_START);
+
+    /* Check for error.  */
+    if (status != TX_SUCCESS)
+    {
+
+        printf("ERROR #%d\n", __LINE__);
+        test_control_return(1);
+    }
+}
+
+#if defined(UX_TRANSFER_SEGMENTS_ENABLE)
+static VOID test_endpoint_setup(UX_HCD_SIM_HOST *hcd_sim_host, UX_ENDPOINT *endpoint,
+                                UX_SLAVE_ENDPOINT *slave_endpoint, UCHAR address)
+{
+UX_DCD_SIM_SLAVE        *dcd_sim_slave;
+UX_DCD_SIM_SLAVE_ED     *slave_ed;
+UX_TRANSFER             *transfer_request;
+UINT                    status;
+
+    /* Host side endpoint and ED.  */
+    endpoint -> ux_endpoint_device = &test_device;
+    endpoint -> ux_endpoint_descriptor.bEndpointAddress = address;
+    endpoint -> ux_endpoint_descriptor.bmAttributes = UX_BULK_ENDPOINT;
+    endpoint -> ux_endpoint_descriptor.wMaxPacketSize = UX_TEST_MAX_PACKET_SIZE;
+    transfer_request = &endpoint -> ux_endpoint_transfer_request;
+    transfer_request -> ux_transfer_request_endpoint = endpoint;
+    transfer_request -> ux_transfer_request_type = (address & UX_ENDPOINT_DIRECTION) ? UX_REQUEST_IN : UX_REQUEST_OUT;
+    transfer_request -> ux_transfer_request_packet_length = UX_TEST_MAX_PACKET_SIZE;
+    status = _ux_hcd_sim_host_asynchronous_endpoint_create(hcd_sim_host, endpoint);
+    UX_TEST_ASSERT(status == UX_SUCCESS);
+
+    /* Device side endpoint, ready for transfer.  */
+    dcd_sim_slave = (UX_DCD_SIM_SLAVE *)_ux_system_slave -> ux_system_slave_dcd.ux_slave_dcd_controller_hardware;
+#ifdef UX_DEVICE_BIDIRECTIONAL_ENDPOINT_SUPPORT
+    slave_ed = (address & UX_ENDPOINT_DIRECTION) ?
+                &dcd_sim_slave -> ux_dcd_sim_slave_ed_in[address & ~UX_ENDPOINT_DIRECTION] :
+                &dcd_sim_slave -> ux_dcd_sim_slave_ed[address];
+#else
+    slave_ed = &dcd_sim_slave -> ux_dcd_sim_slave_ed[address & ~UX_ENDPOINT_DIRECTION];
+#endif
+    slave_ed -> ux_sim_slave_ed_status = UX_DCD_SIM_SLAVE_ED_STATUS_USED | UX_DCD_SIM_SLAVE_ED_STATUS_TRANSFER;
+    slave_ed -> ux_sim_slave_ed_index = address & ~UX_ENDPOINT_DIRECTION;
+    slave_ed -> ux_sim_slave_ed_endpoint = slave_endpoint;
+    slave_endpoint -> ux_slave_endpoint_descriptor.bEndpointAddress = address;
+    slave_endpoint -> ux_slave_endpoint_descriptor.wMaxPacketSize = UX_TEST_MAX_PACKET_SIZE;
+    slave_endpoint -> ux_slave_endpoint_transfer_request.ux_slave_transfer_request_requested_length = UX_TEST_LENGTH;
+    slave_endpoint -> ux_slave_endpoint_transfer_request.ux_slave_transfer_request_segments = test_device_segments;
+    slave_endpoint -> ux_slave_endpoint_transfer_request.ux_slave_transfer_request_segment_count =
+                                    sizeof(test_device_segments) / sizeof(test_device_segments[0]);
+}
+
+static VOID test_transfer_run(UX_HCD_SIM_HOST *hcd_sim_host, UX_ENDPOINT *endpoint)
+{
+UX_HCD_SIM_HOST_ED      *ed;
+UX_HCD_SIM_HOST_TD      *td;
+UX_TRANSFER             *transfer_request;
+ULONG                   i;
+UINT                    status;
+
+    transfer_request = &endpoint -> ux_endpoint_transfer_request;
+    transfer_request -> ux_transfer_request_requested_length = UX_TEST_LENGTH;
+    transfer_request -> ux_transfer_request_segments = test_host_segments;
+    transfer_request -> ux_transfer_request_segment_count = sizeof(test_host_segments) / sizeof(test_host_segments[0]);
+
+    status = _ux_hcd_sim_host_request_bulk_transfer(hcd_sim_host, transfer_request);
+    UX_TEST_ASSERT(status == UX_SUCCESS);
+
+    /* Each non empty segment is described by its own TD.  */
+    ed = endpoint -> ux_endpoint_ed;
+    td = ed -> ux_sim_host_ed_head_td;
+    UX_TEST_ASSERT(td -> ux_sim_host_td_buffer == test_host_buffer_0);
+    UX_TEST_ASSERT(td -> ux_sim_host_td_length == sizeof(test_host_buffer_0));
+    td = td -> ux_sim_host_td_next_td;
+    UX_TEST_ASSERT(td -> ux_sim_host_td_buffer == test_host_buffer_1);
+    UX_TEST_ASSERT(td -> ux_sim_host_td_length == sizeof(test_host_buffer_1));
+    td = td -> ux_sim_host_td_next_td;
+    UX_TEST_ASSERT(td -> ux_sim_host_td_buffer == test_host_buffer_2);
+    UX_TEST_ASSERT(td -> ux_sim_host_td_length == sizeof(test_host_buffer_2));
+    UX_TEST_ASSERT(td -> ux_sim_host_td_next_td == ed -> ux_sim_host_ed_tail_td);
+
+    /* Run the simulated bus until the transfer is done.  */
+    for (i = 0; i < 16 && ed -> ux_sim_host_ed_head_td != ed -> ux_sim_host_ed_tail_td; i ++)
+        _ux_hcd_sim_host_transaction_schedule(hcd_sim_host, ed);
+    UX_TEST_ASSERT(ed -> ux_sim_host_ed_head_td == ed -> ux_sim_host_ed_tail_td);
+    UX_TEST_ASSERT(transfer_request -> ux_transfer_request_completion_code == UX_SUCCESS);
+    UX_TEST_ASSERT(transfer_request -> ux_transfer_request_actual_length == UX_TEST_LENGTH);
+}
+
+static UCHAR test_host_data(ULONG offset)
+{
+    if (offset < sizeof(test_host_buffer_0))
+        return(test_host_buffer_0[offset]);
+    offset -= sizeof(test_host_buffer_0);
+    if (offset < sizeof(test_host_buffer_1))
+        return(test_host_buffer_1[offset]);
+    return(test_host_buffer_2[offset - sizeof(test_host_buffer_1)]);
+}
+
+static UCHAR test_device_data(ULONG offset)
+{
+    if (offset < sizeof(test_device_buffer_0))
+        return(test_device_buffer_0[offset]);
+    return(test_device_buffer_1[offset - sizeof(test_device_buffer_0)]);
+}
+#endif
+
+static void  ux_test_thread_simulation_0_entry(ULONG arg)
+{
+#if defined(UX_TRANSFER_SEGMENTS_ENABLE)
+UX_HCD                  *hcd;
+UX_HCD_SIM_HOST         *hcd_sim_host;
+UX_TRANSFER             *transfer_request;
+UX_SLAVE_TRANSFER       *slave_transfer_request;
+ULONG                   i;
+UINT                    status;
+
+
+    hcd = &_ux_system_host -> ux_system_host_hcd_array[0];
+    hcd_sim_host = (UX_HCD_SIM_HOST *)hcd -> ux_hcd_controller_hardware;
+#if !defined(UX_HOST_STANDALONE)
+
+    /* The bus is run from this thread, not from the simulator timer.  */
+    tx_timer_deactivate(&hcd_sim_host -> ux_hcd_sim_host_timer);
+#endif
+    test_device.ux_device_state = UX_DEVICE_CONFIGURED;
+    UX_DEVICE_HCD_SET(&test_device, hcd);
+
+    /* Segments must cover the requested length.  */
+    transfer_request = &test_endpoint_out.ux_endpoint_transfer_request;
+    transfer_request -> ux_transfer_request_endpoint = &test_endpoint_out;
+    test_endpoint_out.ux_endpoint_device = &test_device;
+    transfer_request -> ux_transfer_request_requested_length = UX_TEST_LENGTH + 1;
+    transfer_request -> ux_transfer_request_segments = test_host_segments;
+    transfer_request -> ux_transfer_request_segment_count = sizeof(test_host_segments) / sizeof(test_host_segments[0]);
+    status = _uxe_host_stack_transfer_request(transfer_request);
+    UX_TEST_ASSERT(status == UX_INVALID_PARAMETER);
+    transfer_request -> ux_transfer_request_segments = UX_NULL;
+    status = _uxe_host_stack_transfer_request(transfer_request);
+    UX_TEST_ASSERT(status == UX_INVALID_PARAMETER);
+
+    /* Sum of segment lengths must not overflow.  */
+    test_endpoint_out.ux_endpoint_descriptor.wMaxPacketSize = UX_TEST_MAX_PACKET_SIZE;
+    test_bad_segments[0].ux_transfer_segment_data_pointer = test_host_buffer_0;
+    test_bad_segments[0].ux_transfer_segment_length = ~(ULONG)(UX_TEST_MAX_PACKET_SIZE - 1);
+    test_bad_segments[1].ux_transfer_segment_data_pointer = test_host_buffer_1;
+    test_bad_segments[1].ux_transfer_segment_length = UX_TEST_MAX_PACKET_SIZE * 2;
+    transfer_request -> ux_transfer_request_requested_length = UX_TEST_MAX_PACKET_SIZE;
+    transfer_request -> ux_transfer_request_segments = test_bad_segments;
+    transfer_request -> ux_transfer_request_segment_count = 2;
+    status = _uxe_host_stack_transfer_request(transfer_request);
+    UX_TEST_ASSERT(status == UX_INVALID_PARAMETER);
+
+    /* Only the last segment may end with a short packet.  */
+    test_bad_segments[0].ux_transfer_segment_length = UX_TEST_MAX_PACKET_SIZE + 1;
+    test_bad_segments[1].ux_transfer_segment_length = UX_TEST_MAX_PACKET_SIZE - 1;
+    transfer_request -> ux_transfer_request_requested_length = UX_TEST_MAX_PACKET_SIZE * 2;
+    status = _uxe_host_stack_transfer_request(transfer_request);
+    UX_TEST_ASSERT(status == UX_INVALID_PARAMETER);
+
+    /* OUT: host segments to device segments.  */
+    for (i = 0; i < UX_TEST_LENGTH; i ++)
+    {
+        if (i < sizeof(test_host_buffer_0))
+            test_host_buffer_0[i] = (UCHAR)i;
+        else if (i < sizeof(test_host_buffer_0) + sizeof(test_host_buffer_1))
+            test_host_buffer_1[i - sizeof(test_host_buffer_0)] = (UCHAR)i;
+        else
+            test_host_buffer_2[i - sizeof(test_host_buffer_0) - sizeof(test_host_buffer_1)] = (UCHAR)i;
+    }
+    test_endpoint_setup(hcd_sim_host, &test_endpoint_out, &test_slave_endpoint_out, 0x02);
+    test_transfer_run(hcd_sim_host, &test_endpoint_out);
+    slave_transfer_request = &test_slave_endpoint_out.ux_slave_endpoint_transfer_request;
+    UX_TEST_ASSERT(slave_transfer_request -> ux_slave_transfer_request_actual_length == UX_TEST_LENGTH);
+    UX_TEST_ASSERT(slave_transfer_request -> ux_slave_transfer_request_status == UX_TRANSFER_STATUS_COMPLETED);
+    for (i = 0; i < UX_TEST_LENGTH; i ++)
+        UX_TEST_ASSERT(test_device_data(i) == (UCHAR)i);
+
+    /* IN: device segments to host segments.  */
+    for (i = 0; i < UX_TEST_LENGTH; i ++)
+    {
+        if (i < sizeof(test_device_buffer_0))
+            test_device_buffer_0[i] = (UCHAR)(i ^ 0x5A);
+        else
+            test_device_buffer_1[i - sizeof(test_device_buffer_0)] = (UCHAR)(i ^ 0x5A);
+    }
+    test_endpoint_setup(hcd_sim_host, &test_endpoint_in, &test_slave_endpoint_in, 0x81);
+    test_transfer_run(hcd_sim_host, &test_endpoint_in);
+    slave_transfer_request = &test_slave_endpoint_in.ux_slave_endpoint_transfer_request;
+    UX_TEST_ASSERT(slave_transfer_request -> ux_slave_transfer_request_actual_length == UX_TEST_LENGTH);
+    for (i = 0; i < UX_TEST_LENGTH; i ++)
+        UX_TEST_ASSERT(test_host_data(i) == (UCHAR)(i ^ 0x5A));
+#endif
+
+    /* Sleep for a tick to make sure everything is complete.  */
+    tx_thread_sleep(1);
+
+    /* Check for errors from other threads.  */
+    if (error_counter)
+    {
+
+        /* Test error.  */
+        printf("ERROR #%d: total %ld errors\n", __LINE__, error_counter);
+        test_control_return(1);
+    }
+    else
+    {
+
+        /* Successful test.  */
+        printf("SUCCESS!\n");
+        test_control_return(0);
+    }
+}
@@ -0,0 +1,274 @@
+/* This test is designed to test the specialized unpack of standard descriptors against
+   the interpretation of descriptor structures, and to compare their costs per enumeration.  */
+
+#include <stdio.h>
+#include <time.h>
+#include "tx_api.h"
+#include "ux_api.h"
+#include "ux_system.h"
+#include "ux_utility.h"
+
+#include "ux_test.h"
+
+
+/* Define USBX test constants.  */
+
+#define UX_TEST_STACK_SIZE      4096
+#define UX_TEST_MEMORY_SIZE     (64*1024)
+
+#define UX_TEST_PATTERNS        64
+#define UX_TEST_BENCH_LOOPS     200000
+
+
+/* Define the counters used in the test application...  */
+
+static ULONG                           error_counter;
+
+static UCHAR                           error_callback_ignore = UX_FALSE;
+static ULONG                           error_callback_counter;
+
+static UCHAR                           test_raw[32];
+
+/* Copies of structure tables, parsed by interpreting the entries.  */
+
+static UCHAR                           test_device_structure[UX_DEVICE_DESCRIPTOR_ENTRIES];
+static UCHAR                           test_configuration_structure[UX_CONFIGURATION_DESCRIPTOR_ENTRIES];
+static UCHAR                           test_interface_structure[UX_INTERFACE_DESCRIPTOR_ENTRIES];
+static UCHAR                           test_endpoint_structure[UX_ENDPOINT_DESCRIPTOR_ENTRIES];
+static UCHAR                           test_iad_structure[UX_INTERFACE_ASSOCIATION_DESCRIPTOR_ENTRIES];
+static UCHAR                           test_bos_structure[UX_BOS_DESCRIPTOR_ENTRIES];
+
+/* Descriptors read by one enumeration: device, configuration, 2 interfaces with 4 endpoints.  */
+
+static UCHAR                           test_framework[] = {
+
+    /* Device descriptor */
+    0x12, 0x01, 0x00, 0x02, 0x00, 0x00, 0x00, 0x40,
+    0x0a, 0x07, 0x25, 0x40, 0x01, 0x00, 0x01, 0x02,
+    0x03, 0x01,
+
+    /* Configuration descriptor */
+    0x09, 0x02, 0x37, 0x00, 0x02, 0x01, 0x00, 0xc0, 0x32,
+
+    /* Interface descriptor */
+    0x09, 0x04, 0x00, 0x00, 0x02, 0x99, 0x99, 0x99, 0x00,
+
+    /* Endpoint descriptors */
+    0x07, 0x05, 0x01, 0x02, 0x00, 0x02, 0x00,
+    0x07, 0x05, 0x82, 0x02, 0x00, 0x02, 0x00,
+
+    /* Interface descriptor */
+    0x09, 0x04, 0x01, 0x00, 0x02, 0x99, 0x99, 0x99, 0x00,
+
+    /* Endpoint descriptors */
+    0x07, 0x05, 0x03, 0x03, 0x08, 0x00, 0x01,
+    0x07, 0x05, 0x84, 0x03, 0x08, 0x00, 0x01,
+};
+
+
+/* Define prototypes for external Host Controller's (HCDs), classes and clients.  */
+
+static TX_THREAD           ux_test_thread_simulation_0;
+static void                ux_test_thread_simulation_0_entry(ULONG);
+
+
+/* Prototype for test control return.  */
+
+void  test_control_return(UINT status);
+
+
+static VOID error_callback(UINT system_level, UINT system_context, UINT error_code)
+{
+
+    error_callback_counter ++;
+
+    if (!error_callback_ignore)
+    {
+        {
+            /* Failed test.  */
+            printf("Error #%d, system_level: %d, system_context: %d, error_code: 0x%x\n", __LINE__, system_level, system_context, error_code);
+            // test_control_return(1);
+        }
+    }
+}
+
+
+/* Compare descriptor fields parsed by both ways.  */
+
+#define TEST_FIELD_COMPARE(size, name)                                          \
+    if (unpacked.name != interpreted.name)                                      \
+    {                                                                           \
+        printf("ERROR #%d: %s pattern %lu\n", __LINE__, #name, pattern);        \
+        error_counter ++;                                                       \
+    }
+
+#define TEST_DESCRIPTOR_COMPARE(type, table, copy, entries, fields)             \
+    {                                                                           \
+    type        unpacked;                                                       \
+    type        interpreted;                                                    \
+        _ux_utility_memory_set(&unpacked, 0, sizeof(type));                     \
+        _ux_utility_memory_set(&interpreted, 0, sizeof(type));                  \
+        _ux_utility_descriptor_parse(test_raw, table, entries, (UCHAR *)&unpacked); \
+        _ux_utility_descriptor_parse(test_raw, copy, entries, (UCHAR *)&interpreted); \
+        fields(TEST_FIELD_COMPARE)                                              \
+    }
+
+static double test_elapsed_ns(clock_t start, ULONG loops)
+{
+    return((double)(clock() - start) * 1000000000.0 / CLOCKS_PER_SEC / (double)loops);
+}
+
+static VOID test_enumeration_parse(UCHAR *device_structure, UCHAR *configuration_structure,
+                                   UCHAR *interface_structure, UCHAR *endpoint_structure)
+{
+static UX_DEVICE_DESCRIPTOR             device;
+static UX_CONFIGURATION_DESCRIPTOR      configuration;
+static UX_INTERFACE_DESCRIPTOR          interfaces[2];
+static UX_ENDPOINT_DESCRIPTOR           endpoints[4];
+UCHAR                                   *raw = test_framework;
+
+    _ux_utility_descriptor_parse(raw, device_structure, UX_DEVICE_DESCRIPTOR_ENTRIES, (UCHAR *)&device);
+    raw += 18;
+    _ux_utility_descriptor_parse(raw, configuration_structure, UX_CONFIGURATION_DESCRIPTOR_ENTRIES, (UCHAR *)&configuration);
+    raw += 9;
+    _ux_utility_descriptor_parse(raw, interface_structure, UX_INTERFACE_DESCRIPTOR_ENTRIES, (UCHAR *)&interfaces[0]);
+    raw += 9;
+    _ux_utility_descriptor_parse(raw, endpoint_structure, UX_ENDPOINT_DESCRIPTOR_ENTRIES, (UCHAR *)&endpoints[0]);
+    raw += 7;
+    _ux_utility_descriptor_parse(raw, endpoint_structure, UX_ENDPOINT_DESCRIPTOR_ENTRIES, (UCHAR *)&endpoints[1]);
+    raw += 7;
+    _ux_utility_descriptor_parse(raw, interface_structure, UX_INTERFACE_DESCRIPTOR_ENTRIES, (UCHAR *)&interfaces[1]);
+    raw += 9;
+    _ux_utility_descriptor_parse(raw, endpoint_structure, UX_ENDPOINT_DESCRIPTOR_ENTRIES, (UCHAR *)&endpoints[2]);
+    raw += 7;
+    _ux_utility_descriptor_parse(raw, endpoint_structure, UX_ENDPOINT_DESCRIPTOR_ENTRIES, (UCHAR *)&endpoints[3]);
+}
+
+
+/* Define what the initial system looks like.  */
+
+#ifdef CTEST
+void test_application_define(void *first_unused_memory)
+#else
+void    usbx_ux_utility_descriptor_unpack_test_application_define(void *first_unused_memory)
+#endif
+{
+
+UINT status;
+CHAR                            *stack_pointer;
+CHAR                            *memory_pointer;
+
+    /* Inform user.  */
+    printf("Running ux_utility_descriptor_unpack Test........................... ");
+
+    /* Initialize the free memory pointer.  */
+    stack_pointer = (CHAR *) first_unused_memory;
+    memory_pointer = stack_pointer + (UX_TEST_STACK_SIZE * 2);
+
+    /* Initialize USBX Memory.  */
+    status =  ux_system_initialize(memory_pointer, UX_TEST_MEMORY_SIZE, UX_NULL, 0);
+
+    /* Check for error.  */
+    if (status != UX_SUCCESS)
+    {
+
+        printf("ERROR #%d\n", __LINE__);
+        test_control_return(1);
+    }
+
+    /* Register the error callback. */
+    _ux_utility_error_callback_register(error_callback);
+
+    /* Create the simulation thread.  */
+    status =  tx_thread_create(&ux_test_thread_simulation_0, "test simulation", ux_test_thread_simulation_0_entry, 0,
+            stack_pointer, UX_TEST_STACK_SIZE,
+            20, 20, 1, TX_AUTO_START);
+
+    /* Check for error.  */
+    if (status != TX_SUCCESS)
+    {
+
+        printf("ERROR #%d\n", __LINE__);
+        test_control_return(1);
+    }
+}
+
+static void  ux_test_thread_simulation_0_entry(ULONG arg)
+{
+
+ULONG           pattern;
+ULONG           i;
+clock_t         start;
+double          interpreted_ns, unpacked_ns;
+
+
+    /* Tables generated from field lists keep the original entries.  */
+    UX_TEST_ASSERT(_ux_utility_descriptor_parse_size(_ux_system_device_descriptor_structure, UX_DEVICE_DESCRIPTOR_ENTRIES, 0x3) == sizeof(UX_DEVICE_DESCRIPTOR));
+    UX_TEST_ASSERT(_ux_utility_descriptor_parse_size(_ux_system_configuration_descriptor_structure, UX_CONFIGURATION_DESCRIPTOR_ENTRIES, 0x3) == 12);
+    UX_TEST_ASSERT(_ux_utility_descriptor_parse_size(_ux_system_interface_descriptor_structure, UX_INTERFACE_DESCRIPTOR_ENTRIES, 0x3) == sizeof(UX_INTERFACE_DESCRIPTOR));
+    UX_TEST_ASSERT(_ux_utility_descriptor_parse_size(_ux_system_endpoint_descriptor_structure, UX_ENDPOINT_DESCRIPTOR_ENTRIES, 0x3) == sizeof(UX_ENDPOINT_DESCRIPTOR));
+    UX_TEST_ASSERT(_ux_utility_descriptor_parse_size(_ux_system_interface_association_descriptor_structure, UX_INTERFACE_ASSOCIATION_DESCRIPTOR_ENTRIES, 0x3) == sizeof(UX_INTERFACE_ASSOCIATION_DESCRIPTOR));
+    UX_TEST_ASSERT(_ux_utility_descriptor_parse_size(_ux_system_bos_descriptor_structure, UX_BOS_DESCRIPTOR_ENTRIES, 0x3) == sizeof(UX_BOS_DESCRIPTOR));
+
+    /* Copy tables, so parse interprets them.  */
+    _ux_utility_memory_copy(test_device_structure, _ux_system_device_descriptor_structure, sizeof(test_device_structure));
+    _ux_utility_memory_copy(test_configuration_structure, _ux_system_configuration_descriptor_structure, sizeof(test_configuration_structure));
+    _ux_utility_memory_copy(test_interface_structure, _ux_system_interface_descriptor_structure, sizeof(test_interface_structure));
+    _ux_utility_memory_copy(test_endpoint_structure, _ux_system_endpoint_descriptor_structure, sizeof(test_endpoint_structure));
+    _ux_utility_memory_copy(test_iad_structure, _ux_system_interface_association_descriptor_structure, sizeof(test_iad_structure));
+    _ux_utility_memory_copy(test_bos_structure, _ux_system_bos_descriptor_structure, sizeof(test_bos_structure));
+
+    /* Unpacked fields must be same as interpreted ones, for different patterns.  */
+    for (pattern = 0; pattern < UX_TEST_PATTERNS; pattern ++)
+    {
+        for (i = 0; i < sizeof(test_raw); i ++)
+            test_raw[i] = (UCHAR)(pattern * 37 + i * 11 + (pattern >> 3));
+
+        TEST_DESCRIPTOR_COMPARE(UX_DEVICE_DESCRIPTOR, _ux_system_device_descriptor_structure,
+                        test_device_structure, UX_DEVICE_DESCRIPTOR_ENTRIES, UX_DEVICE_DESCRIPTOR_FIELDS)
+        TEST_DESCRIPTOR_COMPARE(UX_CONFIGURATION_DESCRIPTOR, _ux_system_configuration_descriptor_structure,
+                        test_configuration_structure, UX_CONFIGURATION_DESCRIPTOR_ENTRIES, UX_CONFIGURATION_DESCRIPTOR_FIELDS)
+        TEST_DESCRIPTOR_COMPARE(UX_INTERFACE_DESCRIPTOR, _ux_system_interface_descriptor_structure,
+                        test_interface_structure, UX_INTERFACE_DESCRIPTOR_ENTRIES, UX_INTERFACE_DESCRIPTOR_FIELDS)
+        TEST_DESCRIPTOR_COMPARE(UX_ENDPOINT_DESCRIPTOR, _ux_system_endpoint_descriptor_structure,
+                        test_endpoint_structure, UX_ENDPOINT_DESCRIPTOR_ENTRIES, UX_ENDPOINT_DESCRIPTOR_FIELDS)
+        TEST_DESCRIPTOR_COMPARE(UX_INTERFACE_ASSOCIATION_DESCRIPTOR, _ux_system_interface_association_descriptor_structure,
+                        test_iad_structure, UX_INTERFACE_ASSOCIATION_DESCRIPTOR_ENTRIES, UX_INTERFACE_ASSOCIATION_DESCRIPTOR_FIELDS)
+        TEST_DESCRIPTOR_COMPARE(UX_BOS_DESCRIPTOR, _ux_system_bos_descriptor_structure,
+                        test_bos_structure, UX_BOS_DESCRIPTOR_ENTRIES, UX_BOS_DESCRIPTOR_FIELDS)
+    }
+
+    /* Benchmark, descriptors parsed by one enumeration.  */
+    start = clock();
+    for (i = 0; i < UX_TEST_BENCH_LOOPS; i ++)
+        test_enumeration_parse(test_device_structure, test_configuration_structure,
+                               test_interface_structure, test_endpoint_structure);
+    interpreted_ns = test_elapsed_ns(start, UX_TEST_BENCH_LOOPS);
+    start = clock();
+    for (i = 0; i < UX_TEST_BENCH_LOOPS; i ++)
+        test_enumeration_parse(_ux_system_device_descriptor_structure, _ux_system_configuration_descriptor_structure,
+                               _ux_system_interface_descriptor_structure, _ux_system_endpoint_descriptor_structure);
+    unpacked_ns = test_elapsed_ns(start, UX_TEST_BENCH_LOOPS);
+    printf("\n");
+    printf("%-24s %16s %16s\n", "Parse per enumeration", "Interpreted(ns)", "Unpacked(ns)");
+    printf("%-24s %16.1f %16.1f\n", "", interpreted_ns, unpacked_ns);
+
+    /* Sleep for a tick to make sure everything is complete.  */
+    tx_thread_sleep(1);
+
+    /* Check for errors from other threads.  */
+    if (error_counter)
+    {
+
+        /* Test error.  */
+        printf("ERROR #%d: total %ld errors\n", __LINE__, error_counter);
+        test_control_return(1);
+    }
+    else
+    {
+
+        /* Successful test.  */
+        printf("SUCCESS!\n");
+        test_control_return(0);
+    }
+}
@@ -0,0 +1,248 @@
+/* This benchmark measures SCSI CBW/CSW and PIMA container header processing, with the
+   endian helpers (inlined with UX_UTILITY_ENDIAN_INLINE) and with the field access macros
+   used by the storage and PIMA classes.  */
+
+#include <stdio.h>
+#include <time.h>
+#include "tx_api.h"
+#include "ux_api.h"
+#include "ux_system.h"
+#include "ux_utility.h"
+
+#include "ux_test.h"
+
+
+/* Define USBX test constants.  */
+
+#define UX_TEST_STACK_SIZE      4096
+#define UX_TEST_MEMORY_SIZE     (64*1024)
+
+#define UX_TEST_BENCH_LOOPS     1000000
+
+
+/* Define the counters used in the test application...  */
+
+static ULONG                           error_counter;
+
+static UCHAR                           test_buffer[64];
+static volatile ULONG                  test_sink;
+
+
+/* Define prototypes for external Host Controller's (HCDs), classes and clients.  */
+
+static TX_THREAD           ux_test_thread_simulation_0;
+static void                ux_test_thread_simulation_0_entry(ULONG);
+
+
+/* Prototype for test control return.  */
+
+void  test_control_return(UINT status);
+
+
+/* Define what the initial system looks like.  */
+
+#ifdef CTEST
+void test_application_define(void *first_unused_memory)
+#else
+void    usbx_ux_utility_endian_benchmark_application_define(void *first_unused_memory)
+#endif
+{
+
+UINT status;
+CHAR                            *stack_pointer;
+CHAR                            *memory_pointer;
+
+    /* Inform user.  */
+    printf("Running ux_utility endian helpers Benchmark......................... ");
+
+    /* Initialize the free memory pointer.  */
+    stack_pointer = (CHAR *) first_unused_memory;
+    memory_pointer = stack_pointer + (UX_TEST_STACK_SIZE * 2);
+
+    /* Initialize USBX Memory.  */
+    status =  ux_system_initialize(memory_pointer, UX_TEST_MEMORY_SIZE, UX_NULL, 0);
+
+    /* Check for error.  */
+    if (status != UX_SUCCESS)
+    {
+
+        printf("ERROR #%d\n", __LINE__);
+        test_control_return(1);
+    }
+
+    /* Create the simulation thread.  */
+    status =  tx_thread_create(&ux_test_thread_simulation_0, "test simulation", ux_test_thread_simulation_0_entry, 0,
+            stack_pointer, UX_TEST_STACK_SIZE,
+            20, 20, 1, TX_AUTO_START);
+
+    /* Check for error.  */
+    if (status != TX_SUCCESS)
+    {
+
+        printf("ERROR #%d\n", __LINE__);
+        test_control_return(1);
+    }
+}
+
+static double test_cbw_csw_ns(ULONG macros)
+{
+clock_t         start;
+ULONG           i;
+UCHAR           *cbw = test_buffer;
+UCHAR           *csw = test_buffer + 32;
+
+    start = clock();
+    for (i = 0; i < UX_TEST_BENCH_LOOPS; i ++)
+    {
+
+        /* Build CBW header and READ(10) LBA and length, as _ux_host_class_storage_cbw_initialize
+           and _ux_host_class_storage_media_read.  */
+        cbw[12] = 0x80;
+        cbw[13] = 0;
+        cbw[14] = 10;
+        if (macros)
+        {
+            UX_UTILITY_LONG_PUT(cbw, 0x43425355);
+            UX_UTILITY_LONG_PUT(cbw + 4, 0x55534243);
+            UX_UTILITY_LONG_PUT(cbw + 8, i);
+            UX_UTILITY_LONG_PUT_BIG_ENDIAN(cbw + 15 + 2, i);
+            UX_UTILITY_SHORT_PUT_BIG_ENDIAN(cbw + 15 + 7, 1);
+        }
+        else
+        {
+            _ux_utility_long_put(cbw, 0x43425355);
+            _ux_utility_long_put(cbw + 4, 0x55534243);
+            _ux_utility_long_put(cbw + 8, i);
+            _ux_utility_long_put_big_endian(cbw + 15 + 2, i);
+            _ux_utility_short_put_big_endian(cbw + 15 + 7, 1);
+        }
+
+        /* Device echoes the CSW.  */
+        csw[0] = 0x55; csw[1] = 0x53; csw[2] = 0x42; csw[3] = 0x53;
+        csw[4] = cbw[4]; csw[5] = cbw[5]; csw[6] = cbw[6]; csw[7] = cbw[7];
+        csw[8] = (UCHAR)i; csw[9] = 0; csw[10] = 0; csw[11] = 0;
+
+        /* Parse CSW, as _ux_host_class_storage_transport_bo.  */
+        if (macros)
+        {
+            if (UX_UTILITY_LONG_GET(csw) != 0x53425355 ||
+                UX_UTILITY_LONG_GET(csw + 4) != UX_UTILITY_LONG_GET(cbw + 4))
+                return(-1.0);
+            test_sink += UX_UTILITY_LONG_GET(cbw + 8) - UX_UTILITY_LONG_GET(csw + 8);
+        }
+        else
+        {
+            if (_ux_utility_long_get(csw) != 0x53425355 ||
+                _ux_utility_long_get(csw + 4) != _ux_utility_long_get(cbw + 4))
+                return(-1.0);
+            test_sink += _ux_utility_long_get(cbw + 8) - _ux_utility_long_get(csw + 8);
+        }
+    }
+    return((double)(clock() - start) * 1000000000.0 / CLOCKS_PER_SEC / UX_TEST_BENCH_LOOPS);
+}
+
+static double test_pima_header_ns(ULONG macros)
+{
+clock_t         start;
+ULONG           i;
+UCHAR           *container = test_buffer;
+ULONG           parameter_1 = 0x10001;
+ULONG           parameter_2;
+ULONG           parameter_3 = 3;
+ULONG           parameter_4 = 4;
+ULONG           parameter_5 = 5;
+
+    start = clock();
+    for (i = 0; i < UX_TEST_BENCH_LOOPS; i ++)
+    {
+
+        /* Build command container, as _ux_host_class_pima_command.  */
+        parameter_2 = i;
+        if (macros)
+        {
+            UX_UTILITY_LONG_PUT(container, 12 + 5 * 4);
+            UX_UTILITY_SHORT_PUT(container + 4, 1);
+            UX_UTILITY_SHORT_PUT(container + 6, 0x1001);
+            UX_UTILITY_LONG_PUT(container + 8, i);
+            UX_UTILITY_LONG_PUT(container + 12, parameter_1);
+            UX_UTILITY_LONG_PUT(container + 16, parameter_2);
+            UX_UTILITY_LONG_PUT(container + 20, parameter_3);
+            UX_UTILITY_LONG_PUT(container + 24, parameter_4);
+            UX_UTILITY_LONG_PUT(container + 28, parameter_5);
+        }
+        else
+        {
+            _ux_utility_long_put(container, 12 + 5 * 4);
+            _ux_utility_short_put(container + 4, 1);
+            _ux_utility_short_put(container + 6, 0x1001);
+            _ux_utility_long_put(container + 8, i);
+            _ux_utility_long_put(container + 12, parameter_1);
+            _ux_utility_long_put(container + 16, parameter_2);
+            _ux_utility_long_put(container + 20, parameter_3);
+            _ux_utility_long_put(container + 24, parameter_4);
+            _ux_utility_long_put(container + 28, parameter_5);
+        }
+
+        /* Parse it as a response container.  */
+        if (macros)
+        {
+            if (UX_UTILITY_SHORT_GET(container + 4) != 1)
+                return(-1.0);
+            parameter_1 = UX_UTILITY_LONG_GET(container + 12);
+            parameter_2 = UX_UTILITY_LONG_GET(container + 16);
+            parameter_3 = UX_UTILITY_LONG_GET(container + 20);
+            parameter_4 = UX_UTILITY_LONG_GET(container + 24);
+            parameter_5 = UX_UTILITY_LONG_GET(container + 28);
+        }
+        else
+        {
+            if (_ux_utility_short_get(container + 4) != 1)
+                return(-1.0);
+            parameter_1 = _ux_utility_long_get(container + 12);
+            parameter_2 = _ux_utility_long_get(container + 16);
+            parameter_3 = _ux_utility_long_get(container + 20);
+            parameter_4 = _ux_utility_long_get(container + 24);
+            parameter_5 = _ux_utility_long_get(container + 28);
+        }
+        test_sink += parameter_2 + parameter_5;
+    }
+    return((double)(clock() - start) * 1000000000.0 / CLOCKS_PER_SEC / UX_TEST_BENCH_LOOPS);
+}
+
+static void  ux_test_thread_simulation_0_entry(ULONG arg)
+{
+double                  cbw_ns, cbw_macros_ns, pima_ns, pima_macros_ns;
+
+
+    /* Benchmark: CBW/CSW and PIMA container header processing.  */
+    cbw_ns = test_cbw_csw_ns(UX_FALSE);
+    cbw_macros_ns = test_cbw_csw_ns(UX_TRUE);
+    pima_ns = test_pima_header_ns(UX_FALSE);
+    pima_macros_ns = test_pima_header_ns(UX_TRUE);
+    UX_TEST_ASSERT(cbw_ns >= 0 && cbw_macros_ns >= 0 && pima_ns >= 0 && pima_macros_ns >= 0);
+#if defined(UX_UTILITY_ENDIAN_INLINE)
+    printf("\ninline helpers, ");
+#else
+    printf("\nout of line helpers, ");
+#endif
+    printf("CBW/CSW %ld ns, PIMA header %ld ns; access macros, CBW/CSW %ld ns, PIMA header %ld ns ... ",
+           (long)cbw_ns, (long)pima_ns, (long)cbw_macros_ns, (long)pima_macros_ns);
+    /* Sleep for a tick to make sure everything is complete.  */
+    tx_thread_sleep(1);
+
+    /* Check for errors from other threads.  */
+    if (error_counter)
+    {
+
+        /* Test error.  */
+        printf("ERROR #%d: total %ld errors\n", __LINE__, error_counter);
+        test_control_return(1);
+    }
+    else
+    {
+
+        /* Successful test.  */
+        printf("SUCCESS!\n");
+        test_control_return(0);
+    }
+}
@@ -0,0 +1,154 @@
+/* This test is designed to test the endian field access macros and the endian helpers,
+   inlined or not, at any alignment.  */
+
+#include <stdio.h>
+#include "tx_api.h"
+#include "ux_api.h"
+#include "ux_system.h"
+#include "ux_utility.h"
+
+#include "ux_test.h"
+
+
+/* Define USBX test constants.  */
+
+#define UX_TEST_STACK_SIZE      4096
+#define UX_TEST_MEMORY_SIZE     (64*1024)
+
+
+/* Define the counters used in the test application...  */
+
+static ULONG                           error_counter;
+
+static UCHAR                           test_buffer[64];
+
+
+/* Define prototypes for external Host Controller's (HCDs), classes and clients.  */
+
+static TX_THREAD           ux_test_thread_simulation_0;
+static void                ux_test_thread_simulation_0_entry(ULONG);
+
+
+/* Prototype for test control return.  */
+
+void  test_control_return(UINT status);
+
+
+/* Define what the initial system looks like.  */
+
+#ifdef CTEST
+void test_application_define(void *first_unused_memory)
+#else
+void    usbx_ux_utility_endian_test_application_define(void *first_unused_memory)
+#endif
+{
+
+UINT status;
+CHAR                            *stack_pointer;
+CHAR                            *memory_pointer;
+
+    /* Inform user.  */
+    printf("Running ux_utility endian helpers Test.............................. ");
+
+    /* Initialize the free memory pointer.  */
+    stack_pointer = (CHAR *) first_unused_memory;
+    memory_pointer = stack_pointer + (UX_TEST_STACK_SIZE * 2);
+
+    /* Initialize USBX Memory.  */
+    status =  ux_system_initialize(memory_pointer, UX_TEST_MEMORY_SIZE, UX_NULL, 0);
+
+    /* Check for error.  */
+    if (status != UX_SUCCESS)
+    {
+
+        printf("ERROR #%d\n", __LINE__);
+        test_control_return(1);
+    }
+
+    /* Create the simulation thread.  */
+    status =  tx_thread_create(&ux_test_thread_simulation_0, "test simulation", ux_test_thread_simulation_0_entry, 0,
+            stack_pointer, UX_TEST_STACK_SIZE,
+            20, 20, 1, TX_AUTO_START);
+
+    /* Check for error.  */
+    if (status != TX_SUCCESS)
+    {
+
+        printf("ERROR #%d\n", __LINE__);
+        test_control_return(1);
+    }
+}
+
+static void  ux_test_thread_simulation_0_entry(ULONG arg)
+{
+UCHAR                   *address;
+ULONG                   offset;
+ULONG                   i;
+
+
+    /* Fields at any alignment.  */
+    for (offset = 0; offset < 4; offset ++)
+    {
+        address = test_buffer + offset;
+        for (i = 0; i < 8; i ++)
+            address[i] = (UCHAR)(0x11 * (i + 1));
+
+        UX_TEST_ASSERT(_ux_utility_long_get(address) == 0x44332211);
+        UX_TEST_ASSERT(_ux_utility_long_get_big_endian(address) == 0x11223344);
+        UX_TEST_ASSERT(_ux_utility_short_get(address) == 0x2211);
+        UX_TEST_ASSERT(_ux_utility_short_get_big_endian(address) == 0x1122);
+
+        _ux_utility_long_put(address, 0x8899AABB);
+        UX_TEST_ASSERT(address[0] == 0xBB && address[1] == 0xAA && address[2] == 0x99 && address[3] == 0x88 && address[4] == 0x55);
+        _ux_utility_long_put_big_endian(address, 0x8899AABB);
+        UX_TEST_ASSERT(address[0] == 0x88 && address[1] == 0x99 && address[2] == 0xAA && address[3] == 0xBB && address[4] == 0x55);
+        _ux_utility_short_put(address, 0xCCDD);
+        UX_TEST_ASSERT(address[0] == 0xDD && address[1] == 0xCC && address[2] == 0xAA);
+        _ux_utility_short_put_big_endian(address, 0xCCDD);
+        UX_TEST_ASSERT(address[0] == 0xCC && address[1] == 0xDD && address[2] == 0xAA);
+
+        /* Values are not sign extended.  */
+        address[0] = 0xFF; address[1] = 0xFE; address[2] = 0xFD; address[3] = 0xFC;
+        UX_TEST_ASSERT(_ux_utility_long_get(address) == 0xFCFDFEFFul);
+        UX_TEST_ASSERT(_ux_utility_long_get_big_endian(address) == 0xFFFEFDFCul);
+        UX_TEST_ASSERT(_ux_utility_short_get(address) == 0xFEFF);
+
+        /* Access macros.  */
+        for (i = 0; i < 8; i ++)
+            address[i] = (UCHAR)(0x11 * (i + 1));
+        UX_TEST_ASSERT(UX_UTILITY_LONG_GET(address) == 0x44332211);
+        UX_TEST_ASSERT(UX_UTILITY_LONG_GET_BIG_ENDIAN(address) == 0x11223344);
+        UX_TEST_ASSERT(UX_UTILITY_SHORT_GET(address) == 0x2211);
+        UX_TEST_ASSERT(UX_UTILITY_SHORT_GET_BIG_ENDIAN(address) == 0x1122);
+        UX_UTILITY_LONG_PUT(address, 0x8899AABB);
+        UX_TEST_ASSERT(address[0] == 0xBB && address[1] == 0xAA && address[2] == 0x99 && address[3] == 0x88 && address[4] == 0x55);
+        UX_UTILITY_LONG_PUT_BIG_ENDIAN(address, 0x8899AABB);
+        UX_TEST_ASSERT(address[0] == 0x88 && address[1] == 0x99 && address[2] == 0xAA && address[3] == 0xBB && address[4] == 0x55);
+        UX_UTILITY_SHORT_PUT(address, 0xCCDD);
+        UX_TEST_ASSERT(address[0] == 0xDD && address[1] == 0xCC && address[2] == 0xAA);
+        UX_UTILITY_SHORT_PUT_BIG_ENDIAN(address, 0xCCDD);
+        UX_TEST_ASSERT(address[0] == 0xCC && address[1] == 0xDD && address[2] == 0xAA);
+        address[0] = 0xFF; address[1] = 0xFE; address[2] = 0xFD; address[3] = 0xFC;
+        UX_TEST_ASSERT(UX_UTILITY_LONG_GET(address) == 0xFCFDFEFFul);
+        UX_TEST_ASSERT(UX_UTILITY_LONG_GET_BIG_ENDIAN(address) == 0xFFFEFDFCul);
+    }
+
+    /* Sleep for a tick to make sure everything is complete.  */
+    tx_thread_sleep(1);
+
+    /* Check for errors from other threads.  */
+    if (error_counter)
+    {
+
+        /* Test error.  */
+        printf("ERROR #%d: total %ld errors\n", __LINE__, error_counter);
+        test_control_return(1);
+    }
+    else
+    {
+
+        /* Successful test.  */
+        printf("SUCCESS!\n");
+        test_control_return(0);
+    }
+}
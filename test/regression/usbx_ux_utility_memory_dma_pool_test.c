@@ -0,0 +1,296 @@
+/* This test is designed to test the DMA buffer pool in ux_utility_memory_dma_allocate/free,
+   and to compare allocate/free costs on a fragmented cache safe pool and on DMA pool.  */
+
+#include <stdio.h>
+#include <time.h>
+#include "tx_api.h"
+#include "ux_api.h"
+#include "ux_system.h"
+#include "ux_utility.h"
+
+#include "ux_test.h"
+
+
+/* Define USBX test constants.  */
+
+#define UX_TEST_STACK_SIZE      4096
+#define UX_TEST_MEMORY_SIZE     (64*1024)
+#define UX_TEST_CACHE_SAFE_SIZE (32*1024)
+
+#define UX_TEST_FRAGMENTS       256
+#define UX_TEST_BENCH_LOOPS     20000
+
+
+/* Define the counters used in the test application...  */
+
+static ULONG                           error_counter;
+
+static UCHAR                           *cache_safe_memory;
+
+static UCHAR                           error_callback_ignore = UX_FALSE;
+static ULONG                           error_callback_counter;
+static UINT                            error_callback_code;
+
+#if defined(UX_ENABLE_MEMORY_DMA_POOL)
+static UCHAR                           *test_blocks[UX_MEMORY_DMA_POOL_BLOCK_NUM];
+#endif
+
+static VOID                            *test_fragments[UX_TEST_FRAGMENTS];
+
+
+/* Define prototypes for external Host Controller's (HCDs), classes and clients.  */
+
+static TX_THREAD           ux_test_thread_simulation_0;
+static void                ux_test_thread_simulation_0_entry(ULONG);
+
+
+/* Prototype for test control return.  */
+
+void  test_control_return(UINT status);
+
+
+static VOID error_callback(UINT system_level, UINT system_context, UINT error_code)
+{
+
+    error_callback_counter ++;
+    error_callback_code = error_code;
+
+    if (!error_callback_ignore)
+    {
+        {
+            /* Failed test.  */
+            printf("Error #%d, system_level: %d, system_context: %d, error_code: 0x%x\n", __LINE__, system_level, system_context, error_code);
+            // test_control_return(1);
+        }
+    }
+}
+
+
+/* Define what the initial system looks like.  */
+
+#ifdef CTEST
+void test_application_define(void *first_unused_memory)
+#else
+void    usbx_ux_utility_memory_dma_pool_test_application_define(void *first_unused_memory)
+#endif
+{
+
+UINT status;
+CHAR                            *stack_pointer;
+CHAR                            *memory_pointer;
+
+    /* Inform user.  */
+#if !defined(UX_ENABLE_MEMORY_DMA_POOL)
+    printf("Running ux_utility_memory_ DMA pool Test........................SKIP SUCCESS!\n");
+    test_control_return(0);
+    return;
+#endif
+
+    printf("Running ux_utility_memory_ DMA pool Test............................ ");
+
+    /* Initialize the free memory pointer.  */
+    stack_pointer = (CHAR *) first_unused_memory;
+    memory_pointer = stack_pointer + (UX_TEST_STACK_SIZE * 2);
+
+    /* Initialize USBX Memory, with separated cache safe memory.  */
+    cache_safe_memory = (UCHAR *)memory_pointer + UX_TEST_MEMORY_SIZE;
+    status =  ux_system_initialize(memory_pointer, UX_TEST_MEMORY_SIZE, cache_safe_memory, UX_TEST_CACHE_SAFE_SIZE);
+
+    /* Check for error.  */
+    if (status != UX_SUCCESS)
+    {
+
+        printf("ERROR #%d\n", __LINE__);
+        test_control_return(1);
+    }
+
+    /* Register the error callback. */
+    _ux_utility_error_callback_register(error_callback);
+
+    /* Create the simulation thread.  */
+    status =  tx_thread_create(&ux_test_thread_simulation_0, "test simulation", ux_test_thread_simulation_0_entry, 0,
+            stack_pointer, UX_TEST_STACK_SIZE,
+            20, 20, 1, TX_AUTO_START);
+
+    /* Check for error.  */
+    if (status != TX_SUCCESS)
+    {
+
+        printf("ERROR #%d\n", __LINE__);
+        test_control_return(1);
+    }
+}
+
+#if defined(UX_ENABLE_MEMORY_DMA_POOL)
+static double test_alloc_free_ns(ULONG dma, ULONG size)
+{
+clock_t         start;
+ULONG           i;
+VOID            *memory;
+
+    start = clock();
+    for (i = 0; i < UX_TEST_BENCH_LOOPS; i ++)
+    {
+        if (dma)
+        {
+            memory = _ux_utility_memory_dma_allocate(UX_MEMORY_DMA_OWNER_OTHERS, size);
+            if (memory == UX_NULL)
+                return(-1.0);
+            _ux_utility_memory_dma_free(memory);
+        }
+        else
+        {
+            memory = _ux_utility_memory_allocate(UX_SAFE_ALIGN, UX_CACHE_SAFE_MEMORY, size);
+            if (memory == UX_NULL)
+                return(-1.0);
+            _ux_utility_memory_free(memory);
+        }
+    }
+    return((double)(clock() - start) * 1000000000.0 / CLOCKS_PER_SEC / UX_TEST_BENCH_LOOPS);
+}
+#endif
+
+static void  ux_test_thread_simulation_0_entry(ULONG arg)
+{
+#if defined(UX_ENABLE_MEMORY_DMA_POOL)
+UX_MEMORY_DMA_POOL      *dma_pool_ptr = &_ux_system -> ux_system_memory_dma_pool;
+UX_MEMORY_BYTE_POOL     *pool_ptr = _ux_system -> ux_system_memory_byte_pool[UX_MEMORY_BYTE_POOL_CACHE_SAFE];
+UCHAR                   *memory0, *memory1;
+ULONG                   available;
+ULONG                   fallback;
+ULONG                   i, j;
+double                  pool_ns, dma_ns;
+
+
+    /* Pool is reserved from cache safe memory, aligned to cache line.  */
+    UX_TEST_ASSERT(dma_pool_ptr -> ux_dma_pool_free_count == UX_MEMORY_DMA_POOL_BLOCK_NUM);
+    UX_TEST_ASSERT(((ALIGN_TYPE)dma_pool_ptr -> ux_dma_pool_start & UX_MEMORY_DMA_POOL_ALIGN) == 0);
+    UX_TEST_ASSERT(dma_pool_ptr -> ux_dma_pool_start > cache_safe_memory);
+    UX_TEST_ASSERT(dma_pool_ptr -> ux_dma_pool_end <= cache_safe_memory + UX_TEST_CACHE_SAFE_SIZE);
+    for (i = 0; i < UX_MEMORY_DMA_OWNER_NUM; i ++)
+        UX_TEST_ASSERT(dma_pool_ptr -> ux_dma_pool_quota[i] == UX_MEMORY_DMA_POOL_BLOCK_NUM);
+
+    /* Blocks are taken without touching the byte pool, and are distinct.  */
+    available = pool_ptr -> ux_byte_pool_available;
+    fallback = dma_pool_ptr -> ux_dma_pool_fallback_count;
+    for (i = 0; i < UX_MEMORY_DMA_POOL_BLOCK_NUM; i ++)
+    {
+        test_blocks[i] = _ux_utility_memory_dma_allocate(UX_MEMORY_DMA_OWNER_HOST_STORAGE, UX_MEMORY_DMA_POOL_BLOCK_SIZE);
+        UX_TEST_ASSERT(test_blocks[i] >= dma_pool_ptr -> ux_dma_pool_start);
+        UX_TEST_ASSERT(test_blocks[i] < dma_pool_ptr -> ux_dma_pool_end);
+        UX_TEST_ASSERT(((ALIGN_TYPE)test_blocks[i] & UX_MEMORY_DMA_POOL_ALIGN) == 0);
+        for (j = 0; j < i; j ++)
+            UX_TEST_ASSERT(test_blocks[i] != test_blocks[j]);
+        _ux_utility_memory_set(test_blocks[i], 0x5A, UX_MEMORY_DMA_POOL_BLOCK_SIZE);
+    }
+    UX_TEST_ASSERT(pool_ptr -> ux_byte_pool_available == available);
+    UX_TEST_ASSERT(dma_pool_ptr -> ux_dma_pool_free_count == 0);
+    UX_TEST_ASSERT(dma_pool_ptr -> ux_dma_pool_used[UX_MEMORY_DMA_OWNER_HOST_STORAGE] == UX_MEMORY_DMA_POOL_BLOCK_NUM);
+    UX_TEST_ASSERT(dma_pool_ptr -> ux_dma_pool_fallback_count == fallback);
+
+    /* Exhausted pool falls back to cache safe byte pool.  */
+    memory0 = _ux_utility_memory_dma_allocate(UX_MEMORY_DMA_OWNER_HOST_PIMA, 64);
+    UX_TEST_ASSERT(memory0 != UX_NULL);
+    UX_TEST_ASSERT(memory0 < dma_pool_ptr -> ux_dma_pool_start || memory0 >= dma_pool_ptr -> ux_dma_pool_end);
+    UX_TEST_ASSERT(pool_ptr -> ux_byte_pool_available < available);
+    UX_TEST_ASSERT(dma_pool_ptr -> ux_dma_pool_fallback_count == fallback + 1);
+    _ux_utility_memory_dma_free(memory0);
+    UX_TEST_ASSERT(pool_ptr -> ux_byte_pool_available == available);
+
+    /* Freed block is reused and cleared up to requested size.  */
+    _ux_utility_memory_dma_free(test_blocks[3]);
+    UX_TEST_ASSERT(dma_pool_ptr -> ux_dma_pool_free_count == 1);
+    UX_TEST_ASSERT(dma_pool_ptr -> ux_dma_pool_used[UX_MEMORY_DMA_OWNER_HOST_STORAGE] == UX_MEMORY_DMA_POOL_BLOCK_NUM - 1);
+    memory1 = _ux_utility_memory_dma_allocate(UX_MEMORY_DMA_OWNER_HOST_PIMA, 13);
+    UX_TEST_ASSERT(memory1 == test_blocks[3]);
+    for (i = 0; i < 13; i ++)
+        UX_TEST_ASSERT(memory1[i] == 0);
+    UX_TEST_ASSERT(dma_pool_ptr -> ux_dma_pool_used[UX_MEMORY_DMA_OWNER_HOST_PIMA] == 1);
+    _ux_utility_memory_dma_free(memory1);
+    UX_TEST_ASSERT(dma_pool_ptr -> ux_dma_pool_used[UX_MEMORY_DMA_OWNER_HOST_PIMA] == 0);
+    for (i = 0; i < UX_MEMORY_DMA_POOL_BLOCK_NUM; i ++)
+    {
+        if (i != 3)
+            _ux_utility_memory_dma_free(test_blocks[i]);
+    }
+    UX_TEST_ASSERT(dma_pool_ptr -> ux_dma_pool_free_count == UX_MEMORY_DMA_POOL_BLOCK_NUM);
+    UX_TEST_ASSERT(dma_pool_ptr -> ux_dma_pool_used[UX_MEMORY_DMA_OWNER_HOST_STORAGE] == 0);
+
+    /* Request larger than a block falls back.  */
+    memory0 = _ux_utility_memory_dma_allocate(UX_MEMORY_DMA_OWNER_OTHERS, UX_MEMORY_DMA_POOL_BLOCK_SIZE + 1);
+    UX_TEST_ASSERT(memory0 != UX_NULL);
+    UX_TEST_ASSERT(memory0 < dma_pool_ptr -> ux_dma_pool_start || memory0 >= dma_pool_ptr -> ux_dma_pool_end);
+    UX_TEST_ASSERT(dma_pool_ptr -> ux_dma_pool_free_count == UX_MEMORY_DMA_POOL_BLOCK_NUM);
+    _ux_utility_memory_dma_free(memory0);
+
+    /* Quota limits blocks taken by owner, others are not affected.  */
+    dma_pool_ptr -> ux_dma_pool_quota[UX_MEMORY_DMA_OWNER_HOST_PIMA] = 1;
+    memory0 = _ux_utility_memory_dma_allocate(UX_MEMORY_DMA_OWNER_HOST_PIMA, 8);
+    memory1 = _ux_utility_memory_dma_allocate(UX_MEMORY_DMA_OWNER_HOST_PIMA, 8);
+    UX_TEST_ASSERT(memory0 >= dma_pool_ptr -> ux_dma_pool_start && memory0 < dma_pool_ptr -> ux_dma_pool_end);
+    UX_TEST_ASSERT(memory1 != UX_NULL);
+    UX_TEST_ASSERT(memory1 < dma_pool_ptr -> ux_dma_pool_start || memory1 >= dma_pool_ptr -> ux_dma_pool_end);
+    test_blocks[0] = _ux_utility_memory_dma_allocate(UX_MEMORY_DMA_OWNER_HOST_STORAGE, 8);
+    UX_TEST_ASSERT(test_blocks[0] >= dma_pool_ptr -> ux_dma_pool_start && test_blocks[0] < dma_pool_ptr -> ux_dma_pool_end);
+    _ux_utility_memory_dma_free(memory1);
+    _ux_utility_memory_dma_free(memory0);
+    _ux_utility_memory_dma_free(test_blocks[0]);
+    dma_pool_ptr -> ux_dma_pool_quota[UX_MEMORY_DMA_OWNER_HOST_PIMA] = UX_MEMORY_DMA_POOL_BLOCK_NUM;
+    UX_TEST_ASSERT(dma_pool_ptr -> ux_dma_pool_free_count == UX_MEMORY_DMA_POOL_BLOCK_NUM);
+    UX_TEST_ASSERT(pool_ptr -> ux_byte_pool_available == available);
+
+    /* Benchmark: allocate/free of transfer buffer behind small free fragments
+       of cache safe pool, and from DMA pool.  */
+    for (i = 0; i < UX_TEST_FRAGMENTS; i ++)
+    {
+        test_fragments[i] = _ux_utility_memory_allocate(UX_NO_ALIGN, UX_CACHE_SAFE_MEMORY, 40);
+        if (test_fragments[i] == UX_NULL)
+            break;
+    }
+    for (i = 0; i < UX_TEST_FRAGMENTS; i += 2)
+    {
+        if (test_fragments[i] != UX_NULL)
+        {
+            _ux_utility_memory_free(test_fragments[i]);
+            test_fragments[i] = UX_NULL;
+        }
+    }
+    pool_ns = test_alloc_free_ns(UX_FALSE, UX_MEMORY_DMA_POOL_BLOCK_SIZE);
+    dma_ns = test_alloc_free_ns(UX_TRUE, UX_MEMORY_DMA_POOL_BLOCK_SIZE);
+    UX_TEST_ASSERT(pool_ns >= 0 && dma_ns >= 0);
+    printf("\nalloc/free, pool %ld ns, DMA pool %ld ns ... ", (long)pool_ns, (long)dma_ns);
+    for (i = 0; i < UX_TEST_FRAGMENTS; i ++)
+    {
+        if (test_fragments[i] != UX_NULL)
+            _ux_utility_memory_free(test_fragments[i]);
+    }
+
+    /* Uninitialize gives the blocks back to cache safe pool and clears the pool.  */
+    available = pool_ptr -> ux_byte_pool_available;
+    _ux_system_uninitialize();
+    UX_TEST_ASSERT(pool_ptr -> ux_byte_pool_available >= available + UX_MEMORY_DMA_POOL_BLOCK_SIZE * UX_MEMORY_DMA_POOL_BLOCK_NUM);
+    UX_TEST_ASSERT(dma_pool_ptr -> ux_dma_pool_start == UX_NULL);
+    UX_TEST_ASSERT(dma_pool_ptr -> ux_dma_pool_free_list == UX_NULL);
+    UX_TEST_ASSERT(dma_pool_ptr -> ux_dma_pool_free_count == 0);
+    UX_TEST_ASSERT(dma_pool_ptr -> ux_dma_pool_fallback_count == 0);
+#endif
+
+    /* Sleep for a tick to make sure everything is complete.  */
+    tx_thread_sleep(1);
+
+    /* Check for errors from other threads.  */
+    if (error_counter)
+    {
+
+        /* Test error.  */
+        printf("ERROR #%d: total %ld errors\n", __LINE__, error_counter);
+        test_control_return(1);
+    }
+    else
+    {
+
+        /* Successful test.  */
+        printf("SUCCESS!\n");
+        test_control_return(0);
+    }
+}
@@ -0,0 +1,261 @@
+/* This test is designed to test the memory slab size classes in ux_utility_memory_allocate/free,
+   and to compare allocate/free costs on a fragmented pool with and without slab cache.  */
+
+#include <stdio.h>
+#include <time.h>
+#include "tx_api.h"
+#include "ux_api.h"
+#include "ux_system.h"
+#include "ux_utility.h"
+
+#include "ux_test.h"
+
+
+/* Define USBX test constants.  */
+
+#define UX_TEST_STACK_SIZE      4096
+#define UX_TEST_MEMORY_SIZE     (64*1024)
+
+#define UX_TEST_FRAGMENTS       256
+#define UX_TEST_BENCH_LOOPS     20000
+
+
+/* Define the counters used in the test application...  */
+
+static ULONG                           error_counter;
+
+static UCHAR                           error_callback_ignore = UX_FALSE;
+static ULONG                           error_callback_counter;
+static UINT                            error_callback_code;
+
+static VOID                            *test_fragments[UX_TEST_FRAGMENTS];
+
+
+/* Define prototypes for external Host Controller's (HCDs), classes and clients.  */
+
+static TX_THREAD           ux_test_thread_simulation_0;
+static void                ux_test_thread_simulation_0_entry(ULONG);
+
+
+/* Prototype for test control return.  */
+
+void  test_control_return(UINT status);
+
+
+static VOID error_callback(UINT system_level, UINT system_context, UINT error_code)
+{
+
+    error_callback_counter ++;
+    error_callback_code = error_code;
+
+    if (!error_callback_ignore)
+    {
+        {
+            /* Failed test.  */
+            printf("Error #%d, system_level: %d, system_context: %d, error_code: 0x%x\n", __LINE__, system_level, system_context, error_code);
+            // test_control_return(1);
+        }
+    }
+}
+
+
+/* Define what the initial system looks like.  */
+
+#ifdef CTEST
+void test_application_define(void *first_unused_memory)
+#else
+void    usbx_ux_utility_memory_slab_test_application_define(void *first_unused_memory)
+#endif
+{
+
+UINT status;
+CHAR                            *stack_pointer;
+CHAR                            *memory_pointer;
+
+    /* Inform user.  */
+#if !defined(UX_ENABLE_MEMORY_SLAB)
+    printf("Running ux_utility_memory_ slab Test............................SKIP SUCCESS!\n");
+    test_control_return(0);
+    return;
+#endif
+
+    printf("Running ux_utility_memory_ slab Test................................ ");
+
+    /* Initialize the free memory pointer.  */
+    stack_pointer = (CHAR *) first_unused_memory;
+    memory_pointer = stack_pointer + (UX_TEST_STACK_SIZE * 2);
+
+    /* Initialize USBX Memory.  */
+    status =  ux_system_initialize(memory_pointer, UX_TEST_MEMORY_SIZE, UX_NULL, 0);
+
+    /* Check for error.  */
+    if (status != UX_SUCCESS)
+    {
+
+        printf("ERROR #%d\n", __LINE__);
+        test_control_return(1);
+    }
+
+    /* Register the error callback. */
+    _ux_utility_error_callback_register(error_callback);
+
+    /* Create the simulation thread.  */
+    status =  tx_thread_create(&ux_test_thread_simulation_0, "test simulation", ux_test_thread_simulation_0_entry, 0,
+            stack_pointer, UX_TEST_STACK_SIZE,
+            20, 20, 1, TX_AUTO_START);
+
+    /* Check for error.  */
+    if (status != TX_SUCCESS)
+    {
+
+        printf("ERROR #%d\n", __LINE__);
+        test_control_return(1);
+    }
+}
+
+#if defined(UX_ENABLE_MEMORY_SLAB)
+static double test_alloc_free_ns(ULONG size)
+{
+clock_t         start;
+ULONG           i;
+VOID            *memory;
+
+    start = clock();
+    for (i = 0; i < UX_TEST_BENCH_LOOPS; i ++)
+    {
+        memory = _ux_utility_memory_allocate(UX_NO_ALIGN, UX_REGULAR_MEMORY, size);
+        if (memory == UX_NULL)
+            return(-1.0);
+        _ux_utility_memory_free(memory);
+    }
+    return((double)(clock() - start) * 1000000000.0 / CLOCKS_PER_SEC / UX_TEST_BENCH_LOOPS);
+}
+#endif
+
+static void  ux_test_thread_simulation_0_entry(ULONG arg)
+{
+#if defined(UX_ENABLE_MEMORY_SLAB)
+UX_MEMORY_BYTE_POOL     *pool_ptr = _ux_system -> ux_system_memory_byte_pool[UX_MEMORY_BYTE_POOL_REGULAR];
+UX_MEMORY_SLAB          *slab_ptr;
+UCHAR                   *memory0, *memory1, *memory2;
+ULONG                   available;
+ULONG                   i;
+double                  cold_ns, slab_ns;
+
+
+    /* Class sizes.  */
+    for (i = 0; i < UX_MEMORY_SLAB_CLASS_NUM; i ++)
+        UX_TEST_ASSERT(pool_ptr -> ux_byte_pool_slab[i].ux_memory_slab_size == ((ULONG)UX_MEMORY_SLAB_SIZE_MIN << i));
+
+    /* Free small block is cached and reused by allocation of same class.  */
+    slab_ptr = &pool_ptr -> ux_byte_pool_slab[2];
+    memory0 = _ux_utility_memory_allocate(UX_NO_ALIGN, UX_REGULAR_MEMORY, slab_ptr -> ux_memory_slab_size - 1);
+    UX_TEST_ASSERT(memory0 != UX_NULL);
+    _ux_utility_memory_set(memory0, 0x5A, slab_ptr -> ux_memory_slab_size);
+    available = pool_ptr -> ux_byte_pool_available;
+    _ux_utility_memory_free(memory0);
+    UX_TEST_ASSERT(pool_ptr -> ux_byte_pool_available == available);
+    UX_TEST_ASSERT(slab_ptr -> ux_memory_slab_cached == 1);
+    memory1 = _ux_utility_memory_allocate(UX_NO_ALIGN, UX_REGULAR_MEMORY, (slab_ptr - 1) -> ux_memory_slab_size + 1);
+    UX_TEST_ASSERT(memory1 == memory0);
+    UX_TEST_ASSERT(slab_ptr -> ux_memory_slab_cached == 0);
+    UX_TEST_ASSERT(pool_ptr -> ux_byte_pool_available == available);
+
+    /* Reused block is cleared.  */
+    for (i = 0; i < slab_ptr -> ux_memory_slab_size; i ++)
+        UX_TEST_ASSERT(memory1[i] == 0);
+
+    /* Other classes are not affected.  */
+    _ux_utility_memory_free(memory1);
+    memory2 = _ux_utility_memory_allocate(UX_NO_ALIGN, UX_REGULAR_MEMORY, slab_ptr -> ux_memory_slab_size + 1);
+    UX_TEST_ASSERT(memory2 != UX_NULL && memory2 != memory1);
+    UX_TEST_ASSERT(slab_ptr -> ux_memory_slab_cached == 1);
+    _ux_utility_memory_free(memory2);
+    UX_TEST_ASSERT((slab_ptr + 1) -> ux_memory_slab_cached == 1);
+
+    /* Aligned and large blocks are released to the pool.  */
+    available = pool_ptr -> ux_byte_pool_available;
+    memory0 = _ux_utility_memory_allocate(UX_ALIGN_64, UX_REGULAR_MEMORY, 20);
+    UX_TEST_ASSERT(memory0 != UX_NULL);
+    _ux_utility_memory_free(memory0);
+    memory0 = _ux_utility_memory_allocate(UX_NO_ALIGN, UX_REGULAR_MEMORY, UX_MEMORY_SLAB_SIZE_MAX + 1);
+    UX_TEST_ASSERT(memory0 != UX_NULL);
+    _ux_utility_memory_free(memory0);
+    UX_TEST_ASSERT(pool_ptr -> ux_byte_pool_available == available);
+
+    /* Double free of cached block is detected.  */
+    error_callback_ignore = UX_TRUE;
+    error_callback_counter = 0;
+    _ux_utility_memory_free(memory2);
+    UX_TEST_ASSERT(error_callback_counter == 1);
+    UX_TEST_ASSERT(error_callback_code == UX_MEMORY_CORRUPTED);
+    UX_TEST_ASSERT((slab_ptr + 1) -> ux_memory_slab_cached == 1);
+    error_callback_ignore = UX_FALSE;
+
+    /* Fill the pool with small blocks, free them all to the slab cache.  */
+    for (i = 0; i < UX_TEST_FRAGMENTS; i ++)
+    {
+        test_fragments[i] = _ux_utility_memory_allocate(UX_NO_ALIGN, UX_REGULAR_MEMORY, UX_MEMORY_SLAB_SIZE_MIN);
+        if (test_fragments[i] == UX_NULL)
+            break;
+    }
+    UX_TEST_ASSERT(i == UX_TEST_FRAGMENTS);
+    for (i = 0; i < UX_TEST_FRAGMENTS; i ++)
+        _ux_utility_memory_free(test_fragments[i]);
+    UX_TEST_ASSERT(pool_ptr -> ux_byte_pool_slab[0].ux_memory_slab_cached == UX_TEST_FRAGMENTS);
+
+    /* Allocation of block larger than available releases cached blocks.  */
+    memory0 = _ux_utility_memory_allocate(UX_NO_ALIGN, UX_REGULAR_MEMORY, pool_ptr -> ux_byte_pool_available + (UX_TEST_FRAGMENTS * UX_MEMORY_SLAB_SIZE_MIN / 2));
+    UX_TEST_ASSERT(memory0 != UX_NULL);
+    for (i = 0; i < UX_MEMORY_SLAB_CLASS_NUM; i ++)
+    {
+        UX_TEST_ASSERT(pool_ptr -> ux_byte_pool_slab[i].ux_memory_slab_cached == 0);
+        UX_TEST_ASSERT(pool_ptr -> ux_byte_pool_slab[i].ux_memory_slab_free_list == UX_NULL);
+    }
+    _ux_utility_memory_free(memory0);
+
+    /* Benchmark: allocate/free behind many small free fragments, aligned
+       allocations are used to bypass the slab cache.  */
+    for (i = 0; i < UX_TEST_FRAGMENTS; i ++)
+    {
+        test_fragments[i] = _ux_utility_memory_allocate(UX_ALIGN_16, UX_REGULAR_MEMORY, 40);
+        if (test_fragments[i] == UX_NULL)
+            break;
+    }
+    for (i = 0; i < UX_TEST_FRAGMENTS; i += 2)
+    {
+        if (test_fragments[i] != UX_NULL)
+        {
+            _ux_utility_memory_free(test_fragments[i]);
+            test_fragments[i] = UX_NULL;
+        }
+    }
+    cold_ns = test_alloc_free_ns(UX_MEMORY_SLAB_SIZE_MAX + 1);
+    slab_ns = test_alloc_free_ns(UX_MEMORY_SLAB_SIZE_MIN);
+    printf("\nalloc/free, pool %ld ns, slab %ld ns ... ", (long)cold_ns, (long)slab_ns);
+    for (i = 0; i < UX_TEST_FRAGMENTS; i ++)
+    {
+        if (test_fragments[i] != UX_NULL)
+            _ux_utility_memory_free(test_fragments[i]);
+    }
+#endif
+
+    /* Sleep for a tick to make sure everything is complete.  */
+    tx_thread_sleep(1);
+
+    /* Check for errors from other threads.  */
+    if (error_counter)
+    {
+
+        /* Test error.  */
+        printf("ERROR #%d: total %ld errors\n", __LINE__, error_counter);
+        test_control_return(1);
+    }
+    else
+    {
+
+        /* Successful test.  */
+        printf("SUCCESS!\n");
+        test_control_return(0);
+    }
+}
@@ -0,0 +1,281 @@
+/* This test is designed to test the memory telemetry of byte pools: latency and search
+   walk histograms, fragments and largest free block watermarks, allocation sites and dump.  */
+
+#include <stdio.h>
+#include <string.h>
+#include "tx_api.h"
+#include "ux_api.h"
+#include "ux_system.h"
+#include "ux_utility.h"
+
+#include "ux_test.h"
+
+
+/* Define USBX test constants.  */
+
+#define UX_TEST_STACK_SIZE      4096
+#define UX_TEST_MEMORY_SIZE     (64*1024)
+#define UX_TEST_CACHE_SAFE_SIZE (16*1024)
+
+#define UX_TEST_BLOCK_SIZE      1000
+#define UX_TEST_BLOCKS          8
+
+
+/* Define the counters used in the test application...  */
+
+static ULONG                           error_counter;
+
+static UCHAR                           error_callback_ignore = UX_FALSE;
+static ULONG                           error_callback_counter;
+
+static ULONG                           dump_lines;
+static ULONG                           dump_regular_lines;
+static ULONG                           dump_cache_safe_lines;
+static ULONG                           dump_site_lines;
+static ULONG                           dump_errors;
+
+
+/* Define prototypes for external Host Controller's (HCDs), classes and clients.  */
+
+static TX_THREAD           ux_test_thread_simulation_0;
+static void                ux_test_thread_simulation_0_entry(ULONG);
+
+
+/* Prototype for test control return.  */
+
+void  test_control_return(UINT status);
+
+
+static VOID error_callback(UINT system_level, UINT system_context, UINT error_code)
+{
+
+    error_callback_counter ++;
+
+    if (!error_callback_ignore)
+    {
+        {
+            /* Failed test.  */
+            printf("Error #%d, system_level: %d, system_context: %d, error_code: 0x%x\n", __LINE__, system_level, system_context, error_code);
+            // test_control_return(1);
+        }
+    }
+}
+
+
+/* Define what the initial system looks like.  */
+
+#ifdef CTEST
+void test_application_define(void *first_unused_memory)
+#else
+void    usbx_ux_utility_memory_telemetry_test_application_define(void *first_unused_memory)
+#endif
+{
+
+UINT status;
+CHAR                            *stack_pointer;
+CHAR                            *memory_pointer;
+
+    /* Inform user.  */
+#if !defined(UX_ENABLE_MEMORY_TELEMETRY)
+    printf("Running ux_utility_memory_ telemetry Test.......................SKIP SUCCESS!\n");
+    test_control_return(0);
+    return;
+#endif
+
+    printf("Running ux_utility_memory_ telemetry Test........................... ");
+
+    /* Initialize the free memory pointer.  */
+    stack_pointer = (CHAR *) first_unused_memory;
+    memory_pointer = stack_pointer + (UX_TEST_STACK_SIZE * 2);
+
+    /* Initialize USBX Memory, with separated cache safe pool.  */
+    status =  ux_system_initialize(memory_pointer, UX_TEST_MEMORY_SIZE,
+                                   memory_pointer + UX_TEST_MEMORY_SIZE, UX_TEST_CACHE_SAFE_SIZE);
+
+    /* Check for error.  */
+    if (status != UX_SUCCESS)
+    {
+
+        printf("ERROR #%d\n", __LINE__);
+        test_control_return(1);
+    }
+
+    /* Register the error callback. */
+    _ux_utility_error_callback_register(error_callback);
+
+    /* Create the simulation thread.  */
+    status =  tx_thread_create(&ux_test_thread_simulation_0, "test simulation", ux_test_thread_simulation_0_entry, 0,
+            stack_pointer, UX_TEST_STACK_SIZE,
+            20, 20, 1, TX_AUTO_START);
+
+    /* Check for error.  */
+    if (status != TX_SUCCESS)
+    {
+
+        printf("ERROR #%d\n", __LINE__);
+        test_control_return(1);
+    }
+}
+
+#if defined(UX_ENABLE_MEMORY_TELEMETRY)
+static VOID test_dump_callback(UCHAR *line, ULONG line_length)
+{
+
+    dump_lines ++;
+    if (line_length != strlen((char *)line) || line_length == 0)
+        dump_errors ++;
+    if (strncmp((char *)line, "regular pool: ", 14) == 0)
+        dump_regular_lines ++;
+    else if (strncmp((char *)line, "cache safe pool: ", 17) == 0)
+        dump_cache_safe_lines ++;
+    else
+        dump_errors ++;
+    if (strstr((char *)line, ": site 0x") != NULL)
+        dump_site_lines ++;
+}
+
+static ULONG test_histogram_sum(UX_MEMORY_HISTOGRAM *histogram)
+{
+ULONG           sum = 0;
+UINT            i;
+
+    for (i = 0; i < UX_MEMORY_TELEMETRY_HISTOGRAM_SIZE; i ++)
+        sum += histogram -> ux_memory_histogram_count[i];
+    return(sum);
+}
+#endif
+
+static void  ux_test_thread_simulation_0_entry(ULONG arg)
+{
+#if defined(UX_ENABLE_MEMORY_TELEMETRY)
+UX_MEMORY_TELEMETRY     telemetry;
+UX_MEMORY_HISTOGRAM     histogram;
+UX_MEMORY_BYTE_POOL     *pool_ptr = _ux_system -> ux_system_memory_byte_pool[UX_MEMORY_BYTE_POOL_REGULAR];
+UCHAR                   *blocks[UX_TEST_BLOCKS];
+UCHAR                   *memory;
+ULONG                   largest;
+ULONG                   free_blocks;
+ULONG                   i;
+UINT                    status;
+
+
+    /* Histogram buckets by number of significant bits.  */
+    _ux_utility_memory_set(&histogram, 0, sizeof(histogram));
+    _ux_utility_memory_telemetry_histogram_add(&histogram, 0);
+    _ux_utility_memory_telemetry_histogram_add(&histogram, 1);
+    _ux_utility_memory_telemetry_histogram_add(&histogram, 2);
+    _ux_utility_memory_telemetry_histogram_add(&histogram, 3);
+    _ux_utility_memory_telemetry_histogram_add(&histogram, 4);
+    _ux_utility_memory_telemetry_histogram_add(&histogram, 0xFFFFFFFF);
+    UX_TEST_ASSERT(histogram.ux_memory_histogram_count[0] == 1);
+    UX_TEST_ASSERT(histogram.ux_memory_histogram_count[1] == 1);
+    UX_TEST_ASSERT(histogram.ux_memory_histogram_count[2] == 2);
+    UX_TEST_ASSERT(histogram.ux_memory_histogram_count[3] == 1);
+    UX_TEST_ASSERT(histogram.ux_memory_histogram_count[UX_MEMORY_TELEMETRY_HISTOGRAM_SIZE - 1] == 1);
+    UX_TEST_ASSERT(histogram.ux_memory_histogram_max == 0xFFFFFFFF);
+
+    /* Invalid parameters.  */
+    UX_TEST_ASSERT(_ux_utility_memory_telemetry_get(0xFF, &telemetry) == UX_INVALID_PARAMETER);
+    UX_TEST_ASSERT(_ux_utility_memory_telemetry_get(UX_REGULAR_MEMORY, UX_NULL) == UX_INVALID_PARAMETER);
+    UX_TEST_ASSERT(_ux_utility_memory_telemetry_reset(0xFF) == UX_INVALID_PARAMETER);
+
+    /* Reset, watermarks start from current pool.  */
+    status = _ux_utility_memory_telemetry_reset(UX_REGULAR_MEMORY);
+    UX_TEST_ASSERT(status == UX_SUCCESS);
+    status = _ux_utility_memory_telemetry_get(UX_REGULAR_MEMORY, &telemetry);
+    UX_TEST_ASSERT(status == UX_SUCCESS);
+    UX_TEST_ASSERT(telemetry.ux_memory_telemetry_alloc_count == 0);
+    UX_TEST_ASSERT(telemetry.ux_memory_telemetry_fail_count == 0);
+    UX_TEST_ASSERT(telemetry.ux_memory_telemetry_fragments == pool_ptr -> ux_byte_pool_fragments);
+    UX_TEST_ASSERT(telemetry.ux_memory_telemetry_fragments_max == pool_ptr -> ux_byte_pool_fragments);
+    UX_TEST_ASSERT(telemetry.ux_memory_telemetry_largest_free == telemetry.ux_memory_telemetry_largest_free_min);
+    UX_TEST_ASSERT(telemetry.ux_memory_telemetry_largest_free < pool_ptr -> ux_byte_pool_available);
+    UX_TEST_ASSERT(test_histogram_sum(&telemetry.ux_memory_telemetry_latency) == 0);
+    UX_TEST_ASSERT(test_histogram_sum(&telemetry.ux_memory_telemetry_walk) == 0);
+    largest = telemetry.ux_memory_telemetry_largest_free;
+    free_blocks = telemetry.ux_memory_telemetry_free_blocks;
+
+    /* Allocations are logged with their latency, search walk and site.  */
+    for (i = 0; i < UX_TEST_BLOCKS; i ++)
+    {
+        blocks[i] = _ux_utility_memory_allocate(UX_NO_ALIGN, UX_REGULAR_MEMORY, UX_TEST_BLOCK_SIZE);
+        UX_TEST_ASSERT(blocks[i] != UX_NULL);
+    }
+    status = _ux_utility_memory_telemetry_get(UX_REGULAR_MEMORY, &telemetry);
+    UX_TEST_ASSERT(status == UX_SUCCESS);
+    UX_TEST_ASSERT(telemetry.ux_memory_telemetry_alloc_count == UX_TEST_BLOCKS);
+    UX_TEST_ASSERT(test_histogram_sum(&telemetry.ux_memory_telemetry_latency) == UX_TEST_BLOCKS);
+    UX_TEST_ASSERT(test_histogram_sum(&telemetry.ux_memory_telemetry_walk) == UX_TEST_BLOCKS);
+    UX_TEST_ASSERT(telemetry.ux_memory_telemetry_walk.ux_memory_histogram_max >= 1);
+    UX_TEST_ASSERT(telemetry.ux_memory_telemetry_fragments == pool_ptr -> ux_byte_pool_fragments);
+    UX_TEST_ASSERT(telemetry.ux_memory_telemetry_fragments_max >= pool_ptr -> ux_byte_pool_fragments);
+    UX_TEST_ASSERT(telemetry.ux_memory_telemetry_largest_free <= largest - UX_TEST_BLOCKS * UX_TEST_BLOCK_SIZE);
+    UX_TEST_ASSERT(telemetry.ux_memory_telemetry_largest_free_min == telemetry.ux_memory_telemetry_largest_free);
+    UX_TEST_ASSERT(telemetry.ux_memory_telemetry_sites[0].ux_memory_telemetry_site_alloc_count == UX_TEST_BLOCKS);
+    UX_TEST_ASSERT(telemetry.ux_memory_telemetry_sites[0].ux_memory_telemetry_site_alloc_total == UX_TEST_BLOCKS * UX_TEST_BLOCK_SIZE);
+    UX_TEST_ASSERT(telemetry.ux_memory_telemetry_sites[0].ux_memory_telemetry_site_alloc_max == UX_TEST_BLOCK_SIZE);
+    UX_TEST_ASSERT(telemetry.ux_memory_telemetry_sites[1].ux_memory_telemetry_site_alloc_count == 0);
+
+    /* Freed blocks between allocated ones are free blocks, the largest one is kept.  */
+    for (i = 0; i < UX_TEST_BLOCKS - 1; i += 2)
+        _ux_utility_memory_free(blocks[i]);
+    status = _ux_utility_memory_telemetry_get(UX_REGULAR_MEMORY, &telemetry);
+    UX_TEST_ASSERT(status == UX_SUCCESS);
+    UX_TEST_ASSERT(telemetry.ux_memory_telemetry_free_blocks == free_blocks + UX_TEST_BLOCKS / 2);
+    UX_TEST_ASSERT(telemetry.ux_memory_telemetry_largest_free_min <= telemetry.ux_memory_telemetry_largest_free);
+
+    /* Failure is logged, with the largest free block.  */
+    error_callback_ignore = UX_TRUE;
+    error_callback_counter = 0;
+    memory = _ux_utility_memory_allocate(UX_NO_ALIGN, UX_REGULAR_MEMORY, UX_TEST_MEMORY_SIZE);
+    UX_TEST_ASSERT(memory == UX_NULL);
+    UX_TEST_ASSERT(error_callback_counter == 1);
+    error_callback_ignore = UX_FALSE;
+    status = _ux_utility_memory_telemetry_get(UX_REGULAR_MEMORY, &telemetry);
+    UX_TEST_ASSERT(status == UX_SUCCESS);
+    UX_TEST_ASSERT(telemetry.ux_memory_telemetry_fail_count == 1);
+    UX_TEST_ASSERT(telemetry.ux_memory_telemetry_sites[0].ux_memory_telemetry_site_fail_count == 1);
+    UX_TEST_ASSERT(telemetry.ux_memory_telemetry_sites[0].ux_memory_telemetry_site_alloc_max == UX_TEST_MEMORY_SIZE);
+    UX_TEST_ASSERT(test_histogram_sum(&telemetry.ux_memory_telemetry_latency) == UX_TEST_BLOCKS + 1);
+
+    /* Cache safe pool is logged separately.  */
+    memory = _ux_utility_memory_allocate(UX_NO_ALIGN, UX_CACHE_SAFE_MEMORY, UX_TEST_BLOCK_SIZE);
+    UX_TEST_ASSERT(memory != UX_NULL);
+    status = _ux_utility_memory_telemetry_get(UX_CACHE_SAFE_MEMORY, &telemetry);
+    UX_TEST_ASSERT(status == UX_SUCCESS);
+    UX_TEST_ASSERT(telemetry.ux_memory_telemetry_alloc_count >= 1);
+    UX_TEST_ASSERT(telemetry.ux_memory_telemetry_largest_free < UX_TEST_CACHE_SAFE_SIZE - UX_TEST_BLOCK_SIZE);
+
+    /* Dump lines of both pools.  */
+    _ux_utility_memory_telemetry_dump(test_dump_callback);
+    UX_TEST_ASSERT(dump_errors == 0);
+    UX_TEST_ASSERT(dump_regular_lines > 0);
+    UX_TEST_ASSERT(dump_cache_safe_lines > 0);
+    UX_TEST_ASSERT(dump_site_lines >= 2);
+    UX_TEST_ASSERT(dump_lines == dump_regular_lines + dump_cache_safe_lines);
+    _ux_utility_memory_telemetry_dump(UX_NULL);
+
+    /* Release all.  */
+    _ux_utility_memory_free(memory);
+    for (i = 1; i < UX_TEST_BLOCKS; i += 2)
+        _ux_utility_memory_free(blocks[i]);
+#endif
+
+    /* Check for errors.  */
+    if (error_counter)
+    {
+
+        /* Test error.  */
+        printf("ERROR #%d: total %ld errors\n", __LINE__, error_counter);
+        test_control_return(1);
+    }
+    else
+    {
+
+        /* Successful test.  */
+        printf("SUCCESS!\n");
+        test_control_return(0);
+    }
+
+    return;
+}
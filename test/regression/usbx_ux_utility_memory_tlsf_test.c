@@ -0,0 +1,421 @@
+/* This test is designed to test the TLSF memory pool in ux_utility_memory_allocate/free,
+   and to compare allocate/free costs on pools with increasing fragmentation.  */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "tx_api.h"
+#include "ux_api.h"
+#include "ux_system.h"
+#include "ux_utility.h"
+
+#include "ux_test.h"
+
+
+/* Define USBX test constants.  */
+
+#define UX_TEST_STACK_SIZE      4096
+#define UX_TEST_MEMORY_SIZE     (128*1024)
+#define UX_TEST_CACHE_SAFE_SIZE (16*1024)
+
+#define UX_TEST_BLOCKS          512
+#define UX_TEST_STRESS_LOOPS    20000
+#define UX_TEST_BENCH_LOOPS     20000
+
+
+/* Define the counters used in the test application...  */
+
+static ULONG                           error_counter;
+
+static UCHAR                           error_callback_ignore = UX_FALSE;
+static ULONG                           error_callback_counter;
+
+static UCHAR                           *test_blocks[UX_TEST_BLOCKS];
+static ULONG                           test_sizes[UX_TEST_BLOCKS];
+
+
+/* Define prototypes for external Host Controller's (HCDs), classes and clients.  */
+
+static TX_THREAD           ux_test_thread_simulation_0;
+static void                ux_test_thread_simulation_0_entry(ULONG);
+
+
+/* Prototype for test control return.  */
+
+void  test_control_return(UINT status);
+
+
+static VOID error_callback(UINT system_level, UINT system_context, UINT error_code)
+{
+
+    error_callback_counter ++;
+
+    if (!error_callback_ignore)
+    {
+        {
+            /* Failed test.  */
+            printf("Error #%d, system_level: %d, system_context: %d, error_code: 0x%x\n", __LINE__, system_level, system_context, error_code);
+            // test_control_return(1);
+        }
+    }
+}
+
+
+/* Define what the initial system looks like.  */
+
+#ifdef CTEST
+void test_application_define(void *first_unused_memory)
+#else
+void    usbx_ux_utility_memory_tlsf_test_application_define(void *first_unused_memory)
+#endif
+{
+
+UINT status;
+CHAR                            *stack_pointer;
+CHAR                            *memory_pointer;
+
+    /* Inform user.  */
+#if !defined(UX_ENABLE_MEMORY_TLSF)
+    printf("Running ux_utility_memory_ TLSF Test............................SKIP SUCCESS!\n");
+    test_control_return(0);
+    return;
+#endif
+
+    printf("Running ux_utility_memory_ TLSF Test................................ ");
+
+    /* Initialize the free memory pointer.  */
+    stack_pointer = (CHAR *) first_unused_memory;
+    memory_pointer = stack_pointer + (UX_TEST_STACK_SIZE * 2);
+
+    /* Initialize USBX Memory.  */
+    status =  ux_system_initialize(memory_pointer, UX_TEST_MEMORY_SIZE,
+                                   memory_pointer + UX_TEST_MEMORY_SIZE, UX_TEST_CACHE_SAFE_SIZE);
+
+    /* Check for error.  */
+    if (status != UX_SUCCESS)
+    {
+
+        printf("ERROR #%d\n", __LINE__);
+        test_control_return(1);
+    }
+
+    /* Register the error callback. */
+    _ux_utility_error_callback_register(error_callback);
+
+    /* Create the simulation thread.  */
+    status =  tx_thread_create(&ux_test_thread_simulation_0, "test simulation", ux_test_thread_simulation_0_entry, 0,
+            stack_pointer, UX_TEST_STACK_SIZE,
+            20, 20, 1, TX_AUTO_START);
+
+    /* Check for error.  */
+    if (status != TX_SUCCESS)
+    {
+
+        printf("ERROR #%d\n", __LINE__);
+        test_control_return(1);
+    }
+}
+
+#if defined(UX_ENABLE_MEMORY_TLSF)
+
+/* Walk the pool, check physical links, free lists and counters, return number of free blocks.  */
+static ULONG test_pool_check(UX_MEMORY_BYTE_POOL *pool_ptr)
+{
+UCHAR           *block_ptr;
+UCHAR           *next_ptr;
+UCHAR           *prev_ptr = UX_NULL;
+UCHAR           *list_ptr;
+UCHAR           **links;
+ALIGN_TYPE      owner;
+ALIGN_TYPE      prev_owner = 0;
+ULONG           free_blocks = 0;
+ULONG           tiny_blocks = 0;
+ULONG           listed_blocks = 0;
+ULONG           free_bytes = 0;
+ULONG           blocks = 0;
+UINT            fl, sl;
+
+#if defined(UX_ENABLE_MEMORY_SLAB)
+
+    /* Blocks cached by slab size classes are released to the pool first.  */
+    _ux_utility_memory_slab_flush(pool_ptr);
+#endif
+
+    block_ptr = pool_ptr -> ux_byte_pool_start;
+    while(1)
+    {
+        links = (UCHAR **)block_ptr;
+        next_ptr = links[0];
+        owner = *(ALIGN_TYPE *)(block_ptr + sizeof(UCHAR *));
+
+        /* Physical previous link.  */
+        UX_TEST_ASSERT(*(UCHAR **)(block_ptr + UX_MEMORY_BLOCK_PREV_OFFSET) == prev_ptr);
+
+        /* Sentinel at the end of pool.  */
+        if (next_ptr == pool_ptr -> ux_byte_pool_start)
+        {
+            UX_TEST_ASSERT(block_ptr == pool_ptr -> ux_byte_pool_start + pool_ptr -> ux_byte_pool_size - UX_MEMORY_BLOCK_HEADER_SIZE);
+            break;
+        }
+        UX_TEST_ASSERT(next_ptr > block_ptr);
+        blocks ++;
+
+        if (owner == UX_BYTE_BLOCK_FREE)
+        {
+
+            /* Free blocks are always merged.  */
+            UX_TEST_ASSERT(prev_owner != UX_BYTE_BLOCK_FREE);
+            free_blocks ++;
+            free_bytes += (ULONG)(next_ptr - block_ptr);
+
+            /* Too small blocks (alignment pads) are not listed.  */
+            if ((ULONG)(next_ptr - block_ptr) < UX_BYTE_BLOCK_MIN)
+                tiny_blocks ++;
+        }
+        prev_owner = owner;
+        prev_ptr = block_ptr;
+        block_ptr = next_ptr;
+    }
+
+    /* Free blocks are listed in the right list, bitmaps are consistent.  */
+    for (fl = 0; fl < UX_MEMORY_TLSF_FL_COUNT; fl ++)
+    {
+        UX_TEST_ASSERT(((pool_ptr -> ux_byte_pool_tlsf_fl_bitmap >> fl) & 1u) == (pool_ptr -> ux_byte_pool_tlsf_sl_bitmap[fl] != 0));
+        for (sl = 0; sl < UX_MEMORY_TLSF_SL_COUNT; sl ++)
+        {
+            list_ptr = pool_ptr -> ux_byte_pool_tlsf_free[fl][sl];
+            UX_TEST_ASSERT(((pool_ptr -> ux_byte_pool_tlsf_sl_bitmap[fl] >> sl) & 1u) == (list_ptr != UX_NULL));
+            while(list_ptr != UX_NULL)
+            {
+                UINT map_fl, map_sl;
+                _ux_utility_memory_tlsf_mapping((ULONG)(*(UCHAR **)list_ptr - list_ptr) - UX_MEMORY_BLOCK_HEADER_SIZE, UX_FALSE, &map_fl, &map_sl);
+                UX_TEST_ASSERT(map_fl == fl && map_sl == sl);
+                UX_TEST_ASSERT(*(ALIGN_TYPE *)(list_ptr + sizeof(UCHAR *)) == UX_BYTE_BLOCK_FREE);
+                listed_blocks ++;
+                list_ptr = ((UCHAR **)(list_ptr + UX_MEMORY_BLOCK_HEADER_SIZE))[0];
+            }
+        }
+    }
+    UX_TEST_ASSERT(listed_blocks + tiny_blocks == free_blocks);
+    UX_TEST_ASSERT(free_bytes == pool_ptr -> ux_byte_pool_available);
+    UX_TEST_ASSERT(blocks + 1 == pool_ptr -> ux_byte_pool_fragments);
+    return(free_blocks);
+}
+
+static double test_alloc_free_ns(ULONG size)
+{
+clock_t         start;
+ULONG           i;
+VOID            *memory;
+
+    start = clock();
+    for (i = 0; i < UX_TEST_BENCH_LOOPS; i ++)
+    {
+        memory = _ux_utility_memory_allocate(UX_NO_ALIGN, UX_REGULAR_MEMORY, size);
+        if (memory == UX_NULL)
+            return(-1.0);
+        _ux_utility_memory_free(memory);
+    }
+    return((double)(clock() - start) * 1000000000.0 / CLOCKS_PER_SEC / UX_TEST_BENCH_LOOPS);
+}
+#endif
+
+static void  ux_test_thread_simulation_0_entry(ULONG arg)
+{
+#if defined(UX_ENABLE_MEMORY_TLSF)
+UX_MEMORY_BYTE_POOL     *pool_ptr = _ux_system -> ux_system_memory_byte_pool[UX_MEMORY_BYTE_POOL_REGULAR];
+UX_MEMORY_BYTE_POOL     *cache_safe_ptr = _ux_system -> ux_system_memory_byte_pool[UX_MEMORY_BYTE_POOL_CACHE_SAFE];
+UCHAR                   *memory0, *memory1, *memory2;
+ULONG                   available, fragments;
+ULONG                   i, j, alignment;
+UINT                    fl, sl;
+double                  ns;
+
+
+    /* Size mapping, small sizes are linear, larger sizes are by power of two and sub ranges.  */
+    _ux_utility_memory_tlsf_mapping(8, UX_FALSE, &fl, &sl);
+    UX_TEST_ASSERT(fl == 0 && sl == 1);
+    _ux_utility_memory_tlsf_mapping(41, UX_TRUE, &fl, &sl);
+    UX_TEST_ASSERT(fl == 0 && sl == 6);
+    _ux_utility_memory_tlsf_mapping((1u << UX_MEMORY_TLSF_FL_SHIFT) - 1, UX_TRUE, &fl, &sl);
+    UX_TEST_ASSERT(fl == 1 && sl == 0);
+    _ux_utility_memory_tlsf_mapping((1u << UX_MEMORY_TLSF_FL_SHIFT), UX_FALSE, &fl, &sl);
+    UX_TEST_ASSERT(fl == 1 && sl == 0);
+    _ux_utility_memory_tlsf_mapping((1u << UX_MEMORY_TLSF_FL_SHIFT) + 1, UX_TRUE, &fl, &sl);
+    UX_TEST_ASSERT(fl == 1 && sl == 1);
+    _ux_utility_memory_tlsf_mapping(0xFFFFFFFFu, UX_FALSE, &fl, &sl);
+    UX_TEST_ASSERT(fl == UX_MEMORY_TLSF_FL_COUNT - 1 && sl == UX_MEMORY_TLSF_SL_COUNT - 1);
+    UX_TEST_ASSERT(_ux_utility_memory_tlsf_fls(1) == 0);
+    UX_TEST_ASSERT(_ux_utility_memory_tlsf_fls(0x80000000u) == 31);
+    UX_TEST_ASSERT(_ux_utility_memory_tlsf_fls(0x00012345u) == 16);
+
+    /* Pools are initialized as single free blocks.  */
+    UX_TEST_ASSERT(test_pool_check(pool_ptr) == 1);
+    UX_TEST_ASSERT(test_pool_check(cache_safe_ptr) == 1);
+    available = pool_ptr -> ux_byte_pool_available;
+    fragments = pool_ptr -> ux_byte_pool_fragments;
+
+    /* Allocate and free in different orders, blocks are merged back to single free block.  */
+    memory0 = _ux_utility_memory_allocate(UX_NO_ALIGN, UX_REGULAR_MEMORY, 100);
+    memory1 = _ux_utility_memory_allocate(UX_NO_ALIGN, UX_REGULAR_MEMORY, 200);
+    memory2 = _ux_utility_memory_allocate(UX_NO_ALIGN, UX_REGULAR_MEMORY, 300);
+    UX_TEST_ASSERT(memory0 != UX_NULL && memory1 != UX_NULL && memory2 != UX_NULL);
+    UX_TEST_ASSERT(test_pool_check(pool_ptr) == 1);
+    _ux_utility_memory_free(memory1);
+    UX_TEST_ASSERT(test_pool_check(pool_ptr) == 2);
+    _ux_utility_memory_free(memory0);
+    UX_TEST_ASSERT(test_pool_check(pool_ptr) == 2);
+    _ux_utility_memory_free(memory2);
+    UX_TEST_ASSERT(test_pool_check(pool_ptr) == 1);
+    UX_TEST_ASSERT(pool_ptr -> ux_byte_pool_available == available);
+    UX_TEST_ASSERT(pool_ptr -> ux_byte_pool_fragments == fragments);
+
+    /* Freed block is reused by allocation of same size.  */
+    memory0 = _ux_utility_memory_allocate(UX_NO_ALIGN, UX_REGULAR_MEMORY, 64);
+    memory1 = _ux_utility_memory_allocate(UX_NO_ALIGN, UX_REGULAR_MEMORY, 64);
+    _ux_utility_memory_free(memory0);
+    memory2 = _ux_utility_memory_allocate(UX_NO_ALIGN, UX_REGULAR_MEMORY, 64);
+    UX_TEST_ASSERT(memory2 == memory0);
+    _ux_utility_memory_free(memory2);
+    _ux_utility_memory_free(memory1);
+    UX_TEST_ASSERT(test_pool_check(pool_ptr) == 1);
+
+    /* Aligned allocations, in regular and cache safe pools.  */
+    for (alignment = UX_ALIGN_8; alignment <= UX_ALIGN_2048; alignment = (alignment << 1) | 1)
+    {
+        memory0 = _ux_utility_memory_allocate(UX_NO_ALIGN, UX_REGULAR_MEMORY, 24);
+        memory1 = _ux_utility_memory_allocate(alignment, UX_REGULAR_MEMORY, 40);
+        memory2 = _ux_utility_memory_allocate(alignment, UX_CACHE_SAFE_MEMORY, 40);
+        UX_TEST_ASSERT(memory1 != UX_NULL && ((ALIGN_TYPE)memory1 & alignment) == 0);
+        UX_TEST_ASSERT(memory2 != UX_NULL && ((ALIGN_TYPE)memory2 & alignment) == 0);
+        test_pool_check(pool_ptr);
+        test_pool_check(cache_safe_ptr);
+        _ux_utility_memory_free(memory1);
+        _ux_utility_memory_free(memory0);
+        _ux_utility_memory_free(memory2);
+        UX_TEST_ASSERT(test_pool_check(pool_ptr) == 1);
+        UX_TEST_ASSERT(test_pool_check(cache_safe_ptr) == 1);
+    }
+    UX_TEST_ASSERT(pool_ptr -> ux_byte_pool_available == available);
+
+    /* Pool exhausted and refilled, the whole pool can be allocated as one block again.  */
+    error_callback_ignore = UX_TRUE;
+    error_callback_counter = 0;
+    for (i = 0; i < UX_TEST_BLOCKS; i ++)
+    {
+        test_blocks[i] = _ux_utility_memory_allocate(UX_NO_ALIGN, UX_REGULAR_MEMORY, 1024);
+        if (test_blocks[i] == UX_NULL)
+            break;
+    }
+    UX_TEST_ASSERT(i < UX_TEST_BLOCKS);
+    UX_TEST_ASSERT(error_callback_counter == 1);
+    for (j = 0; j < i; j += 2)
+    {
+        _ux_utility_memory_free(test_blocks[j]);
+        test_blocks[j] = UX_NULL;
+    }
+    test_pool_check(pool_ptr);
+    for (j = 1; j < i; j += 2)
+    {
+        _ux_utility_memory_free(test_blocks[j]);
+        test_blocks[j] = UX_NULL;
+    }
+    UX_TEST_ASSERT(test_pool_check(pool_ptr) == 1);
+    error_callback_ignore = UX_FALSE;
+    memory0 = _ux_utility_memory_allocate(UX_NO_ALIGN, UX_REGULAR_MEMORY, available - UX_MEMORY_BLOCK_HEADER_SIZE * 2);
+    UX_TEST_ASSERT(memory0 != UX_NULL);
+    _ux_utility_memory_free(memory0);
+
+    /* Double free is detected.  */
+    error_callback_ignore = UX_TRUE;
+    error_callback_counter = 0;
+    _ux_utility_memory_free(memory0);
+    UX_TEST_ASSERT(error_callback_counter == 1);
+    UX_TEST_ASSERT(test_pool_check(pool_ptr) == 1);
+    error_callback_ignore = UX_FALSE;
+
+    /* Random allocate/free with random sizes and alignments.  */
+    srand(1);
+    for (i = 0; i < UX_TEST_STRESS_LOOPS; i ++)
+    {
+        j = (ULONG)rand() % UX_TEST_BLOCKS;
+        if (test_blocks[j] == UX_NULL)
+        {
+            test_sizes[j] = 1 + (ULONG)rand() % ((rand() & 7) ? 128 : 1024);
+            alignment = (rand() & 3) ? UX_NO_ALIGN : (UX_ALIGN_16 << (rand() % 4)) | UX_ALIGN_16;
+            test_blocks[j] = _ux_utility_memory_allocate(alignment, UX_REGULAR_MEMORY, test_sizes[j]);
+            if (test_blocks[j] != UX_NULL)
+            {
+                UX_TEST_ASSERT(alignment == UX_NO_ALIGN || ((ALIGN_TYPE)test_blocks[j] & alignment) == 0);
+                _ux_utility_memory_set(test_blocks[j], (UCHAR)j, test_sizes[j]);
+            }
+        }
+        else
+        {
+            for (alignment = 0; alignment < test_sizes[j]; alignment ++)
+                UX_TEST_ASSERT(test_blocks[j][alignment] == (UCHAR)j);
+            _ux_utility_memory_free(test_blocks[j]);
+            test_blocks[j] = UX_NULL;
+        }
+        if ((i % 256) == 0)
+            test_pool_check(pool_ptr);
+    }
+    for (j = 0; j < UX_TEST_BLOCKS; j ++)
+    {
+        if (test_blocks[j] != UX_NULL)
+        {
+            _ux_utility_memory_free(test_blocks[j]);
+            test_blocks[j] = UX_NULL;
+        }
+    }
+    UX_TEST_ASSERT(test_pool_check(pool_ptr) == 1);
+    UX_TEST_ASSERT(pool_ptr -> ux_byte_pool_available == available);
+    UX_TEST_ASSERT(pool_ptr -> ux_byte_pool_fragments == fragments);
+#if defined(UX_ENABLE_MEMORY_TELEMETRY)
+
+    /* Each search checks one block at most.  */
+    UX_TEST_ASSERT(pool_ptr -> ux_byte_pool_telemetry.ux_memory_telemetry_walk.ux_memory_histogram_max == 1);
+#endif
+
+    /* Benchmark: allocate/free of a large block behind increasing number of small free fragments.  */
+    printf("\n%-12s %12s\n", "Fragments", "ns");
+    for (i = 0; i <= UX_TEST_BLOCKS / 2; i = (i == 0) ? 16 : i * 4)
+    {
+        for (j = 0; j < i * 2; j ++)
+            test_blocks[j] = _ux_utility_memory_allocate(UX_NO_ALIGN, UX_REGULAR_MEMORY, 40);
+        for (j = 0; j < i * 2; j += 2)
+        {
+            _ux_utility_memory_free(test_blocks[j]);
+            test_blocks[j] = UX_NULL;
+        }
+        ns = test_alloc_free_ns(4096);
+        UX_TEST_ASSERT(ns >= 0);
+        printf("%-12lu %12.1f\n", i, ns);
+        for (j = 1; j < i * 2; j += 2)
+        {
+            _ux_utility_memory_free(test_blocks[j]);
+            test_blocks[j] = UX_NULL;
+        }
+    }
+    UX_TEST_ASSERT(test_pool_check(pool_ptr) == 1);
+#endif
+
+    /* Sleep for a tick to make sure everything is complete.  */
+    tx_thread_sleep(1);
+
+    /* Check for errors from other threads.  */
+    if (error_counter)
+    {
+
+        /* Test error.  */
+        printf("ERROR #%d: total %ld errors\n", __LINE__, error_counter);
+        test_control_return(1);
+    }
+    else
+    {
+
+        /* Successful test.  */
+        printf("SUCCESS!\n");
+        test_control_return(0);
+    }
+}
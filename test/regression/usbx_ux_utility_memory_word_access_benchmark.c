@@ -0,0 +1,227 @@
+/* This benchmark compares the costs of ux_utility_memory_copy/set/compare against
+   byte by byte loops, on aligned buffers of 8 to 16K bytes. The same amount of
+   data is processed for each size.  */
+
+#include <stdio.h>
+#include <time.h>
+#include "tx_api.h"
+#include "ux_api.h"
+#include "ux_system.h"
+#include "ux_utility.h"
+
+#include "ux_test.h"
+
+
+/* Define USBX test constants.  */
+
+#define UX_TEST_STACK_SIZE      4096
+#define UX_TEST_MEMORY_SIZE     (64*1024)
+
+#define UX_TEST_BUFFER_SIZE     (16*1024)
+#define UX_TEST_BENCH_BYTES     (16*1024*1024)
+
+/* Define the counters used in the test application...  */
+
+static ULONG                           error_counter;
+
+static UCHAR                           error_callback_ignore = UX_FALSE;
+static ULONG                           error_callback_counter;
+
+static UCHAR                           test_source[UX_TEST_BUFFER_SIZE];
+static UCHAR                           test_destination[UX_TEST_BUFFER_SIZE];
+
+static const ULONG                     test_bench_sizes[] = {8, 64, 512, 16*1024};
+
+
+/* Define prototypes for external Host Controller's (HCDs), classes and clients.  */
+
+static TX_THREAD           ux_test_thread_simulation_0;
+static void                ux_test_thread_simulation_0_entry(ULONG);
+
+
+/* Prototype for test control return.  */
+
+void  test_control_return(UINT status);
+
+
+static VOID error_callback(UINT system_level, UINT system_context, UINT error_code)
+{
+
+    error_callback_counter ++;
+
+    if (!error_callback_ignore)
+    {
+        {
+            /* Failed test.  */
+            printf("Error #%d, system_level: %d, system_context: %d, error_code: 0x%x\n", __LINE__, system_level, system_context, error_code);
+            // test_control_return(1);
+        }
+    }
+}
+
+
+/* Byte by byte references, as the original implementation.  */
+
+static VOID test_byte_copy(VOID *memory_destination, VOID *memory_source, ULONG length)
+{
+volatile UCHAR  *destination = (volatile UCHAR *)memory_destination;
+UCHAR           *source = (UCHAR *)memory_source;
+
+    while(length--)
+        *destination++ = *source++;
+}
+
+static VOID test_byte_set(VOID *memory_destination, UCHAR value, ULONG length)
+{
+volatile UCHAR  *destination = (volatile UCHAR *)memory_destination;
+
+    while(length--)
+        *destination++ = value;
+}
+
+static UINT test_byte_compare(VOID *memory_source, VOID *memory_destination, ULONG length)
+{
+volatile UCHAR  *destination = (volatile UCHAR *)memory_destination;
+UCHAR           *source = (UCHAR *)memory_source;
+
+    while(length--)
+    {
+        if (*destination++ != *source++)
+            return(UX_ERROR);
+    }
+    return(UX_SUCCESS);
+}
+
+static VOID test_buffers_fill(VOID)
+{
+ULONG   i;
+
+    for (i = 0; i < UX_TEST_BUFFER_SIZE; i ++)
+        test_source[i] = (UCHAR)(i * 7 + 3);
+}
+
+static double test_elapsed_ns(clock_t start, ULONG loops)
+{
+    return((double)(clock() - start) * 1000000000.0 / CLOCKS_PER_SEC / (double)loops);
+}
+
+
+/* Define what the initial system looks like.  */
+
+#ifdef CTEST
+void test_application_define(void *first_unused_memory)
+#else
+void    usbx_ux_utility_memory_word_access_benchmark_application_define(void *first_unused_memory)
+#endif
+{
+
+UINT status;
+CHAR                            *stack_pointer;
+CHAR                            *memory_pointer;
+
+    /* Inform user.  */
+    printf("Running ux_utility_memory_ word access Benchmark.................... ");
+
+    /* Initialize the free memory pointer.  */
+    stack_pointer = (CHAR *) first_unused_memory;
+    memory_pointer = stack_pointer + (UX_TEST_STACK_SIZE * 2);
+
+    /* Initialize USBX Memory.  */
+    status =  ux_system_initialize(memory_pointer, UX_TEST_MEMORY_SIZE, UX_NULL, 0);
+
+    /* Check for error.  */
+    if (status != UX_SUCCESS)
+    {
+
+        printf("ERROR #%d\n", __LINE__);
+        test_control_return(1);
+    }
+
+    /* Register the error callback. */
+    _ux_utility_error_callback_register(error_callback);
+
+    /* Create the simulation thread.  */
+    status =  tx_thread_create(&ux_test_thread_simulation_0, "test simulation", ux_test_thread_simulation_0_entry, 0,
+            stack_pointer, UX_TEST_STACK_SIZE,
+            20, 20, 1, TX_AUTO_START);
+
+    /* Check for error.  */
+    if (status != TX_SUCCESS)
+    {
+
+        printf("ERROR #%d\n", __LINE__);
+        test_control_return(1);
+    }
+}
+
+static void  ux_test_thread_simulation_0_entry(ULONG arg)
+{
+
+ULONG           length;
+ULONG           i, loops, n;
+clock_t         start;
+double          byte_ns, word_ns;
+
+
+    /* Fill the source buffer.  */
+    test_buffers_fill();
+
+    /* Benchmark, aligned buffers, same amount of data for each size.  */
+    printf("\n");
+    printf("%-8s %8s %12s %12s\n", "Op", "Size", "Byte(ns)", "Word(ns)");
+    for (n = 0; n < sizeof(test_bench_sizes) / sizeof(test_bench_sizes[0]); n ++)
+    {
+        length = test_bench_sizes[n];
+        loops = UX_TEST_BENCH_BYTES / length;
+
+        start = clock();
+        for (i = 0; i < loops; i ++)
+            test_byte_copy(test_destination, test_source, length);
+        byte_ns = test_elapsed_ns(start, loops);
+        start = clock();
+        for (i = 0; i < loops; i ++)
+            _ux_utility_memory_copy(test_destination, test_source, length);
+        word_ns = test_elapsed_ns(start, loops);
+        printf("%-8s %8lu %12.1f %12.1f\n", "copy", length, byte_ns, word_ns);
+
+        start = clock();
+        for (i = 0; i < loops; i ++)
+            test_byte_set(test_destination, (UCHAR)i, length);
+        byte_ns = test_elapsed_ns(start, loops);
+        start = clock();
+        for (i = 0; i < loops; i ++)
+            _ux_utility_memory_set(test_destination, (UCHAR)i, length);
+        word_ns = test_elapsed_ns(start, loops);
+        printf("%-8s %8lu %12.1f %12.1f\n", "set", length, byte_ns, word_ns);
+
+        _ux_utility_memory_copy(test_destination, test_source, length);
+        start = clock();
+        for (i = 0; i < loops; i ++)
+            test_byte_compare(test_destination, test_source, length);
+        byte_ns = test_elapsed_ns(start, loops);
+        start = clock();
+        for (i = 0; i < loops; i ++)
+            _ux_utility_memory_compare(test_destination, test_source, length);
+        word_ns = test_elapsed_ns(start, loops);
+        printf("%-8s %8lu %12.1f %12.1f\n", "compare", length, byte_ns, word_ns);
+    }
+
+    /* Sleep for a tick to make sure everything is complete.  */
+    tx_thread_sleep(1);
+
+    /* Check for errors from other threads.  */
+    if (error_counter)
+    {
+
+        /* Test error.  */
+        printf("ERROR #%d: total %ld errors\n", __LINE__, error_counter);
+        test_control_return(1);
+    }
+    else
+    {
+
+        /* Successful test.  */
+        printf("SUCCESS!\n");
+        test_control_return(0);
+    }
+}
@@ -0,0 +1,241 @@
+/* This test is designed to test the ux_utility_memory_copy/set/compare word access
+   results against byte by byte references.  */
+
+#include <stdio.h>
+#include "tx_api.h"
+#include "ux_api.h"
+#include "ux_system.h"
+#include "ux_utility.h"
+
+#include "ux_test.h"
+
+
+/* Define USBX test constants.  */
+
+#define UX_TEST_STACK_SIZE      4096
+#define UX_TEST_MEMORY_SIZE     (64*1024)
+
+#define UX_TEST_BUFFER_SIZE     256
+#define UX_TEST_MAX_OFFSET      (sizeof(ALIGN_TYPE) * 2)
+#define UX_TEST_MAX_LENGTH      (sizeof(ALIGN_TYPE) * 12 + 3)
+
+
+/* Define the counters used in the test application...  */
+
+static ULONG                           error_counter;
+
+static UCHAR                           error_callback_ignore = UX_FALSE;
+static ULONG                           error_callback_counter;
+
+static UCHAR                           test_source[UX_TEST_BUFFER_SIZE];
+static UCHAR                           test_destination[UX_TEST_BUFFER_SIZE];
+static UCHAR                           test_reference[UX_TEST_BUFFER_SIZE];
+
+
+/* Define prototypes for external Host Controller's (HCDs), classes and clients.  */
+
+static TX_THREAD           ux_test_thread_simulation_0;
+static void                ux_test_thread_simulation_0_entry(ULONG);
+
+
+/* Prototype for test control return.  */
+
+void  test_control_return(UINT status);
+
+
+static VOID error_callback(UINT system_level, UINT system_context, UINT error_code)
+{
+
+    error_callback_counter ++;
+
+    if (!error_callback_ignore)
+    {
+        {
+            /* Failed test.  */
+            printf("Error #%d, system_level: %d, system_context: %d, error_code: 0x%x\n", __LINE__, system_level, system_context, error_code);
+            // test_control_return(1);
+        }
+    }
+}
+
+
+/* Byte by byte references, as the original implementation.  */
+
+static VOID test_byte_copy(VOID *memory_destination, VOID *memory_source, ULONG length)
+{
+volatile UCHAR  *destination = (volatile UCHAR *)memory_destination;
+UCHAR           *source = (UCHAR *)memory_source;
+
+    while(length--)
+        *destination++ = *source++;
+}
+
+static VOID test_byte_set(VOID *memory_destination, UCHAR value, ULONG length)
+{
+volatile UCHAR  *destination = (volatile UCHAR *)memory_destination;
+
+    while(length--)
+        *destination++ = value;
+}
+
+static UINT test_byte_compare(VOID *memory_source, VOID *memory_destination, ULONG length)
+{
+volatile UCHAR  *destination = (volatile UCHAR *)memory_destination;
+UCHAR           *source = (UCHAR *)memory_source;
+
+    while(length--)
+    {
+        if (*destination++ != *source++)
+            return(UX_ERROR);
+    }
+    return(UX_SUCCESS);
+}
+
+static VOID test_buffers_fill(VOID)
+{
+ULONG   i;
+
+    for (i = 0; i < UX_TEST_BUFFER_SIZE; i ++)
+    {
+        test_source[i] = (UCHAR)(i * 7 + 3);
+        test_destination[i] = (UCHAR)(i * 13 + 5);
+        test_reference[i] = test_destination[i];
+    }
+}
+
+
+/* Define what the initial system looks like.  */
+
+#ifdef CTEST
+void test_application_define(void *first_unused_memory)
+#else
+void    usbx_ux_utility_memory_word_access_test_application_define(void *first_unused_memory)
+#endif
+{
+
+UINT status;
+CHAR                            *stack_pointer;
+CHAR                            *memory_pointer;
+
+    /* Inform user.  */
+    printf("Running ux_utility_memory_ word access Test......................... ");
+
+    /* Initialize the free memory pointer.  */
+    stack_pointer = (CHAR *) first_unused_memory;
+    memory_pointer = stack_pointer + (UX_TEST_STACK_SIZE * 2);
+
+    /* Initialize USBX Memory.  */
+    status =  ux_system_initialize(memory_pointer, UX_TEST_MEMORY_SIZE, UX_NULL, 0);
+
+    /* Check for error.  */
+    if (status != UX_SUCCESS)
+    {
+
+        printf("ERROR #%d\n", __LINE__);
+        test_control_return(1);
+    }
+
+    /* Register the error callback. */
+    _ux_utility_error_callback_register(error_callback);
+
+    /* Create the simulation thread.  */
+    status =  tx_thread_create(&ux_test_thread_simulation_0, "test simulation", ux_test_thread_simulation_0_entry, 0,
+            stack_pointer, UX_TEST_STACK_SIZE,
+            20, 20, 1, TX_AUTO_START);
+
+    /* Check for error.  */
+    if (status != TX_SUCCESS)
+    {
+
+        printf("ERROR #%d\n", __LINE__);
+        test_control_return(1);
+    }
+}
+
+static void  ux_test_thread_simulation_0_entry(ULONG arg)
+{
+
+ULONG           source_offset;
+ULONG           destination_offset;
+ULONG           length;
+ULONG           i;
+
+
+    /* Check copy, set and compare results against byte by byte references,
+       for all combinations of source/destination alignments, head and tail sizes.  */
+    for (source_offset = 0; source_offset < UX_TEST_MAX_OFFSET; source_offset ++)
+    {
+        for (destination_offset = 0; destination_offset < UX_TEST_MAX_OFFSET; destination_offset ++)
+        {
+            for (length = 0; length < UX_TEST_MAX_LENGTH; length ++)
+            {
+
+                /* Copy.  */
+                test_buffers_fill();
+                _ux_utility_memory_copy(test_destination + destination_offset, test_source + source_offset, length);
+                test_byte_copy(test_reference + destination_offset, test_source + source_offset, length);
+                if (test_byte_compare(test_destination, test_reference, UX_TEST_MAX_OFFSET + UX_TEST_MAX_LENGTH + 16) != UX_SUCCESS)
+                {
+                    printf("ERROR #%d: copy %lu -> %lu, %lu\n", __LINE__, source_offset, destination_offset, length);
+                    error_counter ++;
+                }
+
+                /* Compare, equal.  */
+                UX_TEST_ASSERT(_ux_utility_memory_compare(test_source + source_offset, test_destination + destination_offset, length) == UX_SUCCESS);
+
+                /* Compare, first and last bytes different.  */
+                if (length > 0)
+                {
+                    test_destination[destination_offset] ^= 0x80;
+                    UX_TEST_ASSERT(_ux_utility_memory_compare(test_source + source_offset, test_destination + destination_offset, length) == UX_ERROR);
+                    test_destination[destination_offset] ^= 0x80;
+                    test_destination[destination_offset + length - 1] ^= 0x01;
+                    UX_TEST_ASSERT(_ux_utility_memory_compare(test_source + source_offset, test_destination + destination_offset, length) == UX_ERROR);
+                }
+
+                /* Set.  */
+                test_buffers_fill();
+                _ux_utility_memory_set(test_destination + destination_offset, (UCHAR)(0xA5 + source_offset), length);
+                test_byte_set(test_reference + destination_offset, (UCHAR)(0xA5 + source_offset), length);
+                if (test_byte_compare(test_destination, test_reference, UX_TEST_MAX_OFFSET + UX_TEST_MAX_LENGTH + 16) != UX_SUCCESS)
+                {
+                    printf("ERROR #%d: set %lu, %lu\n", __LINE__, destination_offset, length);
+                    error_counter ++;
+                }
+            }
+        }
+    }
+
+    /* Overlapped copy, destination ahead of source must behave as byte copy.  */
+    for (i = 0; i < 64; i ++)
+        test_destination[i] = test_reference[i] = (UCHAR)i;
+    _ux_utility_memory_copy(test_destination + sizeof(ALIGN_TYPE), test_destination, 40);
+    test_byte_copy(test_reference + sizeof(ALIGN_TYPE), test_reference, 40);
+    UX_TEST_ASSERT(test_byte_compare(test_destination, test_reference, 64) == UX_SUCCESS);
+
+    /* Overlapped copy, destination behind source.  */
+    for (i = 0; i < 64; i ++)
+        test_destination[i] = test_reference[i] = (UCHAR)i;
+    _ux_utility_memory_copy(test_destination, test_destination + sizeof(ALIGN_TYPE), 40);
+    test_byte_copy(test_reference, test_reference + sizeof(ALIGN_TYPE), 40);
+    UX_TEST_ASSERT(test_byte_compare(test_destination, test_reference, 64) == UX_SUCCESS);
+
+    /* Sleep for a tick to make sure everything is complete.  */
+    tx_thread_sleep(1);
+
+    /* Check for errors from other threads.  */
+    if (error_counter)
+    {
+
+        /* Test error.  */
+        printf("ERROR #%d: total %ld errors\n", __LINE__, error_counter);
+        test_control_return(1);
+    }
+    else
+    {
+
+        /* Successful test.  */
+        printf("SUCCESS!\n");
+        test_control_return(0);
+    }
+}
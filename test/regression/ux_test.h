@@ -523,7 +523,7 @@ UCHAR               *temp_ptr;
 ALIGN_TYPE          *free_ptr;
 int                 is_free = 0;
     UX_TEST_ASSERT(memory);
-    _ux_system_mutex_on(&_ux_system -> ux_system_mutex);
+    _ux_system_mutex_on(&_ux_system -> ux_system_memory_byte_pool[UX_MEMORY_BYTE_POOL_REGULAR] -> ux_byte_pool_mutex);
     work_ptr =  UX_VOID_TO_UCHAR_POINTER_CONVERT(memory);
     {
         work_ptr =  UX_UCHAR_POINTER_SUB(work_ptr, UX_MEMORY_BLOCK_HEADER_SIZE);
@@ -532,7 +532,7 @@ int                 is_free = 0;
         if ((*free_ptr) == UX_BYTE_BLOCK_FREE)
             is_free = 1;
     }
-    _ux_system_mutex_off(&_ux_system -> ux_system_mutex);
+    _ux_system_mutex_off(&_ux_system -> ux_system_memory_byte_pool[UX_MEMORY_BYTE_POOL_REGULAR] -> ux_byte_pool_mutex);
     return(is_free);
 }
 #define ux_test_regular_memory_free() _ux_system -> ux_system_memory_byte_pool[UX_MEMORY_BYTE_POOL_REGULAR] -> ux_byte_pool_available
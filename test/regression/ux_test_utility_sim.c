@@ -103,6 +103,27 @@ static UX_TEST_ACTION ux_system_mutex_hooks[4] = {
 { 0 },
 };
 
+static void ux_byte_pool_mutex_get_callback(UX_TEST_ACTION *action, VOID *params);
+static void ux_byte_pool_mutex_put_callback(UX_TEST_ACTION *action, VOID *params);
+
+/* Get - 0, put - 1, for the mutex of each memory pool, counted with system mutex */
+static UX_TEST_ACTION ux_byte_pool_mutex_hooks[3] = {
+    {
+        .usbx_function = UX_TEST_OVERRIDE_TX_MUTEX_GET,
+        .mutex_ptr = UX_NULL, /* Checked in callback. */
+        .wait_option = TX_WAIT_FOREVER,
+        .do_after = UX_FALSE,
+        .action_func = ux_byte_pool_mutex_get_callback,
+    },
+    {
+        .usbx_function = UX_TEST_OVERRIDE_TX_MUTEX_PUT,
+        .mutex_ptr = UX_NULL, /* Checked in callback. */
+        .do_after = UX_TRUE,
+        .action_func = ux_byte_pool_mutex_put_callback,
+    },
+{ 0 },
+};
+
 static ULONG ux_system_mutex_on_count      = 0;
 static ULONG ux_system_mutex_off_count     = 0;
 UCHAR ux_system_mutex_callback_skip = UX_FALSE;
@@ -154,6 +175,7 @@ VOID ux_test_utility_sim_cleanup(VOID)
     last_allocate[1] = UX_NULL;
 
     ux_test_remove_hooks_from_array(ux_system_mutex_hooks);
+    ux_test_remove_hooks_from_array(ux_byte_pool_mutex_hooks);
 
     mem_alloc_count = 0;
     mem_alloc_fail_after = FAIL_DISABLE;
@@ -1351,10 +1373,12 @@ VOID  ux_test_utility_sim_mem_alloc_log_enable(UCHAR enable_disable)
         _ux_utility_memory_set(ux_system_mutex_alloc_logs, 0, sizeof(ux_system_mutex_alloc_logs));
 
         ux_test_link_hooks_from_array(ux_system_mutex_hooks);
+        ux_test_link_hooks_from_array(ux_byte_pool_mutex_hooks);
     }
     else
     {
         ux_test_remove_hooks_from_array(ux_system_mutex_hooks);
+        ux_test_remove_hooks_from_array(ux_byte_pool_mutex_hooks);
     }
 }
 
@@ -1758,6 +1782,42 @@ ULONG                                this_count = ux_system_mutex_off_count;
     }
 }
 
+static UCHAR ux_byte_pool_mutex_check(TX_MUTEX *mutex_ptr)
+{
+#if !defined(UX_STANDALONE)
+UX_MEMORY_BYTE_POOL *pool;
+UINT                 i;
+
+    if (_ux_system == UX_NULL)
+        return(UX_FALSE);
+
+    /* Memory is protected by the mutex of the pool it belongs to.  */
+    for (i = 0; i < UX_MEMORY_BYTE_POOL_NUM; i ++)
+    {
+        pool = _ux_system -> ux_system_memory_byte_pool[i];
+        if (pool != UX_NULL && mutex_ptr == &pool -> ux_byte_pool_mutex)
+            return(UX_TRUE);
+    }
+#endif
+    return(UX_FALSE);
+}
+
+static void ux_byte_pool_mutex_get_callback(UX_TEST_ACTION *action, VOID *params)
+{
+UX_TEST_OVERRIDE_TX_MUTEX_GET_PARAMS *mutex_get_param = params;
+
+    if (ux_byte_pool_mutex_check(mutex_get_param->mutex_ptr))
+        ux_system_mutex_get_callback(action, params);
+}
+
+static void ux_byte_pool_mutex_put_callback(UX_TEST_ACTION *action, VOID *params)
+{
+UX_TEST_OVERRIDE_TX_MUTEX_PUT_PARAMS *mutex_put_param = params;
+
+    if (ux_byte_pool_mutex_check(mutex_put_param->mutex_ptr))
+        ux_system_mutex_put_callback(action, params);
+}
+
 UINT  _tx_mutex_put(TX_MUTEX *mutex_ptr)
 {
 